@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <boost/program_options.hpp>
+#include <iostream>
+
+#include "depends/safeserver/safehttpserver.h"
+#include "libNetwork/Guard.h"
+#include "libPersistence/BlockStorage.h"
+#include "libServer/APIReplicaServer.h"
+#include "libUtils/UpgradeManager.h"
+
+#define SUCCESS 0
+#define ERROR_IN_COMMAND_LINE -1
+#define ERROR_UNHANDLED_EXCEPTION -2
+
+/// Read-only API replica. Should be run from a folder with constants.xml,
+/// dsnodes.xml and a folder named "persistence" holding a refreshed copy of
+/// the primary's persistence (LevelDB holds an exclusive lock per directory,
+/// so the replica cannot open the primary's live directory; point it at a
+/// filesystem snapshot or rsync'd copy instead). After each refresh of that
+/// copy, announce the new epoch on the control port:
+///   curl -d '{"id":"1","jsonrpc":"2.0","method":"NotifyNewEpoch",
+///             "params":["1234"]}' http://127.0.0.1:<control port>
+
+using namespace std;
+namespace po = boost::program_options;
+
+void help(const char* argv[]) {
+  cout << "Usage" << endl;
+  cout << argv[0]
+       << " --port [Port to serve the read API] --control [Local port for "
+          "epoch notifications from the primary]"
+       << endl;
+}
+
+int main(int argc, const char* argv[]) {
+  uint port{5555};
+  uint controlPort{5556};
+  try {
+    po::options_description desc("Options");
+
+    desc.add_options()("help,h", "Print help message")(
+        "port,p", po::value<uint>(&port),
+        "Port to serve the read API {default: 5555}")(
+        "control,c", po::value<uint>(&controlPort),
+        "Local port for epoch notifications from the primary {default: "
+        "5556}");
+
+    po::variables_map vm;
+
+    try {
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+
+      if (vm.count("help")) {
+        help(argv);
+        cout << desc << endl;
+        return SUCCESS;
+      }
+      po::notify(vm);
+    } catch (boost::program_options::error& e) {
+      std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    INIT_STDOUT_LOGGER();
+
+    LOG_MARKER();
+
+    PairOfKey key;  // Dummy to initiate mediator
+    Peer peer;
+
+    Mediator mediator(key, peer);
+    Node node(mediator, 0, false);
+    Lookup lk(mediator, NO_SYNC);
+    auto vd = make_shared<Validator>(mediator);
+    Synchronizer sync;
+
+    mediator.m_dsBlockChain.Reset();
+    mediator.m_txBlockChain.Reset();
+
+    sync.InitializeGenesisBlocks(mediator.m_dsBlockChain,
+                                 mediator.m_txBlockChain);
+    const auto& dsBlock = mediator.m_dsBlockChain.GetBlock(0);
+    {
+      lock_guard<mutex> lock(mediator.m_mutexInitialDSCommittee);
+      if (!UpgradeManager::GetInstance().LoadInitialDS(
+              *mediator.m_initialDSCommittee)) {
+        LOG_GENERAL(WARNING, "Unable to load initial DS comm");
+      }
+    }
+    mediator.m_blocklinkchain.AddBlockLink(0, 0, BlockType::DS,
+                                           dsBlock.GetBlockHash());
+
+    if (GUARD_MODE) {
+      Guard::GetInstance().Init();
+    }
+    mediator.RegisterColleagues(nullptr, &node, &lk, vd.get());
+
+    auto apiConnector = make_unique<jsonrpc::SafeHttpServer>(port);
+    auto apiReplicaServer =
+        make_shared<APIReplicaServer>(mediator, *apiConnector);
+
+    if (!apiReplicaServer->RefreshFromStorage()) {
+      cerr << "ERROR: "
+           << "Unable to load blocks and state from persistence" << endl;
+      return ERROR_UNHANDLED_EXCEPTION;
+    }
+
+    auto controlConnector = make_unique<jsonrpc::SafeHttpServer>(controlPort);
+    auto controlServer =
+        make_shared<ReplicaControlServer>(*apiReplicaServer, *controlConnector);
+
+    if (!apiReplicaServer
+             ->jsonrpc::AbstractServer<APIReplicaServer>::StartListening()) {
+      cerr << "API server failed to listen" << endl;
+      return ERROR_UNHANDLED_EXCEPTION;
+    }
+    cout << "Read API listening on " << port << endl;
+
+    if (!controlServer->StartListening()) {
+      cerr << "Control server failed to listen" << endl;
+      return ERROR_UNHANDLED_EXCEPTION;
+    }
+    cout << "Control endpoint listening on " << controlPort << endl;
+
+    while (true) {
+      ;  // keep server running
+    }
+
+  } catch (std::exception& e) {
+    std::cerr << "Unhandled Exception reached the top of main: " << e.what()
+              << ", application will now exit" << std::endl;
+    return ERROR_UNHANDLED_EXCEPTION;
+  }
+
+  return SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/// Seals a historical txBodies LevelDB into the append-only mmap-readable
+/// archive format read by TxnArchive. Point --path at the folder holding the
+/// txBodies DB (the same folder that is passed to InitiateHistoricalDB); the
+/// archive files are written next to it.
+
+#include <iostream>
+
+#include <boost/program_options.hpp>
+
+#include "libPersistence/TxnArchive.h"
+#include "libUtils/SWInfo.h"
+
+using namespace std;
+
+#define SUCCESS 0
+#define ERROR_IN_COMMAND_LINE -1
+#define ERROR_UNHANDLED_EXCEPTION -2
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  string path;
+  po::options_description desc("Options");
+
+  desc.add_options()("help,h", "Print help messages")(
+      "path,p", po::value<string>(&path)->required(),
+      "Folder containing the historical txBodies LevelDB");
+
+  po::variables_map vm;
+
+  try {
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+
+    if (vm.count("help")) {
+      SWInfo::LogBrandBugReport();
+      cout << desc << endl;
+      return SUCCESS;
+    }
+    po::notify(vm);
+  } catch (const boost::program_options::required_option& e) {
+    SWInfo::LogBrandBugReport();
+    cerr << "ERROR: " << e.what() << endl << endl;
+    cout << desc << endl;
+    return ERROR_IN_COMMAND_LINE;
+  } catch (const boost::program_options::error& e) {
+    SWInfo::LogBrandBugReport();
+    cerr << "ERROR: " << e.what() << endl << endl;
+    return ERROR_IN_COMMAND_LINE;
+  }
+
+  try {
+    LevelDB txBodyDB("txBodies", path, (string) "");
+    if (txBodyDB.GetDB() == nullptr) {
+      cerr << "ERROR: no txBodies LevelDB found in " << path << endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    if (!TxnArchive::BuildFromLevelDB(txBodyDB, path)) {
+      cerr << "ERROR: sealing the txn archive failed" << endl;
+      return ERROR_UNHANDLED_EXCEPTION;
+    }
+  } catch (const exception& e) {
+    cerr << "ERROR: " << e.what() << endl;
+    return ERROR_UNHANDLED_EXCEPTION;
+  }
+
+  return SUCCESS;
+}
@@ -201,8 +201,9 @@ int main(int argc, const char* argv[]) {
       zilliqa.Dispatch(message);
     };
 
-    P2PComm::GetInstance().StartMessagePump(my_network_info.m_listenPortHost,
-                                            dispatcher);
+    P2PComm::GetInstance().StartMessagePump(
+        my_network_info.m_listenPortHost, dispatcher,
+        &Zilliqa::IsPriorityMessage);
 
   } catch (std::exception& e) {
     std::cerr << "Unhandled Exception reached the top of main: " << e.what()
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Replays a message trace captured with ENABLE_MESSAGE_TRACE through
+// Zilliqa::Dispatch on an isolated node, at original or accelerated speed.
+// The node is brought up exactly as by the zilliqa binary but without the
+// network pump, so the dispatcher and queues face the recorded message storm
+// and nothing else.
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <boost/program_options.hpp>
+
+#include "libNetwork/MessageTrace.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/IPConverter.h"
+#include "libUtils/Logger.h"
+#include "libZilliqa/Zilliqa.h"
+
+using namespace std;
+
+#define SUCCESS 0
+#define ERROR_IN_COMMAND_LINE -1
+#define ERROR_UNHANDLED_EXCEPTION -3
+
+namespace po = boost::program_options;
+
+int main(int argc, const char* argv[]) {
+  try {
+    string privK;
+    string pubK;
+    string address;
+    string traceFile;
+    string logpath(boost::filesystem::absolute("./").string());
+    int port = -1;
+    double speed = 1.0;
+    unsigned int syncType = 0;
+    unsigned int drainWaitSeconds = 10;
+    uint128_t ip;
+
+    po::options_description desc("Options");
+    desc.add_options()("help,h", "Print help messages")(
+        "privk,i", po::value<string>(&privK)->required(),
+        "32-byte private key")("pubk,u", po::value<string>(&pubK)->required(),
+                               "33-byte public key")(
+        "address,a", po::value<string>(&address)->required(),
+        "Listen IPv4/6 address formated as \"dotted decimal\" or optionally "
+        "\"dotted decimal:portnumber\" format")(
+        "port,p", po::value<int>(&port),
+        "Specifies port to bind to, if not specified in address")(
+        "trace,t", po::value<string>(&traceFile)->required(),
+        "message trace file captured with ENABLE_MESSAGE_TRACE")(
+        "speed,x", po::value<double>(&speed),
+        "replay speed multiplier; 1 = original pacing (default), 0 = as fast "
+        "as possible")("synctype,s", po::value<unsigned int>(&syncType),
+                       "sync type to bring the node up with (default 0)")(
+        "drainwait,w", po::value<unsigned int>(&drainWaitSeconds),
+        "seconds to keep the node up after the last message (default 10)")(
+        "logpath,g", po::value<string>(&logpath), "customized log path");
+
+    po::variables_map vm;
+    try {
+      po::store(po::parse_command_line(argc, argv, desc), vm);
+
+      if (vm.count("help")) {
+        cout << desc << endl;
+        return SUCCESS;
+      }
+
+      po::notify(vm);
+
+      if (!IPConverter::ToNumericalIPFromStr(address, ip)) {
+        return ERROR_IN_COMMAND_LINE;
+      }
+      string address_;
+      if (IPConverter::GetIPPortFromSocket(address, address_, port)) {
+        address = address_;
+      }
+
+      if ((port < 0) || (port > 65535)) {
+        std::cerr << "Invalid or missing port number" << endl;
+        return ERROR_IN_COMMAND_LINE;
+      }
+
+      if (speed < 0) {
+        std::cerr << "Invalid replay speed" << endl;
+        return ERROR_IN_COMMAND_LINE;
+      }
+    } catch (boost::program_options::error& e) {
+      std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    PrivKey privkey;
+    PubKey pubkey;
+    try {
+      privkey = PrivKey::GetPrivKeyFromString(privK);
+      pubkey = PubKey::GetPubKeyFromString(pubK);
+    } catch (std::invalid_argument& e) {
+      std::cerr << e.what() << endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    INIT_FILE_LOGGER("replaytrace", logpath.c_str());
+    INIT_STATE_LOGGER("state", logpath.c_str());
+    INIT_EPOCHINFO_LOGGER("epochinfo", logpath.c_str());
+
+    vector<MessageTrace::Record> records;
+    if (!MessageTrace::ReadTrace(traceFile, records) || records.empty()) {
+      std::cerr << "No records read from " << traceFile << endl;
+      return ERROR_IN_COMMAND_LINE;
+    }
+
+    const Peer my_network_info(ip, port);
+    Zilliqa zilliqa(make_pair(privkey, pubkey), my_network_info,
+                    (SyncType)syncType, false);
+
+    cout << "Replaying " << records.size() << " messages from " << traceFile
+         << " at " << (speed == 0 ? string("max") : to_string(speed) + "x")
+         << " speed" << endl;
+
+    const uint64_t baseTimestampMicros = records.front().timestampMicros;
+    const auto replayStart = chrono::steady_clock::now();
+    uint64_t totalBytes = 0;
+
+    for (auto& record : records) {
+      if (speed > 0) {
+        const auto due =
+            replayStart +
+            chrono::microseconds(static_cast<int64_t>(
+                (record.timestampMicros - baseTimestampMicros) / speed));
+        this_thread::sleep_until(due);
+      }
+
+      totalBytes += record.payload.size();
+      zilliqa.Dispatch(
+          new pair<bytes, Peer>(move(record.payload), record.from));
+    }
+
+    const double elapsedSec =
+        chrono::duration<double>(chrono::steady_clock::now() - replayStart)
+            .count();
+    cout << "Dispatched " << records.size() << " messages (" << totalBytes
+         << " bytes) in " << elapsedSec << " s ("
+         << records.size() / elapsedSec << " msg/s)" << endl;
+
+    // let the queues and handlers drain before tearing the node down
+    this_thread::sleep_for(chrono::seconds(drainWaitSeconds));
+
+  } catch (std::exception& e) {
+    std::cerr << "Unhandled Exception reached the top of main: " << e.what()
+              << ", application will now exit" << std::endl;
+    return ERROR_UNHANDLED_EXCEPTION;
+  }
+
+  return SUCCESS;
+}
@@ -20,15 +20,27 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
+#include <iostream>
 
 using namespace std;
 
 using boost::property_tree::ptree;
 
 struct PTree {
-  static ptree& GetInstance() {
-    static ptree pt;
-    read_xml("constants.xml", pt);
+  static const ptree& GetInstance() {
+    // Parse the file exactly once per process: every constant read used to
+    // re-run read_xml into the shared tree and then deep-copy the whole
+    // tree into the caller, which dominated process start-up time
+    static const ptree pt = []() {
+      ptree t;
+      try {
+        read_xml("constants.xml", t);
+      } catch (const exception& e) {
+        cerr << "Cannot load constants.xml: " << e.what() << endl;
+        throw;
+      }
+      return t;
+    }();
 
     return pt;
   }
@@ -38,24 +50,24 @@ struct PTree {
 
 unsigned int ReadConstantNumeric(const string& propertyName,
                                  const char* path = "node.general.") {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   return pt.get<unsigned int>(path + propertyName);
 }
 
 double ReadConstantDouble(const string& propertyName,
                           const char* path = "node.general.") {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   return pt.get<double>(path + propertyName);
 }
 
 string ReadConstantString(const string& propertyName,
                           const char* path = "node.general.") {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   return pt.get<string>(path + propertyName);
 }
 
 const vector<string> ReadAccountsFromConstantsFile(const string& propName) {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   vector<string> result;
   for (auto& acc : pt.get_child("node.accounts")) {
     auto child = acc.second.get_optional<string>(propName);
@@ -79,6 +91,22 @@ const string GENESIS_PUBKEY{
 const unsigned int UPGRADE_TARGET_DS_NUM{
     ReadConstantNumeric("UPGRADE_TARGET_DS_NUM")};
 const string STORAGE_PATH{ReadConstantString("STORAGE_PATH", "node.general.")};
+const bool LEVELDB_SORTED_BATCH{ReadConstantString("LEVELDB_SORTED_BATCH") ==
+                                "true"};
+const bool BACKGROUND_COMMIT_IO_LOW_PRIO{
+    ReadConstantString("BACKGROUND_COMMIT_IO_LOW_PRIO") == "true"};
+const bool LEVELDB_SYNC_BATCH_WRITES{
+    ReadConstantString("LEVELDB_SYNC_BATCH_WRITES") == "true"};
+const unsigned int LEVELDB_SHARED_BLOCK_CACHE_MB{
+    ReadConstantNumeric("LEVELDB_SHARED_BLOCK_CACHE_MB")};
+const string LEVELDB_DB_OPTIONS_PROFILES{
+    ReadConstantString("LEVELDB_DB_OPTIONS_PROFILES")};
+const unsigned int CACHE_MEMORY_BUDGET_MB{
+    ReadConstantNumeric("CACHE_MEMORY_BUDGET_MB")};
+const unsigned int STATE_DELTA_RETENTION_EPOCHS{
+    ReadConstantNumeric("STATE_DELTA_RETENTION_EPOCHS")};
+const bool ENABLE_STATE_DELTA_COMPRESSION{
+    ReadConstantString("ENABLE_STATE_DELTA_COMPRESSION") == "true"};
 
 // Version constants
 const unsigned int MSG_VERSION{
@@ -109,10 +137,18 @@ const unsigned int CONTRACT_STATE_VERSION{
 // Seed constans
 const bool ARCHIVAL_LOOKUP{
     ReadConstantString("ARCHIVAL_LOOKUP", "node.seed.") == "true"};
+const bool SYNC_HEADERS_ONLY{
+    ReadConstantString("SYNC_HEADERS_ONLY", "node.seed.") == "true"};
 const unsigned int SEED_TXN_COLLECTION_TIME_IN_SEC{
     ReadConstantNumeric("SEED_TXN_COLLECTION_TIME_IN_SEC", "node.seed.")};
+const unsigned int SEED_STATE_CHUNK_NUM_ACCOUNTS{
+    ReadConstantNumeric("SEED_STATE_CHUNK_NUM_ACCOUNTS", "node.seed.")};
 const unsigned int TXN_STORAGE_LIMIT{
     ReadConstantNumeric("TXN_STORAGE_LIMIT", "node.seed.")};
+const unsigned int TXN_PACKET_BACKLOG_TARGET{
+    ReadConstantNumeric("TXN_PACKET_BACKLOG_TARGET", "node.seed.")};
+const bool ENABLE_TXN_POOL_JOURNAL{
+    ReadConstantString("ENABLE_TXN_POOL_JOURNAL", "node.seed.") == "true"};
 // Consensus constants
 const unsigned int COMMIT_WINDOW_IN_SECONDS{
     ReadConstantNumeric("COMMIT_WINDOW_IN_SECONDS", "node.consensus.")};
@@ -271,6 +307,17 @@ const bool SIGN_VERIFY_EMPTY_MSGTYP{
 const bool SIGN_VERIFY_NONEMPTY_MSGTYP{
     ReadConstantString("SIGN_VERIFY_NONEMPTY_MSGTYP", "node.gossip.") ==
     "true"};
+const bool GOSSIP_BATCH_MSGS{
+    ReadConstantString("GOSSIP_BATCH_MSGS", "node.gossip.") == "true"};
+const bool ENABLE_ADAPTIVE_GOSSIP_ROUNDS{
+    ReadConstantString("ENABLE_ADAPTIVE_GOSSIP_ROUNDS", "node.gossip.") ==
+    "true"};
+const unsigned int ADAPTIVE_GOSSIP_EWMA_ALPHA_PERCENT{ReadConstantNumeric(
+    "ADAPTIVE_GOSSIP_EWMA_ALPHA_PERCENT", "node.gossip.")};
+const unsigned int ADAPTIVE_GOSSIP_MARGIN_PERCENT{
+    ReadConstantNumeric("ADAPTIVE_GOSSIP_MARGIN_PERCENT", "node.gossip.")};
+const unsigned int ADAPTIVE_GOSSIP_MIN_PERCENT{
+    ReadConstantNumeric("ADAPTIVE_GOSSIP_MIN_PERCENT", "node.gossip.")};
 
 // GPU mining constants
 const string GPU_TO_USE{ReadConstantString("GPU_TO_USE", "node.gpu.")};
@@ -327,6 +374,8 @@ const unsigned int WEBSOCKET_PORT{
 const bool ENABLE_GETTXNBODIESFORTXBLOCK{
     ReadConstantString("ENABLE_GETTXNBODIESFORTXBLOCK", "node.jsonrpc.") ==
     "true"};
+const bool ENABLE_ADDRESS_INDEX{
+    ReadConstantString("ENABLE_ADDRESS_INDEX", "node.jsonrpc.") == "true"};
 
 // Network composition constants
 const unsigned int COMM_SIZE{
@@ -349,6 +398,14 @@ const unsigned int BROADCAST_INTERVAL{
     ReadConstantNumeric("BROADCAST_INTERVAL", "node.p2pcomm.")};
 const unsigned int BROADCAST_EXPIRY{
     ReadConstantNumeric("BROADCAST_EXPIRY", "node.p2pcomm.")};
+const unsigned int BROADCAST_LAZY_THRESHOLD_IN_BYTES{
+    ReadConstantNumeric("BROADCAST_LAZY_THRESHOLD_IN_BYTES", "node.p2pcomm.")};
+const bool ENABLE_LOOPBACK_DISPATCH{
+    ReadConstantString("ENABLE_LOOPBACK_DISPATCH", "node.p2pcomm.") == "true"};
+const string NUMA_MESSAGE_THREADS_CPUS{
+    ReadConstantString("NUMA_MESSAGE_THREADS_CPUS", "node.p2pcomm.")};
+const string NUMA_STORAGE_THREADS_CPUS{
+    ReadConstantString("NUMA_STORAGE_THREADS_CPUS", "node.p2pcomm.")};
 const unsigned int FETCH_LOOKUP_MSG_MAX_RETRY{
     ReadConstantNumeric("FETCH_LOOKUP_MSG_MAX_RETRY", "node.p2pcomm.")};
 const uint32_t MAXSENDMESSAGE{
@@ -359,10 +416,18 @@ const unsigned int MAXRETRYCONN{
     ReadConstantNumeric("MAXRETRYCONN", "node.p2pcomm.")};
 const unsigned int MSGQUEUE_SIZE{
     ReadConstantNumeric("MSGQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int MSGQUEUE_PRIORITY_SIZE{
+    ReadConstantNumeric("MSGQUEUE_PRIORITY_SIZE", "node.p2pcomm.")};
+const uint32_t MAXRECVMESSAGE_PRIORITY{
+    ReadConstantNumeric("MAXRECVMESSAGE_PRIORITY", "node.p2pcomm.")};
 const unsigned int PUMPMESSAGE_MILLISECONDS{
     ReadConstantNumeric("PUMPMESSAGE_MILLISECONDS", "node.p2pcomm.")};
 const unsigned int SENDQUEUE_SIZE{
     ReadConstantNumeric("SENDQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int SENDQUEUE_PRIORITY_SIZE{
+    ReadConstantNumeric("SENDQUEUE_PRIORITY_SIZE", "node.p2pcomm.")};
+const uint32_t MAXSENDMESSAGE_PRIORITY{
+    ReadConstantNumeric("MAXSENDMESSAGE_PRIORITY", "node.p2pcomm.")};
 const unsigned int MAX_GOSSIP_MSG_SIZE_IN_BYTES{
     ReadConstantNumeric("MAX_GOSSIP_MSG_SIZE_IN_BYTES", "node.p2pcomm.")};
 const unsigned int MIN_READ_WATERMARK_IN_BYTES{
@@ -375,6 +440,12 @@ const unsigned int MAX_PEER_CONNECTION{
     ReadConstantNumeric("MAX_PEER_CONNECTION", "node.p2pcomm.")};
 const unsigned int MAX_WHITELISTREQ_LIMIT{
     ReadConstantNumeric("MAX_WHITELISTREQ_LIMIT", "node.p2pcomm.")};
+const bool SENDSOCKETPOOL_ENABLED{
+    ReadConstantString("SENDSOCKETPOOL_ENABLED", "node.p2pcomm.") == "true"};
+const unsigned int SENDSOCKETPOOL_IDLE_TIMEOUT_IN_SECONDS{ReadConstantNumeric(
+    "SENDSOCKETPOOL_IDLE_TIMEOUT_IN_SECONDS", "node.p2pcomm.")};
+const unsigned int SENDSOCKETPOOL_MAX_SOCKETS{
+    ReadConstantNumeric("SENDSOCKETPOOL_MAX_SOCKETS", "node.p2pcomm.")};
 
 // PoW constants
 const bool CUDA_GPU_MINE{ReadConstantString("CUDA_GPU_MINE", "node.pow.") ==
@@ -514,6 +585,17 @@ const bool DISABLE_SCILLA_LIB{
 const bool ENABLE_CHECK_PERFORMANCE_LOG{
     ReadConstantString("ENABLE_CHECK_PERFORMANCE_LOG", "node.tests.") ==
     "true"};
+const bool ENABLE_MESSAGE_TRACE{
+    ReadConstantString("ENABLE_MESSAGE_TRACE", "node.tests.") == "true"};
+const string MESSAGE_TRACE_FILE{
+    ReadConstantString("MESSAGE_TRACE_FILE", "node.tests.")};
+const bool ENABLE_SCILLA_PROFILE{
+    ReadConstantString("ENABLE_SCILLA_PROFILE", "node.tests.") == "true"};
+const unsigned int SCILLA_PROFILE_SLOW_THRESHOLD_MICROS{
+    ReadConstantNumeric("SCILLA_PROFILE_SLOW_THRESHOLD_MICROS",
+                        "node.tests.")};
+const unsigned int EPOCH_TIME_SLO_MS{
+    ReadConstantNumeric("EPOCH_TIME_SLO_MS", "node.tests.")};
 #ifdef FALLBACK_TEST
 const unsigned int FALLBACK_TEST_EPOCH{
     ReadConstantNumeric("FALLBACK_TEST_EPOCH", "node.tests.")};
@@ -592,6 +674,17 @@ const unsigned int VIEWCHANGE_PRECHECK_TIME{
     ReadConstantNumeric("VIEWCHANGE_PRECHECK_TIME", "node.viewchange.")};
 const unsigned int VIEWCHANGE_TIME{
     ReadConstantNumeric("VIEWCHANGE_TIME", "node.viewchange.")};
+const bool ENABLE_ADAPTIVE_VIEWCHANGE_TIME{
+    ReadConstantString("ENABLE_ADAPTIVE_VIEWCHANGE_TIME",
+                       "node.viewchange.") == "true"};
+const unsigned int ADAPTIVE_VIEWCHANGE_EWMA_ALPHA_PERCENT{ReadConstantNumeric(
+    "ADAPTIVE_VIEWCHANGE_EWMA_ALPHA_PERCENT", "node.viewchange.")};
+const unsigned int ADAPTIVE_VIEWCHANGE_MARGIN_PERCENT{ReadConstantNumeric(
+    "ADAPTIVE_VIEWCHANGE_MARGIN_PERCENT", "node.viewchange.")};
+const unsigned int ADAPTIVE_VIEWCHANGE_MIN_PERCENT{ReadConstantNumeric(
+    "ADAPTIVE_VIEWCHANGE_MIN_PERCENT", "node.viewchange.")};
+const unsigned int ADAPTIVE_VIEWCHANGE_MAX_PERCENT{ReadConstantNumeric(
+    "ADAPTIVE_VIEWCHANGE_MAX_PERCENT", "node.viewchange.")};
 
 // Genesis accounts
 const vector<string> GENESIS_WALLETS{
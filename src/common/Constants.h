@@ -75,6 +75,8 @@ enum MetaType : unsigned char {
   WAKEUPFORUPGRADE,
   LATEST_EPOCH_STATES_UPDATED,  // [deprecated soon]
   EPOCHFIN,
+  SEEDPEERSCORES,
+  MEMPOOLHANDOFF,
 };
 
 // Sync Type
@@ -133,6 +135,14 @@ extern const uint16_t CHAIN_ID;
 extern const std::string GENESIS_PUBKEY;
 extern const unsigned int UPGRADE_TARGET_DS_NUM;
 extern const std::string STORAGE_PATH;
+extern const bool LEVELDB_SORTED_BATCH;
+extern const bool BACKGROUND_COMMIT_IO_LOW_PRIO;
+extern const bool LEVELDB_SYNC_BATCH_WRITES;
+extern const unsigned int LEVELDB_SHARED_BLOCK_CACHE_MB;
+extern const std::string LEVELDB_DB_OPTIONS_PROFILES;
+extern const unsigned int CACHE_MEMORY_BUDGET_MB;
+extern const unsigned int STATE_DELTA_RETENTION_EPOCHS;
+extern const bool ENABLE_STATE_DELTA_COMPRESSION;
 
 // Version constants
 extern const unsigned int MSG_VERSION;
@@ -150,8 +160,12 @@ extern const unsigned int CONTRACT_STATE_VERSION;
 
 // Seed Node
 extern const bool ARCHIVAL_LOOKUP;
+extern const bool SYNC_HEADERS_ONLY;
 extern const unsigned int SEED_TXN_COLLECTION_TIME_IN_SEC;
+extern const unsigned int SEED_STATE_CHUNK_NUM_ACCOUNTS;
 extern const unsigned int TXN_STORAGE_LIMIT;
+extern const unsigned int TXN_PACKET_BACKLOG_TARGET;
+extern const bool ENABLE_TXN_POOL_JOURNAL;
 
 // Consensus constants
 extern const unsigned int COMMIT_WINDOW_IN_SECONDS;
@@ -237,6 +251,11 @@ extern const unsigned int SIMULATED_NETWORK_DELAY_IN_MS;
 extern const unsigned int KEEP_RAWMSG_FROM_LAST_N_ROUNDS;
 extern const bool SIGN_VERIFY_EMPTY_MSGTYP;
 extern const bool SIGN_VERIFY_NONEMPTY_MSGTYP;
+extern const bool GOSSIP_BATCH_MSGS;
+extern const bool ENABLE_ADAPTIVE_GOSSIP_ROUNDS;
+extern const unsigned int ADAPTIVE_GOSSIP_EWMA_ALPHA_PERCENT;
+extern const unsigned int ADAPTIVE_GOSSIP_MARGIN_PERCENT;
+extern const unsigned int ADAPTIVE_GOSSIP_MIN_PERCENT;
 
 // GPU mining constants
 extern const std::string GPU_TO_USE;
@@ -270,6 +289,7 @@ extern const std::string SCILLA_IPC_SOCKET_PATH;
 extern bool ENABLE_WEBSOCKET;
 extern const unsigned int WEBSOCKET_PORT;
 extern const bool ENABLE_GETTXNBODIESFORTXBLOCK;
+extern const bool ENABLE_ADDRESS_INDEX;
 
 // Network composition constants
 extern const unsigned int COMM_SIZE;
@@ -283,19 +303,30 @@ extern const unsigned int STORE_DS_COMMITTEE_INTERVAL;
 // P2PComm constants
 extern const unsigned int BROADCAST_INTERVAL;
 extern const unsigned int BROADCAST_EXPIRY;
+extern const unsigned int BROADCAST_LAZY_THRESHOLD_IN_BYTES;
+extern const bool ENABLE_LOOPBACK_DISPATCH;
+extern const std::string NUMA_MESSAGE_THREADS_CPUS;
+extern const std::string NUMA_STORAGE_THREADS_CPUS;
 extern const unsigned int FETCH_LOOKUP_MSG_MAX_RETRY;
 extern const uint32_t MAXSENDMESSAGE;
 extern const uint32_t MAXRECVMESSAGE;
 extern const unsigned int MAXRETRYCONN;
 extern const unsigned int MSGQUEUE_SIZE;
+extern const unsigned int MSGQUEUE_PRIORITY_SIZE;
+extern const uint32_t MAXRECVMESSAGE_PRIORITY;
 extern const unsigned int PUMPMESSAGE_MILLISECONDS;
 extern const unsigned int SENDQUEUE_SIZE;
+extern const unsigned int SENDQUEUE_PRIORITY_SIZE;
+extern const uint32_t MAXSENDMESSAGE_PRIORITY;
 extern const unsigned int MAX_GOSSIP_MSG_SIZE_IN_BYTES;
 extern const unsigned int MIN_READ_WATERMARK_IN_BYTES;
 extern const unsigned int MAX_READ_WATERMARK_IN_BYTES;
 extern const unsigned int BLACKLIST_NUM_TO_POP;
 extern const unsigned int MAX_PEER_CONNECTION;
 extern const unsigned int MAX_WHITELISTREQ_LIMIT;
+extern const bool SENDSOCKETPOOL_ENABLED;
+extern const unsigned int SENDSOCKETPOOL_IDLE_TIMEOUT_IN_SECONDS;
+extern const unsigned int SENDSOCKETPOOL_MAX_SOCKETS;
 
 // PoW constants
 extern const bool CUDA_GPU_MINE;
@@ -363,6 +394,11 @@ extern const bool DISABLE_SCILLA_LIB;
 
 // Test constants
 extern const bool ENABLE_CHECK_PERFORMANCE_LOG;
+extern const bool ENABLE_MESSAGE_TRACE;
+extern const std::string MESSAGE_TRACE_FILE;
+extern const bool ENABLE_SCILLA_PROFILE;
+extern const unsigned int SCILLA_PROFILE_SLOW_THRESHOLD_MICROS;
+extern const unsigned int EPOCH_TIME_SLO_MS;
 #ifdef FALLBACK_TEST
 extern const unsigned int FALLBACK_TEST_EPOCH;
 #endif  // FALLBACK_TEST
@@ -404,6 +440,11 @@ extern const unsigned int POST_VIEWCHANGE_BUFFER;
 extern const unsigned int VIEWCHANGE_EXTRA_TIME;
 extern const unsigned int VIEWCHANGE_PRECHECK_TIME;
 extern const unsigned int VIEWCHANGE_TIME;
+extern const bool ENABLE_ADAPTIVE_VIEWCHANGE_TIME;
+extern const unsigned int ADAPTIVE_VIEWCHANGE_EWMA_ALPHA_PERCENT;
+extern const unsigned int ADAPTIVE_VIEWCHANGE_MARGIN_PERCENT;
+extern const unsigned int ADAPTIVE_VIEWCHANGE_MIN_PERCENT;
+extern const unsigned int ADAPTIVE_VIEWCHANGE_MAX_PERCENT;
 
 // Genesis accounts
 extern const std::vector<std::string> GENESIS_WALLETS;
@@ -18,6 +18,8 @@
 #ifndef ZILLIQA_SRC_COMMON_MESSAGES_H_
 #define ZILLIQA_SRC_COMMON_MESSAGES_H_
 
+#include "BaseType.h"
+
 enum MessageOffset : unsigned int { TYPE = 0, INST = 1, BODY = 2 };
 
 enum NumberSign : unsigned char { POSITIVE = 0x00, NEGATIVE = 0x01 };
@@ -98,6 +100,25 @@ enum LookupInstructionType : unsigned char {
   SETMINERINFOFROMSEED = 0x20
 };
 
+/// Typed view over a raw message frame. The header is validated and read
+/// exactly once here, so the dispatch layers can work off the parsed fields
+/// instead of repeating bounds-checked byte reads on the buffer.
+struct MessageEnvelope {
+  unsigned char m_type = 0;
+  unsigned char m_instruction = 0;
+
+  /// Validates the frame header and fills in the envelope. Returns false
+  /// when the message is too short to carry a header.
+  static bool Parse(const bytes& message, MessageEnvelope& envelope) {
+    if (message.size() < MessageOffset::BODY) {
+      return false;
+    }
+    envelope.m_type = message[MessageOffset::TYPE];
+    envelope.m_instruction = message[MessageOffset::INST];
+    return true;
+  }
+};
+
 enum TxSharingMode : unsigned char {
   IDLE = 0x00,
   SEND_ONLY = 0x01,
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <random>
 
 #include <boost/functional/hash.hpp>
@@ -357,10 +358,13 @@ namespace dev
     }
 
     /// Fast std::hash compatible hash function object for h256.
+    /// h256 keys are already uniformly distributed (they are hash outputs),
+    /// so the first 8 bytes serve as the bucket hash directly with no mixing.
     template<> inline size_t FixedHash<32>::hash::operator()(FixedHash<32> const& value) const
     {
-        uint64_t const* data = reinterpret_cast<uint64_t const*>(value.data());
-        return boost::hash_range(data, data + 4);
+        uint64_t ret;
+        std::memcpy(&ret, value.data(), sizeof(ret));
+        return static_cast<size_t>(ret);
     }
 
     /// Stream I/O for the FixedHash class.
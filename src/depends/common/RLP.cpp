@@ -88,6 +88,22 @@ RLP RLP::operator[](size_t _i) const
     return RLP(m_lastItem, ThrowOnFail | FailIfTooSmall);
 }
 
+size_t RLP::itemViews(bytesConstRef* _out, size_t _max) const
+{
+    if (!isList())
+        return 0;
+    bytesConstRef d = payload();
+    size_t i = 0;
+    for (; d.size(); ++i)
+    {
+        size_t sz = sizeAsEncoded(d);
+        if (i < _max)
+            _out[i] = d.cropped(0, sz);
+        d = d.cropped(sz);
+    }
+    return i;
+}
+
 RLPs RLP::toList(int _flags) const
 {
     RLPs ret;
@@ -116,6 +116,13 @@ namespace dev
         size_t itemCount() const { return isList() ? items() : 0; }
         size_t itemCountStrict() const { if (!isList()) BOOST_THROW_EXCEPTION(BadCast()); return items(); }
 
+        /// Zero-copy enumeration of list items: fills at most @a _max views into
+        /// @a _out, each spanning one encoded item, in a single pass over the
+        /// payload, and @returns the total item count (zero if not a list).
+        /// itemCount() followed by operator[] rescans the payload on every call;
+        /// this decodes each item's length exactly once and materializes nothing.
+        size_t itemViews(bytesConstRef* _out, size_t _max) const;
+
         /// @returns the number of bytes in the data, or zero if it isn't data.
         size_t size() const { return isData() ? length() : 0; }
         size_t sizeStrict() const { if (!isData()) BOOST_THROW_EXCEPTION(BadCast()); return length(); }
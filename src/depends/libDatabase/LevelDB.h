@@ -19,9 +19,12 @@
 #ifndef __LEVELDB_H__
 #define __LEVELDB_H__
 
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <leveldb/db.h>
@@ -45,6 +48,14 @@ class LevelDB
 
     std::string m_open_db_path;
 
+    /// Group commit state: batches queued by concurrent writers, merged and
+    /// committed in one write by a single committer thread
+    using PendingBatch = std::pair<std::unordered_map<std::string, std::string>,
+                                   std::promise<bool>>;
+    std::mutex m_pendingBatchMutex;
+    std::vector<PendingBatch> m_pendingBatches;
+    bool m_committerScheduled = false;
+
 public:
 
     /// Constructor.
@@ -67,6 +78,10 @@ public:
     /// Returns the DB Name
     std::string GetDBName();
 
+    /// Returns the engine's level/compaction statistics ("leveldb.stats"),
+    /// or an empty string if the DB is not open
+    std::string GetDBStats() const;
+
     /// Returns the value at the specified key.
     std::string Lookup(const std::string & key) const;
 
@@ -82,6 +97,10 @@ public:
     /// Returns the value at the specified key.
     std::string Lookup(const dev::bytesConstRef & key) const;
 
+    /// Returns the values at the specified keys, all read from one snapshot.
+    /// A missing key yields an empty string at its position in the result.
+    std::vector<std::string> MultiLookup(const std::vector<dev::h256> & keys) const;
+
     /// Sets the value at the specified key.
     int Insert(const dev::h256 & key, dev::bytesConstRef value);
 
@@ -113,6 +132,13 @@ public:
                      const std::unordered_map<dev::h256, std::pair<dev::bytes, bool>> & m_aux);
     bool BatchInsert(const std::unordered_map<std::string, std::string>& kv_map);
 
+    /// Group-committed batch insert: the batch is queued and merged with the
+    /// batches of any concurrently enqueuing writers, then committed in one
+    /// write (one fsync when LEVELDB_SYNC_BATCH_WRITES is set). The returned
+    /// future resolves once the merged commit containing this batch is done.
+    std::future<bool> BatchInsertAsync(
+        std::unordered_map<std::string, std::string> kv_map);
+
     /// Remove the kv pair for multiple specified key.
     bool BatchDelete(const std::vector<dev::h256>& toDelete);
 
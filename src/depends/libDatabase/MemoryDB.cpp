@@ -90,14 +90,11 @@ namespace dev
         // WriteGuard l(x_this);
         unique_lock<shared_timed_mutex> lock(x_this);
 // #endif
-        auto it = m_main.find(_h);
-        if (it != m_main.end())
-        {
-            it->second.first = _v.toString();
-            it->second.second++;
-        }
-        else
-            m_main[_h] = make_pair(_v.toString(), 1);
+        // Single bucket probe; assign() writes into the entry's existing
+        // capacity instead of building a temporary string per node
+        auto& entry = m_main[_h];
+        entry.first.assign(reinterpret_cast<char const*>(_v.data()), _v.size());
+        entry.second++;
     }
 
     bool MemoryDB::kill(h256 const& _h)
@@ -106,15 +103,10 @@ namespace dev
         // ReadGuard l(x_this);
         shared_lock<shared_timed_mutex> lock(x_this);
 // #endif
-        if (m_main.count(_h))
-        {
-            m_main[_h].second = 0;
-            return true;
-        } else {
-            m_main[_h] = {"", 0};
-            return true;
-        }
-        return false;
+        // One probe covers both cases: zero the refcount if the node exists,
+        // otherwise record an empty dead entry (as before)
+        m_main[_h].second = 0;
+        return true;
     }
 
     bytes MemoryDB::lookupAux(h256 const& _h) const
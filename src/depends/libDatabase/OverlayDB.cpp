@@ -34,14 +34,74 @@ namespace dev
 
 	void OverlayDB::ResetDB()
 	{
+		clearNodeCache();
 		m_levelDB.ResetDB();
 	}
 
 	bool OverlayDB::RefreshDB()
 	{
+		clearNodeCache();
 		return m_levelDB.RefreshDB();
 	}
 
+	void OverlayDB::cacheNode(h256 const& _h, std::string const& _value) const
+	{
+		lock_guard<mutex> lock(m_nodeCacheMutex);
+
+		auto found = m_nodeCache.find(_h);
+		if (found != m_nodeCache.end())
+		{
+			m_nodeCacheOrder.splice(m_nodeCacheOrder.begin(), m_nodeCacheOrder,
+									found->second.second);
+			return;
+		}
+
+		m_nodeCacheOrder.emplace_front(_h);
+		m_nodeCache[_h] = make_pair(_value, m_nodeCacheOrder.begin());
+
+		while (m_nodeCache.size() > NODE_CACHE_MAX_ENTRIES)
+		{
+			m_nodeCache.erase(m_nodeCacheOrder.back());
+			m_nodeCacheOrder.pop_back();
+		}
+	}
+
+	bool OverlayDB::lookupCachedNode(h256 const& _h, std::string & _value) const
+	{
+		lock_guard<mutex> lock(m_nodeCacheMutex);
+
+		auto found = m_nodeCache.find(_h);
+		if (found == m_nodeCache.end())
+			return false;
+
+		m_nodeCacheOrder.splice(m_nodeCacheOrder.begin(), m_nodeCacheOrder,
+								found->second.second);
+		_value = found->second.first;
+		return true;
+	}
+
+	void OverlayDB::eraseCachedNodes(std::vector<h256> const& _hashes)
+	{
+		lock_guard<mutex> lock(m_nodeCacheMutex);
+
+		for (auto const& h: _hashes)
+		{
+			auto found = m_nodeCache.find(h);
+			if (found != m_nodeCache.end())
+			{
+				m_nodeCacheOrder.erase(found->second.second);
+				m_nodeCache.erase(found);
+			}
+		}
+	}
+
+	void OverlayDB::clearNodeCache()
+	{
+		lock_guard<mutex> lock(m_nodeCacheMutex);
+		m_nodeCache.clear();
+		m_nodeCacheOrder.clear();
+	}
+
 	bool OverlayDB::commit()
 	{
 		LOG_MARKER();
@@ -54,6 +114,7 @@ namespace dev
 			/// delete removed nodes in both mem and disk
 			std::vector<h256> purged;
 			purge(purged, false);
+			eraseCachedNodes(purged);
 			m_levelDB.BatchDelete(purged);
 
 			/// add newly created nodes in disk
@@ -101,10 +162,17 @@ namespace dev
 	std::string OverlayDB::lookup(h256 const& _h) const
 	{
 		std::string ret = MemoryDB::lookup(_h);
-	
-		if (ret.empty())
-			ret = m_levelDB.Lookup(_h);
-	
+
+		if (!ret.empty())
+			return ret;
+
+		if (lookupCachedNode(_h, ret))
+			return ret;
+
+		ret = m_levelDB.Lookup(_h);
+		if (!ret.empty())
+			cacheNode(_h, ret);
+
 		return ret;
 	}
 
@@ -113,6 +181,12 @@ namespace dev
 		if (MemoryDB::exists(_h))
 			return true;
 
+		{
+			lock_guard<mutex> lock(m_nodeCacheMutex);
+			if (m_nodeCache.find(_h) != m_nodeCache.end())
+				return true;
+		}
+
 		return m_levelDB.Exists(_h);
 	}
 
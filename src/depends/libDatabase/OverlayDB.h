@@ -19,7 +19,10 @@
 #ifndef __OVERLAYDB_H__
 #define __OVERLAYDB_H__
 
+#include <list>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "common/Constants.h"
 #include "depends/common/Common.h"
@@ -51,6 +54,22 @@ namespace dev
 	private:
 		using MemoryDB::clear;
 
+		// Bounded LRU cache over committed trie nodes. The store is keyed
+		// by node hash, so entries are content-addressed and can never go
+		// stale; the top levels of the trie are shared by every account
+		// path and would otherwise be re-read from disk on each walk.
+		static const unsigned int NODE_CACHE_MAX_ENTRIES = 4096;
+
+		void cacheNode(h256 const& _h, std::string const& _value) const;
+		bool lookupCachedNode(h256 const& _h, std::string & _value) const;
+		void eraseCachedNodes(std::vector<h256> const& _hashes);
+		void clearNodeCache();
+
+		mutable std::mutex m_nodeCacheMutex;
+		mutable std::list<h256> m_nodeCacheOrder;
+		mutable std::unordered_map<h256,
+			std::pair<std::string, std::list<h256>::iterator>> m_nodeCache;
+
 		LevelDB m_levelDB;
 	};
 }
@@ -20,6 +20,7 @@
 #define __TRIEDB_H__
 
 #include <memory>
+#include <unordered_map>
 
 #include "depends/common/Exceptions.h"
 #include "depends/common/SHA3.h"
@@ -90,6 +91,7 @@ namespace dev
         void setRoot(h256 const& _root, Verification _v = Verification::Normal)
         {
             m_root = _root;
+            m_nodeCache.clear();
             if (_v == Verification::Normal)
             {
                 if (m_root == EmptyTrie && !m_db->exists(m_root))
@@ -125,6 +127,14 @@ namespace dev
 
         std::string at(bytesConstRef _key) const;
 
+        /// Collects the raw RLP bytes of every hash-referenced node on the
+        /// lookup path of _key (root node first) and returns the value at
+        /// the leaf, empty when the key is absent. The node list is a
+        /// Merkle proof: a verifier replays the walk, checking that each
+        /// node hashes to the reference held by its parent (or, for the
+        /// first node, to the trusted root).
+        std::string proveAt(bytesConstRef _key, std::vector<bytes>& _proof) const;
+
         void insert(bytes const& _key, bytes const& _value)
         {
             insert(&_key, &_value);
@@ -278,6 +288,8 @@ namespace dev
 
         std::string atAux(RLP const& _here, NibbleSlice _key) const;
 
+        std::string proveAtAux(RLP const& _here, NibbleSlice _key, std::vector<bytes>& _proof) const;
+
         void mergeAtAux(RLPStream& _out, RLP const& _replace, NibbleSlice _key, bytesConstRef _value);
         bytes mergeAt(RLP const& _replace, NibbleSlice _k, bytesConstRef _v, bool _inLine = false);
         bytes mergeAt(RLP const& _replace, h256 const& _replaceHash, NibbleSlice _k, bytesConstRef _v, bool _inLine = false);
@@ -327,6 +339,24 @@ namespace dev
 
         std::string node(h256 const& _h) const { return m_db->lookup(_h); }
 
+        /// Fetch a node for the at()/atAux() lookup path, memoising the bytes.
+        /// Nodes are content-addressed so a hash always maps to the same bytes,
+        /// but every lookup re-fetches and re-parses the shared upper levels of
+        /// the trie from the backing DB. Entries are held by shared_ptr so the
+        /// bytes a recursive walk is parsing stay valid even if the map rehashes
+        /// mid-descent. The cache is flushed whenever m_root changes, since a
+        /// write may have killed nodes in the backing store.
+        std::shared_ptr<std::string const> cachedNode(h256 const& _h) const
+        {
+            auto it = m_nodeCache.find(_h);
+            if (it != m_nodeCache.end())
+                return it->second;
+            auto sp = std::make_shared<std::string const>(node(_h));
+            if (m_nodeCache.size() < c_nodeCacheMaxSize)
+                m_nodeCache.emplace(_h, sp);
+            return sp;
+        }
+
         // These are low-level node insertion functions that just go straight through into the DB.
         h256 forceInsertNode(bytesConstRef _v) { auto h = sha3(_v); forceInsertNode(h, _v); return h; }
         void forceInsertNode(h256 const& _h, bytesConstRef _v) { m_db->insert(_h, _v); }
@@ -341,6 +371,11 @@ namespace dev
 
         h256 m_root;
         DB* m_db = nullptr;
+
+        // Bound keeps the cache to the hot top levels of the trie; beyond it
+        // lookups fall through to the DB as before.
+        static const size_t c_nodeCacheMaxSize = 4096;
+        mutable std::unordered_map<h256, std::shared_ptr<std::string const>> m_nodeCache;
     };
 
     template <class DB>
@@ -375,6 +410,11 @@ namespace dev
             return Generic::at(bytesConstRef((byte const*)&_k, sizeof(KeyType)));
         }
 
+        std::string proveAt(KeyType _k, std::vector<bytes>& _proof) const
+        {
+            return Generic::proveAt(bytesConstRef((byte const*)&_k, sizeof(KeyType)), _proof);
+        }
+
         void insert(KeyType _k, bytesConstRef _value)
         {
 //            LOG_GENERAL(INFO, "Inserting to SpecificTrieDB Key : Value = " << _k << " : " << _value);
@@ -866,11 +906,13 @@ namespace dev
         if (rootValue.size() < 32)
             forceKillNode(m_root);
         m_root = forceInsertNode(&b);
+        m_nodeCache.clear();
     }
 
     template <class DB> std::string GenericTrieDB<DB>::at(bytesConstRef _key) const
     {
-        return atAux(RLP(node(m_root)), _key);
+        std::shared_ptr<std::string const> rootNode = cachedNode(m_root);
+        return atAux(RLP(*rootNode), _key);
     }
 
     template <class DB> std::string GenericTrieDB<DB>::atAux(RLP const& _here, NibbleSlice _key) const
@@ -878,7 +920,11 @@ namespace dev
         if (_here.isEmpty() || _here.isNull())
             // not found.
             return std::string();
-        unsigned itemCount = _here.itemCount();
+
+        // Decode every child view in one pass over the node's payload;
+        // itemCount() plus the operator[] accesses below used to rescan it.
+        bytesConstRef items[17];
+        unsigned itemCount = (unsigned)_here.itemViews(items, 17);
 
         if(!_here.isList() || (itemCount != 2 && itemCount != 17))
         {
@@ -889,13 +935,21 @@ namespace dev
 
         if (itemCount == 2)
         {
-            auto k = keyOf(_here);
-            if (_key == k && isLeaf(_here))
+            bytesConstRef hpe = RLP(items[0], RLP::ThrowOnFail | RLP::FailIfTooSmall).payload();
+            NibbleSlice k = keyOf(hpe);
+            bool leaf = (hpe[0] & 0x20) != 0;
+            RLP second(items[1], RLP::ThrowOnFail | RLP::FailIfTooSmall);
+            if (_key == k && leaf)
                 // reached leaf and it's us
-                return _here[1].toString();
-            else if (_key.contains(k) && !isLeaf(_here))
+                return second.toString();
+            else if (_key.contains(k) && !leaf)
+            {
                 // not yet at leaf and it might yet be us. onwards...
-                return atAux(_here[1].isList() ? _here[1] : RLP(node(_here[1].toHash<h256>())), _key.mid(k.size()));
+                if (second.isList())
+                    return atAux(second, _key.mid(k.size()));
+                std::shared_ptr<std::string const> child = cachedNode(second.toHash<h256>());
+                return atAux(RLP(*child), _key.mid(k.size()));
+            }
             else
                 // not us.
                 return std::string();
@@ -903,12 +957,77 @@ namespace dev
         else
         {
             if (_key.size() == 0)
-                return _here[16].toString();
-            auto n = _here[_key[0]];
+                return RLP(items[16], RLP::ThrowOnFail | RLP::FailIfTooSmall).toString();
+            RLP n(items[_key[0]], RLP::ThrowOnFail | RLP::FailIfTooSmall);
             if (n.isEmpty())
                 return std::string();
+            if (n.isList())
+                return atAux(n, _key.mid(1));
+            std::shared_ptr<std::string const> child = cachedNode(n.toHash<h256>());
+            return atAux(RLP(*child), _key.mid(1));
+        }
+    }
+
+    template <class DB> std::string GenericTrieDB<DB>::proveAt(bytesConstRef _key, std::vector<bytes>& _proof) const
+    {
+        std::shared_ptr<std::string const> rootNode = cachedNode(m_root);
+        _proof.emplace_back(rootNode->begin(), rootNode->end());
+        return proveAtAux(RLP(*rootNode), _key, _proof);
+    }
+
+    template <class DB> std::string GenericTrieDB<DB>::proveAtAux(RLP const& _here, NibbleSlice _key, std::vector<bytes>& _proof) const
+    {
+        // Same walk as atAux(), but every node fetched by hash is appended
+        // to _proof. Inline children live inside the bytes of the node
+        // already collected, so recursing into them adds nothing.
+        if (_here.isEmpty() || _here.isNull())
+            // not found.
+            return std::string();
+
+        bytesConstRef items[17];
+        unsigned itemCount = (unsigned)_here.itemViews(items, 17);
+
+        if(!_here.isList() || (itemCount != 2 && itemCount != 17))
+        {
+            LOG_GENERAL(FATAL,
+                        "assertion failed (" << __FILE__ << ":" << __LINE__ << ": "
+                                             << __FUNCTION__ << ")");
+        }
+
+        if (itemCount == 2)
+        {
+            bytesConstRef hpe = RLP(items[0], RLP::ThrowOnFail | RLP::FailIfTooSmall).payload();
+            NibbleSlice k = keyOf(hpe);
+            bool leaf = (hpe[0] & 0x20) != 0;
+            RLP second(items[1], RLP::ThrowOnFail | RLP::FailIfTooSmall);
+            if (_key == k && leaf)
+                // reached leaf and it's us
+                return second.toString();
+            else if (_key.contains(k) && !leaf)
+            {
+                // not yet at leaf and it might yet be us. onwards...
+                if (second.isList())
+                    return proveAtAux(second, _key.mid(k.size()), _proof);
+                std::shared_ptr<std::string const> child = cachedNode(second.toHash<h256>());
+                _proof.emplace_back(child->begin(), child->end());
+                return proveAtAux(RLP(*child), _key.mid(k.size()), _proof);
+            }
             else
-                return atAux(n.isList() ? n : RLP(node(n.toHash<h256>())), _key.mid(1));
+                // not us.
+                return std::string();
+        }
+        else
+        {
+            if (_key.size() == 0)
+                return RLP(items[16], RLP::ThrowOnFail | RLP::FailIfTooSmall).toString();
+            RLP n(items[_key[0]], RLP::ThrowOnFail | RLP::FailIfTooSmall);
+            if (n.isEmpty())
+                return std::string();
+            if (n.isList())
+                return proveAtAux(n, _key.mid(1), _proof);
+            std::shared_ptr<std::string const> child = cachedNode(n.toHash<h256>());
+            _proof.emplace_back(child->begin(), child->end());
+            return proveAtAux(RLP(*child), _key.mid(1), _proof);
         }
     }
 
@@ -1029,6 +1148,7 @@ namespace dev
             if (rv.size() < 32)
                 forceKillNode(m_root);
             m_root = forceInsertNode(&b);
+            m_nodeCache.clear();
         }
     }
 
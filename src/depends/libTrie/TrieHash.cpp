@@ -13,9 +13,14 @@
 */
 // adapted from https://github.com/ethereum/cpp-ethereum/blob/develop/libdevcore/TrieHash.cpp
 
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "depends/libDatabase/MemoryDB.h"
+#include "libUtils/ThreadPool.h"
 #include "TrieHash.h"
 #include "TrieCommon.h"
 #include "TrieDB.h"	// @TODO replace ASAP!
@@ -109,6 +114,94 @@ namespace dev
         return sha3(rlp256(_s));
     }
 
+    namespace
+    {
+        // below this the fan-out/join overhead outweighs the hashing itself
+        const size_t c_parallelTrieHashMinItems = 64;
+    }
+
+    h256 hash256Parallel(BytesMap const& _s)
+    {
+        if (_s.size() < c_parallelTrieHashMinItems)
+            return hash256(_s);
+
+        HexMap hexMap;
+        for (auto i = _s.rbegin(); i != _s.rend(); ++i)
+            hexMap[asNibbles(bytesConstRef(&i->first))] = i->second;
+
+        auto begin = hexMap.cbegin();
+        auto end = hexMap.cend();
+
+        // Parallelism only pays off when the root is a branch node, i.e. the
+        // keys already diverge at the first nibble. The map is ordered, so it
+        // suffices to compare the first and last keys.
+        if (!begin->first.empty() && begin->first[0] == std::prev(end)->first[0])
+        {
+            RLPStream s;
+            hash256rlp(hexMap, begin, end, 0, s);
+            return sha3(s.out());
+        }
+
+        // Partition at the top nibble, exactly as the 17-item case of
+        // hash256rlp does, but build each subtree's fragment concurrently.
+        static ThreadPool pool(
+            std::min(16u, std::max(2u, std::thread::hardware_concurrency())),
+            "TrieHash");
+
+        std::array<bytes, 16> children;
+        std::mutex doneMutex;
+        std::condition_variable doneCond;
+        unsigned pending = 0;
+
+        auto b = begin;
+        if (b->first.size() == 0)
+            ++b;
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            auto n = b;
+            for (; n != end && n->first[0] == i; ++n) {}
+            if (b != n)
+            {
+                {
+                    std::lock_guard<std::mutex> g(doneMutex);
+                    ++pending;
+                }
+                pool.AddJob([&hexMap, &children, &doneMutex, &doneCond, &pending, i, b, n]()
+                {
+                    RLPStream sub;
+                    hash256aux(hexMap, b, n, 1, sub);
+                    children[i] = sub.out();
+                    {
+                        std::lock_guard<std::mutex> g(doneMutex);
+                        --pending;
+                    }
+                    doneCond.notify_one();
+                });
+            }
+            b = n;
+        }
+
+        {
+            std::unique_lock<std::mutex> g(doneMutex);
+            doneCond.wait(g, [&pending]() { return pending == 0; });
+        }
+
+        RLPStream s;
+        s.appendList(17);
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            if (children[i].empty())
+                s << "";
+            else
+                s.appendRaw(&children[i], 1);
+        }
+        if (begin->first.size() == 0)
+            s << begin->second;
+        else
+            s << "";
+        return sha3(s.out());
+    }
+
     h256 orderedTrieRoot(std::vector<bytes> const& _data)
     {
         BytesMap m;
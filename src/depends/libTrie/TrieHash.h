@@ -32,6 +32,12 @@ namespace dev
     bytes rlp256(BytesMap const& _s);
     h256 hash256(BytesMap const& _s);
 
+    /// Identical output to hash256(), but when the root is a branch node the
+    /// ordered key space is partitioned at the top nibble and the 16 subtrees
+    /// are hashed concurrently, merging at the root. Falls back to the
+    /// sequential builder for small or single-subtree inputs.
+    h256 hash256Parallel(BytesMap const& _s);
+
     h256 orderedTrieRoot(std::vector<bytes> const& _data);
 
     template <class T, class U> inline h256 trieRootOver(unsigned _itemCount, T const & _getKey, U const & _getValue)
@@ -99,8 +99,8 @@ bool ConsensusBackup::ProcessMessageAnnounce(const bytes& announcement,
 
         // Unicast to the leader
         // =====================
-        P2PComm::GetInstance().SendMessage(
-            GetCommitteeMember(m_leaderID).second, commitFailureMsg);
+        UnicastConsensusMsg(GetCommitteeMember(m_leaderID).second,
+                            commitFailureMsg);
 
         return true;
       }
@@ -124,8 +124,7 @@ bool ConsensusBackup::ProcessMessageAnnounce(const bytes& announcement,
 
     // Unicast to the leader
     // =====================
-    P2PComm::GetInstance().SendMessage(GetCommitteeMember(m_leaderID).second,
-                                       commit);
+    UnicastConsensusMsg(GetCommitteeMember(m_leaderID).second, commit);
   }
   return result;
 }
@@ -263,8 +262,7 @@ bool ConsensusBackup::ProcessMessageChallengeCore(
     // Unicast to the leader
     // =====================
 
-    P2PComm::GetInstance().SendMessage(GetCommitteeMember(m_leaderID).second,
-                                       response);
+    UnicastConsensusMsg(GetCommitteeMember(m_leaderID).second, response);
 
     return true;
   }
@@ -361,8 +359,7 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(
 
       // Unicast to the leader
       // =====================
-      P2PComm::GetInstance().SendMessage(GetCommitteeMember(m_leaderID).second,
-                                         finalcommit);
+      UnicastConsensusMsg(GetCommitteeMember(m_leaderID).second, finalcommit);
     }
   } else {
     // Save the collective sig over the second round
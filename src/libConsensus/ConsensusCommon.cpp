@@ -80,10 +80,100 @@ ConsensusCommon::ConsensusCommon(uint32_t consensus_id, uint64_t block_number,
       m_committee(committee),
       m_classByte(class_byte),
       m_insByte(ins_byte),
-      m_responseMap(committee.size(), false) {}
+      m_responseMap(committee.size(), false) {
+  m_state.SetBlockNumber(block_number);
+
+  // Tag the DS-level round kinds whose completion times drive the adaptive
+  // view-change timeout
+  if (class_byte == static_cast<unsigned char>(DIRECTORY)) {
+    switch (ins_byte) {
+      case static_cast<unsigned char>(DSBLOCKCONSENSUS):
+        m_state.SetAdaptiveRound(ConsensusTimeouts::DSBLOCK);
+        break;
+      case static_cast<unsigned char>(FINALBLOCKCONSENSUS):
+        m_state.SetAdaptiveRound(ConsensusTimeouts::FINALBLOCK);
+        break;
+      case static_cast<unsigned char>(VIEWCHANGECONSENSUS):
+        m_state.SetAdaptiveRound(ConsensusTimeouts::VIEWCHANGE);
+        break;
+      default:
+        break;
+    }
+  }
+}
 
 ConsensusCommon::~ConsensusCommon() {}
 
+// string literals for the phase field of consensus state spans, indexed by
+// ConsensusCommon::State
+static const char* const CONSENSUS_STATE_SPAN_NAMES[] = {
+    "Consensus_INITIAL",
+    "Consensus_ANNOUNCE_DONE",
+    "Consensus_COMMIT_DONE",
+    "Consensus_CHALLENGE_DONE",
+    "Consensus_RESPONSE_DONE",
+    "Consensus_COLLECTIVESIG_DONE",
+    "Consensus_FINALCOMMIT_DONE",
+    "Consensus_FINALCHALLENGE_DONE",
+    "Consensus_FINALRESPONSE_DONE",
+    "Consensus_DONE",
+    "Consensus_ERROR"};
+
+ConsensusCommon::TrackedState& ConsensusCommon::TrackedState::operator=(
+    const State newState) {
+  const State oldState = m_current.exchange(newState);
+
+  if (oldState == newState) {
+    return *this;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  const uint64_t durationMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - m_entered)
+          .count();
+  EpochPhaseTracker::GetInstance().RecordSpan(
+      CONSENSUS_STATE_SPAN_NAMES[oldState], m_blockNumber,
+      m_enteredTimestampMicros, durationMicros);
+  m_entered = now;
+  m_enteredTimestampMicros = EpochPhaseTracker::NowMicros();
+
+  if (newState == DONE && m_adaptiveRound != ConsensusTimeouts::NUM_ROUNDS) {
+    ConsensusTimeouts::GetInstance().RecordRound(
+        m_adaptiveRound, std::chrono::duration_cast<std::chrono::milliseconds>(
+                             now - m_roundStart)
+                             .count());
+  }
+
+  return *this;
+}
+
+void ConsensusCommon::SetTransport(const UnicastFunc& unicast,
+                                   const MulticastFunc& multicast) {
+  m_unicastFunc = unicast;
+  m_multicastFunc = multicast;
+}
+
+void ConsensusCommon::UnicastConsensusMsg(const Peer& peer,
+                                          const bytes& message) {
+  if (m_unicastFunc) {
+    m_unicastFunc(peer, message);
+    return;
+  }
+
+  P2PComm::GetInstance().SendMessage(peer, message);
+}
+
+void ConsensusCommon::MulticastConsensusMsg(const deque<Peer>& peers,
+                                            bytes&& message) {
+  if (m_multicastFunc) {
+    m_multicastFunc(peers, message);
+    return;
+  }
+
+  P2PComm::GetInstance().SendMessage(peers, move(message), START_BYTE_NORMAL,
+                                     true);
+}
+
 Signature ConsensusCommon::SignMessage(const bytes& msg, unsigned int offset,
                                        unsigned int size) {
   LOG_MARKER();
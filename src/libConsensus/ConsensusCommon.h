@@ -18,6 +18,8 @@
 #ifndef ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSCOMMON_H_
 #define ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSCOMMON_H_
 
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -26,7 +28,9 @@
 #include <vector>
 
 #include <MultiSig.h>
+#include "libConsensus/ConsensusTimeouts.h"
 #include "libNetwork/ShardStruct.h"
+#include "libUtils/EpochPhaseTracker.h"
 #include "libUtils/TimeLockedFunction.h"
 
 struct ChallengeSubsetInfo {
@@ -92,6 +96,16 @@ class ConsensusCommon {
 
   static std::map<ConsensusErrorCode, std::string> CONSENSUSERRORMSG;
 
+  /// Transport overrides: consensus messages normally leave through P2PComm,
+  /// but an in-process harness (tests/Consensus/consensus_sim) can reroute
+  /// them over an in-memory fabric. When set, the overrides also take
+  /// precedence over gossip broadcast.
+  using UnicastFunc = std::function<void(const Peer& peer, const bytes& message)>;
+  using MulticastFunc =
+      std::function<void(const std::deque<Peer>& peers, const bytes& message)>;
+  void SetTransport(const UnicastFunc& unicast,
+                    const MulticastFunc& multicast);
+
  protected:
   enum ConsensusMessageType : unsigned char {
     ANNOUNCE = 0x00,
@@ -107,8 +121,36 @@ class ConsensusCommon {
     CONSENSUSFAILURE = 0x10,
   };
 
+  /// Wraps the consensus state so that every assignment records the time
+  /// spent in the outgoing state with EpochPhaseTracker. Assignments are
+  /// serialized by the owning consensus object's mutex; reads stay atomic.
+  /// When the session is tagged with an adaptive-timeout round kind, the
+  /// transition to DONE also reports the full round duration to
+  /// ConsensusTimeouts.
+  class TrackedState {
+   public:
+    void SetBlockNumber(const uint64_t blockNumber) {
+      m_blockNumber = blockNumber;
+    }
+    void SetAdaptiveRound(const ConsensusTimeouts::Round round) {
+      m_adaptiveRound = round;
+    }
+    operator State() const { return m_current.load(); }
+    TrackedState& operator=(const State newState);
+
+   private:
+    std::atomic<State> m_current{};
+    uint64_t m_blockNumber = 0;
+    ConsensusTimeouts::Round m_adaptiveRound = ConsensusTimeouts::NUM_ROUNDS;
+    std::chrono::steady_clock::time_point m_roundStart =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point m_entered =
+        std::chrono::steady_clock::now();
+    uint64_t m_enteredTimestampMicros = EpochPhaseTracker::NowMicros();
+  };
+
   /// State of the active consensus session.
-  std::atomic<State> m_state{};
+  TrackedState m_state{};
 
   /// State of the active consensus session.
   ConsensusErrorCode m_consensusErrorCode;
@@ -200,6 +242,21 @@ class ConsensusCommon {
 
   PairOfNode GetCommitteeMember(const unsigned int index);
 
+  /// Sends a consensus message to one committee member (usually the leader)
+  void UnicastConsensusMsg(const Peer& peer, const bytes& message);
+
+  /// Sends a consensus message to a set of committee members
+  void MulticastConsensusMsg(const std::deque<Peer>& peers, bytes&& message);
+
+  /// True when SetTransport rerouted this instance off P2PComm
+  bool TransportOverridden() const {
+    return static_cast<bool>(m_multicastFunc);
+  }
+
+  /// empty unless overridden via SetTransport
+  UnicastFunc m_unicastFunc;
+  MulticastFunc m_multicastFunc;
+
  public:
   /// Consensus message processing function
   virtual bool ProcessMessage([[gnu::unused]] const bytes& message,
@@ -129,11 +129,15 @@ void ConsensusLeader::GenerateConsensusSubsets() {
     fill(subset.commitMap.begin(), subset.commitMap.end(), false);
     subset.commitPointMap.resize(m_committee.size());
     subset.commitPoints.clear();
+    // each subset collects exactly m_numForConsensus commits and responses;
+    // reserving upfront avoids reallocation while the round is in flight
+    subset.commitPoints.reserve(m_numForConsensus);
     subset.responseCounter = 0;
     subset.responseDataMap.resize(m_committee.size());
     subset.responseMap.resize(m_committee.size());
     fill(subset.responseMap.begin(), subset.responseMap.end(), false);
     subset.responseData.clear();
+    subset.responseData.reserve(m_numForConsensus);
 
     subset.state = m_state;
     // add myself to subset commit map always
@@ -211,6 +215,10 @@ void ConsensusLeader::GenerateConsensusSubsets() {
 bool ConsensusLeader::StartConsensusSubsets() {
   LOG_MARKER();
 
+  // Note: the block content itself is announced once in StartConsensus;
+  // the subsets only add one combined challenge message below, whose
+  // per-subset entries are just the aggregated commit and challenge points
+
   ConsensusMessageType type = ConsensusMessageType::CHALLENGE;
   // Update overall internal state
   if (m_state == ANNOUNCE_DONE) {
@@ -262,8 +270,7 @@ bool ConsensusLeader::StartConsensusSubsets() {
   // Shuffle the peer list so we don't always send challenges in same sequence
   random_shuffle(peerInfo.begin(), peerInfo.end());
 
-  P2PComm::GetInstance().SendMessage(peerInfo, challenge, START_BYTE_NORMAL,
-                                     true);
+  MulticastConsensusMsg(peerInfo, move(challenge));
 
   return true;
 }
@@ -328,17 +335,24 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     [[gnu::unused]] State nextstate, const Peer& from) {
   LOG_MARKER();
 
-  lock_guard<mutex> g(m_mutex);
-
   // Initial checks
   // ==============
 
-  if (!CheckState(action)) {
-    return false;
+  {
+    lock_guard<ProfiledMutex> g(m_mutex);
+    if (!CheckState(action)) {
+      return false;
+    }
   }
 
   // Extract and check commit message body
   // =====================================
+  // Deserialization, point decompression and the commit hash recomputation
+  // are the expensive part of commit intake; do them outside m_mutex so
+  // commits from different backups are validated concurrently on the
+  // dispatcher threads instead of being serialized behind the lock. The
+  // fields read here (consensus ID, block number/hash, committee) are fixed
+  // for the lifetime of the round.
 
   uint16_t backupID = 0;
 
@@ -360,11 +374,6 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     return false;
   }
 
-  if (m_commitMap.at(backupID)) {
-    LOG_GENERAL(WARNING, "Backup already sent commit");
-    return false;
-  }
-
   // Check the commit
   if (!commitPoint.Initialized()) {
     LOG_GENERAL(WARNING, "Invalid commit");
@@ -388,10 +397,17 @@ bool ConsensusLeader::ProcessMessageCommitCore(
   // Update internal state
   // =====================
 
+  lock_guard<ProfiledMutex> g(m_mutex);
+
   if (!CheckState(action)) {
     return false;
   }
 
+  if (m_commitMap.at(backupID)) {
+    LOG_GENERAL(WARNING, "Backup already sent commit");
+    return false;
+  }
+
   // 33-byte commit
   m_commitPoints.emplace_back(commitPoint);
   m_commitPointMap.at(backupID) = commitPoint;
@@ -485,8 +501,7 @@ bool ConsensusLeader::ProcessMessageCommitFailure(const bytes& commitFailureMsg,
       peerInfo.push_back(i.second);
     }
 
-    P2PComm::GetInstance().SendMessage(peerInfo, consensusFailureMsg,
-                                       START_BYTE_NORMAL, true);
+    MulticastConsensusMsg(peerInfo, move(consensusFailureMsg));
     auto main_func = [this]() mutable -> void {
       if (m_shardCommitFailureHandlerFunc != nullptr) {
         m_shardCommitFailureHandlerFunc(m_commitFailureMap);
@@ -591,6 +606,9 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     return false;
   }
 
+  bytes collectivesigToSend;
+  bool startFinalCommitWindow = false;
+
   for (unsigned int subsetID = 0; subsetID < subsetInfo.size(); subsetID++) {
     // Check subset state
     if (!CheckStateSubset(subsetID, action)) {
@@ -631,7 +649,7 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     // Update internal state
     // =====================
 
-    lock_guard<mutex> g(m_mutex);
+    lock_guard<ProfiledMutex> g(m_mutex);
     if (!CheckState(action)) {
       return false;
     }
@@ -710,56 +728,65 @@ bool ConsensusLeader::ProcessMessageResponseCore(
       // Subset has finished consensus! Either Round 1 or Round 2
       SubsetEnded(subsetID);
 
-      // Multicast to all nodes in the committee
-      // =======================================
+      // The multicast and the final-commit window are handled below, after
+      // the lock scope ends: gossiping hashes the whole message under the
+      // rumor manager's own locks, and blocking response/commit intake on
+      // m_mutex for that only lengthens the consensus tail
+      collectivesigToSend = move(collectivesig);
+      startFinalCommitWindow =
+          (m_state == COLLECTIVESIG_DONE) && (m_numOfSubsets > 1);
+
+      break;
+    }
+  }
 
-      deque<Peer> peerInfo;
+  if (!collectivesigToSend.empty()) {
+    // Multicast to all nodes in the committee
+    // =======================================
 
-      for (auto const& i : m_committee) {
-        peerInfo.push_back(i.second);
-      }
+    deque<Peer> peerInfo;
 
-      if (BROADCAST_GOSSIP_MODE) {
-        P2PComm::GetInstance().SpreadRumor(collectivesig);
-      } else {
-        P2PComm::GetInstance().SendMessage(peerInfo, collectivesig,
-                                           START_BYTE_NORMAL, true);
-      }
+    for (auto const& i : m_committee) {
+      peerInfo.push_back(i.second);
+    }
 
-      if ((m_state == COLLECTIVESIG_DONE) && (m_numOfSubsets > 1)) {
-        // Start timer for accepting final commits
-        // =================================
-        auto func = [this]() -> void {
-          std::unique_lock<std::mutex> cv_lk(m_mutexAnnounceSubsetConsensus);
-          m_sufficientCommitsReceived = false;
-          if (cv_scheduleSubsetConsensus.wait_for(
-                  cv_lk, std::chrono::seconds(COMMIT_WINDOW_IN_SECONDS),
-                  [&] { return m_sufficientCommitsReceived; })) {
-            LOG_GENERAL(INFO, "Sufficient final commits within window")
-          } else {
-            LOG_GENERAL(INFO, "Timeout - Final Commit window closed");
-          }
-          if (m_commitCounter < m_numForConsensus) {
-            LOG_GENERAL(WARNING,
-                        "Insufficient final commits. Required "
-                        "= " << m_numForConsensus
-                             << " Actual = " << m_commitCounter);
-            m_state = ERROR;
-          } else {
-            LOG_GENERAL(INFO, "Sufficient final commits. Required = "
-                                  << m_numForConsensus
-                                  << " Actual = " << m_commitCounter);
-            lock_guard<mutex> g(m_mutex);
-            GenerateConsensusSubsets();
-            if (!StartConsensusSubsets()) {
-              LOG_GENERAL(WARNING, "StartConsensusSubsets failed");
-            }
-          }
-        };
-        DetachedFunction(1, func);
-      }
+    if (BROADCAST_GOSSIP_MODE && !TransportOverridden()) {
+      P2PComm::GetInstance().SpreadRumor(collectivesigToSend);
+    } else {
+      MulticastConsensusMsg(peerInfo, move(collectivesigToSend));
+    }
 
-      break;
+    if (startFinalCommitWindow) {
+      // Start timer for accepting final commits
+      // =================================
+      auto func = [this]() -> void {
+        std::unique_lock<std::mutex> cv_lk(m_mutexAnnounceSubsetConsensus);
+        m_sufficientCommitsReceived = false;
+        if (cv_scheduleSubsetConsensus.wait_for(
+                cv_lk, std::chrono::seconds(COMMIT_WINDOW_IN_SECONDS),
+                [&] { return m_sufficientCommitsReceived; })) {
+          LOG_GENERAL(INFO, "Sufficient final commits within window")
+        } else {
+          LOG_GENERAL(INFO, "Timeout - Final Commit window closed");
+        }
+        if (m_commitCounter < m_numForConsensus) {
+          LOG_GENERAL(WARNING,
+                      "Insufficient final commits. Required "
+                      "= " << m_numForConsensus
+                           << " Actual = " << m_commitCounter);
+          m_state = ERROR;
+        } else {
+          LOG_GENERAL(INFO, "Sufficient final commits. Required = "
+                                << m_numForConsensus
+                                << " Actual = " << m_commitCounter);
+          lock_guard<ProfiledMutex> g(m_mutex);
+          GenerateConsensusSubsets();
+          if (!StartConsensusSubsets()) {
+            LOG_GENERAL(WARNING, "StartConsensusSubsets failed");
+          }
+        }
+      };
+      DetachedFunction(1, func);
     }
   }
 
@@ -868,6 +895,7 @@ ConsensusLeader::ConsensusLeader(
 
   // Add the leader to the commits
   m_commitMap.at(m_myID) = true;
+  m_commitPoints.reserve(committee.size());
   m_commitPoints.emplace_back(*m_commitPoint);
   m_commitPointMap.at(m_myID) = *m_commitPoint;
   m_commitCounter = 1;
@@ -929,7 +957,7 @@ bool ConsensusLeader::StartConsensus(
   // Multicast to all nodes in the committee
   // =======================================
 
-  if (useGossipProto) {
+  if (useGossipProto && !TransportOverridden()) {
     P2PComm::GetInstance().SpreadRumor(announcement_message);
   } else {
     std::deque<Peer> peer;
@@ -938,8 +966,7 @@ bool ConsensusLeader::StartConsensus(
       peer.push_back(i.second);
     }
 
-    P2PComm::GetInstance().SendMessage(peer, announcement_message,
-                                       START_BYTE_NORMAL, true);
+    MulticastConsensusMsg(peer, move(announcement_message));
   }
 
   if (m_numOfSubsets > 1) {
@@ -965,7 +992,7 @@ bool ConsensusLeader::StartConsensus(
         LOG_GENERAL(INFO, "Sufficient commits. Required = " << m_numForConsensus
                                                             << " Actual = "
                                                             << m_commitCounter);
-        lock_guard<mutex> g(m_mutex);
+        lock_guard<ProfiledMutex> g(m_mutex);
         GenerateConsensusSubsets();
         StartConsensusSubsets();
       }
@@ -1012,7 +1039,7 @@ bool ConsensusLeader::ProcessMessage(const bytes& message, unsigned int offset,
 void ConsensusLeader::Audit() {
   LOG_MARKER();
 
-  lock_guard<mutex> g(m_mutex);
+  lock_guard<ProfiledMutex> g(m_mutex);
 
   for (unsigned int subsetID = 0; subsetID < m_consensusSubsets.size();
        subsetID++) {
@@ -26,6 +26,7 @@
 
 #include <MultiSig.h>
 #include "ConsensusCommon.h"
+#include "libUtils/LockProfiler.h"
 #include "libUtils/TimeLockedFunction.h"
 
 typedef std::function<bool(const bytes& errorMsg, const Peer& from)>
@@ -56,7 +57,7 @@ class ConsensusLeader : public ConsensusCommon {
   bool m_DS;
   unsigned int m_numOfSubsets;
   // Received commits
-  std::mutex m_mutex;
+  ProfiledMutex m_mutex{"ConsensusLeader::m_mutex"};
   std::atomic<unsigned int> m_commitCounter{0};
 
   std::mutex m_mutexAnnounceSubsetConsensus;
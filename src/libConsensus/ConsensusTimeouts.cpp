@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ConsensusTimeouts.h"
+
+#include <algorithm>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+void ConsensusTimeouts::RecordRound(const Round round,
+                                    const uint64_t durationMillis) {
+  if (!ENABLE_ADAPTIVE_VIEWCHANGE_TIME || round >= NUM_ROUNDS) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  uint64_t& ewma = m_ewmaMillis[round];
+  if (ewma == 0) {
+    ewma = durationMillis;
+  } else {
+    ewma = (ADAPTIVE_VIEWCHANGE_EWMA_ALPHA_PERCENT * durationMillis +
+            (100 - ADAPTIVE_VIEWCHANGE_EWMA_ALPHA_PERCENT) * ewma) /
+           100;
+  }
+}
+
+unsigned int ConsensusTimeouts::GetViewChangeTimeout(const Round round) const {
+  if (!ENABLE_ADAPTIVE_VIEWCHANGE_TIME || round >= NUM_ROUNDS) {
+    return VIEWCHANGE_TIME;
+  }
+
+  uint64_t ewmaMillis = 0;
+  {
+    lock_guard<mutex> g(m_mutex);
+    ewmaMillis = m_ewmaMillis[round];
+  }
+  if (ewmaMillis == 0) {
+    return VIEWCHANGE_TIME;
+  }
+
+  const uint64_t marginedSeconds =
+      (ewmaMillis * ADAPTIVE_VIEWCHANGE_MARGIN_PERCENT) / (100 * 1000);
+  const uint64_t floorSeconds = (static_cast<uint64_t>(VIEWCHANGE_TIME) *
+                                 ADAPTIVE_VIEWCHANGE_MIN_PERCENT) /
+                                100;
+  const uint64_t capSeconds = (static_cast<uint64_t>(VIEWCHANGE_TIME) *
+                               ADAPTIVE_VIEWCHANGE_MAX_PERCENT) /
+                              100;
+  const uint64_t timeout =
+      max(floorSeconds, min(capSeconds, marginedSeconds));
+
+  LOG_GENERAL(DEBUG, "Adaptive view-change timeout for round "
+                         << round << " = " << timeout << "s (EWMA "
+                         << ewmaMillis << "ms)");
+
+  return static_cast<unsigned int>(timeout);
+}
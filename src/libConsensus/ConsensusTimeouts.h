@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSTIMEOUTS_H_
+#define ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSTIMEOUTS_H_
+
+#include <cstdint>
+#include <mutex>
+
+#include "common/Singleton.h"
+
+/// Adapts the view-change timeout to the consensus round times observed on
+/// this node. Every completed round feeds an EWMA per round kind; the
+/// timeout handed to the view-change watchers is a safety margin over that
+/// average, clamped to a bounded band around the configured VIEWCHANGE_TIME
+/// so a run of unusually fast (or slow) rounds can never push the timeout
+/// to an unsafe value. The timeout only governs this node's local wait
+/// before proposing a view change - correctness does not require nodes to
+/// agree on its exact value - so each node adapts from its own observations
+/// within the shared clamp band. Disabled (returning VIEWCHANGE_TIME
+/// verbatim) unless ENABLE_ADAPTIVE_VIEWCHANGE_TIME is set.
+class ConsensusTimeouts : public Singleton<ConsensusTimeouts> {
+  friend class Singleton<ConsensusTimeouts>;
+
+ public:
+  enum Round : unsigned int {
+    DSBLOCK = 0,
+    FINALBLOCK,
+    VIEWCHANGE,
+    NUM_ROUNDS,
+  };
+
+  /// Feeds one completed round's duration into the round kind's average
+  void RecordRound(const Round round, const uint64_t durationMillis);
+
+  /// Returns the view-change timeout in seconds for the round kind
+  unsigned int GetViewChangeTimeout(const Round round) const;
+
+ private:
+  ConsensusTimeouts() = default;
+
+  mutable std::mutex m_mutex;
+  /// EWMA of round completion time per round kind; zero until first sample
+  uint64_t m_ewmaMillis[NUM_ROUNDS] = {};
+};
+
+#endif  // ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSTIMEOUTS_H_
@@ -20,6 +20,7 @@
 
 #include <openssl/sha.h>
 #include <vector>
+#include "depends/common/Common.h"
 #include "libUtils/Logger.h"
 
 /// List of supported hash variants.
@@ -60,6 +61,28 @@ class SHA2 {
     SHA256_Update(&m_context, input.data(), input.size());
   }
 
+  /// Hash update function over a raw buffer, for callers that parse messages
+  /// in place and have no bytes vector to hand over.
+  void Update(const unsigned char* input, unsigned int size) {
+    if (input == NULL || size == 0) {
+      LOG_GENERAL(WARNING, "Nothing to update");
+      return;
+    }
+
+    SHA256_Update(&m_context, input, size);
+  }
+
+  /// Hash update function over a view, so callers can stream the pieces of
+  /// a larger payload without concatenating them into a temporary vector.
+  void Update(dev::bytesConstRef input) {
+    if (input.empty()) {
+      LOG_GENERAL(WARNING, "Nothing to update");
+      return;
+    }
+
+    SHA256_Update(&m_context, input.data(), input.size());
+  }
+
   /// Hash update function.
   void Update(const bytes& input, unsigned int offset, unsigned int size) {
     if ((offset + size) > input.size()) {
@@ -73,6 +96,15 @@ class SHA2 {
   /// Resets the algorithm.
   void Reset() { SHA256_Init(&m_context); }
 
+  /// Returns a per-thread instance, already Reset for a fresh hash. One-shot
+  /// callers in loops reuse its output buffer instead of allocating a new
+  /// instance per hash.
+  static SHA2& GetReusableInstance() {
+    static thread_local SHA2 instance;
+    instance.Reset();
+    return instance;
+  }
+
   /// Hash finalize function.
   bytes Finalize() {
     switch (SIZE) {
@@ -449,6 +449,18 @@ const bytes Account::GetCode() const {
   return m_codeCache;
 }
 
+std::shared_ptr<const bytes> Account::GetCodeShared() const {
+  if (!isContract()) {
+    return std::make_shared<const bytes>();
+  }
+
+  if (m_codeCache.empty()) {
+    return ContractStorage2::GetContractStorage().GetContractCodeShared(
+        m_address, GetCodeHash());
+  }
+  return std::make_shared<const bytes>(m_codeCache);
+}
+
 bool Account::GetContractAuxiliaries(bool& is_library, uint32_t& scilla_version,
                                      std::vector<Address>& extlibs) {
   if (!isContract()) {
@@ -21,6 +21,7 @@
 #include <json/json.h>
 #include <leveldb/db.h>
 #include <array>
+#include <memory>
 
 #include "Address.h"
 #include "common/Constants.h"
@@ -168,6 +169,10 @@ class Account : public AccountBase {
 
   const bytes GetCode() const;
 
+  /// copy-free variant of GetCode: returns a shared immutable blob served
+  /// from the code-hash-keyed cache in ContractStorage2
+  std::shared_ptr<const bytes> GetCodeShared() const;
+
   bool SetInitData(const bytes& initData);
 
   const bytes GetInitData() const;
@@ -15,8 +15,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <leveldb/db.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "AccountStore.h"
 #include "libCrypto/Sha2.h"
 #include "libMessage/Messenger.h"
@@ -70,7 +74,7 @@ void AccountStore::Init() {
 
   InitSoft();
 
-  lock_guard<mutex> g(m_mutexDB);
+  lock_guard<ProfiledMutex> g(m_mutexDB);
 
   ContractStorage2::GetContractStorage().Reset();
   m_db.ResetDB();
@@ -78,35 +82,41 @@ void AccountStore::Init() {
 
 void AccountStore::SetScillaIPCServer(
     std::shared_ptr<ScillaIPCServer> scillaIPCServer) {
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
   m_accountStoreTemp->SetScillaIPCServer(scillaIPCServer);
 }
 
 void AccountStore::InitSoft() {
   LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
 
   AccountStoreTrie<OverlayDB, unordered_map<Address, Account>>::Init();
 
   InitRevertibles();
 
   InitTemp();
+
+  // the old snapshot's nodes are gone along with the trie
+  atomic_store(&m_committedSnapshot, shared_ptr<const StateSnapshot>());
+  InvalidateAccountCache();
 }
 
 bool AccountStore::RefreshDB() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_mutexDB);
+  lock_guard<ProfiledMutex> g(m_mutexDB);
   return m_db.RefreshDB();
 }
 
 void AccountStore::InitTemp() {
   LOG_MARKER();
 
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
 
   m_accountStoreTemp->Init();
+  m_accountStoreTemp->ClearDirtyAddresses();
   m_stateDeltaSerialized.clear();
+  m_stateDeltaFragments.clear();
 
   ContractStorage2::GetContractStorage().InitTempState(true);
 }
@@ -114,7 +124,7 @@ void AccountStore::InitTemp() {
 void AccountStore::InitRevertibles() {
   LOG_MARKER();
 
-  lock_guard<mutex> g(m_mutexRevertibles);
+  lock_guard<ProfiledMutex> g(m_mutexRevertibles);
 
   m_addressToAccountRevChanged.clear();
   m_addressToAccountRevCreated.clear();
@@ -129,7 +139,7 @@ AccountStore& AccountStore::GetInstance() {
 
 bool AccountStore::Serialize(bytes& src, unsigned int offset) const {
   LOG_MARKER();
-  shared_lock<shared_timed_mutex> lock(m_mutexPrimary);
+  shared_lock<ProfiledSharedTimedMutex> lock(m_mutexPrimary);
   return AccountStoreTrie<
       dev::OverlayDB, std::unordered_map<Address, Account>>::Serialize(src,
                                                                        offset);
@@ -140,7 +150,7 @@ bool AccountStore::Deserialize(const bytes& src, unsigned int offset) {
 
   this->Init();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
 
   if (!Messenger::GetAccountStore(src, offset, *this)) {
     LOG_GENERAL(WARNING, "Messenger::GetAccountStore failed.");
@@ -150,26 +160,137 @@ bool AccountStore::Deserialize(const bytes& src, unsigned int offset) {
   return true;
 }
 
+bool AccountStore::Deserialize(google::protobuf::io::ZeroCopyInputStream& src) {
+  LOG_MARKER();
+
+  this->Init();
+
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
+
+  if (!Messenger::GetAccountStore(src, *this)) {
+    LOG_GENERAL(WARNING, "Messenger::GetAccountStore failed.");
+    return false;
+  }
+
+  return true;
+}
+
+bool AccountStore::SerializeChunk(const bytes& cursor,
+                                  unsigned int maxAccounts, bytes& dst,
+                                  bytes& nextCursor) const {
+  LOG_MARKER();
+
+  nextCursor.clear();
+
+  Address cursorAddr;
+  const bool hasCursor = !cursor.empty();
+  if (hasCursor) {
+    if (cursor.size() != ACC_ADDR_SIZE) {
+      LOG_GENERAL(WARNING, "Invalid chunk cursor size " << cursor.size());
+      return false;
+    }
+    copy(cursor.begin(), cursor.end(), cursorAddr.asArray().begin());
+  }
+
+  shared_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
+
+  vector<pair<const Address*, const Account*>> pending;
+  pending.reserve(m_addressToAccount->size());
+  for (const auto& entry : *m_addressToAccount) {
+    if (!hasCursor || cursorAddr < entry.first) {
+      pending.emplace_back(&entry.first, &entry.second);
+    }
+  }
+
+  const auto addressLess = [](const pair<const Address*, const Account*>& lhs,
+                              const pair<const Address*, const Account*>& rhs) {
+    return *lhs.first < *rhs.first;
+  };
+
+  if (pending.size() > maxAccounts) {
+    // Keep the maxAccounts smallest addresses so every chunk boundary is a
+    // well-defined point in address order
+    nth_element(pending.begin(), pending.begin() + maxAccounts, pending.end(),
+                addressLess);
+    const Address* last =
+        max_element(pending.begin(), pending.begin() + maxAccounts,
+                    addressLess)
+            ->first;
+    nextCursor.assign(last->begin(), last->end());
+    pending.resize(maxAccounts);
+  }
+
+  LOG_GENERAL(INFO, "Accounts in chunk: " << pending.size()
+                                          << (nextCursor.empty() ? " (final)"
+                                                                 : ""));
+
+  return Messenger::SetAccountStoreChunk(dst, 0, pending);
+}
+
+bool AccountStore::DeserializeChunk(const bytes& src, bool reset) {
+  LOG_MARKER();
+
+  if (reset) {
+    this->Init();
+  }
+
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
+
+  google::protobuf::io::ArrayInputStream stream(src.data(), src.size());
+  if (!Messenger::GetAccountStore(stream, *this)) {
+    LOG_GENERAL(WARNING, "Messenger::GetAccountStore failed.");
+    return false;
+  }
+
+  return true;
+}
+
 bool AccountStore::SerializeDelta() {
   LOG_MARKER();
 
-  unique_lock<mutex> g(m_mutexDelta, defer_lock);
-  shared_lock<shared_timed_mutex> g2(m_mutexPrimary, defer_lock);
+  unique_lock<ProfiledMutex> g(m_mutexDelta, defer_lock);
+  shared_lock<ProfiledSharedTimedMutex> g2(m_mutexPrimary, defer_lock);
   lock(g, g2);
 
   m_stateDeltaSerialized.clear();
 
-  if (!Messenger::SetAccountStoreDelta(m_stateDeltaSerialized, 0,
-                                       *m_accountStoreTemp, *this)) {
-    LOG_GENERAL(WARNING, "Messenger::SetAccountStoreDelta failed.");
-    return false;
+  // Only re-encode accounts touched since the last serialization; unchanged
+  // accounts reuse the fragment produced last time. Consensus retries and
+  // view changes re-serialize the same delta several times per epoch, so
+  // most calls after the first are pure concatenation.
+  const set<Address>& dirtyAddresses = m_accountStoreTemp->GetDirtyAddresses();
+
+  LOG_GENERAL(INFO, "Account deltas to serialize: "
+                        << m_accountStoreTemp->GetNumOfAccounts()
+                        << ", dirty: " << dirtyAddresses.size());
+
+  for (const auto& entry : *m_accountStoreTemp->GetAddressToAccount()) {
+    auto fragment = m_stateDeltaFragments.find(entry.first);
+    if (fragment == m_stateDeltaFragments.end() ||
+        dirtyAddresses.find(entry.first) != dirtyAddresses.end()) {
+      bytes encoded;
+      if (!Messenger::SetAccountStoreDeltaEntry(
+              encoded, entry.first, this->GetAccount(entry.first),
+              entry.second)) {
+        LOG_GENERAL(WARNING, "Messenger::SetAccountStoreDeltaEntry failed.");
+        return false;
+      }
+      fragment = m_stateDeltaFragments.emplace(entry.first, bytes()).first;
+      fragment->second = move(encoded);
+    }
+
+    m_stateDeltaSerialized.insert(m_stateDeltaSerialized.end(),
+                                  fragment->second.begin(),
+                                  fragment->second.end());
   }
 
+  m_accountStoreTemp->ClearDirtyAddresses();
+
   return true;
 }
 
 void AccountStore::GetSerializedDelta(bytes& dst) {
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
 
   dst.clear();
 
@@ -182,8 +303,8 @@ bool AccountStore::DeserializeDelta(const bytes& src, unsigned int offset,
   LOG_MARKER();
 
   if (revertible) {
-    unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-    unique_lock<mutex> g2(m_mutexRevertibles, defer_lock);
+    unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary, defer_lock);
+    unique_lock<ProfiledMutex> g2(m_mutexRevertibles, defer_lock);
     lock(g, g2);
 
     if (!Messenger::GetAccountStoreDelta(src, offset, *this, revertible,
@@ -192,7 +313,7 @@ bool AccountStore::DeserializeDelta(const bytes& src, unsigned int offset,
       return false;
     }
   } else {
-    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+    unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
 
     if (!Messenger::GetAccountStoreDelta(src, offset, *this, revertible,
                                          false)) {
@@ -201,11 +322,15 @@ bool AccountStore::DeserializeDelta(const bytes& src, unsigned int offset,
     }
   }
 
+  // publish before invalidating so cache refills read the new snapshot
+  PublishStateSnapshot();
+  InvalidateAccountCache();
+
   return true;
 }
 
 bool AccountStore::DeserializeDeltaTemp(const bytes& src, unsigned int offset) {
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
   return m_accountStoreTemp->DeserializeDelta(src, offset);
 }
 
@@ -221,8 +346,8 @@ bool AccountStore::MoveRootToDisk(const h256& root) {
 bool AccountStore::MoveUpdatesToDisk() {
   LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-  unique_lock<mutex> g2(m_mutexDB, defer_lock);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<ProfiledMutex> g2(m_mutexDB, defer_lock);
   lock(g, g2);
 
   unordered_map<string, string> code_batch;
@@ -277,7 +402,7 @@ bool AccountStore::MoveUpdatesToDisk() {
   }
 
   try {
-    lock_guard<mutex> g(m_mutexTrie);
+    lock_guard<ProfiledMutex> g(m_mutexTrie);
     if (!m_state.db()->commit()) {
       LOG_GENERAL(WARNING, "LevelDB commit failed");
     }
@@ -292,6 +417,10 @@ bool AccountStore::MoveUpdatesToDisk() {
     return false;
   }
 
+  // the commit purged nodes the previous snapshot may still reference;
+  // republish so readers walk the freshly persisted root
+  PublishStateSnapshot();
+
   m_addressToAccount->clear();
 
   return true;
@@ -326,17 +455,19 @@ bool AccountStore::UpdateStateTrieFromTempStateDB() {
 void AccountStore::DiscardUnsavedUpdates() {
   LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-  unique_lock<mutex> g2(m_mutexDB, defer_lock);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<ProfiledMutex> g2(m_mutexDB, defer_lock);
   lock(g, g2);
 
   try {
     {
-      lock_guard<mutex> g(m_mutexTrie);
+      lock_guard<ProfiledMutex> g(m_mutexTrie);
       m_state.db()->rollback();
       m_state.setRoot(m_prevRoot);
     }
     m_addressToAccount->clear();
+    PublishStateSnapshot();
+    InvalidateAccountCache();
   } catch (const boost::exception& e) {
     LOG_GENERAL(WARNING, "Error with AccountStore::DiscardUnsavedUpdates. "
                              << boost::diagnostic_information(e));
@@ -348,8 +479,8 @@ bool AccountStore::RetrieveFromDisk() {
 
   InitSoft();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-  unique_lock<mutex> g2(m_mutexDB, defer_lock);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<ProfiledMutex> g2(m_mutexDB, defer_lock);
   lock(g, g2);
 
   bytes rootBytes;
@@ -372,13 +503,15 @@ bool AccountStore::RetrieveFromDisk() {
   try {
     h256 root(rootBytes);
     LOG_GENERAL(INFO, "StateRootHash:" << root.hex());
-    lock_guard<mutex> g(m_mutexTrie);
+    lock_guard<ProfiledMutex> g(m_mutexTrie);
     m_state.setRoot(root);
   } catch (const boost::exception& e) {
     LOG_GENERAL(WARNING, "Error with AccountStore::RetrieveFromDisk. "
                              << boost::diagnostic_information(e));
     return false;
   }
+  PublishStateSnapshot();
+  InvalidateAccountCache();
   return true;
 }
 
@@ -386,6 +519,194 @@ Account* AccountStore::GetAccountTemp(const Address& address) {
   return m_accountStoreTemp->GetAccount(address);
 }
 
+shared_ptr<const Account> AccountStore::GetAccountCached(
+    const Address& address) {
+  AccountCacheShard& shard = m_accountCacheShards.at(
+      address.asArray().at(0) % NUM_ACCOUNT_CACHE_SHARDS);
+
+  {
+    lock_guard<ProfiledMutex> g(shard.m_mutex);
+    auto it = shard.m_cache.find(address);
+    if (it != shard.m_cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Miss: prefer the immutable committed snapshot — walking it touches no
+  // AccountStore mutex, and it stays consistent while the next epoch's
+  // delta applies to the live trie underneath
+  string rawAccountBase;
+  const auto snapshot = GetCommittedSnapshot();
+  if (snapshot != nullptr) {
+    try {
+      dev::SpecificTrieDB<dev::GenericTrieDB<dev::OverlayDB>, Address> view(
+          &m_db, snapshot->m_root);
+      rawAccountBase = view.at(address);
+    } catch (const boost::exception& e) {
+      // the snapshot's nodes were purged by a concurrent commit; a fresh
+      // handle is already published, so fall through to the live trie
+      rawAccountBase.clear();
+    }
+  }
+  if (rawAccountBase.empty()) {
+    // no snapshot yet, the snapshot raced a commit, or the account is
+    // genuinely absent — confirm against the live trie
+    lock(m_mutexTrie, m_mutexDB);
+    lock_guard<ProfiledMutex> lock1(m_mutexTrie, adopt_lock);
+    lock_guard<ProfiledMutex> lock2(m_mutexDB, adopt_lock);
+
+    rawAccountBase = m_state.at(address);
+  }
+  if (rawAccountBase.empty()) {
+    return nullptr;
+  }
+
+  Account account;
+  if (!account.DeserializeBase(
+          bytes(rawAccountBase.begin(), rawAccountBase.end()), 0)) {
+    LOG_GENERAL(WARNING, "Account::DeserializeBase failed");
+    return nullptr;
+  }
+
+  if (account.isContract()) {
+    account.SetAddress(address);
+  }
+
+  // The cache holds shared handles so that a caller still reading an
+  // account survives InvalidateAccountCache() clearing the shard underneath
+  auto entry = make_shared<const Account>(move(account));
+
+  lock_guard<ProfiledMutex> g(shard.m_mutex);
+  return shard.m_cache.emplace(address, move(entry)).first->second;
+}
+
+void AccountStore::InvalidateAccountCache() {
+  for (auto& shard : m_accountCacheShards) {
+    lock_guard<ProfiledMutex> g(shard.m_mutex);
+    shard.m_cache.clear();
+  }
+}
+
+void AccountStore::PublishStateSnapshot() {
+  auto snapshot = make_shared<StateSnapshot>();
+  try {
+    lock_guard<ProfiledMutex> g(m_mutexTrie);
+    snapshot->m_root = m_state.root();
+  } catch (const boost::exception& e) {
+    LOG_GENERAL(WARNING, "Could not publish state snapshot. "
+                             << boost::diagnostic_information(e));
+    return;
+  }
+  atomic_store(&m_committedSnapshot,
+               shared_ptr<const StateSnapshot>(std::move(snapshot)));
+}
+
+shared_ptr<const AccountStore::StateSnapshot>
+AccountStore::GetCommittedSnapshot() const {
+  return atomic_load(&m_committedSnapshot);
+}
+
+void AccountStore::LoadAccountsFromRoot(const h256& root,
+                                        const vector<Address>& addresses,
+                                        vector<pair<Address, Account>>& loaded) {
+  if (addresses.empty()) {
+    return;
+  }
+
+  mutex loadedMutex;
+
+  const unsigned int numWorkers =
+      max(1u, min(static_cast<unsigned int>(addresses.size()),
+                  std::thread::hardware_concurrency()));
+  vector<thread> workers;
+  workers.reserve(numWorkers);
+  for (unsigned int workerId = 0; workerId < numWorkers; workerId++) {
+    workers.emplace_back([this, workerId, numWorkers, &root, &addresses,
+                          &loaded, &loadedMutex]() {
+      try {
+        // each worker gets its own trie view so walks do not share state
+        dev::SpecificTrieDB<dev::GenericTrieDB<dev::OverlayDB>, Address> view(
+            &m_db, root);
+        for (size_t i = workerId; i < addresses.size(); i += numWorkers) {
+          string rawAccountBase = view.at(addresses[i]);
+          if (rawAccountBase.empty()) {
+            continue;
+          }
+          Account account;
+          if (!account.DeserializeBase(
+                  bytes(rawAccountBase.begin(), rawAccountBase.end()), 0)) {
+            continue;
+          }
+          if (account.isContract()) {
+            account.SetAddress(addresses[i]);
+          }
+          lock_guard<mutex> g(loadedMutex);
+          loaded.emplace_back(addresses[i], account);
+        }
+      } catch (const boost::exception& e) {
+        // nodes purged by a concurrent commit — nothing to load
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void AccountStore::PrefetchAccounts(const vector<Address>& addresses) {
+  const auto snapshot = GetCommittedSnapshot();
+  if (snapshot == nullptr || addresses.empty()) {
+    return;
+  }
+
+  vector<pair<Address, Account>> loaded;
+  LoadAccountsFromRoot(snapshot->m_root, addresses, loaded);
+
+  if (loaded.empty()) {
+    return;
+  }
+
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
+  const auto current = GetCommittedSnapshot();
+  if (current == nullptr || current->m_root != snapshot->m_root) {
+    // state moved while we were reading; the walk still warmed the DB caches
+    return;
+  }
+  for (auto& entry : loaded) {
+    // emplace never overwrites, so live entries always win
+    m_addressToAccount->emplace(entry.first, std::move(entry.second));
+  }
+}
+
+void AccountStore::FaultInAccounts(const vector<Address>& addresses) {
+  vector<Address> missing;
+  missing.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    if (m_addressToAccount->find(address) == m_addressToAccount->end()) {
+      missing.emplace_back(address);
+    }
+  }
+  if (missing.empty()) {
+    return;
+  }
+
+  h256 root;
+  try {
+    lock_guard<ProfiledMutex> g(m_mutexTrie);
+    root = m_state.root();
+  } catch (const boost::exception& e) {
+    return;
+  }
+
+  vector<pair<Address, Account>> loaded;
+  LoadAccountsFromRoot(root, missing, loaded);
+
+  // the caller holds m_mutexPrimary, so nothing else mutates the map here
+  for (auto& entry : loaded) {
+    m_addressToAccount->emplace(entry.first, std::move(entry.second));
+  }
+}
+
 bool AccountStore::UpdateAccountsTemp(const uint64_t& blockNum,
                                       const unsigned int& numShards,
                                       const bool& isDS,
@@ -393,8 +714,8 @@ bool AccountStore::UpdateAccountsTemp(const uint64_t& blockNum,
                                       TransactionReceipt& receipt) {
   // LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-  unique_lock<mutex> g2(m_mutexDelta, defer_lock);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<ProfiledMutex> g2(m_mutexDelta, defer_lock);
   lock(g, g2);
 
   return m_accountStoreTemp->UpdateAccounts(blockNum, numShards, isDS,
@@ -406,7 +727,7 @@ bool AccountStore::UpdateCoinbaseTemp(const Address& rewardee,
                                       const uint128_t& amount) {
   // LOG_MARKER();
 
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
 
   if (m_accountStoreTemp->GetAccount(rewardee) == nullptr) {
     m_accountStoreTemp->AddAccount(rewardee, {0, 0});
@@ -415,8 +736,29 @@ bool AccountStore::UpdateCoinbaseTemp(const Address& rewardee,
   // Should the nonce increase ??
 }
 
+bool AccountStore::UpdateCoinbaseTempBatch(
+    const vector<pair<Address, uint128_t>>& rewards,
+    const Address& genesisAddress, vector<bool>& results) {
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
+
+  results.clear();
+  results.reserve(rewards.size());
+
+  bool ret = true;
+  for (const auto& reward : rewards) {
+    if (m_accountStoreTemp->GetAccount(reward.first) == nullptr) {
+      m_accountStoreTemp->AddAccount(reward.first, {0, 0});
+    }
+    const bool applied = m_accountStoreTemp->TransferBalance(
+        genesisAddress, reward.first, reward.second);
+    results.push_back(applied);
+    ret = ret && applied;
+  }
+  return ret;
+}
+
 uint128_t AccountStore::GetNonceTemp(const Address& address) {
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
 
   if (m_accountStoreTemp->GetAddressToAccount()->find(address) !=
       m_accountStoreTemp->GetAddressToAccount()->end()) {
@@ -427,7 +769,7 @@ uint128_t AccountStore::GetNonceTemp(const Address& address) {
 }
 
 StateHash AccountStore::GetStateDeltaHash() {
-  lock_guard<mutex> g(m_mutexDelta);
+  lock_guard<ProfiledMutex> g(m_mutexDelta);
 
   bool isEmpty = true;
 
@@ -467,7 +809,7 @@ void AccountStore::CommitTempRevertible() {
 void AccountStore::RevertCommitTemp() {
   LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+  unique_lock<ProfiledSharedTimedMutex> g(m_mutexPrimary);
 
   // Revert changed
   for (auto const& entry : m_addressToAccountRevChanged) {
@@ -482,4 +824,7 @@ void AccountStore::RevertCommitTemp() {
   }
 
   ContractStorage2::GetContractStorage().RevertContractStates();
+
+  PublishStateSnapshot();
+  InvalidateAccountCache();
 }
\ No newline at end of file
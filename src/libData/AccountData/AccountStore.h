@@ -19,10 +19,12 @@
 #define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_ACCOUNTSTORE_H_
 
 #include <json/json.h>
+#include <array>
 #include <map>
 #include <set>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <Schnorr.h>
 #include "Account.h"
@@ -38,14 +40,26 @@
 #include "depends/libTrie/TrieDB.h"
 #include "libData/AccountData/Transaction.h"
 #include "libServer/ScillaIPCServer.h"
+#include "libUtils/LockProfiler.h"
 
 using StateHash = dev::h256;
 
+namespace google {
+namespace protobuf {
+namespace io {
+class ZeroCopyInputStream;
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
 class AccountStore;
 
 class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
   AccountStore& m_parent;
 
+  /// addresses possibly modified since the last delta serialization
+  std::set<Address> m_dirtyAddresses;
+
   friend class AccountStore;
 
  public:
@@ -60,9 +74,16 @@ class AccountStoreTemp : public AccountStoreSC<std::map<Address, Account>> {
     return this->m_addressToAccount;
   }
 
+  const std::set<Address>& GetDirtyAddresses() const {
+    return m_dirtyAddresses;
+  }
+
+  void ClearDirtyAddresses() { m_dirtyAddresses.clear(); }
+
   void AddAccountDuringDeserialization(const Address& address,
                                        const Account& account) {
     (*m_addressToAccount)[address] = account;
+    m_dirtyAddresses.insert(address);
   }
 };
 
@@ -71,6 +92,17 @@ class AccountStore
     : public AccountStoreTrie<dev::OverlayDB,
                               std::unordered_map<Address, Account>>,
       Singleton<AccountStore> {
+ public:
+  /// Immutable view of the state as of the last commit. Readers walk m_root
+  /// against the shared node store without taking any AccountStore mutex;
+  /// the nodes stay readable while the next epoch's delta applies underneath,
+  /// because killed trie nodes are only purged at the next OverlayDB commit,
+  /// by which time a fresh handle has been published.
+  struct StateSnapshot {
+    dev::h256 m_root;
+  };
+
+ private:
   /// instantiate of AccountStoreTemp, which is serving for the StateDelta
   /// generation
   std::unique_ptr<AccountStoreTemp> m_accountStoreTemp;
@@ -81,14 +113,46 @@ class AccountStore
 
   /// primary mutex used by account store for protecting permanent states from
   /// external access
-  mutable std::shared_timed_mutex m_mutexPrimary;
+  mutable ProfiledSharedTimedMutex m_mutexPrimary{
+      "AccountStore::m_mutexPrimary"};
   /// mutex used when manipulating with state delta
-  std::mutex m_mutexDelta;
+  ProfiledMutex m_mutexDelta{"AccountStore::m_mutexDelta"};
   /// mutex related to revertibles
-  std::mutex m_mutexRevertibles;
+  ProfiledMutex m_mutexRevertibles{"AccountStore::m_mutexRevertibles"};
   /// buffer for the raw bytes of state delta serialized
   bytes m_stateDeltaSerialized;
 
+  /// per-account serialized delta fragments, reused across the repeated
+  /// SerializeDelta calls within an epoch for accounts that did not change
+  std::map<Address, bytes> m_stateDeltaFragments;
+
+  /// number of lock shards in the read-mostly account cache
+  static const unsigned int NUM_ACCOUNT_CACHE_SHARDS = 16;
+
+  /// read-mostly cache serving RPC account lookups without touching
+  /// m_mutexPrimary, so balance polling does not contend with
+  /// consensus-time state updates; invalidated whenever state changes
+  struct AccountCacheShard {
+    ProfiledMutex m_mutex{"AccountStore::m_accountCacheShards"};
+    std::unordered_map<Address, std::shared_ptr<const Account>> m_cache;
+  };
+  std::array<AccountCacheShard, NUM_ACCOUNT_CACHE_SHARDS> m_accountCacheShards;
+
+  /// immutable committed-state handle, republished after every state commit
+  /// and swapped with std::atomic_store; see GetCommittedSnapshot()
+  std::shared_ptr<const StateSnapshot> m_committedSnapshot;
+
+  /// capture the current trie root into a fresh snapshot handle; called
+  /// wherever committed state changes (delta applied, disk commit, revert)
+  void PublishStateSnapshot();
+
+  /// parallel read of the given addresses from the trie at root; absent or
+  /// undecodable accounts are skipped. Takes no AccountStore mutex — each
+  /// worker walks its own trie view against the shared node store
+  void LoadAccountsFromRoot(const dev::h256& root,
+                            const std::vector<Address>& addresses,
+                            std::vector<std::pair<Address, Account>>& loaded);
+
   std::shared_ptr<ScillaIPCServer> m_scillaIPCServer;
   std::unique_ptr<jsonrpc::AbstractServerConnector> m_scillaIPCServerConnector;
 
@@ -106,6 +170,22 @@ class AccountStore
 
   bool Deserialize(const bytes& src, unsigned int offset) override;
 
+  /// streaming counterpart of Deserialize: commits accounts as they are
+  /// parsed off the stream, so sync does not need the whole serialized state
+  /// in memory at once
+  bool Deserialize(google::protobuf::io::ZeroCopyInputStream& src);
+
+  /// serializes the (at most) maxAccounts accounts that follow cursor in
+  /// address order; cursor is empty for the first chunk, and nextCursor is
+  /// set to the last address included while more accounts remain, so memory
+  /// is bounded by the chunk regardless of total state size
+  bool SerializeChunk(const bytes& cursor, unsigned int maxAccounts,
+                      bytes& dst, bytes& nextCursor) const;
+
+  /// applies one chunk of a chunked state transfer on top of the current
+  /// contents; reset clears the store first (used for the first chunk)
+  bool DeserializeChunk(const bytes& src, bool reset);
+
   /// generate serialized raw bytes for StateDelta
   bool SerializeDelta();
 
@@ -148,6 +228,33 @@ class AccountStore
   /// [[[WARNING]]] Test utility function, don't use in core protocol
   Account* GetAccountTemp(const Address& address);
 
+  /// read-only lookup through the sharded account cache; unlike GetAccount,
+  /// concurrent callers only contend on one shard mutex per address. The
+  /// returned handle stays valid even if InvalidateAccountCache() runs
+  /// while the caller is still reading it
+  std::shared_ptr<const Account> GetAccountCached(const Address& address);
+
+  /// drops all cached accounts; called whenever committed state changes
+  void InvalidateAccountCache();
+
+  /// the handle published at the last state commit, or nullptr before the
+  /// first commit; safe to read from any thread without further locking
+  std::shared_ptr<const StateSnapshot> GetCommittedSnapshot() const;
+
+  /// warm the in-memory account map with the given addresses ahead of
+  /// transaction execution: the committed snapshot is walked in parallel
+  /// without holding any AccountStore mutex, then the loaded accounts are
+  /// adopted under m_mutexPrimary — only if the snapshot is still current,
+  /// and only for addresses not already in the map. At worst (state moved
+  /// underneath, or no snapshot yet) it just warms the underlying DB caches.
+  void PrefetchAccounts(const std::vector<Address>& addresses);
+
+  /// fault the given addresses into the in-memory account map from the live
+  /// trie, reading in parallel; the caller must hold m_mutexPrimary
+  /// exclusively. Used by the delta apply path so the per-entry GetAccount
+  /// calls hit memory instead of LevelDB
+  void FaultInAccounts(const std::vector<Address>& addresses);
+
   /// update account states in AccountStoreTemp
   bool UpdateAccountsTemp(const uint64_t& blockNum,
                           const unsigned int& numShards, const bool& isDS,
@@ -156,13 +263,13 @@ class AccountStore
 
   /// add account in AccountStoreTemp
   void AddAccountTemp(const Address& address, const Account& account) {
-    std::lock_guard<std::mutex> g(m_mutexDelta);
+    std::lock_guard<ProfiledMutex> g(m_mutexDelta);
     m_accountStoreTemp->AddAccount(address, account);
   }
 
   /// increase balance for account in AccountStoreTemp
   bool IncreaseBalanceTemp(const Address& address, const uint128_t& delta) {
-    std::lock_guard<std::mutex> g(m_mutexDelta);
+    std::lock_guard<ProfiledMutex> g(m_mutexDelta);
     return m_accountStoreTemp->IncreaseBalance(address, delta);
   }
 
@@ -174,29 +281,38 @@ class AccountStore
                           const Address& genesisAddress,
                           const uint128_t& amount);
 
+  /// Batched counterpart of UpdateCoinbaseTemp: applies every
+  /// (rewardee, amount) transfer from the genesis address under a single
+  /// lock acquisition; results holds the per-entry outcome
+  bool UpdateCoinbaseTempBatch(
+      const std::vector<std::pair<Address, uint128_t>>& rewards,
+      const Address& genesisAddress, std::vector<bool>& results);
+
   /// Call ProcessStorageRootUpdateBuffer in AccountStoreTemp
   void ProcessStorageRootUpdateBufferTemp() {
-    std::lock_guard<std::mutex> g(m_mutexDelta);
+    std::lock_guard<ProfiledMutex> g(m_mutexDelta);
     m_accountStoreTemp->ProcessStorageRootUpdateBuffer();
   }
 
   /// Call ProcessStorageRootUpdateBuffer in AccountStoreTemp
   void CleanStorageRootUpdateBufferTemp() {
-    std::lock_guard<std::mutex> g(m_mutexDelta);
+    std::lock_guard<ProfiledMutex> g(m_mutexDelta);
     m_accountStoreTemp->CleanStorageRootUpdateBuffer();
   }
 
   void CleanNewLibrariesCacheTemp() {
-    std::lock_guard<std::mutex> g(m_mutexDelta);
+    std::lock_guard<ProfiledMutex> g(m_mutexDelta);
     m_accountStoreTemp->CleanNewLibrariesCache();
   }
 
-  /// used in deserialization
+  /// used in deserialization; updateTrie can be turned off when the caller
+  /// batches the trie updates afterwards via UpdateStateTrieBatch
   void AddAccountDuringDeserialization(const Address& address,
                                        const Account& account,
                                        const Account& oriAccount,
                                        const bool fullCopy = false,
-                                       const bool revertible = false) {
+                                       const bool revertible = false,
+                                       const bool updateTrie = true) {
     (*m_addressToAccount)[address] = account;
 
     if (revertible) {
@@ -207,7 +323,9 @@ class AccountStore
       }
     }
 
-    UpdateStateTrie(address, account);
+    if (updateTrie) {
+      UpdateStateTrie(address, account);
+    }
   }
 
   /// return the hash of the raw bytes of StateDelta
@@ -21,28 +21,87 @@ AccountStoreAtomic<MAP>::AccountStoreAtomic(AccountStoreSC<MAP>& parent)
 
 template <class MAP>
 Account* AccountStoreAtomic<MAP>::GetAccount(const Address& address) {
-  Account* account =
-      AccountStoreBase<std::unordered_map<Address, Account>>::GetAccount(
-          address);
-  if (account != nullptr) {
-    // LOG_GENERAL(INFO, "Got From Temp");
-    return account;
+  return m_parent.GetAccount(address);
+}
+
+template <class MAP>
+uint128_t AccountStoreAtomic<MAP>::ViewBalance(const Address& address,
+                                               const Account& account) const {
+  auto entry = m_pendingBalances.find(address);
+  return entry != m_pendingBalances.end() ? entry->second
+                                          : account.GetBalance();
+}
+
+template <class MAP>
+bool AccountStoreAtomic<MAP>::TransferBalance(const Address& from,
+                                              const Address& to,
+                                              const uint128_t& delta) {
+  if (delta == 0) {
+    return true;
   }
 
-  account = m_parent.GetAccount(address);
-  if (account) {
-    // LOG_GENERAL(INFO, "Got From Parent");
-    m_addressToAccount->insert(std::make_pair(address, *account));
-    return &(m_addressToAccount->find(address))->second;
+  Account* fromAccount = m_parent.GetAccount(from);
+  if (fromAccount == nullptr) {
+    LOG_GENERAL(WARNING, "Account " << from.hex() << " not exist");
+    return false;
   }
 
-  // LOG_GENERAL(INFO, "Got Nullptr");
+  Account* toAccount = m_parent.GetAccount(to);
+  if (toAccount == nullptr) {
+    if (!m_parent.AddAccount(to, {0, 0})) {
+      return false;
+    }
+    toAccount = m_parent.GetAccount(to);
+    if (toAccount == nullptr) {
+      return false;
+    }
+    m_createdAccounts.emplace_back(to);
+  }
+
+  const uint128_t fromBalance = ViewBalance(from, *fromAccount);
+  if (fromBalance < delta) {
+    return false;
+  }
+
+  if (from == to) {
+    // the two legs cancel out, as they did when whole accounts were copied
+    return true;
+  }
 
-  return nullptr;
+  uint128_t newToBalance;
+  if (!SafeMath<uint128_t>::add(ViewBalance(to, *toAccount), delta,
+                                newToBalance)) {
+    return false;
+  }
+
+  m_pendingBalances[from] = fromBalance - delta;
+  m_pendingBalances[to] = newToBalance;
+
+  return true;
+}
+
+template <class MAP>
+void AccountStoreAtomic<MAP>::Commit() {
+  for (const auto& entry : m_pendingBalances) {
+    Account* account = m_parent.GetAccount(entry.first);
+    if (account == nullptr) {
+      LOG_GENERAL(WARNING,
+                  "Account " << entry.first.hex() << " vanished before commit");
+      continue;
+    }
+    account->SetBalance(entry.second);
+  }
+
+  m_pendingBalances.clear();
+  m_createdAccounts.clear();
 }
 
 template <class MAP>
-const std::shared_ptr<std::unordered_map<Address, Account>>&
-AccountStoreAtomic<MAP>::GetAddressToAccount() {
-  return this->m_addressToAccount;
+void AccountStoreAtomic<MAP>::Revert() {
+  for (const auto& address : m_createdAccounts) {
+    m_parent.RemoveAccount(address);
+  }
+
+  m_pendingBalances.clear();
+  m_createdAccounts.clear();
 }
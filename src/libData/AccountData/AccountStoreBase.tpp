@@ -98,28 +98,47 @@ bool AccountStoreBase<MAP>::UpdateAccounts(const Transaction& transaction,
     return false;
   }
 
-  if (!DecreaseBalance(fromAddr, gasDeposit)) {
+  // Operate on the two looked-up accounts directly instead of going through
+  // the address-keyed balance helpers: each helper call repeats the map
+  // lookup (and, for the temp store, the copy-in from the parent store),
+  // which dominates the cost of this plain-transfer hot path
+  if (!fromAccount->DecreaseBalance(gasDeposit)) {
     return false;
   }
 
-  if (!TransferBalance(fromAddr, toAddr, amount)) {
-    if (!IncreaseBalance(fromAddr, gasDeposit)) {
+  if (!fromAccount->DecreaseBalance(amount)) {
+    if (!fromAccount->IncreaseBalance(gasDeposit)) {
       LOG_GENERAL(FATAL, "IncreaseBalance failed for gasDeposit");
     }
     return false;
   }
 
+  if (amount > 0) {
+    Account* toAccount = this->GetAccount(toAddr);
+    bool toCredited = (toAccount != nullptr)
+                          ? toAccount->IncreaseBalance(amount)
+                          : AddAccount(toAddr, {amount, 0});
+    if (!toCredited) {
+      if (!fromAccount->IncreaseBalance(amount) ||
+          !fromAccount->IncreaseBalance(gasDeposit)) {
+        LOG_GENERAL(FATAL, "IncreaseBalance failed for refund");
+      }
+      return false;
+    }
+  }
+
   uint128_t gasRefund;
   if (!CalculateGasRefund(gasDeposit, NORMAL_TRAN_GAS,
                           transaction.GetGasPrice(), gasRefund)) {
     return false;
   }
 
-  if (!IncreaseBalance(fromAddr, gasRefund)) {
+  if (gasRefund > 0 && !fromAccount->IncreaseBalance(gasRefund)) {
     LOG_GENERAL(FATAL, "IncreaseBalance failed for gasRefund");
   }
 
-  if (!IncreaseNonce(fromAddr)) {
+  if (!fromAccount->IncreaseNonce()) {
+    LOG_GENERAL(WARNING, "Increase nonce failed");
     return false;
   }
 
@@ -23,27 +23,54 @@
 #include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "AccountStoreBase.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/LockProfiler.h"
 
 class ScillaIPCServer;
 
 template <class MAP>
 class AccountStoreSC;
 
+/// Journal-based revert view over the parent store for one txn's transfers:
+/// pending balances are recorded per touched address instead of copying
+/// whole accounts forward, so call setup is O(1) and rollback costs only the
+/// mutations made. The parent's balances stay untouched until Commit, which
+/// preserves what a chained invocation observes through the parent store.
 template <class MAP>
-class AccountStoreAtomic
-    : public AccountStoreBase<std::unordered_map<Address, Account>> {
+class AccountStoreAtomic {
   AccountStoreSC<MAP>& m_parent;
 
+  /// pending balance of every address mutated through this view
+  std::unordered_map<Address, uint128_t> m_pendingBalances;
+
+  /// accounts created in the parent by transfers through this view, removed
+  /// again on Revert
+  std::vector<Address> m_createdAccounts;
+
+  /// the balance this view observes: the pending value when the address was
+  /// already touched, the parent account's otherwise
+  uint128_t ViewBalance(const Address& address, const Account& account) const;
+
  public:
   AccountStoreAtomic(AccountStoreSC<MAP>& parent);
 
-  Account* GetAccount(const Address& address) override;
+  /// Accounts are served straight from the parent; only balances are
+  /// virtualized by this view
+  Account* GetAccount(const Address& address);
+
+  bool TransferBalance(const Address& from, const Address& to,
+                       const uint128_t& delta);
 
-  const std::shared_ptr<std::unordered_map<Address, Account>>&
-  GetAddressToAccount();
+  /// Applies the pending balances onto the parent accounts and forgets the
+  /// journal
+  void Commit();
+
+  /// Drops the pending balances and removes the accounts this view created
+  void Revert();
 };
 
 template <class MAP>
@@ -53,7 +80,8 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
   std::unique_ptr<AccountStoreAtomic<MAP>> m_accountStoreAtomic;
 
   /// mutex to block major accounts changes
-  std::mutex m_mutexUpdateAccounts;
+  ProfiledMutex m_mutexUpdateAccounts{
+      "AccountStoreSC::m_mutexUpdateAccounts"};
 
   /// the blocknum while executing each txn
   uint64_t m_curBlockNum{0};
@@ -91,6 +119,16 @@ class AccountStoreSC : public AccountStoreBase<MAP> {
   std::condition_variable cv_callContract;
   std::atomic<bool> m_txnProcessTimeout;
 
+  /// whether the interpreter invocation currently in flight has finished;
+  /// guarded by m_MutexCVCallContract
+  bool m_interpreterDone = false;
+
+  /// Runs invocation on a detached thread and blocks until it completes or
+  /// NotifyTimeout fires. The done flag makes the wait immune to the
+  /// invocation finishing before the wait begins - a bare cv wait would
+  /// miss that notify and stall until the consensus timeout
+  void LaunchAndWaitInterpreter(const std::function<void()>& invocation);
+
   /// scilla IPC server
   std::shared_ptr<ScillaIPCServer> m_scillaIPCServer;
 
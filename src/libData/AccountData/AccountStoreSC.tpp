@@ -24,6 +24,7 @@
 #include "libUtils/DataConversion.h"
 #include "libUtils/JsonUtils.h"
 #include "libUtils/SafeMath.h"
+#include "libUtils/ScillaProfiler.h"
 #include "libUtils/SysCommand.h"
 
 // 5mb
@@ -37,7 +38,7 @@ AccountStoreSC<MAP>::AccountStoreSC() {
 
 template <class MAP>
 void AccountStoreSC<MAP>::Init() {
-  std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
+  std::lock_guard<ProfiledMutex> g(m_mutexUpdateAccounts);
   AccountStoreBase<MAP>::Init();
   m_curContractAddr.clear();
   m_curSenderAddr.clear();
@@ -50,6 +51,29 @@ void AccountStoreSC<MAP>::Init() {
   boost::filesystem::create_directories(EXTLIB_FOLDER);
 }
 
+template <class MAP>
+void AccountStoreSC<MAP>::LaunchAndWaitInterpreter(
+    const std::function<void()>& invocation) {
+  {
+    std::lock_guard<std::mutex> lk(m_MutexCVCallContract);
+    m_interpreterDone = false;
+  }
+
+  auto func = [this, invocation]() -> void {
+    invocation();
+    {
+      std::lock_guard<std::mutex> lk(m_MutexCVCallContract);
+      m_interpreterDone = true;
+    }
+    cv_callContract.notify_all();
+  };
+  DetachedFunction(1, func);
+
+  std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
+  cv_callContract.wait(
+      lk, [this]() { return m_interpreterDone || m_txnProcessTimeout; });
+}
+
 template <class MAP>
 void AccountStoreSC<MAP>::InvokeScillaChecker(std::string& checkerPrint,
                                               bool& ret_checker, int& pid,
@@ -74,15 +98,8 @@ void AccountStoreSC<MAP>::InvokeScillaChecker(std::string& checkerPrint,
                                << e.what());
       ret_checker = false;
     }
-
-    cv_callContract.notify_all();
   };
-  DetachedFunction(1, func1);
-
-  {
-    std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
-    cv_callContract.wait(lk);
-  }
+  LaunchAndWaitInterpreter(func1);
 }
 
 template <class MAP>
@@ -93,7 +110,7 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
                                          TransactionReceipt& receipt) {
   // LOG_MARKER();
   LOG_GENERAL(INFO, "Process txn: " << transaction.GetTranID());
-  std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
+  std::lock_guard<ProfiledMutex> g(m_mutexUpdateAccounts);
 
   m_curIsDS = isDS;
   m_txnProcessTimeout = false;
@@ -336,15 +353,10 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
                               << e.what());
               ret = false;
             }
-
-            cv_callContract.notify_all();
           };
-          DetachedFunction(1, func2);
-
-          {
-            std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
-            cv_callContract.wait(lk);
-          }
+          const uint64_t gasBeforeRunner = gasRemained;
+          ScillaProfiler::GetInstance().StartInvocation(toAddr.hex());
+          LaunchAndWaitInterpreter(func2);
 
           try {
             if (m_txnProcessTimeout) {
@@ -364,6 +376,12 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
                                             is_library)) {
               ret = false;
             }
+            ScillaProfiler::GetInstance().EndInvocation(ret,
+                                                        runnerPrint.size());
+            if (gasBeforeRunner >= gasRemained) {
+              ScillaProfiler::GetInstance().AddGas(
+                  toAddr.hex(), gasBeforeRunner - gasRemained);
+            }
             if (!ret) {
               gasRemained = std::min(
                   transaction.GetGasLimit() - createGasPenalty, gasRemained);
@@ -583,16 +601,11 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
                       "Exception caught in call account (1): " << e.what());
           ret = false;
         }
-        cv_callContract.notify_all();
       };
 
       Contract::ContractStorage2::GetContractStorage().BufferCurrentState();
-      DetachedFunction(1, func);
-
-      {
-        std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
-        cv_callContract.wait(lk);
-      }
+      ScillaProfiler::GetInstance().StartInvocation(toAddr.hex());
+      LaunchAndWaitInterpreter(func);
 
       if (m_txnProcessTimeout) {
         LOG_GENERAL(
@@ -614,6 +627,10 @@ bool AccountStoreSC<MAP>::UpdateAccounts(const uint64_t& blockNum,
                                << r_timer_end(tpStart) << " microseconds");
       }
 
+      // gas is attributed later, once ParseCallContractJsonOutput has read
+      // gas_remaining from this output
+      ScillaProfiler::GetInstance().EndInvocation(ret, runnerPrint.size());
+
       uint32_t tree_depth = 0;
 
       if (ret && !ParseCallContract(gasRemained, runnerPrint, receipt,
@@ -774,7 +791,7 @@ bool AccountStoreSC<MAP>::PopulateExtlibsExports(
       }
 
       extlibs_exports[libAddr] = {
-          DataConversion::CharArrayToString(libAcc->GetCode()),
+          DataConversion::CharArrayToString(*libAcc->GetCodeShared()),
           DataConversion::CharArrayToString(libAcc->GetInitData())};
 
       if (!extlibsExporter(ext_extlibs, extlibs_exports)) {
@@ -811,7 +828,8 @@ bool AccountStoreSC<MAP>::ExportCreateContractFiles(
     // Scilla code
     std::ofstream os(INPUT_CODE + (is_library ? LIBRARY_CODE_EXTENSION
                                               : CONTRACT_FILE_EXTENSION));
-    os << DataConversion::CharArrayToString(contract.GetCode());
+    const auto code = contract.GetCodeShared();
+    os.write(reinterpret_cast<const char*>(code->data()), code->size());
     os.close();
 
     ExportCommonFiles(os, contract, extlibs_exports);
@@ -888,7 +906,8 @@ bool AccountStoreSC<MAP>::ExportContractFiles(
   try {
     // Scilla code
     std::ofstream os(INPUT_CODE + CONTRACT_FILE_EXTENSION);
-    os << DataConversion::CharArrayToString(contract.GetCode());
+    const auto code = contract.GetCodeShared();
+    os.write(reinterpret_cast<const char*>(code->data()), code->size());
     os.close();
 
     ExportCommonFiles(os, contract, extlibs_exports);
@@ -1331,6 +1350,10 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(
   }
   LOG_GENERAL(INFO, "gasRemained: " << gasRemained);
 
+  // the invocation whose output this is ran against m_curContractAddr
+  ScillaProfiler::GetInstance().AddGas(m_curContractAddr.hex(),
+                                       startGas - gasRemained);
+
   if (!_json.isMember("messages") || !_json.isMember("events")) {
     if (_json.isMember("errors")) {
       LOG_GENERAL(WARNING, "Call contract failed");
@@ -1601,19 +1624,14 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(
               "Exception caught in ParseCallContractJsonOutput: " << e.what());
           result = false;
         }
-        cv_callContract.notify_all();
       };
 
       if (ENABLE_CHECK_PERFORMANCE_LOG) {
         tpStart = r_timer_start();
       }
 
-      DetachedFunction(1, func);
-
-      {
-        std::unique_lock<std::mutex> lk(m_MutexCVCallContract);
-        cv_callContract.wait(lk);
-      }
+      ScillaProfiler::GetInstance().StartInvocation(recipient.hex());
+      LaunchAndWaitInterpreter(func);
 
       if (m_txnProcessTimeout) {
         LOG_GENERAL(
@@ -1638,6 +1656,8 @@ bool AccountStoreSC<MAP>::ParseCallContractJsonOutput(
                                        << " microseconds");
       }
 
+      ScillaProfiler::GetInstance().EndInvocation(result, runnerPrint.size());
+
       if (!result) {
         return false;
       }
@@ -1664,7 +1684,7 @@ template <class MAP>
 void AccountStoreSC<MAP>::ProcessStorageRootUpdateBuffer() {
   LOG_MARKER();
   {
-    std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
+    std::lock_guard<ProfiledMutex> g(m_mutexUpdateAccounts);
     for (const auto& addr : m_storageRootUpdateBuffer) {
       Account* account = this->GetAccount(addr);
       if (account == nullptr) {
@@ -1680,7 +1700,7 @@ void AccountStoreSC<MAP>::ProcessStorageRootUpdateBuffer() {
 
 template <class MAP>
 void AccountStoreSC<MAP>::CleanStorageRootUpdateBuffer() {
-  std::lock_guard<std::mutex> g(m_mutexUpdateAccounts);
+  std::lock_guard<ProfiledMutex> g(m_mutexUpdateAccounts);
   m_storageRootUpdateBuffer.clear();
 }
 
@@ -1695,28 +1715,24 @@ bool AccountStoreSC<MAP>::TransferBalanceAtomic(const Address& from,
 template <class MAP>
 void AccountStoreSC<MAP>::CommitTransferAtomic() {
   LOG_MARKER();
-  for (const auto& entry : *m_accountStoreAtomic->GetAddressToAccount()) {
-    Account* account = this->GetAccount(entry.first);
-    if (account != nullptr) {
-      *account = entry.second;
-    } else {
-      // this->m_addressToAccount.emplace(std::make_pair(entry.first,
-      // entry.second));
-      this->AddAccount(entry.first, entry.second);
-    }
-  }
+  m_accountStoreAtomic->Commit();
 }
 
 template <class MAP>
 void AccountStoreSC<MAP>::DiscardTransferAtomic() {
   LOG_MARKER();
-  m_accountStoreAtomic->Init();
+  m_accountStoreAtomic->Revert();
 }
 
 template <class MAP>
 void AccountStoreSC<MAP>::NotifyTimeout() {
   LOG_MARKER();
-  m_txnProcessTimeout = true;
+  {
+    // taken so the flag cannot be set between a waiter's predicate check and
+    // its sleep, which would lose this wakeup
+    std::lock_guard<std::mutex> lk(m_MutexCVCallContract);
+    m_txnProcessTimeout = true;
+  }
   cv_callContract.notify_all();
 }
 
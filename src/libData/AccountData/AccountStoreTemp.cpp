@@ -28,6 +28,9 @@ Account* AccountStoreTemp::GetAccount(const Address& address) {
       AccountStoreBase<map<Address, Account>>::GetAccount(address);
   if (account != nullptr) {
     // LOG_GENERAL(INFO, "Got From Temp");
+    // The caller can mutate through the returned pointer, so be conservative
+    // and treat the account as changed for the next delta serialization
+    m_dirtyAddresses.insert(address);
     return account;
   }
 
@@ -36,6 +39,7 @@ Account* AccountStoreTemp::GetAccount(const Address& address) {
     // LOG_GENERAL(INFO, "Got From Parent");
     Account newaccount(*account);
     m_addressToAccount->insert(make_pair(address, newaccount));
+    m_dirtyAddresses.insert(address);
     return &(m_addressToAccount->find(address))->second;
   }
 
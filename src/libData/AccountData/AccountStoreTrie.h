@@ -19,6 +19,7 @@
 #define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_ACCOUNTSTORETRIE_H_
 
 #include "AccountStoreSC.h"
+#include "libUtils/LockProfiler.h"
 #include "depends/libDatabase/MemoryDB.h"
 #include "depends/libDatabase/OverlayDB.h"
 
@@ -30,14 +31,19 @@ class AccountStoreTrie : public AccountStoreSC<MAP> {
   dev::h256 m_prevRoot;
 
   // mutex for AccountStore DB related operations
-  std::mutex m_mutexDB;
-  mutable std::mutex m_mutexTrie;
+  ProfiledMutex m_mutexDB{"AccountStoreTrie::m_mutexDB"};
+  mutable ProfiledMutex m_mutexTrie{"AccountStoreTrie::m_mutexTrie"};
 
   AccountStoreTrie();
 
   bool UpdateStateTrie(const Address& address, const Account& account);
   bool RemoveFromTrie(const Address& address);
 
+  /// Serializes and inserts the entries into the trie; caller must hold
+  /// m_mutexTrie
+  bool UpdateStateTrieEntries(
+      const std::vector<std::pair<const Address*, const Account*>>& entries);
+
  public:
   virtual void Init() override;
 
@@ -49,8 +55,21 @@ class AccountStoreTrie : public AccountStoreSC<MAP> {
 
   dev::h256 GetStateRootHash() const;
   dev::h256 GetPrevRootHash() const;
+
+  /// Collects the Merkle proof for an account: the raw trie nodes on the
+  /// lookup path from the given root, plus the serialized account at the
+  /// leaf (empty when the address is absent, which proves non-inclusion).
+  /// Walks a fresh trie view at the given root, so it takes no trie lock
+  /// and can run against a committed snapshot while consensus advances.
+  bool GetAccountProof(const dev::h256& root, const Address& address,
+                       std::vector<bytes>& proof, bytes& accountRaw);
   bool UpdateStateTrieAll();
 
+  /// Applies the given addresses' current accounts to the trie in one
+  /// batched pass - one lock acquisition and one serialization fan-out
+  /// instead of a per-account trie update
+  bool UpdateStateTrieBatch(const std::vector<Address>& addresses);
+
   void PrintAccountState() override;
 };
 
@@ -15,6 +15,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <thread>
+
 #include "libPersistence/ContractStorage.h"
 
 #include "libMessage/MessengerAccountStoreTrie.h"
@@ -22,7 +25,7 @@
 template <class DB, class MAP>
 AccountStoreTrie<DB, MAP>::AccountStoreTrie()
     : m_db(std::is_same<DB, dev::OverlayDB>::value ? "state" : "") {
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
   m_state = dev::SpecificTrieDB<dev::GenericTrieDB<DB>, Address>(&m_db);
 }
 
@@ -34,7 +37,7 @@ void AccountStoreTrie<DB, MAP>::Init() {
 
 template <class DB, class MAP>
 void AccountStoreTrie<DB, MAP>::InitTrie() {
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
   m_state.init();
   m_prevRoot = m_state.root();
 }
@@ -42,7 +45,7 @@ void AccountStoreTrie<DB, MAP>::InitTrie() {
 template <class DB, class MAP>
 bool AccountStoreTrie<DB, MAP>::Serialize(bytes& dst,
                                           unsigned int offset) const {
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
   if (!MessengerAccountStoreTrie::SetAccountStoreTrie(
           dst, offset, m_state, this->m_addressToAccount)) {
     LOG_GENERAL(WARNING, "Messenger::SetAccountStoreTrie failed.");
@@ -65,8 +68,8 @@ Account* AccountStoreTrie<DB, MAP>::GetAccount(const Address& address) {
   std::string rawAccountBase;
   {
     std::lock(m_mutexTrie, m_mutexDB);
-    std::lock_guard<std::mutex> lock1(m_mutexTrie, std::adopt_lock);
-    std::lock_guard<std::mutex> lock2(m_mutexDB, std::adopt_lock);
+    std::lock_guard<ProfiledMutex> lock1(m_mutexTrie, std::adopt_lock);
+    std::lock_guard<ProfiledMutex> lock2(m_mutexDB, std::adopt_lock);
 
     rawAccountBase = m_state.at(address);
   }
@@ -103,7 +106,7 @@ bool AccountStoreTrie<DB, MAP>::UpdateStateTrie(const Address& address,
     return false;
   }
 
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
   m_state.insert(address, rawBytes);
 
   return true;
@@ -112,7 +115,7 @@ bool AccountStoreTrie<DB, MAP>::UpdateStateTrie(const Address& address,
 template <class DB, class MAP>
 bool AccountStoreTrie<DB, MAP>::RemoveFromTrie(const Address& address) {
   // LOG_MARKER();
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
 
   m_state.remove(address);
 
@@ -123,7 +126,7 @@ template <class DB, class MAP>
 dev::h256 AccountStoreTrie<DB, MAP>::GetStateRootHash() const {
   LOG_MARKER();
 
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
 
   return m_state.root();
 }
@@ -132,21 +135,110 @@ template <class DB, class MAP>
 dev::h256 AccountStoreTrie<DB, MAP>::GetPrevRootHash() const {
   LOG_MARKER();
 
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
 
   return m_prevRoot;
 }
 
+template <class DB, class MAP>
+bool AccountStoreTrie<DB, MAP>::GetAccountProof(const dev::h256& root,
+                                                const Address& address,
+                                                std::vector<bytes>& proof,
+                                                bytes& accountRaw) {
+  // LOG_MARKER();
+  try {
+    dev::SpecificTrieDB<dev::GenericTrieDB<DB>, Address> view(&m_db, root);
+    const std::string rawAccountBase = view.proveAt(address, proof);
+    accountRaw = bytes(rawAccountBase.begin(), rawAccountBase.end());
+  } catch (const boost::exception& e) {
+    // the nodes under this root were purged by a concurrent commit
+    LOG_GENERAL(WARNING, "Failed to walk trie at root "
+                             << root.hex() << ". "
+                             << boost::diagnostic_information(e));
+    return false;
+  }
+
+  return true;
+}
+
 template <class DB, class MAP>
 bool AccountStoreTrie<DB, MAP>::UpdateStateTrieAll() {
-  std::lock_guard<std::mutex> g(m_mutexTrie);
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
+
+  std::vector<std::pair<const Address*, const Account*>> entries;
+  entries.reserve(this->m_addressToAccount->size());
   for (auto const& entry : *(this->m_addressToAccount)) {
-    bytes rawBytes;
-    if (!entry.second.SerializeBase(rawBytes, 0)) {
-      LOG_GENERAL(WARNING, "Messenger::SetAccountBase failed");
+    entries.emplace_back(&entry.first, &entry.second);
+  }
+
+  return UpdateStateTrieEntries(entries);
+}
+
+template <class DB, class MAP>
+bool AccountStoreTrie<DB, MAP>::UpdateStateTrieBatch(
+    const std::vector<Address>& addresses) {
+  std::lock_guard<ProfiledMutex> g(m_mutexTrie);
+
+  std::vector<std::pair<const Address*, const Account*>> entries;
+  entries.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    auto it = this->m_addressToAccount->find(address);
+    if (it == this->m_addressToAccount->end()) {
+      LOG_GENERAL(WARNING,
+                  "Account " << address << " missing for trie update");
       return false;
     }
-    m_state.insert(entry.first, rawBytes);
+    entries.emplace_back(&it->first, &it->second);
+  }
+
+  return UpdateStateTrieEntries(entries);
+}
+
+template <class DB, class MAP>
+bool AccountStoreTrie<DB, MAP>::UpdateStateTrieEntries(
+    const std::vector<std::pair<const Address*, const Account*>>& entries) {
+  // Serializing each account is independent work, so fan it out across
+  // threads before walking the trie; the inserts themselves stay serial
+  // under m_mutexTrie because GenericTrieDB shares a single node store.
+  // Only spin up threads when there are enough accounts to pay for them.
+  static const size_t PARALLEL_SERIALIZE_THRESHOLD = 1000;
+
+  std::vector<bytes> rawBytesList(entries.size());
+  std::atomic<bool> failed(false);
+
+  if (entries.size() >= PARALLEL_SERIALIZE_THRESHOLD) {
+    const unsigned int numThreads =
+        std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < numThreads; t++) {
+      workers.emplace_back([&, t]() {
+        for (size_t i = t; i < entries.size(); i += numThreads) {
+          if (!entries[i].second->SerializeBase(rawBytesList[i], 0)) {
+            failed = true;
+            return;
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  } else {
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (!entries[i].second->SerializeBase(rawBytesList[i], 0)) {
+        failed = true;
+        break;
+      }
+    }
+  }
+
+  if (failed) {
+    LOG_GENERAL(WARNING, "Messenger::SetAccountBase failed");
+    return false;
+  }
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    m_state.insert(*entries[i].first, rawBytesList[i]);
   }
 
   return true;
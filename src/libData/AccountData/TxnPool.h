@@ -18,9 +18,12 @@
 #ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNPOOL_H_
 #define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNPOOL_H_
 
+#include <deque>
 #include <functional>
 #include <map>
+#include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "Account.h"
 #include "Transaction.h"
@@ -36,10 +39,12 @@ struct TxnPool {
     }
   };
 
+  // HashIndex owns the transactions; the gas and nonce indexes only hold
+  // hashes, so each transaction is stored (and copied, when the pool is
+  // snapshotted at microblock time) exactly once
   std::unordered_map<TxnHash, Transaction> HashIndex;
-  std::map<uint128_t, std::map<TxnHash, Transaction>, std::greater<uint128_t>>
-      GasIndex;
-  std::unordered_map<std::pair<PubKey, uint64_t>, Transaction, PubKeyNonceHash>
+  std::map<uint128_t, std::set<TxnHash>, std::greater<uint128_t>> GasIndex;
+  std::unordered_map<std::pair<PubKey, uint64_t>, TxnHash, PubKeyNonceHash>
       NonceIndex;
 
   void clear() {
@@ -70,31 +75,31 @@ struct TxnPool {
 
     auto searchNonce = NonceIndex.find({t.GetSenderPubKey(), t.GetNonce()});
     if (searchNonce != NonceIndex.end()) {
-      if ((t.GetGasPrice() > searchNonce->second.GetGasPrice()) ||
-          (t.GetGasPrice() == searchNonce->second.GetGasPrice() &&
-           t.GetTranID() < searchNonce->second.GetTranID())) {
-        // erase from HashIdxTxns
-        auto searchHash = HashIndex.find(searchNonce->second.GetTranID());
-        if (searchHash != HashIndex.end()) {
-          HashIndex.erase(searchHash);
-        }
-        // erase from GasIdxTxns
-        auto searchGas = GasIndex.find(searchNonce->second.GetGasPrice());
+      const auto searchHash = HashIndex.find(searchNonce->second);
+      if (searchHash != HashIndex.end() &&
+          ((t.GetGasPrice() > searchHash->second.GetGasPrice()) ||
+           (t.GetGasPrice() == searchHash->second.GetGasPrice() &&
+            t.GetTranID() < searchHash->second.GetTranID()))) {
+        // evict the replaced txn from all indexes
+        const uint128_t oldGasPrice = searchHash->second.GetGasPrice();
+        const TxnHash oldTranID = searchHash->second.GetTranID();
+        auto searchGas = GasIndex.find(oldGasPrice);
         if (searchGas != GasIndex.end()) {
-          auto searchGasHash =
-              searchGas->second.find(searchNonce->second.GetTranID());
-          if (searchGasHash != searchGas->second.end()) {
-            searchGas->second.erase(searchGasHash);
+          searchGas->second.erase(oldTranID);
+          if (searchGas->second.empty()) {
+            GasIndex.erase(searchGas);
           }
         }
+        HashIndex.erase(searchHash);
+
         HashIndex[t.GetTranID()] = t;
-        GasIndex[t.GetGasPrice()][t.GetTranID()] = t;
-        searchNonce->second = t;
+        GasIndex[t.GetGasPrice()].insert(t.GetTranID());
+        searchNonce->second = t.GetTranID();
       }
     } else {
       HashIndex[t.GetTranID()] = t;
-      GasIndex[t.GetGasPrice()][t.GetTranID()] = t;
-      NonceIndex[{t.GetSenderPubKey(), t.GetNonce()}] = t;
+      GasIndex[t.GetGasPrice()].insert(t.GetTranID());
+      NonceIndex[{t.GetSenderPubKey(), t.GetNonce()}] = t.GetTranID();
     }
     return true;
   }
@@ -102,42 +107,133 @@ struct TxnPool {
   void findSameNonceButHigherGas(Transaction& t) {
     auto searchNonce = NonceIndex.find({t.GetSenderPubKey(), t.GetNonce()});
     if (searchNonce != NonceIndex.end()) {
-      if (searchNonce->second.GetGasPrice() > t.GetGasPrice()) {
-        t = std::move(searchNonce->second);
+      auto searchHash = HashIndex.find(searchNonce->second);
+      if (searchHash == HashIndex.end()) {
+        NonceIndex.erase(searchNonce);
+        return;
+      }
+      if (searchHash->second.GetGasPrice() > t.GetGasPrice()) {
+        t = std::move(searchHash->second);
 
         // erase tx nonce map
         NonceIndex.erase(searchNonce);
         // erase tx gas map
-        GasIndex[t.GetGasPrice()].erase(t.GetTranID());
-        if (GasIndex[t.GetGasPrice()].empty()) {
-          GasIndex.erase(t.GetGasPrice());
+        auto searchGas = GasIndex.find(t.GetGasPrice());
+        if (searchGas != GasIndex.end()) {
+          searchGas->second.erase(t.GetTranID());
+          if (searchGas->second.empty()) {
+            GasIndex.erase(searchGas);
+          }
         }
         // erase tx hash map
-        HashIndex.erase(t.GetTranID());
+        HashIndex.erase(searchHash);
       }
     }
   }
 
   bool findOne(Transaction& t) {
-    if (GasIndex.empty()) {
-      return false;
-    }
-
-    auto firstGas = GasIndex.begin();
-    auto firstHash = firstGas->second.begin();
+    while (!GasIndex.empty()) {
+      auto firstGas = GasIndex.begin();
+      auto firstHash = firstGas->second.begin();
+      if (firstHash == firstGas->second.end()) {
+        GasIndex.erase(firstGas);
+        continue;
+      }
 
-    if (firstHash != firstGas->second.end()) {
-      t = std::move(firstHash->second);
+      const TxnHash th = *firstHash;
 
       // erase tx gas map
       firstGas->second.erase(firstHash);
       if (firstGas->second.empty()) {
         GasIndex.erase(firstGas);
       }
+
+      auto searchHash = HashIndex.find(th);
+      if (searchHash == HashIndex.end()) {
+        continue;
+      }
+
+      t = std::move(searchHash->second);
+
       // erase tx nonce map
       NonceIndex.erase({t.GetSenderPubKey(), t.GetNonce()});
-      // erase tx hash m ap
-      HashIndex.erase(t.GetTranID());
+      // erase tx hash map
+      HashIndex.erase(searchHash);
+      return true;
+    }
+    return false;
+  }
+
+  /// pops up to n highest-gas-price transactions in one call, saving the
+  /// per-txn call overhead when the leader drains the pool for a microblock
+  unsigned int findBatch(std::vector<Transaction>& txns, unsigned int n) {
+    Transaction t;
+    while (txns.size() < n && findOne(t)) {
+      txns.emplace_back(std::move(t));
+    }
+    return txns.size();
+  }
+};
+
+/// Buffers transactions whose nonce is ahead of their sender's account,
+/// keyed by sender and sorted by nonce. A sender is queued as ready the
+/// moment its lowest buffered nonce becomes processable, so draining the
+/// buffer during microblock ordering is O(1) amortized per transaction
+/// instead of a scan over every gapped sender per loop iteration
+struct NonceGapBuffer {
+  std::map<Address, std::map<uint64_t, Transaction>> AddrNonceIndex;
+  std::deque<Address> ReadySenders;
+
+  /// Buffers t (its nonce must be ahead of the sender's account); when the
+  /// same sender and nonce is already buffered, the higher gas price wins
+  void insert(const Address& senderAddr, const Transaction& t) {
+    auto itAddr = AddrNonceIndex.find(senderAddr);
+    if (itAddr != AddrNonceIndex.end()) {
+      auto itNonce = itAddr->second.find(t.GetNonce());
+      if (itNonce != itAddr->second.end()) {
+        if (t.GetGasPrice() > itNonce->second.GetGasPrice()) {
+          itNonce->second = t;
+        }
+        return;
+      }
+    }
+    AddrNonceIndex[senderAddr].insert({t.GetNonce(), t});
+  }
+
+  /// Queues the sender for findReady when expectedNonce matches its lowest
+  /// buffered nonce; call after a txn of that sender has been applied
+  void markReady(const Address& senderAddr, const uint64_t expectedNonce) {
+    const auto itAddr = AddrNonceIndex.find(senderAddr);
+    if (itAddr != AddrNonceIndex.end() &&
+        itAddr->second.begin()->first == expectedNonce) {
+      ReadySenders.push_back(senderAddr);
+    }
+  }
+
+  /// Pops the next buffered txn whose nonce matches the sender's expected
+  /// nonce; stale queue entries (sender drained or nonce moved on) are
+  /// skipped
+  bool findReady(Transaction& t,
+                 const std::function<uint64_t(const Address&)>& expectedNonce) {
+    while (!ReadySenders.empty()) {
+      const Address senderAddr = ReadySenders.front();
+      ReadySenders.pop_front();
+
+      const auto itAddr = AddrNonceIndex.find(senderAddr);
+      if (itAddr == AddrNonceIndex.end()) {
+        continue;
+      }
+
+      const auto itNonce = itAddr->second.begin();
+      if (itNonce->first != expectedNonce(senderAddr)) {
+        continue;
+      }
+
+      t = std::move(itNonce->second);
+      itAddr->second.erase(itNonce);
+      if (itAddr->second.empty()) {
+        AddrNonceIndex.erase(itAddr);
+      }
       return true;
     }
     return false;
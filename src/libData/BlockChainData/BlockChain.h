@@ -18,7 +18,9 @@
 #ifndef ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 #define ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 
+#include <algorithm>
 #include <mutex>
+#include <vector>
 
 #include "libData/BlockData/Block/DSBlock.h"
 #include "libData/DataStructures/CircularArray.h"
@@ -39,6 +41,24 @@ class BlockChain {
 
   virtual T GetBlockFromPersistentStorage(const uint64_t& blockNum) = 0;
 
+  /// Copies the block at blockNum out of the in-memory window. Returns false
+  /// when the block is not there (evicted to persistent storage, never added,
+  /// or past the tip), mirroring the fallback conditions in GetBlock.
+  bool GetBlockFromMemory(const uint64_t& blockNum, T& block) {
+    std::lock_guard<std::mutex> g(m_mutexBlocks);
+
+    if (m_blocks.size() > 0 &&
+        (m_blocks.back().GetHeader().GetBlockNum() < blockNum)) {
+      return false;
+    }
+    if (blockNum + m_blocks.capacity() < m_blocks.size() ||
+        m_blocks[blockNum].GetHeader().GetBlockNum() != blockNum) {
+      return false;
+    }
+    block = m_blocks[blockNum];
+    return true;
+  }
+
  public:
   /// Reset
   void Reset() { m_blocks.resize(BLOCKCHAIN_SIZE); }
@@ -77,6 +97,52 @@ class BlockChain {
     }
   }
 
+  /// Copies blocks [lowBlockNum, highBlockNum] into the supplied vector under
+  /// a single lock acquisition, walking the circular array's contiguous
+  /// storage directly instead of locking and probing per block. Stops at the
+  /// first block that is neither in memory nor in persistent storage.
+  /// Returns the number of the last block copied (lowBlockNum - 1 if none).
+  uint64_t GetBlockRange(const uint64_t& lowBlockNum,
+                         const uint64_t& highBlockNum, std::vector<T>& blocks) {
+    std::lock_guard<std::mutex> g(m_mutexBlocks);
+
+    if (highBlockNum < lowBlockNum) {
+      return lowBlockNum - 1;
+    }
+
+    // the requested range can come from a remote peer, so cap the upfront
+    // reservation; a genuine oversized range still grows the vector normally
+    blocks.reserve(blocks.size() +
+                   std::min<uint64_t>(highBlockNum - lowBlockNum + 1,
+                                      m_blocks.capacity()));
+
+    for (uint64_t blockNum = lowBlockNum; blockNum <= highBlockNum;
+         blockNum++) {
+      if (m_blocks.size() > 0 &&
+          (m_blocks.back().GetHeader().GetBlockNum() < blockNum)) {
+        // past the tip
+        return blockNum - 1;
+      }
+
+      if (blockNum + m_blocks.capacity() < m_blocks.size() ||
+          m_blocks[blockNum].GetHeader().GetBlockNum() != blockNum) {
+        try {
+          T block = GetBlockFromPersistentStorage(blockNum);
+          if (block.GetHeader().GetBlockNum() != blockNum) {
+            return blockNum - 1;
+          }
+          blocks.emplace_back(std::move(block));
+        } catch (...) {
+          return blockNum - 1;
+        }
+      } else {
+        blocks.emplace_back(m_blocks[blockNum]);
+      }
+    }
+
+    return highBlockNum;
+  }
+
   /// Adds a block to the chain.
   int AddBlock(const T& block) {
     uint64_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
@@ -137,6 +203,23 @@ class TxBlockChain : public BlockChain<TxBlock> {
     }
     return *block;
   }
+
+  /// Header-only variant of GetBlock. Blocks that have fallen out of the
+  /// in-memory window are answered from the header column of the block
+  /// store, skipping the full-block deserialization the header-only callers
+  /// (explorer queries, tx counting, gas pricing) would otherwise pay.
+  TxBlockHeader GetBlockHeader(const uint64_t& blockNum) {
+    TxBlock block;
+    if (GetBlockFromMemory(blockNum, block)) {
+      return block.GetHeader();
+    }
+
+    TxBlockHeader header;
+    if (BlockStorage::GetBlockStorage().GetTxBlockHeader(blockNum, header)) {
+      return header;
+    }
+    return GetBlockFromPersistentStorage(blockNum).GetHeader();
+  }
 };
 
 class VCBlockChain : public BlockChain<VCBlock> {
@@ -31,21 +31,54 @@ BlockHeaderBase::BlockHeaderBase(const uint32_t& version,
       m_committeeHash(committeeHash),
       m_prevHash(prevHash) {}
 
+BlockHeaderBase::BlockHeaderBase(const BlockHeaderBase& src)
+    : m_version(src.m_version),
+      m_committeeHash(src.m_committeeHash),
+      m_prevHash(src.m_prevHash) {
+  lock_guard<mutex> guard(src.m_hashMutex);
+  m_cachedHash = src.m_cachedHash;
+  m_hashCached = src.m_hashCached;
+}
+
+BlockHeaderBase& BlockHeaderBase::operator=(const BlockHeaderBase& src) {
+  if (this == &src) {
+    return *this;
+  }
+
+  m_version = src.m_version;
+  m_committeeHash = src.m_committeeHash;
+  m_prevHash = src.m_prevHash;
+
+  std::lock(m_hashMutex, src.m_hashMutex);
+  lock_guard<mutex> guard1(m_hashMutex, adopt_lock);
+  lock_guard<mutex> guard2(src.m_hashMutex, adopt_lock);
+  m_cachedHash = src.m_cachedHash;
+  m_hashCached = src.m_hashCached;
+  return *this;
+}
+
 BlockHash BlockHeaderBase::GetMyHash() const {
-  SHA2<HashType::HASH_VARIANT_256> sha2;
-  bytes vec;
-  Serialize(vec, 0);
-  sha2.Update(vec);
-  const bytes& resVec = sha2.Finalize();
-  BlockHash blockHash;
-  std::copy(resVec.begin(), resVec.end(), blockHash.asArray().begin());
-  return blockHash;
+  lock_guard<mutex> guard(m_hashMutex);
+
+  if (!m_hashCached) {
+    SHA2<HashType::HASH_VARIANT_256> sha2;
+    bytes vec;
+    Serialize(vec, 0);
+    sha2.Update(vec);
+    const bytes& resVec = sha2.Finalize();
+    std::copy(resVec.begin(), resVec.end(), m_cachedHash.asArray().begin());
+    m_hashCached = true;
+  }
+
+  return m_cachedHash;
 }
 
 const uint32_t& BlockHeaderBase::GetVersion() const { return m_version; }
 
 void BlockHeaderBase::SetVersion(const uint32_t& version) {
+  lock_guard<mutex> guard(m_hashMutex);
   m_version = version;
+  m_hashCached = false;
 }
 
 const CommitteeHash& BlockHeaderBase::GetCommitteeHash() const {
@@ -53,13 +86,17 @@ const CommitteeHash& BlockHeaderBase::GetCommitteeHash() const {
 }
 
 void BlockHeaderBase::SetCommitteeHash(const CommitteeHash& committeeHash) {
+  lock_guard<mutex> guard(m_hashMutex);
   m_committeeHash = committeeHash;
+  m_hashCached = false;
 }
 
 const BlockHash& BlockHeaderBase::GetPrevHash() const { return m_prevHash; }
 
 void BlockHeaderBase::SetPrevHash(const BlockHash& prevHash) {
+  lock_guard<mutex> guard(m_hashMutex);
   m_prevHash = prevHash;
+  m_hashCached = false;
 }
 
 bool BlockHeaderBase::operator==(const BlockHeaderBase& header) const {
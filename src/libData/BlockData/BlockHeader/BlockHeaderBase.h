@@ -19,6 +19,7 @@
 #define ZILLIQA_SRC_LIBDATA_BLOCKDATA_BLOCKHEADER_BLOCKHEADERBASE_H_
 
 #include <array>
+#include <mutex>
 
 #include <Schnorr.h>
 #include "common/Constants.h"
@@ -38,13 +39,23 @@ class BlockHeaderBase : public SerializableDataBlock {
   CommitteeHash m_committeeHash;
   BlockHash m_prevHash;
 
+ private:
+  // GetMyHash re-serializes the whole header, so the result is memoized;
+  // every mutation path (constructors, assignment, the setters below)
+  // invalidates the cache
+  mutable std::mutex m_hashMutex;
+  mutable BlockHash m_cachedHash;
+  mutable bool m_hashCached{};
+
  public:
   // Constructors
   BlockHeaderBase();
   BlockHeaderBase(const uint32_t& version, const CommitteeHash& committeeHash,
                   const BlockHash& prevHash);
+  BlockHeaderBase(const BlockHeaderBase& src);
+  BlockHeaderBase& operator=(const BlockHeaderBase& src);
 
-  /// Calculate my hash
+  /// Calculate my hash (cached after the first call)
   BlockHash GetMyHash() const;
 
   /// Returns the current version of this block.
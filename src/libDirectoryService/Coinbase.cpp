@@ -216,12 +216,14 @@ void DirectoryService::InitCoinbase() {
   LOG_GENERAL(INFO, "Total base reward: " << base_reward);
 
   uint128_t base_reward_each = 0;
+  uint128_t base_reward_left = 0;
   uint128_t node_count = m_mediator.m_DSCommittee->size();
   for (const auto& shard : m_shards) {
     node_count += shard.size();
   }
   LOG_GENERAL(INFO, "Total num of node: " << node_count);
-  if (!SafeMath<uint128_t>::div(base_reward, node_count, base_reward_each)) {
+  if (!SafeMath<uint128_t>::div_with_remainder(
+          base_reward, node_count, base_reward_each, base_reward_left)) {
     LOG_GENERAL(WARNING, "base_reward_each dividing unsafe!");
     return;
   }
@@ -238,20 +240,27 @@ void DirectoryService::InitCoinbase() {
   uint128_t nodeReward = total_reward - lookupReward - base_reward;
   uint128_t reward_each = 0;
   uint128_t reward_each_lookup = 0;
+  uint128_t node_reward_left = 0;
+  uint128_t lookup_reward_left = 0;
 
-  if (!SafeMath<uint128_t>::div(nodeReward, sig_count, reward_each)) {
+  if (!SafeMath<uint128_t>::div_with_remainder(nodeReward, sig_count,
+                                               reward_each, node_reward_left)) {
     LOG_GENERAL(WARNING, "reward_each dividing unsafe!");
     return;
   }
 
-  if (!SafeMath<uint128_t>::div(lookupReward, lookup_count,
-                                reward_each_lookup)) {
+  if (!SafeMath<uint128_t>::div_with_remainder(lookupReward, lookup_count,
+                                               reward_each_lookup,
+                                               lookup_reward_left)) {
     LOG_GENERAL(WARNING, "reward_each_lookup dividing unsafe");
     return;
   }
 
   LOG_GENERAL(INFO, "Each reward: " << reward_each << " lookup each "
                                     << reward_each_lookup);
+  LOG_GENERAL(INFO, "Undistributed after split: "
+                        << base_reward_left + node_reward_left +
+                               lookup_reward_left);
 
   // Add rewards come from gas fee back to the coinbase account
   if (!AccountStore::GetInstance().IncreaseBalanceTemp(coinbaseAddress,
@@ -271,11 +280,38 @@ void DirectoryService::InitCoinbase() {
   // repeated checking of guard list
   unordered_map<PubKey, bool> pubKeyAndIsGuard;
 
+  // The same public keys recur across the base reward pass and every epoch's
+  // cosig rewards, so derive each address (serialize + hash) only once
+  unordered_map<PubKey, Address> rewardAddresses;
+  auto getRewardAddress =
+      [&rewardAddresses](const PubKey& pk) -> const Address& {
+    auto iterAddr = rewardAddresses.find(pk);
+    if (iterAddr == rewardAddresses.end()) {
+      iterAddr =
+          rewardAddresses.emplace(pk, Account::GetAddressFromPublicKey(pk))
+              .first;
+    }
+    return iterAddr->second;
+  };
+
+  // All reward transfers are accumulated first and applied in one batch
+  // under a single account store lock acquisition, instead of locking once
+  // per rewardee per epoch
+  enum class RewardKind : uint8_t { BASE, COSIG, LOOKUP_COSIG };
+  struct RewardContext {
+    Address addr;
+    PubKey pubKey;
+    uint64_t epochNum;
+    RewardKind kind;
+  };
+  vector<pair<Address, uint128_t>> rewards;
+  vector<RewardContext> rewardContexts;
+
   // DS nodes
   LOG_GENERAL(INFO, "[CNBSE] Rewarding base reward to DS nodes...");
   for (const auto& ds : *m_mediator.m_DSCommittee) {
     const auto& pk = ds.first;
-    Address addr = Account::GetAddressFromPublicKey(pk);
+    const Address& addr = getRewardAddress(pk);
     if (GUARD_MODE) {
       auto& isGuard = pubKeyAndIsGuard[pk];
       if (Guard::GetInstance().IsNodeInDSGuardList(pk)) {
@@ -289,19 +325,8 @@ void DirectoryService::InitCoinbase() {
     }
     nonGuard.emplace_back(addr);
 
-    if (!AccountStore::GetInstance().UpdateCoinbaseTemp(addr, coinbaseAddress,
-                                                        base_reward_each)) {
-      LOG_GENERAL(WARNING, "Could not reward base reward  " << addr);
-    } else {
-      if (addr == myAddr) {
-        LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-                  "[REWARD] Rewarded base reward " << base_reward_each);
-        LOG_STATE("[REWARD][" << setw(15) << left
-                              << m_mediator.m_selfPeer.GetPrintableIPAddress()
-                              << "][" << m_mediator.m_currentEpochNum << "]["
-                              << base_reward_each << "] base reward");
-      }
-    }
+    rewards.emplace_back(addr, base_reward_each);
+    rewardContexts.push_back({addr, pk, 0, RewardKind::BASE});
   }
 
   // Shard nodes
@@ -317,13 +342,11 @@ void DirectoryService::InitCoinbase() {
         }
         isGuard = false;
       }
-      Address addr = Account::GetAddressFromPublicKey(pk);
+      const Address& addr = getRewardAddress(pk);
       nonGuard.emplace_back(addr);
 
-      if (!AccountStore::GetInstance().UpdateCoinbaseTemp(addr, coinbaseAddress,
-                                                          base_reward_each)) {
-        LOG_GENERAL(WARNING, "Could not reward base reward  " << addr);
-      }
+      rewards.emplace_back(addr, base_reward_each);
+      rewardContexts.push_back({addr, pk, 0, RewardKind::BASE});
       // No need to log as shard node won't call InitCoinbase
     }
   }
@@ -347,43 +370,78 @@ void DirectoryService::InitCoinbase() {
       LOG_GENERAL(INFO, "[CNBSE] Rewarding shard " << shardId);
       if (shardId == CoinbaseReward::LOOKUP_REWARD) {
         for (const auto& pk : rewardees) {
-          const auto& addr = Account::GetAddressFromPublicKey(pk);
-          if (!AccountStore::GetInstance().UpdateCoinbaseTemp(
-                  addr, coinbaseAddress, reward_each_lookup)) {
-            LOG_GENERAL(WARNING, "Could not reward " << addr << " - " << pk);
-          } else {
-            nonGuard.emplace_back(addr);
-            suc_lookup_counter++;
-          }
+          const auto& addr = getRewardAddress(pk);
+          rewards.emplace_back(addr, reward_each_lookup);
+          rewardContexts.push_back(
+              {addr, pk, epochNum, RewardKind::LOOKUP_COSIG});
         }
       } else {
         for (const auto& pk : rewardees) {
           if (GUARD_MODE && pubKeyAndIsGuard[pk]) {
             suc_counter++;
           } else {
-            const auto& addr = Account::GetAddressFromPublicKey(pk);
-            if (!AccountStore::GetInstance().UpdateCoinbaseTemp(
-                    addr, coinbaseAddress, reward_each)) {
-              LOG_GENERAL(WARNING, "Could not reward " << addr << " - " << pk);
-            } else {
-              if (addr == myAddr) {
-                LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-                          "[REWARD] Rewarded " << reward_each << " for blk "
-                                               << epochNum);
-                LOG_STATE("[REWARD]["
-                          << setw(15) << left
-                          << m_mediator.m_selfPeer.GetPrintableIPAddress()
-                          << "][" << m_mediator.m_currentEpochNum << "]["
-                          << reward_each << "] for blk " << epochNum);
-              }
-              suc_counter++;
-            }
+            const auto& addr = getRewardAddress(pk);
+            rewards.emplace_back(addr, reward_each);
+            rewardContexts.push_back({addr, pk, epochNum, RewardKind::COSIG});
           }
         }
       }
     }
   }
 
+  vector<bool> rewarded;
+  if (!AccountStore::GetInstance().UpdateCoinbaseTempBatch(
+          rewards, coinbaseAddress, rewarded)) {
+    LOG_GENERAL(WARNING, "Some of the coinbase rewards were not applied");
+  }
+
+  for (unsigned int i = 0; i < rewardContexts.size(); i++) {
+    const auto& context = rewardContexts.at(i);
+    const bool applied = (i < rewarded.size()) && rewarded.at(i);
+    switch (context.kind) {
+      case RewardKind::BASE:
+        if (!applied) {
+          LOG_GENERAL(WARNING,
+                      "Could not reward base reward  " << context.addr);
+        } else if (context.addr == myAddr) {
+          LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
+                    "[REWARD] Rewarded base reward " << base_reward_each);
+          LOG_STATE("[REWARD][" << setw(15) << left
+                                << m_mediator.m_selfPeer.GetPrintableIPAddress()
+                                << "][" << m_mediator.m_currentEpochNum << "]["
+                                << base_reward_each << "] base reward");
+        }
+        break;
+      case RewardKind::LOOKUP_COSIG:
+        if (!applied) {
+          LOG_GENERAL(WARNING, "Could not reward " << context.addr << " - "
+                                                   << context.pubKey);
+        } else {
+          nonGuard.emplace_back(context.addr);
+          suc_lookup_counter++;
+        }
+        break;
+      case RewardKind::COSIG:
+        if (!applied) {
+          LOG_GENERAL(WARNING, "Could not reward " << context.addr << " - "
+                                                   << context.pubKey);
+        } else {
+          if (context.addr == myAddr) {
+            LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
+                      "[REWARD] Rewarded " << reward_each << " for blk "
+                                           << context.epochNum);
+            LOG_STATE("[REWARD]["
+                      << setw(15) << left
+                      << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["
+                      << m_mediator.m_currentEpochNum << "][" << reward_each
+                      << "] for blk " << context.epochNum);
+          }
+          suc_counter++;
+        }
+        break;
+    }
+  }
+
   uint128_t balance_left = total_reward - (suc_counter * reward_each) -
                            (suc_lookup_counter * reward_each_lookup) -
                            (node_count * base_reward_each);
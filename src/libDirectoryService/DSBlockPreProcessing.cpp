@@ -27,6 +27,7 @@
 #include "depends/common/RLP.h"
 #include "depends/libTrie/TrieDB.h"
 #include "depends/libTrie/TrieHash.h"
+#include "libConsensus/ConsensusTimeouts.h"
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
@@ -1585,8 +1586,10 @@ void DirectoryService::RunConsensusOnDSBlock() {
   // View change will wait for timeout. If conditional variable is notified
   // before timeout, the thread will return without triggering view change.
   std::unique_lock<std::mutex> cv_lk(m_MutexCVViewChangeDSBlock);
-  if (cv_viewChangeDSBlock.wait_for(cv_lk,
-                                    std::chrono::seconds(VIEWCHANGE_TIME)) ==
+  if (cv_viewChangeDSBlock.wait_for(
+          cv_lk, std::chrono::seconds(
+                     ConsensusTimeouts::GetInstance().GetViewChangeTimeout(
+                         ConsensusTimeouts::DSBLOCK))) ==
       std::cv_status::timeout) {
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
               "Initiated DS block view change. ");
@@ -1058,23 +1058,23 @@ bool DirectoryService::Execute(const bytes& message, unsigned int offset,
   typedef bool (DirectoryService::*InstructionHandler)(
       const bytes&, unsigned int, const Peer&);
 
-  std::vector<InstructionHandler> ins_handlers;
-
-  ins_handlers.insert(ins_handlers.end(),
-                      {&DirectoryService::ProcessSetPrimary,
-                       &DirectoryService::ProcessPoWSubmission,
-                       &DirectoryService::ProcessDSBlockConsensus,
-                       &DirectoryService::ProcessMicroblockSubmission,
-                       &DirectoryService::ProcessFinalBlockConsensus,
-                       &DirectoryService::ProcessViewChangeConsensus,
-                       &DirectoryService::ProcessGetDSTxBlockMessage,
-                       &DirectoryService::ProcessPoWPacketSubmission,
-                       &DirectoryService::ProcessNewDSGuardNetworkInfo,
-                       &DirectoryService::ProcessCosigsRewardsFromSeed});
+  // Built once; the table is ordered by DSInstructionType
+  static const InstructionHandler ins_handlers[] = {
+      &DirectoryService::ProcessSetPrimary,
+      &DirectoryService::ProcessPoWSubmission,
+      &DirectoryService::ProcessDSBlockConsensus,
+      &DirectoryService::ProcessMicroblockSubmission,
+      &DirectoryService::ProcessFinalBlockConsensus,
+      &DirectoryService::ProcessViewChangeConsensus,
+      &DirectoryService::ProcessGetDSTxBlockMessage,
+      &DirectoryService::ProcessPoWPacketSubmission,
+      &DirectoryService::ProcessNewDSGuardNetworkInfo,
+      &DirectoryService::ProcessCosigsRewardsFromSeed};
 
   const unsigned char ins_byte = message.at(offset);
 
-  const unsigned int ins_handlers_count = ins_handlers.size();
+  const unsigned int ins_handlers_count =
+      sizeof(ins_handlers) / sizeof(InstructionHandler);
 
   if (ToBlockMessage(ins_byte)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum, "Ignore DS message");
@@ -148,9 +148,9 @@ class DirectoryService : public Executable {
   std::shared_ptr<TxBlock> m_finalBlock;
 
   struct MBSubmissionBufferEntry {
-    MicroBlock m_microBlock;
+    std::shared_ptr<const MicroBlock> m_microBlock;
     bytes m_stateDelta;
-    MBSubmissionBufferEntry(const MicroBlock& microBlock,
+    MBSubmissionBufferEntry(const std::shared_ptr<const MicroBlock>& microBlock,
                             const bytes& stateDelta)
         : m_microBlock(microBlock), m_stateDelta(stateDelta) {}
   };
@@ -291,6 +291,7 @@ class DirectoryService : public Executable {
   uint128_t GetDecreasedGasPrice();
   uint128_t GetIncreasedGasPrice();
   bool VerifyGasPrice(const uint128_t& gasPrice);
+  void UpdateGasCongestionStats(const TxBlock& txBlock);
 
   bool VerifyPoWWinner(const MapOfPubKeyPoW& dsWinnerPoWsFromLeader);
   bool VerifyDifficulty();
@@ -337,12 +338,13 @@ class DirectoryService : public Executable {
   bool CheckWhetherDSBlockIsFresh(const uint64_t dsblock_num);
   void CommitMBSubmissionMsgBuffer();
   bool ProcessMicroblockSubmissionFromShard(
-      const uint64_t epochNumber, const std::vector<MicroBlock>& microBlocks,
+      const uint64_t epochNumber, std::vector<MicroBlock>& microBlocks,
       const std::vector<bytes>& stateDelta);
-  bool ProcessMicroblockSubmissionFromShardCore(const MicroBlock& microBlocks,
-                                                const bytes& stateDelta);
+  bool ProcessMicroblockSubmissionFromShardCore(
+      const std::shared_ptr<const MicroBlock>& microBlockPtr,
+      const bytes& stateDelta);
   bool ProcessMissingMicroblockSubmission(
-      const uint64_t epochNumber, const std::vector<MicroBlock>& microBlocks,
+      const uint64_t epochNumber, std::vector<MicroBlock>& microBlocks,
       const std::vector<bytes>& stateDeltas);
   void ExtractDataFromMicroblocks(std::vector<MicroBlockInfo>& mbInfos,
                                   uint64_t& allGasLimit, uint64_t& allGasUsed,
@@ -421,6 +423,7 @@ class DirectoryService : public Executable {
       const uint16_t candidateLeaderIndex);
   bool RunConsensusOnViewChangeWhenNotCandidateLeader(
       const uint16_t candidateLeaderIndex);
+  bool StartViewChangeConsensusAsCandidateLeader();
   void ProcessViewChangeConsensusWhenDone();
   void ProcessNextConsensus(unsigned char viewChangeState);
 
@@ -513,13 +516,38 @@ class DirectoryService : public Executable {
   std::mutex m_mutexPrepareRunFinalblockConsensus;
   std::atomic<bool> m_startedRunFinalblockConsensus{};
 
+  // Pending microblocks are held behind shared_ptr so the copy deserialized
+  // from the submission message is the same object later used for final-block
+  // assembly, instead of being duplicated into the set and back out
+  struct MicroBlockPtrLess {
+    bool operator()(const std::shared_ptr<const MicroBlock>& lhs,
+                    const std::shared_ptr<const MicroBlock>& rhs) const {
+      return *lhs < *rhs;
+    }
+  };
   std::mutex m_mutexMicroBlocks;
-  std::unordered_map<uint64_t, std::set<MicroBlock>> m_microBlocks;
+  std::unordered_map<uint64_t,
+                     std::set<std::shared_ptr<const MicroBlock>,
+                              MicroBlockPtrLess>>
+      m_microBlocks;
   std::unordered_map<uint64_t, std::vector<BlockHash>> m_missingMicroBlocks;
   std::unordered_map<uint64_t, std::unordered_map<BlockHash, bytes>>
       m_microBlockStateDeltas;
   uint128_t m_totalTxnFees;
 
+  /// Running congestion statistics over the current DS epoch's final blocks,
+  /// updated incrementally in StoreFinalBlockToDisk so gas-price derivation
+  /// does not re-walk the tx block chain each DS epoch
+  struct GasCongestionStats {
+    uint64_t loBlockNum = 0;
+    uint64_t hiBlockNum = 0;
+    uint64_t totalBlockNum = 0;
+    uint64_t fullBlockNum = 0;
+    bool valid = false;
+  };
+  std::mutex m_mutexGasCongestionStats;
+  GasCongestionStats m_gasCongestionStats;
+
   Synchronizer m_synchronizer;
 
   // For view change pre check
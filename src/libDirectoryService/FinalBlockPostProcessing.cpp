@@ -69,6 +69,8 @@ bool DirectoryService::StoreFinalBlockToDisk() {
   m_mediator.m_node->AddBlock(*m_finalBlock);
   m_mediator.IncreaseEpochNum();
 
+  UpdateGasCongestionStats(*m_finalBlock);
+
   // At this point, the transactions in the last Epoch is no longer useful, thus
   // erase.
   // m_mediator.m_node->EraseCommittedTransactions(m_mediator.m_currentEpochNum
@@ -248,7 +250,7 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone() {
   const auto& microBlocks = m_microBlocks
       [m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum()];
   for (const auto& microBlock : microBlocks) {
-    t_microBlocks.emplace(microBlock.GetHeader().GetShardId(), microBlock);
+    t_microBlocks.emplace(microBlock->GetHeader().GetShardId(), *microBlock);
   }
 
   DequeOfShard t_shards;
@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <chrono>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "DirectoryService.h"
 #include "common/Constants.h"
@@ -26,6 +28,7 @@
 #include "depends/common/RLP.h"
 #include "depends/libTrie/TrieDB.h"
 #include "depends/libTrie/TrieHash.h"
+#include "libConsensus/ConsensusTimeouts.h"
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
@@ -62,30 +65,32 @@ void DirectoryService::ExtractDataFromMicroblocks(
     LOG_STATE("[STATS][" << std::setw(15) << std::left
                          << m_mediator.m_selfPeer.GetPrintableIPAddress()
                          << "][" << i << "    ]["
-                         << microBlock.GetHeader().GetNumTxs() << "] PROPOSED");
+                         << microBlock->GetHeader().GetNumTxs()
+                         << "] PROPOSED");
 
     i++;
 
     LOG_GENERAL(INFO, "Pushback microblock shard ID: "
-                          << microBlock.GetHeader().GetShardId() << endl
-                          << "hash: " << microBlock.GetHeader().GetHashes());
+                          << microBlock->GetHeader().GetShardId() << endl
+                          << "hash: " << microBlock->GetHeader().GetHashes());
 
     uint64_t tmpGasLimit = allGasLimit, tmpGasUsed = allGasUsed;
     uint128_t tmpRewards = allRewards;
 
     bool flag = true;
-    if (!SafeMath<uint64_t>::add(
-            allGasLimit, microBlock.GetHeader().GetGasLimit(), allGasLimit)) {
+    if (!SafeMath<uint64_t>::add(allGasLimit,
+                                 microBlock->GetHeader().GetGasLimit(),
+                                 allGasLimit)) {
       flag = false;
     }
     if (flag &&
         !SafeMath<uint64_t>::add(
-            allGasUsed, microBlock.GetHeader().GetGasUsed(), allGasUsed)) {
+            allGasUsed, microBlock->GetHeader().GetGasUsed(), allGasUsed)) {
       flag = false;
     }
     if (flag &&
         !SafeMath<uint128_t>::add(
-            allRewards, microBlock.GetHeader().GetRewards(), allRewards)) {
+            allRewards, microBlock->GetHeader().GetRewards(), allRewards)) {
       flag = false;
     }
     if (!flag) {
@@ -94,11 +99,11 @@ void DirectoryService::ExtractDataFromMicroblocks(
       allRewards = tmpRewards;
     }
 
-    numTxs += microBlock.GetHeader().GetNumTxs();
+    numTxs += microBlock->GetHeader().GetNumTxs();
 
-    mbInfos.push_back({microBlock.GetBlockHash(),
-                       microBlock.GetHeader().GetTxRootHash(),
-                       microBlock.GetHeader().GetShardId()});
+    mbInfos.push_back({microBlock->GetBlockHash(),
+                       microBlock->GetHeader().GetTxRootHash(),
+                       microBlock->GetHeader().GetShardId()});
   }
 }
 
@@ -227,7 +232,7 @@ bool DirectoryService::RunConsensusOnFinalBlockWhenDSPrimary() {
     m_mediator.m_node->m_microblock = nullptr;
   } else {
     m_microBlocks[m_mediator.m_currentEpochNum].emplace(
-        *(m_mediator.m_node->m_microblock));
+        m_mediator.m_node->m_microblock);
   }
 
   // stores it in m_finalBlock
@@ -412,9 +417,15 @@ bool DirectoryService::CheckMicroBlocks(bytes& errorMsg, bool fromShards,
     lock_guard<mutex> g(m_mutexMicroBlocks);
 
     m_missingMicroBlocks[m_mediator.m_currentEpochNum].clear();
-    // O(n^2) might be fine since number of shards is low
-    // If its slow on benchmarking, may be first populate an unordered_set and
-    // then std::find
+
+    // Populate the local hashes once so each microblock info in the final
+    // block costs a single lookup rather than a scan over all microblocks
+    std::unordered_set<BlockHash> localMicroBlockHashes;
+    for (const auto& microBlock :
+         m_microBlocks[m_mediator.m_currentEpochNum]) {
+      localMicroBlockHashes.emplace(microBlock->GetBlockHash());
+    }
+
     for (const auto& info : m_finalBlock->GetMicroBlockInfos()) {
       if (info.m_shardId == m_shards.size()) {
         continue;
@@ -422,16 +433,8 @@ bool DirectoryService::CheckMicroBlocks(bytes& errorMsg, bool fromShards,
 
       BlockHash hash = info.m_microBlockHash;
       LOG_GENERAL(INFO, "MicroBlock hash = " << hash);
-      bool found = false;
-      auto& microBlocks = m_microBlocks[m_mediator.m_currentEpochNum];
-      for (auto& microBlock : microBlocks) {
-        if (microBlock.GetBlockHash() == hash) {
-          found = true;
-          break;
-        }
-      }
 
-      if (!found) {
+      if (localMicroBlockHashes.find(hash) == localMicroBlockHashes.end()) {
         LOG_GENERAL(WARNING, "cannot find microblock with hash: " << hash);
         m_missingMicroBlocks[m_mediator.m_currentEpochNum].emplace_back(hash);
       }
@@ -496,18 +499,19 @@ bool DirectoryService::CheckLegitimacyOfMicroBlocks() {
       uint128_t tmpRewards = allRewards;
 
       bool flag = true;
-      if (!SafeMath<uint64_t>::add(
-              allGasLimit, microBlock.GetHeader().GetGasLimit(), allGasLimit)) {
+      if (!SafeMath<uint64_t>::add(allGasLimit,
+                                   microBlock->GetHeader().GetGasLimit(),
+                                   allGasLimit)) {
         flag = false;
       }
       if (flag &&
           !SafeMath<uint64_t>::add(
-              allGasUsed, microBlock.GetHeader().GetGasUsed(), allGasUsed)) {
+              allGasUsed, microBlock->GetHeader().GetGasUsed(), allGasUsed)) {
         flag = false;
       }
       if (flag &&
           !SafeMath<uint128_t>::add(
-              allRewards, microBlock.GetHeader().GetRewards(), allRewards)) {
+              allRewards, microBlock->GetHeader().GetRewards(), allRewards)) {
         flag = false;
       }
       if (!flag) {
@@ -516,7 +520,7 @@ bool DirectoryService::CheckLegitimacyOfMicroBlocks() {
         allRewards = tmpRewards;
       }
 
-      allNumTxns += microBlock.GetHeader().GetNumTxs();
+      allNumTxns += microBlock->GetHeader().GetNumTxs();
       ++allNumMicroBlockHashes;
     }
   }
@@ -652,39 +656,37 @@ bool DirectoryService::OnNodeMissingMicroBlocks(const bytes& errorMsg,
   vector<MicroBlock> microBlocksSent;
   vector<bytes> stateDeltasSent;
 
-  for (const auto& hash : missingMicroBlocks) {
-    bool found = false;
-    // O(n^2) might be fine since number of shards is low
-    // If its slow on benchmarking, may be first populate an unordered_set and
-    // then std::find
-    auto microBlockIter = microBlocks.begin();
-    for (; microBlockIter != microBlocks.end(); microBlockIter++) {
-      if (microBlockIter->GetBlockHash() == hash) {
-        found = true;
-        break;
-      }
-    }
+  // Index the local microblocks by hash once, so each requested hash costs
+  // a single lookup rather than a scan over all microblocks
+  std::unordered_map<BlockHash, const MicroBlock*> microBlocksByHash;
+  for (const auto& microBlock : microBlocks) {
+    microBlocksByHash.emplace(microBlock->GetBlockHash(), microBlock.get());
+  }
 
-    if (microBlockIter->GetHeader().GetShardId() == m_shards.size()) {
-      LOG_GENERAL(WARNING, "Ignore the fetching of DS microblock");
+  for (const auto& hash : missingMicroBlocks) {
+    auto microBlockIter = microBlocksByHash.find(hash);
+    if (microBlockIter == microBlocksByHash.end()) {
+      LOG_GENERAL(WARNING,
+                  "cannot find missing microblock: (hash)" << hash.hex());
       continue;
     }
 
-    if (!found) {
-      LOG_GENERAL(WARNING,
-                  "cannot find missing microblock: (hash)" << hash.hex());
+    const MicroBlock& microBlock = *microBlockIter->second;
+
+    if (microBlock.GetHeader().GetShardId() == m_shards.size()) {
+      LOG_GENERAL(WARNING, "Ignore the fetching of DS microblock");
       continue;
     }
 
     auto found_delta =
-        m_microBlockStateDeltas[epochNum].find(microBlockIter->GetBlockHash());
+        m_microBlockStateDeltas[epochNum].find(microBlock.GetBlockHash());
     if (found_delta != m_microBlockStateDeltas[epochNum].end()) {
       stateDeltasSent.emplace_back(found_delta->second);
     } else {
       stateDeltasSent.push_back({});
     }
 
-    microBlocksSent.emplace_back(*microBlockIter);
+    microBlocksSent.emplace_back(microBlock);
   }
 
   // // Final state delta
@@ -737,9 +739,10 @@ bool DirectoryService::CheckMicroBlockInfo() {
     //                 << m_finalBlock->GetIsMicroBlockEmpty()[i]);
     auto& microBlocks = m_microBlocks[m_mediator.m_currentEpochNum];
     for (auto& microBlock : microBlocks) {
-      if (microBlock.GetBlockHash() == microBlockInfos.at(i).m_microBlockHash) {
+      if (microBlock->GetBlockHash() ==
+          microBlockInfos.at(i).m_microBlockHash) {
         if (m_finalBlock->GetMicroBlockInfos().at(i).m_txnRootHash !=
-            microBlock.GetHeader().GetTxRootHash()) {
+            microBlock->GetHeader().GetTxRootHash()) {
           LOG_GENERAL(
               WARNING,
               "MicroBlockInfo::m_txnRootHash in proposed final block is "
@@ -747,7 +750,7 @@ bool DirectoryService::CheckMicroBlockInfo() {
                   << endl
                   << "MB Hash: " << microBlockInfos.at(i).m_microBlockHash
                   << endl
-                  << "Expected: " << microBlock.GetHeader().GetTxRootHash()
+                  << "Expected: " << microBlock->GetHeader().GetTxRootHash()
                   << " Received: "
                   << m_finalBlock->GetMicroBlockInfos().at(i).m_txnRootHash);
 
@@ -756,14 +759,14 @@ bool DirectoryService::CheckMicroBlockInfo() {
 
           return false;
         } else if (m_finalBlock->GetMicroBlockInfos().at(i).m_shardId !=
-                   microBlock.GetHeader().GetShardId()) {
+                   microBlock->GetHeader().GetShardId()) {
           LOG_GENERAL(
               WARNING,
               "ShardIds in proposed final block is incorrect"
                   << endl
                   << "MB Hash: " << microBlockInfos.at(i).m_microBlockHash
                   << endl
-                  << "Expected: " << (microBlock.GetHeader().GetShardId() == 0)
+                  << "Expected: " << (microBlock->GetHeader().GetShardId() == 0)
                   << " Received: "
                   << m_finalBlock->GetMicroBlockInfos().at(i).m_shardId);
           return false;
@@ -925,7 +928,7 @@ bool DirectoryService::CheckMicroBlockValidity(bytes& errorMsg) {
     m_mediator.m_node->m_microblock = nullptr;
   } else {
     m_microBlocks[m_mediator.m_currentEpochNum].emplace(
-        *(m_mediator.m_node->m_microblock));
+        m_mediator.m_node->m_microblock);
   }
 
   return ret;
@@ -1233,7 +1236,9 @@ void DirectoryService::RunConsensusOnFinalBlock() {
     // before timeout, the thread will return without triggering view change.
     std::unique_lock<std::mutex> cv_lk(m_MutexCVViewChangeFinalBlock);
     if (cv_viewChangeFinalBlock.wait_for(
-            cv_lk, std::chrono::seconds(VIEWCHANGE_TIME)) ==
+            cv_lk, std::chrono::seconds(
+                       ConsensusTimeouts::GetInstance().GetViewChangeTimeout(
+                           ConsensusTimeouts::FINALBLOCK))) ==
         std::cv_status::timeout) {
       LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
                 "Initiated final block view change");
@@ -1264,10 +1269,11 @@ void DirectoryService::RemoveDSMicroBlock() {
   lock_guard<mutex> g(m_mutexMicroBlocks);
 
   auto& microBlocksAtEpoch = m_microBlocks[m_mediator.m_currentEpochNum];
-  auto dsmb = find_if(microBlocksAtEpoch.begin(), microBlocksAtEpoch.end(),
-                      [this](const MicroBlock& mb) -> bool {
-                        return mb.GetHeader().GetShardId() == m_shards.size();
-                      });
+  auto dsmb =
+      find_if(microBlocksAtEpoch.begin(), microBlocksAtEpoch.end(),
+              [this](const shared_ptr<const MicroBlock>& mb) -> bool {
+                return mb->GetHeader().GetShardId() == m_shards.size();
+              });
   if (dsmb != microBlocksAtEpoch.end()) {
     LOG_GENERAL(INFO, "Removed DS microblock from list of microblocks");
     microBlocksAtEpoch.erase(dsmb);
@@ -22,6 +22,44 @@
 using namespace std;
 using namespace boost::multiprecision;
 
+namespace {
+
+bool IsBlockCongested(const TxBlockHeader& header) {
+  const uint128_t gasUsed = header.GetGasUsed();
+  const uint128_t gasLimit = header.GetGasLimit();
+  return gasUsed >= gasLimit * GAS_CONGESTION_PERCENT / 100;
+}
+
+}  // namespace
+
+void DirectoryService::UpdateGasCongestionStats(const TxBlock& txBlock) {
+  lock_guard<mutex> g(m_mutexGasCongestionStats);
+
+  const uint64_t blockNum = txBlock.GetHeader().GetBlockNum();
+  const uint64_t windowStart =
+      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum();
+
+  if (blockNum == windowStart) {
+    // First final block of the DS epoch restarts the window
+    m_gasCongestionStats = GasCongestionStats();
+    m_gasCongestionStats.loBlockNum = windowStart;
+    m_gasCongestionStats.valid = true;
+  } else if (!m_gasCongestionStats.valid ||
+             (m_gasCongestionStats.loBlockNum != windowStart) ||
+             (blockNum != m_gasCongestionStats.hiBlockNum + 1)) {
+    // Out of sequence (e.g. node joined mid-epoch); GetNewGasPrice will
+    // fall back to walking the chain and reseed the stats
+    m_gasCongestionStats.valid = false;
+    return;
+  }
+
+  m_gasCongestionStats.hiBlockNum = blockNum;
+  m_gasCongestionStats.totalBlockNum++;
+  if (IsBlockCongested(txBlock.GetHeader())) {
+    m_gasCongestionStats.fullBlockNum++;
+  }
+}
+
 uint128_t DirectoryService::GetNewGasPrice() {
   LOG_MARKER();
 
@@ -32,15 +70,31 @@ uint128_t DirectoryService::GetNewGasPrice() {
   uint64_t totalBlockNum = 0;
   uint64_t fullBlockNum = 0;
 
-  for (uint64_t i = loBlockNum; i <= hiBlockNum; ++i) {
-    uint128_t gasUsed =
-        m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetGasUsed();
-    uint128_t gasLimit =
-        m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetGasLimit();
-    if (gasUsed >= gasLimit * GAS_CONGESTION_PERCENT / 100) {
-      fullBlockNum++;
+  {
+    lock_guard<mutex> g(m_mutexGasCongestionStats);
+    if (m_gasCongestionStats.valid &&
+        (m_gasCongestionStats.loBlockNum == loBlockNum) &&
+        (m_gasCongestionStats.hiBlockNum == hiBlockNum)) {
+      totalBlockNum = m_gasCongestionStats.totalBlockNum;
+      fullBlockNum = m_gasCongestionStats.fullBlockNum;
     }
-    totalBlockNum++;
+  }
+
+  if (totalBlockNum == 0) {
+    for (uint64_t i = loBlockNum; i <= hiBlockNum; ++i) {
+      if (IsBlockCongested(
+              m_mediator.m_txBlockChain.GetBlockHeader(i))) {
+        fullBlockNum++;
+      }
+      totalBlockNum++;
+    }
+
+    lock_guard<mutex> g(m_mutexGasCongestionStats);
+    m_gasCongestionStats.loBlockNum = loBlockNum;
+    m_gasCongestionStats.hiBlockNum = hiBlockNum;
+    m_gasCongestionStats.totalBlockNum = totalBlockNum;
+    m_gasCongestionStats.fullBlockNum = fullBlockNum;
+    m_gasCongestionStats.valid = true;
   }
 
   if (fullBlockNum < totalBlockNum * UNFILLED_PERCENT_LOW / 100) {
@@ -196,7 +196,10 @@ bool DirectoryService::ProcessStateDelta(
 }
 
 bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
-    const MicroBlock& microBlock, const bytes& stateDelta) {
+    const std::shared_ptr<const MicroBlock>& microBlockPtr,
+    const bytes& stateDelta) {
+  const MicroBlock& microBlock = *microBlockPtr;
+
   if (LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
                 "DirectoryService::ProcessMicroblockSubmissionCore not "
@@ -212,8 +215,8 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
     // Check if we already received a validated microblock with the same shard
     // id. Save on unnecessary-validation.
     if (find_if(microBlocksAtEpoch.begin(), microBlocksAtEpoch.end(),
-                [shardId](const MicroBlock& mb) -> bool {
-                  return mb.GetHeader().GetShardId() == shardId;
+                [shardId](const shared_ptr<const MicroBlock>& mb) -> bool {
+                  return mb->GetHeader().GetShardId() == shardId;
                 }) != microBlocksAtEpoch.end()) {
       LOG_GENERAL(WARNING,
                   "Duplicate microblock received for shard " << shardId);
@@ -330,7 +333,7 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShardCore(
   }
 
   auto& microBlocksAtEpoch = m_microBlocks[m_mediator.m_currentEpochNum];
-  microBlocksAtEpoch.emplace(microBlock);
+  microBlocksAtEpoch.emplace(microBlockPtr);
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             microBlocksAtEpoch.size()
@@ -385,7 +388,7 @@ void DirectoryService::CommitMBSubmissionMsgBuffer() {
 }
 
 bool DirectoryService::ProcessMicroblockSubmissionFromShard(
-    const uint64_t epochNumber, const vector<MicroBlock>& microBlocks,
+    const uint64_t epochNumber, vector<MicroBlock>& microBlocks,
     const vector<bytes>& stateDeltas) {
   LOG_MARKER();
 
@@ -442,7 +445,10 @@ bool DirectoryService::ProcessMicroblockSubmissionFromShard(
     return false;
   }
 
-  const auto& microBlock = microBlocks.at(0);
+  // Take ownership of the deserialized microblock once; everything after
+  // this point (buffer, pending set, final-block assembly) shares it
+  const auto microBlock =
+      make_shared<const MicroBlock>(std::move(microBlocks.at(0)));
   const auto& stateDelta = stateDeltas.at(0);
 
   if (m_mediator.m_currentEpochNum < epochNumber) {
@@ -525,7 +531,7 @@ bool DirectoryService::ProcessMicroblockSubmission(
 }
 
 bool DirectoryService::ProcessMissingMicroblockSubmission(
-    const uint64_t epochNumber, const vector<MicroBlock>& microBlocks,
+    const uint64_t epochNumber, vector<MicroBlock>& microBlocks,
     const vector<bytes>& stateDeltas) {
   if (epochNumber != m_mediator.m_currentEpochNum) {
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
@@ -625,7 +631,7 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
         bool found = false;
         const auto& myMicroBlocks = m_microBlocks[epochNumber];
         for (const auto& myMicroBlock : myMicroBlocks) {
-          if (myMicroBlock.GetBlockHash() == microBlocks[i].GetBlockHash()) {
+          if (myMicroBlock->GetBlockHash() == microBlocks[i].GetBlockHash()) {
             found = true;
             break;
           }
@@ -667,7 +673,8 @@ bool DirectoryService::ProcessMissingMicroblockSubmission(
         return false;
       }
 
-      microBlocksAtEpoch.emplace(microBlocks.at(i));
+      microBlocksAtEpoch.emplace(
+          make_shared<const MicroBlock>(std::move(microBlocks.at(i))));
       // m_fetchedMicroBlocks.emplace(microBlock);
 
       LOG_GENERAL(INFO, microBlocksAtEpoch.size()
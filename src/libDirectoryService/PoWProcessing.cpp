@@ -36,6 +36,7 @@
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -116,13 +117,33 @@ bool DirectoryService::ProcessPoWPacketSubmission(
   }
 
   LOG_GENERAL(INFO, "PoW solutions received in this packet: " << tmp.size());
-  for (auto& sol : tmp) {
-    // No point processing the other solutions if DS Block consensus is starting
-    if ((m_state == DSBLOCK_CONSENSUS_PREP) || (m_state == DSBLOCK_CONSENSUS)) {
-      LOG_GENERAL(INFO, "Too late");
-      break;
-    }
-    VerifyPoWSubmission(sol);
+
+  if (tmp.size() == 1) {
+    VerifyPoWSubmission(tmp.front());
+    return true;
+  }
+
+  // The ethash verification dominates the cost of each solution and the
+  // solutions are independent, so verify the packet on a pool instead of
+  // one at a time; m_allPoWs updates are guarded inside VerifyPoWSubmission
+  const unsigned int NUMTHREADS =
+      min<unsigned int>(tmp.size(), max(1u, thread::hardware_concurrency()));
+  ThreadPool verifyPool(NUMTHREADS, "PoWVerifyPool");
+
+  for (const auto& sol : tmp) {
+    verifyPool.AddJob([this, sol]() {
+      // No point processing the solution if DS Block consensus is starting
+      if ((m_state == DSBLOCK_CONSENSUS_PREP) ||
+          (m_state == DSBLOCK_CONSENSUS)) {
+        LOG_GENERAL(INFO, "Too late");
+        return;
+      }
+      VerifyPoWSubmission(sol);
+    });
+  }
+
+  while (verifyPool.GetJobsLeft() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(10));
   }
 
   return true;
@@ -292,6 +313,19 @@ bool DirectoryService::VerifyPoWSubmission(const DSPowSolution& sol) {
     return false;
   }
 
+  // Cheap duplicate rejection before the expensive ethash verification: a
+  // resubmission of an already-accepted solution cannot change m_allPoWs
+  {
+    array<uint8_t, 32> resultingHashArr{};
+    DataConversion::HexStrToStdArray(resultingHash, resultingHashArr);
+    lock_guard<mutex> g(m_mutexAllPOW);
+    auto iter = m_allPoWs.find(submitterPubKey);
+    if (iter != m_allPoWs.end() && iter->second.result == resultingHashArr) {
+      LOG_GENERAL(INFO, "Duplicated");
+      return true;
+    }
+  }
+
   // Define the PoW parameters
   array<unsigned char, 32> rand1 = m_mediator.m_dsBlockRand;
   array<unsigned char, 32> rand2 = m_mediator.m_txBlockRand;
@@ -333,7 +333,7 @@ void DirectoryService::ProcessViewChangeConsensusWhenDone() {
     const auto& microBlocks = m_microBlocks
         [m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum()];
     for (const auto& microBlock : microBlocks) {
-      t_microBlocks.emplace(microBlock.GetHeader().GetShardId(), microBlock);
+      t_microBlocks.emplace(microBlock->GetHeader().GetShardId(), *microBlock);
     }
 
     DequeOfShard t_shards;
@@ -394,6 +394,41 @@ bool DirectoryService::ProcessViewChangeConsensus(const bytes& message,
   }
 
   LOG_MARKER();
+
+  // Deserialize and verify the signature on the dispatcher thread, before
+  // any consensus lock or condition variable wait, so a storm of malformed
+  // or unsigned messages never stalls the consensus state machine behind
+  // m_mutexConsensus
+  std::shared_ptr<ConsensusCommon> consensusObject;
+  {
+    lock_guard<mutex> g(m_mutexConsensus);
+    consensusObject = m_consensusObject;
+  }
+
+  if (consensusObject == nullptr) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "m_consensusObject is a nullptr. It has not been initialized.");
+    return false;
+  }
+
+  uint32_t unused_consensus_id = 0;
+  bytes unused_reserialized_message;
+  PubKey senderPubKey;
+
+  if (!consensusObject->PreProcessMessage(message, offset, unused_consensus_id,
+                                          senderPubKey,
+                                          unused_reserialized_message)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "PreProcessMessage failed");
+    return false;
+  }
+
+  if (!CheckIfDSNode(senderPubKey)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "ProcessViewChangeConsensus signed by non ds member");
+    return false;
+  }
+
   // Consensus messages must be processed in correct sequence as they come in
   // It is possible for ANNOUNCE to arrive before correct DS state
   // In that case, ANNOUNCE will sleep for a second below
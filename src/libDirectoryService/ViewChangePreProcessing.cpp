@@ -26,6 +26,7 @@
 #include "depends/common/RLP.h"
 #include "depends/libTrie/TrieDB.h"
 #include "depends/libTrie/TrieHash.h"
+#include "libConsensus/ConsensusTimeouts.h"
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
@@ -267,16 +268,17 @@ void DirectoryService::RunConsensusOnViewChange() {
   // VCFetchLatestDSTxBlockFromSeedNodes always check for current block + 1
   // i.e in first epoch, it will request for block 1, which means fetch latest
   // block (including block 0)
-  if (dsCurBlockNum != 0 && txCurBlockNum != 0) {
-    VCFetchLatestDSTxBlockFromSeedNodes();
-    if (!NodeVCPrecheck()) {
-      LOG_GENERAL(WARNING,
-                  "[RDS]Failed the vc precheck. Node is lagging behind the "
-                  "whole network.");
-      CleanUpViewChange(true);
-      RejoinAsDS();
-      return;
+  const bool precheckNeeded = (dsCurBlockNum != 0 && txCurBlockNum != 0);
+  if (precheckNeeded) {
+    // Send the precheck request first; the candidate leader computation and
+    // consensus object setup below then overlap the seed node round trip
+    // instead of extending it
+    {
+      lock_guard<mutex> g(m_MutexCVViewChangePrecheckBlocks);
+      m_vcPreCheckDSBlocks.clear();
+      m_vcPreCheckTxBlocks.clear();
     }
+    VCFetchLatestDSTxBlockFromSeedNodes();
   }
 
   // Blacklist::GetInstance().Clear();
@@ -290,6 +292,7 @@ void DirectoryService::RunConsensusOnViewChange() {
   }
 
   bool ConsensusObjCreation = true;
+  bool isCandidateLeader = false;
 
   {
     lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
@@ -324,6 +327,7 @@ void DirectoryService::RunConsensusOnViewChange() {
     // We compare with empty peer is due to the fact that DSCommittee for
     // yourself is 0.0.0.0 with port 0.
     if (m_mediator.m_DSCommittee->at(m_candidateLeaderIndex).second == Peer()) {
+      isCandidateLeader = true;
       ConsensusObjCreation =
           RunConsensusOnViewChangeWhenCandidateLeader(m_candidateLeaderIndex);
       if (!ConsensusObjCreation) {
@@ -340,9 +344,27 @@ void DirectoryService::RunConsensusOnViewChange() {
     }
   }
 
+  // Only now collect the precheck verdict; the setup above ran while the
+  // response was in flight, and nothing has been announced yet if the
+  // precheck says we are the ones lagging behind
+  if (precheckNeeded && !NodeVCPrecheck()) {
+    LOG_GENERAL(WARNING,
+                "[RDS]Failed the vc precheck. Node is lagging behind the "
+                "whole network.");
+    CleanUpViewChange(true);
+    RejoinAsDS();
+    return;
+  }
+
   if (ConsensusObjCreation) {
     SetState(VIEWCHANGE_CONSENSUS);
     cv_ViewChangeConsensusObj.notify_all();
+
+    if (isCandidateLeader &&
+        !StartViewChangeConsensusAsCandidateLeader()) {
+      LOG_GENERAL(WARNING,
+                  "Error after StartViewChangeConsensusAsCandidateLeader");
+    }
   }
 
   auto func = [this]() -> void { ScheduleViewChangeTimeout(); };
@@ -358,8 +380,10 @@ void DirectoryService::ScheduleViewChangeTimeout() {
   }
 
   std::unique_lock<std::mutex> cv_lk(m_MutexCVViewChangeVCBlock);
-  if (cv_ViewChangeVCBlock.wait_for(cv_lk,
-                                    std::chrono::seconds(VIEWCHANGE_TIME)) ==
+  if (cv_ViewChangeVCBlock.wait_for(
+          cv_lk, std::chrono::seconds(
+                     ConsensusTimeouts::GetInstance().GetViewChangeTimeout(
+                         ConsensusTimeouts::VIEWCHANGE))) ==
       std::cv_status::timeout) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Initiated view change again");
@@ -437,11 +461,10 @@ bool DirectoryService::ComputeNewCandidateLeader(
 
 bool DirectoryService::NodeVCPrecheck() {
   LOG_MARKER();
-  {
-    lock_guard<mutex> g(m_MutexCVViewChangePrecheckBlocks);
-    m_vcPreCheckDSBlocks.clear();
-    m_vcPreCheckTxBlocks.clear();
-  }
+
+  // Note: the precheck block buffers are cleared by the caller before the
+  // fetch request goes out, so a response that arrives while the candidate
+  // leader setup is still running is not thrown away here
 
   std::unique_lock<std::mutex> cv_lk(m_MutexCVViewChangePrecheck);
   if (cv_viewChangePrecheck.wait_for(
@@ -635,12 +658,26 @@ bool DirectoryService::RunConsensusOnViewChangeWhenCandidateLeader(
     return false;
   }
 
+  return true;
+}
+
+bool DirectoryService::StartViewChangeConsensusAsCandidateLeader() {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "DirectoryService::"
+                "StartViewChangeConsensusAsCandidateLeader not expected "
+                "to be called from LookUp node.");
+    return true;
+  }
+
+  LOG_MARKER();
+
   ConsensusLeader* cl = dynamic_cast<ConsensusLeader*>(m_consensusObject.get());
 
-  bytes m;
-  {
-    lock_guard<mutex> g(m_mutexPendingVCBlock);
-    m_pendingVCBlock->Serialize(m, 0);
+  if (cl == nullptr) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "Error: consensus object is not the leader");
+    return false;
   }
 
   std::this_thread::sleep_for(std::chrono::seconds(VIEWCHANGE_EXTRA_TIME));
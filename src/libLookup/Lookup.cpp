@@ -24,7 +24,10 @@
 #include <cstring>
 #include <exception>
 #include <fstream>
+#include <iterator>
+#include <limits>
 #include <random>
+#include <sstream>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -54,12 +57,26 @@
 #include "libUtils/RandomGenerator.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/SysCommand.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 using namespace boost::multiprecision;
 
 const int32_t MAX_FETCH_BLOCK_RETRIES = 5;
 
+// Size of one tx block range requested from a single seed during catch-up,
+// and how many such disjoint ranges are requested from different seeds in
+// parallel when the deficit is known to be large
+const uint64_t TXBLOCK_FETCH_WINDOW = 512;
+const unsigned int MAX_PARALLEL_FETCH_WINDOWS = 4;
+
+// Seed latency scoring: EWMA smoothing factor, how often a request goes to a
+// uniformly random seed instead of the best-scored one (so a recovered seed
+// can shed a bad score), and how many score updates between persists
+const double SEED_SCORE_EWMA_ALPHA = 0.25;
+const unsigned int SEED_SCORE_EXPLORE_ONE_IN = 5;
+const unsigned int SEED_SCORE_PERSIST_EVERY = 16;
+
 Lookup::Lookup(Mediator& mediator, SyncType syncType) : m_mediator(mediator) {
   m_syncType.store(SyncType::NO_SYNC);
   vector<SyncType> ignorable_syncTypes = {NO_SYNC, DB_VERIF};
@@ -155,7 +172,7 @@ void Lookup::SetLookupNodes(const VectorOfNode& lookupNodes) {
 void Lookup::SetLookupNodes() {
   LOG_MARKER();
 
-  std::lock_guard<std::mutex> lock(m_mutexLookupNodes);
+  std::lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
 
   m_startedTxnBatchThread = false;
   m_lookupNodes.clear();
@@ -294,7 +311,7 @@ void Lookup::SetAboveLayer() {
 }
 
 VectorOfNode Lookup::GetSeedNodes() const {
-  lock_guard<mutex> g(m_mutexSeedNodes);
+  lock_guard<ProfiledMutex> g(m_mutexSeedNodes);
 
   return m_seedNodes;
 }
@@ -443,13 +460,13 @@ bool Lookup::GenTxnToSend(size_t num_txn,
 
 VectorOfNode Lookup::GetLookupNodes() const {
   LOG_MARKER();
-  lock_guard<mutex> lock(m_mutexLookupNodes);
+  lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
   return m_lookupNodes;
 }
 
 VectorOfNode Lookup::GetLookupNodesStatic() const {
   LOG_MARKER();
-  lock_guard<mutex> lock(m_mutexLookupNodes);
+  lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
   return m_lookupNodesStatic;
 }
 
@@ -492,7 +509,7 @@ void Lookup::SendMessageToLookupNodes(const bytes& message) const {
   vector<Peer> allLookupNodes;
 
   {
-    lock_guard<mutex> lock(m_mutexLookupNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     for (const auto& node : m_lookupNodes) {
       auto resolved_ip = TryGettingResolvedIP(node.second);
 
@@ -515,7 +532,7 @@ void Lookup::SendMessageToLookupNodesSerial(const bytes& message) const {
   vector<Peer> allLookupNodes;
 
   {
-    lock_guard<mutex> lock(m_mutexLookupNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     for (const auto& node : m_lookupNodes) {
       if (find_if(m_multipliers.begin(), m_multipliers.end(),
                   [&node](const PairOfNode& mult) {
@@ -544,7 +561,7 @@ void Lookup::SendMessageToRandomLookupNode(const bytes& message) const {
 
   // int index = rand() % (NUM_LOOKUP_USE_FOR_SYNC) + m_lookupNodes.size()
   // - NUM_LOOKUP_USE_FOR_SYNC;
-  lock_guard<mutex> lock(m_mutexLookupNodes);
+  lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
   if (0 == m_lookupNodes.size()) {
     LOG_GENERAL(WARNING, "There is no lookup node existed yet!");
     return;
@@ -581,7 +598,7 @@ void Lookup::SendMessageToSeedNodes(const bytes& message) const {
 
   vector<Peer> seedNodePeer;
   {
-    lock_guard<mutex> g(m_mutexSeedNodes);
+    lock_guard<ProfiledMutex> g(m_mutexSeedNodes);
 
     for (const auto& node : m_seedNodes) {
       auto resolved_ip = TryGettingResolvedIP(node.second);
@@ -620,9 +637,16 @@ bytes Lookup::ComposeGetStateMessage() {
   bytes getStateMessage = {MessageType::LOOKUP,
                            LookupInstructionType::GETSTATEFROMSEED};
 
+  // Resume a chunked transfer from wherever the last applied chunk ended
+  bytes cursor;
+  {
+    lock_guard<mutex> g(m_mutexSetState);
+    cursor = m_stateSyncCursor;
+  }
+
   if (!Messenger::SetLookupGetStateFromSeed(
           getStateMessage, MessageOffset::BODY,
-          m_mediator.m_selfPeer.m_listenPortHost)) {
+          m_mediator.m_selfPeer.m_listenPortHost, true, cursor)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::SetLookupGetStateFromSeed failed.");
     return {};
@@ -767,6 +791,30 @@ bool Lookup::GetTxBlockFromSeedNodes(uint64_t lowBlockNum,
                                      uint64_t highBlockNum) {
   LOG_MARKER();
 
+  // When a previous response told us how far behind we are, fan the deficit
+  // out as disjoint windows to different seed peers instead of fetching one
+  // range per round trip; ProcessSetTxBlockFromSeed reassembles the
+  // responses in order. The last window is left open-ended so blocks minted
+  // past the known tip are still picked up.
+  const uint64_t knownTip = m_seedTxBlockTip.load();
+  if (highBlockNum == 0 && knownTip > lowBlockNum &&
+      knownTip - lowBlockNum >= TXBLOCK_FETCH_WINDOW) {
+    vector<bytes> messages;
+    uint64_t windowLow = lowBlockNum;
+    for (unsigned int i = 0; i < MAX_PARALLEL_FETCH_WINDOWS; i++) {
+      const bool lastWindow = (i == MAX_PARALLEL_FETCH_WINDOWS - 1) ||
+                              (windowLow + TXBLOCK_FETCH_WINDOW > knownTip);
+      messages.emplace_back(ComposeGetTxBlockMessage(
+          windowLow, lastWindow ? 0 : windowLow + TXBLOCK_FETCH_WINDOW - 1));
+      if (lastWindow) {
+        break;
+      }
+      windowLow += TXBLOCK_FETCH_WINDOW;
+    }
+    SendMessagesToSeedNodes(messages);
+    return true;
+  }
+
   SendMessageToRandomSeedNode(
       ComposeGetTxBlockMessage(lowBlockNum, highBlockNum));
 
@@ -855,7 +903,7 @@ vector<Peer> Lookup::GetNodePeers() {
     return vector<Peer>();
   }
 
-  lock_guard<mutex> g(m_mutexNodesInNetwork);
+  lock_guard<ProfiledMutex> g(m_mutexNodesInNetwork);
   return m_nodesInNetwork;
 }
 
@@ -873,7 +921,7 @@ bool Lookup::ProcessEntireShardingStructure() {
 
   lock(m_mediator.m_ds->m_mutexShards, m_mutexNodesInNetwork);
   lock_guard<mutex> g(m_mediator.m_ds->m_mutexShards, adopt_lock);
-  lock_guard<mutex> h(m_mutexNodesInNetwork, adopt_lock);
+  lock_guard<ProfiledMutex> h(m_mutexNodesInNetwork, adopt_lock);
 
   m_nodesInNetwork.clear();
   unordered_set<Peer> t_nodesInNetwork;
@@ -983,12 +1031,137 @@ bool Lookup::ProcessGetDSInfoFromSeed(const bytes& message, unsigned int offset,
   return true;
 }
 
+void Lookup::LoadSeedScores() const {
+  if (m_seedScoresLoaded) {
+    return;
+  }
+  m_seedScoresLoaded = true;
+
+  bytes data;
+  if (!BlockStorage::GetBlockStorage().GetMetadata(MetaType::SEEDPEERSCORES,
+                                                   data, true)) {
+    return;
+  }
+
+  try {
+    istringstream in(string(data.begin(), data.end()));
+    string ipStr;
+    double score;
+    while (in >> ipStr >> score) {
+      m_seedScores[uint128_t(ipStr)] = score;
+    }
+  } catch (const exception& e) {
+    LOG_GENERAL(WARNING, "Failed to parse persisted seed scores: " << e.what());
+    m_seedScores.clear();
+  }
+
+  LOG_GENERAL(INFO, "Loaded " << m_seedScores.size() << " seed node scores");
+}
+
+void Lookup::PersistSeedScores() const {
+  ostringstream out;
+  for (const auto& entry : m_seedScores) {
+    out << entry.first.str() << ' ' << entry.second << '\n';
+  }
+
+  const string serialized = out.str();
+  if (!BlockStorage::GetBlockStorage().PutMetadata(
+          MetaType::SEEDPEERSCORES,
+          bytes(serialized.begin(), serialized.end()))) {
+    LOG_GENERAL(WARNING, "Failed to persist seed node scores");
+  }
+}
+
+const Peer& Lookup::PickSeedNodeForRequest(
+    const VectorOfPeer& candidates) const {
+  lock_guard<mutex> g(m_mutexSeedScores);
+  LoadSeedScores();
+
+  size_t index = RandomGenerator::GetRandomInt(candidates.size());
+  if (RandomGenerator::GetRandomInt(SEED_SCORE_EXPLORE_ONE_IN) != 0) {
+    // Prefer the lowest latency EWMA; an unscored seed counts as fastest so
+    // that new peers get tried at least once
+    double bestScore = numeric_limits<double>::max();
+    for (size_t i = 0; i < candidates.size(); i++) {
+      const auto it = m_seedScores.find(candidates[i].GetIpAddress());
+      const double score = (it == m_seedScores.end()) ? 0 : it->second;
+      if (score < bestScore) {
+        bestScore = score;
+        index = i;
+      }
+    }
+  }
+
+  m_seedRequestTimes[candidates[index].GetIpAddress()] =
+      chrono::steady_clock::now();
+  return candidates[index];
+}
+
+void Lookup::RecordSeedResponse(const Peer& from) const {
+  lock_guard<mutex> g(m_mutexSeedScores);
+
+  const auto it = m_seedRequestTimes.find(from.GetIpAddress());
+  if (it == m_seedRequestTimes.end()) {
+    // No request of ours outstanding for this peer (e.g. the response was
+    // relayed through a multiplier), so there is no latency to measure
+    return;
+  }
+
+  const double latencyMs = chrono::duration_cast<chrono::milliseconds>(
+                               chrono::steady_clock::now() - it->second)
+                               .count();
+  m_seedRequestTimes.erase(it);
+
+  LoadSeedScores();
+  auto& score = m_seedScores[from.GetIpAddress()];
+  score = (score == 0) ? latencyMs
+                       : SEED_SCORE_EWMA_ALPHA * latencyMs +
+                             (1 - SEED_SCORE_EWMA_ALPHA) * score;
+
+  if (++m_seedScoreUpdates % SEED_SCORE_PERSIST_EVERY == 0) {
+    PersistSeedScores();
+  }
+}
+
 void Lookup::SendMessageToRandomSeedNode(const bytes& message) const {
   LOG_MARKER();
 
   VectorOfPeer notBlackListedSeedNodes;
   {
-    lock_guard<mutex> lock(m_mutexSeedNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexSeedNodes);
+    if (0 == m_seedNodes.size()) {
+      LOG_GENERAL(WARNING, "Seed nodes are empty");
+      return;
+    }
+
+    for (const auto& node : m_seedNodes) {
+      auto seedNodeIpToSend = TryGettingResolvedIP(node.second);
+      if (!Blacklist::GetInstance().Exist(seedNodeIpToSend) &&
+          (m_mediator.m_selfPeer.GetIpAddress() != seedNodeIpToSend)) {
+        notBlackListedSeedNodes.push_back(
+            Peer(seedNodeIpToSend, node.second.GetListenPortHost()));
+      }
+    }
+  }
+
+  if (notBlackListedSeedNodes.empty()) {
+    LOG_GENERAL(WARNING,
+                "All the seed nodes are blacklisted, please check you network "
+                "connection.");
+    return;
+  }
+
+  const Peer& seedNode = PickSeedNodeForRequest(notBlackListedSeedNodes);
+  LOG_GENERAL(INFO, "Sending message to " << seedNode);
+  P2PComm::GetInstance().SendMessage(seedNode, message);
+}
+
+void Lookup::SendMessagesToSeedNodes(const vector<bytes>& messages) const {
+  LOG_MARKER();
+
+  VectorOfPeer notBlackListedSeedNodes;
+  {
+    lock_guard<ProfiledMutex> lock(m_mutexSeedNodes);
     if (0 == m_seedNodes.size()) {
       LOG_GENERAL(WARNING, "Seed nodes are empty");
       return;
@@ -1012,8 +1185,11 @@ void Lookup::SendMessageToRandomSeedNode(const bytes& message) const {
   }
 
   auto index = RandomGenerator::GetRandomInt(notBlackListedSeedNodes.size());
-  LOG_GENERAL(INFO, "Sending message to " << notBlackListedSeedNodes[index]);
-  P2PComm::GetInstance().SendMessage(notBlackListedSeedNodes[index], message);
+  for (const auto& message : messages) {
+    LOG_GENERAL(INFO, "Sending message to " << notBlackListedSeedNodes[index]);
+    P2PComm::GetInstance().SendMessage(notBlackListedSeedNodes[index], message);
+    index = (index + 1) % notBlackListedSeedNodes.size();
+  }
 }
 
 // TODO: Refactor the code to remove the following assumption
@@ -1148,32 +1324,14 @@ void Lookup::RetrieveDSBlocks(vector<DSBlock>& dsBlocks, uint64_t& lowBlockNum,
     highBlockNum = curBlockNum;
   }
 
-  uint64_t blockNum;
-  for (blockNum = lowBlockNum; blockNum <= highBlockNum; blockNum++) {
-    try {
-      DSBlock dsblk = m_mediator.m_dsBlockChain.GetBlock(blockNum);
-      // TODO
-      // Workaround to identify dummy block as == comparator does not work on
-      // empty object for DSBlock and DSBlockheader().
-      if (dsblk.GetHeader().GetBlockNum() == INIT_BLOCK_NUMBER) {
-        LOG_GENERAL(WARNING,
-                    "Block Number " << blockNum << " does not exists.");
-        break;
-      }
-
-      dsBlocks.emplace_back(m_mediator.m_dsBlockChain.GetBlock(blockNum));
-    } catch (const char* e) {
-      LOG_GENERAL(INFO, "Block Number " << blockNum
-                                        << " absent. Didn't include it in "
-                                           "response message. Reason: "
-                                        << e);
-      break;
-    }
-  }
+  const uint64_t lastServedBlockNum = m_mediator.m_dsBlockChain.GetBlockRange(
+      lowBlockNum, highBlockNum, dsBlocks);
 
   // Reset the highBlockNum value if retrieval failed
-  if (blockNum != highBlockNum + 1) {
-    highBlockNum = blockNum - 1;
+  if (lastServedBlockNum != highBlockNum) {
+    LOG_GENERAL(WARNING, "Block Number " << lastServedBlockNum + 1
+                                         << " does not exists.");
+    highBlockNum = lastServedBlockNum;
   }
 }
 
@@ -1189,8 +1347,11 @@ bool Lookup::ProcessGetStateFromSeed(const bytes& message, unsigned int offset,
   LOG_MARKER();
 
   uint32_t portNo = 0;
+  bool chunked = false;
+  bytes cursor;
 
-  if (!Messenger::GetLookupGetStateFromSeed(message, offset, portNo)) {
+  if (!Messenger::GetLookupGetStateFromSeed(message, offset, portNo, chunked,
+                                            cursor)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::GetLookupGetStateFromSeed failed.");
     return false;
@@ -1200,9 +1361,30 @@ bool Lookup::ProcessGetStateFromSeed(const bytes& message, unsigned int offset,
   bytes setStateMessage = {MessageType::LOOKUP,
                            LookupInstructionType::SETSTATEFROMSEED};
 
-  if (!Messenger::SetLookupSetStateFromSeed(
-          setStateMessage, MessageOffset::BODY, m_mediator.m_selfKey,
-          AccountStore::GetInstance())) {
+  if (chunked) {
+    // Serialize only one bounded slice of the state per request; the
+    // requester walks the address space with the returned cursor, so memory
+    // here stays proportional to the chunk and a dropped connection resumes
+    // from the last applied chunk instead of restarting
+    bytes chunk;
+    bytes nextCursor;
+    if (!AccountStore::GetInstance().SerializeChunk(
+            cursor, SEED_STATE_CHUNK_NUM_ACCOUNTS, chunk, nextCursor)) {
+      LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+                "AccountStore::SerializeChunk failed.");
+      return false;
+    }
+
+    if (!Messenger::SetLookupSetStateFromSeedChunk(
+            setStateMessage, MessageOffset::BODY, m_mediator.m_selfKey, chunk,
+            nextCursor)) {
+      LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+                "Messenger::SetLookupSetStateFromSeedChunk failed.");
+      return false;
+    }
+  } else if (!Messenger::SetLookupSetStateFromSeed(
+                 setStateMessage, MessageOffset::BODY, m_mediator.m_selfKey,
+                 AccountStore::GetInstance())) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::SetLookupSetStateFromSeed failed.");
     return false;
@@ -1244,23 +1426,88 @@ bool Lookup::ProcessGetTxBlockFromSeed(const bytes& message,
                                                       << lowBlockNum << " to "
                                                       << highBlockNum);
 
+  bytes txBlockMessage;
+  if (!ComposeSetTxBlockFromSeedMessage(lowBlockNum, highBlockNum,
+                                        txBlockMessage)) {
+    return false;
+  }
+
+  Peer requestingNode(from.m_ipAddress, portNo);
+  P2PComm::GetInstance().SendMessage(requestingNode, txBlockMessage);
+  LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
+            "Sent Txblks " << lowBlockNum << " - " << highBlockNum);
+  return true;
+}
+
+bool Lookup::ComposeSetTxBlockFromSeedMessage(uint64_t& lowBlockNum,
+                                              uint64_t& highBlockNum,
+                                              bytes& txBlockMessage) {
+  // resolve the implicit bounds up front (the same way RetrieveTxBlocks
+  // would) so identical rejoin requests map onto the same cache key
+  {
+    lock_guard<mutex> g(m_mediator.m_node->m_mutexFinalBlock);
+
+    if (lowBlockNum == 0) {
+      lowBlockNum = 1;
+    }
+    const uint64_t lowestLimitNum =
+        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetEpochNum();
+    if (lowBlockNum < lowestLimitNum) {
+      lowBlockNum = lowestLimitNum;
+    }
+    if (highBlockNum == 0) {
+      highBlockNum =
+          m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    }
+  }
+
+  const auto range = make_pair(lowBlockNum, highBlockNum);
+  {
+    lock_guard<mutex> g(m_txBlockResponseCacheMutex);
+    auto found = m_txBlockResponseCache.find(range);
+    if (found != m_txBlockResponseCache.end()) {
+      m_txBlockResponseCacheOrder.splice(m_txBlockResponseCacheOrder.begin(),
+                                         m_txBlockResponseCacheOrder,
+                                         found->second.second);
+      txBlockMessage = found->second.first;
+      return true;
+    }
+  }
+
   vector<TxBlock> txBlocks;
-  RetrieveTxBlocks(txBlocks, lowBlockNum, highBlockNum);
+  uint64_t servedLowBlockNum = lowBlockNum;
+  uint64_t servedHighBlockNum = highBlockNum;
+  RetrieveTxBlocks(txBlocks, servedLowBlockNum, servedHighBlockNum);
 
-  bytes txBlockMessage = {MessageType::LOOKUP,
-                          LookupInstructionType::SETTXBLOCKFROMSEED};
+  txBlockMessage = {MessageType::LOOKUP,
+                    LookupInstructionType::SETTXBLOCKFROMSEED};
   if (!Messenger::SetLookupSetTxBlockFromSeed(
-          txBlockMessage, MessageOffset::BODY, lowBlockNum, highBlockNum,
-          m_mediator.m_selfKey, txBlocks)) {
+          txBlockMessage, MessageOffset::BODY, servedLowBlockNum,
+          servedHighBlockNum, m_mediator.m_selfKey, txBlocks)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::SetLookupSetTxBlockFromSeed failed.");
     return false;
   }
 
-  Peer requestingNode(from.m_ipAddress, portNo);
-  P2PComm::GetInstance().SendMessage(requestingNode, txBlockMessage);
-  LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "Sent Txblks " << lowBlockNum << " - " << highBlockNum);
+  // only cache responses covering the full resolved range; a truncated
+  // response (missing blocks) would otherwise get pinned
+  if (!txBlocks.empty() && servedLowBlockNum == lowBlockNum &&
+      servedHighBlockNum == highBlockNum) {
+    lock_guard<mutex> g(m_txBlockResponseCacheMutex);
+    if (m_txBlockResponseCache.find(range) == m_txBlockResponseCache.end()) {
+      m_txBlockResponseCacheOrder.emplace_front(range);
+      m_txBlockResponseCache.emplace(
+          range,
+          make_pair(txBlockMessage, m_txBlockResponseCacheOrder.begin()));
+      if (m_txBlockResponseCache.size() > TXBLOCK_RESPONSE_CACHE_MAX_ENTRIES) {
+        m_txBlockResponseCache.erase(m_txBlockResponseCacheOrder.back());
+        m_txBlockResponseCacheOrder.pop_back();
+      }
+    }
+  }
+
+  lowBlockNum = servedLowBlockNum;
+  highBlockNum = servedHighBlockNum;
   return true;
 }
 
@@ -1298,33 +1545,15 @@ void Lookup::RetrieveTxBlocks(vector<TxBlock>& txBlocks, uint64_t& lowBlockNum,
     return;
   }
 
-  uint64_t blockNum;
-  for (blockNum = lowBlockNum; blockNum <= highBlockNum; blockNum++) {
-    try {
-      TxBlock txblk = m_mediator.m_txBlockChain.GetBlock(blockNum);
-      // TODO
-      // Workaround to identify dummy block as == comparator does not work on
-      // empty object for TxBlock and TxBlockheader().
-      if (txblk.GetHeader().GetBlockNum() == INIT_BLOCK_NUMBER &&
-          txblk.GetHeader().GetDSBlockNum() == INIT_BLOCK_NUMBER) {
-        LOG_GENERAL(WARNING,
-                    "Block Number " << blockNum << " does not exists.");
-        break;
-      }
-      txBlocks.emplace_back(txblk);
-    } catch (const char* e) {
-      LOG_GENERAL(INFO, "Block Number " << blockNum
-                                        << " absent. Didn't include it in "
-                                           "response message. Reason: "
-                                        << e);
-      break;
-    }
-  }
+  const uint64_t lastServedBlockNum = m_mediator.m_txBlockChain.GetBlockRange(
+      lowBlockNum, highBlockNum, txBlocks);
 
   // if serialization got interrupted in between, reset the highBlockNum value
   // in msg
-  if (blockNum != highBlockNum + 1) {
-    highBlockNum = blockNum - 1;
+  if (lastServedBlockNum != highBlockNum) {
+    LOG_GENERAL(WARNING, "Block Number " << lastServedBlockNum + 1
+                                         << " does not exists.");
+    highBlockNum = lastServedBlockNum;
   }
 }
 
@@ -1509,9 +1738,13 @@ bool Lookup::ProcessSetShardFromSeed([[gnu::unused]] const bytes& message,
     LOG_GENERAL(INFO, "Size of shard " << i << " " << shard.size());
     i++;
   }
-  lock_guard<mutex> g(m_mediator.m_ds->m_mutexShards);
+  {
+    lock_guard<mutex> g(m_mediator.m_ds->m_mutexShards);
+    m_mediator.m_ds->m_shards = move(shards);
+  }
 
-  m_mediator.m_ds->m_shards = move(shards);
+  // submission routing reads the shard count from the epoch context
+  m_mediator.RefreshEpochContext();
 
   cv_shardStruct.notify_all();
 
@@ -1601,26 +1834,45 @@ bool Lookup::ProcessGetMicroBlockFromLookup(
   }
 
   Peer requestingNode(ipAddr, portNo);
-  vector<MicroBlock> retMicroBlocks;
 
-  for (const auto& mbhash : microBlockHashes) {
-    LOG_GENERAL(INFO, "[SendMB]"
-                          << "Request for microBlockHash " << mbhash);
-    shared_ptr<MicroBlock> mbptr;
-    int retryCount = MAX_FETCH_BLOCK_RETRIES;
-
-    while (retryCount-- > 0) {
-      if (!BlockStorage::GetBlockStorage().GetMicroBlock(mbhash, mbptr)) {
-        LOG_GENERAL(WARNING,
-                    "Failed to fetch micro block Hash, retry... " << mbhash);
-        this_thread::sleep_for(chrono::seconds(1));
-        continue;
-      } else {
-        LOG_GENERAL(
-            INFO, "Request for microBlockHash " << mbhash << " successfully.");
-        retMicroBlocks.push_back(*mbptr);
-        break;
+  // Fetch on a worker pool so the disk reads and deserialization overlap;
+  // each hash lands in its own slot, preserving the requested order
+  vector<shared_ptr<MicroBlock>> fetchedMicroBlocks(microBlockHashes.size());
+  const unsigned int NUMTHREADS = min<unsigned int>(
+      microBlockHashes.size(), max(1u, thread::hardware_concurrency()));
+  ThreadPool fetchPool(NUMTHREADS, "MBFetchPool");
+
+  for (unsigned int i = 0; i < microBlockHashes.size(); i++) {
+    fetchPool.AddJob([&microBlockHashes, &fetchedMicroBlocks, i]() {
+      const auto& mbhash = microBlockHashes.at(i);
+      LOG_GENERAL(INFO, "[SendMB]"
+                            << "Request for microBlockHash " << mbhash);
+      int retryCount = MAX_FETCH_BLOCK_RETRIES;
+
+      while (retryCount-- > 0) {
+        if (!BlockStorage::GetBlockStorage().GetMicroBlock(
+                mbhash, fetchedMicroBlocks.at(i))) {
+          LOG_GENERAL(WARNING,
+                      "Failed to fetch micro block Hash, retry... " << mbhash);
+          this_thread::sleep_for(chrono::seconds(1));
+          continue;
+        } else {
+          LOG_GENERAL(INFO, "Request for microBlockHash " << mbhash
+                                                          << " successfully.");
+          break;
+        }
       }
+    });
+  }
+
+  while (fetchPool.GetJobsLeft() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+
+  vector<MicroBlock> retMicroBlocks;
+  for (const auto& mbptr : fetchedMicroBlocks) {
+    if (mbptr != nullptr) {
+      retMicroBlocks.push_back(*mbptr);
     }
   }
 
@@ -1967,8 +2219,7 @@ bool Lookup::ProcessSetDSInfoFromSeed(const bytes& message, unsigned int offset,
 }
 
 bool Lookup::ProcessSetDSBlockFromSeed(const bytes& message,
-                                       unsigned int offset,
-                                       [[gnu::unused]] const Peer& from) {
+                                       unsigned int offset, const Peer& from) {
   // #ifndef IS_LOOKUP_NODE TODO: uncomment later
 
   LOG_MARKER();
@@ -1996,6 +2247,8 @@ bool Lookup::ProcessSetDSBlockFromSeed(const bytes& message,
     return false;
   }
 
+  RecordSeedResponse(from);
+
   uint64_t latestSynBlockNum =
       m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
 
@@ -2141,6 +2394,8 @@ bool Lookup::ProcessSetTxBlockFromSeed(const bytes& message,
                                                  << lowBlockNum << " to "
                                                  << highBlockNum);
 
+  RecordSeedResponse(from);
+
   // Update GetWork Server info for new nodes not in shards
   if (GETWORK_SERVER_MINE) {
     // roughly calc how many seconds to next PoW
@@ -2170,9 +2425,23 @@ bool Lookup::ProcessSetTxBlockFromSeed(const bytes& message,
     return false;
   }
 
+  if (highBlockNum > m_seedTxBlockTip) {
+    m_seedTxBlockTip = highBlockNum;
+  }
+
   uint64_t latestSynBlockNum =
       m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
 
+  if (lowBlockNum > latestSynBlockNum) {
+    // a window ahead of the chain tip arrived before its predecessors;
+    // buffer it until the gap gets filled
+    LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
+              "Buffering out-of-order blocks " << lowBlockNum << " - "
+                                               << highBlockNum);
+    m_pendingTxBlockRanges[lowBlockNum] = txBlocks;
+    return true;
+  }
+
   if (latestSynBlockNum > highBlockNum) {
     // TODO: We should get blocks from n nodes.
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
@@ -2194,6 +2463,7 @@ bool Lookup::ProcessSetTxBlockFromSeed(const bytes& message,
         }
 #endif  // SJ_TEST_SJ_TXNBLKS_PROCESS_SLOW
         CommitTxBlocks(txBlocks);
+        CommitPendingTxBlockRanges();
         break;
       case Validator::TxBlockValidationMsg::INVALID:
         LOG_GENERAL(INFO, "[TxBlockVerif]"
@@ -2281,7 +2551,12 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
   uint64_t lowBlockNum = txBlocks.front().GetHeader().GetBlockNum();
   uint64_t highBlockNum = txBlocks.back().GetHeader().GetBlockNum();
   bool placeholder = false;
-  if (m_syncType != SyncType::RECOVERY_ALL_SYNC) {
+  if (SYNC_HEADERS_ONLY) {
+    // header-only followers trust the verified cosignatures and never
+    // materialize state, so there are no deltas to fetch or roots to check
+    LOG_GENERAL(INFO, "Header-only sync, skipping state deltas for txBlks: "
+                          << lowBlockNum << "-" << highBlockNum);
+  } else if (m_syncType != SyncType::RECOVERY_ALL_SYNC) {
     unsigned int retry = 1;
     while (retry <= RETRY_GETSTATEDELTAS_COUNT) {
       // Get the state-delta for all txBlocks from random lookup nodes
@@ -2351,10 +2626,11 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
       m_mediator.m_ds->m_totalTxnFees += rewards;
     }
 
-    if ((LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP &&
-         m_syncType == SyncType::NEW_LOOKUP_SYNC) ||
-        (LOOKUP_NODE_MODE && !ARCHIVAL_LOOKUP &&
-         m_syncType == SyncType::LOOKUP_SYNC)) {
+    if (!SYNC_HEADERS_ONLY &&
+        ((LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP &&
+          m_syncType == SyncType::NEW_LOOKUP_SYNC) ||
+         (LOOKUP_NODE_MODE && !ARCHIVAL_LOOKUP &&
+          m_syncType == SyncType::LOOKUP_SYNC))) {
       m_mediator.m_node->LoadUnavailableMicroBlockHashes(
           txBlock, placeholder, true /*skip shardid check*/);
     }
@@ -2371,10 +2647,11 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
   // To trigger m_isVacuousEpoch calculation
   m_mediator.IncreaseEpochNum();
 
-  if ((LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP &&
-       m_syncType == SyncType::NEW_LOOKUP_SYNC) ||
-      (LOOKUP_NODE_MODE && !ARCHIVAL_LOOKUP &&
-       m_syncType == SyncType::LOOKUP_SYNC)) {
+  if (!SYNC_HEADERS_ONLY &&
+      ((LOOKUP_NODE_MODE && ARCHIVAL_LOOKUP &&
+        m_syncType == SyncType::NEW_LOOKUP_SYNC) ||
+       (LOOKUP_NODE_MODE && !ARCHIVAL_LOOKUP &&
+        m_syncType == SyncType::LOOKUP_SYNC))) {
     m_mediator.m_node->CommitMBnForwardedTransactionBuffer();
     m_mediator.m_node->CommitPendingTxnBuffer();
     // Additional safe-guard mechanism, if have not received the MBNdFWDTXNS at
@@ -2484,6 +2761,53 @@ void Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
   cv_waitJoined.notify_all();
 }
 
+void Lookup::CommitPendingTxBlockRanges() {
+  while (!m_pendingTxBlockRanges.empty()) {
+    const uint64_t next =
+        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+
+    auto found = m_pendingTxBlockRanges.end();
+    for (auto it = m_pendingTxBlockRanges.begin();
+         it != m_pendingTxBlockRanges.end();) {
+      const uint64_t low = it->first;
+      const uint64_t high = low + it->second.size() - 1;
+      if (high < next) {
+        // range fell entirely behind the chain tip
+        it = m_pendingTxBlockRanges.erase(it);
+      } else if (low <= next) {
+        found = it;
+        break;
+      } else {
+        // map is ordered, so the gap before this range is still unfilled
+        break;
+      }
+    }
+
+    if (found == m_pendingTxBlockRanges.end()) {
+      return;
+    }
+
+    vector<TxBlock> txBlocks(found->second.begin() + (next - found->first),
+                             found->second.end());
+    m_pendingTxBlockRanges.erase(found);
+
+    LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
+              "Committing buffered blocks "
+                  << txBlocks.front().GetHeader().GetBlockNum() << " - "
+                  << txBlocks.back().GetHeader().GetBlockNum());
+
+    if (m_mediator.m_validator->CheckTxBlocks(
+            txBlocks, m_mediator.m_blocklinkchain.GetBuiltDSComm(),
+            m_mediator.m_blocklinkchain.GetLatestBlockLink()) !=
+        Validator::TxBlockValidationMsg::VALID) {
+      LOG_GENERAL(WARNING, "Buffered block range failed validation, dropped");
+      return;
+    }
+
+    CommitTxBlocks(txBlocks);
+  }
+}
+
 void Lookup::FindMissingMBsForLastNTxBlks(const uint32_t& num) {
   LOG_MARKER();
   uint64_t upperLimit =
@@ -2504,11 +2828,7 @@ void Lookup::FindMissingMBsForLastNTxBlks(const uint32_t& num) {
           info.m_txnRootHash != TxnHash()) {
         lock_guard<mutex> g(m_mediator.m_node->m_mutexUnavailableMicroBlocks);
         auto& mbs = m_mediator.m_node->GetUnavailableMicroBlocks()[i];
-        if (std::find_if(mbs.begin(), mbs.end(),
-                         [info](const std::pair<BlockHash, TxnHash>& e) {
-                           return e.first == info.m_microBlockHash;
-                         }) == mbs.end()) {
-          mbs.push_back({info.m_microBlockHash, info.m_txnRootHash});
+        if (mbs.emplace(info.m_microBlockHash, info.m_txnRootHash).second) {
           LOG_GENERAL(INFO,
                       "[TxBlk:" << i << "] Add unavailable block [MbBlockHash] "
                                 << info.m_microBlockHash << " [TxnRootHash] "
@@ -2558,6 +2878,8 @@ bool Lookup::ProcessSetStateDeltaFromSeed(const bytes& message,
             "ProcessSetStateDeltaFromSeed sent by " << from << " for block "
                                                     << blockNum);
 
+  RecordSeedResponse(from);
+
   if (!m_skipAddStateDeltaToAccountStore &&
       !AccountStore::GetInstance().DeserializeDelta(stateDelta, 0)) {
     LOG_GENERAL(WARNING, "AccountStore::GetInstance().DeserializeDelta failed");
@@ -2611,6 +2933,8 @@ bool Lookup::ProcessSetStateDeltasFromSeed(const bytes& message,
                 << from << " for blocks: " << lowBlockNum << " to "
                 << highBlockNum);
 
+  RecordSeedResponse(from);
+
   if (stateDeltas.size() != (highBlockNum - lowBlockNum + 1)) {
     LOG_GENERAL(WARNING,
                 "StateDeltas recvd:" << stateDeltas.size() << " , Expected: "
@@ -2654,18 +2978,21 @@ bool Lookup::ProcessSetStateDeltasFromSeed(const bytes& message,
 }
 
 bool Lookup::ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
-                                     [[gnu::unused]] const Peer& from) {
+                                     const Peer& from) {
   LOG_MARKER();
 
   if (AlreadyJoinedNetwork()) {
+    lock_guard<mutex> g(m_mutexSetState);
+    m_stateSyncCursor.clear();
     return true;
   }
 
   unique_lock<mutex> lock(m_mutexSetState);
   PubKey lookupPubKey;
   bytes accountStoreBytes;
+  bytes nextCursor;
   if (!Messenger::GetLookupSetStateFromSeed(message, offset, lookupPubKey,
-                                            accountStoreBytes)) {
+                                            accountStoreBytes, nextCursor)) {
     LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
               "Messenger::GetLookupSetStateFromSeed failed.");
     return false;
@@ -2678,11 +3005,28 @@ bool Lookup::ProcessSetStateFromSeed(const bytes& message, unsigned int offset,
     return false;
   }
 
-  if (!AccountStore::GetInstance().Deserialize(accountStoreBytes, 0)) {
+  RecordSeedResponse(from);
+
+  // The first chunk (or a legacy single-shot response) starts from a clean
+  // store; later chunks are applied on top of it
+  if (!AccountStore::GetInstance().DeserializeChunk(
+          accountStoreBytes, m_stateSyncCursor.empty())) {
     LOG_GENERAL(WARNING, "Deserialize AccountStore Failed");
+    m_stateSyncCursor.clear();
     return false;
   }
 
+  if (!nextCursor.empty()) {
+    // More chunks to come: remember where this one ended and request the
+    // next slice before running any of the post-sync logic
+    m_stateSyncCursor = nextCursor;
+    lock.unlock();
+    GetStateFromSeedNodes();
+    return true;
+  }
+
+  m_stateSyncCursor.clear();
+
   if (!LOOKUP_NODE_MODE) {
     if (m_syncType == SyncType::NEW_SYNC ||
         m_syncType == SyncType::NORMAL_SYNC) {
@@ -2938,6 +3282,14 @@ bool Lookup::ProcessSetTxnsFromLookup([[gnu::unused]] const bytes& message,
               "Received " << txns.size() << " txns for microblock :" << mbHash);
 
   for (const auto& txn : txns) {
+    bytes serializedTxnReceipt;
+    txn.GetTransactionReceipt().Serialize(serializedTxnReceipt, 0);
+    if (!BlockStorage::GetBlockStorage().PutTxnReceipt(
+            txn.GetTransaction().GetTranID(), serializedTxnReceipt)) {
+      LOG_GENERAL(WARNING, "BlockStorage::PutTxnReceipt failed "
+                               << txn.GetTransaction().GetTranID());
+    }
+
     bytes serializedTxBody;
     txn.Serialize(serializedTxBody, 0);
 
@@ -2955,14 +3307,7 @@ bool Lookup::ProcessSetTxnsFromLookup([[gnu::unused]] const bytes& message,
   auto& unavailableMBs = m_mediator.m_node->GetUnavailableMicroBlocks();
   for (auto it = unavailableMBs.begin(); it != unavailableMBs.end();) {
     auto& mbsVec = it->second;
-    auto origSiz = mbsVec.size();
-    mbsVec.erase(
-        std::remove_if(mbsVec.begin(), mbsVec.end(),
-                       [mbHash](const std::pair<BlockHash, TxnHash>& e) {
-                         return e.first == mbHash;
-                       }),
-        mbsVec.end());
-    if (mbsVec.size() < origSiz) {
+    if (mbsVec.erase(mbHash) > 0) {
       LOG_GENERAL(
           INFO, "[TxBlk - "
                     << it->first
@@ -3138,7 +3483,7 @@ bool Lookup::ProcessSetLookupOffline(const bytes& message, unsigned int offset,
   Peer requestingNode(ipAddr, portNo);
 
   {
-    lock_guard<mutex> lock(m_mutexLookupNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     auto iter = std::find_if(
         m_lookupNodes.begin(), m_lookupNodes.end(),
         [&lookuppubkey, &requestingNode](const PairOfNode& node) {
@@ -3187,7 +3532,7 @@ bool Lookup::ProcessSetLookupOnline(const bytes& message, unsigned int offset,
   Peer requestingNode(ipAddr, portNo);
 
   {
-    lock_guard<mutex> lock(m_mutexLookupNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     auto iter = std::find_if(
         m_lookupNodesOffline.cbegin(), m_lookupNodesOffline.cend(),
         [&lookupPubKey, &requestingNode](const PairOfNode& node) {
@@ -3230,7 +3575,7 @@ bool Lookup::ProcessGetOfflineLookups(const bytes& message, unsigned int offset,
                                  LookupInstructionType::SETOFFLINELOOKUPS};
 
   {
-    lock_guard<mutex> lock(m_mutexLookupNodes);
+    lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     VectorOfPeer lookupNodesOffline;
     for (const auto& pairPubKeyPeer : m_lookupNodesOffline)
       lookupNodesOffline.push_back(pairPubKeyPeer.second);
@@ -3287,7 +3632,7 @@ bool Lookup::ProcessSetOfflineLookups(const bytes& message, unsigned int offset,
 
   unsigned int i = 0;
   for (const auto& peer : nodes) {
-    std::lock_guard<std::mutex> lock(m_mutexLookupNodes);
+    std::lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     // Remove selfPeerInfo from m_lookupNodes
     auto iter = std::find_if(
         m_lookupNodes.begin(), m_lookupNodes.end(),
@@ -3639,7 +3984,7 @@ bool Lookup::GetMyLookupOffline() {
   LOG_MARKER();
 
   {
-    std::lock_guard<std::mutex> lock(m_mutexLookupNodes);
+    std::lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     // Remove selfPeerInfo from m_lookupNodes
     auto selfPeer(m_mediator.m_selfPeer);
     auto selfpubkey(m_mediator.m_selfKey.second);
@@ -3673,7 +4018,7 @@ bool Lookup::GetMyLookupOnline(bool fromRecovery) {
   bool found = false;
 
   if (!fromRecovery) {
-    std::lock_guard<std::mutex> lock(m_mutexLookupNodes);
+    std::lock_guard<ProfiledMutex> lock(m_mutexLookupNodes);
     auto selfPeer(m_mediator.m_selfPeer);
     auto selfPubkey(m_mediator.m_selfKey.second);
     auto iter = std::find_if(
@@ -3823,8 +4168,9 @@ bool Lookup::CleanVariables() {
     std::lock_guard<mutex> lock(m_mediator.m_ds->m_mutexShards);
     m_mediator.m_ds->m_shards.clear();
   }
+  m_mediator.RefreshEpochContext();
   {
-    std::lock_guard<mutex> lock(m_mutexNodesInNetwork);
+    std::lock_guard<ProfiledMutex> lock(m_mutexNodesInNetwork);
     m_nodesInNetwork.clear();
     l_nodesInNetwork.clear();
   }
@@ -4214,7 +4560,8 @@ bool Lookup::Execute(const bytes& message, unsigned int offset,
   typedef bool (Lookup::*InstructionHandler)(const bytes&, unsigned int,
                                              const Peer&);
 
-  InstructionHandler ins_handlers[] = {
+  // Built once; the table is ordered by LookupInstructionType
+  static const InstructionHandler ins_handlers[] = {
       &Lookup::ProcessGetDSInfoFromSeed,
       &Lookup::ProcessSetDSInfoFromSeed,
       &Lookup::ProcessGetDSBlockFromSeed,
@@ -4280,7 +4627,7 @@ bool Lookup::AlreadyJoinedNetwork() { return m_syncType == SyncType::NO_SYNC; }
 void Lookup::RemoveSeedNodesFromBlackList() {
   LOG_MARKER();
 
-  lock_guard<mutex> lock(m_mutexSeedNodes);
+  lock_guard<ProfiledMutex> lock(m_mutexSeedNodes);
 
   for (const auto& node : m_seedNodes) {
     auto seedNodeIp = TryGettingResolvedIP(node.second);
@@ -4290,8 +4637,8 @@ void Lookup::RemoveSeedNodesFromBlackList() {
 
 bool Lookup::AddToTxnShardMap(const Transaction& tx, uint32_t shardId,
                               TxnShardMap& txnShardMap,
-                              mutex& txnShardMapMutex) {
-  lock_guard<mutex> g(txnShardMapMutex);
+                              ProfiledMutex& txnShardMapMutex) {
+  lock_guard<ProfiledMutex> g(txnShardMapMutex);
 
   uint32_t size = 0;
 
@@ -4329,7 +4676,23 @@ bool Lookup::AddToTxnShardMap(const Transaction& tx, uint32_t shardId) {
     return true;
   }
 
-  return AddToTxnShardMap(tx, shardId, m_txnShardMap, m_txnShardMapMutex);
+  if (!AddToTxnShardMap(tx, shardId, m_txnShardMap, m_txnShardMapMutex)) {
+    return false;
+  }
+
+  if (ENABLE_TXN_POOL_JOURNAL) {
+    // Journal before the caller acknowledges the txn, so a restart replays
+    // it instead of losing it; the write is an idempotent point insert
+    bytes entry;
+    Serializable::SetNumber<uint32_t>(entry, 0, shardId, sizeof(uint32_t));
+    if (!tx.Serialize(entry, sizeof(uint32_t)) ||
+        !BlockStorage::GetBlockStorage().PutTxnPoolJournalEntry(tx.GetTranID(),
+                                                                entry)) {
+      LOG_GENERAL(WARNING, "Failed to journal txn " << tx.GetTranID());
+    }
+  }
+
+  return true;
 }
 
 bool Lookup::DeleteTxnShardMap(uint32_t shardId) {
@@ -4340,13 +4703,101 @@ bool Lookup::DeleteTxnShardMap(uint32_t shardId) {
     return true;
   }
 
-  lock_guard<mutex> g(m_txnShardMapMutex);
+  lock_guard<ProfiledMutex> g(m_txnShardMapMutex);
+
+  if (ENABLE_TXN_POOL_JOURNAL && !m_txnShardMap[shardId].empty()) {
+    std::vector<dev::h256> hashes;
+    hashes.reserve(m_txnShardMap[shardId].size());
+    for (const auto& tx : m_txnShardMap[shardId]) {
+      hashes.emplace_back(tx.GetTranID());
+    }
+    if (!BlockStorage::GetBlockStorage().DeleteTxnPoolJournalEntries(hashes)) {
+      LOG_GENERAL(WARNING, "Failed to truncate txn-pool journal for shard "
+                               << shardId);
+    }
+  }
 
   m_txnShardMap[shardId].clear();
 
   return true;
 }
 
+void Lookup::ReplayTxnPoolJournal() {
+  if (!LOOKUP_NODE_MODE || !ENABLE_TXN_POOL_JOURNAL) {
+    return;
+  }
+
+  LOG_MARKER();
+
+  std::vector<bytes> entries;
+  if (!BlockStorage::GetBlockStorage().GetTxnPoolJournal(entries) ||
+      entries.empty()) {
+    return;
+  }
+
+  unsigned int replayed = 0;
+  for (const auto& entry : entries) {
+    if (entry.size() <= sizeof(uint32_t)) {
+      continue;
+    }
+    const uint32_t shardId =
+        Serializable::GetNumber<uint32_t>(entry, 0, sizeof(uint32_t));
+    Transaction tx;
+    if (!tx.Deserialize(entry, sizeof(uint32_t))) {
+      LOG_GENERAL(WARNING, "Failed to deserialize a journaled txn, skipping");
+      continue;
+    }
+    // Re-adding also re-journals the txn - a harmless overwrite of the
+    // entry being replayed. The recorded shard id may be stale if the shard
+    // count changed while the node was down; RectifyTxnShardMap reshuffles
+    // the pool on the next shard change as it does for live txns
+    if (AddToTxnShardMap(tx, shardId)) {
+      ++replayed;
+    }
+  }
+
+  LOG_GENERAL(INFO, "Replayed " << replayed << " of " << entries.size()
+                                << " journaled txns into the pool");
+}
+
+void Lookup::UpdateShardTxnBacklog(uint32_t shardId, const uint64_t& epochNum,
+                                   uint32_t poolSize) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Lookup::UpdateShardTxnBacklog not expected to be called from "
+                "other than the LookUp node.");
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutexShardTxnBacklog);
+
+  auto& entry = m_shardTxnBacklog[shardId];
+  if (epochNum >= entry.first) {
+    entry = {epochNum, poolSize};
+  }
+}
+
+size_t Lookup::GetTxnCreditForShard(uint32_t shardId) {
+  if (TXN_PACKET_BACKLOG_TARGET == 0) {
+    return numeric_limits<size_t>::max();
+  }
+
+  lock_guard<mutex> g(m_mutexShardTxnBacklog);
+
+  const auto it = m_shardTxnBacklog.find(shardId);
+  // a shard that stopped reporting has either drained its pool or changed
+  // leader, so a stale report must not throttle it forever
+  if (it == m_shardTxnBacklog.end() ||
+      it->second.first + 2 < m_mediator.m_currentEpochNum) {
+    return numeric_limits<size_t>::max();
+  }
+
+  const uint32_t reported = it->second.second;
+  return reported >= TXN_PACKET_BACKLOG_TARGET
+             ? 0
+             : TXN_PACKET_BACKLOG_TARGET - reported;
+}
+
 void Lookup::SenderTxnBatchThread(const uint32_t oldNumShards) {
   if (!LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
@@ -4385,7 +4836,7 @@ void Lookup::RectifyTxnShardMap(const uint32_t oldNumShards,
 
   map<uint, vector<Transaction>> tempTxnShardMap;
 
-  lock_guard<mutex> g(m_txnShardMapMutex);
+  lock_guard<ProfiledMutex> g(m_txnShardMapMutex);
 
   LOG_GENERAL(INFO, "Shard dropped or gained, shuffling txn shard map");
   LOG_GENERAL(INFO, "New Shard Size: " << newNumShards
@@ -4461,37 +4912,100 @@ void Lookup::SendTxnPacketToNodes(const uint32_t oldNumShards,
   this_thread::sleep_for(
       chrono::milliseconds(LOOKUP_DELAY_SEND_TXNPACKET_IN_MS));
 
+  // Move every shard's queue out under one short lock - ingestion keeps
+  // appending to the emptied vectors while the packets are built and sent,
+  // so CreateTransaction never waits on the dispatch. The packets are then
+  // built in parallel: serializing and signing them is the expensive part
+  // of the dispatch and needs no ordering between shards. Anything not
+  // dispatched (backlog credit, failed packet, empty shard) goes back to
+  // the head of its queue at the end
+  vector<vector<Transaction>> shardTxns(numShards + 1);
+  vector<vector<Transaction>> heldBack(numShards + 1);
+  {
+    lock_guard<ProfiledMutex> g(m_txnShardMapMutex);
+    for (unsigned int i = 0; i < numShards + 1; i++) {
+      shardTxns[i] = std::move(m_txnShardMap[i]);
+      m_txnShardMap[i].clear();
+    }
+  }
+
   for (unsigned int i = 0; i < numShards + 1; i++) {
-    bytes msg = {MessageType::NODE, NodeInstructionType::FORWARDTXNPACKET};
-    bool result = false;
+    const size_t credit = GetTxnCreditForShard(i);
+    if (shardTxns[i].size() > credit) {
+      LOG_GENERAL(INFO, "Shard " << i << " backlogged, sending " << credit
+                                 << " of " << shardTxns[i].size() << " txns");
+      heldBack[i].assign(make_move_iterator(shardTxns[i].begin() + credit),
+                         make_move_iterator(shardTxns[i].end()));
+      shardTxns[i].resize(credit);
+    }
+  }
 
-    {
-      lock_guard<mutex> g(m_txnShardMapMutex);
-      auto transactionNumber = mp[i].size();
+  // moves shard i's undispatched packet content back in front of whatever
+  // it already holds back
+  auto requeueShard = [&shardTxns, &heldBack](unsigned int i) {
+    shardTxns[i].insert(shardTxns[i].end(),
+                        make_move_iterator(heldBack[i].begin()),
+                        make_move_iterator(heldBack[i].end()));
+    heldBack[i] = std::move(shardTxns[i]);
+    shardTxns[i].clear();
+  };
 
-      LOG_GENERAL(INFO, "Txn number generated: " << transactionNumber);
+  const uint64_t dsBlockNum =
+      m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
 
-      if (LOG_PARAMETERS) {
-        LOG_STATE("[TXNPKT][" << m_mediator.m_currentEpochNum << "] Shard=" << i
-                              << " NumTx="
-                              << (GetTxnFromShardMap(i).size() + mp[i].size()));
-      }
+  vector<bytes> msgs(numShards + 1);
+  vector<char> results(numShards + 1, false);
 
-      if (GetTxnFromShardMap(i).empty() && mp[i].empty()) {
-        LOG_GENERAL(INFO, "No txns to send to shard " << i);
-        continue;
-      }
+  const unsigned int NUMTHREADS = min<unsigned int>(
+      numShards + 1, max(1u, thread::hardware_concurrency()));
+  ThreadPool packetPool(NUMTHREADS, "TxnPacketPool");
+
+  // materialize every mp slot up front so the parallel jobs only ever read
+  for (unsigned int i = 0; i < numShards + 1; i++) {
+    (void)mp[i];
+  }
+
+  for (unsigned int i = 0; i < numShards + 1; i++) {
+    if (shardTxns[i].empty() && mp[i].empty()) {
+      continue;
+    }
+
+    auto buildPacket = [this, i, dsBlockNum, &shardTxns, &mp, &msgs,
+                        &results]() -> void {
+      msgs[i] = {MessageType::NODE, NodeInstructionType::FORWARDTXNPACKET};
+      results[i] = Messenger::SetNodeForwardTxnBlock(
+          msgs[i], MessageOffset::BODY, m_mediator.m_currentEpochNum,
+          dsBlockNum, i, m_mediator.m_selfKey, shardTxns[i], mp[i]);
+    };
+    packetPool.AddJob(buildPacket);
+  }
+
+  while (packetPool.GetJobsLeft() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  for (unsigned int i = 0; i < numShards + 1; i++) {
+    LOG_GENERAL(INFO, "Txn number generated: " << mp[i].size());
+
+    if (LOG_PARAMETERS) {
+      LOG_STATE("[TXNPKT][" << m_mediator.m_currentEpochNum << "] Shard=" << i
+                            << " NumTx="
+                            << (shardTxns[i].size() + mp[i].size()));
+    }
 
-      result = Messenger::SetNodeForwardTxnBlock(
-          msg, MessageOffset::BODY, m_mediator.m_currentEpochNum,
-          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(), i,
-          m_mediator.m_selfKey, GetTxnFromShardMap(i), mp[i]);
+    if (shardTxns[i].empty() && mp[i].empty()) {
+      LOG_GENERAL(INFO, "No txns to send to shard " << i);
+      continue;
     }
 
+    bytes& msg = msgs[i];
+    const bool result = results[i];
+
     if (!result) {
       LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
                 "Messenger::SetNodeForwardTxnBlock failed.");
       LOG_GENERAL(WARNING, "Cannot create packet for " << i << " shard");
+      requeueShard(i);
       continue;
     }
     vector<Peer> toSend;
@@ -4521,19 +5035,19 @@ void Lookup::SendTxnPacketToNodes(const uint32_t oldNumShards,
           }
         }
         if (m_mediator.m_ds->m_shards.at(i).empty()) {
+          requeueShard(i);
           continue;
         }
       }
 
       P2PComm::GetInstance().SendBroadcastMessage(toSend, msg);
-
-      DeleteTxnShardMap(i);
     } else if (i == numShards) {
       // To send DS
       {
         lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
 
         if (m_mediator.m_DSCommittee->empty()) {
+          requeueShard(i);
           continue;
         }
 
@@ -4561,8 +5075,37 @@ void Lookup::SendTxnPacketToNodes(const uint32_t oldNumShards,
 
       LOG_GENERAL(INFO, "[DSMB]"
                             << " Sent DS the txns");
+    }
+  }
 
-      DeleteTxnShardMap(i);
+  // return everything undispatched to the head of its queue, in front of
+  // what ingestion appended meanwhile
+  {
+    lock_guard<ProfiledMutex> g(m_txnShardMapMutex);
+    for (unsigned int i = 0; i < numShards + 1; i++) {
+      if (heldBack[i].empty()) {
+        continue;
+      }
+      auto& queue = m_txnShardMap[i];
+      heldBack[i].insert(heldBack[i].end(), make_move_iterator(queue.begin()),
+                         make_move_iterator(queue.end()));
+      queue = std::move(heldBack[i]);
+    }
+  }
+
+  if (ENABLE_TXN_POOL_JOURNAL) {
+    // shardTxns now only holds the txns that actually went out - the
+    // requeued shards were moved back into the map above - so their journal
+    // entries can be dropped. Held-back txns keep theirs until dispatched
+    std::vector<dev::h256> dispatched;
+    for (unsigned int i = 0; i < numShards + 1; i++) {
+      for (const auto& tx : shardTxns[i]) {
+        dispatched.emplace_back(tx.GetTranID());
+      }
+    }
+    if (!BlockStorage::GetBlockStorage().DeleteTxnPoolJournalEntries(
+            dispatched)) {
+      LOG_GENERAL(WARNING, "Failed to truncate txn-pool journal");
     }
   }
 }
@@ -4906,11 +5449,13 @@ void Lookup::CheckAndFetchUnavailableMBs(bool skipLatestTxBlk) {
 
       // Delete missing mbs from unavailable list which has no txns
       auto& mbs = m.second;
-      mbs.erase(std::remove_if(mbs.begin(), mbs.end(),
-                               [](const std::pair<BlockHash, TxnHash>& e) {
-                                 return e.second == TxnHash();
-                               }),
-                mbs.end());
+      for (auto mbIt = mbs.begin(); mbIt != mbs.end();) {
+        if (mbIt->second == TxnHash()) {
+          mbIt = mbs.erase(mbIt);
+        } else {
+          ++mbIt;
+        }
+      }
 
       LOG_GENERAL(INFO,
                   "After deleting microblock bodies with no transactions, "
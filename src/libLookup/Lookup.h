@@ -22,6 +22,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdlib>
+#include <list>
 #include <map>
 #include <mutex>
 #include <unordered_set>
@@ -37,6 +38,7 @@
 #include "libNetwork/Peer.h"
 #include "libNetwork/ShardStruct.h"
 #include "libUtils/IPConverter.h"
+#include "libUtils/LockProfiler.h"
 #include "libUtils/Logger.h"
 
 #include <condition_variable>
@@ -67,10 +69,32 @@ class Lookup : public Executable {
   VectorOfNode m_lookupNodesOffline;
   VectorOfNode m_seedNodes;
   VectorOfNode m_multipliers;
-  std::mutex mutable m_mutexSeedNodes;
+  ProfiledMutex mutable m_mutexSeedNodes{"Lookup::m_mutexSeedNodes"};
   bool m_dsInfoWaitingNotifying = false;
   bool m_fetchedDSInfo = false;
 
+  // Response latency scores for seed nodes, keyed by resolved IP: an EWMA of
+  // the request-to-response time in ms, persisted in BlockStorage so restarts
+  // keep the ranking. Guarded by m_mutexSeedScores
+  mutable std::map<uint128_t, double> m_seedScores;
+  mutable std::map<uint128_t, std::chrono::steady_clock::time_point>
+      m_seedRequestTimes;
+  mutable std::mutex m_mutexSeedScores;
+  mutable bool m_seedScoresLoaded = false;
+  mutable unsigned int m_seedScoreUpdates = 0;
+
+  /// Loads the persisted seed scores on first use; caller must hold
+  /// m_mutexSeedScores
+  void LoadSeedScores() const;
+
+  /// Writes the seed scores to BlockStorage; caller must hold
+  /// m_mutexSeedScores
+  void PersistSeedScores() const;
+
+  /// Picks a seed from candidates, favouring the lowest latency EWMA with
+  /// periodic uniform exploration, and records the request time for the pick
+  const Peer& PickSeedNodeForRequest(const VectorOfPeer& candidates) const;
+
   // m_lookupNodes can change during operation if some lookups go offline.
   // m_lookupNodesStatic is the fixed copy of m_lookupNodes after loading from
   // constants.xml.
@@ -90,7 +114,7 @@ class Lookup : public Executable {
 
   // Sharding committee members
 
-  std::mutex m_mutexNodesInNetwork;
+  ProfiledMutex m_mutexNodesInNetwork{"Lookup::m_mutexNodesInNetwork"};
   VectorOfPeer m_nodesInNetwork;
   std::unordered_set<Peer> l_nodesInNetwork;
 
@@ -123,12 +147,28 @@ class Lookup : public Executable {
   std::mutex m_mutexSetTxBlockFromSeed;
   std::mutex m_mutexSetTxBodyFromSeed;
   std::mutex m_mutexSetState;
-  std::mutex mutable m_mutexLookupNodes;
+  // Cursor of an in-flight chunked GETSTATEFROMSEED transfer: the last
+  // address applied so far, empty when no transfer is in progress (guarded
+  // by m_mutexSetState). Address-based, so a resumed transfer can be served
+  // by any seed
+  bytes m_stateSyncCursor;
+  ProfiledMutex mutable m_mutexLookupNodes{"Lookup::m_mutexLookupNodes"};
   std::mutex m_mutexCheckDirBlocks;
   std::mutex m_mutexMicroBlocksBuffer;
 
   TxnShardMap m_txnShardMap;
 
+  // Latest txn pool occupancy reported by each shard (and the DS committee)
+  // through PENDINGTXN, as {report epoch, pool size}; used to size the next
+  // txn packet to what the shard can absorb
+  std::map<uint32_t, std::pair<uint64_t, uint32_t>> m_shardTxnBacklog;
+  std::mutex m_mutexShardTxnBacklog;
+
+  /// How many more txns the shard can take before hitting
+  /// TXN_PACKET_BACKLOG_TARGET, based on its last fresh report; unlimited
+  /// when scaling is disabled or no fresh report exists
+  size_t GetTxnCreditForShard(uint32_t shardId);
+
   // Get StateDeltas from seed
   std::mutex m_mutexSetStateDeltasFromSeed;
   std::condition_variable cv_setStateDeltasFromSeed;
@@ -136,6 +176,27 @@ class Lookup : public Executable {
   // TxBlockBuffer
   std::vector<TxBlock> m_txBlockBuffer;
 
+  // Tx block ranges that arrived ahead of the chain tip from parallel window
+  // fetches, keyed by their low block number; guarded by
+  // m_mutexSetTxBlockFromSeed
+  std::map<uint64_t, std::vector<TxBlock>> m_pendingTxBlockRanges;
+
+  // Highest tx block number any seed reported in a response; used to size the
+  // parallel fetch windows on the next sync round
+  std::atomic<uint64_t> m_seedTxBlockTip{0};
+
+  // Serve-side cache of serialized SETTXBLOCKFROMSEED responses, keyed by
+  // the resolved block range: rejoin storms request identical ranges, and a
+  // finalized range never changes so entries need no invalidation - requests
+  // resolving to a newer tip simply use a new key while old entries age out
+  // of the LRU. Bounded by LRU eviction
+  static const unsigned int TXBLOCK_RESPONSE_CACHE_MAX_ENTRIES = 32;
+  std::mutex m_txBlockResponseCacheMutex;
+  std::list<std::pair<uint64_t, uint64_t>> m_txBlockResponseCacheOrder;
+  std::map<std::pair<uint64_t, uint64_t>,
+           std::pair<bytes, std::list<std::pair<uint64_t, uint64_t>>::iterator>>
+      m_txBlockResponseCache;
+
   std::shared_ptr<LookupServer> m_lookupServer;
   std::shared_ptr<StakingServer> m_stakingServer;
 
@@ -159,6 +220,13 @@ class Lookup : public Executable {
   void RetrieveTxBlocks(std::vector<TxBlock>& txBlocks, uint64_t& lowBlockNum,
                         uint64_t& highBlockNum);
 
+  /// Builds (or serves from the response cache) the serialized
+  /// SETTXBLOCKFROMSEED message for the requested range; lowBlockNum and
+  /// highBlockNum are updated to the range actually served
+  bool ComposeSetTxBlockFromSeedMessage(uint64_t& lowBlockNum,
+                                        uint64_t& highBlockNum,
+                                        bytes& txBlockMessage);
+
  public:
   /// Constructor.
   Lookup(Mediator& mediator, SyncType syncType);
@@ -186,7 +254,7 @@ class Lookup : public Executable {
   // Getter for m_seedNodes
   VectorOfNode GetSeedNodes() const;
 
-  std::mutex m_txnShardMapMutex;
+  ProfiledMutex m_txnShardMapMutex{"Lookup::m_txnShardMapMutex"};
 
   const std::vector<Transaction>& GetTxnFromShardMap(
       uint32_t index);  // Use m_txnShardMapMutex with this function
@@ -224,6 +292,14 @@ class Lookup : public Executable {
 
   void SendMessageToRandomSeedNode(const bytes& message) const;
 
+  /// Folds the response latency of a seed into its score; called by the
+  /// ProcessSet*FromSeed handlers when a reply arrives
+  void RecordSeedResponse(const Peer& from) const;
+
+  /// Sends each message to a different non-blacklisted seed peer, starting
+  /// from a random one
+  void SendMessagesToSeedNodes(const std::vector<bytes>& messages) const;
+
   void RectifyTxnShardMap(const uint32_t, const uint32_t);
 
   // TODO: move the Get and ProcessSet functions to Synchronizer
@@ -276,12 +352,21 @@ class Lookup : public Executable {
   bool AddToTxnShardMap(const Transaction& tx, uint32_t shardId);
   static bool AddToTxnShardMap(const Transaction& tx, uint32_t shardId,
                                TxnShardMap& txnShardMap,
-                               std::mutex& txnShardMapMutex);
+                               ProfiledMutex& txnShardMapMutex);
 
   void CheckBufferTxBlocks();
 
   bool DeleteTxnShardMap(uint32_t shardId);
 
+  /// Re-adds journaled txns that were pooled but not yet dispatched when the
+  /// node last stopped; called once at startup before the API server accepts
+  /// new txns
+  void ReplayTxnPoolJournal();
+
+  /// Records the txn pool occupancy a shard reported through PENDINGTXN
+  void UpdateShardTxnBacklog(uint32_t shardId, const uint64_t& epochNum,
+                             uint32_t poolSize);
+
   void SetServerTrue();
 
   bool GetIsServer();
@@ -338,6 +423,9 @@ class Lookup : public Executable {
   bool ProcessSetTxBlockFromSeed(const bytes& message, unsigned int offset,
                                  const Peer& from);
   void CommitTxBlocks(const std::vector<TxBlock>& txBlocks);
+  /// Commits the buffered out-of-order ranges that became contiguous with
+  /// the chain tip; call with m_mutexSetTxBlockFromSeed held
+  void CommitPendingTxBlockRanges();
   void PrepareForStartPow();
   bool GetDSInfo();
   bool ProcessSetStateDeltaFromSeed(const bytes& message, unsigned int offset,
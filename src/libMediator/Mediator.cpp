@@ -48,7 +48,8 @@ Mediator::Mediator(const PairOfKey& key, const Peer& peer)
       m_isRetrievedHistory(false),
       m_isVacuousEpoch(false),
       m_curSWInfo(),
-      m_disablePoW(false) {
+      m_disablePoW(false),
+      m_epochContext(make_shared<EpochContext>()) {
   SetupLogLevel();
 }
 
@@ -81,6 +82,9 @@ void Mediator::UpdateDSBlockRand(bool isGenesis) {
     randVec = sha2.Finalize();
     copy(randVec.begin(), randVec.end(), m_dsBlockRand.begin());
   }
+
+  // a new DS tip was stored (or restored) before this call
+  RefreshEpochContext();
 }
 
 void Mediator::UpdateTxBlockRand(bool isGenesis) {
@@ -101,6 +105,35 @@ void Mediator::UpdateTxBlockRand(bool isGenesis) {
     randVec = sha2.Finalize();
     copy(randVec.begin(), randVec.end(), m_txBlockRand.begin());
   }
+
+  // a new Tx tip was stored (or restored) before this call
+  RefreshEpochContext();
+}
+
+std::shared_ptr<const EpochContext> Mediator::GetEpochContext() const {
+  return atomic_load(&m_epochContext);
+}
+
+void Mediator::RefreshEpochContext() {
+  auto context = make_shared<EpochContext>();
+
+  const TxBlock lastTxBlock = m_txBlockChain.GetLastBlock();
+  const DSBlock lastDSBlock = m_dsBlockChain.GetLastBlock();
+
+  context->currentEpochNum = m_currentEpochNum;
+  context->lastTxBlockNum = lastTxBlock.GetHeader().GetBlockNum();
+  context->lastDSBlockNum = lastDSBlock.GetHeader().GetBlockNum();
+  context->lastTxBlockHash = lastTxBlock.GetBlockHash();
+  context->lastDSBlockHash = lastDSBlock.GetBlockHash();
+  context->gasPrice = lastDSBlock.GetHeader().GetGasPrice();
+
+  if (m_ds != nullptr) {
+    lock_guard<mutex> g(m_ds->m_mutexShards);
+    context->numShards = m_ds->m_shards.size();
+  }
+
+  atomic_store(&m_epochContext,
+               shared_ptr<const EpochContext>(std::move(context)));
 }
 
 std::string Mediator::GetNodeMode(const Peer& peer) {
@@ -149,6 +182,8 @@ void Mediator::IncreaseEpochNum() {
     GetWorkServer::GetInstance().SetNextPoWTime(now + wait_seconds);
   }
 
+  RefreshEpochContext();
+
   LOG_GENERAL(INFO, "Epoch number is now " << m_currentEpochNum);
 
   LOG_STATE("Epoch = " << m_currentEpochNum);
@@ -182,8 +217,9 @@ bool Mediator::CheckWhetherBlockIsLatest(const uint64_t& dsblockNum,
                                          const uint64_t& epochNum) {
   LOG_MARKER();
 
-  uint64_t latestDSBlockNumInBlockchain =
-      m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+  // validators call this on every incoming block; read the tip from the
+  // epoch-context snapshot instead of locking the DS chain
+  uint64_t latestDSBlockNumInBlockchain = GetEpochContext()->lastDSBlockNum;
 
   if (dsblockNum < (latestDSBlockNumInBlockchain + 1)) {
     LOG_EPOCH(WARNING, m_currentEpochNum,
@@ -30,6 +30,22 @@
 #include "libNode/Node.h"
 #include "libValidator/Validator.h"
 
+/// Immutable snapshot of the hottest chain-tip facts. Rebuilt once per block
+/// boundary and swapped atomically, so per-request readers (RPC fee checks,
+/// block validators) get a consistent view without taking the blockchain
+/// locks or copying headers.
+struct EpochContext {
+  uint64_t currentEpochNum = 0;
+  uint64_t lastTxBlockNum = 0;
+  uint64_t lastDSBlockNum = 0;
+  BlockHash lastTxBlockHash;
+  BlockHash lastDSBlockHash;
+  uint128_t gasPrice;
+  /// shard count for submission routing, so CreateTransaction does not
+  /// copy the whole shard structure under its lock per txn
+  unsigned int numShards = 0;
+};
+
 /// A mediator class for providing access to global members.
 class Mediator {
  public:
@@ -100,6 +116,10 @@ class Mediator {
   /// Prevent transactions from being created, forwarded, and dispatched
   static std::atomic<bool> m_disableTxns;
 
+  /// Current epoch-context snapshot; read through GetEpochContext and
+  /// replaced wholesale by RefreshEpochContext
+  std::shared_ptr<const EpochContext> m_epochContext;
+
   /// Constructor.
   Mediator(const PairOfKey& key, const Peer& peer);
 
@@ -120,6 +140,13 @@ class Mediator {
 
   void IncreaseEpochNum();
 
+  /// Returns the current epoch-context snapshot (never null)
+  std::shared_ptr<const EpochContext> GetEpochContext() const;
+
+  /// Rebuilds the epoch-context snapshot from the chain tips; called at
+  /// block boundaries after the new block is stored
+  void RefreshEpochContext();
+
   bool GetIsVacuousEpoch();
 
   bool GetIsVacuousEpoch(const uint64_t& epochNum);
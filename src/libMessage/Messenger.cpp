@@ -23,10 +23,13 @@
 #include "libMessage/ZilliqaMessage.pb.h"
 #include "libUtils/Logger.h"
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <random>
 #include <unordered_set>
 
@@ -779,13 +782,56 @@ bool ProtobufToAccountDelta(const ProtoAccount& protoAccount, Account& account,
 
 void DSCommitteeToProtobuf(const uint32_t version,
                            const DequeOfNode& dsCommittee,
-                           ProtoDSCommittee& protoDSCommittee) {
+                           ProtoDSCommittee& protoDSCommittee,
+                           bytes* serialized = nullptr) {
+  // Memoize the encoded committee: the same committee is re-encoded for
+  // every DSInfo request and diagnostic dump until the next DS block, and
+  // every member costs an EC point serialization through PubKey::Serialize.
+  // On a hit the cached protobuf is reused via CopyFrom, which is plain
+  // byte copying without touching OpenSSL. The serialized wire blob is
+  // cached alongside it for callers that sign or splice the committee
+  // bytes, so those do not pay a fresh SerializeToArray per message.
+  static mutex encodeCacheMutex;
+  static uint32_t encodeCacheVersion = 0;
+  static DequeOfNode encodeCacheCommittee;
+  static ProtoDSCommittee encodeCacheResult;
+  static bytes encodeCacheSerialized;
+  static bool encodeCacheValid = false;
+
+  {
+    lock_guard<mutex> g(encodeCacheMutex);
+    if (encodeCacheValid && encodeCacheVersion == version &&
+        encodeCacheCommittee == dsCommittee) {
+      protoDSCommittee.CopyFrom(encodeCacheResult);
+      if (serialized != nullptr) {
+        *serialized = encodeCacheSerialized;
+      }
+      return;
+    }
+  }
+
   protoDSCommittee.set_version(version);
   for (const auto& node : dsCommittee) {
     ProtoDSNode* protodsnode = protoDSCommittee.add_dsnodes();
     SerializableToProtobufByteArray(node.first, *protodsnode->mutable_pubkey());
     SerializableToProtobufByteArray(node.second, *protodsnode->mutable_peer());
   }
+
+  bytes encoded;
+  if (!SerializeToArray(protoDSCommittee, encoded, 0)) {
+    LOG_GENERAL(WARNING, "Failed to serialize DS committee for the cache");
+    return;
+  }
+  if (serialized != nullptr) {
+    *serialized = encoded;
+  }
+
+  lock_guard<mutex> g(encodeCacheMutex);
+  encodeCacheVersion = version;
+  encodeCacheCommittee = dsCommittee;
+  encodeCacheResult.CopyFrom(protoDSCommittee);
+  encodeCacheSerialized = std::move(encoded);
+  encodeCacheValid = true;
 }
 
 bool ProtobufToDSCommittee(const ProtoDSCommittee& protoDSCommittee,
@@ -1213,9 +1259,15 @@ bool ProtobufToTransaction(const ProtoTransaction& protoTransaction,
     return false;
   }
 
+  if (!CheckRequiredFieldsProtoTransactionCoreInfo(protoTransaction.info())) {
+    LOG_GENERAL(WARNING, "CheckRequiredFieldsProtoTransactionCoreInfo failed");
+    return false;
+  }
+
   TxnHash tranID;
   TransactionCoreInfo txnCoreInfo;
   Signature signature;
+  PubKey senderPubKey;
 
   copy(protoTransaction.tranid().begin(),
        protoTransaction.tranid().begin() +
@@ -1223,13 +1275,8 @@ bool ProtobufToTransaction(const ProtoTransaction& protoTransaction,
                (unsigned int)tranID.size),
        tranID.asArray().begin());
 
-  if (!ProtobufToTransactionCoreInfo(protoTransaction.info(), txnCoreInfo)) {
-    LOG_GENERAL(WARNING, "ProtobufToTransactionCoreInfo failed");
-    return false;
-  }
-
-  PROTOBUFBYTEARRAYTOSERIALIZABLE(protoTransaction.signature(), signature);
-
+  // Validate against the protobuf-backed view first, so rejected transactions
+  // never pay for materializing the code/data byte copies
   bytes txnData;
   if (!SerializeToArray(protoTransaction.info(), txnData, 0)) {
     LOG_GENERAL(WARNING, "Serialize protoTransaction core info failed");
@@ -1248,12 +1295,22 @@ bool ProtobufToTransaction(const ProtoTransaction& protoTransaction,
     return false;
   }
 
+  PROTOBUFBYTEARRAYTOSERIALIZABLE(protoTransaction.signature(), signature);
+  PROTOBUFBYTEARRAYTOSERIALIZABLE(protoTransaction.info().senderpubkey(),
+                                  senderPubKey);
+
   // Verify signature
-  if (!Schnorr::Verify(txnData, signature, txnCoreInfo.senderPubKey)) {
+  if (!Schnorr::Verify(txnData, signature, senderPubKey)) {
     LOG_GENERAL(WARNING, "Signature verification failed");
     return false;
   }
 
+  // Only accepted transactions get the heavyweight conversion
+  if (!ProtobufToTransactionCoreInfo(protoTransaction.info(), txnCoreInfo)) {
+    LOG_GENERAL(WARNING, "ProtobufToTransactionCoreInfo failed");
+    return false;
+  }
+
   transaction = Transaction(
       tranID, txnCoreInfo.version, txnCoreInfo.nonce, txnCoreInfo.toAddr,
       txnCoreInfo.senderPubKey, txnCoreInfo.amount, txnCoreInfo.gasPrice,
@@ -1293,7 +1350,7 @@ bool ProtobufToTransactionArray(
       LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
       return false;
     }
-    txns.push_back(txn);
+    txns.push_back(std::move(txn));
   }
 
   return true;
@@ -2138,74 +2195,29 @@ bool SetConsensusAnnouncementCore(
 
   // Sign the announcement
 
-  bytes inputToSigning;
+  const google::protobuf::Message* content = nullptr;
+  const char* contentName = nullptr;
 
   switch (announcement.announcement_case()) {
     case ConsensusAnnouncement::AnnouncementCase::kDsblock:
-      if (!announcement.dsblock().IsInitialized()) {
-        LOG_GENERAL(WARNING, "Announcement dsblock content not initialized");
-        return false;
-      }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.dsblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.dsblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.dsblock().ByteSize());
+      content = &announcement.dsblock();
+      contentName = "dsblock";
       break;
     case ConsensusAnnouncement::AnnouncementCase::kMicroblock:
-      if (!announcement.microblock().IsInitialized()) {
-        LOG_GENERAL(WARNING, "Announcement microblock content not initialized");
-        return false;
-      }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.microblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.microblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.microblock().ByteSize());
+      content = &announcement.microblock();
+      contentName = "microblock";
       break;
     case ConsensusAnnouncement::AnnouncementCase::kFinalblock:
-      if (!announcement.finalblock().IsInitialized()) {
-        LOG_GENERAL(WARNING, "Announcement finalblock content not initialized");
-        return false;
-      }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.finalblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.finalblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.finalblock().ByteSize());
+      content = &announcement.finalblock();
+      contentName = "finalblock";
       break;
     case ConsensusAnnouncement::AnnouncementCase::kVcblock:
-      if (!announcement.vcblock().IsInitialized()) {
-        LOG_GENERAL(WARNING, "Announcement vcblock content not initialized");
-        return false;
-      }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.vcblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.vcblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.vcblock().ByteSize());
+      content = &announcement.vcblock();
+      contentName = "vcblock";
       break;
     case ConsensusAnnouncement::AnnouncementCase::kFallbackblock:
-      if (!announcement.fallbackblock().IsInitialized()) {
-        LOG_GENERAL(WARNING,
-                    "Announcement fallbackblock content not initialized");
-        return false;
-      }
-      inputToSigning.resize(announcement.consensusinfo().ByteSize() +
-                            announcement.fallbackblock().ByteSize());
-      announcement.consensusinfo().SerializeToArray(
-          inputToSigning.data(), announcement.consensusinfo().ByteSize());
-      announcement.fallbackblock().SerializeToArray(
-          inputToSigning.data() + announcement.consensusinfo().ByteSize(),
-          announcement.fallbackblock().ByteSize());
+      content = &announcement.fallbackblock();
+      contentName = "fallbackblock";
       break;
     case ConsensusAnnouncement::AnnouncementCase::ANNOUNCEMENT_NOT_SET:
     default:
@@ -2213,6 +2225,19 @@ bool SetConsensusAnnouncementCore(
       return false;
   }
 
+  if (!content->IsInitialized()) {
+    LOG_GENERAL(WARNING,
+                "Announcement " << contentName << " content not initialized");
+    return false;
+  }
+
+  // The consensusinfo header was already serialized into tmp above; reuse
+  // those bytes instead of encoding the header a second time
+  bytes inputToSigning(tmp.size() + content->ByteSize());
+  copy(tmp.begin(), tmp.end(), inputToSigning.begin());
+  content->SerializeToArray(inputToSigning.data() + tmp.size(),
+                            content->ByteSize());
+
   Signature finalsignature;
   if (!Schnorr::Sign(inputToSigning, leaderKey.first, leaderKey.second,
                      finalsignature)) {
@@ -2226,10 +2251,80 @@ bool SetConsensusAnnouncementCore(
   return announcement.IsInitialized();
 }
 
+// Recovers the exact wire bytes the leader signed - the consensusinfo
+// sub-message followed by the announcement content sub-message - by scanning
+// the received buffer, so the signature is verified over what actually
+// arrived instead of a re-serialization of the parsed object.
+bool ExtractAnnouncementSignedPayload(const bytes& src,
+                                      const unsigned int offset,
+                                      bytes& signedPayload) {
+  google::protobuf::io::CodedInputStream input(src.data() + offset,
+                                               src.size() - offset);
+  const unsigned char* base = src.data() + offset;
+
+  int consensusInfoPos = -1;
+  uint32_t consensusInfoSize = 0;
+  int contentPos = -1;
+  uint32_t contentSize = 0;
+
+  while (true) {
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      break;
+    }
+
+    // Every ConsensusAnnouncement field is length-delimited
+    if ((tag & 7) != 2) {
+      LOG_GENERAL(WARNING, "Unexpected wire type in announcement");
+      return false;
+    }
+
+    uint32_t size = 0;
+    if (!input.ReadVarint32(&size)) {
+      return false;
+    }
+    const int pos = input.CurrentPosition();
+    if (!input.Skip(size)) {
+      return false;
+    }
+
+    switch (tag >> 3) {
+      case ConsensusAnnouncement::kConsensusinfoFieldNumber:
+        consensusInfoPos = pos;
+        consensusInfoSize = size;
+        break;
+      case ConsensusAnnouncement::kDsblockFieldNumber:
+      case ConsensusAnnouncement::kMicroblockFieldNumber:
+      case ConsensusAnnouncement::kFinalblockFieldNumber:
+      case ConsensusAnnouncement::kVcblockFieldNumber:
+      case ConsensusAnnouncement::kFallbackblockFieldNumber:
+        contentPos = pos;
+        contentSize = size;
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (consensusInfoPos < 0 || contentPos < 0) {
+    LOG_GENERAL(WARNING, "Announcement content not set");
+    return false;
+  }
+
+  signedPayload.resize(consensusInfoSize + contentSize);
+  copy(base + consensusInfoPos, base + consensusInfoPos + consensusInfoSize,
+       signedPayload.begin());
+  copy(base + contentPos, base + contentPos + contentSize,
+       signedPayload.begin() + consensusInfoSize);
+
+  return true;
+}
+
 bool GetConsensusAnnouncementCore(
     const ZilliqaMessage::ConsensusAnnouncement& announcement,
-    const uint32_t consensusID, const uint64_t blockNumber,
-    const bytes& blockHash, const uint16_t leaderID, const PubKey& leaderKey) {
+    const bytes& src, const unsigned int offset, const uint32_t consensusID,
+    const uint64_t blockNumber, const bytes& blockHash, const uint16_t leaderID,
+    const PubKey& leaderKey) {
   LOG_MARKER();
 
   // Check the consensus parameters
@@ -2281,55 +2376,18 @@ bool GetConsensusAnnouncementCore(
     return false;
   }
 
-  // Verify the signature
+  // Verify the signature over the exact bytes received on the wire, rather
+  // than paying for a full re-serialization of the parsed announcement
+  if (announcement.announcement_case() ==
+      ConsensusAnnouncement::AnnouncementCase::ANNOUNCEMENT_NOT_SET) {
+    LOG_GENERAL(WARNING, "Announcement content not set");
+    return false;
+  }
+
   bytes tmp;
 
-  if (announcement.has_dsblock() && announcement.dsblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.dsblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.dsblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.dsblock().ByteSize());
-  } else if (announcement.has_microblock() &&
-             announcement.microblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.microblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.microblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.microblock().ByteSize());
-  } else if (announcement.has_finalblock() &&
-             announcement.finalblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.finalblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.finalblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.finalblock().ByteSize());
-  } else if (announcement.has_vcblock() &&
-             announcement.vcblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.vcblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.vcblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.vcblock().ByteSize());
-  } else if (announcement.has_fallbackblock() &&
-             announcement.fallbackblock().IsInitialized()) {
-    tmp.resize(announcement.consensusinfo().ByteSize() +
-               announcement.fallbackblock().ByteSize());
-    announcement.consensusinfo().SerializeToArray(
-        tmp.data(), announcement.consensusinfo().ByteSize());
-    announcement.fallbackblock().SerializeToArray(
-        tmp.data() + announcement.consensusinfo().ByteSize(),
-        announcement.fallbackblock().ByteSize());
-  } else {
-    LOG_GENERAL(WARNING, "Announcement content not set");
+  if (!ExtractAnnouncementSignedPayload(src, offset, tmp)) {
+    LOG_GENERAL(WARNING, "Failed to recover announcement wire bytes");
     return false;
   }
 
@@ -2353,6 +2411,23 @@ bool GetConsensusAnnouncementCore(
 
 bool Messenger::GetDSCommitteeHash(const DequeOfNode& dsCommittee,
                                    CommitteeHash& dst) {
+  // Memoize the result: the committee only changes at DS block time, yet
+  // its hash is recomputed for every microblock and final block header.
+  // An equality check over the committee is much cheaper than the protobuf
+  // serialization plus SHA256 it replaces.
+  static mutex hashCacheMutex;
+  static DequeOfNode hashCacheCommittee;
+  static CommitteeHash hashCacheResult;
+  static bool hashCacheValid = false;
+
+  {
+    lock_guard<mutex> g(hashCacheMutex);
+    if (hashCacheValid && hashCacheCommittee == dsCommittee) {
+      dst = hashCacheResult;
+      return true;
+    }
+  }
+
   ProtoCommittee protoCommittee;
 
   DSCommitteeToProtoCommittee(dsCommittee, protoCommittee);
@@ -2375,6 +2450,11 @@ bool Messenger::GetDSCommitteeHash(const DequeOfNode& dsCommittee,
 
   copy(tmp.begin(), tmp.end(), dst.asArray().begin());
 
+  lock_guard<mutex> g(hashCacheMutex);
+  hashCacheCommittee = dsCommittee;
+  hashCacheResult = dst;
+  hashCacheValid = true;
+
   return true;
 }
 
@@ -2407,6 +2487,25 @@ bool Messenger::GetShardHash(const Shard& shard, CommitteeHash& dst) {
 bool Messenger::GetShardingStructureHash(const uint32_t& version,
                                          const DequeOfShard& shards,
                                          ShardingHash& dst) {
+  // Memoize the result like GetDSCommitteeHash: the sharding structure is
+  // fixed for a DS epoch but its hash is requested at every block that
+  // embeds or validates it, and the equality walk is much cheaper than
+  // re-serializing every shard member
+  static mutex hashCacheMutex;
+  static uint32_t hashCacheVersion = 0;
+  static DequeOfShard hashCacheShards;
+  static ShardingHash hashCacheResult;
+  static bool hashCacheValid = false;
+
+  {
+    lock_guard<mutex> g(hashCacheMutex);
+    if (hashCacheValid && hashCacheVersion == version &&
+        hashCacheShards == shards) {
+      dst = hashCacheResult;
+      return true;
+    }
+  }
+
   ProtoShardingStructure protoShardingStructure;
 
   ShardingStructureToProtobuf(version, shards, protoShardingStructure);
@@ -2429,6 +2528,12 @@ bool Messenger::GetShardingStructureHash(const uint32_t& version,
 
   copy(tmp.begin(), tmp.end(), dst.asArray().begin());
 
+  lock_guard<mutex> g(hashCacheMutex);
+  hashCacheVersion = version;
+  hashCacheShards = shards;
+  hashCacheResult = dst;
+  hashCacheValid = true;
+
   return true;
 }
 
@@ -2532,6 +2637,8 @@ bool Messenger::SetAccountStore(bytes& dst, const unsigned int offset,
 
   LOG_GENERAL(INFO, "Accounts to serialize: " << addressToAccount.size());
 
+  result.mutable_entries()->Reserve(addressToAccount.size());
+
   for (const auto& entry : addressToAccount) {
     ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
     protoEntry->set_address(entry.first.data(), entry.first.size);
@@ -2560,7 +2667,11 @@ bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
     return false;
   }
 
-  ProtoAccountStore result;
+  // Arena-backed parse: the hundreds of thousands of per-entry allocations
+  // all come out of one region torn down in O(1) when the arena goes away.
+  google::protobuf::Arena arena;
+  ProtoAccountStore& result =
+      *google::protobuf::Arena::CreateMessage<ProtoAccountStore>(&arena);
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -2598,7 +2709,11 @@ bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
     return false;
   }
 
-  ProtoAccountStore result;
+  // Arena-backed parse: the hundreds of thousands of per-entry allocations
+  // all come out of one region torn down in O(1) when the arena goes away.
+  google::protobuf::Arena arena;
+  ProtoAccountStore& result =
+      *google::protobuf::Arena::CreateMessage<ProtoAccountStore>(&arena);
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -2628,14 +2743,103 @@ bool Messenger::GetAccountStore(const bytes& src, const unsigned int offset,
   return true;
 }
 
+bool Messenger::GetAccountStore(google::protobuf::io::ZeroCopyInputStream& src,
+                                AccountStore& accountStore) {
+  // Wire tag of ProtoAccountStore.entries (field 3, length-delimited).
+  const uint32_t ENTRIES_TAG = (3 << 3) | 2;
+
+  uint64_t entriesCount = 0;
+
+  while (true) {
+    // A fresh CodedInputStream per entry keeps us clear of the cumulative
+    // bytes limit; unread bytes are returned to the underlying stream when it
+    // is destroyed.
+    google::protobuf::io::CodedInputStream input(&src);
+
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      break;
+    }
+
+    if (tag != ENTRIES_TAG) {
+      LOG_GENERAL(WARNING, "Unexpected tag " << tag << " in account stream");
+      return false;
+    }
+
+    uint32_t entrySize = 0;
+    if (!input.ReadVarint32(&entrySize)) {
+      LOG_GENERAL(WARNING, "Failed to read entry size from account stream");
+      return false;
+    }
+
+    const auto limit = input.PushLimit(entrySize);
+    ProtoAccountStore::AddressAccount entry;
+    if (!entry.ParseFromCodedStream(&input) || !input.ConsumedEntireMessage()) {
+      LOG_GENERAL(WARNING, "AddressAccount parsing failed");
+      return false;
+    }
+    input.PopLimit(limit);
+
+    Address address;
+    Account account;
+
+    copy(entry.address().begin(),
+         entry.address().begin() + min((unsigned int)entry.address().size(),
+                                       (unsigned int)address.size),
+         address.asArray().begin());
+    if (!ProtobufToAccount(entry.account(), account, address)) {
+      LOG_GENERAL(WARNING, "ProtobufToAccount failed for account at address "
+                               << address.hex());
+      return false;
+    }
+
+    accountStore.AddAccountDuringDeserialization(address, account, Account());
+    entriesCount++;
+  }
+
+  LOG_GENERAL(INFO, "Accounts deserialized (streamed): " << entriesCount);
+
+  return true;
+}
+
+bool Messenger::SetAccountStoreChunk(
+    bytes& dst, const unsigned int offset,
+    const vector<pair<const Address*, const Account*>>& entries) {
+  ProtoAccountStore result;
+
+  result.mutable_entries()->Reserve(entries.size());
+
+  for (const auto& entry : entries) {
+    ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
+    protoEntry->set_address(entry.first->data(), entry.first->size);
+    ProtoAccount* protoEntryAccount = protoEntry->mutable_account();
+    AccountToProtobuf(*entry.second, *protoEntryAccount);
+    if (!protoEntryAccount->IsInitialized()) {
+      LOG_GENERAL(WARNING, "ProtoAccount initialization failed");
+      return false;
+    }
+  }
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "ProtoAccountStore initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, offset);
+}
+
 bool Messenger::SetAccountStoreDelta(bytes& dst, const unsigned int offset,
                                      AccountStoreTemp& accountStoreTemp,
                                      AccountStore& accountStore) {
-  ProtoAccountStore result;
+  google::protobuf::Arena arena;
+  ProtoAccountStore& result =
+      *google::protobuf::Arena::CreateMessage<ProtoAccountStore>(&arena);
 
   LOG_GENERAL(INFO, "Account deltas to serialize: "
                         << accountStoreTemp.GetNumOfAccounts());
 
+  result.mutable_entries()->Reserve(accountStoreTemp.GetNumOfAccounts());
+
   for (const auto& entry : *accountStoreTemp.GetAddressToAccount()) {
     ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
     protoEntry->set_address(entry.first.data(), entry.first.size);
@@ -2656,6 +2860,26 @@ bool Messenger::SetAccountStoreDelta(bytes& dst, const unsigned int offset,
   return SerializeToArray(result, dst, offset);
 }
 
+bool Messenger::SetAccountStoreDeltaEntry(bytes& dst, const Address& address,
+                                          Account* oldAccount,
+                                          const Account& newAccount) {
+  // A one-entry ProtoAccountStore serializes to exactly the wire fragment of
+  // that entry, so fragments produced here concatenate into the same bytes
+  // SetAccountStoreDelta would emit for the full map
+  ProtoAccountStore result;
+
+  ProtoAccountStore::AddressAccount* protoEntry = result.add_entries();
+  protoEntry->set_address(address.data(), address.size);
+  ProtoAccount* protoEntryAccount = protoEntry->mutable_account();
+  AccountDeltaToProtobuf(oldAccount, newAccount, *protoEntryAccount);
+  if (!protoEntryAccount->IsInitialized()) {
+    LOG_GENERAL(WARNING, "ProtoAccount initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, 0);
+}
+
 bool Messenger::StateDeltaToAddressMap(
     const bytes& src, const unsigned int offset,
     unordered_map<Address, int256_t>& accountMap) {
@@ -2702,6 +2926,7 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
                                      AccountStore& accountStore,
                                      const bool revertible, bool temp) {
   ProtoAccountStore result;
+
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -2712,6 +2937,23 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
   LOG_GENERAL(INFO,
               "Total Number of Accounts Delta: " << result.entries().size());
 
+  // The delta fixes the touched address set up front, so fault the accounts
+  // in from LevelDB in parallel before the serial apply below; the per-entry
+  // GetAccount calls then hit memory. The apply itself must stay serial and
+  // in entry order: contract deltas write shared contract storage whose
+  // ordering and revert bookkeeping have to be deterministic.
+  std::vector<Address> addresses;
+  addresses.reserve(result.entries().size());
+  for (const auto& entry : result.entries()) {
+    Address address;
+    copy(entry.address().begin(),
+         entry.address().begin() + min((unsigned int)entry.address().size(),
+                                       (unsigned int)address.size),
+         address.asArray().begin());
+    addresses.emplace_back(address);
+  }
+  accountStore.FaultInAccounts(addresses);
+
   for (const auto& entry : result.entries()) {
     Address address;
     Account account, t_account;
@@ -2745,8 +2987,16 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
       return false;
     }
 
+    // Trie updates are deferred to the batched pass below
     accountStore.AddAccountDuringDeserialization(address, account, t_account,
-                                                 fullCopy, revertible);
+                                                 fullCopy, revertible, false);
+  }
+
+  // One pass over the touched addresses: serialization fans out across
+  // threads and the trie lock is taken once, instead of per account
+  if (!accountStore.UpdateStateTrieBatch(addresses)) {
+    LOG_GENERAL(WARNING, "AccountStore::UpdateStateTrieBatch failed");
+    return false;
   }
 
   return true;
@@ -2757,6 +3007,7 @@ bool Messenger::GetAccountStoreDelta(const bytes& src,
                                      AccountStoreTemp& accountStoreTemp,
                                      bool temp) {
   ProtoAccountStore result;
+
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -3589,20 +3840,103 @@ bool Messenger::GetFallbackBlockWShardingStructure(
                                      shardingStructureVersion, shards);
 }
 
+// Fixed record width of a serialized Peer in the columnar diagnostic format
+const unsigned int DIAG_PEER_RECORD_SIZE = UINT128_SIZE + sizeof(uint32_t);
+
+bool DiagnosticColumnsToShard(
+    const ProtoDiagnosticNodesColumnar::NodeColumns& columns, Shard& shard) {
+  const size_t numNodes = columns.pubkeys().size() / PUB_KEY_SIZE;
+  if ((columns.pubkeys().size() != numNodes * PUB_KEY_SIZE) ||
+      (columns.peers().size() != numNodes * DIAG_PEER_RECORD_SIZE) ||
+      (static_cast<size_t>(columns.reputations_size()) != numNodes)) {
+    LOG_GENERAL(WARNING, "Malformed columnar diagnostic shard");
+    return false;
+  }
+
+  const bytes pubkeyBytes(columns.pubkeys().begin(), columns.pubkeys().end());
+  const bytes peerBytes(columns.peers().begin(), columns.peers().end());
+
+  for (size_t i = 0; i < numNodes; i++) {
+    PubKey key;
+    Peer peer;
+    if (!key.Deserialize(pubkeyBytes, i * PUB_KEY_SIZE) ||
+        (peer.Deserialize(peerBytes, i * DIAG_PEER_RECORD_SIZE) != 0)) {
+      LOG_GENERAL(WARNING, "Failed to decode columnar diagnostic member " << i);
+      return false;
+    }
+    shard.emplace_back(key, peer, columns.reputations(i));
+  }
+
+  return true;
+}
+
+bool DiagnosticColumnsToDSCommittee(
+    const ProtoDiagnosticNodesColumnar::NodeColumns& columns,
+    DequeOfNode& dsCommittee) {
+  const size_t numNodes = columns.pubkeys().size() / PUB_KEY_SIZE;
+  if ((columns.pubkeys().size() != numNodes * PUB_KEY_SIZE) ||
+      (columns.peers().size() != numNodes * DIAG_PEER_RECORD_SIZE)) {
+    LOG_GENERAL(WARNING, "Malformed columnar diagnostic DS committee");
+    return false;
+  }
+
+  const bytes pubkeyBytes(columns.pubkeys().begin(), columns.pubkeys().end());
+  const bytes peerBytes(columns.peers().begin(), columns.peers().end());
+
+  for (size_t i = 0; i < numNodes; i++) {
+    PubKey key;
+    Peer peer;
+    if (!key.Deserialize(pubkeyBytes, i * PUB_KEY_SIZE) ||
+        (peer.Deserialize(peerBytes, i * DIAG_PEER_RECORD_SIZE) != 0)) {
+      LOG_GENERAL(WARNING, "Failed to decode columnar diagnostic member " << i);
+      return false;
+    }
+    dsCommittee.emplace_back(key, peer);
+  }
+
+  return true;
+}
+
 bool Messenger::SetDiagnosticDataNodes(bytes& dst, const unsigned int offset,
                                        const uint32_t& shardingStructureVersion,
                                        const DequeOfShard& shards,
                                        const uint32_t& dsCommitteeVersion,
                                        const DequeOfNode& dsCommittee) {
-  ProtoDiagnosticDataNodes result;
+  ProtoDiagnosticNodesColumnar result;
 
-  ShardingStructureToProtobuf(shardingStructureVersion, shards,
-                              *result.mutable_shards());
-  DSCommitteeToProtobuf(dsCommitteeVersion, dsCommittee,
-                        *result.mutable_dscommittee());
+  result.set_shardingstructureversion(shardingStructureVersion);
+  result.set_dscommitteeversion(dsCommitteeVersion);
+
+  for (const auto& shard : shards) {
+    ProtoDiagnosticNodesColumnar::NodeColumns* columns = result.add_shards();
+    bytes pubkeys;
+    bytes peers;
+    pubkeys.reserve(shard.size() * PUB_KEY_SIZE);
+    peers.reserve(shard.size() * DIAG_PEER_RECORD_SIZE);
+    for (const auto& node : shard) {
+      std::get<SHARD_NODE_PUBKEY>(node).Serialize(pubkeys, pubkeys.size());
+      std::get<SHARD_NODE_PEER>(node).Serialize(peers, peers.size());
+      columns->add_reputations(std::get<SHARD_NODE_REP>(node));
+    }
+    columns->set_pubkeys(pubkeys.data(), pubkeys.size());
+    columns->set_peers(peers.data(), peers.size());
+  }
+
+  ProtoDiagnosticNodesColumnar::NodeColumns* columns =
+      result.mutable_dscommittee();
+  bytes pubkeys;
+  bytes peers;
+  pubkeys.reserve(dsCommittee.size() * PUB_KEY_SIZE);
+  peers.reserve(dsCommittee.size() * DIAG_PEER_RECORD_SIZE);
+  for (const auto& node : dsCommittee) {
+    node.first.Serialize(pubkeys, pubkeys.size());
+    node.second.Serialize(peers, peers.size());
+  }
+  columns->set_pubkeys(pubkeys.data(), pubkeys.size());
+  columns->set_peers(peers.data(), peers.size());
 
   if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoDiagnosticDataNodes initialization failed");
+    LOG_GENERAL(WARNING, "ProtoDiagnosticNodesColumnar initialization failed");
     return false;
   }
 
@@ -3615,29 +3949,48 @@ bool Messenger::GetDiagnosticDataNodes(const bytes& src,
                                        DequeOfShard& shards,
                                        uint32_t& dsCommitteeVersion,
                                        DequeOfNode& dsCommittee) {
-  ProtoDiagnosticDataNodes result;
-
   if (offset >= src.size()) {
     LOG_GENERAL(WARNING, "Invalid data and offset, data size "
                              << src.size() << ", offset " << offset);
     return false;
   }
 
+  ProtoDiagnosticNodesColumnar result;
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
-  if (!result.IsInitialized()) {
-    LOG_GENERAL(WARNING, "ProtoDiagnosticDataNodes initialization failed");
-    return false;
+  // Records written before the columnar format land here with every field
+  // empty (the legacy fields are skipped as wire-type mismatches); a real
+  // columnar record always carries the DS committee pubkeys
+  if ((result.shards_size() == 0) && result.dscommittee().pubkeys().empty()) {
+    ProtoDiagnosticDataNodes legacy;
+    legacy.ParseFromArray(src.data() + offset, src.size() - offset);
+
+    if (!legacy.IsInitialized()) {
+      LOG_GENERAL(WARNING, "ProtoDiagnosticDataNodes initialization failed");
+      return false;
+    }
+
+    if (!ProtobufToShardingStructure(legacy.shards(), shardingStructureVersion,
+                                     shards)) {
+      LOG_GENERAL(WARNING, "ProtobufToShardingStructure failed");
+      return false;
+    }
+
+    return ProtobufToDSCommittee(legacy.dscommittee(), dsCommitteeVersion,
+                                 dsCommittee);
   }
 
-  if (!ProtobufToShardingStructure(result.shards(), shardingStructureVersion,
-                                   shards)) {
-    LOG_GENERAL(WARNING, "ProtobufToShardingStructure failed");
-    return false;
+  shardingStructureVersion = result.shardingstructureversion();
+  dsCommitteeVersion = result.dscommitteeversion();
+
+  for (const auto& columns : result.shards()) {
+    shards.emplace_back();
+    if (!DiagnosticColumnsToShard(columns, shards.back())) {
+      return false;
+    }
   }
 
-  return ProtobufToDSCommittee(result.dscommittee(), dsCommitteeVersion,
-                               dsCommittee);
+  return DiagnosticColumnsToDSCommittee(result.dscommittee(), dsCommittee);
 }
 
 bool Messenger::SetDiagnosticDataCoinbase(bytes& dst, const unsigned int offset,
@@ -4166,8 +4519,9 @@ bool Messenger::GetDSDSBlockAnnouncement(
 
   // Check the common consensus announcement parameters
 
-  if (!GetConsensusAnnouncementCore(announcement, consensusID, blockNumber,
-                                    blockHash, leaderID, leaderKey)) {
+  if (!GetConsensusAnnouncementCore(announcement, src, offset, consensusID,
+                                    blockNumber, blockHash, leaderID,
+                                    leaderKey)) {
     LOG_GENERAL(WARNING, "GetConsensusAnnouncementCore failed");
     return false;
   }
@@ -4298,8 +4652,9 @@ bool Messenger::GetDSFinalBlockAnnouncement(
 
   // Check the common consensus announcement parameters
 
-  if (!GetConsensusAnnouncementCore(announcement, consensusID, blockNumber,
-                                    blockHash, leaderID, leaderKey)) {
+  if (!GetConsensusAnnouncementCore(announcement, src, offset, consensusID,
+                                    blockNumber, blockHash, leaderID,
+                                    leaderKey)) {
     LOG_GENERAL(WARNING, "GetConsensusAnnouncementCore failed");
     return false;
   }
@@ -4398,8 +4753,9 @@ bool Messenger::GetDSVCBlockAnnouncement(
 
   // Check the common consensus announcement parameters
 
-  if (!GetConsensusAnnouncementCore(announcement, consensusID, blockNumber,
-                                    blockHash, leaderID, leaderKey)) {
+  if (!GetConsensusAnnouncementCore(announcement, src, offset, consensusID,
+                                    blockNumber, blockHash, leaderID,
+                                    leaderKey)) {
     LOG_GENERAL(WARNING, "GetConsensusAnnouncementCore failed");
     return false;
   }
@@ -4554,7 +4910,9 @@ bool Messenger::SetNodeFinalBlock(bytes& dst, const unsigned int offset,
                                   const bytes& stateDelta) {
   LOG_MARKER();
 
-  NodeFinalBlock result;
+  google::protobuf::Arena arena;
+  NodeFinalBlock& result =
+      *google::protobuf::Arena::CreateMessage<NodeFinalBlock>(&arena);
 
   result.set_dsblocknumber(dsBlockNumber);
   result.set_consensusid(consensusID);
@@ -4581,7 +4939,9 @@ bool Messenger::GetNodeFinalBlock(const bytes& src, const unsigned int offset,
     return false;
   }
 
-  NodeFinalBlock result;
+  google::protobuf::Arena arena;
+  NodeFinalBlock& result =
+      *google::protobuf::Arena::CreateMessage<NodeFinalBlock>(&arena);
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -4612,6 +4972,8 @@ bool Messenger::SetNodeMBnForwardTransaction(
 
   unsigned int txnsCount = 0;
 
+  result.mutable_txnswithreceipt()->Reserve(txns.size());
+
   for (const auto& txn : txns) {
     SerializableToProtobufByteArray(txn, *result.add_txnswithreceipt());
     txnsCount++;
@@ -4632,7 +4994,7 @@ bool Messenger::SetNodeMBnForwardTransaction(
 bool Messenger::SetNodePendingTxn(
     bytes& dst, const unsigned offset, const uint64_t& epochnum,
     const unordered_map<TxnHash, PoolTxnStatus>& hashCodeMap,
-    const uint32_t shardId, const PairOfKey& key) {
+    const uint32_t shardId, const uint32_t poolSize, const PairOfKey& key) {
   LOG_MARKER();
 
   NodePendingTxn result;
@@ -4641,6 +5003,7 @@ bool Messenger::SetNodePendingTxn(
                                   *result.mutable_data()->mutable_pubkey());
   result.mutable_data()->set_epochnumber(epochnum);
   result.mutable_data()->set_shardid(shardId);
+  result.mutable_data()->set_poolsize(poolSize);
 
   for (const auto& hashCodePair : hashCodeMap) {
     auto protoHashCodePair = result.mutable_data()->add_hashcodepair();
@@ -4676,7 +5039,7 @@ bool Messenger::SetNodePendingTxn(
 bool Messenger::GetNodePendingTxn(
     const bytes& src, const unsigned offset, uint64_t& epochnum,
     unordered_map<TxnHash, PoolTxnStatus>& hashCodeMap, uint32_t& shardId,
-    PubKey& pubKey) {
+    PubKey& pubKey, uint32_t& poolSize) {
   LOG_MARKER();
 
   if (offset >= src.size()) {
@@ -4718,6 +5081,7 @@ bool Messenger::GetNodePendingTxn(
 
   epochnum = result.data().epochnumber();
   shardId = result.data().shardid();
+  poolSize = result.data().poolsize();
 
   return true;
 }
@@ -4813,38 +5177,41 @@ bool Messenger::SetNodeForwardTxnBlock(
 
   unsigned int msg_size = 0;
 
+  // Size the repeated field once up front so add_transactions never has to
+  // regrow it mid-epoch.
+  result.mutable_transactions()->Reserve(txnsCurrent.size() +
+                                         txnsGenerated.size());
+
   for (const auto& txn : txnsCurrent) {
     if (msg_size >= PACKET_BYTESIZE_LIMIT) {
       break;
     }
-    ProtoTransaction* protoTxn = new ProtoTransaction();
-    TransactionToProtobuf(txn, *protoTxn);
-    unsigned txn_size = protoTxn->ByteSize();
+    ProtoTransaction protoTxn;
+    TransactionToProtobuf(txn, protoTxn);
+    unsigned txn_size = protoTxn.ByteSize();
     if ((msg_size + txn_size) > PACKET_BYTESIZE_LIMIT &&
         txn_size >= SMALL_TXN_SIZE) {
       continue;
     }
-    *result.add_transactions() = *protoTxn;
+    result.add_transactions()->Swap(&protoTxn);
     txnsCurrentCount++;
-    msg_size += protoTxn->ByteSize();
-    delete protoTxn;
+    msg_size += txn_size;
   }
 
   for (const auto& txn : txnsGenerated) {
     if (msg_size >= PACKET_BYTESIZE_LIMIT) {
       break;
     }
-    ProtoTransaction* protoTxn = new ProtoTransaction();
-    TransactionToProtobuf(txn, *protoTxn);
-    unsigned txn_size = protoTxn->ByteSize();
+    ProtoTransaction protoTxn;
+    TransactionToProtobuf(txn, protoTxn);
+    unsigned txn_size = protoTxn.ByteSize();
     if ((msg_size + txn_size) > PACKET_BYTESIZE_LIMIT &&
         txn_size >= SMALL_TXN_SIZE) {
       continue;
     }
-    *result.add_transactions() = *protoTxn;
+    result.add_transactions()->Swap(&protoTxn);
     txnsGeneratedCount++;
     msg_size += txn_size;
-    delete protoTxn;
   }
 
   Signature signature;
@@ -4894,21 +5261,22 @@ bool Messenger::SetNodeForwardTxnBlock(bytes& dst, const unsigned int offset,
 
   unsigned int msg_size = 0;
 
+  result.mutable_transactions()->Reserve(txns.size());
+
   for (const auto& txn : txns) {
     if (msg_size >= PACKET_BYTESIZE_LIMIT) {
       break;
     }
-    ProtoTransaction* protoTxn = new ProtoTransaction();
-    TransactionToProtobuf(txn, *protoTxn);
-    unsigned txn_size = protoTxn->ByteSize();
+    ProtoTransaction protoTxn;
+    TransactionToProtobuf(txn, protoTxn);
+    unsigned txn_size = protoTxn.ByteSize();
     if ((msg_size + txn_size) > PACKET_BYTESIZE_LIMIT &&
         txn_size >= SMALL_TXN_SIZE) {
       continue;
     }
-    *result.add_transactions() = *protoTxn;
+    result.add_transactions()->Swap(&protoTxn);
     txnsCount++;
     msg_size += txn_size;
-    delete protoTxn;
   }
 
   SerializableToProtobufByteArray(signature, *result.mutable_signature());
@@ -4936,7 +5304,9 @@ bool Messenger::GetNodeForwardTxnBlock(
     return false;
   }
 
-  NodeForwardTxnBlock result;
+  google::protobuf::Arena arena;
+  NodeForwardTxnBlock& result =
+      *google::protobuf::Arena::CreateMessage<NodeForwardTxnBlock>(&arena);
   result.ParseFromArray(src.data() + offset, src.size() - offset);
 
   if (!result.IsInitialized()) {
@@ -4968,7 +5338,7 @@ bool Messenger::GetNodeForwardTxnBlock(
         LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
         return false;
       }
-      txns.emplace_back(t);
+      txns.emplace_back(std::move(t));
     }
   }
 
@@ -5046,8 +5416,9 @@ bool Messenger::GetNodeMicroBlockAnnouncement(
 
   // Check the common consensus announcement parameters
 
-  if (!GetConsensusAnnouncementCore(announcement, consensusID, blockNumber,
-                                    blockHash, leaderID, leaderKey)) {
+  if (!GetConsensusAnnouncementCore(announcement, src, offset, consensusID,
+                                    blockNumber, blockHash, leaderID,
+                                    leaderKey)) {
     LOG_GENERAL(WARNING, "GetConsensusAnnouncementCore failed");
     return false;
   }
@@ -5140,8 +5511,9 @@ bool Messenger::GetNodeFallbackBlockAnnouncement(
 
   // Check the common consensus announcement parameters
 
-  if (!GetConsensusAnnouncementCore(announcement, consensusID, blockNumber,
-                                    blockHash, leaderID, leaderKey)) {
+  if (!GetConsensusAnnouncementCore(announcement, src, offset, consensusID,
+                                    blockNumber, blockHash, leaderID,
+                                    leaderKey)) {
     LOG_GENERAL(WARNING, "GetConsensusAnnouncementCore failed");
     return false;
   }
@@ -5492,13 +5864,15 @@ bool Messenger::SetLookupSetDSInfoFromSeed(bytes& dst,
 
   LookupSetDSInfoFromSeed result;
 
+  // The cached wire blob doubles as the signing payload, so serving DSInfo
+  // does not re-serialize hundreds of committee members per request
+  bytes tmp;
   DSCommitteeToProtobuf(dsCommitteeVersion, dsNodes,
-                        *result.mutable_dscommittee());
+                        *result.mutable_dscommittee(), &tmp);
 
   SerializableToProtobufByteArray(senderKey.second, *result.mutable_pubkey());
 
-  bytes tmp;
-  if (!SerializeToArray(result.dscommittee(), tmp, 0)) {
+  if (tmp.empty()) {
     LOG_GENERAL(WARNING, "Failed to serialize DS committee");
     return false;
   }
@@ -6249,12 +6623,18 @@ bool Messenger::GetLookupSetStateDeltasFromSeed(
 }
 
 bool Messenger::SetLookupGetStateFromSeed(bytes& dst, const unsigned int offset,
-                                          const uint32_t listenPort) {
+                                          const uint32_t listenPort,
+                                          const bool chunked,
+                                          const bytes& cursor) {
   LOG_MARKER();
 
   LookupGetStateFromSeed result;
 
   result.set_listenport(listenPort);
+  result.set_chunked(chunked ? 1 : 0);
+  if (!cursor.empty()) {
+    result.mutable_cursor()->set_data(cursor.data(), cursor.size());
+  }
 
   if (!result.IsInitialized()) {
     LOG_GENERAL(WARNING, "LookupGetStateFromSeed initialization failed");
@@ -6266,7 +6646,8 @@ bool Messenger::SetLookupGetStateFromSeed(bytes& dst, const unsigned int offset,
 
 bool Messenger::GetLookupGetStateFromSeed(const bytes& src,
                                           const unsigned int offset,
-                                          uint32_t& listenPort) {
+                                          uint32_t& listenPort, bool& chunked,
+                                          bytes& cursor) {
   LOG_MARKER();
 
   if (offset >= src.size()) {
@@ -6284,6 +6665,12 @@ bool Messenger::GetLookupGetStateFromSeed(const bytes& src,
   }
 
   listenPort = result.listenport();
+  chunked = (result.chunked() != 0);
+  cursor.clear();
+  if (result.has_cursor()) {
+    copy(result.cursor().data().begin(), result.cursor().data().end(),
+         back_inserter(cursor));
+  }
 
   return true;
 }
@@ -6321,10 +6708,50 @@ bool Messenger::SetLookupSetStateFromSeed(bytes& dst, const unsigned int offset,
   return SerializeToArray(result, dst, offset);
 }
 
+bool Messenger::SetLookupSetStateFromSeedChunk(bytes& dst,
+                                               const unsigned int offset,
+                                               const PairOfKey& lookupKey,
+                                               const bytes& accountStoreChunk,
+                                               const bytes& nextCursor) {
+  LOG_MARKER();
+
+  LookupSetStateFromSeed result;
+
+  SerializableToProtobufByteArray(lookupKey.second, *result.mutable_pubkey());
+
+  result.mutable_accountstore()->set_data(accountStoreChunk.data(),
+                                          accountStoreChunk.size());
+
+  // The cursor is covered by the signature, so a relay cannot truncate the
+  // transfer by clearing it
+  bytes signedData = accountStoreChunk;
+  if (!nextCursor.empty()) {
+    result.mutable_nextcursor()->set_data(nextCursor.data(), nextCursor.size());
+    signedData.insert(signedData.end(), nextCursor.begin(), nextCursor.end());
+  }
+
+  Signature signature;
+  if (!Schnorr::Sign(signedData, lookupKey.first, lookupKey.second,
+                     signature)) {
+    LOG_GENERAL(WARNING, "Failed to sign accounts");
+    return false;
+  }
+
+  SerializableToProtobufByteArray(signature, *result.mutable_signature());
+
+  if (!result.IsInitialized()) {
+    LOG_GENERAL(WARNING, "LookupSetStateFromSeed initialization failed");
+    return false;
+  }
+
+  return SerializeToArray(result, dst, offset);
+}
+
 bool Messenger::GetLookupSetStateFromSeed(const bytes& src,
                                           const unsigned int offset,
                                           PubKey& lookupPubKey,
-                                          bytes& accountStoreBytes) {
+                                          bytes& accountStoreBytes,
+                                          bytes& nextCursor) {
   LOG_MARKER();
 
   LookupSetStateFromSeed result;
@@ -6348,9 +6775,25 @@ bool Messenger::GetLookupSetStateFromSeed(const bytes& src,
   copy(result.accountstore().data().begin(), result.accountstore().data().end(),
        back_inserter(accountStoreBytes));
 
-  if (!Schnorr::Verify(accountStoreBytes, signature, lookupPubKey)) {
-    LOG_GENERAL(WARNING, "Invalid signature in accounts");
-    return false;
+  nextCursor.clear();
+  if (result.has_nextcursor()) {
+    copy(result.nextcursor().data().begin(), result.nextcursor().data().end(),
+         back_inserter(nextCursor));
+  }
+
+  if (nextCursor.empty()) {
+    if (!Schnorr::Verify(accountStoreBytes, signature, lookupPubKey)) {
+      LOG_GENERAL(WARNING, "Invalid signature in accounts");
+      return false;
+    }
+  } else {
+    // Non-final chunks are signed over the chunk plus its cursor
+    bytes signedData = accountStoreBytes;
+    signedData.insert(signedData.end(), nextCursor.begin(), nextCursor.end());
+    if (!Schnorr::Verify(signedData, signature, lookupPubKey)) {
+      LOG_GENERAL(WARNING, "Invalid signature in accounts");
+      return false;
+    }
   }
 
   return true;
@@ -7505,7 +7948,12 @@ bool Messenger::SetConsensusCommit(
     const PairOfKey& backupKey) {
   LOG_MARKER();
 
-  ConsensusCommit result;
+  // Arena-backed construction: consensus messages are rebuilt from scratch
+  // on every round and every view change, so pooling the protobuf node
+  // allocations avoids churning the heap in the view-change-heavy worst case
+  google::protobuf::Arena arena;
+  ConsensusCommit& result =
+      *google::protobuf::Arena::CreateMessage<ConsensusCommit>(&arena);
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -7644,7 +8092,10 @@ bool Messenger::SetConsensusChallenge(
     const vector<ChallengeSubsetInfo>& subsetInfo, const PairOfKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusChallenge result;
+  // Arena-backed construction, same rationale as SetConsensusCommit
+  google::protobuf::Arena arena;
+  ConsensusChallenge& result =
+      *google::protobuf::Arena::CreateMessage<ConsensusChallenge>(&arena);
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -7787,7 +8238,10 @@ bool Messenger::SetConsensusResponse(
     const vector<ResponseSubsetInfo>& subsetInfo, const PairOfKey& backupKey) {
   LOG_MARKER();
 
-  ConsensusResponse result;
+  // Arena-backed construction, same rationale as SetConsensusCommit
+  google::protobuf::Arena arena;
+  ConsensusResponse& result =
+      *google::protobuf::Arena::CreateMessage<ConsensusResponse>(&arena);
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -7926,7 +8380,10 @@ bool Messenger::SetConsensusCollectiveSig(
     const PairOfKey& leaderKey) {
   LOG_MARKER();
 
-  ConsensusCollectiveSig result;
+  // Arena-backed construction, same rationale as SetConsensusCommit
+  google::protobuf::Arena arena;
+  ConsensusCollectiveSig& result =
+      *google::protobuf::Arena::CreateMessage<ConsensusCollectiveSig>(&arena);
 
   result.mutable_consensusinfo()->set_consensusid(consensusID);
   result.mutable_consensusinfo()->set_blocknumber(blockNumber);
@@ -43,6 +43,14 @@ namespace ZilliqaMessage {
 class ByteArray;
 }
 
+namespace google {
+namespace protobuf {
+namespace io {
+class ZeroCopyInputStream;
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
 bool ProtobufByteArrayToSerializable(const ZilliqaMessage::ByteArray& byteArray,
                                      SerializableCrypto& serializable);
 
@@ -95,11 +103,28 @@ class Messenger {
                               MAP& addressToAccount);
   static bool GetAccountStore(const bytes& src, const unsigned int offset,
                               AccountStore& accountStore);
+  /// Streaming variant: parses ProtoAccountStore entries one at a time off
+  /// the stream and commits each account as it arrives, so peak memory stays
+  /// bounded by one entry instead of the whole serialized state.
+  static bool GetAccountStore(google::protobuf::io::ZeroCopyInputStream& src,
+                              AccountStore& accountStore);
+  /// Serializes one slice of the account store (used by the chunked
+  /// GETSTATEFROMSEED transfer); each chunk is a self-contained
+  /// ProtoAccountStore
+  static bool SetAccountStoreChunk(
+      bytes& dst, const unsigned int offset,
+      const std::vector<std::pair<const Address*, const Account*>>& entries);
 
   // These are called by AccountStore class
   static bool SetAccountStoreDelta(bytes& dst, const unsigned int offset,
                                    AccountStoreTemp& accountStoreTemp,
                                    AccountStore& accountStore);
+  /// Serializes a single delta entry as a standalone fragment; concatenating
+  /// fragments yields the same bytes as SetAccountStoreDelta over the full
+  /// map (used by the incremental AccountStore::SerializeDelta)
+  static bool SetAccountStoreDeltaEntry(bytes& dst, const Address& address,
+                                        Account* oldAccount,
+                                        const Account& newAccount);
   static bool GetAccountStoreDelta(const bytes& src, const unsigned int offset,
                                    AccountStore& accountStore,
                                    const bool revertible, bool temp);
@@ -375,12 +400,12 @@ class Messenger {
   static bool GetNodePendingTxn(
       const bytes& src, const unsigned offset, uint64_t& epochnum,
       std::unordered_map<TxnHash, PoolTxnStatus>& hashCodeMap,
-      uint32_t& shardId, PubKey& pubKey);
+      uint32_t& shardId, PubKey& pubKey, uint32_t& poolSize);
 
   static bool SetNodePendingTxn(
       bytes& dst, const unsigned offset, const uint64_t& epochnum,
       const std::unordered_map<TxnHash, PoolTxnStatus>& hashCodeMap,
-      const uint32_t shardId, const PairOfKey& key);
+      const uint32_t shardId, const uint32_t poolSize, const PairOfKey& key);
 
   static bool SetNodeForwardTxnBlock(
       bytes& dst, const unsigned int offset, const uint64_t& epochNumber,
@@ -560,17 +585,29 @@ class Messenger {
                                               PubKey& lookupPubKey,
                                               std::vector<bytes>& stateDeltas);
   static bool SetLookupGetStateFromSeed(bytes& dst, const unsigned int offset,
-                                        const uint32_t listenPort);
+                                        const uint32_t listenPort,
+                                        const bool chunked = false,
+                                        const bytes& cursor = {});
   static bool GetLookupGetStateFromSeed(const bytes& src,
                                         const unsigned int offset,
-                                        uint32_t& listenPort);
+                                        uint32_t& listenPort, bool& chunked,
+                                        bytes& cursor);
   static bool SetLookupSetStateFromSeed(bytes& dst, const unsigned int offset,
                                         const PairOfKey& lookupKey,
                                         const AccountStore& accountStore);
+  /// Chunked counterpart of SetLookupSetStateFromSeed: wraps one
+  /// pre-serialized slice of the account store; nextCursor is covered by the
+  /// signature and is empty on the final chunk
+  static bool SetLookupSetStateFromSeedChunk(bytes& dst,
+                                             const unsigned int offset,
+                                             const PairOfKey& lookupKey,
+                                             const bytes& accountStoreChunk,
+                                             const bytes& nextCursor);
   static bool GetLookupSetStateFromSeed(const bytes& src,
                                         const unsigned int offset,
                                         PubKey& lookupPubKey,
-                                        bytes& accountStoreBytes);
+                                        bytes& accountStoreBytes,
+                                        bytes& nextCursor);
   static bool SetLookupSetLookupOffline(bytes& dst, const unsigned int offset,
                                         const uint8_t msgType,
                                         const uint32_t listenPort,
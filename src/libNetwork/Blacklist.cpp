@@ -30,15 +30,20 @@ Blacklist& Blacklist::GetInstance() {
   return blacklist;
 }
 
+Blacklist::BlacklistShard& Blacklist::GetShard(const uint128_t& ip) {
+  return m_shards.at((ip % NUM_SHARDS).convert_to<unsigned int>());
+}
+
 /// P2PComm may use this function
 bool Blacklist::Exist(const uint128_t& ip, const bool strict) {
   if (!m_enabled) {
     return false;
   }
 
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  const auto& bl = m_blacklistIP.find(ip);
-  if (bl != m_blacklistIP.end()) {
+  BlacklistShard& shard = GetShard(ip);
+  lock_guard<mutex> g(shard.m_mutex);
+  const auto& bl = shard.m_ips.find(ip);
+  if (bl != shard.m_ips.end()) {
     if (strict) {
       // always return exist when strict, must be checked while sending message
       return true;
@@ -55,16 +60,21 @@ void Blacklist::Add(const uint128_t& ip, const bool strict) {
     return;
   }
 
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  if (m_whitelistedIP.end() == m_whitelistedIP.find(ip)) {
-    const auto& res = m_blacklistIP.emplace(ip, strict);
-    // already existed, then over-ride strictness i.e. false by true
-    if (!res.second && strict) {
-      res.first->second = strict;
+  {
+    lock_guard<mutex> g(m_mutexWhitelistedIP);
+    if (m_whitelistedIP.end() != m_whitelistedIP.find(ip)) {
+      LOG_GENERAL(INFO,
+                  "Whitelisted IP: " << IPConverter::ToStrFromNumericalIP(ip));
+      return;
     }
-  } else {
-    LOG_GENERAL(INFO,
-                "Whitelisted IP: " << IPConverter::ToStrFromNumericalIP(ip));
+  }
+
+  BlacklistShard& shard = GetShard(ip);
+  lock_guard<mutex> g(shard.m_mutex);
+  const auto& res = shard.m_ips.emplace(ip, strict);
+  // already existed, then over-ride strictness i.e. false by true
+  if (!res.second && strict) {
+    res.first->second = strict;
   }
 }
 
@@ -74,14 +84,17 @@ void Blacklist::Remove(const uint128_t& ip) {
     return;
   }
 
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  m_blacklistIP.erase(ip);
+  BlacklistShard& shard = GetShard(ip);
+  lock_guard<mutex> g(shard.m_mutex);
+  shard.m_ips.erase(ip);
 }
 
 /// Reputation Manager may use this function
 void Blacklist::Clear() {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  m_blacklistIP.clear();
+  for (auto& shard : m_shards) {
+    lock_guard<mutex> g(shard.m_mutex);
+    shard.m_ips.clear();
+  }
   LOG_GENERAL(INFO, "Blacklist cleared");
 }
 
@@ -90,16 +103,18 @@ void Blacklist::Pop(unsigned int num_to_pop) {
     return;
   }
 
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  LOG_GENERAL(INFO, "Num of nodes in blacklist: " << m_blacklistIP.size());
+  LOG_GENERAL(INFO, "Num of nodes in blacklist: " << SizeOfBlacklist());
 
   unsigned int counter = 0;
-  for (auto it = m_blacklistIP.begin(); it != m_blacklistIP.end();) {
-    if (counter < num_to_pop) {
-      it = m_blacklistIP.erase(it);
-      counter++;
-    } else {
-      break;
+  for (auto& shard : m_shards) {
+    lock_guard<mutex> g(shard.m_mutex);
+    for (auto it = shard.m_ips.begin(); it != shard.m_ips.end();) {
+      if (counter < num_to_pop) {
+        it = shard.m_ips.erase(it);
+        counter++;
+      } else {
+        break;
+      }
     }
   }
 
@@ -107,8 +122,12 @@ void Blacklist::Pop(unsigned int num_to_pop) {
 }
 
 unsigned int Blacklist::SizeOfBlacklist() {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
-  return m_blacklistIP.size();
+  unsigned int size = 0;
+  for (auto& shard : m_shards) {
+    lock_guard<mutex> g(shard.m_mutex);
+    size += shard.m_ips.size();
+  }
+  return size;
 }
 
 void Blacklist::Enable(const bool enable) {
@@ -123,7 +142,7 @@ bool Blacklist::Whitelist(const uint128_t& ip) {
   if (!m_enabled) {
     return false;
   }
-  lock_guard<mutex> g(m_mutexBlacklistIP);
+  lock_guard<mutex> g(m_mutexWhitelistedIP);
   return m_whitelistedIP.emplace(ip).second;
 }
 
@@ -131,11 +150,11 @@ bool Blacklist::RemoveFromWhitelist(const uint128_t& ip) {
   if (!m_enabled) {
     return false;
   }
-  lock_guard<mutex> g(m_mutexBlacklistIP);
+  lock_guard<mutex> g(m_mutexWhitelistedIP);
   return (m_whitelistedIP.erase(ip) > 0);
 }
 
 bool Blacklist::IsWhitelistedIP(const uint128_t& ip) {
-  lock_guard<mutex> g(m_mutexBlacklistIP);
+  lock_guard<mutex> g(m_mutexWhitelistedIP);
   return m_whitelistedIP.end() != m_whitelistedIP.find(ip);
 }
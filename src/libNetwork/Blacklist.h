@@ -18,6 +18,7 @@
 #ifndef ZILLIQA_SRC_LIBNETWORK_BLACKLIST_H_
 #define ZILLIQA_SRC_LIBNETWORK_BLACKLIST_H_
 
+#include <array>
 #include <atomic>
 #include <mutex>
 #include <set>
@@ -42,11 +43,23 @@ class Blacklist {
   Blacklist(Blacklist const&) = delete;
   void operator=(Blacklist const&) = delete;
 
-  std::mutex m_mutexBlacklistIP;
-  std::unordered_map<uint128_t, bool>
-      m_blacklistIP;  // IP <-> Strict/Relaxed
-                      // Strict -> Blacklisted for both sending and incoming msg
-                      // Relaxed -> Blacklisted for incoming msg only
+  // The store is sharded by IP so that the hot-path lookups done on every
+  // accept and every send contend only on 1/NUM_SHARDS of the key space
+  // instead of one global mutex.
+  static const unsigned int NUM_SHARDS = 16;
+
+  struct BlacklistShard {
+    std::mutex m_mutex;
+    std::unordered_map<uint128_t, bool>
+        m_ips;  // IP <-> Strict/Relaxed
+                // Strict -> Blacklisted for both sending and incoming msg
+                // Relaxed -> Blacklisted for incoming msg only
+  };
+
+  std::array<BlacklistShard, NUM_SHARDS> m_shards;
+  BlacklistShard& GetShard(const uint128_t& ip);
+
+  std::mutex m_mutexWhitelistedIP;
   std::set<uint128_t> m_whitelistedIP;
   std::atomic<bool> m_enabled;
 
@@ -21,6 +21,7 @@
 #include "libNetwork/Blacklist.h"
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/DetachedFunction.h"
 #include "libUtils/IPConverter.h"
 #include "libUtils/Logger.h"
 
@@ -283,6 +284,10 @@ bool DataSender::SendDataToOthers(
       return false;
     }
 
+    // Serialize once; the lookup and shard legs below run concurrently and
+    // share this buffer instead of each leg working through its own copy.
+    auto sharedMessage = make_shared<bytes>(move(message));
+
     uint16_t randomDigits =
         DataConversion::charArrTo16Bits(hashForRandom.asBytes());
     bool committeeTooSmall = tmpCommittee.size() <= TX_SHARING_CLUSTER_SIZE;
@@ -297,7 +302,13 @@ bool DataSender::SendDataToOthers(
     if (indexB2 >= nodeToSendToLookUpLo && indexB2 < nodeToSendToLookUpHi) {
       LOG_GENERAL(INFO, "I will send data to the lookups");
       if (sendDataToLookupFunc) {
-        sendDataToLookupFunc(lookups, message);
+        // DNS resolution of the lookup hostnames can take a while - get it
+        // off the critical path between consensus and shard distribution
+        auto funcSendToLookup = [sendDataToLookupFunc, lookups,
+                                 sharedMessage]() mutable -> void {
+          sendDataToLookupFunc(lookups, *sharedMessage);
+        };
+        DetachedFunction(1, funcSendToLookup);
       }
     }
 
@@ -312,14 +323,27 @@ bool DataSender::SendDataToOthers(
       if ((my_cluster_num + 1) <= shards.size()) {
         LOG_GENERAL(INFO, "I will send data to the shards");
         if (sendDataToShardFunc) {
-          sendDataToShardFunc(message, shards, my_shards_lo, my_shards_hi);
+          auto funcSendToShards = [sendDataToShardFunc, sharedMessage, shards,
+                                   my_shards_lo,
+                                   my_shards_hi]() mutable -> void {
+            sendDataToShardFunc(*sharedMessage, shards, my_shards_lo,
+                                my_shards_hi);
+          };
+          DetachedFunction(1, funcSendToShards);
         } else {
+          // Receiver selection is cheap and needs the shard structure by
+          // reference, so keep it synchronous; only the sending leg is
+          // dispatched.
           std::deque<VectorOfPeer> sharded_receivers;
           DetermineNodesToSendDataTo(shards, blockswcosigRecver, consensusMyId,
                                      my_shards_lo, my_shards_hi, forceMulticast,
                                      sharded_receivers);
-          SendDataToShardNodesDefault(message, sharded_receivers,
-                                      forceMulticast);
+          auto funcSendToShards = [sharedMessage, sharded_receivers,
+                                   forceMulticast]() mutable -> void {
+            SendDataToShardNodesDefault(*sharedMessage, sharded_receivers,
+                                        forceMulticast);
+          };
+          DetachedFunction(1, funcSendToShards);
         }
       }
     }
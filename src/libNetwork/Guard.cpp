@@ -18,6 +18,7 @@
 #include "Guard.h"
 
 #include <arpa/inet.h>
+#include <algorithm>
 #include <boost/foreach.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -35,7 +36,10 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-Guard::Guard() {}
+Guard::Guard()
+    : m_DSGuardList(make_shared<unordered_set<PubKey>>()),
+      m_ShardGuardList(make_shared<unordered_set<PubKey>>()),
+      m_IPExclusionRange(make_shared<vector<pair<uint128_t, uint128_t>>>()) {}
 
 Guard::~Guard() {}
 
@@ -61,6 +65,10 @@ void Guard::UpdateDSGuardlist() {
   ptree pt;
   read_xml(config, pt);
 
+  lock_guard<mutex> g(m_mutexDSGuardList);
+  auto updated =
+      make_shared<unordered_set<PubKey>>(*atomic_load(&m_DSGuardList));
+
   for (const ptree::value_type& v : pt.get_child("node.ds_guard")) {
     if (v.first == "DSPUBKEY") {
       bytes pubkeyBytes;
@@ -68,14 +76,13 @@ void Guard::UpdateDSGuardlist() {
         continue;
       }
       PubKey pubKey(pubkeyBytes, 0);
-      AddToDSGuardlist(pubKey);
+      updated->emplace(pubKey);
     }
   }
 
-  {
-    lock_guard<mutex> g(m_mutexDSGuardList);
-    LOG_GENERAL(INFO, "Entries = " << m_DSGuardList.size());
-  }
+  LOG_GENERAL(INFO, "Entries = " << updated->size());
+  atomic_store(&m_DSGuardList,
+               shared_ptr<const unordered_set<PubKey>>(move(updated)));
 }
 
 void Guard::UpdateShardGuardlist() {
@@ -95,6 +102,10 @@ void Guard::UpdateShardGuardlist() {
   ptree pt;
   read_xml(config, pt);
 
+  lock_guard<mutex> g(m_mutexShardGuardList);
+  auto updated =
+      make_shared<unordered_set<PubKey>>(*atomic_load(&m_ShardGuardList));
+
   for (const ptree::value_type& v : pt.get_child("node.shard_guard")) {
     if (v.first == "SHARDPUBKEY") {
       bytes pubkeyBytes;
@@ -102,13 +113,13 @@ void Guard::UpdateShardGuardlist() {
         continue;
       }
       PubKey pubKey(pubkeyBytes, 0);
-      AddToShardGuardlist(pubKey);
+      updated->emplace(pubKey);
     }
   }
-  {
-    lock_guard<mutex> g(m_mutexShardGuardList);
-    LOG_GENERAL(INFO, "Entries = " << m_ShardGuardList.size());
-  }
+
+  LOG_GENERAL(INFO, "Entries = " << updated->size());
+  atomic_store(&m_ShardGuardList,
+               shared_ptr<const unordered_set<PubKey>>(move(updated)));
 }
 
 void Guard::AddToDSGuardlist(const PubKey& dsGuardPubKey) {
@@ -118,7 +129,11 @@ void Guard::AddToDSGuardlist(const PubKey& dsGuardPubKey) {
   }
 
   lock_guard<mutex> g(m_mutexDSGuardList);
-  m_DSGuardList.emplace(dsGuardPubKey);
+  auto updated =
+      make_shared<unordered_set<PubKey>>(*atomic_load(&m_DSGuardList));
+  updated->emplace(dsGuardPubKey);
+  atomic_store(&m_DSGuardList,
+               shared_ptr<const unordered_set<PubKey>>(move(updated)));
   // LOG_GENERAL(INFO, "Added " << dsGuardPubKey);
 }
 
@@ -129,7 +144,11 @@ void Guard::AddToShardGuardlist(const PubKey& shardGuardPubKey) {
   }
 
   lock_guard<mutex> g(m_mutexShardGuardList);
-  m_ShardGuardList.emplace(shardGuardPubKey);
+  auto updated =
+      make_shared<unordered_set<PubKey>>(*atomic_load(&m_ShardGuardList));
+  updated->emplace(shardGuardPubKey);
+  atomic_store(&m_ShardGuardList,
+               shared_ptr<const unordered_set<PubKey>>(move(updated)));
 }
 
 bool Guard::IsNodeInDSGuardList(const PubKey& nodePubKey) {
@@ -138,8 +157,8 @@ bool Guard::IsNodeInDSGuardList(const PubKey& nodePubKey) {
     return false;
   }
 
-  lock_guard<mutex> g(m_mutexDSGuardList);
-  return (m_DSGuardList.find(nodePubKey) != m_DSGuardList.end());
+  const auto list = atomic_load(&m_DSGuardList);
+  return (list->find(nodePubKey) != list->end());
 }
 
 bool Guard::IsNodeInShardGuardList(const PubKey& nodePubKey) {
@@ -148,17 +167,15 @@ bool Guard::IsNodeInShardGuardList(const PubKey& nodePubKey) {
     return false;
   }
 
-  lock_guard<mutex> g(m_mutexShardGuardList);
-  return (m_ShardGuardList.find(nodePubKey) != m_ShardGuardList.end());
+  const auto list = atomic_load(&m_ShardGuardList);
+  return (list->find(nodePubKey) != list->end());
 }
 
 unsigned int Guard::GetNumOfDSGuard() {
-  lock_guard<mutex> g(m_mutexDSGuardList);
-  return m_DSGuardList.size();
+  return atomic_load(&m_DSGuardList)->size();
 }
 unsigned int Guard::GetNumOfShardGuard() {
-  lock_guard<mutex> g(m_mutexShardGuardList);
-  return m_ShardGuardList.size();
+  return atomic_load(&m_ShardGuardList)->size();
 }
 
 bool Guard::IsValidIP(const uint128_t& ip_addr) {
@@ -179,15 +196,22 @@ bool Guard::IsValidIP(const uint128_t& ip_addr) {
     return true;
   }
 
-  lock_guard<mutex> g(m_mutexIPExclusion);
-  for (const auto& ip_pair : m_IPExclusionRange) {
-    if (ip_pair.first <= ip_addr_c && ip_pair.second >= ip_addr_c) {
-      char ipStr[INET_ADDRSTRLEN];
-      inet_ntop(AF_INET, &(serv_addr.sin_addr), ipStr, INET_ADDRSTRLEN);
+  const auto ranges = atomic_load(&m_IPExclusionRange);
 
-      LOG_GENERAL(WARNING, "In Exclusion List: " << string(ipStr));
-      return false;
-    }
+  // The ranges are sorted by start and non-overlapping, so the only
+  // candidate is the last range starting at or before the address
+  auto it = upper_bound(ranges->begin(), ranges->end(), ip_addr_c,
+                        [](const uint32_t& addr,
+                           const pair<uint128_t, uint128_t>& ip_pair) {
+                          return addr < ip_pair.first;
+                        });
+
+  if (it != ranges->begin() && (--it)->second >= ip_addr_c) {
+    char ipStr[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &(serv_addr.sin_addr), ipStr, INET_ADDRSTRLEN);
+
+    LOG_GENERAL(WARNING, "In Exclusion List: " << string(ipStr));
+    return false;
   }
 
   return true;
@@ -216,11 +240,29 @@ void Guard::AddToExclusionList(const uint128_t& ft, const uint128_t& sd) {
   uint32_t sd_c = ntohl(sd.convert_to<uint32_t>());
   lock_guard<mutex> g(m_mutexIPExclusion);
 
+  auto ranges = *atomic_load(&m_IPExclusionRange);
+
   if (ft_c > sd_c) {
-    m_IPExclusionRange.emplace_back(sd_c, ft_c);
+    ranges.emplace_back(sd_c, ft_c);
   } else {
-    m_IPExclusionRange.emplace_back(ft_c, sd_c);
+    ranges.emplace_back(ft_c, sd_c);
   }
+
+  // Re-sort and merge overlaps so IsValidIP can binary search
+  sort(ranges.begin(), ranges.end());
+  vector<pair<uint128_t, uint128_t>> merged;
+  for (const auto& ip_pair : ranges) {
+    if (!merged.empty() && ip_pair.first <= merged.back().second) {
+      merged.back().second = max(merged.back().second, ip_pair.second);
+    } else {
+      merged.emplace_back(ip_pair);
+    }
+  }
+
+  atomic_store(&m_IPExclusionRange,
+               shared_ptr<const vector<pair<uint128_t, uint128_t>>>(
+                   make_shared<vector<pair<uint128_t, uint128_t>>>(
+                       move(merged))));
 }
 
 void Guard::AddDSGuardToBlacklistExcludeList(const DequeOfNode& dsComm) {
@@ -18,6 +18,7 @@
 #ifndef ZILLIQA_SRC_LIBNETWORK_GUARD_H_
 #define ZILLIQA_SRC_LIBNETWORK_GUARD_H_
 
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -33,17 +34,24 @@ class Guard {
   Guard(Guard const&) = delete;
   void operator=(Guard const&) = delete;
 
+  // The guard lists and the IP exclusion ranges are consulted per message in
+  // guard mode, so readers take an atomic snapshot of an immutable copy
+  // instead of a mutex. The mutexes below only serialize writers, which
+  // publish a fresh copy (copy-on-write) at init and list refreshes.
+
   // DS guardlist
   std::mutex m_mutexDSGuardList;
-  std::unordered_set<PubKey> m_DSGuardList;
+  std::shared_ptr<const std::unordered_set<PubKey>> m_DSGuardList;
 
   // Shard guardlist
   std::mutex m_mutexShardGuardList;
-  std::unordered_set<PubKey> m_ShardGuardList;
+  std::shared_ptr<const std::unordered_set<PubKey>> m_ShardGuardList;
 
-  // IPFilter
+  // IPFilter - kept sorted by range start with overlaps merged, so lookups
+  // can binary search
   std::mutex m_mutexIPExclusion;
-  std::vector<std::pair<uint128_t, uint128_t>> m_IPExclusionRange;
+  std::shared_ptr<const std::vector<std::pair<uint128_t, uint128_t>>>
+      m_IPExclusionRange;
 
   void ValidateRunTimeEnvironment();
 
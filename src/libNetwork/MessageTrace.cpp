@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MessageTrace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+
+#include "common/Constants.h"
+#include "common/Serializable.h"
+#include "libUtils/Logger.h"
+#include "libUtils/TimeUtils.h"
+
+using namespace std;
+
+namespace {
+
+// Trace layout: MAGIC, then per record a fixed header followed by the raw
+// payload. All numbers big-endian via Serializable, the sender in
+// Peer::Serialize layout.
+const char MAGIC[] = "ZILMTR01";
+const unsigned int MAGIC_SIZE = 8;
+const unsigned int PEER_SIZE = UINT128_SIZE + sizeof(uint32_t);
+const unsigned int RECORD_HEADER_SIZE =
+    sizeof(uint64_t) + PEER_SIZE + sizeof(uint32_t);
+
+}  // namespace
+
+void MessageTrace::RecordInbound(const bytes& message, const Peer& from) {
+  if (!ENABLE_MESSAGE_TRACE) {
+    return;
+  }
+
+  static mutex traceMutex;
+  static ofstream traceFile;
+  static bool initAttempted = false;
+
+  lock_guard<mutex> g(traceMutex);
+
+  if (!initAttempted) {
+    initAttempted = true;
+    // append so a restart during an incident keeps capturing into one trace
+    const bool isNew = !ifstream(MESSAGE_TRACE_FILE).good();
+    traceFile.open(MESSAGE_TRACE_FILE, ios::binary | ios::app);
+    if (!traceFile.is_open()) {
+      LOG_GENERAL(WARNING,
+                  "Cannot open message trace file " << MESSAGE_TRACE_FILE);
+      return;
+    }
+    if (isNew) {
+      traceFile.write(MAGIC, MAGIC_SIZE);
+    }
+  }
+
+  if (!traceFile.is_open()) {
+    return;
+  }
+
+  bytes header(RECORD_HEADER_SIZE);
+  Serializable::SetNumber<uint64_t>(header, 0, get_time_as_int(),
+                                    sizeof(uint64_t));
+  from.Serialize(header, sizeof(uint64_t));
+  Serializable::SetNumber<uint32_t>(header, sizeof(uint64_t) + PEER_SIZE,
+                                    message.size(), sizeof(uint32_t));
+
+  traceFile.write(reinterpret_cast<const char*>(header.data()), header.size());
+  traceFile.write(reinterpret_cast<const char*>(message.data()),
+                  message.size());
+  traceFile.flush();
+}
+
+bool MessageTrace::ReadTrace(const string& path, vector<Record>& records) {
+  records.clear();
+
+  ifstream traceFile(path, ios::binary);
+  if (!traceFile.is_open()) {
+    LOG_GENERAL(WARNING, "Cannot open message trace file " << path);
+    return false;
+  }
+
+  char magic[MAGIC_SIZE];
+  if (!traceFile.read(magic, MAGIC_SIZE) ||
+      !equal(magic, magic + MAGIC_SIZE, MAGIC)) {
+    LOG_GENERAL(WARNING, path << " is not a message trace file");
+    return false;
+  }
+
+  bytes header(RECORD_HEADER_SIZE);
+  while (traceFile.read(reinterpret_cast<char*>(header.data()),
+                        RECORD_HEADER_SIZE)) {
+    Record record;
+    record.timestampMicros =
+        Serializable::GetNumber<uint64_t>(header, 0, sizeof(uint64_t));
+    if (record.from.Deserialize(header, sizeof(uint64_t)) != 0) {
+      return false;
+    }
+    const uint32_t payloadSize = Serializable::GetNumber<uint32_t>(
+        header, sizeof(uint64_t) + PEER_SIZE, sizeof(uint32_t));
+
+    record.payload.resize(payloadSize);
+    if (!traceFile.read(reinterpret_cast<char*>(record.payload.data()),
+                        payloadSize)) {
+      LOG_GENERAL(WARNING, "Truncated record at the end of "
+                               << path << "; keeping the "
+                               << records.size() << " complete ones");
+      break;
+    }
+
+    records.emplace_back(move(record));
+  }
+
+  return true;
+}
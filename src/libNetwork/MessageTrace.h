@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBNETWORK_MESSAGETRACE_H_
+#define ZILLIQA_SRC_LIBNETWORK_MESSAGETRACE_H_
+
+#include <string>
+#include <vector>
+
+#include "Peer.h"
+#include "common/BaseType.h"
+
+/// Record/replay of inbound P2P messages. With ENABLE_MESSAGE_TRACE set in
+/// constants.xml, every message P2PComm hands to the dispatcher is appended
+/// to a compact binary trace (timestamp, sender, payload), so the exact
+/// message storm of an incident can later be replayed through
+/// Zilliqa::Dispatch on a lab node (see the replaytrace tool).
+class MessageTrace {
+ public:
+  struct Record {
+    uint64_t timestampMicros = 0;
+    Peer from;
+    bytes payload;
+  };
+
+  /// Appends one dispatched inbound message to the trace file; no-op unless
+  /// ENABLE_MESSAGE_TRACE is set
+  static void RecordInbound(const bytes& message, const Peer& from);
+
+  /// Loads a trace written by RecordInbound, in capture order
+  static bool ReadTrace(const std::string& path, std::vector<Record>& records);
+
+ private:
+  MessageTrace() = delete;
+};
+
+#endif  // ZILLIQA_SRC_LIBNETWORK_MESSAGETRACE_H_
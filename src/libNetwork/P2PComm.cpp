@@ -29,13 +29,17 @@
 #include <signal.h>
 #include <stdint.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
 
 #include "Blacklist.h"
+#include "MessageTrace.h"
 #include "P2PComm.h"
+#include "SendSocketPool.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
 #include "libUtils/DataConversion.h"
@@ -43,6 +47,7 @@
 #include "libUtils/JoinableFunction.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SafeMath.h"
+#include "libUtils/ThreadAffinity.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -56,7 +61,17 @@ const unsigned int GOSSIP_MSGTYPE_LEN = 1;
 const unsigned int GOSSIP_ROUND_LEN = 4;
 const unsigned int GOSSIP_SNDR_LISTNR_PORT_LEN = 4;
 
+// Lazy broadcast control messages: large payloads are announced by hash and
+// served on demand, so a peer that already holds the payload never receives
+// it a second time.
+const unsigned char START_BYTE_LAZY_BROADCAST = 0x44;
+const unsigned char LAZY_BROADCAST_ANNOUNCE = 0x01;
+const unsigned char LAZY_BROADCAST_FETCH = 0x02;
+const unsigned int LAZY_BROADCAST_CTRL_TYPE_LEN = 1;
+const unsigned int LAZY_BROADCAST_SNDR_LISTNR_PORT_LEN = 4;
+
 P2PComm::Dispatcher P2PComm::m_dispatcher;
+P2PComm::PriorityPredicate P2PComm::m_prioritySendPredicate;
 std::mutex P2PComm::m_mutexPeerConnectionCount;
 std::map<uint128_t, uint16_t> P2PComm::m_peerConnectionCount;
 
@@ -80,12 +95,41 @@ static bool comparePairSecond(
   return a.second < b.second;
 }
 
-P2PComm::P2PComm() : m_sendQueue(SENDQUEUE_SIZE) {
+P2PComm::P2PComm()
+    : m_sendQueue(SENDQUEUE_SIZE),
+      m_sendQueuePriority(SENDQUEUE_PRIORITY_SIZE) {
   auto func = [this]() -> void {
     bytes emptyHash;
 
     while (true) {
       this_thread::sleep_for(chrono::seconds(BROADCAST_INTERVAL));
+
+      {
+        // Expire lazily broadcast payloads and stale in-flight fetches on the
+        // same schedule as the broadcast hashes
+        lock_guard<mutex> g3(m_lazyBroadcastMutex);
+        const auto expiredBefore =
+            chrono::system_clock::now() - chrono::seconds(BROADCAST_EXPIRY);
+
+        for (auto it = m_lazyBroadcastStore.begin();
+             it != m_lazyBroadcastStore.end();) {
+          if (it->second.second < expiredBefore) {
+            it = m_lazyBroadcastStore.erase(it);
+          } else {
+            ++it;
+          }
+        }
+
+        for (auto it = m_lazyBroadcastPending.begin();
+             it != m_lazyBroadcastPending.end();) {
+          if (it->second < expiredBefore) {
+            it = m_lazyBroadcastPending.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+
       lock(m_broadcastToRemoveMutex, m_broadcastHashesMutex);
       lock_guard<mutex> g(m_broadcastToRemoveMutex, adopt_lock);
       lock_guard<mutex> g2(m_broadcastHashesMutex, adopt_lock);
@@ -118,6 +162,9 @@ P2PComm::~P2PComm() {
   while (m_sendQueue.pop(job)) {
     delete job;
   }
+  while (m_sendQueuePriority.pop(job)) {
+    delete job;
+  }
 }
 
 P2PComm& P2PComm::GetInstance() {
@@ -125,13 +172,21 @@ P2PComm& P2PComm::GetInstance() {
   return comm;
 }
 
-uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
-                           const uint32_t message_length) {
+std::atomic<uint64_t> SendJob::m_scatterGatherBytesSaved{0};
+
+uint32_t SendJob::writeMsgVec(struct iovec* iov, int iovcnt, int cli_sock,
+                              const Peer& from,
+                              const uint32_t message_length) {
   uint32_t written_length = 0;
 
   while (written_length < message_length) {
-    ssize_t n = write(cli_sock, (unsigned char*)buf + written_length,
-                      message_length - written_length);
+    // Skip iovecs already fully written after a partial writev
+    while (iovcnt > 0 && iov[0].iov_len == 0) {
+      ++iov;
+      --iovcnt;
+    }
+
+    ssize_t n = writev(cli_sock, iov, iovcnt);
 
     if (P2PComm::IsHostHavingNetworkIssue()) {
       LOG_GENERAL(WARNING, "[blacklist] Encountered "
@@ -158,13 +213,22 @@ uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
     }
 
     if (n <= 0) {
-      LOG_GENERAL(WARNING, "Socket write failed in message header. Code = "
+      LOG_GENERAL(WARNING, "Socket writev failed. Code = "
                                << errno << " Desc: " << std::strerror(errno)
                                << ". IP address:" << from);
       return written_length;
     }
 
     written_length += n;
+
+    // Advance the scatter list past the bytes the kernel consumed
+    size_t consumed = n;
+    for (int i = 0; i < iovcnt && consumed > 0; i++) {
+      const size_t take = std::min(consumed, iov[i].iov_len);
+      iov[i].iov_base = static_cast<unsigned char*>(iov[i].iov_base) + take;
+      iov[i].iov_len -= take;
+      consumed -= take;
+    }
   }
 
   if (written_length > 1000000) {
@@ -174,9 +238,76 @@ uint32_t SendJob::writeMsg(const void* buf, int cli_sock, const Peer& from,
   return written_length;
 }
 
+bytes SendJob::BuildFrameHeader(const bytes& message, unsigned char start_byte,
+                                const bytes& msg_hash) {
+  // Transmission format:
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x11 - start byte
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x22 - start byte (broadcast)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
+  // <32-byte hash> <message>
+
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x33 - start byte (report)
+  // 0x00 0x00 0x00 0x01 - 4-byte length of message
+  // 0x00
+  uint32_t length = message.size();
+
+  if (start_byte == START_BYTE_BROADCAST) {
+    length += HASH_LEN;
+  }
+
+  // Only the small header (plus broadcast hash) is materialized; the payload
+  // itself is handed to the kernel by reference via writev.
+  bytes header;
+  header.reserve(HDR_LEN +
+                 ((start_byte == START_BYTE_BROADCAST) ? HASH_LEN : 0));
+  header.insert(header.end(), {(unsigned char)(MSG_VERSION & 0xFF), start_byte,
+                               (unsigned char)((length >> 24) & 0xFF),
+                               (unsigned char)((length >> 16) & 0xFF),
+                               (unsigned char)((length >> 8) & 0xFF),
+                               (unsigned char)(length & 0xFF)});
+
+  if (start_byte == START_BYTE_BROADCAST) {
+    header.insert(header.end(), msg_hash.begin(), msg_hash.end());
+  }
+
+  return header;
+}
+
+bool SendJob::SendFrameOnSocket(int cli_sock, const Peer& peer,
+                                const bytes& header, const bytes& message) {
+  struct iovec iov[2];
+  iov[0].iov_base = const_cast<unsigned char*>(header.data());
+  iov[0].iov_len = header.size();
+  iov[1].iov_base = const_cast<unsigned char*>(message.data());
+  iov[1].iov_len = message.size();
+
+  const uint32_t total = header.size() + message.size();
+  const int iovcnt = message.empty() ? 1 : 2;
+
+  if (total != writeMsgVec(iov, iovcnt, cli_sock, peer, total)) {
+    return false;
+  }
+
+  // Bytes that would previously have been memcpy'd into a staging buffer
+  m_scatterGatherBytesSaved += message.size();
+  return true;
+}
+
 bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
                                     unsigned char start_byte,
                                     const bytes& msg_hash) {
+  return SendFrameSocketCore(
+      peer, BuildFrameHeader(message, start_byte, msg_hash), message);
+}
+
+bool SendJob::SendFrameSocketCore(const Peer& peer, const bytes& header,
+                                  const bytes& message) {
   // LOG_MARKER();
   LOG_PAYLOAD(DEBUG, "Sending to " << peer, message,
               Logger::MAX_BYTES_TO_DISPLAY);
@@ -191,6 +322,24 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
     return true;
   }
 
+  // Try a pooled persistent connection first; on any failure fall back to
+  // the one-shot socket below, since the pooled connection may simply have
+  // been closed by the remote end in the meantime.
+  if (SENDSOCKETPOOL_ENABLED) {
+    signal(SIGPIPE, SIG_IGN);
+    int pooled_sock = SendSocketPool::GetInstance().Acquire(peer);
+    if (pooled_sock >= 0) {
+      if (SendFrameOnSocket(pooled_sock, peer, header, message)) {
+        SendSocketPool::GetInstance().Release(peer, pooled_sock);
+        return true;
+      }
+      LOG_GENERAL(DEBUG, "Pooled send to " << peer
+                                           << " failed - retrying on a "
+                                              "fresh connection");
+      close_socket(&pooled_sock);
+    }
+  }
+
   try {
     int cli_sock = socket(AF_INET, SOCK_STREAM, 0);
     unique_ptr<int, void (*)(int*)> cli_sock_closer(&cli_sock, close_socket);
@@ -233,50 +382,13 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
 
       return false;
     }
-    // Transmission format:
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x11 - start byte
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
-    // <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x22 - start byte (broadcast)
-    // 0xLL 0xLL 0xLL 0xLL - 4-byte length of hash + message
-    // <32-byte hash> <message>
-
-    // 0x01 ~ 0xFF - version, defined in constant file
-    // 0x33 - start byte (report)
-    // 0x00 0x00 0x00 0x01 - 4-byte length of message
-    // 0x00
-    uint32_t length = message.size();
-
-    if (start_byte == START_BYTE_BROADCAST) {
-      length += HASH_LEN;
-    }
-
-    unsigned char buf[HDR_LEN] = {(unsigned char)(MSG_VERSION & 0xFF),
-                                  start_byte,
-                                  (unsigned char)((length >> 24) & 0xFF),
-                                  (unsigned char)((length >> 16) & 0xFF),
-                                  (unsigned char)((length >> 8) & 0xFF),
-                                  (unsigned char)(length & 0xFF)};
-
-    if (HDR_LEN != writeMsg(buf, cli_sock, peer, HDR_LEN)) {
-      LOG_GENERAL(INFO, "DEBUG: not written_length == " << HDR_LEN);
-    }
 
-    if (start_byte != START_BYTE_BROADCAST) {
-      writeMsg(&message.at(0), cli_sock, peer, length);
-      return true;
+    if (SendFrameOnSocket(cli_sock, peer, header, message) &&
+        SENDSOCKETPOOL_ENABLED) {
+      // Park the healthy connection for the next message to this peer
+      SendSocketPool::GetInstance().Release(peer, cli_sock);
+      cli_sock_closer.release();
     }
-
-    if (HASH_LEN != writeMsg(&msg_hash.at(0), cli_sock, peer, HASH_LEN)) {
-      LOG_GENERAL(WARNING, "Wrong message hash length.");
-      return true;
-    }
-
-    length -= HASH_LEN;
-    writeMsg(&message.at(0), cli_sock, peer, length);
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with write socket." << ' ' << e.what());
     return false;
@@ -286,8 +398,13 @@ bool SendJob::SendMessageSocketCore(const Peer& peer, const bytes& message,
 
 void SendJob::SendMessageCore(const Peer& peer, const bytes& message,
                               unsigned char startbyte, const bytes& hash) {
+  SendFrameCore(peer, BuildFrameHeader(message, startbyte, hash), message);
+}
+
+void SendJob::SendFrameCore(const Peer& peer, const bytes& header,
+                            const bytes& message) {
   uint32_t retry_counter = 0;
-  while (!SendMessageSocketCore(peer, message, startbyte, hash)) {
+  while (!SendFrameSocketCore(peer, header, message)) {
     if (Blacklist::GetInstance().Exist(peer.m_ipAddress)) {
       return;
     }
@@ -334,6 +451,11 @@ void SendJobPeers<T>::DoSend() {
                          << hashStr.substr(0, 6) << "] BEGN");
   }
 
+  // Broadcast fast path: derive the frame header (with optional hash)
+  // exactly once; the payload buffer is shared by reference across all
+  // peers via the scatter-gather send.
+  const bytes header = BuildFrameHeader(m_message, m_startbyte, m_hash);
+
   for (vector<unsigned int>::const_iterator curr = indexes.begin();
        curr < indexes.end(); ++curr) {
     const Peer& peer = m_peers.at(*curr);
@@ -345,7 +467,7 @@ void SendJobPeers<T>::DoSend() {
       continue;
     }
 
-    SendMessageCore(peer, m_message, m_startbyte, m_hash);
+    SendFrameCore(peer, header, m_message);
   }
 
   if ((m_startbyte == START_BYTE_BROADCAST) && (m_selfPeer != Peer())) {
@@ -356,11 +478,36 @@ void SendJobPeers<T>::DoSend() {
 }
 
 void P2PComm::ProcessSendJob(SendJob* job) {
+  const bool broadcast = job->m_startbyte == START_BYTE_BROADCAST;
+  auto funcSendMsg = [job]() mutable -> void {
+    job->DoSend();
+    delete job;
+  };
+  m_SendPool.AddJob(funcSendMsg, broadcast ? "broadcast" : "unicast");
+}
+
+void P2PComm::ProcessPrioritySendJob(SendJob* job) {
+  const bool broadcast = job->m_startbyte == START_BYTE_BROADCAST;
   auto funcSendMsg = [job]() mutable -> void {
     job->DoSend();
     delete job;
   };
-  m_SendPool.AddJob(funcSendMsg);
+  m_SendPoolPriority.AddJob(funcSendMsg, broadcast ? "broadcast" : "unicast");
+}
+
+void P2PComm::QueueSendJob(SendJob* job) {
+  if (m_prioritySendPredicate && m_prioritySendPredicate(job->m_message)) {
+    if (!m_sendQueuePriority.bounded_push(job)) {
+      LOG_GENERAL(WARNING, "Priority SendQueue is full");
+      delete job;
+    }
+    return;
+  }
+
+  if (!m_sendQueue.bounded_push(job)) {
+    LOG_GENERAL(WARNING, "SendQueue is full");
+    delete job;
+  }
 }
 
 void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
@@ -369,35 +516,93 @@ void P2PComm::ClearBroadcastHashAsync(const bytes& message_hash) {
   m_broadcastToRemove.emplace_back(message_hash, chrono::system_clock::now());
 }
 
-void P2PComm::ProcessBroadCastMsg(bytes& message, const Peer& from) {
-  bytes msg_hash(message.begin() + HDR_LEN,
-                 message.begin() + HDR_LEN + HASH_LEN);
+namespace {
+
+// Per-thread direct-mapped filter of recently seen broadcast hashes. At
+// gossip fan-in the same hash arrives dozens of times within milliseconds,
+// and each copy used to pay the full payload SHA-256 plus the dedup mutex
+// just to be discarded; a hit here short-circuits both. Entries expire with
+// BROADCAST_EXPIRY so the filter never outlives the authoritative set, and
+// the full hash is stored so a hit is never a false positive.
+struct RecentBroadcastFilter {
+  static const unsigned int NUM_SLOTS = 256;  // power of two
+
+  struct Slot {
+    unsigned char hash[HASH_LEN];
+    std::chrono::steady_clock::time_point seen;
+    bool used = false;
+  };
+
+  Slot slots[NUM_SLOTS];
+
+  static unsigned int IndexOf(const unsigned char* hash) {
+    // broadcast hashes are SHA-256 digests, so the leading bytes are as
+    // good a slot index as any
+    return ((hash[0] << 8) | hash[1]) & (NUM_SLOTS - 1);
+  }
+
+  bool Seen(const unsigned char* hash) const {
+    const Slot& slot = slots[IndexOf(hash)];
+    return slot.used && equal(slot.hash, slot.hash + HASH_LEN, hash) &&
+           chrono::steady_clock::now() - slot.seen <
+               chrono::seconds(BROADCAST_EXPIRY);
+  }
+
+  void Remember(const unsigned char* hash) {
+    Slot& slot = slots[IndexOf(hash)];
+    copy(hash, hash + HASH_LEN, slot.hash);
+    slot.seen = chrono::steady_clock::now();
+    slot.used = true;
+  }
+};
+
+thread_local RecentBroadcastFilter t_recentBroadcasts;
+
+}  // namespace
+
+void P2PComm::ProcessBroadCastMsg(const unsigned char* message, size_t len,
+                                  const Peer& from) {
+  bytes msg_hash(message + HDR_LEN, message + HDR_LEN + HASH_LEN);
+
+  // A hash this thread saw moments ago can be discarded on the wire-carried
+  // hash alone: whether the payload matches it (duplicate) or not (invalid),
+  // the message would be dropped after the expensive checks anyway
+  if (t_recentBroadcasts.Seen(message + HDR_LEN)) {
+    LOG_GENERAL(INFO, "Discarding duplicate");
+    return;
+  }
 
   P2PComm& p2p = P2PComm::GetInstance();
 
+  // Hash the payload once, outside the dedup lock - for multi-megabyte
+  // announcements this used to serialize every receive thread behind one
+  // SHA-256 computation. The digest is carried forward from here.
+  SHA2<HashType::HASH_VARIANT_256> sha256;
+  sha256.Update(message + HDR_LEN + HASH_LEN, len - HDR_LEN - HASH_LEN);
+  const bytes this_msg_hash = sha256.Finalize();
+
+  if (this_msg_hash != msg_hash) {
+    LOG_GENERAL(WARNING, "Incorrect message hash.");
+    return;
+  }
+
   // Check if this message has been received before
   bool found = false;
   {
     lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
 
-    found =
-        (p2p.m_broadcastHashes.find(msg_hash) != p2p.m_broadcastHashes.end());
+    found = (p2p.m_broadcastHashes.find(this_msg_hash) !=
+             p2p.m_broadcastHashes.end());
     // While we have the lock, we should quickly add the hash
     if (!found) {
-      SHA2<HashType::HASH_VARIANT_256> sha256;
-      sha256.Update(message, HDR_LEN + HASH_LEN,
-                    message.size() - HDR_LEN - HASH_LEN);
-      bytes this_msg_hash = sha256.Finalize();
-
-      if (this_msg_hash == msg_hash) {
-        p2p.m_broadcastHashes.insert(this_msg_hash);
-      } else {
-        LOG_GENERAL(WARNING, "Incorrect message hash.");
-        return;
-      }
+      p2p.m_broadcastHashes.insert(this_msg_hash);
     }
   }
 
+  // either way the hash is now known; further copies reaching this thread
+  // stop at the per-thread filter
+  t_recentBroadcasts.Remember(this_msg_hash.data());
+
   if (found) {
     // We already sent and/or received this message before -> discard
     LOG_GENERAL(INFO, "Discarding duplicate");
@@ -406,6 +611,13 @@ void P2PComm::ProcessBroadCastMsg(bytes& message, const Peer& from) {
 
   p2p.ClearBroadcastHashAsync(msg_hash);
 
+  {
+    // If this payload was fetched after a lazy announcement, the fetch is no
+    // longer in flight
+    lock_guard<mutex> guard(p2p.m_lazyBroadcastMutex);
+    p2p.m_lazyBroadcastPending.erase(this_msg_hash);
+  }
+
   string msgHashStr;
   if (!DataConversion::Uint8VecToHexStr(msg_hash, msgHashStr)) {
     return;
@@ -414,34 +626,42 @@ void P2PComm::ProcessBroadCastMsg(bytes& message, const Peer& from) {
   LOG_STATE("[BROAD][" << std::setw(15) << std::left << p2p.m_selfPeer << "]["
                        << msgHashStr.substr(0, 6) << "] RECV");
 
-  // Move the shared_ptr message to raw pointer type
+  // Only the payload that survived validation is copied out of the evbuffer
   pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(
-      bytes(message.begin() + HDR_LEN + HASH_LEN, message.end()), from);
+      bytes(message + HDR_LEN + HASH_LEN, message + len), from);
 
   // Queue the message
+  DispatchMessage(raw_message);
+}
+
+/*static*/ void P2PComm::DispatchMessage(pair<bytes, Peer>* raw_message) {
+  if (ENABLE_MESSAGE_TRACE) {
+    MessageTrace::RecordInbound(raw_message->first, raw_message->second);
+  }
   m_dispatcher(raw_message);
 }
 
-/*static*/ void P2PComm::ProcessGossipMsg(bytes& message, Peer& from) {
-  unsigned char gossipMsgTyp = message.at(HDR_LEN);
+/*static*/ void P2PComm::ProcessGossipMsg(const unsigned char* message,
+                                          size_t len, Peer& from) {
+  unsigned char gossipMsgTyp = message[HDR_LEN];
 
   const uint32_t gossipMsgRound =
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN) << 24) +
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + 1) << 16) +
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + 2) << 8) +
-      message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + 3);
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN] << 24) +
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN + 1] << 16) +
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN + 2] << 8) +
+      message[HDR_LEN + GOSSIP_MSGTYPE_LEN + 3];
 
   const uint32_t gossipSenderPort =
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN) << 24) +
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 1) << 16) +
-      (message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 2) << 8) +
-      message.at(HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 3);
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN] << 24) +
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 1] << 16) +
+      (message[HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 2] << 8) +
+      message[HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN + 3];
   from.m_listenPortHost = gossipSenderPort;
 
   RumorManager::RawBytes rumor_message(
-      message.begin() + HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN +
+      message + HDR_LEN + GOSSIP_MSGTYPE_LEN + GOSSIP_ROUND_LEN +
           GOSSIP_SNDR_LISTNR_PORT_LEN,
-      message.end());
+      message + len);
 
   P2PComm& p2p = P2PComm::GetInstance();
   if (gossipMsgTyp == (uint8_t)RRS::Message::Type::FORWARD) {
@@ -457,7 +677,7 @@ void P2PComm::ProcessBroadCastMsg(bytes& message, const Peer& from) {
       LOG_GENERAL(INFO, "Rumor size: " << tmp.size());
 
       // Queue the message
-      m_dispatcher(raw_message);
+      DispatchMessage(raw_message);
     }
   } else {
     auto resp = p2p.m_rumorManager.RumorReceived(
@@ -469,11 +689,86 @@ void P2PComm::ProcessBroadCastMsg(bytes& message, const Peer& from) {
       LOG_GENERAL(INFO, "Rumor size: " << rumor_message.size());
 
       // Queue the message
-      m_dispatcher(raw_message);
+      DispatchMessage(raw_message);
     }
   }
 }
 
+/*static*/ void P2PComm::ProcessLazyBroadcastMsg(const unsigned char* message,
+                                                 Peer& from) {
+  const unsigned char ctrlType = message[HDR_LEN];
+
+  const uint32_t senderPort =
+      (message[HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN] << 24) +
+      (message[HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN + 1] << 16) +
+      (message[HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN + 2] << 8) +
+      message[HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN + 3];
+  from.m_listenPortHost = senderPort;
+
+  bytes msg_hash(message + HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN +
+                     LAZY_BROADCAST_SNDR_LISTNR_PORT_LEN,
+                 message + HDR_LEN + LAZY_BROADCAST_CTRL_TYPE_LEN +
+                     LAZY_BROADCAST_SNDR_LISTNR_PORT_LEN + HASH_LEN);
+
+  P2PComm& p2p = P2PComm::GetInstance();
+
+  if (ctrlType == LAZY_BROADCAST_ANNOUNCE) {
+    {
+      lock_guard<mutex> guard(p2p.m_broadcastHashesMutex);
+      if (p2p.m_broadcastHashes.find(msg_hash) !=
+          p2p.m_broadcastHashes.end()) {
+        // Payload already received through another path - nothing to fetch
+        return;
+      }
+    }
+
+    {
+      lock_guard<mutex> guard(p2p.m_lazyBroadcastMutex);
+      if (!p2p.m_lazyBroadcastPending
+               .emplace(msg_hash, chrono::system_clock::now())
+               .second) {
+        // A fetch for this payload is already in flight
+        return;
+      }
+    }
+
+    bytes fetch = {LAZY_BROADCAST_FETCH};
+    Serializable::SetNumber<uint32_t>(fetch, fetch.size(),
+                                      p2p.m_selfPeer.m_listenPortHost,
+                                      sizeof(uint32_t));
+    fetch.insert(fetch.end(), msg_hash.begin(), msg_hash.end());
+
+    p2p.SendMessage(from, fetch, START_BYTE_LAZY_BROADCAST);
+  } else if (ctrlType == LAZY_BROADCAST_FETCH) {
+    bytes payload;
+    {
+      lock_guard<mutex> guard(p2p.m_lazyBroadcastMutex);
+      auto it = p2p.m_lazyBroadcastStore.find(msg_hash);
+      if (it == p2p.m_lazyBroadcastStore.end()) {
+        LOG_GENERAL(WARNING,
+                    "No stored payload for lazy broadcast fetch from " << from);
+        return;
+      }
+      payload = it->second.first;
+    }
+
+    // Serve the payload as a regular broadcast frame, so the fetcher's normal
+    // hash verification and dedup handle the delivery
+    SendJob* job = new SendJobPeer;
+    dynamic_cast<SendJobPeer*>(job)->m_peer = from;
+    job->m_selfPeer = p2p.m_selfPeer;
+    job->m_startbyte = START_BYTE_BROADCAST;
+    job->m_message = std::move(payload);
+    job->m_hash = msg_hash;
+    job->m_allowSendToRelaxedBlacklist = false;
+
+    p2p.QueueSendJob(job);
+  } else {
+    LOG_GENERAL(WARNING, "Unexpected lazy broadcast control type "
+                             << (unsigned int)ctrlType);
+  }
+}
+
 void P2PComm::CloseAndFreeBufferEvent(struct bufferevent* bufev) {
   int fd = bufferevent_getfd(bufev);
   struct sockaddr_in cli_addr {};
@@ -528,14 +823,13 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
     LOG_GENERAL(WARNING, "evbuffer_get_length failure.");
     return;
   }
-  bytes message(len);
-  if (evbuffer_copyout(input, message.data(), len) !=
-      static_cast<ev_ssize_t>(len)) {
-    LOG_GENERAL(WARNING, "evbuffer_copyout failure.");
-    return;
-  }
-  if (evbuffer_drain(input, len) != 0) {
-    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+
+  // Linearize the buffer in place so headers can be parsed without copying
+  // the whole message out of the evbuffer. Only the payload that survives
+  // validation is copied into a fresh bytes vector further down.
+  const unsigned char* message = evbuffer_pullup(input, len);
+  if (message == NULL) {
+    LOG_GENERAL(WARNING, "evbuffer_pullup failure.");
     return;
   }
 
@@ -561,8 +855,14 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
   // 0x00 0x00 0x00 0x01 - 4-byte length of message
   // 0x00
 
+  // 0x01 ~ 0xFF - version, defined in constant file
+  // 0x44 - start byte (lazy broadcast control)
+  // 0xLL 0xLL 0xLL 0xLL - 4-byte length of message
+  // 0x01 (announce) / 0x02 (fetch)
+  // <4-byte sender listen port> <32-byte hash>
+
   // Check for minimum message size
-  if (message.size() <= HDR_LEN) {
+  if (len <= HDR_LEN) {
     LOG_GENERAL(WARNING, "Empty message received.");
     return;
   }
@@ -570,6 +870,10 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
   const unsigned char version = message[0];
   const unsigned char startByte = message[1];
 
+  // Bounded copy for payload logging only
+  const bytes messageHead(
+      message, message + min(len, (size_t)Logger::MAX_BYTES_TO_DISPLAY));
+
   // Check for version requirement
   if (version != (unsigned char)(MSG_VERSION & 0xFF)) {
     LOG_GENERAL(WARNING, "Header version wrong, received ["
@@ -585,7 +889,7 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
     // Check for length consistency
     uint32_t res;
 
-    if (!SafeMath<uint32_t>::sub(message.size(), HDR_LEN, res)) {
+    if (!SafeMath<uint32_t>::sub(len, HDR_LEN, res)) {
       LOG_GENERAL(WARNING, "Unexpected subtraction operation!");
       return;
     }
@@ -597,7 +901,7 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
   }
 
   if (startByte == START_BYTE_BROADCAST) {
-    LOG_PAYLOAD(INFO, "Incoming broadcast " << from, message,
+    LOG_PAYLOAD(INFO, "Incoming broadcast " << from, messageHead,
                 Logger::MAX_BYTES_TO_DISPLAY);
 
     if (messageLength <= HASH_LEN) {
@@ -607,23 +911,23 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
       return;
     }
 
-    ProcessBroadCastMsg(message, from);
+    ProcessBroadCastMsg(message, len, from);
   } else if (startByte == START_BYTE_NORMAL) {
-    LOG_PAYLOAD(INFO, "Incoming normal " << from, message,
+    LOG_PAYLOAD(INFO, "Incoming normal " << from, messageHead,
                 Logger::MAX_BYTES_TO_DISPLAY);
 
-    // Move the shared_ptr message to raw pointer type
-    pair<bytes, Peer>* raw_message = new pair<bytes, Peer>(
-        bytes(message.begin() + HDR_LEN, message.end()), from);
+    // Only the payload is copied out of the evbuffer
+    pair<bytes, Peer>* raw_message =
+        new pair<bytes, Peer>(bytes(message + HDR_LEN, message + len), from);
 
     // Queue the message
-    m_dispatcher(raw_message);
+    DispatchMessage(raw_message);
   } else if (startByte == START_BYTE_GOSSIP) {
     // Check for the maximum gossiped-message size
-    if (message.size() >= MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
+    if (len >= MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
       LOG_GENERAL(WARNING,
                   "Gossip message received [Size:"
-                      << message.size() << "] is unexpectedly large [ >"
+                      << len << "] is unexpectedly large [ >"
                       << MAX_GOSSIP_MSG_SIZE_IN_BYTES
                       << " ]. Will be strictly blacklisting the sender");
       Blacklist::GetInstance().Add(
@@ -641,11 +945,26 @@ void P2PComm::EventCallback(struct bufferevent* bev, short events,
       return;
     }
 
-    ProcessGossipMsg(message, from);
+    ProcessGossipMsg(message, len, from);
+  } else if (startByte == START_BYTE_LAZY_BROADCAST) {
+    if (messageLength != LAZY_BROADCAST_CTRL_TYPE_LEN +
+                             LAZY_BROADCAST_SNDR_LISTNR_PORT_LEN + HASH_LEN) {
+      LOG_GENERAL(WARNING,
+                  "Unexpected lazy broadcast control length (messageLength = "
+                      << messageLength << ")");
+      return;
+    }
+
+    ProcessLazyBroadcastMsg(message, from);
   } else {
     // Unexpected start byte. Drop this message
     LOG_GENERAL(WARNING, "Incorrect start byte.");
   }
+
+  // The socket is about to be freed; the parsed view dies with the evbuffer
+  if (evbuffer_drain(input, len) != 0) {
+    LOG_GENERAL(WARNING, "evbuffer_drain failure.");
+  }
 }
 
 void P2PComm::ReadCallback(struct bufferevent* bev, [[gnu::unused]] void* ctx) {
@@ -736,12 +1055,18 @@ inline bool P2PComm::IsNodeNotRunning() {
   return (errno == EHOSTDOWN || errno == ECONNREFUSED);
 }
 
-void P2PComm::StartMessagePump(uint32_t listen_port_host,
-                               Dispatcher dispatcher) {
+void P2PComm::StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
+                               PriorityPredicate prioritySendPredicate) {
   LOG_MARKER();
 
+  // The libevent pump parses every inbound message; keep it on the same NUMA
+  // domain as the pools that consume the parsed buffers
+  ThreadAffinity::PinCurrentThread(NUMA_MESSAGE_THREADS_CPUS, "MessagePump");
+
   // Launch the thread that reads messages from the send queue
   auto funcCheckSendQueue = [this]() mutable -> void {
+    ThreadAffinity::PinCurrentThread(NUMA_MESSAGE_THREADS_CPUS,
+                                     "SendQueueDrain");
     SendJob* job = NULL;
     while (true) {
       while (m_sendQueue.pop(job)) {
@@ -752,7 +1077,24 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host,
   };
   DetachedFunction(1, funcCheckSendQueue);
 
+  // Consensus-class messages get their own drain thread and pool, so a
+  // sync-storm's worth of queued state and block-range transfers cannot
+  // head-of-line-block a consensus announcement.
+  auto funcCheckPrioritySendQueue = [this]() mutable -> void {
+    ThreadAffinity::PinCurrentThread(NUMA_MESSAGE_THREADS_CPUS,
+                                     "PrioSendQueueDrain");
+    SendJob* job = NULL;
+    while (true) {
+      while (m_sendQueuePriority.pop(job)) {
+        ProcessPrioritySendJob(job);
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(1));
+    }
+  };
+  DetachedFunction(1, funcCheckPrioritySendQueue);
+
   m_dispatcher = move(dispatcher);
+  m_prioritySendPredicate = move(prioritySendPredicate);
 
   struct sockaddr_in serv_addr {};
   memset(&serv_addr, 0, sizeof(struct sockaddr_in));
@@ -785,7 +1127,38 @@ void P2PComm::StartMessagePump(uint32_t listen_port_host,
   event_base_free(base);
 }
 
-void P2PComm::SendMessage(const vector<Peer>& peers, const bytes& message,
+bool P2PComm::DispatchLoopbackMessage(const Peer& peer, const bytes& message,
+                                      const unsigned char& startByteType) {
+  if (!ENABLE_LOOPBACK_DISPATCH || startByteType != START_BYTE_NORMAL ||
+      m_selfPeer == Peer() || peer != m_selfPeer || !m_dispatcher) {
+    return false;
+  }
+
+  DispatchMessage(new pair<bytes, Peer>(message, m_selfPeer));
+  return true;
+}
+
+template <class PeerContainer>
+bool P2PComm::FilterLoopbackPeer(const PeerContainer& peers,
+                                 PeerContainer& remotePeers,
+                                 const bytes& message,
+                                 const unsigned char& startByteType) {
+  if (!ENABLE_LOOPBACK_DISPATCH || startByteType != START_BYTE_NORMAL ||
+      m_selfPeer == Peer() || !m_dispatcher ||
+      find(peers.begin(), peers.end(), m_selfPeer) == peers.end()) {
+    return false;
+  }
+
+  DispatchMessage(new pair<bytes, Peer>(message, m_selfPeer));
+  for (const auto& peer : peers) {
+    if (peer != m_selfPeer) {
+      remotePeers.push_back(peer);
+    }
+  }
+  return true;
+}
+
+void P2PComm::SendMessage(const vector<Peer>& peers, bytes message,
                           const unsigned char& startByteType) {
   // LOG_MARKER();
 
@@ -793,23 +1166,30 @@ void P2PComm::SendMessage(const vector<Peer>& peers, const bytes& message,
     return;
   }
 
+  // A multicast list often includes ourselves (e.g. a DS node sending to
+  // the whole committee); deliver our own copy in-process
+  vector<Peer> remotePeers;
+  const bool loopedBack =
+      FilterLoopbackPeer(peers, remotePeers, message, startByteType);
+  if (loopedBack && remotePeers.empty()) {
+    return;
+  }
+
   // Make job
   SendJob* job = new SendJobPeers<vector<Peer>>;
-  dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
+  dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers =
+      loopedBack ? remotePeers : peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = std::move(message);
   job->m_hash.clear();
   job->m_allowSendToRelaxedBlacklist = false;
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-    delete job;
-  }
+  QueueSendJob(job);
 }
 
-void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
+void P2PComm::SendMessage(const deque<Peer>& peers, bytes message,
                           const unsigned char& startByteType,
                           const bool bAllowSendToRelaxedBlacklist) {
   // LOG_MARKER();
@@ -818,44 +1198,77 @@ void P2PComm::SendMessage(const deque<Peer>& peers, const bytes& message,
     return;
   }
 
+  deque<Peer> remotePeers;
+  const bool loopedBack =
+      FilterLoopbackPeer(peers, remotePeers, message, startByteType);
+  if (loopedBack && remotePeers.empty()) {
+    return;
+  }
+
   // Make job
   SendJob* job = new SendJobPeers<deque<Peer>>;
-  dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
+  dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers =
+      loopedBack ? remotePeers : peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = std::move(message);
   job->m_hash.clear();
   job->m_allowSendToRelaxedBlacklist = bAllowSendToRelaxedBlacklist;
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-    delete job;
-  }
+  QueueSendJob(job);
 }
 
-void P2PComm::SendMessage(const Peer& peer, const bytes& message,
+void P2PComm::SendMessage(const Peer& peer, bytes message,
                           const unsigned char& startByteType) {
   // LOG_MARKER();
 
+  if (DispatchLoopbackMessage(peer, message, startByteType)) {
+    return;
+  }
+
   // Make job
   SendJob* job = new SendJobPeer;
   dynamic_cast<SendJobPeer*>(job)->m_peer = peer;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = startByteType;
-  job->m_message = message;
+  job->m_message = std::move(message);
   job->m_hash.clear();
   job->m_allowSendToRelaxedBlacklist = false;
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-    delete job;
+  QueueSendJob(job);
+}
+
+template <class PeerContainer>
+void P2PComm::SendLazyBroadcastAnnouncement(const PeerContainer& peers,
+                                            bytes message,
+                                            const bytes& msgHash) {
+  LOG_GENERAL(INFO, "Lazy broadcast of " << message.size() << " bytes to "
+                                         << peers.size() << " peers");
+
+  {
+    lock_guard<mutex> guard(m_lazyBroadcastMutex);
+    m_lazyBroadcastStore[msgHash] =
+        make_pair(std::move(message), chrono::system_clock::now());
   }
+
+  {
+    lock_guard<mutex> guard(m_broadcastHashesMutex);
+    m_broadcastHashes.insert(msgHash);
+  }
+
+  bytes announcement = {LAZY_BROADCAST_ANNOUNCE};
+  Serializable::SetNumber<uint32_t>(announcement, announcement.size(),
+                                    m_selfPeer.m_listenPortHost,
+                                    sizeof(uint32_t));
+  announcement.insert(announcement.end(), msgHash.begin(), msgHash.end());
+
+  SendMessage(peers, announcement, START_BYTE_LAZY_BROADCAST);
 }
 
 void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
-                                   const bytes& message) {
+                                   bytes message) {
   LOG_MARKER();
 
   if (peers.empty()) {
@@ -864,30 +1277,34 @@ void P2PComm::SendBroadcastMessage(const vector<Peer>& peers,
 
   SHA2<HashType::HASH_VARIANT_256> sha256;
   sha256.Update(message);
+  bytes msgHash = sha256.Finalize();
+
+  if ((BROADCAST_LAZY_THRESHOLD_IN_BYTES > 0) &&
+      (message.size() >= BROADCAST_LAZY_THRESHOLD_IN_BYTES)) {
+    SendLazyBroadcastAnnouncement(peers, std::move(message), msgHash);
+    return;
+  }
 
   // Make job
   SendJob* job = new SendJobPeers<vector<Peer>>;
   dynamic_cast<SendJobPeers<vector<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
-  job->m_hash = sha256.Finalize();
+  job->m_message = std::move(message);
+  job->m_hash = std::move(msgHash);
   job->m_allowSendToRelaxedBlacklist = false;
 
   bytes hashCopy(job->m_hash);
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-    delete job;
-  }
+  QueueSendJob(job);
 
   lock_guard<mutex> guard(m_broadcastHashesMutex);
   m_broadcastHashes.insert(hashCopy);
 }
 
 void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
-                                   const bytes& message) {
+                                   bytes message) {
   LOG_MARKER();
 
   if (peers.empty()) {
@@ -896,23 +1313,27 @@ void P2PComm::SendBroadcastMessage(const deque<Peer>& peers,
 
   SHA2<HashType::HASH_VARIANT_256> sha256;
   sha256.Update(message);
+  bytes msgHash = sha256.Finalize();
+
+  if ((BROADCAST_LAZY_THRESHOLD_IN_BYTES > 0) &&
+      (message.size() >= BROADCAST_LAZY_THRESHOLD_IN_BYTES)) {
+    SendLazyBroadcastAnnouncement(peers, std::move(message), msgHash);
+    return;
+  }
 
   // Make job
   SendJob* job = new SendJobPeers<deque<Peer>>;
   dynamic_cast<SendJobPeers<deque<Peer>>*>(job)->m_peers = peers;
   job->m_selfPeer = m_selfPeer;
   job->m_startbyte = START_BYTE_BROADCAST;
-  job->m_message = message;
-  job->m_hash = sha256.Finalize();
+  job->m_message = std::move(message);
+  job->m_hash = std::move(msgHash);
   job->m_allowSendToRelaxedBlacklist = false;
 
   bytes hashCopy(job->m_hash);
 
   // Queue job
-  if (!m_sendQueue.bounded_push(job)) {
-    LOG_GENERAL(WARNING, "SendQueue is full");
-    delete job;
-  }
+  QueueSendJob(job);
 
   lock_guard<mutex> guard(m_broadcastHashesMutex);
   m_broadcastHashes.insert(hashCopy);
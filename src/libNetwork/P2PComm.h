@@ -19,6 +19,7 @@
 #define ZILLIQA_SRC_LIBNETWORK_P2PCOMM_H_
 
 #include <event2/util.h>
+#include <atomic>
 #include <boost/lockfree/queue.hpp>
 #include <deque>
 #include <functional>
@@ -34,6 +35,7 @@
 #include "libUtils/ThreadPool.h"
 
 struct evconnlistener;
+struct iovec;
 
 extern const unsigned char START_BYTE_NORMAL;
 extern const unsigned char START_BYTE_GOSSIP;
@@ -42,9 +44,27 @@ class SendJob {
  protected:
   static uint32_t writeMsg(const void* buf, int cli_sock, const Peer& from,
                            const uint32_t message_length);
+  static uint32_t writeMsgVec(struct iovec* iov, int iovcnt, int cli_sock,
+                              const Peer& from, const uint32_t message_length);
+
+  /// Serializes the frame header (and broadcast hash, if any) once; the
+  /// payload is never concatenated but handed to the kernel by reference
+  /// through writev.
+  static bytes BuildFrameHeader(const bytes& message, unsigned char start_byte,
+                                const bytes& msg_hash);
+  static bool SendFrameOnSocket(int cli_sock, const Peer& peer,
+                                const bytes& header, const bytes& message);
+  static bool SendFrameSocketCore(const Peer& peer, const bytes& header,
+                                  const bytes& message);
   static bool SendMessageSocketCore(const Peer& peer, const bytes& message,
                                     unsigned char start_byte,
                                     const bytes& msg_hash);
+  static void SendFrameCore(const Peer& peer, const bytes& header,
+                            const bytes& message);
+
+  /// Running total of payload bytes sent by reference instead of being
+  /// copied into a staging buffer (diagnostic).
+  static std::atomic<uint64_t> m_scatterGatherBytesSaved;
 
  public:
   Peer m_selfPeer;
@@ -56,6 +76,10 @@ class SendJob {
   static void SendMessageCore(const Peer& peer, const bytes& message,
                               unsigned char startbyte, const bytes& hash);
 
+  static uint64_t GetScatterGatherBytesSaved() {
+    return m_scatterGatherBytesSaved.load();
+  }
+
   virtual ~SendJob() {}
   virtual void DoSend() = 0;
 };
@@ -81,6 +105,16 @@ class P2PComm {
       std::pair<bytes, std::chrono::time_point<std::chrono::system_clock>>>
       m_broadcastToRemove;
   std::mutex m_broadcastToRemoveMutex;
+  // Payloads announced by hash only (lazy broadcast), kept until expiry so
+  // every announced peer can fetch the body once
+  std::map<bytes,
+           std::pair<bytes, std::chrono::time_point<std::chrono::system_clock>>>
+      m_lazyBroadcastStore;
+  // Announced hashes whose payload fetch is still in flight, so repeated
+  // announcements do not trigger repeated fetches
+  std::map<bytes, std::chrono::time_point<std::chrono::system_clock>>
+      m_lazyBroadcastPending;
+  std::mutex m_lazyBroadcastMutex;
   RumorManager m_rumorManager;
 
   const static uint32_t MAXPUMPMESSAGE = 128;
@@ -103,13 +137,37 @@ class P2PComm {
   static std::mutex m_mutexPeerConnectionCount;
   static std::map<uint128_t, uint16_t> m_peerConnectionCount;
 
-  ThreadPool m_SendPool{MAXSENDMESSAGE, "SendPool"};
+  ThreadPool m_SendPool{MAXSENDMESSAGE, "SendPool",
+                        NUMA_MESSAGE_THREADS_CPUS};
+  // Outbound priority lane: consensus-class messages are drained by their
+  // own thread and sent by a dedicated pool, so a state or block-range
+  // transfer occupying every SendPool worker cannot delay a consensus
+  // announcement behind megabytes of queued bulk writes.
+  ThreadPool m_SendPoolPriority{MAXSENDMESSAGE_PRIORITY, "SendPoolPrio",
+                                NUMA_MESSAGE_THREADS_CPUS};
 
   boost::lockfree::queue<SendJob*> m_sendQueue;
+  boost::lockfree::queue<SendJob*> m_sendQueuePriority;
   void ProcessSendJob(SendJob* job);
-
-  static void ProcessBroadCastMsg(bytes& message, const Peer& from);
-  static void ProcessGossipMsg(bytes& message, Peer& from);
+  void ProcessPrioritySendJob(SendJob* job);
+
+  /// Routes the job to the priority or the normal send queue based on the
+  /// registered predicate, taking ownership either way.
+  void QueueSendJob(SendJob* job);
+
+  // Zero-copy receive path: both parse headers in place on the evbuffer view
+  // and only copy out the payload that survives validation.
+  static void ProcessBroadCastMsg(const unsigned char* message, size_t len,
+                                  const Peer& from);
+  static void ProcessGossipMsg(const unsigned char* message, size_t len,
+                               Peer& from);
+  static void ProcessLazyBroadcastMsg(const unsigned char* message, Peer& from);
+
+  /// Stores the payload for later fetches and multicasts a hash-only
+  /// announcement instead of the payload itself.
+  template <class PeerContainer>
+  void SendLazyBroadcastAnnouncement(const PeerContainer& peers, bytes message,
+                                     const bytes& msgHash);
 
   static void EventCallback(struct bufferevent* bev, short events, void* ctx);
   static void ReadCallback(struct bufferevent* bev, void* ctx);
@@ -119,12 +177,37 @@ class P2PComm {
                                        void* arg);
   static void CloseAndFreeBufferEvent(struct bufferevent* bufev);
 
+  /// Hands one validated inbound message to the dispatcher, recording it to
+  /// the message trace first when ENABLE_MESSAGE_TRACE is set
+  static void DispatchMessage(std::pair<bytes, Peer>* raw_message);
+
+  /// Delivers a message the node addressed to itself straight into the
+  /// dispatcher, skipping the socket round trip and the header
+  /// serialize/parse; returns false when the fast path does not apply
+  /// (disabled, non-normal start byte, pump not started, or a remote peer)
+  bool DispatchLoopbackMessage(const Peer& peer, const bytes& message,
+                               const unsigned char& startByteType);
+
+  /// Multicast variant of the loopback fast path: dispatches our own copy
+  /// in-process and collects the remaining peers into remotePeers; returns
+  /// false (leaving remotePeers untouched) when the list does not include
+  /// this node
+  template <class PeerContainer>
+  bool FilterLoopbackPeer(const PeerContainer& peers,
+                          PeerContainer& remotePeers, const bytes& message,
+                          const unsigned char& startByteType);
+
  public:
   /// Returns the singleton P2PComm instance.
   static P2PComm& GetInstance();
 
   using Dispatcher = std::function<void(std::pair<bytes, Peer>*)>;
 
+  /// Classifies an application message as consensus-class; registered by the
+  /// application alongside the dispatcher, since the network layer does not
+  /// know the message-type table.
+  using PriorityPredicate = std::function<bool(const bytes&)>;
+
   using BroadcastListFunc = std::function<VectorOfPeer(
       unsigned char msg_type, unsigned char ins_type, const Peer&)>;
 
@@ -137,6 +220,7 @@ class P2PComm {
  private:
   using SocketCloser = std::unique_ptr<int, void (*)(int*)>;
   static Dispatcher m_dispatcher;
+  static PriorityPredicate m_prioritySendPredicate;
   static BroadcastListFunc m_broadcast_list_retriever;
 
  public:
@@ -146,28 +230,36 @@ class P2PComm {
                                struct sockaddr* cli_addr, int socklen,
                                void* arg);
 
-  /// Listens for incoming socket connections.
-  void StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher);
+  /// Listens for incoming socket connections. Messages for which
+  /// prioritySendPredicate returns true are sent through a dedicated
+  /// queue/pool pair ahead of bulk traffic.
+  void StartMessagePump(uint32_t listen_port_host, Dispatcher dispatcher,
+                        PriorityPredicate prioritySendPredicate = nullptr);
 
-  /// Multicasts message to specified list of peers.
-  void SendMessage(const VectorOfPeer& peers, const bytes& message,
+  /// Multicasts message to specified list of peers. The message is taken by
+  /// value so callers that are done with the buffer can std::move it into
+  /// the send queue instead of copying it.
+  void SendMessage(const VectorOfPeer& peers, bytes message,
                    const unsigned char& startByteType = START_BYTE_NORMAL);
 
   /// Multicasts message to specified list of peers.
-  void SendMessage(const std::deque<Peer>& peers, const bytes& message,
+  void SendMessage(const std::deque<Peer>& peers, bytes message,
                    const unsigned char& startByteType = START_BYTE_NORMAL,
                    const bool bAllowSendToRelaxedBlacklist = false);
 
   /// Sends normal message to specified peer.
-  void SendMessage(const Peer& peer, const bytes& message,
+  void SendMessage(const Peer& peer, bytes message,
                    const unsigned char& startByteType = START_BYTE_NORMAL);
 
   /// Multicasts message of type=broadcast to specified list of peers.
-  void SendBroadcastMessage(const VectorOfPeer& peers, const bytes& message);
+  /// Payloads of BROADCAST_LAZY_THRESHOLD_IN_BYTES or more are announced by
+  /// hash only; peers missing the payload fetch it once.
+  void SendBroadcastMessage(const VectorOfPeer& peers, bytes message);
 
   /// Multicasts message of type=broadcast to specified list of peers.
-  void SendBroadcastMessage(const std::deque<Peer>& peers,
-                            const bytes& message);
+  /// Payloads of BROADCAST_LAZY_THRESHOLD_IN_BYTES or more are announced by
+  /// hash only; peers missing the payload fetch it once.
+  void SendBroadcastMessage(const std::deque<Peer>& peers, bytes message);
 
   void RebroadcastMessage(const VectorOfPeer& peers, const bytes& message,
                           const bytes& msg_hash);
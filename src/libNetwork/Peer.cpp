@@ -51,12 +51,45 @@ bool Peer::operator<(const Peer& r) const {
           (m_listenPortHost < r.m_listenPortHost));
 }
 
-const string Peer::GetPrintableIPAddress() const {
+/// Process-wide interning table so each unique address is converted to its
+/// printable form once, no matter how many Peer copies refer to it. Logging
+/// in Blacklist/ReputationManager hits this on every message.
+static string InternPrintableIPAddress(const uint128_t& ipAddress) {
+  static mutex printableIPCacheMutex;
+  static map<uint128_t, string> printableIPCache;
+  // Guards against unbounded growth under sybil floods
+  static const unsigned int PRINTABLE_IP_CACHE_MAX_ENTRIES = 8192;
+
+  {
+    lock_guard<mutex> g(printableIPCacheMutex);
+    auto it = printableIPCache.find(ipAddress);
+    if (it != printableIPCache.end()) {
+      return it->second;
+    }
+  }
+
   char str[INET_ADDRSTRLEN];
   struct sockaddr_in serv_addr {};
-  serv_addr.sin_addr.s_addr = m_ipAddress.convert_to<unsigned long>();
+  serv_addr.sin_addr.s_addr = ipAddress.convert_to<unsigned long>();
   inet_ntop(AF_INET, &(serv_addr.sin_addr), str, INET_ADDRSTRLEN);
-  return string(str);
+  string printable(str);
+
+  {
+    lock_guard<mutex> g(printableIPCacheMutex);
+    if (printableIPCache.size() >= PRINTABLE_IP_CACHE_MAX_ENTRIES) {
+      printableIPCache.clear();
+    }
+    printableIPCache.emplace(ipAddress, printable);
+  }
+
+  return printable;
+}
+
+const string Peer::GetPrintableIPAddress() const {
+  if (m_printableIP.empty()) {
+    m_printableIP = InternPrintableIPAddress(m_ipAddress);
+  }
+  return m_printableIP;
 }
 
 unsigned int Peer::Serialize(bytes& dst, unsigned int offset) const {
@@ -72,6 +105,7 @@ int Peer::Deserialize(const bytes& src, unsigned int offset) {
     m_ipAddress = Serializable::GetNumber<uint128_t>(src, offset, UINT128_SIZE);
     m_listenPortHost = Serializable::GetNumber<uint32_t>(
         src, offset + UINT128_SIZE, sizeof(uint32_t));
+    m_printableIP.clear();  // cached form no longer matches
   } catch (const std::exception& e) {
     LOG_GENERAL(WARNING, "Error with Peer::Deserialize." << ' ' << e.what());
     return -1;
@@ -35,6 +35,9 @@ struct Peer : public Serializable {
   /// Peer hostname
   std::string m_hostname;  // optional
 
+  /// Lazily-filled printable form of m_ipAddress; not serialized.
+  mutable std::string m_printableIP;
+
   /// Default constructor.
   Peer();
 
@@ -17,6 +17,8 @@
 
 #include "ReputationManager.h"
 
+#include <algorithm>
+
 #include "Blacklist.h"
 #include "libUtils/IPConverter.h"
 #include "libUtils/Logger.h"
@@ -38,17 +40,30 @@ bool ReputationManager::IsNodeBanned(const uint128_t& IPAddress) {
 void ReputationManager::PunishNode(const uint128_t& IPAddress,
                                    int32_t Penalty) {
   UpdateReputation(IPAddress, Penalty);
-  if (!Blacklist::GetInstance().Exist(IPAddress) and IsNodeBanned(IPAddress)) {
-    LOG_GENERAL(INFO, "Node " << IPConverter::ToStrFromNumericalIP(IPAddress)
-                              << " banned.");
-    Blacklist::GetInstance().Add(IPAddress);
+  if (IsNodeBanned(IPAddress)) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutexReputations);
+      m_BannedIPs.emplace(IPAddress);
+    }
+    if (!Blacklist::GetInstance().Exist(IPAddress)) {
+      LOG_GENERAL(INFO, "Node " << IPConverter::ToStrFromNumericalIP(IPAddress)
+                                << " banned.");
+      Blacklist::GetInstance().Add(IPAddress);
+    }
   }
 }
 
 void ReputationManager::AwardAllNodes() {
-  std::vector<uint128_t> AllKnownIPs = GetAllKnownIP();
-  for (const auto& ip : AllKnownIPs) {
-    AwardNode(ip);
+  std::lock_guard<std::mutex> lock(m_mutexReputations);
+
+  // One counter bump awards every known node lazily; only the banned few are
+  // materialized now so they still get unbanned on schedule
+  m_awardRound++;
+
+  const std::vector<uint128_t> bannedIPs(m_BannedIPs.begin(),
+                                         m_BannedIPs.end());
+  for (const auto& ip : bannedIPs) {
+    MaterializeInternal(ip);
   }
 }
 
@@ -59,20 +74,26 @@ void ReputationManager::AddNodeIfNotKnown(const uint128_t& IPAddress) {
 
 void ReputationManager::AddNodeIfNotKnownInternal(const uint128_t& IPAddress) {
   if (m_Reputations.find(IPAddress) == m_Reputations.end()) {
-    m_Reputations.emplace(IPAddress, ScoreType::GOOD);
+    // A new node starts at GOOD as of the current round, so it does not
+    // retroactively collect earlier awards
+    RepEntry entry;
+    entry.m_round = m_awardRound;
+    m_Reputations.emplace(IPAddress, entry);
   }
 }
 
 int32_t ReputationManager::GetReputation(const uint128_t& IPAddress) {
   std::lock_guard<std::mutex> lock(m_mutexReputations);
   AddNodeIfNotKnownInternal(IPAddress);
-  return m_Reputations[IPAddress];
+  return MaterializeInternal(IPAddress);
 }
 
 void ReputationManager::Clear() {
   LOG_MARKER();
   std::lock_guard<std::mutex> lock(m_mutexReputations);
   m_Reputations.clear();
+  m_BannedIPs.clear();
+  m_awardRound = 0;
 }
 
 void ReputationManager::SetReputation(const uint128_t& IPAddress,
@@ -80,17 +101,21 @@ void ReputationManager::SetReputation(const uint128_t& IPAddress,
   std::lock_guard<std::mutex> lock(m_mutexReputations);
   AddNodeIfNotKnownInternal(IPAddress);
 
+  RepEntry& entry = m_Reputations[IPAddress];
+  // The new score supersedes any rounds still pending for this entry
+  entry.m_round = m_awardRound;
+
   if (ReputationScore > ScoreType::UPPERREPTHRESHOLD) {
     LOG_GENERAL(
         WARNING,
         "Reputation score too high. Exceed upper bound. ReputationScore: "
             << ReputationScore << ". Setting reputation to "
             << ScoreType::UPPERREPTHRESHOLD);
-    m_Reputations[IPAddress] = ScoreType::UPPERREPTHRESHOLD;
+    entry.m_score = ScoreType::UPPERREPTHRESHOLD;
     return;
   }
 
-  m_Reputations[IPAddress] = ReputationScore;
+  entry.m_score = ReputationScore;
 }
 
 void ReputationManager::UpdateReputation(const uint128_t& IPAddress,
@@ -113,22 +138,32 @@ void ReputationManager::UpdateReputation(const uint128_t& IPAddress,
   SetReputation(IPAddress, NewRep);
 }
 
-std::vector<uint128_t> ReputationManager::GetAllKnownIP() {
-  std::lock_guard<std::mutex> lock(m_mutexReputations);
+int32_t ReputationManager::MaterializeInternal(const uint128_t& IPAddress) {
+  RepEntry& entry = m_Reputations[IPAddress];
 
-  std::vector<uint128_t> AllKnownIPs;
-  for (const auto& node : m_Reputations) {
-    AllKnownIPs.emplace_back(node.first);
+  if (entry.m_round == m_awardRound) {
+    return entry.m_score;
   }
-  return AllKnownIPs;
-}
 
-void ReputationManager::AwardNode(const uint128_t& IPAddress) {
-  UpdateReputation(IPAddress, ScoreType::AWARD_FOR_GOOD_NODES);
-
-  if (Blacklist::GetInstance().Exist(IPAddress) && !IsNodeBanned(IPAddress)) {
-    LOG_GENERAL(INFO, "Node " << IPConverter::ToStrFromNumericalIP(IPAddress)
-                              << " unbanned.");
-    Blacklist::GetInstance().Remove(IPAddress);
+  const uint64_t rounds = m_awardRound - entry.m_round;
+  entry.m_round = m_awardRound;
+
+  // Awards are positive, so applying all pending rounds and capping once is
+  // the same as capping after every round
+  const int64_t newScore =
+      static_cast<int64_t>(entry.m_score) +
+      static_cast<int64_t>(rounds) * ScoreType::AWARD_FOR_GOOD_NODES;
+  entry.m_score = static_cast<int32_t>(
+      std::min<int64_t>(newScore, ScoreType::UPPERREPTHRESHOLD));
+
+  if (entry.m_score > ScoreType::REPTHRESHOLD) {
+    m_BannedIPs.erase(IPAddress);
+    if (Blacklist::GetInstance().Exist(IPAddress)) {
+      LOG_GENERAL(INFO, "Node " << IPConverter::ToStrFromNumericalIP(IPAddress)
+                                << " unbanned.");
+      Blacklist::GetInstance().Remove(IPAddress);
+    }
   }
+
+  return entry.m_score;
 }
@@ -24,6 +24,7 @@
 #include <functional>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class ReputationManager {
@@ -71,14 +72,28 @@ class ReputationManager {
   std::mutex m_mutexReputations;
 
  private:
-  std::unordered_map<uint128_t, int32_t, HashStr<uint128_t>> m_Reputations;
+  // Lazily awarded score: m_score is exact as of award round m_round, and
+  // the rounds elapsed since are applied when the entry is next touched, so
+  // AwardAllNodes never has to sweep the whole table
+  struct RepEntry {
+    int32_t m_score = ScoreType::GOOD;
+    uint64_t m_round = 0;
+  };
+
+  std::unordered_map<uint128_t, RepEntry, HashStr<uint128_t>> m_Reputations;
+  // IPs currently at or below the ban threshold; only these are eagerly
+  // materialized when a new award round starts, so nodes still get unbanned
+  // on schedule without touching every known peer
+  std::unordered_set<uint128_t, HashStr<uint128_t>> m_BannedIPs;
+  uint64_t m_awardRound = 0;
 
   void AddNodeIfNotKnownInternal(const uint128_t& IPAddress);
   void SetReputation(const uint128_t& IPAddress, const int32_t ReputationScore);
   void UpdateReputation(const uint128_t& IPAddress,
                         const int32_t ReputationScoreDelta);
-  std::vector<uint128_t> GetAllKnownIP();
-  void AwardNode(const uint128_t& IPAddress);
+  // Applies the award rounds elapsed since the entry was last touched and
+  // returns the up-to-date score (caller must hold m_mutexReputations)
+  int32_t MaterializeInternal(const uint128_t& IPAddress);
 };
 
 #endif  // ZILLIQA_SRC_LIBNETWORK_REPUTATIONMANAGER_H_
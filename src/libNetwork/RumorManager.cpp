@@ -17,7 +17,9 @@
 
 #include "RumorManager.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <string>
 #include <thread>
 
@@ -26,6 +28,7 @@
 #include "libCrypto/Sha2.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/HashUtils.h"
+#include "libUtils/RandomGenerator.h"
 
 namespace {
 RRS::Message::Type convertType(uint8_t type) {
@@ -68,6 +71,7 @@ void RumorManager::StartRounds() {
 
   std::thread([&]() {
     unsigned int rounds = 0;
+    unsigned int roundsSinceDigest = 0;
     while (true) {
       std::unique_lock<std::mutex> guard(m_continueRoundMutex);
       m_continueRound = true;
@@ -91,6 +95,10 @@ void RumorManager::StartRounds() {
           CleanUp();
           rounds = 0;
         }
+        if (++roundsSinceDigest >= GOSSIP_ANTI_ENTROPY_EVERY_N_ROUNDS) {
+          SendAntiEntropyDigest();
+          roundsSinceDigest = 0;
+        }
       }  // end critical section
       if (m_condStopRound.wait_for(guard,
                                    std::chrono::milliseconds(ROUND_TIME_IN_MS),
@@ -112,6 +120,70 @@ void RumorManager::StopRounds() {
   m_condStopRound.notify_all();
 }
 
+void RumorManager::HarvestConvergenceStats() {
+  const std::map<RRS::RumorHolder::StatisticKey, double>& stats =
+      m_rumorHolder->statistics();
+
+  auto converged =
+      stats.find(RRS::RumorHolder::StatisticKey::NumConvergedRumors);
+  if (converged == stats.end() || converged->second < 1) {
+    // Nothing reached quiescence last epoch - either no rumors ran or the
+    // network was unhealthy. Forget the learned estimate so the next holder
+    // runs at the full configured redundancy.
+    m_ewmaRoundsToQuiescence = 0;
+    return;
+  }
+
+  const double avgRounds =
+      stats.at(RRS::RumorHolder::StatisticKey::RoundsToQuiescence) /
+      converged->second;
+
+  if (m_ewmaRoundsToQuiescence <= 0) {
+    m_ewmaRoundsToQuiescence = avgRounds;
+  } else {
+    m_ewmaRoundsToQuiescence =
+        (ADAPTIVE_GOSSIP_EWMA_ALPHA_PERCENT * avgRounds +
+         (100 - ADAPTIVE_GOSSIP_EWMA_ALPHA_PERCENT) *
+             m_ewmaRoundsToQuiescence) /
+        100;
+  }
+
+  LOG_GENERAL(DEBUG, "Observed avg rounds-to-quiescence: "
+                         << avgRounds
+                         << ", EWMA: " << m_ewmaRoundsToQuiescence);
+}
+
+void RumorManager::TuneRoundLimits(int& maxRoundsInB, int& maxRoundsInC,
+                                   int& maxTotalRounds) const {
+  if (!ENABLE_ADAPTIVE_GOSSIP_ROUNDS || m_ewmaRoundsToQuiescence <= 0) {
+    return;
+  }
+
+  const int floorRounds = std::max(
+      1, (maxTotalRounds * (int)ADAPTIVE_GOSSIP_MIN_PERCENT) / 100);
+  int tunedTotal = (int)std::ceil(
+      (m_ewmaRoundsToQuiescence * ADAPTIVE_GOSSIP_MARGIN_PERCENT) / 100);
+  tunedTotal = std::max(floorRounds, std::min(maxTotalRounds, tunedTotal));
+
+  if (tunedTotal >= maxTotalRounds) {
+    return;
+  }
+
+  // Scale the per-state limits with the total so the B:C proportions of the
+  // configuration are preserved
+  const int tunedB = std::max(1, (maxRoundsInB * tunedTotal) / maxTotalRounds);
+  const int tunedC = std::max(1, (maxRoundsInC * tunedTotal) / maxTotalRounds);
+
+  LOG_GENERAL(INFO, "Tuned gossip round limits from ("
+                        << maxRoundsInB << "," << maxRoundsInC << ","
+                        << maxTotalRounds << ") to (" << tunedB << "," << tunedC
+                        << "," << tunedTotal << ")");
+
+  maxRoundsInB = tunedB;
+  maxRoundsInC = tunedC;
+  maxTotalRounds = tunedTotal;
+}
+
 // PUBLIC METHODS
 bool RumorManager::Initialize(const VectorOfNode& peers, const Peer& myself,
                               const PairOfKey& myKeys,
@@ -132,6 +204,9 @@ bool RumorManager::Initialize(const VectorOfNode& peers, const Peer& myself,
 
   if (m_rumorIdGenerator) {
     PrintStatistics();
+    if (ENABLE_ADAPTIVE_GOSSIP_ROUNDS && m_rumorHolder) {
+      HarvestConvergenceStats();
+    }
   }
 
   m_rumorIdGenerator = 0;
@@ -160,9 +235,26 @@ bool RumorManager::Initialize(const VectorOfNode& peers, const Peer& myself,
 
   // Now create the one and only RumorHolder
   if (GOSSIP_CUSTOM_ROUNDS_SETTINGS) {
+    int maxRoundsInB = MAX_ROUNDS_IN_BSTATE;
+    int maxRoundsInC = MAX_ROUNDS_IN_CSTATE;
+    int maxTotalRounds = MAX_TOTAL_ROUNDS;
+    TuneRoundLimits(maxRoundsInB, maxRoundsInC, maxTotalRounds);
+    m_rumorHolder.reset(new RRS::RumorHolder(m_peerIdSet, maxRoundsInB,
+                                             maxRoundsInC, maxTotalRounds,
+                                             MAX_NEIGHBORS_PER_ROUND, 0));
+  } else if (ENABLE_ADAPTIVE_GOSSIP_ROUNDS && !m_peerIdSet.empty()) {
+    // Start from the theory-derived limits for this network size, then
+    // apply the same bounded tuning
+    RRS::NetworkConfig conf(m_peerIdSet.size());
+    int maxRoundsInB = conf.maxRoundsInB();
+    int maxRoundsInC = conf.maxRoundsInC();
+    int maxTotalRounds = conf.maxRoundsTotal();
+    TuneRoundLimits(maxRoundsInB, maxRoundsInC, maxTotalRounds);
     m_rumorHolder.reset(new RRS::RumorHolder(
-        m_peerIdSet, MAX_ROUNDS_IN_BSTATE, MAX_ROUNDS_IN_CSTATE,
-        MAX_TOTAL_ROUNDS, MAX_NEIGHBORS_PER_ROUND, 0));
+        m_peerIdSet,
+        RRS::NetworkConfig(m_peerIdSet.size(), maxRoundsInB, maxRoundsInC,
+                           maxTotalRounds),
+        0));
   } else {
     m_rumorHolder.reset(new RRS::RumorHolder(m_peerIdSet, 0));
   }
@@ -419,6 +511,102 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::VerifyMessage(
 
 std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
     uint8_t type, int32_t round, const RawBytes& message, const Peer& from) {
+  if (GOSSIP_BATCH_MSGTYPE == type) {
+    // Unpack the batch envelope and process each length-prefixed entry as if
+    // it had arrived as its own gossip message. Entries are hash / control
+    // messages, so nothing gets dispatched from here.
+    unsigned int offset = 0;
+    while (offset + sizeof(uint32_t) < message.size()) {
+      const uint32_t entryLen = Serializable::GetNumber<uint32_t>(
+          message, offset, sizeof(uint32_t));
+      offset += sizeof(uint32_t);
+
+      // Each entry carries its own type, round and (redundant) sender port
+      const unsigned int entryHdrLen =
+          RRSMessageOffset::R_ROUNDS + 2 * sizeof(uint32_t);
+      if (entryLen < entryHdrLen || offset + entryLen > message.size()) {
+        LOG_GENERAL(WARNING, "Malformed gossip batch entry from " << from);
+        break;
+      }
+
+      const uint8_t entryType = message.at(offset);
+      const int32_t entryRound = Serializable::GetNumber<uint32_t>(
+          message, offset + RRSMessageOffset::R_ROUNDS, sizeof(uint32_t));
+      RawBytes entryMsg(message.begin() + offset + entryHdrLen,
+                        message.begin() + offset + entryLen);
+      offset += entryLen;
+
+      if (GOSSIP_BATCH_MSGTYPE == entryType) {
+        LOG_GENERAL(WARNING, "Nested gossip batch from " << from
+                                                         << " - ignoring");
+        continue;
+      }
+
+      RumorReceived(entryType, entryRound, entryMsg, from);
+    }
+    return {false, {}};
+  }
+
+  if (GOSSIP_DIGEST_MSGTYPE == type) {
+    {
+      std::lock_guard<std::mutex> guard(m_continueRoundMutex);
+      if (!m_continueRound) {
+        return {false, {}};
+      }
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    if (m_peerIdPeerBimap.right.find(from) == m_peerIdPeerBimap.right.end()) {
+      LOG_GENERAL(DEBUG, "Received digest from peer : "
+                             << from
+                             << " which does not exist in my peerlist.");
+      return {false, {}};
+    }
+
+    // Digests carry the same key+signature framing as the non-empty rumor
+    // messages, so verify them under the same setting
+    auto result = VerifyMessage(message, RRS::Message::Type::LAZY_PUSH, from);
+    if (!result.first) {
+      return {false, {}};
+    }
+    const RawBytes& digest = result.second;
+
+    if (digest.empty() || digest.size() % COMMON_HASH_SIZE != 0) {
+      LOG_GENERAL(WARNING, "Malformed anti-entropy digest from " << from);
+      return {false, {}};
+    }
+
+    for (unsigned int offset = 0; offset < digest.size();
+         offset += COMMON_HASH_SIZE) {
+      RawBytes hash(digest.begin() + offset,
+                    digest.begin() + offset + COMMON_HASH_SIZE);
+
+      if (m_rumorHashRawMsgBimap.left.find(hash) !=
+          m_rumorHashRawMsgBimap.left.end()) {
+        // already hold the payload
+        continue;
+      }
+
+      // Missing payload: make sure the hash has a rumor id, then ask the
+      // digest sender for the raw message, exactly as the LAZY_PUSH path
+      // does for a hash it has not seen before
+      int64_t rumorId;
+      auto it = m_rumorIdHashBimap.right.find(hash);
+      if (it == m_rumorIdHashBimap.right.end()) {
+        rumorId = ++m_rumorIdGenerator;
+        m_rumorIdHashBimap.insert(RumorIdRumorBimap::value_type(rumorId, hash));
+      } else {
+        rumorId = it->second;
+      }
+
+      RRS::Message pullMsg(RRS::Message::Type::PULL, rumorId, -1);
+      SendMessage(from, pullMsg);
+    }
+
+    return {false, {}};
+  }
+
   {
     std::lock_guard<std::mutex> guard(m_continueRoundMutex);
     if (!m_continueRound) {
@@ -591,9 +779,24 @@ void RumorManager::AppendKeyAndSignature(RawBytes& result,
 
 void RumorManager::SendMessage(const Peer& toPeer,
                                const RRS::Message& message) {
+  RawBytes cmd;
+  if (!BuildRumorMessage(message, cmd)) {
+    return;
+  }
+
+  // Send the message to peer .
+  if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
+  }
+  P2PComm::GetInstance().SendMessage(toPeer, cmd, START_BYTE_GOSSIP);
+}
+
+bool RumorManager::BuildRumorMessage(const RRS::Message& message,
+                                     RawBytes& cmd) {
   // Add round and type to outgoing message
   RRS::Message::Type t = message.type();
-  RawBytes cmd = {(unsigned char)t};
+  cmd = {(unsigned char)t};
   unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
 
   Serializable::SetNumber<uint32_t>(cmd, cur_offset, message.rounds(),
@@ -622,13 +825,12 @@ void RumorManager::SendMessage(const Peer& toPeer,
           cmd.insert(cmd.end(), it2->second.begin(), it2->second.end());
           std::string gossipHashStr;
           if (!DataConversion::Uint8VecToHexStr(it1->second, gossipHashStr)) {
-            return;
+            return false;
           }
-          LOG_GENERAL(INFO, "Sending [" << gossipHashStr.substr(0, 6) << "] to "
-                                        << toPeer);
+          LOG_GENERAL(INFO, "Sending [" << gossipHashStr.substr(0, 6) << "]");
         } else {
           // Nothing to send.
-          return;
+          return false;
         }
       } else if (RRS::Message::Type::LAZY_PUSH == t ||
                  RRS::Message::Type::LAZY_PULL == t ||
@@ -641,10 +843,9 @@ void RumorManager::SendMessage(const Peer& toPeer,
         // Add hash message to outgoing message for types
         // LAZY_PULL/LAZY_PUSH/PULL
         cmd.insert(cmd.end(), it1->second.begin(), it1->second.end());
-        LOG_GENERAL(DEBUG, "Sending Gossip Hash Message: "
-                               << message << " To Peer : " << toPeer);
+        LOG_GENERAL(DEBUG, "Built Gossip Hash Message: " << message);
       } else {
-        return;
+        return false;
       }
     }
   } else {  // EMPTY_PULL/ EMPTY_PUSH
@@ -657,19 +858,117 @@ void RumorManager::SendMessage(const Peer& toPeer,
     }
   }
 
-  // Send the message to peer .
-  if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
-  }
-  P2PComm::GetInstance().SendMessage(toPeer, cmd, START_BYTE_GOSSIP);
+  return true;
 }
 
 void RumorManager::SendMessages(const Peer& toPeer,
                                 const std::vector<RRS::Message>& messages) {
+  if (!GOSSIP_BATCH_MSGS || messages.size() < 2) {
+    for (auto& k : messages) {
+      SendMessage(toPeer, k);
+    }
+    return;
+  }
+
+  // Coalesce all rumor messages for this peer from the current round tick
+  // into batch envelopes, each entry length-prefixed, so the peer receives
+  // one framed+signed P2P message instead of one per rumor.
+  RawBytes batch;
+  auto initBatch = [this](RawBytes& b) {
+    b = {GOSSIP_BATCH_MSGTYPE};
+    unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
+    Serializable::SetNumber<uint32_t>(b, cur_offset, 0, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+    Serializable::SetNumber<uint32_t>(
+        b, cur_offset, m_selfPeer.m_listenPortHost, sizeof(uint32_t));
+  };
+  auto flushBatch = [&toPeer](RawBytes& b) {
+    if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
+    }
+    P2PComm::GetInstance().SendMessage(toPeer, b, START_BYTE_GOSSIP);
+  };
+
+  initBatch(batch);
+  unsigned int entries = 0;
+
   for (auto& k : messages) {
-    SendMessage(toPeer, k);
+    RawBytes cmd;
+    if (!BuildRumorMessage(k, cmd)) {
+      continue;
+    }
+
+    // Respect the receive-side size cap: flush and start a fresh envelope
+    // rather than growing past it.
+    if (entries > 0 && batch.size() + sizeof(uint32_t) + cmd.size() >=
+                           MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
+      flushBatch(batch);
+      initBatch(batch);
+      entries = 0;
+    }
+
+    Serializable::SetNumber<uint32_t>(batch, batch.size(), cmd.size(),
+                                      sizeof(uint32_t));
+    batch.insert(batch.end(), cmd.begin(), cmd.end());
+    entries++;
+  }
+
+  if (entries > 0) {
+    flushBatch(batch);
+  }
+}
+
+void RumorManager::SendAntiEntropyDigest() {
+  if (m_peerIdPeerBimap.empty() || m_rumorHashRawMsgBimap.empty()) {
+    return;
   }
+
+  // Pick one random peer for this exchange
+  auto peerIt = m_peerIdPeerBimap.left.begin();
+  std::advance(peerIt, RandomGenerator::GetRandomInt(
+                           static_cast<int>(m_peerIdPeerBimap.size())));
+  const Peer& toPeer = peerIt->second;
+
+  // The digest only covers hashes whose raw payload we hold, since those
+  // are the ones we can serve a PULL for; capped at the receive-side size
+  // limit
+  RawBytes digest;
+  for (const auto& entry : m_rumorHashRawMsgBimap.left) {
+    if (digest.size() + COMMON_HASH_SIZE + RRSMessageOffset::R_ROUNDS +
+            2 * sizeof(uint32_t) >
+        MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
+      break;
+    }
+    digest.insert(digest.end(), entry.first.begin(), entry.first.end());
+  }
+
+  if (digest.empty()) {
+    return;
+  }
+
+  RawBytes cmd = {GOSSIP_DIGEST_MSGTYPE};
+  unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
+  Serializable::SetNumber<uint32_t>(cmd, cur_offset, 0, sizeof(uint32_t));
+  cur_offset += sizeof(uint32_t);
+  Serializable::SetNumber<uint32_t>(
+      cmd, cur_offset, m_selfPeer.m_listenPortHost, sizeof(uint32_t));
+
+  if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
+    AppendKeyAndSignature(cmd, digest);
+  }
+
+  cmd.insert(cmd.end(), digest.begin(), digest.end());
+
+  LOG_GENERAL(DEBUG, "Sending anti-entropy digest of "
+                         << digest.size() / COMMON_HASH_SIZE << " hashes to "
+                         << toPeer);
+
+  if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
+  }
+  P2PComm::GetInstance().SendMessage(toPeer, cmd, START_BYTE_GOSSIP);
 }
 
 // PUBLIC CONST METHODS
@@ -37,6 +37,21 @@ enum RRSMessageOffset : unsigned int {
 
 const unsigned int RETRY_COUNT = 3;
 
+// Envelope type (outside the RRS::Message::Type range) used to coalesce all
+// rumor messages destined for the same peer in one round tick into a single
+// P2P message. Each entry is length-prefixed and is itself a complete
+// single-rumor gossip command.
+const unsigned char GOSSIP_BATCH_MSGTYPE = 0x0F;
+
+// Anti-entropy digest type (outside the RRS::Message::Type range). The body
+// is a concatenation of the 32-byte hashes of all raw rumor messages the
+// sender holds; the receiver PULLs any payload it is missing, so a node that
+// missed a rumor's push rounds recovers it in one extra round trip.
+const unsigned char GOSSIP_DIGEST_MSGTYPE = 0x10;
+
+// How many gossip round ticks between anti-entropy digests to one random peer
+const unsigned int GOSSIP_ANTI_ENTROPY_EVERY_N_ROUNDS = 8;
+
 class RumorManager {
  public:
   // TYPES
@@ -75,11 +90,33 @@ class RumorManager {
 
   int32_t m_rawMessageExpiryInMs{};
 
+  // EWMA (across epochs) of the average number of rounds a rumor needed to
+  // reach quiescence in the previous holders; 0 until the first epoch that
+  // retired at least one rumor, and reset to 0 whenever an epoch retires
+  // none so the next holder falls back to the configured round limits
+  double m_ewmaRoundsToQuiescence{};
+
+  // Fold the convergence statistics of the outgoing holder into
+  // m_ewmaRoundsToQuiescence; the caller must hold m_mutex
+  void HarvestConvergenceStats();
+
+  // Shrink the configured per-rumor round limits towards the observed
+  // rounds-to-quiescence (plus margin), clamped so they never exceed the
+  // configured values nor drop below ADAPTIVE_GOSSIP_MIN_PERCENT of them
+  void TuneRoundLimits(int& maxRoundsInB, int& maxRoundsInC,
+                       int& maxTotalRounds) const;
+
   void SendMessages(const Peer& toPeer,
                     const std::vector<RRS::Message>& messages);
 
   void SendMessage(const Peer& toPeer, const RRS::Message& message);
 
+  bool BuildRumorMessage(const RRS::Message& message, RawBytes& cmd);
+
+  // Send a digest of all held raw-rumor hashes to one random peer; the
+  // caller must hold m_mutex
+  void SendAntiEntropyDigest();
+
   RawBytes GenerateGossipForwardMessage(const RawBytes& message);
 
  public:
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SendSocketPool.h"
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+SendSocketPool::~SendSocketPool() { Clear(); }
+
+SendSocketPool& SendSocketPool::GetInstance() {
+  static SendSocketPool pool;
+  return pool;
+}
+
+/// Cheap liveness probe: a zero-byte result on a non-blocking peek means the
+/// remote end has closed the connection.
+static bool IsSocketAlive(int fd) {
+  char byte;
+  const ssize_t n = recv(fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n == 0) {
+    return false;
+  }
+  return n > 0 || errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+void SendSocketPool::PruneIdleSockets() {
+  const auto deadline =
+      chrono::steady_clock::now() -
+      chrono::seconds(SENDSOCKETPOOL_IDLE_TIMEOUT_IN_SECONDS);
+
+  for (auto it = m_sockets.begin(); it != m_sockets.end();) {
+    if (it->second.lastUsed < deadline) {
+      close(it->second.fd);
+      it = m_sockets.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int SendSocketPool::Acquire(const Peer& peer) {
+  const PoolKey key{peer.m_ipAddress, peer.m_listenPortHost};
+
+  lock_guard<mutex> guard(m_mutexSockets);
+
+  const auto it = m_sockets.find(key);
+  if (it == m_sockets.end()) {
+    return -1;
+  }
+
+  const int fd = it->second.fd;
+  m_sockets.erase(it);
+
+  if (!IsSocketAlive(fd)) {
+    LOG_GENERAL(DEBUG, "Pooled socket to " << peer << " went stale");
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+void SendSocketPool::Release(const Peer& peer, int cli_sock) {
+  const PoolKey key{peer.m_ipAddress, peer.m_listenPortHost};
+
+  lock_guard<mutex> guard(m_mutexSockets);
+
+  PruneIdleSockets();
+
+  if (m_sockets.size() >= SENDSOCKETPOOL_MAX_SOCKETS) {
+    close(cli_sock);
+    return;
+  }
+
+  auto& slot = m_sockets[key];
+  if (slot.fd >= 0 && slot.fd != cli_sock) {
+    // A concurrent sender already parked a connection for this peer
+    close(slot.fd);
+  }
+  slot.fd = cli_sock;
+  slot.lastUsed = chrono::steady_clock::now();
+}
+
+void SendSocketPool::Clear() {
+  lock_guard<mutex> guard(m_mutexSockets);
+  for (const auto& entry : m_sockets) {
+    close(entry.second.fd);
+  }
+  m_sockets.clear();
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBNETWORK_SENDSOCKETPOOL_H_
+#define ZILLIQA_SRC_LIBNETWORK_SENDSOCKETPOOL_H_
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "Peer.h"
+#include "common/BaseType.h"
+
+/// Keyed pool of persistent outbound sockets, so that repeated sends to the
+/// same peer reuse one TCP connection instead of paying a connect/teardown
+/// cycle (and the resulting TIME_WAIT pressure) per message.
+class SendSocketPool {
+  SendSocketPool() = default;
+  ~SendSocketPool();
+
+  // Singleton should not implement these
+  SendSocketPool(SendSocketPool const&) = delete;
+  void operator=(SendSocketPool const&) = delete;
+
+  using PoolKey = std::pair<uint128_t, uint32_t>;  // IP <-> listen port
+
+  struct PooledSocket {
+    int fd = -1;
+    std::chrono::time_point<std::chrono::steady_clock> lastUsed;
+  };
+
+  std::mutex m_mutexSockets;
+  std::map<PoolKey, PooledSocket> m_sockets;
+
+  /// Closes entries unused for longer than the configured idle timeout.
+  /// Caller must hold m_mutexSockets.
+  void PruneIdleSockets();
+
+ public:
+  static SendSocketPool& GetInstance();
+
+  /// Takes a healthy pooled socket for the peer out of the pool, or returns
+  /// -1 if none is available. Dead sockets found are closed on the spot.
+  int Acquire(const Peer& peer);
+
+  /// Returns a socket to the pool after a fully successful send. If the pool
+  /// is at capacity, the socket is closed instead.
+  void Release(const Peer& peer, int cli_sock);
+
+  /// Closes all pooled sockets.
+  void Clear();
+};
+
+#endif  // ZILLIQA_SRC_LIBNETWORK_SENDSOCKETPOOL_H_
@@ -30,6 +30,7 @@
 #include "libUtils/BitVector.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/IOPriority.h"
 #include "libUtils/Logger.h"
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/TimeUtils.h"
@@ -289,6 +290,7 @@ bool Node::ProcessFallbackBlock(const bytes& message, unsigned int cur_offset,
     }
 
     auto writeStateToDisk = [this]() mutable -> void {
+      IOPriority::LowerCurrentThread("writeStateToDisk");
       if (!AccountStore::GetInstance().MoveUpdatesToDisk()) {
         LOG_GENERAL(WARNING, "MoveUpdatesToDisk failed, what to do?");
         return;
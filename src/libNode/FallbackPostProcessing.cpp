@@ -29,6 +29,7 @@
 #include "libUtils/BitVector.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/IOPriority.h"
 #include "libUtils/Logger.h"
 
 using namespace std;
@@ -194,6 +195,7 @@ void Node::ProcessFallbackConsensusWhenDone() {
     AccountStore::GetInstance().InitTemp();
 
     auto writeStateToDisk = [this]() mutable -> void {
+      IOPriority::LowerCurrentThread("writeStateToDisk");
       if (!AccountStore::GetInstance().MoveUpdatesToDisk()) {
         LOG_GENERAL(WARNING, "MoveUpdatesToDisk failed, what to do?");
         return;
@@ -254,6 +256,40 @@ bool Node::ProcessFallbackConsensus(const bytes& message, unsigned int offset,
 
   LOG_MARKER();
 
+  // Deserialize and verify the signature on the dispatcher thread, before
+  // any consensus lock or condition variable wait, so a storm of malformed
+  // or unsigned messages never stalls the consensus state machine behind
+  // m_mutexConsensus
+  std::shared_ptr<ConsensusCommon> consensusObject;
+  {
+    lock_guard<mutex> g(m_mutexConsensus);
+    consensusObject = m_consensusObject;
+  }
+
+  if (consensusObject == nullptr) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "m_consensusObject is a nullptr. It has not been initialized.");
+    return false;
+  }
+
+  uint32_t unused_consensus_id = 0;
+  bytes unused_reserialized_message;
+  PubKey senderPubKey;
+
+  if (!consensusObject->PreProcessMessage(message, offset, unused_consensus_id,
+                                          senderPubKey,
+                                          unused_reserialized_message)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "PreProcessMessage failed");
+    return false;
+  }
+
+  if (!IsShardNode(senderPubKey)) {
+    LOG_EPOCH(WARNING, m_mediator.m_currentEpochNum,
+              "ProcessFallbackConsensus signed by non shard member");
+    return false;
+  }
+
   {
     lock_guard<mutex> g(m_mutexConsensus);
 
@@ -46,7 +46,10 @@
 #include "libUtils/BitVector.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EpochPhaseTracker.h"
+#include "libUtils/EpochWatchdog.h"
 #include "libUtils/HashUtils.h"
+#include "libUtils/IOPriority.h"
 #include "libUtils/Logger.h"
 #include "libUtils/RootComputation.h"
 #include "libUtils/SanityChecks.h"
@@ -122,11 +125,7 @@ bool Node::LoadUnavailableMicroBlockHashes(const TxBlock& finalBlock,
           !(info.m_shardId == m_mediator.m_ds->m_shards.size() &&
             info.m_txnRootHash == TxnHash())) {
         auto& mbs = m_unavailableMicroBlocks[blockNum];
-        if (std::find_if(mbs.begin(), mbs.end(),
-                         [info](const std::pair<BlockHash, TxnHash>& e) {
-                           return e.first == info.m_microBlockHash;
-                         }) == mbs.end()) {
-          mbs.push_back({info.m_microBlockHash, info.m_txnRootHash});
+        if (mbs.emplace(info.m_microBlockHash, info.m_txnRootHash).second) {
           LOG_GENERAL(
               INFO,
               "[TxBlk:" << blockNum << "] Add unavailable block [MbBlockHash] "
@@ -186,39 +185,26 @@ bool Node::LoadUnavailableMicroBlockHashes(const TxBlock& finalBlock,
 
 bool Node::RemoveTxRootHashFromUnavailableMicroBlock(
     const MBnForwardedTxnEntry& entry) {
-  for (auto it = m_unavailableMicroBlocks
-                     .at(entry.m_microBlock.GetHeader().GetEpochNum())
-                     .begin();
-       it !=
-       m_unavailableMicroBlocks.at(entry.m_microBlock.GetHeader().GetEpochNum())
-           .end();
-       it++) {
-    if (it->first == entry.m_microBlock.GetBlockHash()) {
-      TxnHash txnHash = ComputeRoot(entry.m_transactions);
-      if (it->second != txnHash) {
-        LOG_CHECK_FAIL("Txn root hash", txnHash, it->second);
-        return false;
-      }
+  auto& mbs =
+      m_unavailableMicroBlocks.at(entry.m_microBlock.GetHeader().GetEpochNum());
 
-      LOG_GENERAL(INFO, "MB found" << it->first);
-      LOG_GENERAL(INFO,
-                  "Count before = "
-                      << m_unavailableMicroBlocks
-                             .at(entry.m_microBlock.GetHeader().GetEpochNum())
-                             .size());
-      m_unavailableMicroBlocks.at(entry.m_microBlock.GetHeader().GetEpochNum())
-          .erase(it);
-      LOG_GENERAL(INFO,
-                  "Count after  = "
-                      << m_unavailableMicroBlocks
-                             .at(entry.m_microBlock.GetHeader().GetEpochNum())
-                             .size());
-      return true;
-    }
+  auto it = mbs.find(entry.m_microBlock.GetBlockHash());
+  if (it == mbs.end()) {
+    LOG_GENERAL(WARNING, "MB not found = " << entry);
+    return false;
   }
 
-  LOG_GENERAL(WARNING, "MB not found = " << entry);
-  return false;
+  TxnHash txnHash = ComputeRoot(entry.m_transactions);
+  if (it->second != txnHash) {
+    LOG_CHECK_FAIL("Txn root hash", txnHash, it->second);
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "MB found" << it->first);
+  LOG_GENERAL(INFO, "Count before = " << mbs.size());
+  mbs.erase(it);
+  LOG_GENERAL(INFO, "Count after  = " << mbs.size());
+  return true;
 }
 
 bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
@@ -233,21 +219,25 @@ bool Node::VerifyFinalBlockCoSignature(const TxBlock& txblock) {
     return false;
   }
 
+  // popcount the bitmap before touching any keys, so an invalid cosig is
+  // rejected without extracting hundreds of pubkeys
+  count = BitVector::CountSetBits(B2);
+
+  if (count != ConsensusCommon::NumForConsensus(B2.size())) {
+    LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
+    return false;
+  }
+
   // Generate the aggregated key
   vector<PubKey> keys;
+  keys.reserve(count);
   for (auto const& kv : *m_mediator.m_DSCommittee) {
-    if (B2.at(index)) {
+    if (B2[index]) {
       keys.emplace_back(kv.first);
-      count++;
     }
     index++;
   }
 
-  if (count != ConsensusCommon::NumForConsensus(B2.size())) {
-    LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
-    return false;
-  }
-
   shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
@@ -534,7 +524,18 @@ void Node::PrepareGoodStateForFinalBlock() {
 bool Node::ProcessFinalBlock(const bytes& message, unsigned int offset,
                              [[gnu::unused]] const Peer& from) {
   LOG_MARKER();
-  return ProcessFinalBlockCore(message, offset, from);
+  const uint64_t epochNum = m_mediator.m_currentEpochNum;
+  bool ret;
+  {
+    EpochPhaseTracker::Scope span("ProcessFinalBlock", epochNum);
+    ret = ProcessFinalBlockCore(message, offset, from);
+  }
+  if (ret) {
+    // the span above has been recorded by now, so the watchdog sees the
+    // complete set of phases for this epoch
+    EpochWatchdog::GetInstance().EpochCompleted(epochNum);
+  }
+  return ret;
 }
 
 bool Node::ProcessFinalBlockCore(const bytes& message, unsigned int offset,
@@ -827,6 +828,8 @@ bool Node::ProcessFinalBlockCore(const bytes& message, unsigned int offset,
       return false;
     }
     auto writeStateToDisk = [this]() -> void {
+      // let the API read path go first at the device while this burst runs
+      IOPriority::LowerCurrentThread("writeStateToDisk");
       if (!AccountStore::GetInstance().MoveUpdatesToDisk()) {
         LOG_GENERAL(WARNING, "MoveUpdatesToDisk failed, what to do?");
         // return false;
@@ -1012,6 +1015,10 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
               << "BGN")
   }
 
+  std::unordered_map<dev::h256, bytes> serializedTxBodies;
+  std::unordered_map<dev::h256, bytes> serializedTxnReceipts;
+  std::map<std::string, std::vector<std::string>> addrToTxnHashes;
+
   for (const auto& twr : entry.m_transactions) {
     LOG_GENERAL(INFO, "Commit txn " << twr.GetTransaction().GetTranID().hex());
     if (LOOKUP_NODE_MODE) {
@@ -1023,16 +1030,44 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
       WebsocketServer::GetInstance().ParseTxn(twr);
     }
 
-    // Store TxBody to disk
     bytes serializedTxBody;
     twr.Serialize(serializedTxBody, 0);
-    if (!BlockStorage::GetBlockStorage().PutTxBody(
-            twr.GetTransaction().GetTranID(), serializedTxBody)) {
-      LOG_GENERAL(WARNING, "BlockStorage::PutTxBody failed "
-                               << twr.GetTransaction().GetTranID());
-      return;
+    serializedTxBodies.emplace(twr.GetTransaction().GetTranID(),
+                               std::move(serializedTxBody));
+
+    bytes serializedTxnReceipt;
+    twr.GetTransactionReceipt().Serialize(serializedTxnReceipt, 0);
+    serializedTxnReceipts.emplace(twr.GetTransaction().GetTranID(),
+                                  std::move(serializedTxnReceipt));
+
+    // feed the address -> txn history index from both ends of the transfer
+    if (ENABLE_ADDRESS_INDEX) {
+      const std::string txnHash = twr.GetTransaction().GetTranID().hex();
+      addrToTxnHashes[twr.GetTransaction().GetSenderAddr().hex()].push_back(
+          txnHash);
+      addrToTxnHashes[twr.GetTransaction().GetToAddr().hex()].push_back(
+          txnHash);
     }
   }
+
+  if (ENABLE_ADDRESS_INDEX &&
+      !BlockStorage::GetBlockStorage().PutTxnAddressIndex(
+          entry.m_microBlock.GetHeader().GetEpochNum(), addrToTxnHashes)) {
+    LOG_GENERAL(WARNING, "BlockStorage::PutTxnAddressIndex failed");
+  }
+
+  // Populate the receipt-only column so receipt readers do not have to
+  // deserialize the full txn body
+  if (!BlockStorage::GetBlockStorage().PutTxnReceipts(serializedTxnReceipts)) {
+    LOG_GENERAL(WARNING, "BlockStorage::PutTxnReceipts failed");
+  }
+
+  // Store the TxBodies to disk in one batched write per DB instead of one
+  // standalone write per txn
+  if (!BlockStorage::GetBlockStorage().PutTxBodies(serializedTxBodies)) {
+    LOG_GENERAL(WARNING, "BlockStorage::PutTxBodies failed");
+    return;
+  }
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
             "Proceessed " << entry.m_transactions.size() << " of txns.");
   if (LOG_PARAMETERS) {
@@ -1107,6 +1142,24 @@ bool Node::ProcessMBnForwardTransaction(const bytes& message,
   }
 #endif  // SJ_TEST_SJ_MISSING_MBTXNS
 
+  // Cheap duplicate check before any protobuf work: the same packet can
+  // arrive via the DS broadcast and the lookup forwarding path, and hashing
+  // the raw payload costs a fraction of deserializing it and recomputing
+  // the txn / receipt roots. Only accepted packets are recorded, so a copy
+  // that failed transiently still gets retried
+  SHA2<HashType::HASH_VARIANT_256> sha2;
+  sha2.Update(message, cur_offset, message.size() - cur_offset);
+  const dev::h256 payloadHash(sha2.Finalize());
+  {
+    lock_guard<mutex> g(m_mutexMBnForwardedSeen);
+    if (m_mbnForwardedSeenCache.count(payloadHash) > 0) {
+      ++m_mbnForwardedDupCount;
+      LOG_GENERAL(INFO, "Skipped duplicate MB & TXN BODIES packet ("
+                            << m_mbnForwardedDupCount << " dups so far)");
+      return true;
+    }
+  }
+
   MBnForwardedTxnEntry entry;
 
   if (!Messenger::GetNodeMBnForwardTransaction(message, cur_offset, entry)) {
@@ -1181,10 +1234,30 @@ bool Node::ProcessMBnForwardTransaction(const bytes& message,
                           << " shard "
                           << entry.m_microBlock.GetHeader().GetShardId());
 
+    MarkMBnForwardPacketSeen(payloadHash);
     return true;
   }
 
-  return ProcessMBnForwardTransactionCore(entry);
+  if (!ProcessMBnForwardTransactionCore(entry)) {
+    return false;
+  }
+
+  MarkMBnForwardPacketSeen(payloadHash);
+  return true;
+}
+
+void Node::MarkMBnForwardPacketSeen(const dev::h256& payloadHash) {
+  lock_guard<mutex> g(m_mutexMBnForwardedSeen);
+
+  if (!m_mbnForwardedSeenCache.insert(payloadHash).second) {
+    return;
+  }
+
+  m_mbnForwardedSeenOrder.push_back(payloadHash);
+  while (m_mbnForwardedSeenOrder.size() > MBNFORWARD_SEEN_MAX_ENTRIES) {
+    m_mbnForwardedSeenCache.erase(m_mbnForwardedSeenOrder.front());
+    m_mbnForwardedSeenOrder.pop_front();
+  }
 }
 
 bool Node::AddPendingTxn(const HashCodeMap& pendingTxns, const PubKey& pubkey,
@@ -1213,10 +1286,9 @@ bool Node::AddPendingTxn(const HashCodeMap& pendingTxns, const PubKey& pubkey,
     }
   }
 
-  unique_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
   for (const auto& entry : pendingTxns) {
     LOG_GENERAL(INFO, " " << entry.first << " " << entry.second);
-    m_unconfirmedTxns.emplace(entry);
+    AddToUnconfirmedTxns(entry.first, entry.second);
   }
   return true;
 }
@@ -1235,11 +1307,19 @@ bool Node::SendPendingTxnToLookup() {
   const auto& blocknum =
       m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
 
+  // report the pool occupancy alongside, so the lookup can size the next
+  // txn packet to what this shard can actually absorb
+  uint32_t poolSize = 0;
+  {
+    lock_guard<mutex> g(m_mutexCreatedTransactions);
+    poolSize = m_createdTxns.size();
+  }
+
   bytes pend_txns_message = {MessageType::NODE,
                              NodeInstructionType::PENDINGTXN};
   if (!Messenger::SetNodePendingTxn(pend_txns_message, MessageOffset::BODY,
                                     blocknum, pendingTxns, m_myshardId,
-                                    m_mediator.m_selfKey)) {
+                                    poolSize, m_mediator.m_selfKey)) {
     LOG_GENERAL(WARNING, "Failed to set SetNodePendingTxn");
     return false;
   }
@@ -1260,9 +1340,10 @@ bool Node::ProcessPendingTxn(const bytes& message, unsigned int cur_offset,
   unordered_map<TxnHash, PoolTxnStatus> hashCodeMap;
   uint32_t shardId;
   PubKey pubkey;
+  uint32_t poolSize;
 
   if (!Messenger::GetNodePendingTxn(message, cur_offset, epochNum, hashCodeMap,
-                                    shardId, pubkey)) {
+                                    shardId, pubkey, poolSize)) {
     LOG_GENERAL(WARNING, "Failed to set GetNodePendingTxn");
     return false;
   }
@@ -1285,7 +1366,10 @@ bool Node::ProcessPendingTxn(const bytes& message, unsigned int cur_offset,
   }
   LOG_GENERAL(INFO, "Recieved message for epoch " << epochNum << " and shard "
                                                   << shardId);
-  AddPendingTxn(hashCodeMap, pubkey, shardId);
+  if (AddPendingTxn(hashCodeMap, pubkey, shardId)) {
+    // sender verified against the shard by AddPendingTxn
+    m_mediator.m_lookup->UpdateShardTxnBacklog(shardId, epochNum, poolSize);
+  }
 
   return true;
 }
@@ -1391,6 +1475,11 @@ bool Node::ProcessMBnForwardTransactionCore(const MBnForwardedTxnEntry& entry) {
         WebsocketServer::GetInstance().PrepareTxBlockAndTxHashes(
             JSONConversion::convertTxBlocktoJson(txBlock), j_txnhashes);
 
+        // distribute the block's event log index to subscribers and persist
+        // it for historical queries
+        WebsocketServer::GetInstance().FinalizeEventLogIndex(
+            txBlock.GetHeader().GetBlockNum());
+
         // send event logs
         WebsocketServer::GetInstance().SendOutMessages();
       }
@@ -278,7 +278,7 @@ void Node::ProcessTransactionWhenShardLeader(
   lock_guard<mutex> g(m_mutexCreatedTransactions);
 
   t_createdTxns = m_createdTxns;
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
+  NonceGapBuffer t_addrNonceTxnMap;
   t_processedTransactions.clear();
   m_TxnOrder.clear();
 
@@ -299,28 +299,21 @@ void Node::ProcessTransactionWhenShardLeader(
   this_thread::sleep_for(chrono::milliseconds(100));
 
   auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap) -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
+      [](Transaction& t, NonceGapBuffer& t_addrNonceTxnMap) -> bool {
+    return t_addrNonceTxnMap.findReady(t, [](const Address& addr) {
+      return AccountStore::GetInstance().GetNonceTemp(addr) + 1;
+    });
   };
 
-  auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
+  auto appendOne = [this, &t_addrNonceTxnMap](const Transaction& t,
+                                              const TransactionReceipt& tr) {
     t_processedTransactions.insert(
         make_pair(t.GetTranID(), TransactionWithReceipt(t, tr)));
     m_TxnOrder.push_back(t.GetTranID());
+    // the sender's next buffered txn (if any) may be processable now
+    t_addrNonceTxnMap.markReady(
+        t.GetSenderAddr(),
+        AccountStore::GetInstance().GetNonceTemp(t.GetSenderAddr()) + 1);
   };
 
   m_gasUsedTotal = 0;
@@ -387,19 +380,7 @@ void Node::ProcessTransactionWhenShardLeader(
         //                     << " nonce: "
         //                     <<
         //                     AccountStore::GetInstance().GetNonceTemp(senderAddr));
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(t.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (t.GetGasPrice() > it2->second.GetGasPrice()) {
-              it2->second = t;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({t.GetNonce(), t});
+        t_addrNonceTxnMap.insert(senderAddr, t);
       }
       // if nonce too small, ignore it
       else if (t.GetNonce() <
@@ -450,7 +431,7 @@ void Node::ProcessTransactionWhenShardLeader(
     SaveTxnsToS3(t_processedTransactions);
   }
   // Put txns in map back into pool
-  ReinstateMemPool(t_addrNonceTxnMap, gasLimitExceededTxnBuffer);
+  ReinstateMemPool(t_addrNonceTxnMap.AddrNonceIndex, gasLimitExceededTxnBuffer);
 
   if (LOG_PARAMETERS) {
     double elaspedTimeMs =
@@ -543,9 +524,10 @@ void Node::ProcessTransactionWhenShardBackup(
 
   lock_guard<mutex> g(m_mutexCreatedTransactions);
 
+  m_prestagedHashesValid = false;
   t_createdTxns = m_createdTxns;
   m_expectedTranOrdering.clear();
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
+  NonceGapBuffer t_addrNonceTxnMap;
   t_processedTransactions.clear();
 
   if (LOG_PARAMETERS) {
@@ -565,29 +547,21 @@ void Node::ProcessTransactionWhenShardBackup(
   this_thread::sleep_for(chrono::milliseconds(100));
 
   auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         std::map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap)
-      -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
+      [](Transaction& t, NonceGapBuffer& t_addrNonceTxnMap) -> bool {
+    return t_addrNonceTxnMap.findReady(t, [](const Address& addr) {
+      return AccountStore::GetInstance().GetNonceTemp(addr) + 1;
+    });
   };
 
-  auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
+  auto appendOne = [this, &t_addrNonceTxnMap](const Transaction& t,
+                                              const TransactionReceipt& tr) {
     m_expectedTranOrdering.emplace_back(t.GetTranID());
     t_processedTransactions.insert(
         make_pair(t.GetTranID(), TransactionWithReceipt(t, tr)));
+    // the sender's next buffered txn (if any) may be processable now
+    t_addrNonceTxnMap.markReady(
+        t.GetSenderAddr(),
+        AccountStore::GetInstance().GetNonceTemp(t.GetSenderAddr()) + 1);
   };
 
   m_gasUsedTotal = 0;
@@ -645,19 +619,7 @@ void Node::ProcessTransactionWhenShardBackup(
       // t_addrNonceTxnMap
       if (t.GetNonce() >
           AccountStore::GetInstance().GetNonceTemp(senderAddr) + 1) {
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(t.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (t.GetGasPrice() > it2->second.GetGasPrice()) {
-              it2->second = t;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({t.GetNonce(), t});
+        t_addrNonceTxnMap.insert(senderAddr, t);
       }
       // if nonce too small, ignore it
       else if (t.GetNonce() <
@@ -697,11 +659,20 @@ void Node::ProcessTransactionWhenShardBackup(
   AccountStore::GetInstance().ProcessStorageRootUpdateBufferTemp();
   AccountStore::GetInstance().CleanNewLibrariesCacheTemp();
 
+  // Pre-stage the roots the announcement checks would otherwise recompute,
+  // so a proposal matching this ordering validates by hash comparison alone
+  m_prestagedTranHashes = m_expectedTranOrdering;
+  m_prestagedTxRootHash = ComputeRoot(m_prestagedTranHashes);
+  m_prestagedHashesValid =
+      TransactionWithReceipt::ComputeTransactionReceiptsHash(
+          m_prestagedTranHashes, t_processedTransactions,
+          m_prestagedTranReceiptHash);
+
   cv_TxnProcFinished.notify_all();
 
   PutTxnsInTempDataBase(t_processedTransactions);
 
-  ReinstateMemPool(t_addrNonceTxnMap, gasLimitExceededTxnBuffer);
+  ReinstateMemPool(t_addrNonceTxnMap.AddrNonceIndex, gasLimitExceededTxnBuffer);
 
   if (LOG_PARAMETERS) {
     double elaspedTimeMs =
@@ -772,64 +743,76 @@ std::string Node::GetAwsS3CpString(const std::string& uploadFilePath) {
   return ossS3Cmd.str();
 }
 
+void Node::AddToUnconfirmedTxns(const TxnHash& txhash,
+                                const PoolTxnStatus status) {
+  auto& shard = GetUnconfirmedTxnShard(txhash);
+  unique_lock<shared_timed_mutex> g(shard.m_mutex);
+  shard.m_txns.emplace(txhash, status);
+}
+
 void Node::ReinstateMemPool(
     const map<Address, map<uint64_t, Transaction>>& addrNonceTxnMap,
     const vector<Transaction>& gasLimitExceededTxnBuffer) {
-  unique_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
-
   // Put remaining txns back in pool
   for (const auto& kv : addrNonceTxnMap) {
     for (const auto& nonceTxn : kv.second) {
       t_createdTxns.insert(nonceTxn.second);
-      m_unconfirmedTxns.emplace(nonceTxn.second.GetTranID(),
-                                PoolTxnStatus::PRESENT_NONCE_HIGH);
+      AddToUnconfirmedTxns(nonceTxn.second.GetTranID(),
+                           PoolTxnStatus::PRESENT_NONCE_HIGH);
     }
   }
 
   for (const auto& t : gasLimitExceededTxnBuffer) {
     t_createdTxns.insert(t);
     LOG_GENERAL(INFO, "PendingAPI " << t.GetTranID());
-    m_unconfirmedTxns.emplace(t.GetTranID(),
-                              PoolTxnStatus::PRESENT_GAS_EXCEEDED);
+    AddToUnconfirmedTxns(t.GetTranID(), PoolTxnStatus::PRESENT_GAS_EXCEEDED);
   }
 }
 
 void Node::PutProcessedInUnconfirmedTxns() {
-  unique_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
-
   uint count = 0;
 
   for (const auto& t : t_processedTransactions) {
-    m_unconfirmedTxns.emplace(
-        t.first, PoolTxnStatus::PRESENT_VALID_CONSENSUS_NOT_REACHED);
+    AddToUnconfirmedTxns(t.first,
+                         PoolTxnStatus::PRESENT_VALID_CONSENSUS_NOT_REACHED);
     count++;
   }
   LOG_GENERAL(INFO, "Count of txns " << count);
 }
 
 PoolTxnStatus Node::IsTxnInMemPool(const TxnHash& txhash) const {
-  shared_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex, defer_lock);
+  const auto& shard = GetUnconfirmedTxnShard(txhash);
+  shared_lock<shared_timed_mutex> g(shard.m_mutex, defer_lock);
   // Try to lock for 100 ms
   if (!g.try_lock_for(chrono::milliseconds(100))) {
     return PoolTxnStatus::ERROR;
   }
-  const auto res = m_unconfirmedTxns.find(txhash);
-  if (res == m_unconfirmedTxns.end()) {
+  const auto res = shard.m_txns.find(txhash);
+  if (res == shard.m_txns.end()) {
     return PoolTxnStatus::NOT_PRESENT;
   }
   return res->second;
 }
 
 unordered_map<TxnHash, PoolTxnStatus> Node::GetUnconfirmedTxns() const {
-  shared_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
-
-  return m_unconfirmedTxns;
+  // Shards are snapshotted one at a time; entries added concurrently to an
+  // already-copied shard are simply picked up by the next call
+  unordered_map<TxnHash, PoolTxnStatus> result;
+  for (const auto& shard : m_unconfirmedTxnShards) {
+    shared_lock<shared_timed_mutex> g(shard.m_mutex);
+    result.insert(shard.m_txns.begin(), shard.m_txns.end());
+  }
+  return result;
 }
 
 bool Node::IsUnconfirmedTxnEmpty() const {
-  shared_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
-
-  return m_unconfirmedTxns.empty();
+  for (const auto& shard : m_unconfirmedTxnShards) {
+    shared_lock<shared_timed_mutex> g(shard.m_mutex);
+    if (!shard.m_txns.empty()) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void Node::UpdateBalanceForPreGeneratedAccounts() {
@@ -969,7 +952,24 @@ bool Node::RunConsensusOnMicroBlockWhenShardBackup() {
        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum() >=
            TXN_DS_TARGET_NUM)) {
     std::this_thread::sleep_for(chrono::milliseconds(TX_DISTRIBUTE_TIME_IN_MS));
-    ProcessTransactionWhenShardBackup(SHARD_MICROBLOCK_GAS_LIMIT);
+
+    // Execute the pooled txns speculatively on a detached thread so that the
+    // consensus backup below is already set up when the leader's announcement
+    // arrives; MicroBlockValidator waits for this run to finish before
+    // checking the announced microblock against the local results
+    {
+      lock_guard<mutex> g(m_mutexCVTxnProcFinished);
+      m_shardBackupTxnProcInFlight = true;
+    }
+    auto speculativeTxnProc = [this]() mutable -> void {
+      ProcessTransactionWhenShardBackup(SHARD_MICROBLOCK_GAS_LIMIT);
+      {
+        lock_guard<mutex> g(m_mutexCVTxnProcFinished);
+        m_shardBackupTxnProcInFlight = false;
+      }
+      cv_TxnProcFinished.notify_all();
+    };
+    DetachedFunction(1, speculativeTxnProc);
   }
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
@@ -1316,8 +1316,15 @@ bool Node::CheckMicroBlockTxnRootHash() {
     return true;
   }
 
-  // Check transaction root
-  TxnHash expectedTxRootHash = ComputeRoot(m_microblock->GetTranHashes());
+  // Check transaction root; the leader proposing exactly the pre-staged
+  // ordering means its root was already computed by the backup txn run
+  TxnHash expectedTxRootHash;
+  if (m_prestagedHashesValid &&
+      m_microblock->GetTranHashes() == m_prestagedTranHashes) {
+    expectedTxRootHash = m_prestagedTxRootHash;
+  } else {
+    expectedTxRootHash = ComputeRoot(m_microblock->GetTranHashes());
+  }
 
   if (expectedTxRootHash != m_microblock->GetHeader().GetTxRootHash()) {
     LOG_CHECK_FAIL("Txn root hash", m_microblock->GetHeader().GetTxRootHash(),
@@ -1363,9 +1370,13 @@ bool Node::CheckMicroBlockStateDeltaHash() {
 
 bool Node::CheckMicroBlockTranReceiptHash() {
   TxnHash expectedTranHash;
-  if (!TransactionWithReceipt::ComputeTransactionReceiptsHash(
-          m_microblock->GetTranHashes(), t_processedTransactions,
-          expectedTranHash)) {
+  if (m_prestagedHashesValid &&
+      m_microblock->GetTranHashes() == m_prestagedTranHashes) {
+    // same ordering the backup txn run already hashed the receipts for
+    expectedTranHash = m_prestagedTranReceiptHash;
+  } else if (!TransactionWithReceipt::ComputeTransactionReceiptsHash(
+                 m_microblock->GetTranHashes(), t_processedTransactions,
+                 expectedTranHash)) {
     LOG_GENERAL(WARNING, "Cannot compute transaction receipts hash");
     return false;
   }
@@ -1457,6 +1468,17 @@ bool Node::MicroBlockValidator(const bytes& message, unsigned int offset,
     return false;
   }
 
+  // The backup executes the pooled txns in the background while waiting for
+  // the announcement; make sure that run has finished before validating
+  // against its ordering and state delta. The run is bounded by the txn proc
+  // timeout, so this wait cannot exceed MICROBLOCK_TIMEOUT
+  {
+    unique_lock<mutex> lock(m_mutexCVTxnProcFinished);
+    cv_TxnProcFinished.wait_for(
+        lock, chrono::seconds(MICROBLOCK_TIMEOUT),
+        [this]() { return !m_shardBackupTxnProcInFlight; });
+  }
+
   if (!CheckMicroBlockValidity(errorMsg, SHARD_MICROBLOCK_GAS_LIMIT)) {
     m_microblock = nullptr;
     LOG_GENERAL(WARNING, "CheckMicroBlockValidity failed");
@@ -17,8 +17,10 @@
 
 #include <arpa/inet.h>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <set>
 #include <thread>
 #include <tuple>
 
@@ -48,6 +50,7 @@
 #include "libPythonRunner/PythonRunner.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EpochPhaseTracker.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
@@ -206,6 +209,9 @@ bool Node::Install(const SyncType syncType, const bool toRetrieveHistory,
         WakeupAtTxEpoch();
       }
 
+      // resume with the mempool the previous process handed off, if any
+      ImportMempoolFromHandoff();
+
       return true;
     }
   }
@@ -552,8 +558,10 @@ bool Node::CheckIntegrity(bool fromIsolatedBinary) {
 }
 
 void Node::ClearUnconfirmedTxn() {
-  unique_lock<shared_timed_mutex> g(m_unconfirmedTxnsMutex);
-  m_unconfirmedTxns.clear();
+  for (auto& shard : m_unconfirmedTxnShards) {
+    unique_lock<shared_timed_mutex> g(shard.m_mutex);
+    shard.m_txns.clear();
+  }
 }
 
 bool Node::ValidateDB() {
@@ -689,6 +697,12 @@ bool Node::StartRetrieveHistory(const SyncType syncType,
 
   m_retriever = std::make_shared<Retriever>(m_mediator);
 
+  /// Seed persistence from a checkpoint archive, if one was dropped in
+  if (!m_retriever->ImportCheckpoint()) {
+    LOG_GENERAL(WARNING, "Retriever::ImportCheckpoint failed");
+    return false;
+  }
+
   /// Retrieve block link
   bool ds_result =
       m_retriever->RetrieveBlockLink(RECOVERY_TRIM_INCOMPLETED_BLOCK &&
@@ -1645,6 +1659,8 @@ bool Node::ProcessTxnPacketFromLookupCore(const bytes& message,
     return true;
   }
 
+  EpochPhaseTracker::Scope span("ProcessTxnPacketFromLookup", epochNum);
+
   if (LOG_PARAMETERS) {
     LOG_STATE("[TXNPKT-BEG]["
               << m_mediator.m_currentEpochNum << "] PktEpoch=" << epochNum
@@ -1768,27 +1784,66 @@ bool Node::ProcessTxnPacketFromLookupCore(const bytes& message,
 #endif  // DM_TEST_DM_MORETXN_HALF
 
   // Process the txns
-  unsigned int processed_count = 0;
-
   LOG_GENERAL(INFO, "Start check txn packet from lookup");
 
-  std::vector<Transaction> checkedTxns;
-  for (const auto& txn : txns) {
-    if (m_mediator.GetIsVacuousEpoch()) {
-      LOG_GENERAL(WARNING, "Already in vacuous epoch, stop proc txn");
-      return false;
-    }
-    if (m_mediator.m_validator->CheckCreatedTransactionFromLookup(txn)) {
-      checkedTxns.push_back(txn);
-    } else {
-      LOG_GENERAL(WARNING, "Txn " << txn.GetTranID().hex() << " is not valid.");
-    }
+  if (m_mediator.GetIsVacuousEpoch()) {
+    LOG_GENERAL(WARNING, "Already in vacuous epoch, stop proc txn");
+    return false;
+  }
 
-    processed_count++;
+  // The packet fixes the sender/recipient set for the upcoming microblock, so
+  // warm the account store while the signature checks below run; execution
+  // then finds these accounts in memory instead of faulting each one in from
+  // LevelDB on first touch
+  {
+    std::set<Address> addressSet;
+    for (const auto& txn : txns) {
+      addressSet.emplace(txn.GetSenderAddr());
+      addressSet.emplace(txn.GetToAddr());
+    }
+    auto prefetch = [addresses = std::vector<Address>(addressSet.begin(),
+                                                      addressSet.end())]() {
+      AccountStore::GetInstance().PrefetchAccounts(addresses);
+    };
+    DetachedFunction(1, prefetch);
+  }
+
+  // Schnorr verification dominates the per-txn check, so fan the packet out
+  // across a pool of workers; the pool inserts below still happen serially
+  // and in packet order, so the resulting pool state is the same as with the
+  // old serial loop
+  std::vector<unsigned char> txnValid(txns.size(), 0);
+  std::atomic<unsigned int> processed_count(0);
+  const unsigned int numWorkers =
+      std::max(1u, std::min(static_cast<unsigned int>(txns.size()),
+                            std::thread::hardware_concurrency()));
+  std::vector<std::thread> validationWorkers;
+  validationWorkers.reserve(numWorkers);
+  for (unsigned int workerId = 0; workerId < numWorkers; workerId++) {
+    validationWorkers.emplace_back([this, workerId, numWorkers, &txns,
+                                    &txnValid, &processed_count]() {
+      for (size_t i = workerId; i < txns.size(); i += numWorkers) {
+        if (m_mediator.m_validator->CheckCreatedTransactionFromLookup(
+                txns[i])) {
+          txnValid[i] = 1;
+        } else {
+          LOG_GENERAL(WARNING,
+                      "Txn " << txns[i].GetTranID().hex() << " is not valid.");
+        }
 
-    if (processed_count % 100 == 0) {
-      LOG_GENERAL(INFO, processed_count << " txns from packet processed");
-    }
+        if (++processed_count % 100 == 0) {
+          LOG_GENERAL(INFO, processed_count << " txns from packet processed");
+        }
+      }
+    });
+  }
+  for (auto& worker : validationWorkers) {
+    worker.join();
+  }
+
+  if (m_mediator.GetIsVacuousEpoch()) {
+    LOG_GENERAL(WARNING, "Already in vacuous epoch, stop proc txn");
+    return false;
   }
 
   {
@@ -1796,9 +1851,13 @@ bool Node::ProcessTxnPacketFromLookupCore(const bytes& message,
     LOG_GENERAL(INFO,
                 "TxnPool size before processing: " << m_createdTxns.size());
 
-    for (const auto& txn : checkedTxns) {
-      LOG_GENERAL(INFO, "Txn " << txn.GetTranID().hex() << " added to pool");
-      m_createdTxns.insert(txn);
+    for (size_t i = 0; i < txns.size(); i++) {
+      if (!txnValid[i]) {
+        continue;
+      }
+      LOG_GENERAL(INFO,
+                  "Txn " << txns[i].GetTranID().hex() << " added to pool");
+      m_createdTxns.insert(txns[i]);
     }
 
     LOG_GENERAL(INFO, "Txn processed: " << processed_count
@@ -1956,10 +2015,51 @@ void Node::RejoinAsNormal() {
   LOG_MARKER();
   if (m_mediator.m_lookup->GetSyncType() == SyncType::NO_SYNC) {
     auto func = [this]() mutable -> void {
+      // Delta-sync fast path: local persistence is current up to the epoch
+      // we fell out at, so first try fetching only the missing blocks and
+      // per-epoch state deltas from the seeds (Lookup::CommitTxBlocks
+      // applies them through AccountStore::DeserializeDelta) instead of
+      // re-downloading the whole persistence. Falls back to the full
+      // download when no progress is made, e.g. when the node fell behind
+      // the current DS epoch, beyond which seeds do not serve tx blocks.
+      uint64_t lastEpochFin = 0;
+      bool attemptDeltaSync =
+          BlockStorage::GetBlockStorage().GetEpochFin(lastEpochFin) &&
+          (lastEpochFin > 0);
       while (true) {
         m_mediator.m_lookup->SetSyncType(SyncType::NORMAL_SYNC);
         this->CleanVariables();
         this->m_mediator.m_ds->CleanVariables();
+        if (attemptDeltaSync) {
+          attemptDeltaSync = false;
+          LOG_GENERAL(INFO, "Attempting delta-sync rejoin from epoch "
+                                << lastEpochFin);
+          if (this->Install(SyncType::NORMAL_SYNC, true, true)) {
+            this->StartSynchronization();
+
+            const uint64_t tipBefore = m_mediator.m_txBlockChain.GetLastBlock()
+                                           .GetHeader()
+                                           .GetBlockNum();
+            this_thread::sleep_for(
+                chrono::seconds(NEW_NODE_SYNC_INTERVAL * 6));
+            if (m_mediator.m_lookup->GetSyncType() == SyncType::NO_SYNC ||
+                m_mediator.m_txBlockChain.GetLastBlock()
+                        .GetHeader()
+                        .GetBlockNum() > tipBefore) {
+              // delta-sync is making progress, leave it to finish
+              return;
+            }
+            LOG_GENERAL(WARNING,
+                        "Delta-sync made no progress, falling back to full "
+                        "persistence download");
+            // let the synchronization loop wind down before restarting the
+            // full rejoin
+            m_mediator.m_lookup->SetSyncType(SyncType::NO_SYNC);
+            this_thread::sleep_for(
+                chrono::seconds(NEW_NODE_SYNC_INTERVAL * 2));
+          }
+          continue;
+        }
         while (!this->DownloadPersistenceFromS3()) {
           LOG_GENERAL(
               WARNING,
@@ -2090,15 +2190,77 @@ void Node::CleanCreatedTransaction() {
     m_processedTransactions.clear();
     t_processedTransactions.clear();
   }
-  {
-    std::unique_lock<shared_timed_mutex> lock(m_unconfirmedTxnsMutex);
-    m_unconfirmedTxns.clear();
-  }
+  ClearUnconfirmedTxn();
   m_TxnOrder.clear();
   m_gasUsedTotal = 0;
   m_txnFees = 0;
 }
 
+bool Node::ExportMempoolForHandoff() {
+  if (LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING,
+                "Node::ExportMempoolForHandoff not expected to be called "
+                "from LookUp node.");
+    return false;
+  }
+
+  vector<Transaction> txns;
+  {
+    lock_guard<mutex> g(m_mutexCreatedTransactions);
+    txns.reserve(m_createdTxns.HashIndex.size());
+    for (const auto& entry : m_createdTxns.HashIndex) {
+      txns.emplace_back(entry.second);
+    }
+  }
+
+  bytes data;
+  if (!Messenger::SetTransactionArray(data, 0, txns)) {
+    LOG_GENERAL(WARNING, "Messenger::SetTransactionArray failed.");
+    return false;
+  }
+
+  if (!BlockStorage::GetBlockStorage().PutMetadata(MetaType::MEMPOOLHANDOFF,
+                                                   data)) {
+    LOG_GENERAL(WARNING, "Failed to store mempool handoff blob");
+    return false;
+  }
+
+  LOG_GENERAL(INFO,
+              "Exported " << txns.size() << " pending txns for handoff");
+  return true;
+}
+
+void Node::ImportMempoolFromHandoff() {
+  if (LOOKUP_NODE_MODE) {
+    return;
+  }
+
+  bytes data;
+  if (!BlockStorage::GetBlockStorage().GetMetadata(MetaType::MEMPOOLHANDOFF,
+                                                   data, true)) {
+    return;
+  }
+
+  // one-shot: a stale blob must not resurrect old txns on a later restart
+  BlockStorage::GetBlockStorage().PutMetadata(MetaType::MEMPOOLHANDOFF, {});
+
+  vector<Transaction> txns;
+  if (!Messenger::GetTransactionArray(data, 0, txns)) {
+    LOG_GENERAL(WARNING, "Messenger::GetTransactionArray failed.");
+    return;
+  }
+
+  {
+    lock_guard<mutex> g(m_mutexCreatedTransactions);
+    for (const auto& txn : txns) {
+      m_createdTxns.insert(txn);
+    }
+  }
+
+  LOG_GENERAL(INFO,
+              "Imported " << txns.size() << " pending txns from handoff");
+}
+
 bool Node::IsShardNode(const PubKey& pubKey) {
   lock_guard<mutex> lock(m_mutexShardMember);
   return std::find_if(m_myShardMembers->begin(), m_myShardMembers->end(),
@@ -2558,7 +2720,8 @@ bool Node::Execute(const bytes& message, unsigned int offset,
   typedef bool (Node::*InstructionHandler)(const bytes&, unsigned int,
                                            const Peer&);
 
-  InstructionHandler ins_handlers[] = {&Node::ProcessStartPoW,
+  // Built once; the table is ordered by NodeInstructionType
+  static const InstructionHandler ins_handlers[] = {&Node::ProcessStartPoW,
                                        &Node::ProcessVCDSBlocksMessage,
                                        &Node::ProcessSubmitTransaction,
                                        &Node::ProcessMicroBlockConsensus,
@@ -17,6 +17,7 @@
 #ifndef ZILLIQA_SRC_LIBNODE_NODE_H_
 #define ZILLIQA_SRC_LIBNODE_NODE_H_
 
+#include <array>
 #include <condition_variable>
 #include <deque>
 #include <list>
@@ -24,6 +25,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/Constants.h"
@@ -44,7 +46,10 @@
 class Mediator;
 class Retriever;
 
-typedef std::unordered_map<uint64_t, std::vector<std::pair<BlockHash, TxnHash>>>
+// Per final block, the microblocks whose txn bodies have not arrived yet,
+// keyed by microblock hash for O(1) matching on arrival; the epoch is
+// complete exactly when its map turns empty
+typedef std::unordered_map<uint64_t, std::unordered_map<BlockHash, TxnHash>>
     UnavailableMicroBlockList;
 
 /// Implements PoW submission and sharding node functionality.
@@ -138,16 +143,57 @@ class Node : public Executable {
   uint64_t m_gasUsedTotal = 0;
   uint128_t m_txnFees = 0;
 
+  // Expected microblock content pre-staged at the end of the backup txn
+  // processing run: when the leader announces exactly this txn ordering (the
+  // common case in healthy epochs), the validator reuses these hashes
+  // instead of recomputing the roots on the announcement critical path
+  std::vector<TxnHash> m_prestagedTranHashes;
+  TxnHash m_prestagedTxRootHash;
+  TxnHash m_prestagedTranReceiptHash;
+  bool m_prestagedHashesValid = false;
+
   // std::mutex m_mutexCommittedTransactions;
   // std::unordered_map<uint64_t, std::list<TransactionWithReceipt>>
   //     m_committedTransactions;
-  std::shared_timed_mutex mutable m_unconfirmedTxnsMutex;
-  std::unordered_map<TxnHash, PoolTxnStatus> m_unconfirmedTxns;
+  /// number of lock shards in the mempool txn status index
+  static const unsigned int NUM_UNCONFIRMED_TXN_SHARDS = 16;
+
+  /// mempool txn status, sharded by hash so wallet status polling through
+  /// IsTxnInMemPool does not contend with the bulk updates made while
+  /// transactions are processed
+  struct UnconfirmedTxnShard {
+    std::shared_timed_mutex mutable m_mutex;
+    std::unordered_map<TxnHash, PoolTxnStatus> m_txns;
+  };
+  std::array<UnconfirmedTxnShard, NUM_UNCONFIRMED_TXN_SHARDS> mutable
+      m_unconfirmedTxnShards;
+
+  UnconfirmedTxnShard& GetUnconfirmedTxnShard(const TxnHash& txhash) const {
+    return m_unconfirmedTxnShards[txhash[0] % NUM_UNCONFIRMED_TXN_SHARDS];
+  }
+
+  void AddToUnconfirmedTxns(const TxnHash& txhash, const PoolTxnStatus status);
 
   std::mutex m_mutexMBnForwardedTxnBuffer;
   std::unordered_map<uint64_t, std::vector<MBnForwardedTxnEntry>>
       m_mbnForwardedTxnBuffer;
 
+  // Payload hashes of recently accepted MBNFORWARDTRANSACTION packets. The
+  // DS broadcast and the lookup forwarding path can deliver the same packet;
+  // checking the raw payload hash first lets the repeat skip the protobuf
+  // deserialization and the merkle recomputations entirely. Bounded FIFO -
+  // the capacity comfortably covers the bursty final-block window, after
+  // which old entries simply age out
+  static const unsigned int MBNFORWARD_SEEN_MAX_ENTRIES = 1024;
+  std::mutex m_mutexMBnForwardedSeen;
+  std::unordered_set<dev::h256> m_mbnForwardedSeenCache;
+  std::deque<dev::h256> m_mbnForwardedSeenOrder;
+  uint64_t m_mbnForwardedDupCount{};
+
+  /// Records an accepted forwarded-txn packet's payload hash, evicting the
+  /// oldest entry once the filter is full
+  void MarkMBnForwardPacketSeen(const dev::h256& payloadHash);
+
   std::mutex m_mutexPendingTxnBuffer;
   std::unordered_map<uint64_t,
                      std::vector<std::tuple<HashCodeMap, PubKey, uint32_t>>>
@@ -159,6 +205,10 @@ class Node : public Executable {
   // txn proc timeout related
   std::mutex m_mutexCVTxnProcFinished;
   std::condition_variable cv_TxnProcFinished;
+  // set while the shard backup is still executing txns speculatively in the
+  // background; MicroBlockValidator waits on cv_TxnProcFinished until the
+  // run completes (guarded by m_mutexCVTxnProcFinished)
+  bool m_shardBackupTxnProcInFlight = false;
 
   std::mutex m_mutexMicroBlockConsensusBuffer;
   std::unordered_map<uint32_t, VectorOfNodeMsg> m_microBlockConsensusBuffer;
@@ -532,6 +582,15 @@ class Node : public Executable {
 
   void CleanCreatedTransaction();
 
+  /// Serializes the pending transaction pool to persistence so the next
+  /// process resumes with its mempool intact across a coordinated restart;
+  /// triggered through StatusServer just before the upgrade
+  bool ExportMempoolForHandoff();
+
+  /// One-shot counterpart: re-imports (and then clears) a mempool blob the
+  /// previous process left behind
+  void ImportMempoolFromHandoff();
+
   void AddBalanceToGenesisAccount();
 
   void PopulateAccounts(bool temp = false);
@@ -27,6 +27,7 @@
 #include "libCrypto/Sha2.h"
 #include "libServer/GetWorkServer.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/DetachedFunction.h"
 #include "pow.h"
 
 #ifdef OPENCL_MINE
@@ -43,6 +44,7 @@ POW::POW() {
   m_currentBlockNum = 0;
   m_epochContextLight =
       ethash::create_epoch_context(ethash::get_epoch_number(m_currentBlockNum));
+  m_lightContextEpoch = ethash::get_epoch_number(m_currentBlockNum);
 
   if (REMOTE_MINE) {
     m_httpClient = std::make_unique<jsonrpc::HttpClient>(MINING_PROXY_URL);
@@ -236,27 +238,101 @@ bool POW::EthashConfigureClient(uint64_t block_number, bool fullDataset) {
                     << " currentBlockNum: " << m_currentBlockNum);
   }
 
-  if (ethash::get_epoch_number(block_number) !=
-      ethash::get_epoch_number(m_currentBlockNum)) {
-    auto epochNumber = ethash::get_epoch_number(block_number);
-    m_epochContextLight = ethash::create_epoch_context(epochNumber);
+  const auto epochNumber = ethash::get_epoch_number(block_number);
+  const bool epochChanged =
+      epochNumber != ethash::get_epoch_number(m_currentBlockNum);
+
+  if (epochChanged) {
+    std::lock_guard<std::mutex> h(m_mutexNextEpochContext);
+    if (m_nextEpochNumber == epochNumber &&
+        m_nextEpochContextLight != nullptr) {
+      // Use the context pre-generated while the previous epoch was mined
+      std::atomic_store(&m_epochContextLight,
+                        std::move(m_nextEpochContextLight));
+      m_nextEpochContextLight = nullptr;
+    } else {
+      std::atomic_store(&m_epochContextLight,
+                        ethash::create_epoch_context(epochNumber));
+    }
+    // Publish the epoch only after the context, so a fast-path reader that
+    // sees the new epoch is guaranteed to load the matching context
+    m_lightContextEpoch.store(epochNumber, std::memory_order_release);
   }
 
   bool isMineFullCpu = fullDataset && !CUDA_GPU_MINE && !OPENCL_GPU_MINE &&
                        !GETWORK_SERVER_MINE && !REMOTE_MINE;
 
-  if (isMineFullCpu && (m_epochContextFull == nullptr ||
-                        ethash::get_epoch_number(block_number) !=
-                            ethash::get_epoch_number(m_currentBlockNum))) {
-    m_epochContextFull = ethash::create_epoch_context_full(
-        ethash::get_epoch_number(block_number));
+  if (isMineFullCpu && (m_epochContextFull == nullptr || epochChanged)) {
+    std::lock_guard<std::mutex> h(m_mutexNextEpochContext);
+    if (m_nextEpochNumber == epochNumber && m_nextEpochContextFull != nullptr) {
+      m_epochContextFull = std::move(m_nextEpochContextFull);
+      m_nextEpochContextFull = nullptr;
+    } else {
+      m_epochContextFull = ethash::create_epoch_context_full(epochNumber);
+    }
   }
 
   m_currentBlockNum = block_number;
 
+  // Warm the DAG for the next ethash epoch in the background while this one
+  // is mined, so crossing a DAG boundary does not freeze the mining start
+  PreGenerateNextEpochContext(epochNumber + 1, isMineFullCpu);
+
   return true;
 }
 
+std::shared_ptr<ethash::epoch_context> POW::GetLightContext(
+    uint64_t blockNum) {
+  // Fast path: all verifications within one ethash epoch share the
+  // published context without touching m_mutexLightClientConfigure
+  if (ethash::get_epoch_number(blockNum) ==
+      m_lightContextEpoch.load(std::memory_order_acquire)) {
+    auto context = std::atomic_load(&m_epochContextLight);
+    if (context != nullptr) {
+      return context;
+    }
+  }
+
+  EthashConfigureClient(blockNum);
+  return std::atomic_load(&m_epochContextLight);
+}
+
+void POW::PreGenerateNextEpochContext(int epochNumber, bool fullDataset) {
+  {
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    if (m_nextEpochContextGenerating ||
+        (m_nextEpochNumber == epochNumber &&
+         m_nextEpochContextLight != nullptr &&
+         (!fullDataset || m_nextEpochContextFull != nullptr))) {
+      return;
+    }
+    m_nextEpochContextGenerating = true;
+  }
+
+  auto generate = [this, epochNumber, fullDataset]() -> void {
+    LOG_GENERAL(INFO, "Pre-generating ethash context for epoch "
+                          << epochNumber
+                          << (fullDataset ? " (full dataset)" : " (light)"));
+
+    std::shared_ptr<ethash::epoch_context> light =
+        ethash::create_epoch_context(epochNumber);
+    std::shared_ptr<ethash::epoch_context_full> full = nullptr;
+    if (fullDataset) {
+      full = ethash::create_epoch_context_full(epochNumber);
+    }
+
+    std::lock_guard<std::mutex> g(m_mutexNextEpochContext);
+    m_nextEpochNumber = epochNumber;
+    m_nextEpochContextLight = std::move(light);
+    m_nextEpochContextFull = std::move(full);
+    m_nextEpochContextGenerating = false;
+
+    LOG_GENERAL(INFO,
+                "Ethash context for epoch " << epochNumber << " is ready");
+  };
+  DetachedFunction(1, generate);
+}
+
 ethash_mining_result_t POW::MineGetWork(uint64_t blockNum,
                                         ethash_hash256 const& headerHash,
                                         uint8_t difficulty, int timeWindow) {
@@ -281,8 +357,10 @@ ethash_mining_result_t POW::MineLight(ethash_hash256 const& headerHash,
   uint64_t nonce = startNonce;
   auto startTime = std::chrono::high_resolution_clock::now();
 
+  const auto epochContextLight = std::atomic_load(&m_epochContextLight);
+
   while (m_shouldMine) {
-    auto mineResult = ethash::hash(*m_epochContextLight, headerHash, nonce);
+    auto mineResult = ethash::hash(*epochContextLight, headerHash, nonce);
     if (ethash::is_less_or_equal(mineResult.final_hash, boundary)) {
       ethash_mining_result_t winning_result = {
           BlockhashToHexString(mineResult.final_hash),
@@ -603,12 +681,14 @@ bool POW::VerifyRemoteSoln(uint64_t blockNum, ethash_hash256 const& boundary,
                            ethash_hash256& hashResult) {
   LOG_MARKER();
 
-  hashResult = LightHash(blockNum, headerHash, nonce).final_hash;
+  const auto epochContextLight = GetLightContext(blockNum);
+
+  hashResult = ethash::hash(*epochContextLight, headerHash, nonce).final_hash;
   if (!ethash::is_less_or_equal(hashResult, boundary)) {
     return false;
   }
 
-  return ethash::verify(*m_epochContextLight, headerHash, mixHash, nonce,
+  return ethash::verify(*epochContextLight, headerHash, mixHash, nonce,
                         boundary);
 }
 
@@ -805,7 +885,7 @@ bool POW::PoWVerify(uint64_t blockNum, uint8_t difficulty,
                     const std::string& winning_result,
                     const std::string& winning_mixhash) {
   LOG_MARKER();
-  EthashConfigureClient(blockNum);
+  const auto epochContextLight = GetLightContext(blockNum);
   const auto boundary = DifficultyLevelInIntDevided(difficulty);
   auto winnning_result = StringToBlockhash(winning_result);
   auto winningMixhash = StringToBlockhash(winning_mixhash);
@@ -815,15 +895,14 @@ bool POW::PoWVerify(uint64_t blockNum, uint8_t difficulty,
     return false;
   }
 
-  return ethash::verify(*m_epochContextLight, headerHash, winningMixhash,
+  return ethash::verify(*epochContextLight, headerHash, winningMixhash,
                         winning_nonce, boundary);
 }
 
 ethash::result POW::LightHash(uint64_t blockNum,
                               ethash_hash256 const& headerHash,
                               uint64_t nonce) {
-  EthashConfigureClient(blockNum);
-  return ethash::hash(*m_epochContextLight, headerHash, nonce);
+  return ethash::hash(*GetLightContext(blockNum), headerHash, nonce);
 }
 
 bool POW::CheckSolnAgainstsTargetedDifficulty(const ethash_hash256& result,
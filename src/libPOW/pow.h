@@ -131,8 +131,23 @@ class POW {
                         ethash_hash256 const& boundary, bool verifyResult);
 
  private:
+  /// Returns the light client context for the given block's ethash epoch.
+  /// Verifications within one epoch take a lock-free fast path against the
+  /// atomically published context; only an epoch change falls back to
+  /// EthashConfigureClient and its mutex.
+  std::shared_ptr<ethash::epoch_context> GetLightContext(uint64_t blockNum);
+
   std::shared_ptr<ethash::epoch_context> m_epochContextLight = nullptr;
+  // ethash epoch of the published light context, for the lock-free fast path
+  std::atomic<int> m_lightContextEpoch{-1};
   std::shared_ptr<ethash::epoch_context_full> m_epochContextFull = nullptr;
+  // Contexts for the next ethash epoch, built in the background while the
+  // current epoch is being mined
+  std::mutex m_mutexNextEpochContext;
+  int m_nextEpochNumber = -1;
+  bool m_nextEpochContextGenerating = false;
+  std::shared_ptr<ethash::epoch_context> m_nextEpochContextLight = nullptr;
+  std::shared_ptr<ethash::epoch_context_full> m_nextEpochContextFull = nullptr;
   uint64_t m_currentBlockNum;
   std::atomic<bool> m_shouldMine{};
   std::vector<dev::eth::MinerPtr> m_miners;
@@ -157,6 +172,7 @@ class POW {
                                      int timeWindow);
   void MineFullGPUThread(uint64_t blockNum, ethash_hash256 const& headerHash,
                          uint8_t difficulty, uint64_t nonce, int timeWindow);
+  void PreGenerateNextEpochContext(int epochNumber, bool fullDataset);
   void InitOpenCL();
   void InitCUDA();
 };
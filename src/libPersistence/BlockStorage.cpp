@@ -20,9 +20,11 @@
 #include <unistd.h>
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 
 #include <leveldb/db.h>
 #include <boost/filesystem.hpp>
@@ -33,7 +35,13 @@
 #include "common/Serializable.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
 #include "libMessage/Messenger.h"
+#include "libUtils/DataCompression.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/EpochPhaseTracker.h"
+#include "libUtils/JsonUtils.h"
+#include "libUtils/MemoryBudget.h"
+#include "libUtils/SysCommand.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 
@@ -60,6 +68,7 @@ bool BlockStorage::PutBlock(const uint64_t& blockNum, const bytes& body,
 
 bool BlockStorage::PutDSBlock(const uint64_t& blockNum, const bytes& body) {
   // return PutBlock(blockNum, body, BlockType::DS);
+  EpochPhaseTracker::Scope span("BlockStorage_PutDSBlock", blockNum);
   bool ret = false;
   if (PutBlock(blockNum, body, BlockType::DS)) {
     if (PutMetadata(MetaType::DSINCOMPLETED, {'1'})) {
@@ -95,8 +104,158 @@ bool BlockStorage::PutBlockLink(const uint64_t& index, const bytes& body) {
   return (ret == 0);
 }
 
+bool BlockStorage::PutDirBlockCheckpoint(const uint64_t& index,
+                                         const CommitteeHash& committeeHash) {
+  unique_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+  return (m_dirBlockCheckpointDB->Insert(index, committeeHash.asBytes()) == 0);
+}
+
+bool BlockStorage::GetDirBlockCheckpoint(const uint64_t& index,
+                                         CommitteeHash& committeeHash) {
+  string hashString;
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+    hashString = m_dirBlockCheckpointDB->Lookup(index);
+  }
+
+  if (hashString.size() != CommitteeHash::size) {
+    return false;
+  }
+
+  committeeHash = CommitteeHash(bytes(hashString.begin(), hashString.end()));
+  return true;
+}
+
 bool BlockStorage::PutTxBlock(const uint64_t& blockNum, const bytes& body) {
-  return PutBlock(blockNum, body, BlockType::Tx);
+  EpochPhaseTracker::Scope span("BlockStorage_PutTxBlock", blockNum);
+  if (!PutBlock(blockNum, body, BlockType::Tx)) {
+    return false;
+  }
+
+  TxBlockSharedPtr block = TxBlockSharedPtr(new TxBlock(body, 0));
+
+  // Write-through into the header column. A failure here only costs the
+  // header readers a full-block fallback, so it does not fail the put
+  bytes headerBytes;
+  if (block->GetHeader().Serialize(headerBytes, 0)) {
+    unique_lock<shared_timed_mutex> g(m_mutexTxBlockHeader);
+    if (m_txBlockHeaderDB->Insert(blockNum, headerBytes) != 0) {
+      LOG_GENERAL(WARNING, "Failed to store TxBlock header " << blockNum);
+    }
+  } else {
+    LOG_GENERAL(WARNING,
+                "TxBlockHeader serialization failed for block " << blockNum);
+  }
+
+  AddToRecentTxBlocks(blockNum, block, body.size());
+  return true;
+}
+
+void BlockStorage::AddToRecentTxBlocks(const uint64_t& blockNum,
+                                       const TxBlockSharedPtr& block,
+                                       const uint64_t& bodySize) {
+  lock_guard<mutex> g(m_mutexRecentBlocks);
+  m_recentTxBlocks[blockNum] = block;
+  m_recentTxBlockBytes[blockNum] = bodySize;
+  while (m_recentTxBlocks.size() > RECENT_TX_BLOCKS_MAX_ENTRIES) {
+    m_recentTxBlockBytes.erase(m_recentTxBlocks.begin()->first);
+    m_recentTxBlocks.erase(m_recentTxBlocks.begin());
+  }
+}
+
+void BlockStorage::AddToRecentMicroBlocks(const BlockHash& blockHash,
+                                          const bytes& body) {
+  MicroBlockSharedPtr block = make_shared<MicroBlock>(body, 0);
+  lock_guard<mutex> g(m_mutexRecentBlocks);
+  m_recentMicroBlockBytes[blockHash] = body.size();
+  if (m_recentMicroBlocks.emplace(blockHash, block).second) {
+    m_recentMicroBlockOrder.push_back(blockHash);
+    while (m_recentMicroBlockOrder.size() > RECENT_MICRO_BLOCKS_MAX_ENTRIES) {
+      m_recentMicroBlocks.erase(m_recentMicroBlockOrder.front());
+      m_recentMicroBlockBytes.erase(m_recentMicroBlockOrder.front());
+      m_recentMicroBlockOrder.pop_front();
+    }
+  } else {
+    m_recentMicroBlocks[blockHash] = block;
+  }
+}
+
+// hash plus set-node and order-deque overhead per miss cache entry
+const unsigned int TX_BODY_MISS_ENTRY_BYTES = 96;
+
+void BlockStorage::RegisterMemoryBudgetCaches() {
+  // The recent-blocks tier refills write-through as new blocks arrive, so
+  // shedding it only costs LevelDB re-reads until the next epoch
+  MemoryBudget::GetInstance().RegisterCache(
+      "blockStorage.recentBlocks", MemoryBudget::Tier::PERFORMANCE,
+      [this]() -> uint64_t {
+        lock_guard<mutex> g(m_mutexRecentBlocks);
+        uint64_t total = 0;
+        for (const auto& entry : m_recentTxBlockBytes) {
+          total += entry.second;
+        }
+        for (const auto& entry : m_recentMicroBlockBytes) {
+          total += entry.second;
+        }
+        return total;
+      },
+      [this](uint64_t targetBytes) {
+        lock_guard<mutex> g(m_mutexRecentBlocks);
+        uint64_t total = 0;
+        for (const auto& entry : m_recentTxBlockBytes) {
+          total += entry.second;
+        }
+        for (const auto& entry : m_recentMicroBlockBytes) {
+          total += entry.second;
+        }
+        // oldest entries go first - the newest blocks are the ones the
+        // subsystems re-read
+        while (total > targetBytes && !m_recentMicroBlockOrder.empty()) {
+          const auto it =
+              m_recentMicroBlockBytes.find(m_recentMicroBlockOrder.front());
+          if (it != m_recentMicroBlockBytes.end()) {
+            total -= min(total, it->second);
+            m_recentMicroBlockBytes.erase(it);
+          }
+          m_recentMicroBlocks.erase(m_recentMicroBlockOrder.front());
+          m_recentMicroBlockOrder.pop_front();
+        }
+        while (total > targetBytes && !m_recentTxBlocks.empty()) {
+          const auto it =
+              m_recentTxBlockBytes.find(m_recentTxBlocks.begin()->first);
+          if (it != m_recentTxBlockBytes.end()) {
+            total -= min(total, it->second);
+            m_recentTxBlockBytes.erase(it);
+          }
+          m_recentTxBlocks.erase(m_recentTxBlocks.begin());
+        }
+      });
+
+  // A dropped miss cache entry only re-costs one LevelDB probe per repeated
+  // absent hash, so this cache gives back memory first
+  MemoryBudget::GetInstance().RegisterCache(
+      "blockStorage.txBodyMissCache", MemoryBudget::Tier::OPPORTUNISTIC,
+      [this]() -> uint64_t {
+        lock_guard<mutex> g(m_mutexTxBodyMissCache);
+        return (m_txBodyMissCache.size() + m_txnHistoricalMissCache.size()) *
+               uint64_t(TX_BODY_MISS_ENTRY_BYTES);
+      },
+      [this](uint64_t targetBytes) {
+        lock_guard<mutex> g(m_mutexTxBodyMissCache);
+        auto overTarget = [this, targetBytes]() {
+          return (m_txBodyMissCache.size() + m_txnHistoricalMissCache.size()) *
+                     uint64_t(TX_BODY_MISS_ENTRY_BYTES) >
+                 targetBytes;
+        };
+        while (!m_txBodyMissOrder.empty() && overTarget()) {
+          m_txBodyMissCache.erase(m_txBodyMissOrder.front());
+          m_txBodyMissOrder.pop_front();
+        }
+        while (!m_txnHistoricalMissOrder.empty() && overTarget()) {
+          m_txnHistoricalMissCache.erase(m_txnHistoricalMissOrder.front());
+          m_txnHistoricalMissOrder.pop_front();
+        }
+      });
 }
 
 bool BlockStorage::PutTxBody(const dev::h256& key, const bytes& body) {
@@ -111,9 +270,70 @@ bool BlockStorage::PutTxBody(const dev::h256& key, const bytes& body) {
     ret = m_txBodyDB->Insert(key, body) && m_txBodyTmpDB->Insert(key, body);
   }
 
+  {
+    lock_guard<mutex> g(m_mutexTxBodyMissCache);
+    m_txBodyMissCache.erase(key);
+  }
+
   return (ret == 0);
 }
 
+bool BlockStorage::PutTxBodies(const unordered_map<dev::h256, bytes>& bodies) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  unordered_map<string, string> bodies_str;
+  for (const auto& body : bodies) {
+    bodies_str.emplace(body.first.hex(),
+                       DataConversion::CharArrayToString(body.second));
+  }
+
+  {
+    lock_guard<mutex> g(m_mutexTxBodyMissCache);
+    for (const auto& body : bodies) {
+      m_txBodyMissCache.erase(body.first);
+    }
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexTxBody);
+  // Enqueue on both DBs before waiting so the two commits (and any batches
+  // other writers enqueue meanwhile) overlap instead of running back to back
+  auto mainDone = m_txBodyDB->BatchInsertAsync(bodies_str);
+  auto tmpDone = m_txBodyTmpDB->BatchInsertAsync(std::move(bodies_str));
+  const bool mainOk = mainDone.get();
+  const bool tmpOk = tmpDone.get();
+  return mainOk && tmpOk;
+}
+
+bool BlockStorage::PutTxnReceipt(const dev::h256& key, const bytes& receipt) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+  return (m_txnReceiptDB->Insert(key, receipt) == 0);
+}
+
+bool BlockStorage::PutTxnReceipts(
+    const unordered_map<dev::h256, bytes>& receipts) {
+  if (!LOOKUP_NODE_MODE) {
+    LOG_GENERAL(WARNING, "Non lookup node should not trigger this.");
+    return false;
+  }
+
+  unordered_map<string, string> receipts_str;
+  for (const auto& receipt : receipts) {
+    receipts_str.emplace(receipt.first.hex(),
+                         DataConversion::CharArrayToString(receipt.second));
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+  return m_txnReceiptDB->BatchInsert(receipts_str);
+}
+
 bool BlockStorage::PutProcessedTxBodyTmp(const dev::h256& key,
                                          const bytes& body) {
   int ret;
@@ -126,8 +346,15 @@ bool BlockStorage::PutProcessedTxBodyTmp(const dev::h256& key,
 
 bool BlockStorage::PutMicroBlock(const BlockHash& blockHash,
                                  const bytes& body) {
-  unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
-  int ret = m_microBlockDB->Insert(blockHash, body);
+  int ret;
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+    ret = m_microBlockDB->Insert(blockHash, body);
+  }
+
+  if (ret == 0) {
+    AddToRecentMicroBlocks(blockHash, body);
+  }
 
   return (ret == 0);
 }
@@ -137,23 +364,42 @@ bool BlockStorage::InitiateHistoricalDB(const string& path) {
   {
     unique_lock<shared_timed_mutex> g(m_mutexTxnHistorical);
     m_txnHistoricalDB = make_shared<LevelDB>("txBodies", path, (string) "");
+    // A sealed archive (built by gentxnarchive) serves body lookups without
+    // LevelDB overhead; the DB stays as fallback for unmigrated data
+    m_txnArchive.Load(path);
   }
   {
     unique_lock<shared_timed_mutex> g(m_mutexMBHistorical);
     m_MBHistoricalDB = make_shared<LevelDB>("microBlocks", path, (string) "");
   }
+  {
+    lock_guard<mutex> g(m_mutexTxBodyMissCache);
+    m_txnHistoricalMissCache.clear();
+    m_txnHistoricalMissOrder.clear();
+  }
 
   return true;
 }
 
 bool BlockStorage::GetTxnFromHistoricalDB(const dev::h256& key,
                                           TxBodySharedPtr& body) {
+  if (CheckTxBodyMissCache(key, m_txnHistoricalMissCache)) {
+    return false;
+  }
+
   std::string bodyString;
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxnHistorical);
+    bytes archivedBody;
+    if (m_txnArchive.Get(key, archivedBody)) {
+      body = make_shared<TransactionWithReceipt>(archivedBody, 0);
+      return true;
+    }
     bodyString = m_txnHistoricalDB->Lookup(key);
   }
   if (bodyString.empty()) {
+    AddToTxBodyMissCache(key, m_txnHistoricalMissCache,
+                         m_txnHistoricalMissOrder);
     return false;
   }
   body = make_shared<TransactionWithReceipt>(
@@ -184,6 +430,15 @@ bool BlockStorage::GetMicroBlock(const BlockHash& blockHash,
                                  MicroBlockSharedPtr& microblock) {
   LOG_MARKER();
 
+  {
+    lock_guard<mutex> g(m_mutexRecentBlocks);
+    const auto it = m_recentMicroBlocks.find(blockHash);
+    if (it != m_recentMicroBlocks.end()) {
+      microblock = it->second;
+      return true;
+    }
+  }
+
   string blockString;
 
   {
@@ -214,18 +469,46 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
 
   shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
 
+  // Pull the raw entries off the (inherently serial) iterator first, then
+  // deserialize them on a worker pool - the proto decode dominates the scan
+  vector<pair<string, string>> rawBlocks;  // key, serialized block
   leveldb::Iterator* it =
       m_microBlockDB->GetDB()->NewIterator(leveldb::ReadOptions());
   for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    string bns = it->key().ToString();
     string blockString = it->value().ToString();
     if (blockString.empty()) {
       LOG_GENERAL(WARNING, "Lost one block in the chain");
       delete it;
       return false;
     }
-    MicroBlockSharedPtr block = MicroBlockSharedPtr(
-        new MicroBlock(bytes(blockString.begin(), blockString.end()), 0));
+    rawBlocks.emplace_back(it->key().ToString(), move(blockString));
+  }
+
+  delete it;
+
+  // Each job writes to its own slot, so the results come back in iterator
+  // order without a merge step
+  vector<MicroBlockSharedPtr> deserialized(rawBlocks.size());
+  if (!rawBlocks.empty()) {
+    const unsigned int NUMTHREADS = min<unsigned int>(
+        rawBlocks.size(), max(1u, thread::hardware_concurrency()));
+    ThreadPool deserializePool(NUMTHREADS, "MBRangeReadPool");
+
+    for (unsigned int i = 0; i < rawBlocks.size(); i++) {
+      deserializePool.AddJob([&rawBlocks, &deserialized, i]() {
+        const string& blockString = rawBlocks.at(i).second;
+        deserialized.at(i) = MicroBlockSharedPtr(
+            new MicroBlock(bytes(blockString.begin(), blockString.end()), 0));
+      });
+    }
+
+    while (deserializePool.GetJobsLeft() > 0) {
+      this_thread::sleep_for(chrono::milliseconds(10));
+    }
+  }
+
+  for (unsigned int i = 0; i < deserialized.size(); i++) {
+    const MicroBlockSharedPtr& block = deserialized.at(i);
 
     if (block->GetHeader().GetEpochNum() < lowEpochNum ||
         block->GetHeader().GetEpochNum() > hiEpochNum ||
@@ -235,11 +518,9 @@ bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
     }
 
     blocks.emplace_back(block);
-    LOG_GENERAL(INFO, "Retrievd MicroBlock Num:" << bns);
+    LOG_GENERAL(INFO, "Retrievd MicroBlock Num:" << rawBlocks.at(i).first);
   }
 
-  delete it;
-
   if (blocks.empty()) {
     LOG_GENERAL(INFO, "Disk has no MicroBlock matching the criteria");
     return false;
@@ -375,6 +656,18 @@ bool BlockStorage::ReleaseDB() {
     unique_lock<shared_timed_mutex> g(m_mutexMinerInfoShards);
     m_minerInfoShardsDB.reset();
   }
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+    m_eventLogIndexDB.reset();
+  }
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+    m_txnAddressIndexDB.reset();
+  }
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+    m_txnPoolJournalDB.reset();
+  }
   return true;
 }
 
@@ -434,6 +727,15 @@ bool BlockStorage::GetBlockLink(const uint64_t& index,
 
 bool BlockStorage::GetTxBlock(const uint64_t& blockNum,
                               TxBlockSharedPtr& block) {
+  {
+    lock_guard<mutex> g(m_mutexRecentBlocks);
+    const auto it = m_recentTxBlocks.find(blockNum);
+    if (it != m_recentTxBlocks.end()) {
+      block = it->second;
+      return true;
+    }
+  }
+
   string blockString;
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
@@ -449,6 +751,37 @@ bool BlockStorage::GetTxBlock(const uint64_t& blockNum,
   return true;
 }
 
+bool BlockStorage::GetTxBlockHeader(const uint64_t& blockNum,
+                                    TxBlockHeader& header) {
+  {
+    lock_guard<mutex> g(m_mutexRecentBlocks);
+    const auto it = m_recentTxBlocks.find(blockNum);
+    if (it != m_recentTxBlocks.end()) {
+      header = it->second->GetHeader();
+      return true;
+    }
+  }
+
+  string headerString;
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexTxBlockHeader);
+    headerString = m_txBlockHeaderDB->Lookup(blockNum);
+  }
+  if (!headerString.empty()) {
+    return header.Deserialize(bytes(headerString.begin(), headerString.end()),
+                              0);
+  }
+
+  // Blocks stored before the header column existed only have the block
+  // column entry
+  TxBlockSharedPtr block;
+  if (!GetTxBlock(blockNum, block)) {
+    return false;
+  }
+  header = block->GetHeader();
+  return true;
+}
+
 bool BlockStorage::GetLatestTxBlock(TxBlockSharedPtr& block) {
   uint64_t latestTxBlockNum = 0;
 
@@ -468,7 +801,41 @@ bool BlockStorage::GetLatestTxBlock(TxBlockSharedPtr& block) {
   return GetTxBlock(latestTxBlockNum, block);
 }
 
+bool BlockStorage::CheckTxBodyMissCache(
+    const dev::h256& key, const unordered_set<dev::h256>& cache) {
+  lock_guard<mutex> g(m_mutexTxBodyMissCache);
+  if (cache.find(key) != cache.end()) {
+    m_txBodyMissCacheHits++;
+    return true;
+  }
+  m_txBodyMissCacheMisses++;
+  return false;
+}
+
+void BlockStorage::AddToTxBodyMissCache(const dev::h256& key,
+                                        unordered_set<dev::h256>& cache,
+                                        deque<dev::h256>& order) {
+  lock_guard<mutex> g(m_mutexTxBodyMissCache);
+  if (!cache.insert(key).second) {
+    return;
+  }
+  order.push_back(key);
+  if (order.size() > TX_BODY_MISS_CACHE_MAX_ENTRIES) {
+    cache.erase(order.front());
+    order.pop_front();
+  }
+}
+
+void BlockStorage::GetTxBodyMissCacheStats(uint64_t& hits, uint64_t& misses) {
+  hits = m_txBodyMissCacheHits;
+  misses = m_txBodyMissCacheMisses;
+}
+
 bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
+  if (CheckTxBodyMissCache(key, m_txBodyMissCache)) {
+    return false;
+  }
+
   std::string bodyString;
 
   {
@@ -477,6 +844,7 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   }
 
   if (bodyString.empty()) {
+    AddToTxBodyMissCache(key, m_txBodyMissCache, m_txBodyMissOrder);
     return false;
   }
   body = TxBodySharedPtr(new TransactionWithReceipt(
@@ -485,6 +853,60 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
   return true;
 }
 
+bool BlockStorage::GetTxBodies(const std::vector<dev::h256>& keys,
+                               std::vector<TxBodySharedPtr>& bodies) {
+  bodies.assign(keys.size(), nullptr);
+
+  // Only keys not already known to be absent hit the DB
+  std::vector<dev::h256> dbKeys;
+  std::vector<size_t> dbKeyPositions;
+  dbKeys.reserve(keys.size());
+  dbKeyPositions.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!CheckTxBodyMissCache(keys[i], m_txBodyMissCache)) {
+      dbKeys.emplace_back(keys[i]);
+      dbKeyPositions.emplace_back(i);
+    }
+  }
+
+  std::vector<std::string> bodyStrings;
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexTxBody);
+    bodyStrings = m_txBodyDB->MultiLookup(dbKeys);
+  }
+
+  bool found = false;
+  for (size_t i = 0; i < dbKeys.size(); i++) {
+    if (bodyStrings[i].empty()) {
+      AddToTxBodyMissCache(dbKeys[i], m_txBodyMissCache, m_txBodyMissOrder);
+      continue;
+    }
+    bodies[dbKeyPositions[i]] = TxBodySharedPtr(new TransactionWithReceipt(
+        bytes(bodyStrings[i].begin(), bodyStrings[i].end()), 0));
+    found = true;
+  }
+
+  return found;
+}
+
+bool BlockStorage::GetTxnReceipt(const dev::h256& key,
+                                 TxnReceiptSharedPtr& receipt) {
+  std::string receiptString;
+
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+    receiptString = m_txnReceiptDB->Lookup(key);
+  }
+
+  if (receiptString.empty()) {
+    return false;
+  }
+
+  receipt = make_shared<TransactionReceipt>();
+  return receipt->Deserialize(bytes(receiptString.begin(), receiptString.end()),
+                              0);
+}
+
 bool BlockStorage::CheckTxBody(const dev::h256& key) {
   shared_lock<shared_timed_mutex> g(m_mutexTxBody);
   return m_txBodyDB->Exists(key);
@@ -511,6 +933,15 @@ bool BlockStorage::DeleteFallbackBlock(const BlockHash& blockhash) {
 
 bool BlockStorage::DeleteTxBlock(const uint64_t& blocknum) {
   LOG_GENERAL(INFO, "Delete TxBlock Num: " << blocknum);
+  {
+    lock_guard<mutex> g(m_mutexRecentBlocks);
+    m_recentTxBlocks.erase(blocknum);
+    m_recentTxBlockBytes.erase(blocknum);
+  }
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexTxBlockHeader);
+    m_txBlockHeaderDB->DeleteKey(blocknum);
+  }
   unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
   int ret = m_txBlockchainDB->DeleteKey(blocknum);
   return (ret == 0);
@@ -530,6 +961,13 @@ bool BlockStorage::DeleteTxBody(const dev::h256& key) {
 }
 
 bool BlockStorage::DeleteMicroBlock(const BlockHash& blockHash) {
+  {
+    // The stale entry in m_recentMicroBlockOrder is harmless: evicting it
+    // later is a no-op erase
+    lock_guard<mutex> g(m_mutexRecentBlocks);
+    m_recentMicroBlocks.erase(blockHash);
+    m_recentMicroBlockBytes.erase(blockHash);
+  }
   unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
   int ret = m_microBlockDB->DeleteKey(blockHash);
 
@@ -946,13 +1384,43 @@ bool BlockStorage::GetShardStructure(DequeOfShard& shards) {
   return true;
 }
 
+// First byte of a stored state delta identifies its on-disk format. A raw
+// protobuf delta never begins with either value (a serialized message starts
+// with a field key of at least 0x08), so entries written before the marker
+// existed are parsed as legacy raw deltas.
+const unsigned char STATE_DELTA_FORMAT_RAW = 0x00;
+const unsigned char STATE_DELTA_FORMAT_SNAPPY = 0x01;
+
 bool BlockStorage::PutStateDelta(const uint64_t& finalBlockNum,
                                  const bytes& stateDelta) {
   LOG_MARKER();
 
+  // Compression is a node-local storage detail; the bytes exchanged over the
+  // network and hashed into block headers are always the raw delta, so a
+  // mixed-config network still agrees on the StateDeltaHash
+  bytes stored;
+  if (ENABLE_STATE_DELTA_COMPRESSION && !stateDelta.empty()) {
+    bytes compressed;
+    if (!DataCompression::Compress(stateDelta, compressed)) {
+      LOG_GENERAL(WARNING, "Failed to compress state delta of final block "
+                               << finalBlockNum);
+      return false;
+    }
+    LOG_GENERAL(INFO, "State delta compressed from "
+                          << stateDelta.size() << " to " << compressed.size()
+                          << " bytes");
+    stored.reserve(compressed.size() + 1);
+    stored.push_back(STATE_DELTA_FORMAT_SNAPPY);
+    stored.insert(stored.end(), compressed.begin(), compressed.end());
+  } else {
+    stored.reserve(stateDelta.size() + 1);
+    stored.push_back(STATE_DELTA_FORMAT_RAW);
+    stored.insert(stored.end(), stateDelta.begin(), stateDelta.end());
+  }
+
   unique_lock<shared_timed_mutex> g(m_mutexStateDelta);
 
-  if (0 != m_stateDeltaDB->Insert(finalBlockNum, stateDelta)) {
+  if (0 != m_stateDeltaDB->Insert(finalBlockNum, stored)) {
     LOG_PAYLOAD(WARNING,
                 "Failed to store state delta of final block " << finalBlockNum,
                 stateDelta, Logger::MAX_BYTES_TO_DISPLAY);
@@ -961,6 +1429,16 @@ bool BlockStorage::PutStateDelta(const uint64_t& finalBlockNum,
 
   LOG_PAYLOAD(INFO, "FinalBlock " << finalBlockNum << " state delta",
               stateDelta, Logger::MAX_BYTES_TO_DISPLAY);
+
+  // Rolling retention: deltas older than the configured window are dead
+  // weight once their state is incorporated, so drop them as new ones land.
+  // The window must span at least the epochs the retriever may replay
+  // (INCRDB_DSNUMS_WITH_STATEDELTAS DS epochs); 0 keeps everything
+  if (STATE_DELTA_RETENTION_EPOCHS > 0 &&
+      finalBlockNum >= STATE_DELTA_RETENTION_EPOCHS) {
+    m_stateDeltaDB->DeleteKey(finalBlockNum - STATE_DELTA_RETENTION_EPOCHS);
+  }
+
   return true;
 }
 
@@ -975,7 +1453,19 @@ bool BlockStorage::GetStateDelta(const uint64_t& finalBlockNum,
     dataStr = m_stateDeltaDB->Lookup(finalBlockNum, found);
   }
   if (found) {
-    stateDelta = bytes(dataStr.begin(), dataStr.end());
+    const bytes stored(dataStr.begin(), dataStr.end());
+    if (!stored.empty() && stored.front() == STATE_DELTA_FORMAT_SNAPPY) {
+      if (!DataCompression::Decompress(stored, 1, stateDelta)) {
+        LOG_GENERAL(WARNING, "Failed to decompress state delta of final block "
+                                 << finalBlockNum);
+        return false;
+      }
+    } else if (!stored.empty() && stored.front() == STATE_DELTA_FORMAT_RAW) {
+      stateDelta.assign(stored.begin() + 1, stored.end());
+    } else {
+      // Entry written before the format marker existed
+      stateDelta = stored;
+    }
     LOG_PAYLOAD(INFO, "Retrieved state delta of final block " << finalBlockNum,
                 stateDelta, Logger::MAX_BYTES_TO_DISPLAY);
   } else {
@@ -1332,6 +1822,184 @@ bool BlockStorage::GetMinerInfoShards(const uint64_t& dsBlockNum,
   return found;
 }
 
+/// address in hex followed by the epoch zero-padded to full uint64_t width,
+/// so the entries of one address are contiguous and epoch-ordered
+static string EventLogIndexKey(const string& address,
+                               const uint64_t& epochNum) {
+  ostringstream keystream;
+  keystream << address << setw(20) << setfill('0') << epochNum;
+  return keystream.str();
+}
+
+bool BlockStorage::PutEventLogIndex(
+    const uint64_t& epochNum,
+    const std::map<std::string, Json::Value>& addrToLogs) {
+  LOG_MARKER();
+
+  if (addrToLogs.empty()) {
+    return true;
+  }
+
+  unordered_map<string, string> kv;
+  for (const auto& entry : addrToLogs) {
+    kv.emplace(EventLogIndexKey(entry.first, epochNum),
+               JSONUtils::GetInstance().convertJsontoStr(entry.second));
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+
+  if (!m_eventLogIndexDB->BatchInsert(kv)) {
+    LOG_GENERAL(WARNING, "Failed to store event log index");
+    return false;
+  }
+
+  return true;
+}
+
+bool BlockStorage::GetEventLogs(const std::string& address,
+                                const uint64_t& lowEpochNum,
+                                const uint64_t& hiEpochNum,
+                                Json::Value& logs) {
+  LOG_MARKER();
+
+  const string hiKey = EventLogIndexKey(address, hiEpochNum);
+
+  shared_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+
+  leveldb::Iterator* it =
+      m_eventLogIndexDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  for (it->Seek(EventLogIndexKey(address, lowEpochNum));
+       it->Valid() && it->key().ToString() <= hiKey; it->Next()) {
+    const string key = it->key().ToString();
+    if (key.compare(0, address.size(), address) != 0) {
+      break;
+    }
+    Json::Value eventLogs;
+    if (!JSONUtils::GetInstance().convertStrtoJson(it->value().ToString(),
+                                                   eventLogs)) {
+      LOG_GENERAL(WARNING, "Corrupted event log index entry for " << key);
+      continue;
+    }
+    Json::Value entry;
+    entry["blockNum"] =
+        to_string(strtoull(key.c_str() + address.size(), NULL, 10));
+    entry["event_logs"] = std::move(eventLogs);
+    logs.append(entry);
+  }
+  delete it;
+
+  return true;
+}
+
+/// address in hex, the epoch zero-padded to full uint64_t width, then the
+/// txn hash, so one address's history is contiguous and epoch-ordered while
+/// every txn in an epoch still gets a distinct key
+static string TxnAddressIndexKey(const string& address,
+                                 const uint64_t& epochNum,
+                                 const string& txnHash) {
+  ostringstream keystream;
+  keystream << address << setw(20) << setfill('0') << epochNum << txnHash;
+  return keystream.str();
+}
+
+bool BlockStorage::PutTxnAddressIndex(
+    const uint64_t& epochNum,
+    const std::map<std::string, std::vector<std::string>>& addrToTxnHashes) {
+  LOG_MARKER();
+
+  if (addrToTxnHashes.empty()) {
+    return true;
+  }
+
+  unordered_map<string, string> kv;
+  for (const auto& entry : addrToTxnHashes) {
+    for (const auto& txnHash : entry.second) {
+      kv.emplace(TxnAddressIndexKey(entry.first, epochNum, txnHash), txnHash);
+    }
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+
+  if (!m_txnAddressIndexDB->BatchInsert(kv)) {
+    LOG_GENERAL(WARNING, "Failed to store txn address index");
+    return false;
+  }
+
+  return true;
+}
+
+bool BlockStorage::GetTxnHashesForAddress(const std::string& address,
+                                          const unsigned int page,
+                                          const unsigned int pageSize,
+                                          Json::Value& txns, bool& hasMore) {
+  LOG_MARKER();
+
+  hasMore = false;
+  uint64_t toSkip = static_cast<uint64_t>(page - 1) * pageSize;
+
+  shared_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+
+  leveldb::Iterator* it =
+      m_txnAddressIndexDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  for (it->Seek(address); it->Valid(); it->Next()) {
+    const string key = it->key().ToString();
+    if (key.compare(0, address.size(), address) != 0) {
+      break;
+    }
+    if (toSkip > 0) {
+      --toSkip;
+      continue;
+    }
+    if (txns.size() >= pageSize) {
+      hasMore = true;
+      break;
+    }
+    Json::Value entry;
+    // The key has no separator between the 20-digit epoch and the txn hash,
+    // so bound the parse to the epoch digits - strtoull would otherwise keep
+    // consuming any leading decimal digits of the hash
+    entry["blockNum"] =
+        to_string(strtoull(key.substr(address.size(), 20).c_str(), NULL, 10));
+    entry["TxnHash"] = it->value().ToString();
+    txns.append(entry);
+  }
+  delete it;
+
+  return true;
+}
+
+bool BlockStorage::PutTxnPoolJournalEntry(const dev::h256& txnHash,
+                                          const bytes& entry) {
+  unique_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+  return m_txnPoolJournalDB->Insert(txnHash, entry) == 0;
+}
+
+bool BlockStorage::DeleteTxnPoolJournalEntries(
+    const std::vector<dev::h256>& txnHashes) {
+  if (txnHashes.empty()) {
+    return true;
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+  return m_txnPoolJournalDB->BatchDelete(txnHashes);
+}
+
+bool BlockStorage::GetTxnPoolJournal(std::vector<bytes>& entries) {
+  LOG_MARKER();
+
+  shared_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+
+  leveldb::Iterator* it =
+      m_txnPoolJournalDB->GetDB()->NewIterator(leveldb::ReadOptions());
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    const string value = it->value().ToString();
+    entries.emplace_back(value.begin(), value.end());
+  }
+  delete it;
+
+  return true;
+}
+
 bool BlockStorage::ResetDB(DBTYPE type) {
   LOG_MARKER();
   bool ret = false;
@@ -1348,7 +2016,11 @@ bool BlockStorage::ResetDB(DBTYPE type) {
     }
     case TX_BLOCK: {
       unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-      ret = m_txBlockchainDB->ResetDB();
+      unique_lock<shared_timed_mutex> gh(m_mutexTxBlockHeader);
+      ret = m_txBlockchainDB->ResetDB() && m_txBlockHeaderDB->ResetDB();
+      lock_guard<mutex> gr(m_mutexRecentBlocks);
+      m_recentTxBlocks.clear();
+      m_recentTxBlockBytes.clear();
       break;
     }
     case TX_BODY: {
@@ -1364,6 +2036,10 @@ bool BlockStorage::ResetDB(DBTYPE type) {
     case MICROBLOCK: {
       unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
       ret = m_microBlockDB->ResetDB();
+      lock_guard<mutex> gr(m_mutexRecentBlocks);
+      m_recentMicroBlocks.clear();
+      m_recentMicroBlockOrder.clear();
+      m_recentMicroBlockBytes.clear();
       break;
     }
     case DS_COMMITTEE: {
@@ -1437,6 +2113,31 @@ bool BlockStorage::ResetDB(DBTYPE type) {
       ret = m_minerInfoShardsDB->ResetDB();
       break;
     }
+    case EVENT_LOG_INDEX: {
+      unique_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+      ret = m_eventLogIndexDB->ResetDB();
+      break;
+    }
+    case TXN_RECEIPT: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+      ret = m_txnReceiptDB->ResetDB();
+      break;
+    }
+    case TXN_ADDRESS_INDEX: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+      ret = m_txnAddressIndexDB->ResetDB();
+      break;
+    }
+    case DIRBLOCK_CHECKPOINT: {
+      unique_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+      ret = m_dirBlockCheckpointDB->ResetDB();
+      break;
+    }
+    case TXN_POOL_JOURNAL: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+      ret = m_txnPoolJournalDB->ResetDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Reset DB " << type << " failed");
@@ -1460,7 +2161,11 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
     }
     case TX_BLOCK: {
       unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-      ret = m_txBlockchainDB->RefreshDB();
+      unique_lock<shared_timed_mutex> gh(m_mutexTxBlockHeader);
+      ret = m_txBlockchainDB->RefreshDB() && m_txBlockHeaderDB->RefreshDB();
+      lock_guard<mutex> gr(m_mutexRecentBlocks);
+      m_recentTxBlocks.clear();
+      m_recentTxBlockBytes.clear();
       break;
     }
     case TX_BODY: {
@@ -1476,6 +2181,10 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
     case MICROBLOCK: {
       unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
       ret = m_microBlockDB->RefreshDB();
+      lock_guard<mutex> gr(m_mutexRecentBlocks);
+      m_recentMicroBlocks.clear();
+      m_recentMicroBlockOrder.clear();
+      m_recentMicroBlockBytes.clear();
       break;
     }
     case DS_COMMITTEE: {
@@ -1549,6 +2258,31 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
       ret = m_minerInfoShardsDB->RefreshDB();
       break;
     }
+    case EVENT_LOG_INDEX: {
+      unique_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+      ret = m_eventLogIndexDB->RefreshDB();
+      break;
+    }
+    case TXN_RECEIPT: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+      ret = m_txnReceiptDB->RefreshDB();
+      break;
+    }
+    case TXN_ADDRESS_INDEX: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+      ret = m_txnAddressIndexDB->RefreshDB();
+      break;
+    }
+    case DIRBLOCK_CHECKPOINT: {
+      unique_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+      ret = m_dirBlockCheckpointDB->RefreshDB();
+      break;
+    }
+    case TXN_POOL_JOURNAL: {
+      unique_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+      ret = m_txnPoolJournalDB->RefreshDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Refresh DB " << type << " failed");
@@ -1572,6 +2306,8 @@ std::vector<std::string> BlockStorage::GetDBName(DBTYPE type) {
     case TX_BLOCK: {
       shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
       ret.push_back(m_txBlockchainDB->GetDBName());
+      shared_lock<shared_timed_mutex> gh(m_mutexTxBlockHeader);
+      ret.push_back(m_txBlockHeaderDB->GetDBName());
       break;
     }
     case TX_BODY: {
@@ -1654,6 +2390,161 @@ std::vector<std::string> BlockStorage::GetDBName(DBTYPE type) {
       ret.push_back(m_minerInfoShardsDB->GetDBName());
       break;
     }
+    case EVENT_LOG_INDEX: {
+      shared_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+      ret.push_back(m_eventLogIndexDB->GetDBName());
+      break;
+    }
+    case TXN_RECEIPT: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+      ret.push_back(m_txnReceiptDB->GetDBName());
+      break;
+    }
+    case TXN_ADDRESS_INDEX: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+      ret.push_back(m_txnAddressIndexDB->GetDBName());
+      break;
+    }
+    case DIRBLOCK_CHECKPOINT: {
+      shared_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+      ret.push_back(m_dirBlockCheckpointDB->GetDBName());
+      break;
+    }
+    case TXN_POOL_JOURNAL: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+      ret.push_back(m_txnPoolJournalDB->GetDBName());
+      break;
+    }
+  }
+
+  return ret;
+}
+
+std::vector<std::string> BlockStorage::GetDBStats(DBTYPE type) {
+  std::vector<std::string> ret;
+  switch (type) {
+    case META: {
+      shared_lock<shared_timed_mutex> g(m_mutexMetadata);
+      ret.push_back(m_metadataDB->GetDBStats());
+      break;
+    }
+    case DS_BLOCK: {
+      shared_lock<shared_timed_mutex> g(m_mutexDsBlockchain);
+      ret.push_back(m_dsBlockchainDB->GetDBStats());
+      break;
+    }
+    case TX_BLOCK: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
+      ret.push_back(m_txBlockchainDB->GetDBStats());
+      shared_lock<shared_timed_mutex> gh(m_mutexTxBlockHeader);
+      ret.push_back(m_txBlockHeaderDB->GetDBStats());
+      break;
+    }
+    case TX_BODY: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxBody);
+      ret.push_back(m_txBodyDB->GetDBStats());
+      break;
+    }
+    case TX_BODY_TMP: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxBodyTmp);
+      ret.push_back(m_txBodyTmpDB->GetDBStats());
+      break;
+    }
+    case MICROBLOCK: {
+      shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+      ret.push_back(m_microBlockDB->GetDBStats());
+      break;
+    }
+    case DS_COMMITTEE: {
+      shared_lock<shared_timed_mutex> g(m_mutexDsCommittee);
+      ret.push_back(m_dsCommitteeDB->GetDBStats());
+      break;
+    }
+    case VC_BLOCK: {
+      shared_lock<shared_timed_mutex> g(m_mutexVCBlock);
+      ret.push_back(m_VCBlockDB->GetDBStats());
+      break;
+    }
+    case FB_BLOCK: {
+      shared_lock<shared_timed_mutex> g(m_mutexFallbackBlock);
+      ret.push_back(m_fallbackBlockDB->GetDBStats());
+      break;
+    }
+    case BLOCKLINK: {
+      shared_lock<shared_timed_mutex> g(m_mutexBlockLink);
+      ret.push_back(m_blockLinkDB->GetDBStats());
+      break;
+    }
+    case SHARD_STRUCTURE: {
+      shared_lock<shared_timed_mutex> g(m_mutexShardStructure);
+      ret.push_back(m_shardStructureDB->GetDBStats());
+      break;
+    }
+    case STATE_DELTA: {
+      shared_lock<shared_timed_mutex> g(m_mutexStateDelta);
+      ret.push_back(m_stateDeltaDB->GetDBStats());
+      break;
+    }
+    case TEMP_STATE: {
+      shared_lock<shared_timed_mutex> g(m_mutexTempState);
+      ret.push_back(m_tempStateDB->GetDBStats());
+      break;
+    }
+    case DIAGNOSTIC_NODES: {
+      lock_guard<mutex> g(m_mutexDiagnostic);
+      ret.push_back(m_diagnosticDBNodes->GetDBStats());
+      break;
+    }
+    case DIAGNOSTIC_COINBASE: {
+      lock_guard<mutex> g(m_mutexDiagnostic);
+      ret.push_back(m_diagnosticDBCoinbase->GetDBStats());
+      break;
+    }
+    case STATE_ROOT: {
+      shared_lock<shared_timed_mutex> g(m_mutexStateRoot);
+      ret.push_back(m_stateRootDB->GetDBStats());
+      break;
+    }
+    case PROCESSED_TEMP: {
+      shared_lock<shared_timed_mutex> g(m_mutexProcessTx);
+      ret.push_back(m_processedTxnTmpDB->GetDBStats());
+      break;
+    }
+    case MINER_INFO_DSCOMM: {
+      shared_lock<shared_timed_mutex> g(m_mutexMinerInfoDSComm);
+      ret.push_back(m_minerInfoDSCommDB->GetDBStats());
+      break;
+    }
+    case MINER_INFO_SHARDS: {
+      shared_lock<shared_timed_mutex> g(m_mutexMinerInfoShards);
+      ret.push_back(m_minerInfoShardsDB->GetDBStats());
+      break;
+    }
+    case EVENT_LOG_INDEX: {
+      shared_lock<shared_timed_mutex> g(m_mutexEventLogIndex);
+      ret.push_back(m_eventLogIndexDB->GetDBStats());
+      break;
+    }
+    case TXN_RECEIPT: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnReceipt);
+      ret.push_back(m_txnReceiptDB->GetDBStats());
+      break;
+    }
+    case TXN_ADDRESS_INDEX: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnAddressIndex);
+      ret.push_back(m_txnAddressIndexDB->GetDBStats());
+      break;
+    }
+    case DIRBLOCK_CHECKPOINT: {
+      shared_lock<shared_timed_mutex> g(m_mutexDirBlockCheckpoint);
+      ret.push_back(m_dirBlockCheckpointDB->GetDBStats());
+      break;
+    }
+    case TXN_POOL_JOURNAL: {
+      shared_lock<shared_timed_mutex> g(m_mutexTxnPoolJournal);
+      ret.push_back(m_txnPoolJournalDB->GetDBStats());
+      break;
+    }
   }
 
   return ret;
@@ -1661,6 +2552,50 @@ std::vector<std::string> BlockStorage::GetDBName(DBTYPE type) {
 
 // Don't use short-circuit logical AND (&&) here so that we attempt to reset all
 // databases
+bool BlockStorage::ExportCheckpoint(const uint64_t& epochNum,
+                                    const string& outputDir) {
+  LOG_MARKER();
+
+  // The directories that together bootstrap a replacement node: the full
+  // state (trie + contract data), the chain skeleton and its metadata
+  static const vector<string> checkpointDBs = {
+      "state",       "stateRoot",  "contractCode", "contractInitState2",
+      "contractStateData2",        "dsBlocks",     "txBlocks",
+      "blockLinks",  "dsCommittee", "shardStructure", "metadata"};
+
+  const string persistencePath = STORAGE_PATH + PERSISTENCE_PATH;
+
+  if (!boost::filesystem::exists(outputDir)) {
+    boost::filesystem::create_directories(outputDir);
+  }
+
+  ostringstream cmd;
+  cmd << "tar -C " << persistencePath << " -czf " << outputDir << "/checkpoint_"
+      << epochNum << ".tar.gz";
+  unsigned int included = 0;
+  for (const auto& dbName : checkpointDBs) {
+    if (boost::filesystem::exists(persistencePath + "/" + dbName)) {
+      cmd << " " << dbName;
+      included++;
+    }
+  }
+
+  if (included == 0) {
+    LOG_GENERAL(WARNING, "Nothing to checkpoint in " << persistencePath);
+    return false;
+  }
+
+  if (!SysCommand::ExecuteCmdWithoutOutput(cmd.str())) {
+    LOG_GENERAL(WARNING, "Checkpoint export for epoch " << epochNum
+                                                        << " failed");
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Exported checkpoint for epoch " << epochNum << " to "
+                                                     << outputDir);
+  return true;
+}
+
 bool BlockStorage::ResetAll() {
   if (!LOOKUP_NODE_MODE) {
     return ResetDB(META) & ResetDB(DS_BLOCK) & ResetDB(TX_BLOCK) &
@@ -1678,7 +2613,9 @@ bool BlockStorage::ResetAll() {
            ResetDB(STATE_DELTA) & ResetDB(TEMP_STATE) &
            ResetDB(DIAGNOSTIC_NODES) & ResetDB(DIAGNOSTIC_COINBASE) &
            ResetDB(STATE_ROOT) & ResetDB(PROCESSED_TEMP) &
-           ResetDB(MINER_INFO_DSCOMM) & ResetDB(MINER_INFO_SHARDS);
+           ResetDB(MINER_INFO_DSCOMM) & ResetDB(MINER_INFO_SHARDS) &
+           ResetDB(EVENT_LOG_INDEX) & ResetDB(TXN_RECEIPT) &
+           ResetDB(TXN_ADDRESS_INDEX);
   }
 }
 
@@ -1704,6 +2641,8 @@ bool BlockStorage::RefreshAll() {
            RefreshDB(DIAGNOSTIC_NODES) & RefreshDB(DIAGNOSTIC_COINBASE) &
            RefreshDB(STATE_ROOT) & RefreshDB(PROCESSED_TEMP) &
            RefreshDB(MINER_INFO_DSCOMM) & RefreshDB(MINER_INFO_SHARDS) &
+           RefreshDB(EVENT_LOG_INDEX) & RefreshDB(TXN_RECEIPT) &
+           RefreshDB(TXN_ADDRESS_INDEX) &
            Contract::ContractStorage2::GetContractStorage().RefreshAll();
   }
 }
\ No newline at end of file
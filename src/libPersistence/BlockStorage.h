@@ -18,13 +18,19 @@
 #ifndef ZILLIQA_SRC_LIBPERSISTENCE_BLOCKSTORAGE_H_
 #define ZILLIQA_SRC_LIBPERSISTENCE_BLOCKSTORAGE_H_
 
+#include <json/json.h>
+#include <atomic>
+#include <deque>
 #include <list>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_set>
 #include <vector>
 
 #include <Schnorr.h>
 #include "ContractStorage.h"
+#include "TxnArchive.h"
 #include "common/Singleton.h"
 #include "depends/libDatabase/LevelDB.h"
 #include "libData/BlockData/Block.h"
@@ -41,6 +47,7 @@ typedef std::shared_ptr<FallbackBlockWShardingStructure> FallbackBlockSharedPtr;
 typedef std::shared_ptr<BlockLink> BlockLinkSharedPtr;
 typedef std::shared_ptr<MicroBlock> MicroBlockSharedPtr;
 typedef std::shared_ptr<TransactionWithReceipt> TxBodySharedPtr;
+typedef std::shared_ptr<TransactionReceipt> TxnReceiptSharedPtr;
 typedef std::shared_ptr<std::pair<Address, Account>> StateSharedPtr;
 
 struct DiagnosticDataNodes {
@@ -100,13 +107,33 @@ class BlockStorage : public Singleton<BlockStorage> {
   std::shared_ptr<LevelDB> m_diagnosticDBNodes;
   std::shared_ptr<LevelDB> m_diagnosticDBCoinbase;
   std::shared_ptr<LevelDB> m_stateRootDB;
+  /// blocklink index -> DS committee hash after applying that link, recorded
+  /// once the link's cosignature has been verified (Validator::CheckDirBlocks)
+  std::shared_ptr<LevelDB> m_dirBlockCheckpointDB;
   /// used for historical data
   std::shared_ptr<LevelDB> m_txnHistoricalDB;
   std::shared_ptr<LevelDB> m_MBHistoricalDB;
+  /// sealed archive of historical txn bodies, preferred over the LevelDB
+  TxnArchive m_txnArchive;
   /// used for miner nodes (DS committee) retrieval
   std::shared_ptr<LevelDB> m_minerInfoDSCommDB;
   /// used for miner nodes (shards) retrieval
   std::shared_ptr<LevelDB> m_minerInfoShardsDB;
+  /// per-epoch contract event log index (address + epoch -> event entries)
+  std::shared_ptr<LevelDB> m_eventLogIndexDB;
+  /// receipt-only column of the txn store (txn hash -> serialized
+  /// TransactionReceipt), so receipt readers skip the txn payload
+  std::shared_ptr<LevelDB> m_txnReceiptDB;
+  /// address -> txn history index (address + epoch + txn hash keys),
+  /// populated only when ENABLE_ADDRESS_INDEX is set
+  std::shared_ptr<LevelDB> m_txnAddressIndexDB;
+  /// header-only column of the Tx block store (block num -> serialized
+  /// TxBlockHeader), so header-only readers skip the block body
+  std::shared_ptr<LevelDB> m_txBlockHeaderDB;
+  /// write-ahead journal of pooled txns on the lookup (txn hash -> shard id
+  /// + serialized txn), replayed on restart; populated only when
+  /// ENABLE_TXN_POOL_JOURNAL is set
+  std::shared_ptr<LevelDB> m_txnPoolJournalDB;
 
   BlockStorage(const std::string& path = "", bool diagnostic = false)
       : m_metadataDB(std::make_shared<LevelDB>("metadata")),
@@ -126,6 +153,8 @@ class BlockStorage : public Singleton<BlockStorage> {
         m_diagnosticDBCoinbase(
             std::make_shared<LevelDB>("diagnosticCoinb", path, diagnostic)),
         m_stateRootDB(std::make_shared<LevelDB>("stateRoot")),
+        m_dirBlockCheckpointDB(std::make_shared<LevelDB>("dirBlockCheckpoints")),
+        m_txBlockHeaderDB(std::make_shared<LevelDB>("txBlockHeaders")),
         m_diagnosticDBNodesCounter(0),
         m_diagnosticDBCoinbaseCounter(0) {
     if (LOOKUP_NODE_MODE) {
@@ -133,7 +162,12 @@ class BlockStorage : public Singleton<BlockStorage> {
       m_txBodyTmpDB = std::make_shared<LevelDB>("txBodiesTmp");
       m_minerInfoDSCommDB = std::make_shared<LevelDB>("minerInfoDSComm");
       m_minerInfoShardsDB = std::make_shared<LevelDB>("minerInfoShards");
+      m_eventLogIndexDB = std::make_shared<LevelDB>("eventLogIndex");
+      m_txnReceiptDB = std::make_shared<LevelDB>("txnReceipts");
+      m_txnAddressIndexDB = std::make_shared<LevelDB>("txnAddressIndex");
+      m_txnPoolJournalDB = std::make_shared<LevelDB>("txnPoolJournal");
     }
+    RegisterMemoryBudgetCaches();
   };
   ~BlockStorage() = default;
   bool PutBlock(const uint64_t& blockNum, const bytes& body,
@@ -160,6 +194,11 @@ class BlockStorage : public Singleton<BlockStorage> {
     PROCESSED_TEMP,
     MINER_INFO_DSCOMM,
     MINER_INFO_SHARDS,
+    EVENT_LOG_INDEX,
+    TXN_RECEIPT,
+    TXN_ADDRESS_INDEX,
+    DIRBLOCK_CHECKPOINT,
+    TXN_POOL_JOURNAL,
   };
 
   /// Returns the singleton BlockStorage instance.
@@ -175,6 +214,14 @@ class BlockStorage : public Singleton<BlockStorage> {
   bool PutFallbackBlock(const BlockHash& blockhash, const bytes& body);
   bool PutBlockLink(const uint64_t& index, const bytes& body);
 
+  /// Records the verified DS committee hash at the given blocklink index.
+  bool PutDirBlockCheckpoint(const uint64_t& index,
+                             const CommitteeHash& committeeHash);
+
+  /// Retrieves the verified DS committee hash at the given blocklink index.
+  bool GetDirBlockCheckpoint(const uint64_t& index,
+                             CommitteeHash& committeeHash);
+
   bool InitiateHistoricalDB(const std::string& path);
 
   /// Adds a Tx block to storage.
@@ -186,6 +233,16 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Adds a transaction body to storage.
   bool PutTxBody(const dev::h256& key, const bytes& body);
 
+  /// Adds a batch of transaction bodies to storage in one write per DB.
+  bool PutTxBodies(const std::unordered_map<dev::h256, bytes>& bodies);
+
+  /// Adds a transaction receipt to the receipt-only column.
+  bool PutTxnReceipt(const dev::h256& key, const bytes& receipt);
+
+  /// Adds a batch of transaction receipts to the receipt-only column in one
+  /// batched write.
+  bool PutTxnReceipts(const std::unordered_map<dev::h256, bytes>& receipts);
+
   bool PutProcessedTxBodyTmp(const dev::h256& key, const bytes& body);
 
   /// Retrieves the requested DS block.
@@ -201,6 +258,11 @@ class BlockStorage : public Singleton<BlockStorage> {
 
   bool GetLatestTxBlock(TxBlockSharedPtr& block);
 
+  /// Retrieves only the header of the requested Tx block, served from the
+  /// header column without deserializing the block body. Falls back to the
+  /// full block read for blocks stored before the header column existed.
+  bool GetTxBlockHeader(const uint64_t& blockNum, TxBlockHeader& header);
+
   bool CheckTxBody(const dev::h256& key);
 
   bool ReleaseDB();
@@ -220,8 +282,21 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieves the requested transaction body.
   bool GetTxBody(const dev::h256& key, TxBodySharedPtr& body);
 
+  /// Retrieves the requested transaction bodies in one grouped DB read.
+  /// Missing bodies are returned as null pointers at their positions.
+  /// Returns true if at least one body was found.
+  bool GetTxBodies(const std::vector<dev::h256>& keys,
+                   std::vector<TxBodySharedPtr>& bodies);
+
+  /// Retrieves only the receipt of a transaction, without deserializing the
+  /// txn payload stored in the body column.
+  bool GetTxnReceipt(const dev::h256& key, TxnReceiptSharedPtr& receipt);
+
   bool GetTxnFromHistoricalDB(const dev::h256& key, TxBodySharedPtr& body);
 
+  /// Retrieves the hit/miss counters of the negative txn body lookup cache
+  void GetTxBodyMissCacheStats(uint64_t& hits, uint64_t& misses);
+
   bool GetHistoricalMicroBlock(const BlockHash& blockhash,
                                MicroBlockSharedPtr& microblock);
 
@@ -367,6 +442,41 @@ class BlockStorage : public Singleton<BlockStorage> {
   /// Retrieves the requested miner info (shards)
   bool GetMinerInfoShards(const uint64_t& dsBlockNum, MinerInfoShards& entry);
 
+  /// Adds the contract event log index for one epoch (contract address in
+  /// hex -> event log entries emitted in that epoch) in one batched write
+  bool PutEventLogIndex(const uint64_t& epochNum,
+                        const std::map<std::string, Json::Value>& addrToLogs);
+
+  /// Retrieves indexed event logs for the address within [lowEpochNum,
+  /// hiEpochNum], one {"blockNum", "event_logs"} entry per epoch with logs
+  bool GetEventLogs(const std::string& address, const uint64_t& lowEpochNum,
+                    const uint64_t& hiEpochNum, Json::Value& logs);
+
+  /// Adds the address -> txn history index entries for one epoch (address
+  /// in hex -> hashes of the txns touching that address) in one batched
+  /// write
+  bool PutTxnAddressIndex(
+      const uint64_t& epochNum,
+      const std::map<std::string, std::vector<std::string>>& addrToTxnHashes);
+
+  /// Retrieves one page of indexed txn hashes for the address, oldest first,
+  /// skipping (page - 1) * pageSize entries; hasMore is set when further
+  /// pages exist
+  bool GetTxnHashesForAddress(const std::string& address,
+                              const unsigned int page,
+                              const unsigned int pageSize, Json::Value& txns,
+                              bool& hasMore);
+
+  /// Appends one txn to the lookup txn-pool journal (idempotent - the key is
+  /// the txn hash)
+  bool PutTxnPoolJournalEntry(const dev::h256& txnHash, const bytes& entry);
+
+  /// Drops journal entries whose txns have been dispatched
+  bool DeleteTxnPoolJournalEntries(const std::vector<dev::h256>& txnHashes);
+
+  /// Retrieves every journaled entry for replay at startup
+  bool GetTxnPoolJournal(std::vector<bytes>& entries);
+
   /// Clean a DB
   bool ResetDB(DBTYPE type);
 
@@ -375,6 +485,15 @@ class BlockStorage : public Singleton<BlockStorage> {
 
   std::vector<std::string> GetDBName(DBTYPE type);
 
+  /// Retrieve the underlying engine statistics (level sizes, compaction
+  /// read/write volumes) for write-amplification monitoring
+  std::vector<std::string> GetDBStats(DBTYPE type);
+
+  /// Exports a compressed checkpoint of the persistence directories a
+  /// replacement node needs to bootstrap. Call at an epoch boundary when no
+  /// writes are in flight so the copied DBs form a consistent cut
+  bool ExportCheckpoint(const uint64_t& epochNum, const std::string& outputDir);
+
   /// Clean all DB
   bool ResetAll();
 
@@ -382,8 +501,56 @@ class BlockStorage : public Singleton<BlockStorage> {
   bool RefreshAll();
 
  private:
+  /// Checks whether key is a known-absent txn body, updating the counters
+  bool CheckTxBodyMissCache(const dev::h256& key,
+                            const std::unordered_set<dev::h256>& cache);
+
+  /// Records key as a known-absent txn body, evicting the oldest entry
+  void AddToTxBodyMissCache(const dev::h256& key,
+                            std::unordered_set<dev::h256>& cache,
+                            std::deque<dev::h256>& order);
+
+  /// Adds a freshly stored Tx block to the recent-blocks memory tier
+  void AddToRecentTxBlocks(const uint64_t& blockNum,
+                           const TxBlockSharedPtr& block,
+                           const uint64_t& bodySize);
+
+  /// Adds a freshly stored micro block to the recent-blocks memory tier
+  void AddToRecentMicroBlocks(const BlockHash& blockHash, const bytes& body);
+
+  /// Wires the miss caches and the recent-blocks tier into the global
+  /// MemoryBudget registry
+  void RegisterMemoryBudgetCaches();
+
   std::mutex m_mutexDiagnostic;
 
+  // Negative-result caches for txn body lookups: clients polling or spamming
+  // hashes that do not exist would otherwise fall through to the SSTs on
+  // every GetTransaction call
+  static const unsigned int TX_BODY_MISS_CACHE_MAX_ENTRIES = 131072;
+  std::mutex m_mutexTxBodyMissCache;
+  std::unordered_set<dev::h256> m_txBodyMissCache;
+  std::deque<dev::h256> m_txBodyMissOrder;
+  std::unordered_set<dev::h256> m_txnHistoricalMissCache;
+  std::deque<dev::h256> m_txnHistoricalMissOrder;
+  std::atomic<uint64_t> m_txBodyMissCacheHits{};
+  std::atomic<uint64_t> m_txBodyMissCacheMisses{};
+
+  // In-memory tier over the newest blocks: every subsystem (DataSender,
+  // LookupServer, WebsocketServer) re-reads the current epoch's blocks right
+  // after they are stored, so serve them as already-deserialized objects
+  // instead of paying a LevelDB read plus deserialization on every call.
+  // Write-through only - LevelDB stays the source of truth
+  static const unsigned int RECENT_TX_BLOCKS_MAX_ENTRIES = 16;
+  static const unsigned int RECENT_MICRO_BLOCKS_MAX_ENTRIES = 64;
+  std::mutex m_mutexRecentBlocks;
+  std::map<uint64_t, TxBlockSharedPtr> m_recentTxBlocks;
+  std::map<BlockHash, MicroBlockSharedPtr> m_recentMicroBlocks;
+  std::deque<BlockHash> m_recentMicroBlockOrder;
+  // serialized size of each cached block, for the memory budget accounting
+  std::map<uint64_t, uint64_t> m_recentTxBlockBytes;
+  std::map<BlockHash, uint64_t> m_recentMicroBlockBytes;
+
   mutable std::shared_timed_mutex m_mutexMetadata;
   mutable std::shared_timed_mutex m_mutexDsBlockchain;
   mutable std::shared_timed_mutex m_mutexTxBlockchain;
@@ -403,6 +570,12 @@ class BlockStorage : public Singleton<BlockStorage> {
   mutable std::shared_timed_mutex m_mutexProcessTx;
   mutable std::shared_timed_mutex m_mutexMinerInfoDSComm;
   mutable std::shared_timed_mutex m_mutexMinerInfoShards;
+  mutable std::shared_timed_mutex m_mutexEventLogIndex;
+  mutable std::shared_timed_mutex m_mutexTxnReceipt;
+  mutable std::shared_timed_mutex m_mutexTxnAddressIndex;
+  mutable std::shared_timed_mutex m_mutexDirBlockCheckpoint;
+  mutable std::shared_timed_mutex m_mutexTxBlockHeader;
+  mutable std::shared_timed_mutex m_mutexTxnPoolJournal;
 
   unsigned int m_diagnosticDBNodesCounter;
   unsigned int m_diagnosticDBCoinbaseCounter;
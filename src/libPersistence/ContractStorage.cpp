@@ -451,6 +451,20 @@ bool ContractStorage::GetContractStateJson(
   return true;
 }
 
+vector<dev::h160> ContractStorage::GetContractAddresses() {
+  shared_lock<shared_timed_mutex> g(m_stateIndexMutex);
+
+  vector<dev::h160> addresses;
+
+  std::unique_ptr<leveldb::Iterator> it(
+      m_stateIndexDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    addresses.emplace_back(dev::h160(it->key().ToString()));
+  }
+
+  return addresses;
+}
+
 dev::h256 ContractStorage::GetContractStateHash(const dev::h160& address,
                                                 bool temp) {
   // LOG_MARKER();
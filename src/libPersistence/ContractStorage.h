@@ -138,6 +138,10 @@ class ContractStorage : public Singleton<ContractStorage> {
                             std::pair<Json::Value, Json::Value>& roots,
                             uint32_t& scilla_version, bool temp);
 
+  /// List the addresses that still have data in this legacy state layout;
+  /// used by the ContractStorage2 migration engine
+  std::vector<dev::h160> GetContractAddresses();
+
   /// Get the state hash of a contract account
   dev::h256 GetContractStateHash(const dev::h160& address, bool temp);
 
@@ -22,10 +22,12 @@
 #include "ScillaMessage.pb.h"
 #pragma GCC diagnostic pop
 
+#include "ContractStorage.h"
 #include "libCrypto/Sha2.h"
 #include "libMessage/Messenger.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/JsonUtils.h"
+#include "libUtils/MemoryBudget.h"
 
 #include <bits/stdc++.h>
 #include <boost/algorithm/string.hpp>
@@ -54,6 +56,40 @@ bytes ContractStorage2::GetContractCode(const dev::h160& address) {
   return DataConversion::StringToCharArray(m_codeDB.Lookup(address.hex()));
 }
 
+shared_ptr<const bytes> ContractStorage2::GetContractCodeShared(
+    const dev::h160& address, const dev::h256& codeHash) {
+  {
+    lock_guard<mutex> g(m_codeCacheMutex);
+    auto it = m_codeCache.find(codeHash);
+    if (it != m_codeCache.end()) {
+      m_codeCacheHits++;
+      m_codeCacheOrder.splice(m_codeCacheOrder.begin(), m_codeCacheOrder,
+                              it->second.second);
+      return it->second.first;
+    }
+  }
+
+  m_codeCacheMisses++;
+
+  auto code = make_shared<const bytes>(GetContractCode(address));
+  if (code->empty()) {
+    // nothing worth caching
+    return code;
+  }
+
+  lock_guard<mutex> g(m_codeCacheMutex);
+  if (m_codeCache.find(codeHash) == m_codeCache.end()) {
+    m_codeCacheOrder.push_front(codeHash);
+    m_codeCache[codeHash] = {code, m_codeCacheOrder.begin()};
+    while (m_codeCache.size() > CODE_CACHE_MAX_ENTRIES) {
+      m_codeCache.erase(m_codeCacheOrder.back());
+      m_codeCacheOrder.pop_back();
+    }
+  }
+
+  return code;
+}
+
 bool ContractStorage2::DeleteContractCode(const dev::h160& address) {
   lock_guard<mutex> g(m_codeMutex);
   return m_codeDB.DeleteKey(address.hex()) == 0;
@@ -115,7 +151,8 @@ bool ContractStorage2::FetchStateValue(const dev::h160& addr, const bytes& src,
     LOG_MARKER();
   }
 
-  lock_guard<mutex> g(m_stateDataMutex);
+  // Read-only on the state maps, so concurrent fetches may proceed together
+  shared_lock<shared_timed_mutex> g(m_stateDataMutex);
 
   foundVal = true;
 
@@ -196,11 +233,13 @@ bool ContractStorage2::FetchStateValue(const dev::h160& addr, const bytes& src,
       }
     }
     if (!found) {
-      if (m_stateDataDB.Exists(key)) {
+      const auto db_entries = FetchStateEntriesFromDB(key);
+      const auto db_found = db_entries->find(key);
+      if (db_found != db_entries->end()) {
         if (query.ignoreval()) {
           return true;
         }
-        bval = DataConversion::StringToCharArray(m_stateDataDB.Lookup(key));
+        bval = db_found->second;
       } else {
         if (query.mapdepth() == 0) {
           // for non-map value, should be existing in db otherwise error
@@ -249,11 +288,9 @@ bool ContractStorage2::FetchStateValue(const dev::h160& addr, const bytes& src,
     ++p;
   }
 
-  std::unique_ptr<leveldb::Iterator> it(
-      m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  const auto db_entries = FetchStateEntriesFromDB(key);
 
-  it->Seek({key});
-  if (!it->Valid() || it->key().ToString().compare(0, key.size(), key) != 0) {
+  if (db_entries->empty()) {
     // no entry
     if (entries.empty()) {
       foundVal = false;
@@ -269,12 +306,10 @@ bool ContractStorage2::FetchStateValue(const dev::h160& addr, const bytes& src,
       return true;
     }
     // found entries
-    for (; it->Valid() && it->key().ToString().compare(0, key.size(), key) == 0;
-         it->Next()) {
-      auto exist = entries.find(it->key().ToString());
+    for (const auto& db_entry : *db_entries) {
+      auto exist = entries.find(db_entry.first);
       if (exist == entries.end()) {
-        bytes val(it->value().data(), it->value().data() + it->value().size());
-        entries.emplace(it->key().ToString(), val);
+        entries.emplace(db_entry.first, db_entry.second);
       }
     }
   }
@@ -479,7 +514,11 @@ bool ContractStorage2::FetchStateJsonForContract(Json::Value& _json,
                                                  const string& vname,
                                                  const vector<string>& indices,
                                                  bool temp) {
-  lock_guard<mutex> g(m_stateDataMutex);
+  // a contract deployed before the layout change may still hold its state
+  // in the legacy encoding; re-encode it once before reading
+  MigrateContractStateFromLegacy(address);
+
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
 
   std::map<std::string, bytes> states;
   FetchStateDataForContract(states, address, vname, indices, temp);
@@ -491,6 +530,35 @@ bool ContractStorage2::FetchStateJsonForContract(Json::Value& _json,
                              << address.hex());
   }
 
+  return BuildStateJson(states, address, map_depth_json, _json);
+}
+
+bool ContractStorage2::FetchStateJsonForContractPaged(
+    Json::Value& _json, const dev::h160& address, const string& cursor,
+    unsigned int maxEntries, string& nextCursor, const string& vname,
+    const vector<string>& indices, bool temp) {
+  MigrateContractStateFromLegacy(address);
+
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
+
+  std::map<std::string, bytes> states;
+  FetchStateDataForKeyPaged(states, GenerateStorageKey(address, vname, indices),
+                            cursor, maxEntries, nextCursor, temp);
+
+  /// get the map depth
+  Json::Value map_depth_json;
+  if (!FetchContractFieldsMapDepth(address, map_depth_json, temp)) {
+    LOG_GENERAL(WARNING, "FetchContractFieldsMapDepth failed for contract: "
+                             << address.hex());
+  }
+
+  return BuildStateJson(states, address, map_depth_json, _json);
+}
+
+bool ContractStorage2::BuildStateJson(const std::map<std::string, bytes>& states,
+                                      const dev::h160& address,
+                                      const Json::Value& map_depth_json,
+                                      Json::Value& _json) {
   for (const auto& state : states) {
     vector<string> fragments;
     boost::split(fragments, state.first,
@@ -563,6 +631,302 @@ bool ContractStorage2::FetchStateJsonForContract(Json::Value& _json,
   return true;
 }
 
+/// Number of map levels in a Scilla type: "Map (KT) (VT)" nests further maps
+/// only in the value position, and maps cannot appear inside ADTs, so
+/// counting the Map tokens gives the depth
+unsigned int MapDepthOfType(const string& type) {
+  unsigned int depth = 0;
+  size_t pos = 0;
+  while ((pos = type.find("Map", pos)) != string::npos) {
+    const bool boundedLeft =
+        pos == 0 || type[pos - 1] == ' ' || type[pos - 1] == '(';
+    const size_t end = pos + 3;
+    const bool boundedRight =
+        end == type.size() || type[end] == ' ' || type[end] == '(';
+    if (boundedLeft && boundedRight) {
+      depth++;
+    }
+    pos = end;
+  }
+  return depth;
+}
+
+void ContractStorage2::FlattenLegacyStateValue(const Json::Value& value,
+                                               const string& keyPrefix,
+                                               unsigned int remainingDepth,
+                                               map<string, bytes>& states) {
+  if (remainingDepth == 0) {
+    states[keyPrefix] = DataConversion::StringToCharArray(
+        JSONUtils::GetInstance().convertJsontoStr(value));
+    return;
+  }
+
+  bool emptyLevel = true;
+
+  if (value.isArray()) {
+    // scilla emits map literals as [{"key": ..., "val": ...}, ...]
+    for (const auto& entry : value) {
+      if (!entry.isObject() || !entry.isMember("key") ||
+          !entry.isMember("val")) {
+        continue;
+      }
+      emptyLevel = false;
+      FlattenLegacyStateValue(
+          entry["val"],
+          keyPrefix + JSONUtils::GetInstance().convertJsontoStr(entry["key"]) +
+              SCILLA_INDEX_SEPARATOR,
+          remainingDepth - 1, states);
+    }
+  } else if (value.isObject()) {
+    // tolerate the plain-object form older state dumps used
+    for (const auto& name : value.getMemberNames()) {
+      emptyLevel = false;
+      FlattenLegacyStateValue(
+          value[name],
+          keyPrefix + "\"" + name + "\"" + SCILLA_INDEX_SEPARATOR,
+          remainingDepth - 1, states);
+    }
+  }
+
+  if (emptyLevel) {
+    // the new layout keeps a serialized empty map as placeholder
+    ProtoScillaVal emap;
+    emap.mutable_mval()->mutable_m();
+    bytes placeholder;
+    SerializeToArray(emap, placeholder, 0);
+    states[keyPrefix] = placeholder;
+  }
+}
+
+bool ContractStorage2::MigrateContractStateFromLegacy(
+    const dev::h160& address) {
+  if (m_migratedContractsDB.Exists(address.hex())) {
+    return true;
+  }
+
+  if (m_stateDataDB.Exists(
+          GenerateStorageKey(address, FIELDS_MAP_DEPTH_INDICATOR, {}))) {
+    // already in the new layout; just record it so we don't probe again
+    m_migratedContractsDB.Insert(address.hex(), bytes{'1'});
+    return true;
+  }
+
+  pair<Json::Value, Json::Value> roots;
+  uint32_t scilla_version;
+  if (!ContractStorage::GetContractStorage().GetContractStateJson(
+          address, roots, scilla_version, false)) {
+    // no usable legacy data either; nothing to migrate
+    m_migratedContractsDB.Insert(address.hex(), bytes{'1'});
+    return true;
+  }
+
+  LOG_GENERAL(INFO, "Migrating legacy contract state for " << address.hex());
+
+  map<string, bytes> states;
+  Json::Value map_depth_json = Json::objectValue;
+
+  for (const auto& item : roots.second) {
+    const string t_vname = item["vname"].asString();
+    const unsigned int depth = MapDepthOfType(item["type"].asString());
+    map_depth_json[t_vname] = depth;
+    FlattenLegacyStateValue(item["value"],
+                            GenerateStorageKey(address, t_vname, {}), depth,
+                            states);
+  }
+
+  states[GenerateStorageKey(address, FIELDS_MAP_DEPTH_INDICATOR, {})] =
+      DataConversion::StringToCharArray(
+          JSONUtils::GetInstance().convertJsontoStr(map_depth_json));
+
+  unordered_map<string, string> batch;
+  for (const auto& state : states) {
+    batch.insert(
+        {state.first, DataConversion::CharArrayToString(state.second)});
+  }
+
+  {
+    lock_guard<shared_timed_mutex> g(m_stateDataMutex);
+    if (!m_stateDataDB.BatchInsert(batch)) {
+      LOG_GENERAL(WARNING,
+                  "BatchInsert failed while migrating " << address.hex());
+      return false;
+    }
+    InvalidateStateCache();
+  }
+
+  // the immutable legacy entries are the contract's init data
+  if (!m_initDataDB.Exists(address.hex())) {
+    PutInitData(address,
+                DataConversion::StringToCharArray(
+                    JSONUtils::GetInstance().convertJsontoStr(roots.first)));
+  }
+
+  m_migratedContractsDB.Insert(address.hex(), bytes{'1'});
+
+  return true;
+}
+
+unsigned int ContractStorage2::MigrateAllLegacyContractStates() {
+  unsigned int migrated = 0;
+
+  for (const auto& address :
+       ContractStorage::GetContractStorage().GetContractAddresses()) {
+    if (m_migratedContractsDB.Exists(address.hex())) {
+      continue;
+    }
+    if (MigrateContractStateFromLegacy(address)) {
+      migrated++;
+    } else {
+      LOG_GENERAL(WARNING,
+                  "Legacy state migration failed for " << address.hex());
+    }
+  }
+
+  if (migrated > 0) {
+    LOG_GENERAL(INFO, "Migrated " << migrated
+                                  << " contracts from the legacy state layout");
+  }
+
+  return migrated;
+}
+
+shared_ptr<const map<string, bytes>> ContractStorage2::FetchStateEntriesFromDB(
+    const string& prefix) {
+  StateCacheShard& shard =
+      m_stateCacheShards[std::hash<string>()(prefix) % STATE_CACHE_NUM_SHARDS];
+
+  {
+    lock_guard<mutex> g(shard.mutex);
+    auto found = shard.entries.find(prefix);
+    if (found != shard.entries.end()) {
+      shard.order.splice(shard.order.begin(), shard.order,
+                         found->second.second);
+      m_stateCacheHits++;
+      return found->second.first;
+    }
+  }
+  m_stateCacheMisses++;
+
+  auto entries = std::make_shared<map<string, bytes>>();
+
+  std::unique_ptr<leveldb::Iterator> it(
+      m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+
+  for (it->Seek({prefix});
+       it->Valid() && it->key().ToString().compare(0, prefix.size(), prefix) == 0;
+       it->Next()) {
+    bytes val(it->value().data(), it->value().data() + it->value().size());
+    entries->emplace(it->key().ToString(), std::move(val));
+  }
+
+  {
+    lock_guard<mutex> g(shard.mutex);
+    if (shard.entries.find(prefix) == shard.entries.end()) {
+      shard.order.emplace_front(prefix);
+      shard.entries.emplace(prefix, make_pair(entries, shard.order.begin()));
+      if (shard.entries.size() > STATE_CACHE_MAX_ENTRIES_PER_SHARD) {
+        shard.entries.erase(shard.order.back());
+        shard.order.pop_back();
+      }
+    }
+  }
+
+  return entries;
+}
+
+void ContractStorage2::InvalidateStateCache() {
+  for (auto& shard : m_stateCacheShards) {
+    lock_guard<mutex> g(shard.mutex);
+    shard.entries.clear();
+    shard.order.clear();
+  }
+}
+
+void ContractStorage2::RegisterMemoryBudgetCaches() {
+  // Code entries are content-addressed and re-fetchable from m_codeDB, so
+  // evicting them under memory pressure is always safe
+  MemoryBudget::GetInstance().RegisterCache(
+      "contractStorage.codeCache", MemoryBudget::Tier::PERFORMANCE,
+      [this]() -> uint64_t {
+        lock_guard<mutex> g(m_codeCacheMutex);
+        uint64_t total = 0;
+        for (const auto& entry : m_codeCache) {
+          total += entry.second.first->size();
+        }
+        return total;
+      },
+      [this](uint64_t targetBytes) {
+        lock_guard<mutex> g(m_codeCacheMutex);
+        uint64_t total = 0;
+        for (const auto& entry : m_codeCache) {
+          total += entry.second.first->size();
+        }
+        while (total > targetBytes && !m_codeCacheOrder.empty()) {
+          const auto it = m_codeCache.find(m_codeCacheOrder.back());
+          if (it != m_codeCache.end()) {
+            total -= min<uint64_t>(total, it->second.first->size());
+            m_codeCache.erase(it);
+          }
+          m_codeCacheOrder.pop_back();
+        }
+      });
+
+  // The prefix-scan entries likewise rebuild from m_stateDataDB on the
+  // next read
+  MemoryBudget::GetInstance().RegisterCache(
+      "contractStorage.stateCache", MemoryBudget::Tier::PERFORMANCE,
+      [this]() -> uint64_t {
+        uint64_t total = 0;
+        for (auto& shard : m_stateCacheShards) {
+          lock_guard<mutex> g(shard.mutex);
+          for (const auto& entry : shard.entries) {
+            for (const auto& kv : *entry.second.first) {
+              total += kv.first.size() + kv.second.size();
+            }
+          }
+        }
+        return total;
+      },
+      [this](uint64_t targetBytes) {
+        auto entryBytes = [](const map<string, bytes>& entries) {
+          uint64_t total = 0;
+          for (const auto& kv : entries) {
+            total += kv.first.size() + kv.second.size();
+          }
+          return total;
+        };
+        uint64_t total = 0;
+        for (auto& shard : m_stateCacheShards) {
+          lock_guard<mutex> g(shard.mutex);
+          for (const auto& entry : shard.entries) {
+            total += entryBytes(*entry.second.first);
+          }
+        }
+        // evict each shard's LRU tail in round-robin sweeps so one hot
+        // shard does not keep its whole working set while others empty
+        bool evictedAny = true;
+        while (total > targetBytes && evictedAny) {
+          evictedAny = false;
+          for (auto& shard : m_stateCacheShards) {
+            if (total <= targetBytes) {
+              break;
+            }
+            lock_guard<mutex> g(shard.mutex);
+            if (shard.order.empty()) {
+              continue;
+            }
+            const auto it = shard.entries.find(shard.order.back());
+            if (it != shard.entries.end()) {
+              total -= min(total, entryBytes(*it->second.first));
+              shard.entries.erase(it);
+            }
+            shard.order.pop_back();
+            evictedAny = true;
+          }
+        }
+      });
+}
+
 void ContractStorage2::FetchStateDataForKey(map<string, bytes>& states,
                                             const string& key, bool temp) {
   std::map<std::string, bytes>::iterator p;
@@ -584,22 +948,100 @@ void ContractStorage2::FetchStateDataForKey(map<string, bytes>& states,
     ++p;
   }
 
-  std::unique_ptr<leveldb::Iterator> it(
-      m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  const auto db_entries = FetchStateEntriesFromDB(key);
+  for (const auto& db_entry : *db_entries) {
+    if (states.find(db_entry.first) == states.end()) {
+      states.emplace(db_entry.first, db_entry.second);
+    }
+  }
 
-  it->Seek({key});
-  if (!it->Valid() || it->key().ToString().compare(0, key.size(), key) != 0) {
-    // no entry
-  } else {
-    for (; it->Valid() && it->key().ToString().compare(0, key.size(), key) == 0;
+  if (temp) {
+    for (auto it = states.begin(); it != states.end();) {
+      if (t_indexToBeDeleted.find(it->first) != t_indexToBeDeleted.cend()) {
+        it = states.erase(it);
+      } else {
+        it++;
+      }
+    }
+  }
+
+  for (auto it = states.begin(); it != states.end();) {
+    if (m_indexToBeDeleted.find(it->first) != m_indexToBeDeleted.cend() &&
+        ((temp && t_stateDataMap.find(it->first) == t_stateDataMap.end()) ||
+         !temp)) {
+      it = states.erase(it);
+    } else {
+      it++;
+    }
+  }
+}
+
+void ContractStorage2::FetchStateDataForKeyPaged(
+    map<string, bytes>& states, const string& key, const string& cursor,
+    unsigned int maxEntries, string& nextCursor, bool temp) {
+  nextCursor.clear();
+  if (maxEntries == 0) {
+    return;
+  }
+
+  const string& start = cursor > key ? cursor : key;
+  // every source contributes one entry beyond the page so the merged view
+  // reveals where the next page starts
+  const unsigned int limit = maxEntries + 1;
+
+  std::map<std::string, bytes>::iterator p;
+  if (temp) {
+    unsigned int taken = 0;
+    p = t_stateDataMap.lower_bound(start);
+    while (p != t_stateDataMap.end() && taken < limit &&
+           p->first.compare(0, key.size(), key) == 0) {
+      states.emplace(p->first, p->second);
+      ++taken;
+      ++p;
+    }
+  }
+
+  {
+    unsigned int taken = 0;
+    p = m_stateDataMap.lower_bound(start);
+    while (p != m_stateDataMap.end() && taken < limit &&
+           p->first.compare(0, key.size(), key) == 0) {
+      if (states.find(p->first) == states.end()) {
+        states.emplace(p->first, p->second);
+      }
+      ++taken;
+      ++p;
+    }
+  }
+
+  // raw bounded scan on purpose: paging exists so one query never walks the
+  // whole contract, so the prefix-scan cache is bypassed here
+  {
+    unsigned int taken = 0;
+    std::unique_ptr<leveldb::Iterator> it(
+        m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+    for (it->Seek({start});
+         it->Valid() && taken < limit &&
+         it->key().ToString().compare(0, key.size(), key) == 0;
          it->Next()) {
       if (states.find(it->key().ToString()) == states.end()) {
         bytes val(it->value().data(), it->value().data() + it->value().size());
-        states.emplace(it->key().ToString(), val);
+        states.emplace(it->key().ToString(), std::move(val));
       }
+      ++taken;
     }
   }
 
+  // the merged first maxEntries + 1 keys are complete, anything beyond may
+  // not be; trim before applying the deletion masks so the cursor stays
+  // correct even when masked entries shrink the page
+  if (states.size() > maxEntries) {
+    auto cut = states.begin();
+    std::advance(cut, maxEntries);
+    nextCursor = cut->first;
+    states.erase(cut, states.end());
+  }
+
   if (temp) {
     for (auto it = states.begin(); it != states.end();) {
       if (t_indexToBeDeleted.find(it->first) != t_indexToBeDeleted.cend()) {
@@ -637,7 +1079,7 @@ void ContractStorage2::FetchUpdatedStateValuesForAddress(
     LOG_MARKER();
   }
 
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
 
   if (address == dev::h160()) {
     LOG_GENERAL(WARNING, "address provided is empty");
@@ -668,22 +1110,10 @@ void ContractStorage2::FetchUpdatedStateValuesForAddress(
       ++p;
     }
 
-    std::unique_ptr<leveldb::Iterator> it(
-        m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
-
-    it->Seek({address.hex()});
-    if (!it->Valid() || it->key().ToString().compare(0, address.hex().size(),
-                                                     address.hex()) != 0) {
-      // no entry
-    } else {
-      for (; it->Valid() && it->key().ToString().compare(
-                                0, address.hex().size(), address.hex()) == 0;
-           it->Next()) {
-        if (t_states.find(it->key().ToString()) == t_states.end()) {
-          bytes val(it->value().data(),
-                    it->value().data() + it->value().size());
-          t_states.emplace(it->key().ToString(), val);
-        }
+    const auto db_entries = FetchStateEntriesFromDB(address.hex());
+    for (const auto& db_entry : *db_entries) {
+      if (t_states.find(db_entry.first) == t_states.end()) {
+        t_states.emplace(db_entry.first, db_entry.second);
       }
     }
 
@@ -709,12 +1139,16 @@ bool ContractStorage2::CleanEmptyMapPlaceholders(const string& key) {
 
   string scankey = indices.at(0) + SCILLA_INDEX_SEPARATOR + indices.at(1) +
                    SCILLA_INDEX_SEPARATOR;
-  DeleteByIndex(scankey);  // clean root level
+  if (t_cleanedPlaceholders.emplace(scankey).second) {
+    DeleteByIndex(scankey);  // clean root level
+  }
 
   for (unsigned int i = 2; i < indices.size() - 1 /*exclude the value key*/;
        ++i) {
     scankey += indices.at(i) + SCILLA_INDEX_SEPARATOR;
-    DeleteByIndex(scankey);
+    if (t_cleanedPlaceholders.emplace(scankey).second) {
+      DeleteByIndex(scankey);
+    }
   }
   return true;
 }
@@ -735,6 +1169,10 @@ void ContractStorage2::UpdateStateData(const string& key, const bytes& value,
     t_indexToBeDeleted.erase(pos);
   }
 
+  // the key exists again (it may be an empty-map placeholder), so a later
+  // write into the same map has to re-clean it
+  t_cleanedPlaceholders.erase(key);
+
   t_stateDataMap[key] = value;
 }
 
@@ -745,7 +1183,7 @@ bool ContractStorage2::UpdateStateValue(const dev::h160& addr, const bytes& q,
     LOG_MARKER();
   }
 
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
 
   if (q_offset > q.size()) {
     LOG_GENERAL(WARNING, "Invalid query data and offset, data size "
@@ -883,7 +1321,7 @@ void ContractStorage2::UpdateStateDatasAndToDeletes(
     LOG_MARKER();
   }
 
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
 
   if (temp) {
     for (const auto& state : t_states) {
@@ -927,21 +1365,23 @@ void ContractStorage2::UpdateStateDatasAndToDeletes(
 
 void ContractStorage2::BufferCurrentState() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
   p_stateDataMap = t_stateDataMap;
   p_indexToBeDeleted = m_indexToBeDeleted;
 }
 
 void ContractStorage2::RevertPrevState() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
   t_stateDataMap = std::move(p_stateDataMap);
   m_indexToBeDeleted = std::move(p_indexToBeDeleted);
+  // conservative: re-probe placeholders touched since the snapshot
+  t_cleanedPlaceholders.clear();
 }
 
 void ContractStorage2::RevertContractStates() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
 
   for (const auto& data : r_stateDataMap) {
     if (data.second.empty()) {
@@ -967,14 +1407,14 @@ void ContractStorage2::RevertContractStates() {
 
 void ContractStorage2::InitRevertibles() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
   r_stateDataMap.clear();
   r_indexToBeDeleted.clear();
 }
 
 bool ContractStorage2::CommitStateDB() {
   LOG_MARKER();
-  lock_guard<mutex> g(m_stateDataMutex);
+  lock_guard<shared_timed_mutex> g(m_stateDataMutex);
   // copy everything into m_stateXXDB;
   // Index
   unordered_map<string, std::string> batch;
@@ -997,6 +1437,9 @@ bool ContractStorage2::CommitStateDB() {
     }
   }
 
+  // the DB just changed underneath the cached prefix scans
+  InvalidateStateCache();
+
   m_stateDataMap.clear();
   m_indexToBeDeleted.clear();
 
@@ -1008,13 +1451,14 @@ bool ContractStorage2::CommitStateDB() {
 void ContractStorage2::InitTempStateCore() {
   t_stateDataMap.clear();
   t_indexToBeDeleted.clear();
+  t_cleanedPlaceholders.clear();
 }
 
 void ContractStorage2::InitTempState(bool callFromExternal) {
   LOG_MARKER();
 
   if (callFromExternal) {
-    lock_guard<mutex> g(m_stateDataMutex);
+    lock_guard<shared_timed_mutex> g(m_stateDataMutex);
     InitTempStateCore();
   } else {
     InitTempStateCore();
@@ -1057,7 +1501,7 @@ dev::h256 ContractStorage2::GetContractStateHash(const dev::h160& address,
   }
 
   if (callFromExternal) {
-    lock_guard<mutex> g(m_stateDataMutex);
+    lock_guard<shared_timed_mutex> g(m_stateDataMutex);
     return GetContractStateHashCore(address, temp);
   } else {
     return GetContractStateHashCore(address, temp);
@@ -1074,14 +1518,18 @@ void ContractStorage2::Reset() {
     m_initDataDB.ResetDB();
   }
   {
-    lock_guard<mutex> g(m_stateDataMutex);
+    lock_guard<shared_timed_mutex> g(m_stateDataMutex);
     m_stateDataDB.ResetDB();
+    m_migratedContractsDB.ResetDB();
+
+    InvalidateStateCache();
 
     p_stateDataMap.clear();
     p_indexToBeDeleted.clear();
 
     t_stateDataMap.clear();
     t_indexToBeDeleted.clear();
+    t_cleanedPlaceholders.clear();
 
     r_stateDataMap.clear();
     r_indexToBeDeleted.clear();
@@ -1102,8 +1550,9 @@ bool ContractStorage2::RefreshAll() {
     ret = m_initDataDB.RefreshDB();
   }
   if (ret) {
-    lock_guard<mutex> g(m_stateDataMutex);
+    lock_guard<shared_timed_mutex> g(m_stateDataMutex);
     ret = m_stateDataDB.RefreshDB();
+    InvalidateStateCache();
   }
   return ret;
 }
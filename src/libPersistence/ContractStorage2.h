@@ -20,6 +20,9 @@
 
 #include <json/json.h>
 #include <leveldb/db.h>
+#include <atomic>
+#include <list>
+#include <memory>
 #include <shared_mutex>
 
 #include "common/Constants.h"
@@ -45,6 +48,10 @@ class ContractStorage2 : public Singleton<ContractStorage2> {
   LevelDB m_codeDB;
   LevelDB m_initDataDB;
   LevelDB m_stateDataDB;
+  // Per-contract migration markers: an address is present once its legacy
+  // state has been re-encoded into this layout (or it had none to migrate),
+  // so the legacy databases are probed at most once per contract
+  LevelDB m_migratedContractsDB;
 
   // Used by AccountStore
   std::map<std::string, bytes> m_stateDataMap;
@@ -65,9 +72,63 @@ class ContractStorage2 : public Singleton<ContractStorage2> {
   std::set<std::string> m_indexToBeDeleted;
   std::set<std::string> t_indexToBeDeleted;
 
+  // Placeholder keys already probed by CleanEmptyMapPlaceholders in the
+  // current temp state, so repeated writes into the same map don't re-check
+  // the same ancestor keys (each check can cost a LevelDB read)
+  std::set<std::string> t_cleanedPlaceholders;
+
   mutable std::mutex m_codeMutex;
   mutable std::mutex m_initDataMutex;
-  mutable std::mutex m_stateDataMutex;
+  // Taken shared by the Scilla IPC fetch path, so a heavy execution's state
+  // writes don't stall another interpreter's reads; all mutating paths take
+  // it exclusive
+  mutable std::shared_timed_mutex m_stateDataMutex;
+
+  // Shared immutable code cache: entries are keyed by code hash, so they
+  // are content-addressed and never need invalidation; bounded by LRU
+  // eviction
+  static const unsigned int CODE_CACHE_MAX_ENTRIES = 64;
+  mutable std::mutex m_codeCacheMutex;
+  std::list<dev::h256> m_codeCacheOrder;
+  std::unordered_map<dev::h256,
+                     std::pair<std::shared_ptr<const bytes>,
+                               std::list<dev::h256>::iterator>>
+      m_codeCache;
+  std::atomic<uint64_t> m_codeCacheHits{0};
+  std::atomic<uint64_t> m_codeCacheMisses{0};
+
+  // Sharded cache of raw m_stateDataDB prefix scans: the same hot contracts
+  // are re-read every block by both transaction execution and the query
+  // APIs, while m_stateDataDB itself only changes in CommitStateDB, which
+  // drops the whole cache. Sharded by prefix hash so concurrent readers
+  // don't serialize on one mutex; bounded by per-shard LRU eviction
+  static const unsigned int STATE_CACHE_NUM_SHARDS = 16;
+  static const unsigned int STATE_CACHE_MAX_ENTRIES_PER_SHARD = 64;
+  struct StateCacheShard {
+    std::mutex mutex;
+    std::list<std::string> order;
+    std::unordered_map<
+        std::string,
+        std::pair<std::shared_ptr<const std::map<std::string, bytes>>,
+                  std::list<std::string>::iterator>>
+        entries;
+  };
+  StateCacheShard m_stateCacheShards[STATE_CACHE_NUM_SHARDS];
+  std::atomic<uint64_t> m_stateCacheHits{0};
+  std::atomic<uint64_t> m_stateCacheMisses{0};
+
+  /// Reads all the m_stateDataDB entries whose key starts with prefix,
+  /// serving repeated scans of the same prefix from the shard cache
+  std::shared_ptr<const std::map<std::string, bytes>> FetchStateEntriesFromDB(
+      const std::string& prefix);
+
+  /// Drops all the cached prefix scans; called whenever m_stateDataDB changes
+  void InvalidateStateCache();
+
+  /// Converts flat state entries into the nested state JSON
+  bool BuildStateJson(const std::map<std::string, bytes>& states,
+                      const dev::h160& address,
+                      const Json::Value& map_depth_json, Json::Value& _json);
 
   void DeleteByPrefix(const std::string& prefix);
 
@@ -82,10 +143,25 @@ class ContractStorage2 : public Singleton<ContractStorage2> {
 
   void InitTempStateCore();
 
+  /// Wires the code and prefix-scan caches into the global MemoryBudget
+  /// registry
+  void RegisterMemoryBudgetCaches();
+
   ContractStorage2()
       : m_codeDB("contractCode"),
         m_initDataDB("contractInitState2"),
-        m_stateDataDB("contractStateData2"){};
+        m_stateDataDB("contractStateData2"),
+        m_migratedContractsDB("contractStateMigrated") {
+    RegisterMemoryBudgetCaches();
+  };
+
+  /// Flattens one legacy state value into flat storage entries under
+  /// keyPrefix, descending remainingDepth map levels; empty map levels get
+  /// the empty ProtoScillaVal placeholder the new layout expects
+  void FlattenLegacyStateValue(const Json::Value& value,
+                               const std::string& keyPrefix,
+                               unsigned int remainingDepth,
+                               std::map<std::string, bytes>& states);
 
   ~ContractStorage2() = default;
 
@@ -106,6 +182,19 @@ class ContractStorage2 : public Singleton<ContractStorage2> {
   /// Get the desired code from persistence
   bytes GetContractCode(const dev::h160& address);
 
+  /// Get the code as a shared immutable blob, cached by code hash so hot
+  /// contracts hit LevelDB only once
+  std::shared_ptr<const bytes> GetContractCodeShared(const dev::h160& address,
+                                                     const dev::h256& codeHash);
+
+  /// effectiveness counters for the shared code cache
+  uint64_t GetCodeCacheHits() const { return m_codeCacheHits; }
+  uint64_t GetCodeCacheMisses() const { return m_codeCacheMisses; }
+
+  /// effectiveness counters for the state prefix-scan cache
+  uint64_t GetStateCacheHits() const { return m_stateCacheHits; }
+  uint64_t GetStateCacheMisses() const { return m_stateCacheMisses; }
+
   /// Delete the contract code in persistence
   bool DeleteContractCode(const dev::h160& address);
 
@@ -140,9 +229,37 @@ class ContractStorage2 : public Singleton<ContractStorage2> {
                                  const std::vector<std::string>& indices = {},
                                  bool temp = false);
 
+  /// Re-encodes the contract's legacy (index-based) state into this layout
+  /// and marks it migrated; a no-op once the marker exists. Returns false
+  /// only when legacy data exists but could not be converted
+  bool MigrateContractStateFromLegacy(const dev::h160& address);
+
+  /// Walks every contract still present in the legacy layout and migrates
+  /// it; returns the number of contracts whose state was re-encoded
+  unsigned int MigrateAllLegacyContractStates();
+
   void FetchStateDataForKey(std::map<std::string, bytes>& states,
                             const std::string& key, bool temp);
 
+  /// Fetches a bounded page of the flat state entries under key, starting
+  /// from cursor (or from key itself when cursor is smaller). nextCursor is
+  /// set to the key the next page should start from, or cleared when the
+  /// scan is complete
+  void FetchStateDataForKeyPaged(std::map<std::string, bytes>& states,
+                                 const std::string& key,
+                                 const std::string& cursor,
+                                 unsigned int maxEntries,
+                                 std::string& nextCursor, bool temp);
+
+  /// Paged variant of FetchStateJsonForContract: builds the JSON for one
+  /// page of state entries so a large contract never gets serialized in one
+  /// piece
+  bool FetchStateJsonForContractPaged(
+      Json::Value& _json, const dev::h160& address, const std::string& cursor,
+      unsigned int maxEntries, std::string& nextCursor,
+      const std::string& vname = "",
+      const std::vector<std::string>& indices = {}, bool temp = false);
+
   void FetchStateDataForContract(std::map<std::string, bytes>& states,
                                  const dev::h160& address,
                                  const std::string& vname = "",
@@ -19,7 +19,9 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <chrono>
 #include <exception>
+#include <thread>
 #include <vector>
 
 #include "libData/AccountData/AccountStore.h"
@@ -27,9 +29,49 @@
 #include "libPersistence/BlockStorage.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/FileSystem.h"
+#include "libUtils/SysCommand.h"
+#include "libUtils/ThreadPool.h"
 
 Retriever::Retriever(Mediator& mediator) : m_mediator(mediator) {}
 
+bool Retriever::ImportCheckpoint() {
+  const std::string checkpointFile = STORAGE_PATH + "/checkpoint.tar.gz";
+  if (!boost::filesystem::exists(checkpointFile)) {
+    return true;
+  }
+
+  LOG_MARKER();
+
+  const std::string persistencePath = STORAGE_PATH + PERSISTENCE_PATH;
+  if (!boost::filesystem::exists(persistencePath)) {
+    boost::filesystem::create_directories(persistencePath);
+  }
+
+  if (!SysCommand::ExecuteCmdWithoutOutput("tar -C " + persistencePath +
+                                           " -xzf " + checkpointFile)) {
+    LOG_GENERAL(WARNING, "Failed to extract checkpoint " << checkpointFile);
+    return false;
+  }
+
+  // The DB handles were opened before the extraction, so point them at the
+  // imported files; the regular retrieval below then rebuilds the chain
+  // state and the account trie from them
+  if (!BlockStorage::GetBlockStorage().RefreshAll()) {
+    LOG_GENERAL(WARNING, "BlockStorage::RefreshAll failed");
+    return false;
+  }
+  if (!AccountStore::GetInstance().RefreshDB()) {
+    LOG_GENERAL(WARNING, "AccountStore::RefreshDB failed");
+    return false;
+  }
+
+  // Drop the archive so a later restart does not roll persistence back
+  boost::filesystem::remove(checkpointFile);
+
+  LOG_GENERAL(INFO, "Imported checkpoint " << checkpointFile);
+  return true;
+}
+
 bool Retriever::RetrieveTxBlocks(bool trimIncompletedBlocks) {
   LOG_MARKER();
 
@@ -138,24 +180,55 @@ bool Retriever::RetrieveTxBlocks(bool trimIncompletedBlocks) {
           }
 
           // generate state now for NUM_FINAL_BLOCK_PER_POW statedeltas
+
+          // The deltas have to be applied strictly in order, but the disk
+          // reads do not: prefetch the whole window on a worker pool while
+          // the main thread deserializes in order
+          const unsigned int numDeltas = i - firstStateDeltaIndex + 1;
+          std::vector<std::pair<bool, bytes>> preloadedDeltas(numDeltas);
+          std::vector<TxBlockSharedPtr> preloadedTxBlocks(numDeltas);
+          {
+            const unsigned int NUMTHREADS = std::min(
+                numDeltas, std::max(1u, std::thread::hardware_concurrency()));
+            ThreadPool preloadPool(NUMTHREADS, "StatePreloadPool",
+                                   NUMA_STORAGE_THREADS_CPUS);
+            for (unsigned int j = firstStateDeltaIndex; j <= i; j++) {
+              preloadPool.AddJob([j, firstStateDeltaIndex, &preloadedDeltas,
+                                  &preloadedTxBlocks]() {
+                const unsigned int idx = j - firstStateDeltaIndex;
+                bytes stateDelta;
+                if (BlockStorage::GetBlockStorage().GetStateDelta(
+                        j, stateDelta)) {
+                  preloadedDeltas.at(idx) =
+                      std::make_pair(true, std::move(stateDelta));
+                  BlockStorage::GetBlockStorage().GetTxBlock(
+                      j, preloadedTxBlocks.at(idx));
+                }
+              });
+            }
+            while (preloadPool.GetJobsLeft() > 0) {
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+          }
+
           for (unsigned int j = firstStateDeltaIndex; j <= i; j++) {
-            bytes stateDelta;
+            const unsigned int idx = j - firstStateDeltaIndex;
             LOG_GENERAL(
                 INFO,
                 "Try fetching statedelta and deserializing to state for txnBlk:"
                     << j);
-            if (BlockStorage::GetBlockStorage().GetStateDelta(j, stateDelta)) {
-              if (!AccountStore::GetInstance().DeserializeDelta(stateDelta,
-                                                                0)) {
+            if (preloadedDeltas.at(idx).first) {
+              if (!AccountStore::GetInstance().DeserializeDelta(
+                      preloadedDeltas.at(idx).second, 0)) {
                 LOG_GENERAL(
                     WARNING,
                     "AccountStore::GetInstance().DeserializeDelta failed");
                 return false;
               }
 
-              TxBlockSharedPtr txBlockPerDelta;
-              if (!BlockStorage::GetBlockStorage().GetTxBlock(
-                      j, txBlockPerDelta)) {
+              const TxBlockSharedPtr& txBlockPerDelta =
+                  preloadedTxBlocks.at(idx);
+              if (txBlockPerDelta == nullptr) {
                 LOG_GENERAL(WARNING, "GetTxBlock failed for " << j);
                 return false;
               }
@@ -30,6 +30,9 @@ class Retriever {
  public:
   Retriever(Mediator& mediator);
 
+  /// Seeds persistence from a checkpoint archive dropped at
+  /// STORAGE_PATH/checkpoint.tar.gz; a no-op when none is present
+  bool ImportCheckpoint();
   bool RetrieveTxBlocks(bool trimIncompletedBlocks);
   bool RetrieveBlockLink(bool trimIncompletedBlocks);
   bool RetrieveStates();
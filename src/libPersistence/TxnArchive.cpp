@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <leveldb/db.h>
+#include <boost/filesystem.hpp>
+
+#include "TxnArchive.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+const string TXN_ARCHIVE_DATA_FILE = "txbodies.dat";
+const string TXN_ARCHIVE_INDEX_FILE = "txbodies.idx";
+const char TXN_ARCHIVE_MAGIC[8] = {'Z', 'I', 'L', 'T', 'X', 'A', 'R', '1'};
+
+bool MapFileReadOnly(const string& fileName, void*& mapping, uint64_t& size) {
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+  mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+    return false;
+  }
+
+  size = st.st_size;
+  return true;
+}
+
+}  // namespace
+
+TxnArchive::~TxnArchive() { Unload(); }
+
+bool TxnArchive::Load(const string& path) {
+  Unload();
+
+  void* indexMapping = nullptr;
+  uint64_t indexSize = 0;
+  if (!MapFileReadOnly(path + "/" + TXN_ARCHIVE_INDEX_FILE, indexMapping,
+                       indexSize)) {
+    return false;
+  }
+
+  const uint64_t headerSize = sizeof(TXN_ARCHIVE_MAGIC) + sizeof(uint64_t);
+  if (indexSize < headerSize ||
+      memcmp(indexMapping, TXN_ARCHIVE_MAGIC, sizeof(TXN_ARCHIVE_MAGIC)) !=
+          0) {
+    LOG_GENERAL(WARNING, "Txn archive index in " << path << " is malformed");
+    munmap(indexMapping, indexSize);
+    return false;
+  }
+
+  uint64_t numEntries = 0;
+  memcpy(&numEntries,
+         static_cast<const unsigned char*>(indexMapping) +
+             sizeof(TXN_ARCHIVE_MAGIC),
+         sizeof(numEntries));
+  if (indexSize != headerSize + numEntries * sizeof(IndexEntry)) {
+    LOG_GENERAL(WARNING, "Txn archive index in " << path << " is truncated");
+    munmap(indexMapping, indexSize);
+    return false;
+  }
+
+  void* dataMapping = nullptr;
+  uint64_t dataSize = 0;
+  if (!MapFileReadOnly(path + "/" + TXN_ARCHIVE_DATA_FILE, dataMapping,
+                       dataSize)) {
+    LOG_GENERAL(WARNING, "Txn archive data file in " << path << " is missing");
+    munmap(indexMapping, indexSize);
+    return false;
+  }
+
+  m_indexMapping = indexMapping;
+  m_indexMappingSize = indexSize;
+  m_indexEntries = reinterpret_cast<const IndexEntry*>(
+      static_cast<const unsigned char*>(indexMapping) + headerSize);
+  m_numEntries = numEntries;
+  m_data = static_cast<const unsigned char*>(dataMapping);
+  m_dataSize = dataSize;
+
+  LOG_GENERAL(INFO, "Loaded txn archive with " << m_numEntries
+                                               << " bodies from " << path);
+  return true;
+}
+
+void TxnArchive::Unload() {
+  if (m_indexMapping != nullptr) {
+    munmap(m_indexMapping, m_indexMappingSize);
+  }
+  if (m_data != nullptr) {
+    munmap(const_cast<unsigned char*>(m_data), m_dataSize);
+  }
+  m_indexMapping = nullptr;
+  m_indexMappingSize = 0;
+  m_indexEntries = nullptr;
+  m_numEntries = 0;
+  m_data = nullptr;
+  m_dataSize = 0;
+}
+
+bool TxnArchive::Get(const dev::h256& key, bytes& body) const {
+  if (!IsLoaded()) {
+    return false;
+  }
+
+  const IndexEntry* end = m_indexEntries + m_numEntries;
+  const IndexEntry* entry = lower_bound(
+      m_indexEntries, end, key, [](const IndexEntry& lhs, const dev::h256& k) {
+        return memcmp(lhs.hash, k.data(), dev::h256::size) < 0;
+      });
+  if (entry == end || memcmp(entry->hash, key.data(), dev::h256::size) != 0) {
+    return false;
+  }
+
+  if (entry->offset + entry->size > m_dataSize) {
+    LOG_GENERAL(WARNING, "Txn archive entry for " << key.hex()
+                                                  << " is out of bounds");
+    return false;
+  }
+
+  body.assign(m_data + entry->offset, m_data + entry->offset + entry->size);
+  return true;
+}
+
+bool TxnArchive::BuildFromLevelDB(LevelDB& db, const string& path) {
+  LOG_MARKER();
+
+  // Collect the bodies and sort the index by txhash so the reader can
+  // binary-search it
+  vector<pair<dev::h256, string>> entries;
+  {
+    leveldb::Iterator* it = db.GetDB()->NewIterator(leveldb::ReadOptions());
+    for (it->SeekToFirst(); it->Valid(); it->Next()) {
+      const string keyString = it->key().ToString();
+      if (keyString.size() != dev::h256::size * 2) {
+        LOG_GENERAL(WARNING, "Skipping entry with unexpected key " << keyString);
+        continue;
+      }
+      entries.emplace_back(dev::h256(keyString), it->value().ToString());
+    }
+    delete it;
+  }
+
+  sort(entries.begin(), entries.end(),
+       [](const pair<dev::h256, string>& lhs,
+          const pair<dev::h256, string>& rhs) { return lhs.first < rhs.first; });
+
+  if (!boost::filesystem::exists(path)) {
+    boost::filesystem::create_directories(path);
+  }
+
+  ofstream dataFile(path + "/" + TXN_ARCHIVE_DATA_FILE,
+                    ios::binary | ios::trunc);
+  ofstream indexFile(path + "/" + TXN_ARCHIVE_INDEX_FILE,
+                     ios::binary | ios::trunc);
+  if (!dataFile.is_open() || !indexFile.is_open()) {
+    LOG_GENERAL(WARNING, "Cannot create txn archive files in " << path);
+    return false;
+  }
+
+  indexFile.write(TXN_ARCHIVE_MAGIC, sizeof(TXN_ARCHIVE_MAGIC));
+  const uint64_t numEntries = entries.size();
+  indexFile.write(reinterpret_cast<const char*>(&numEntries),
+                  sizeof(numEntries));
+
+  uint64_t offset = 0;
+  for (const auto& entry : entries) {
+    dataFile.write(entry.second.data(), entry.second.size());
+
+    IndexEntry indexEntry{};
+    memcpy(indexEntry.hash, entry.first.data(), dev::h256::size);
+    indexEntry.offset = offset;
+    indexEntry.size = entry.second.size();
+    indexFile.write(reinterpret_cast<const char*>(&indexEntry),
+                    sizeof(indexEntry));
+
+    offset += entry.second.size();
+  }
+
+  dataFile.close();
+  indexFile.close();
+  if (!dataFile || !indexFile) {
+    LOG_GENERAL(WARNING, "Writing txn archive to " << path << " failed");
+    return false;
+  }
+
+  LOG_GENERAL(INFO, "Sealed " << numEntries << " txn bodies (" << offset
+                              << " bytes) into " << path);
+  return true;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBPERSISTENCE_TXNARCHIVE_H_
+#define ZILLIQA_SRC_LIBPERSISTENCE_TXNARCHIVE_H_
+
+#include <string>
+
+#include "common/BaseType.h"
+#include "depends/common/FixedHash.h"
+#include "depends/libDatabase/LevelDB.h"
+
+/// Append-only, mmap-readable archive of historical transaction bodies.
+///
+/// Historical bodies are immutable after finality, so instead of paying
+/// LevelDB compaction and index overhead forever they can be sealed into two
+/// flat files: a data file holding the serialized bodies back to back, and an
+/// index file holding a table of (txhash, offset, size) entries sorted by
+/// txhash. Both files are mapped read-only and a lookup binary-searches the
+/// index, so it touches only the index pages and the pages of the one body
+/// requested.
+class TxnArchive {
+ public:
+  TxnArchive() = default;
+  ~TxnArchive();
+
+  TxnArchive(const TxnArchive&) = delete;
+  TxnArchive& operator=(const TxnArchive&) = delete;
+
+  /// Maps the archive files under path; returns false if absent or malformed
+  bool Load(const std::string& path);
+
+  /// Unmaps the archive files
+  void Unload();
+
+  /// Returns whether an archive is currently mapped
+  bool IsLoaded() const { return m_indexEntries != nullptr; }
+
+  /// Retrieves the serialized body for the given txhash
+  bool Get(const dev::h256& key, bytes& body) const;
+
+  /// Seals all the entries of a txBodies LevelDB into an archive under path
+  static bool BuildFromLevelDB(LevelDB& db, const std::string& path);
+
+ private:
+  struct IndexEntry {
+    unsigned char hash[dev::h256::size];
+    uint64_t offset;
+    uint32_t size;
+  } __attribute__((packed));
+
+  const unsigned char* m_data = nullptr;
+  uint64_t m_dataSize = 0;
+  const IndexEntry* m_indexEntries = nullptr;
+  uint64_t m_numEntries = 0;
+  void* m_indexMapping = nullptr;
+  uint64_t m_indexMappingSize = 0;
+};
+
+#endif  // ZILLIQA_SRC_LIBPERSISTENCE_TXNARCHIVE_H_
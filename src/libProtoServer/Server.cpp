@@ -86,7 +86,7 @@ uint256_t Server::GetNumTransactions(uint64_t blockNum) {
 
   uint64_t i, res = 0;
   for (i = blockNum + 1; i <= currBlockNum; i++) {
-    res += m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+    res += m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
   }
 
   return res;
@@ -182,7 +182,7 @@ CreateTransactionResponse Server::CreateTransaction(
       return ret;
     }
 
-    unsigned int num_shards = m_mediator.m_lookup->GetShardPeers().size();
+    unsigned int num_shards = m_mediator.GetEpochContext()->numShards;
 
     const PubKey& senderPubKey = tx.GetSenderPubKey();
     const Address fromAddr = Account::GetAddressFromPublicKey(senderPubKey);
@@ -752,7 +752,7 @@ StringResponse Server::GetNumTransactions() {
   if (m_BlockTxPair.first < currBlock) {
     for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
       m_BlockTxPair.second +=
-          m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+          m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
     }
   }
   m_BlockTxPair.first = currBlock;
@@ -1024,7 +1024,7 @@ ProtoBlockListing Server::TxBlockListing(ProtoPage& protoPage) {
   if (m_TxBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlock(0).GetHeader();
+      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlockHeader(0);
       SHA2<HashType::HASH_VARIANT_256> sha2;
       bytes vec;
       txhead.Serialize(vec, 0);
@@ -1047,15 +1047,13 @@ ProtoBlockListing Server::TxBlockListing(ProtoPage& protoPage) {
 
   if (currBlockNum > m_TxBlockCache.first) {
     for (uint64_t i = m_TxBlockCache.first + 1; i < currBlockNum; i++) {
-      m_TxBlockCache.second.insert_new(m_TxBlockCache.second.size(),
-                                       m_mediator.m_txBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+      m_TxBlockCache.second.insert_new(
+          m_TxBlockCache.second.size(),
+          m_mediator.m_txBlockChain.GetBlockHeader(i + 1).GetPrevHash().hex());
     }
     // for the latest block
     TxBlockHeader txhead =
-        m_mediator.m_txBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_txBlockChain.GetBlockHeader(currBlockNum);
     SHA2<HashType::HASH_VARIANT_256> sha2;
     bytes vec;
     txhead.Serialize(vec, 0);
@@ -1088,8 +1086,7 @@ ProtoBlockListing Server::TxBlockListing(ProtoPage& protoPage) {
          i++) {
       auto blockData = ret.add_data();
       blockData->set_hash(
-          m_mediator.m_txBlockChain.GetBlock(currBlockNum - i + 1)
-              .GetHeader()
+          m_mediator.m_txBlockChain.GetBlockHeader(currBlockNum - i + 1)
               .GetPrevHash()
               .hex());
       blockData->set_blocknum(int(currBlockNum - i));
@@ -1191,25 +1188,23 @@ StringResponse Server::GetNumTxnsDSEpoch() {
 
     if (latestTxBlockNum > m_TxBlockCountSumPair.first) {
       // Case where the DS Epoch is same
-      if (m_mediator.m_txBlockChain.GetBlock(m_TxBlockCountSumPair.first)
-              .GetHeader()
+      if (m_mediator.m_txBlockChain.GetBlockHeader(m_TxBlockCountSumPair.first)
               .GetDSBlockNum() == latestDSBlockNum) {
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
         }
 
       } else {  // Case if DS Epoch Changed
         m_TxBlockCountSumPair.second = 0;
 
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          if (m_mediator.m_txBlockChain.GetBlock(i)
-                  .GetHeader()
-                  .GetDSBlockNum() < latestDSBlockNum) {
+          if (m_mediator.m_txBlockChain.GetBlockHeader(i).GetDSBlockNum() <
+              latestDSBlockNum) {
             break;
           }
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
         }
       }
 
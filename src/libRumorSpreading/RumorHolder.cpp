@@ -18,6 +18,7 @@
 #include "RumorHolder.h"
 #include "common/Constants.h"
 #include "libUtils/Logger.h"
+#include "libUtils/RandomGenerator.h"
 
 #include <random>
 
@@ -35,6 +36,8 @@ std::map<RumorHolder::StatisticKey, std::string>
         {StatisticKey::NumEmptyPushMessages, LITERAL(NumEmptyPushMessages)},
         {StatisticKey::NumLazyPullMessages, LITERAL(NumLazyPullMessages)},
         {StatisticKey::NumEmptyPullMessages, LITERAL(NumEmptyPullMessages)},
+        {StatisticKey::NumConvergedRumors, LITERAL(NumConvergedRumors)},
+        {StatisticKey::RoundsToQuiescence, LITERAL(RoundsToQuiescence)},
 };
 
 // PRIVATE METHODS
@@ -48,11 +51,8 @@ void RumorHolder::toVector(const std::unordered_set<int>& peers) {
 }
 
 int RumorHolder::chooseRandomMember() {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-  std::uniform_int_distribution<int> dis(0,
-                                         static_cast<int>(m_peers.size() - 1));
-  return m_peers[dis(gen)];
+  return m_peers[RandomGenerator::GetRandomInt(
+      static_cast<int>(m_peers.size()))];
 }
 
 void RumorHolder::increaseStatValue(StatisticKey key, double value) {
@@ -154,6 +154,7 @@ RumorHolder::RumorHolder(const RumorHolder& other)
       m_peers(other.m_peers),
       m_peersInCurrentRound(other.m_peersInCurrentRound),
       m_rumors(other.m_rumors),
+      m_oldRumors(other.m_oldRumors),
       m_mutex(),
       m_nextMemberCb(other.m_nextMemberCb),
       m_nonPriorityPeers(other.m_nonPriorityPeers),
@@ -167,6 +168,7 @@ RumorHolder::RumorHolder(RumorHolder&& other) noexcept
       m_peers(std::move(other.m_peers)),
       m_peersInCurrentRound(std::move(other.m_peersInCurrentRound)),
       m_rumors(std::move(other.m_rumors)),
+      m_oldRumors(std::move(other.m_oldRumors)),
       m_mutex(),
       m_nextMemberCb(std::move(other.m_nextMemberCb)),
       m_nonPriorityPeers(std::move(other.m_nonPriorityPeers)),
@@ -176,6 +178,9 @@ RumorHolder::RumorHolder(RumorHolder&& other) noexcept
 // PUBLIC METHODS
 bool RumorHolder::addRumor(int rumorId) {
   std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  if (m_oldRumors.count(rumorId) > 0) {
+    return false;
+  }
   return m_rumors.insert(std::make_pair(rumorId, &m_networkConfig)).second;
 }
 
@@ -217,7 +222,8 @@ std::pair<int, std::vector<Message>> RumorHolder::receivedMessage(
   if (receivedRumorId >= 0) {
     if (m_rumors.count(receivedRumorId) > 0) {
       m_rumors.at(receivedRumorId).rumorReceived(fromPeer, message.rounds());
-    } else {
+    } else if (m_oldRumors.count(receivedRumorId) == 0) {
+      // a retired rumor is fully spread; do not resurrect its state machine
       m_rumors.insert(std::make_pair(
           receivedRumorId,
           RumorStateMachine(&m_networkConfig, fromPeer, theirRound)));
@@ -258,8 +264,25 @@ std::pair<std::vector<int>, std::vector<Message>> RumorHolder::advanceRound() {
     // So lets set it to bare min. default.
     maxRetry = MAX_RETRY;
   }
+
+  // Draw a round's worth of random candidates in one batch rather than one
+  // engine access per pick; refilled in the unlikely case retries burn
+  // through the batch
+  std::vector<int> candidateDraws;
+  size_t candidateIdx = 0;
+
   while (neighborC < m_maxNeighborsPerRound && retryCount < maxRetry) {
-    toMember = m_nextMemberCb ? m_nextMemberCb() : chooseRandomMember();
+    if (m_nextMemberCb) {
+      toMember = m_nextMemberCb();
+    } else {
+      if (candidateIdx >= candidateDraws.size()) {
+        RandomGenerator::GetRandomInts(candidateDraws,
+                                       m_maxNeighborsPerRound + MAX_RETRY,
+                                       static_cast<int>(m_peers.size()));
+        candidateIdx = 0;
+      }
+      toMember = m_peers[candidateDraws[candidateIdx++]];
+    }
     if (tmp.count(toMember) == 0  // checks if not already found
         && m_nonPriorityPeers.count(toMember) ==
                0)  // checks if it is not a part of Non-PriorityPeers.
@@ -300,19 +323,27 @@ std::pair<std::vector<int>, std::vector<Message>> RumorHolder::advanceRound() {
   }
   m_nonPriorityPeers.clear();
 
-  // Construct the push messages
+  // Construct the push messages, retiring rumors that finished spreading so
+  // the next tick does not walk them again
   std::vector<Message> pushMessages;
-  for (auto& r : m_rumors) {
-    RumorStateMachine& stateMach = r.second;
+  for (auto iter = m_rumors.begin(); iter != m_rumors.end();) {
+    RumorStateMachine& stateMach = iter->second;
 
-    if (stateMach.isOld()) {
-      continue;
+    if (!stateMach.isOld()) {
+      stateMach.advanceRound(m_peersInCurrentRound);
     }
 
-    stateMach.advanceRound(m_peersInCurrentRound);
-    if (!stateMach.isOld()) {
+    if (stateMach.isOld()) {
+      // Rounds-to-quiescence per retired rumor; consumers derive the average
+      // convergence speed of this holder's lifetime from the two counters
+      increaseStatValue(StatisticKey::NumConvergedRumors, 1);
+      increaseStatValue(StatisticKey::RoundsToQuiescence, stateMach.rounds());
+      m_oldRumors.insert(iter->first);
+      iter = m_rumors.erase(iter);
+    } else {
       pushMessages.emplace_back(
-          Message(Message::Type::LAZY_PUSH, r.first, r.second.rounds()));
+          Message(Message::Type::LAZY_PUSH, iter->first, stateMach.rounds()));
+      ++iter;
     }
   }
   increaseStatValue(StatisticKey::NumLazyPushMessages, pushMessages.size());
@@ -348,7 +379,12 @@ const std::map<RumorHolder::StatisticKey, double>& RumorHolder::statistics()
 
 bool RumorHolder::rumorExists(int rumorId) const {
   std::lock_guard<std::mutex> guard(m_mutex);  // critical section
-  return m_rumors.count(rumorId) > 0;
+  return m_rumors.count(rumorId) > 0 || m_oldRumors.count(rumorId) > 0;
+}
+
+bool RumorHolder::isOld(int rumorId) const {
+  std::lock_guard<std::mutex> guard(m_mutex);  // critical section
+  return m_oldRumors.count(rumorId) > 0;
 }
 
 std::ostream& RumorHolder::printStatistics(std::ostream& outStream) const {
@@ -46,6 +46,8 @@ class RumorHolder : public RumorSpreadingInterface {
     NumEmptyPushMessages,
     NumLazyPullMessages,
     NumEmptyPullMessages,
+    NumConvergedRumors,
+    RoundsToQuiescence,
   };
 
   static std::map<StatisticKey, std::string> s_enumKeyToString;
@@ -57,6 +59,10 @@ class RumorHolder : public RumorSpreadingInterface {
   std::vector<int> m_peers;
   std::unordered_set<int> m_peersInCurrentRound;
   std::unordered_map<int, RumorStateMachine> m_rumors;
+  // Rumors whose state machines reached OLD, retired out of 'm_rumors' so
+  // round ticks and PULL construction only walk rumors still spreading;
+  // within an epoch the set of finished rumors otherwise grows unbounded
+  std::unordered_set<int> m_oldRumors;
   mutable std::mutex m_mutex;
   NextMemberCb m_nextMemberCb;
   std::unordered_set<int> m_nonPriorityPeers;
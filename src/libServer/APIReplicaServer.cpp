@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "APIReplicaServer.h"
+
+#include "libPersistence/BlockStorage.h"
+#include "libPersistence/Retriever.h"
+
+using namespace jsonrpc;
+using namespace std;
+
+APIReplicaServer::APIReplicaServer(Mediator& mediator,
+                                   AbstractServerConnector& server)
+    : LookupServer(mediator, server),
+      jsonrpc::AbstractServer<APIReplicaServer>(server,
+                                                jsonrpc::JSONRPC_SERVER_V2) {
+  // only the read subset of the LookupServer methods is exposed; anything
+  // mutating (CreateTransaction) stays on the primary
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetNetworkId", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetNetworkIdI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTransaction", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetTransactionI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTransactionsBatch", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_ARRAY,
+                         NULL),
+      &LookupServer::GetTransactionsBatchI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetEventLogs", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING,
+                         "param02", jsonrpc::JSON_STRING, "param03",
+                         jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetEventLogsI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTransactionsForAddress",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         "param01", jsonrpc::JSON_STRING, "param02",
+                         jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetTransactionsForAddressI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetDsBlock", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetDsBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTxBlock", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetTxBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetLatestDsBlock", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &LookupServer::GetLatestDsBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetLatestTxBlock", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &LookupServer::GetLatestTxBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetBalance", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetBalanceI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetAccountProof", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetAccountProofI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContracts", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetSmartContractsI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetContractAddressFromTransactionID",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_STRING,
+                         "param01", jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetContractAddressFromTransactionIDI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetNumTxBlocks", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetNumTxBlocksI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetNumDSBlocks", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetNumDSBlocksI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure(
+          "GetSmartContractSubState", jsonrpc::PARAMS_BY_POSITION,
+          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING, "param02",
+          jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_ARRAY, NULL),
+      &LookupServer::GetSmartContractSubStateI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure(
+          "GetSmartContractSubStateBatch", jsonrpc::PARAMS_BY_POSITION,
+          jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING, "param02",
+          jsonrpc::JSON_ARRAY, NULL),
+      &LookupServer::GetSmartContractSubStateBatchI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContractState", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetSmartContractStateI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure(
+          "GetSmartContractStatePage", jsonrpc::PARAMS_BY_POSITION,
+          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING, "param02",
+          jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetSmartContractStatePageI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContractCode", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetSmartContractCodeI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetSmartContractInit", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetSmartContractInitI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTransactionsForTxBlock",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         "param01", jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetTransactionsForTxBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetTxnBodiesForTxBlock", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetTxnBodiesForTxBlockI);
+  AbstractServer<APIReplicaServer>::bindAndAddMethod(
+      jsonrpc::Procedure("GetMinerInfo", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetMinerInfoI);
+}
+
+bool APIReplicaServer::RefreshFromStorage() {
+  LOG_MARKER();
+
+  lock_guard<mutex> g(m_mutexRefresh);
+
+  // reopen every LevelDB handle so this process sees the files the refresh
+  // job just put in place
+  if (!BlockStorage::GetBlockStorage().RefreshAll()) {
+    LOG_GENERAL(WARNING, "BlockStorage::RefreshAll failed");
+    return false;
+  }
+
+  Retriever retriever(m_mediator);
+
+  if (!retriever.RetrieveBlockLink(false)) {
+    LOG_GENERAL(WARNING, "Retriever::RetrieveBlockLink failed");
+    return false;
+  }
+
+  if (!retriever.RetrieveTxBlocks(false)) {
+    LOG_GENERAL(WARNING, "Retriever::RetrieveTxBlocks failed");
+    return false;
+  }
+
+  if (!retriever.RetrieveStates()) {
+    LOG_GENERAL(WARNING, "Retriever::RetrieveStates failed");
+    return false;
+  }
+
+  return true;
+}
+
+ReplicaControlServer::ReplicaControlServer(APIReplicaServer& replica,
+                                           AbstractServerConnector& server)
+    : jsonrpc::AbstractServer<ReplicaControlServer>(server,
+                                                    jsonrpc::JSONRPC_SERVER_V2),
+      m_replica(replica) {
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("NotifyNewEpoch", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_STRING, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &ReplicaControlServer::NotifyNewEpochI);
+}
+
+string ReplicaControlServer::NotifyNewEpoch(const string& epochNum) {
+  LOG_GENERAL(INFO, "Primary announced epoch " << epochNum);
+
+  if (!m_replica.RefreshFromStorage()) {
+    throw JsonRpcException(RPC_INTERNAL_ERROR, "Refresh from storage failed");
+  }
+
+  return "Refreshed up to epoch " + epochNum;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSERVER_APIREPLICASERVER_H_
+#define ZILLIQA_SRC_LIBSERVER_APIREPLICASERVER_H_
+
+#include "LookupServer.h"
+
+class Mediator;
+
+/// Read-only API replica: serves the read subset of LookupServer methods
+/// from a locally refreshed copy of the primary's persistence, so API load
+/// runs in a separate process (or several) instead of on the consensus/sync
+/// node. The primary side announces finished epochs over the local control
+/// endpoint (ReplicaControlServer), which reopens the storage handles and
+/// reloads blockchains and account state.
+class APIReplicaServer : public LookupServer,
+                         public jsonrpc::AbstractServer<APIReplicaServer> {
+  std::mutex m_mutexRefresh;
+
+ public:
+  APIReplicaServer(Mediator& mediator,
+                   jsonrpc::AbstractServerConnector& server);
+  ~APIReplicaServer() = default;
+
+  /// Reopens every storage handle and reloads blockchains and account state
+  /// from the refreshed persistence directory
+  bool RefreshFromStorage();
+};
+
+/// Control endpoint for the replica, to be bound on a local-only port so
+/// the public API port cannot trigger refreshes
+class ReplicaControlServer
+    : public ServerBase,
+      public jsonrpc::AbstractServer<ReplicaControlServer> {
+  APIReplicaServer& m_replica;
+
+ public:
+  ReplicaControlServer(APIReplicaServer& replica,
+                       jsonrpc::AbstractServerConnector& server);
+  ~ReplicaControlServer() = default;
+
+  inline virtual void NotifyNewEpochI(const Json::Value& request,
+                                      Json::Value& response) {
+    response = this->NotifyNewEpoch(request[0u].asString());
+  }
+  std::string NotifyNewEpoch(const std::string& epochNum);
+};
+
+#endif  // ZILLIQA_SRC_LIBSERVER_APIREPLICASERVER_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "APIThrottle.h"
+
+#include <thread>
+
+#include "Server.h"
+#include "jsonrpccpp/common/exception.h"
+
+using namespace std;
+using namespace jsonrpc;
+
+/// concurrency cap and wait queue bound for the expensive method pool
+const unsigned int EXPENSIVE_POOL_MAX_RUNNING = 4;
+const unsigned int EXPENSIVE_POOL_MAX_WAITING = 16;
+/// wait queue bound for the cheap method pool (its concurrency cap follows
+/// hardware concurrency)
+const unsigned int CHEAP_POOL_MAX_WAITING = 256;
+
+/// histogram bucket upper bounds in milliseconds; the last bucket is open
+const double LATENCY_BUCKET_UPPER_BOUNDS_MS[] = {1, 10, 100, 1000, 10000};
+
+APIThrottle::APIThrottle()
+    : m_expensiveMethods({"GetSmartContractState", "GetSmartContractStatePage",
+                          "GetSmartContractSubStateBatch",
+                          "GetSmartContractCode", "GetSmartContractInit",
+                          "GetTransactionsForTxBlock", "GetTxnBodiesForTxBlock",
+                          "GetTransactionsBatch", "GetEventLogs",
+                          "GetTransactionsForAddress"}) {
+  m_expensivePool.maxRunning = EXPENSIVE_POOL_MAX_RUNNING;
+  m_expensivePool.maxWaiting = EXPENSIVE_POOL_MAX_WAITING;
+  m_cheapPool.maxRunning = max(4u, thread::hardware_concurrency());
+  m_cheapPool.maxWaiting = CHEAP_POOL_MAX_WAITING;
+}
+
+APIThrottle::Pool& APIThrottle::GetPool(const string& method) {
+  return m_expensiveMethods.find(method) != m_expensiveMethods.end()
+             ? m_expensivePool
+             : m_cheapPool;
+}
+
+void APIThrottle::Acquire(const string& method) {
+  Pool& pool = GetPool(method);
+
+  unique_lock<mutex> lk(pool.mutex);
+  if (pool.running < pool.maxRunning) {
+    pool.running++;
+    return;
+  }
+  if (pool.waiting >= pool.maxWaiting) {
+    throw JsonRpcException(ServerBase::RPC_SERVER_BUSY,
+                           "Server busy, request rejected");
+  }
+  pool.waiting++;
+  pool.cv.wait(lk, [&pool]() { return pool.running < pool.maxRunning; });
+  pool.waiting--;
+  pool.running++;
+}
+
+void APIThrottle::Release(const string& method, double elapsedMs) {
+  Pool& pool = GetPool(method);
+  {
+    lock_guard<mutex> lk(pool.mutex);
+    pool.running--;
+  }
+  pool.cv.notify_one();
+
+  RecordLatency(method, elapsedMs);
+}
+
+void APIThrottle::RecordLatency(const string& method, double elapsedMs) {
+  unsigned int bucket = 0;
+  while (bucket < NUM_LATENCY_BUCKETS - 1 &&
+         elapsedMs >= LATENCY_BUCKET_UPPER_BOUNDS_MS[bucket]) {
+    bucket++;
+  }
+
+  lock_guard<mutex> lk(m_mutexHistograms);
+  m_histograms[method][bucket]++;
+}
+
+Json::Value APIThrottle::GetLatencyHistograms() {
+  Json::Value _json;
+
+  Json::Value bounds = Json::arrayValue;
+  for (const double bound : LATENCY_BUCKET_UPPER_BOUNDS_MS) {
+    bounds.append(bound);
+  }
+  _json["bucketUpperBoundsMs"] = bounds;
+
+  Json::Value methods;
+  {
+    lock_guard<mutex> lk(m_mutexHistograms);
+    for (const auto& entry : m_histograms) {
+      Json::Value counts = Json::arrayValue;
+      for (const uint64_t count : entry.second) {
+        counts.append(static_cast<Json::UInt64>(count));
+      }
+      methods[entry.first] = counts;
+    }
+  }
+  _json["methods"] = methods;
+
+  return _json;
+}
+
+APIThrottle::Guard::Guard(const string& method) : m_method(method) {
+  APIThrottle::GetInstance().Acquire(m_method);
+  m_start = chrono::steady_clock::now();
+}
+
+APIThrottle::Guard::~Guard() {
+  const double elapsedMs =
+      chrono::duration<double, milli>(chrono::steady_clock::now() - m_start)
+          .count();
+  APIThrottle::GetInstance().Release(m_method, elapsedMs);
+}
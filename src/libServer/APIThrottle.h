@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSERVER_APITHROTTLE_H_
+#define ZILLIQA_SRC_LIBSERVER_APITHROTTLE_H_
+
+#include <json/json.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "common/Singleton.h"
+
+/// Admission control shared by the jsonrpc servers: methods are classified
+/// by cost into separate bounded concurrency pools, so an expensive contract
+/// state query cannot occupy every connector thread and starve cheap calls.
+/// Requests arriving when a pool and its wait queue are both full are
+/// rejected outright. Per-method latency histograms are kept for monitoring.
+class APIThrottle : public Singleton<APIThrottle> {
+  friend class Singleton<APIThrottle>;
+
+ public:
+  /// RAII admission ticket taken around one method dispatch; the constructor
+  /// blocks until the method's pool has a free slot and throws
+  /// JsonRpcException(RPC_SERVER_BUSY) if the pool's wait queue is full,
+  /// while the destructor frees the slot and records the method's latency
+  class Guard {
+   public:
+    Guard(const std::string& method);
+    ~Guard();
+
+   private:
+    const std::string m_method;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /// Returns the per-method latency histograms for StatusServer
+  Json::Value GetLatencyHistograms();
+
+ private:
+  APIThrottle();
+  ~APIThrottle() = default;
+
+  struct Pool {
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned int running = 0;
+    unsigned int waiting = 0;
+    unsigned int maxRunning = 0;
+    unsigned int maxWaiting = 0;
+  };
+
+  Pool& GetPool(const std::string& method);
+  void Acquire(const std::string& method);
+  void Release(const std::string& method, double elapsedMs);
+  void RecordLatency(const std::string& method, double elapsedMs);
+
+  static const unsigned int NUM_LATENCY_BUCKETS = 6;
+
+  /// methods whose handlers do heavy storage or JSON work
+  std::set<std::string> m_expensiveMethods;
+
+  Pool m_cheapPool;
+  Pool m_expensivePool;
+
+  std::mutex m_mutexHistograms;
+  std::map<std::string, std::array<uint64_t, NUM_LATENCY_BUCKETS>>
+      m_histograms;
+};
+
+#endif  // ZILLIQA_SRC_LIBSERVER_APITHROTTLE_H_
@@ -77,6 +77,7 @@ bool GetWorkServer::StartMining(const PoWWorkPackage& wp) {
     m_startTime = std::chrono::system_clock::now();
     m_curWork = wp;
     m_isMining = true;
+    RefreshWorkJson();
   }
 
   LOG_GENERAL(INFO, "Got PoW Work : "
@@ -91,10 +92,28 @@ bool GetWorkServer::StartMining(const PoWWorkPackage& wp) {
 void GetWorkServer::StopMining() {
   m_isMining = false;
 
+  {
+    lock_guard<mutex> g(m_mutexWork);
+    RefreshWorkJson();
+  }
+
   lock_guard<mutex> g(m_mutexResult);
   m_curResult.success = false;
 }
 
+// RefreshWorkJson rebuilds the cached getWork response (minus the per-poll
+// countdown entry); caller must hold m_mutexWork
+void GetWorkServer::RefreshWorkJson() {
+  Json::Value work;
+
+  work.append(m_isMining ? m_curWork.header : "");
+  work.append(m_isMining ? m_curWork.seed : "");
+  work.append(m_isMining ? m_curWork.boundary : "");
+  work.append(m_isMining.load());
+
+  m_curWorkJson.swap(work);
+}
+
 // SetNextPoWTime sets the time of next PoW
 void GetWorkServer::SetNextPoWTime(
     const std::chrono::system_clock::time_point& tp) {
@@ -159,11 +178,25 @@ ethash_mining_result_t GetWorkServer::VerifySubmit(const string& nonce,
     return FAIL_RESULT;
   }
 
+  // Convert the hex fields once; both the pre-check and the full
+  // verification reuse them
+  const ethash_hash256 headerHash = POW::StringToBlockhash(header);
+  const ethash_hash256 mixHash = POW::StringToBlockhash(mixdigest);
+  const ethash_hash256 boundaryHash = POW::StringToBlockhash(boundary);
+
+  // Keccak-only rejection against the boundary (trusting the submitted
+  // mixdigest), so garbage submissions never reach the DAG-backed
+  // verification
+  if (!ethash::verify_final_hash(headerHash, mixHash, winning_nonce,
+                                 boundaryHash)) {
+    LOG_GENERAL(WARNING, "Submitted solution fails the boundary pre-check");
+    return FAIL_RESULT;
+  }
+
   ethash_hash256 final_result{};
-  if (!POW::GetInstance().VerifyRemoteSoln(
-          m_curWork.blocknum, POW::StringToBlockhash(boundary), winning_nonce,
-          POW::StringToBlockhash(header), POW::StringToBlockhash(mixdigest),
-          final_result)) {
+  if (!POW::GetInstance().VerifyRemoteSoln(m_curWork.blocknum, boundaryHash,
+                                           winning_nonce, headerHash, mixHash,
+                                           final_result)) {
     LOG_GENERAL(WARNING, "Failed to verify PoW result from miner.");
     return FAIL_RESULT;
   }
@@ -215,12 +248,13 @@ Json::Value GetWorkServer::getWork() {
   LOG_MARKER();
   Json::Value result;
 
-  lock_guard<mutex> g(m_mutexWork);
+  // Copy the cached package; only the countdown entry is computed per poll,
+  // and m_mutexPoWTime is no longer taken while m_mutexWork is held
+  {
+    lock_guard<mutex> g(m_mutexWork);
+    result = m_curWorkJson;
+  }
 
-  result.append(m_isMining ? m_curWork.header : "");
-  result.append(m_isMining ? m_curWork.seed : "");
-  result.append(m_isMining ? m_curWork.boundary : "");
-  result.append(m_isMining.load());
   result.append(GetSecondsToNextPoW());
 
   return result;
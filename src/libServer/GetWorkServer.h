@@ -101,7 +101,9 @@ struct PoWWorkPackage {
 class GetWorkServer : public AbstractStubServer {
   // Constructor
   GetWorkServer(jsonrpc::AbstractServerConnector &conn)
-      : AbstractStubServer(conn) {}
+      : AbstractStubServer(conn) {
+    RefreshWorkJson();
+  }
 
   ~GetWorkServer() {}
 
@@ -117,6 +119,15 @@ class GetWorkServer : public AbstractStubServer {
   PoWWorkPackage m_curWork;
   std::mutex m_mutexWork;
 
+  // getWork response without the per-poll countdown entry, rebuilt only when
+  // the work package changes so high-frequency farm polling is a copy, not a
+  // re-serialization
+  Json::Value m_curWorkJson;
+
+  // Rebuilds m_curWorkJson from the current work package; caller must hold
+  // m_mutexWork
+  void RefreshWorkJson();
+
   ethash_mining_result_t m_curResult;
   std::mutex m_mutexResult;
   std::condition_variable m_cvGotResult;
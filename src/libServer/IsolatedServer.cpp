@@ -171,13 +171,9 @@ bool IsolatedServer::ValidateTxn(const Transaction& tx, const Address& fromAddr,
 
 Json::Value IsolatedServer::CreateTransaction(const Json::Value& _json) {
   try {
-    if (!JSONConversion::checkJsonTx(_json)) {
-      throw JsonRpcException(RPC_PARSE_ERROR, "Invalid Transaction JSON");
-    }
-
     LOG_GENERAL(INFO, "On the isolated server ");
 
-    Transaction tx = JSONConversion::convertJsontoTx(_json);
+    Transaction tx = JSONConversion::convertJsontoTxChecked(_json);
 
     Json::Value ret;
 
@@ -265,6 +261,15 @@ Json::Value IsolatedServer::CreateTransaction(const Json::Value& _json) {
       LOG_GENERAL(WARNING, "Unable to put tx body");
     }
 
+    bytes receipt_ser;
+
+    txreceipt.Serialize(receipt_ser, 0);
+
+    if (!BlockStorage::GetBlockStorage().PutTxnReceipt(tx.GetTranID(),
+                                                       receipt_ser)) {
+      LOG_GENERAL(WARNING, "Unable to put txn receipt");
+    }
+
     ret["TranID"] = tx.GetTranID().hex();
     ret["Info"] = "Txn processed";
     return ret;
@@ -16,6 +16,7 @@
  */
 
 #include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -35,7 +36,7 @@ using namespace boost::multiprecision;
 
 unsigned int JSON_TRAN_OBJECT_SIZE = 10;
 
-const Json::Value JSONConversion::convertMicroBlockInfoArraytoJson(
+Json::Value JSONConversion::convertMicroBlockInfoArraytoJson(
     const vector<MicroBlockInfo>& v) {
   Json::Value mbInfosJson = Json::arrayValue;
   for (auto const& i : v) {
@@ -43,12 +44,13 @@ const Json::Value JSONConversion::convertMicroBlockInfoArraytoJson(
     t_mbInfoJson["MicroBlockHash"] = i.m_microBlockHash.hex();
     t_mbInfoJson["MicroBlockTxnRootHash"] = i.m_txnRootHash.hex();
     t_mbInfoJson["MicroBlockShardId"] = i.m_shardId;
-    mbInfosJson.append(t_mbInfoJson);
+    // Swap into the freshly appended slot instead of deep-copying the node
+    mbInfosJson.append(Json::Value()).swap(t_mbInfoJson);
   }
   return mbInfosJson;
 }
 
-const Json::Value JSONConversion::convertTxBlocktoJson(const TxBlock& txblock) {
+Json::Value JSONConversion::convertTxBlocktoJson(const TxBlock& txblock) {
   Json::Value ret;
   Json::Value ret_head;
   Json::Value ret_body;
@@ -80,11 +82,13 @@ const Json::Value JSONConversion::convertTxBlocktoJson(const TxBlock& txblock) {
   ret_body["HeaderSign"] = HeaderSignStr;
   ret_body["BlockHash"] = txblock.GetBlockHash().hex();
 
-  ret_body["MicroBlockInfos"] =
+  Json::Value mbInfosJson =
       convertMicroBlockInfoArraytoJson(txblock.GetMicroBlockInfos());
+  ret_body["MicroBlockInfos"].swap(mbInfosJson);
 
-  ret["header"] = ret_head;
-  ret["body"] = ret_body;
+  // Stitch the assembled subtrees in place of deep-copying them
+  ret["header"].swap(ret_head);
+  ret["body"].swap(ret_body);
 
   return ret;
 }
@@ -109,7 +113,7 @@ const Json::Value JSONConversion::convertRawTxBlocktoJson(
   return ret;
 }
 
-const Json::Value JSONConversion::convertDSblocktoJson(const DSBlock& dsblock) {
+Json::Value JSONConversion::convertDSblocktoJson(const DSBlock& dsblock) {
   Json::Value ret;
   Json::Value ret_header;
   Json::Value ret_sign;
@@ -134,9 +138,9 @@ const Json::Value JSONConversion::convertDSblocktoJson(const DSBlock& dsblock) {
     ret_header["PoWWinners"].append(static_cast<string>(dswinner.first));
   }
   ret_header["Timestamp"] = to_string(dsblock.GetTimestamp());
-  ret["header"] = ret_header;
+  ret["header"].swap(ret_header);
 
-  ret["signature"] = ret_sign;
+  ret["signature"].swap(ret_sign);
 
   return ret;
 }
@@ -219,6 +223,158 @@ const Transaction JSONConversion::convertJsontoTx(const Json::Value& _json) {
   return tx1;
 }
 
+namespace {
+
+// Fetches one expected field of the CreateTransaction request shape with a
+// single map lookup, rejecting the request if the field is absent
+const Json::Value& GetTxField(const Json::Value& _json, const char* name) {
+  const Json::Value* field = _json.find(name, name + strlen(name));
+  if (field == nullptr) {
+    LOG_GENERAL(INFO, "Json Data Object has missing components");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Missing components in Json Data Object");
+  }
+  return *field;
+}
+
+}  // namespace
+
+const Transaction JSONConversion::convertJsontoTxChecked(
+    const Json::Value& _json) {
+  if (!_json.isObject() || (_json.size() != JSON_TRAN_OBJECT_SIZE &&
+                            _json.size() != JSON_TRAN_OBJECT_SIZE + 1)) {
+    LOG_GENERAL(INFO, "Json Data Object has missing components");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Missing components in Json Data Object");
+  }
+
+  if (_json.size() == JSON_TRAN_OBJECT_SIZE + 1) {
+    const Json::Value* priority = _json.find("priority", "priority" + 8);
+    if (priority == nullptr || !priority->isBool()) {
+      throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                      "Priority should be boolean");
+    }
+  }
+
+  const Json::Value& version_json = GetTxField(_json, "version");
+  if (!version_json.isIntegral()) {
+    LOG_GENERAL(INFO, "Fault in version");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Version not integral");
+  }
+  uint32_t version = version_json.asUInt();
+
+  const Json::Value& nonce_json = GetTxField(_json, "nonce");
+  if (!nonce_json.isIntegral()) {
+    LOG_GENERAL(INFO, "Fault in nonce");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Nonce is not integral");
+  }
+  uint64_t nonce = nonce_json.asUInt64();
+
+  // The checksum pass already needs the lowercased address, so the hex
+  // decode below works off its output instead of re-walking the field
+  string lower_case_addr;
+  if (!AddressChecksum::VerifyChecksumAddress(
+          GetTxField(_json, "toAddr").asString(), lower_case_addr)) {
+    LOG_GENERAL(INFO, "To Address checksum wrong");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "To Addr checksum wrong");
+  }
+  bytes toAddr_ser;
+  if (!DataConversion::HexStrToUint8Vec(lower_case_addr, toAddr_ser)) {
+    LOG_GENERAL(WARNING, "json containing invalid hex str for toAddr");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Invalid Hex Str for toAddr");
+  }
+  Address toAddr(toAddr_ser);
+
+  const Json::Value& amount_json = GetTxField(_json, "amount");
+  if (!amount_json.isString()) {
+    LOG_GENERAL(INFO, "Amount not string");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Amount invalid string");
+  }
+  uint128_t amount;
+  try {
+    amount = uint128_t(amount_json.asString());
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "Fault in amount " << e.what());
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Amount invalid string");
+  }
+
+  uint128_t gasPrice(GetTxField(_json, "gasPrice").asString());
+
+  const Json::Value& gasLimit_json = GetTxField(_json, "gasLimit");
+  uint64_t gasLimit =
+      gasLimit_json.isIntegral()
+          ? gasLimit_json.asUInt64()
+          : strtoull(gasLimit_json.asString().c_str(), NULL, 0);
+
+  const char* pubKeyBegin = nullptr;
+  const char* pubKeyEnd = nullptr;
+  if (!GetTxField(_json, "pubKey").getString(&pubKeyBegin, &pubKeyEnd) ||
+      static_cast<size_t>(pubKeyEnd - pubKeyBegin) != PUB_KEY_SIZE * 2) {
+    LOG_GENERAL(INFO, "PubKey size wrong");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Invalid PubKey Size");
+  }
+  bytes pubKey_ser;
+  if (!DataConversion::HexStrToUint8Vec(pubKeyBegin, pubKeyEnd, pubKey_ser)) {
+    LOG_GENERAL(WARNING, "json cointaining invalid hex str for pubkey");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Invalid Hex Str for PubKey");
+  }
+  PubKey pubKey(pubKey_ser, 0);
+
+  const char* signBegin = nullptr;
+  const char* signEnd = nullptr;
+  if (!GetTxField(_json, "signature").getString(&signBegin, &signEnd) ||
+      static_cast<size_t>(signEnd - signBegin) != TRAN_SIG_SIZE * 2) {
+    LOG_GENERAL(INFO, "signature size wrong");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Invalid Signature size");
+  }
+  bytes sign;
+  if (!DataConversion::HexStrToUint8Vec(signBegin, signEnd, sign)) {
+    LOG_GENERAL(WARNING, "json cointaining invalid hex str for sign");
+    throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                    "Invalid Hex Str for Signature");
+  }
+
+  // code and data may be sent as null instead of an empty string
+  const Json::Value& code_json = GetTxField(_json, "code");
+  bytes code;
+  if (!code_json.isNull()) {
+    const char* codeBegin = nullptr;
+    const char* codeEnd = nullptr;
+    if (!code_json.getString(&codeBegin, &codeEnd)) {
+      throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                      "Code is not a string");
+    }
+    code.assign(codeBegin, codeEnd);
+  }
+
+  const Json::Value& data_json = GetTxField(_json, "data");
+  bytes data;
+  if (!data_json.isNull()) {
+    const char* dataBegin = nullptr;
+    const char* dataEnd = nullptr;
+    if (!data_json.getString(&dataBegin, &dataEnd)) {
+      throw jsonrpc::JsonRpcException(Server::RPC_INVALID_PARAMETER,
+                                      "Data is not a string");
+    }
+    data.assign(dataBegin, dataEnd);
+  }
+
+  Transaction tx1(version, nonce, toAddr, pubKey, amount, gasPrice, gasLimit,
+                  code, data, Signature(sign, 0));
+  LOG_GENERAL(INFO, "Tx converted");
+
+  return tx1;
+}
+
 bool JSONConversion::checkStringAddress(const std::string& address) {
   return ((address.size() == ACC_ADDR_SIZE * 2 + 2) &&
           (address.substr(0, 2) == "0x"));
@@ -321,7 +477,7 @@ const vector<string> JSONConversion::convertJsonArrayToVector(
   return vec;
 }
 
-const Json::Value JSONConversion::convertTxtoJson(
+Json::Value JSONConversion::convertTxtoJson(
     const TransactionWithReceipt& twr) {
   Json::Value _json;
 
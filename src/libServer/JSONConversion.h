@@ -28,18 +28,22 @@
 class JSONConversion {
  public:
   // converts a uint32_t array to JSON array containing shard ids
-  static const Json::Value convertMicroBlockInfoArraytoJson(
+  static Json::Value convertMicroBlockInfoArraytoJson(
       const std::vector<MicroBlockInfo>& v);
   // converts a TxBlock to JSON object
-  static const Json::Value convertTxBlocktoJson(const TxBlock& txblock);
+  static Json::Value convertTxBlocktoJson(const TxBlock& txblock);
   // converts raw TxBlock to JSON object (for staking)
   static const Json::Value convertRawTxBlocktoJson(const TxBlock& txblock);
   // converts a DSBlocck to JSON object
-  static const Json::Value convertDSblocktoJson(const DSBlock& dsblock);
+  static Json::Value convertDSblocktoJson(const DSBlock& dsblock);
   // converts raw DSBlock to JSON object (for staking)
   static const Json::Value convertRawDSBlocktoJson(const DSBlock& dsblock);
   // converts a JSON to Tx
   static const Transaction convertJsontoTx(const Json::Value& _json);
+  // single-pass validate-and-convert for the CreateTransaction request
+  // shape: each field is looked up once and the fixed-size hex fields are
+  // decoded straight out of the DOM string storage
+  static const Transaction convertJsontoTxChecked(const Json::Value& _json);
   // check if a Json is a valid Tx
   static bool checkJsonTx(const Json::Value& _json);
   // check is string address is a valid address
@@ -47,8 +51,9 @@ class JSONConversion {
   // Convert a json array of strings to a vector of strings
   static const std::vector<std::string> convertJsonArrayToVector(
       const Json::Value& _json);
-  // Convert a Tx to JSON object
-  static const Json::Value convertTxtoJson(const TransactionWithReceipt& twr);
+  // Convert a Tx to JSON object; returned by non-const value so the result
+  // can be moved into response arrays instead of deep-copied
+  static Json::Value convertTxtoJson(const TransactionWithReceipt& twr);
   // Convert a node to json
   static const Json::Value convertNode(const PairOfNode& node);
   // conver a node with reputation to json
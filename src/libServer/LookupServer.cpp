@@ -29,8 +29,10 @@
 #include "libNetwork/P2PComm.h"
 #include "libNetwork/Peer.h"
 #include "libPersistence/BlockStorage.h"
+#include "libPersistence/ContractStorage2.h"
 #include "libUtils/DetachedFunction.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 #include "libUtils/TimeUtils.h"
 
 using namespace jsonrpc;
@@ -42,6 +44,11 @@ std::mutex LookupServer::m_mutexRecentTxns;
 const unsigned int PAGE_SIZE = 10;
 const unsigned int NUM_PAGES_CACHE = 2;
 const unsigned int TXN_PAGE_SIZE = 100;
+const unsigned int STATE_PAGE_DEFAULT_SIZE = 1000;
+const unsigned int STATE_PAGE_MAX_SIZE = 10000;
+const unsigned int TXNS_BATCH_MAX_SIZE = 100;
+const unsigned int EVENT_LOG_QUERY_MAX_EPOCHS = 100;
+const unsigned int STATE_BATCH_MAX_QUERIES = 50;
 
 //[warning] do not make this constant too big as it loops over blockchain
 const unsigned int REF_BLOCK_DIFF = 1;
@@ -79,6 +86,23 @@ LookupServer::LookupServer(Mediator& mediator,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
                          NULL),
       &LookupServer::GetTransactionI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetTransactionsBatch", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_ARRAY,
+                         NULL),
+      &LookupServer::GetTransactionsBatchI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetEventLogs", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING,
+                         "param02", jsonrpc::JSON_STRING, "param03",
+                         jsonrpc::JSON_STRING, NULL),
+      &LookupServer::GetEventLogsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetTransactionsForAddress",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         "param01", jsonrpc::JSON_STRING, "param02",
+                         jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetTransactionsForAddressI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetDsBlock", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
@@ -102,6 +126,11 @@ LookupServer::LookupServer(Mediator& mediator,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
                          NULL),
       &LookupServer::GetBalanceI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetAccountProof", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
+                         NULL),
+      &LookupServer::GetAccountProofI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetMinimumGasPrice", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_STRING, NULL),
@@ -193,11 +222,23 @@ LookupServer::LookupServer(Mediator& mediator,
           jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING, "param02",
           jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_ARRAY, NULL),
       &LookupServer::GetSmartContractSubStateI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure(
+          "GetSmartContractSubStateBatch", jsonrpc::PARAMS_BY_POSITION,
+          jsonrpc::JSON_ARRAY, "param01", jsonrpc::JSON_STRING, "param02",
+          jsonrpc::JSON_ARRAY, NULL),
+      &LookupServer::GetSmartContractSubStateBatchI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetSmartContractState", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
                          NULL),
       &LookupServer::GetSmartContractStateI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure(
+          "GetSmartContractStatePage", jsonrpc::PARAMS_BY_POSITION,
+          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING, "param02",
+          jsonrpc::JSON_STRING, "param03", jsonrpc::JSON_INTEGER, NULL),
+      &LookupServer::GetSmartContractStatePageI);
   this->bindAndAddMethod(
       jsonrpc::Procedure("GetSmartContractCode", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, "param01", jsonrpc::JSON_STRING,
@@ -313,7 +354,7 @@ bool LookupServer::StartCollectorThread() {
       for (auto const& i :
            {SEND_TYPE::ARCHIVAL_SEND_SHARD, SEND_TYPE::ARCHIVAL_SEND_DS}) {
         {
-          lock_guard<mutex> g(m_mediator.m_lookup->m_txnShardMapMutex);
+          lock_guard<ProfiledMutex> g(m_mediator.m_lookup->m_txnShardMapMutex);
           if (m_mediator.m_lookup->GetTxnFromShardMap(i).empty()) {
             continue;
           }
@@ -329,7 +370,7 @@ bool LookupServer::StartCollectorThread() {
       bytes msg = {MessageType::LOOKUP, LookupInstructionType::FORWARDTXN};
 
       {
-        lock_guard<mutex> g(m_mediator.m_lookup->m_txnShardMapMutex);
+        lock_guard<ProfiledMutex> g(m_mediator.m_lookup->m_txnShardMapMutex);
         if (!Messenger::SetForwardTxnBlockFromSeed(
                 msg, MessageOffset::BODY,
                 m_mediator.m_lookup->GetTxnFromShardMap(
@@ -438,20 +479,25 @@ Json::Value LookupServer::CreateTransaction(
   }
 
   try {
-    if (!JSONConversion::checkJsonTx(_json)) {
-      throw JsonRpcException(RPC_PARSE_ERROR, "Invalid Transaction JSON");
-    }
+    Transaction tx = JSONConversion::convertJsontoTxChecked(_json);
 
-    Transaction tx = JSONConversion::convertJsontoTx(_json);
+    // Replayed submissions of an already-admitted txn are turned away here,
+    // before paying for signature verification again
+    if (IsRecentlyAdmittedTxn(tx.GetTranID())) {
+      throw JsonRpcException(RPC_DATABASE_ERROR,
+                             "Txn could not be added as database exceeded "
+                             "limit or the txn was already present");
+    }
 
     Json::Value ret;
 
     const Address fromAddr = tx.GetSenderAddr();
-    const Account* sender = AccountStore::GetInstance().GetAccount(fromAddr);
-    const Account* toAccount =
-        AccountStore::GetInstance().GetAccount(tx.GetToAddr());
+    const shared_ptr<const Account> sender =
+        AccountStore::GetInstance().GetAccountCached(fromAddr);
+    const shared_ptr<const Account> toAccount =
+        AccountStore::GetInstance().GetAccountCached(tx.GetToAddr());
 
-    if (!ValidateTxn(tx, fromAddr, sender, gasPrice)) {
+    if (!ValidateTxn(tx, fromAddr, sender.get(), gasPrice)) {
       return ret;
     }
 
@@ -540,6 +586,7 @@ Json::Value LookupServer::CreateTransaction(
                              "Txn could not be added as database exceeded "
                              "limit or the txn was already present");
     }
+    RecordAdmittedTxn(tx.GetTranID());
     ret["TranID"] = tx.GetTranID().hex();
     return ret;
   } catch (const JsonRpcException& je) {
@@ -551,6 +598,23 @@ Json::Value LookupServer::CreateTransaction(
   }
 }
 
+bool LookupServer::IsRecentlyAdmittedTxn(const TxnHash& txhash) {
+  lock_guard<mutex> g(m_txnDedupMutex);
+  return m_txnDedupCache.find(txhash) != m_txnDedupCache.end();
+}
+
+void LookupServer::RecordAdmittedTxn(const TxnHash& txhash) {
+  lock_guard<mutex> g(m_txnDedupMutex);
+  if (!m_txnDedupCache.insert(txhash).second) {
+    return;
+  }
+  m_txnDedupOrder.push_back(txhash);
+  if (m_txnDedupCache.size() > TXN_DEDUP_CACHE_MAX_ENTRIES) {
+    m_txnDedupCache.erase(m_txnDedupOrder.front());
+    m_txnDedupOrder.pop_front();
+  }
+}
+
 Json::Value LookupServer::GetTransaction(const string& transactionHash) {
   LOG_MARKER();
 
@@ -585,6 +649,210 @@ Json::Value LookupServer::GetTransaction(const string& transactionHash) {
   }
 }
 
+Json::Value LookupServer::GetTransactionsBatch(
+    const Json::Value& transactionHashes) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  if (!transactionHashes.isArray()) {
+    throw JsonRpcException(RPC_INVALID_PARAMS, "Expected array of txn hashes");
+  }
+  if (transactionHashes.size() > TXNS_BATCH_MAX_SIZE) {
+    throw JsonRpcException(RPC_INVALID_PARAMS,
+                           "Batch size exceeds " +
+                               to_string(TXNS_BATCH_MAX_SIZE) + " txn hashes");
+  }
+
+  try {
+    vector<dev::h256> tranHashes;
+    tranHashes.reserve(transactionHashes.size());
+    for (const auto& hash : transactionHashes) {
+      const string& hashStr = hash.asString();
+      if (hashStr.size() != TRAN_HASH_SIZE * 2) {
+        throw JsonRpcException(RPC_INVALID_PARAMS, "Size not appropriate");
+      }
+      tranHashes.emplace_back(TxnHash(hashStr));
+    }
+
+    vector<TxBodySharedPtr> tptrs;
+    BlockStorage::GetBlockStorage().GetTxBodies(tranHashes, tptrs);
+
+    // The result array is aligned with the input hashes: a txn absent from
+    // both the main and the historical DB yields an error entry in its place
+    Json::Value _json = Json::arrayValue;
+    for (size_t i = 0; i < tranHashes.size(); i++) {
+      if (tptrs[i] == nullptr && m_mediator.m_lookup->m_historicalDB) {
+        BlockStorage::GetBlockStorage().GetTxnFromHistoricalDB(tranHashes[i],
+                                                               tptrs[i]);
+      }
+      if (tptrs[i] != nullptr) {
+        // Swap into the appended slot rather than deep-copying the txn tree
+        Json::Value txJson = JSONConversion::convertTxtoJson(*tptrs[i]);
+        _json.append(Json::Value()).swap(txJson);
+      } else {
+        Json::Value notFound;
+        notFound["error"] = "Txn Hash not Present";
+        _json.append(notFound);
+      }
+    }
+    return _json;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what());
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable to Process");
+  }
+}
+
+Json::Value LookupServer::GetEventLogs(const string& address,
+                                       const string& fromBlock,
+                                       const string& toBlock) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  uint64_t lowEpochNum;
+  uint64_t hiEpochNum;
+  try {
+    lowEpochNum = strtoull(fromBlock.c_str(), NULL, 0);
+    hiEpochNum = strtoull(toBlock.c_str(), NULL, 0);
+  } catch (exception& e) {
+    throw JsonRpcException(RPC_INVALID_PARAMETER, e.what());
+  }
+
+  if (hiEpochNum < lowEpochNum ||
+      hiEpochNum - lowEpochNum + 1 > EVENT_LOG_QUERY_MAX_EPOCHS) {
+    throw JsonRpcException(
+        RPC_INVALID_PARAMS, "Block range exceeds " +
+                                to_string(EVENT_LOG_QUERY_MAX_EPOCHS) +
+                                " epochs");
+  }
+
+  try {
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+    Address addr(tmpaddr);
+
+    Json::Value logs = Json::arrayValue;
+    if (!BlockStorage::GetBlockStorage().GetEventLogs(addr.hex(), lowEpochNum,
+                                                      hiEpochNum, logs)) {
+      throw JsonRpcException(RPC_DATABASE_ERROR,
+                             "Unable to fetch event logs");
+    }
+    return logs;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable to Process");
+  }
+}
+
+Json::Value LookupServer::GetTransactionsForAddress(const string& address,
+                                                    unsigned int page) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  if (!ENABLE_ADDRESS_INDEX) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Address index is not enabled");
+  }
+
+  if (page < 1) {
+    throw JsonRpcException(RPC_INVALID_PARAMETER, "Pages out of limit");
+  }
+
+  try {
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+    Address addr(tmpaddr);
+
+    Json::Value txns = Json::arrayValue;
+    bool hasMore = false;
+    if (!BlockStorage::GetBlockStorage().GetTxnHashesForAddress(
+            addr.hex(), page, TXN_PAGE_SIZE, txns, hasMore)) {
+      throw JsonRpcException(RPC_DATABASE_ERROR,
+                             "Unable to fetch txn history");
+    }
+
+    Json::Value _json;
+    _json["CurrPage"] = page;
+    _json["HasMore"] = hasMore;
+    _json["Txns"].swap(txns);
+    return _json;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable to Process");
+  }
+}
+
+Json::Value LookupServer::GetDsBlockJson(const DSBlock& block) {
+  const uint64_t blockNum = block.GetHeader().GetBlockNum();
+
+  lock_guard<mutex> g(m_dsBlockJsonCacheMutex);
+  auto found = m_dsBlockJsonCache.find(blockNum);
+  if (found != m_dsBlockJsonCache.end()) {
+    m_dsBlockJsonCacheOrder.splice(m_dsBlockJsonCacheOrder.begin(),
+                                   m_dsBlockJsonCacheOrder,
+                                   found->second.second);
+    return found->second.first;
+  }
+
+  Json::Value json = JSONConversion::convertDSblocktoJson(block);
+  m_dsBlockJsonCacheOrder.emplace_front(blockNum);
+  m_dsBlockJsonCache.emplace(blockNum,
+                             make_pair(json, m_dsBlockJsonCacheOrder.begin()));
+  if (m_dsBlockJsonCache.size() > BLOCK_JSON_CACHE_MAX_ENTRIES) {
+    m_dsBlockJsonCache.erase(m_dsBlockJsonCacheOrder.back());
+    m_dsBlockJsonCacheOrder.pop_back();
+  }
+  return json;
+}
+
+Json::Value LookupServer::GetTxBlockJson(const TxBlock& block) {
+  const uint64_t blockNum = block.GetHeader().GetBlockNum();
+
+  lock_guard<mutex> g(m_txBlockJsonCacheMutex);
+  auto found = m_txBlockJsonCache.find(blockNum);
+  if (found != m_txBlockJsonCache.end()) {
+    m_txBlockJsonCacheOrder.splice(m_txBlockJsonCacheOrder.begin(),
+                                   m_txBlockJsonCacheOrder,
+                                   found->second.second);
+    return found->second.first;
+  }
+
+  Json::Value json = JSONConversion::convertTxBlocktoJson(block);
+  m_txBlockJsonCacheOrder.emplace_front(blockNum);
+  m_txBlockJsonCache.emplace(blockNum,
+                             make_pair(json, m_txBlockJsonCacheOrder.begin()));
+  if (m_txBlockJsonCache.size() > BLOCK_JSON_CACHE_MAX_ENTRIES) {
+    m_txBlockJsonCache.erase(m_txBlockJsonCacheOrder.back());
+    m_txBlockJsonCacheOrder.pop_back();
+  }
+  return json;
+}
+
 Json::Value LookupServer::GetDsBlock(const string& blockNum) {
   if (!LOOKUP_NODE_MODE) {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
@@ -592,8 +860,7 @@ Json::Value LookupServer::GetDsBlock(const string& blockNum) {
 
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertDSblocktoJson(
-        m_mediator.m_dsBlockChain.GetBlock(BlockNum));
+    return GetDsBlockJson(m_mediator.m_dsBlockChain.GetBlock(BlockNum));
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (runtime_error& e) {
@@ -618,8 +885,7 @@ Json::Value LookupServer::GetTxBlock(const string& blockNum) {
 
   try {
     uint64_t BlockNum = stoull(blockNum);
-    return JSONConversion::convertTxBlocktoJson(
-        m_mediator.m_txBlockChain.GetBlock(BlockNum));
+    return GetTxBlockJson(m_mediator.m_txBlockChain.GetBlock(BlockNum));
   } catch (const JsonRpcException& je) {
     throw je;
   } catch (runtime_error& e) {
@@ -642,10 +908,7 @@ string LookupServer::GetMinimumGasPrice() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  return m_mediator.m_dsBlockChain.GetLastBlock()
-      .GetHeader()
-      .GetGasPrice()
-      .str();
+  return m_mediator.GetEpochContext()->gasPrice.str();
 }
 
 Json::Value LookupServer::GetLatestDsBlock() {
@@ -660,7 +923,7 @@ Json::Value LookupServer::GetLatestDsBlock() {
             "BlockNum " << Latest.GetHeader().GetBlockNum()
                         << "  Timestamp:        " << Latest.GetTimestamp());
 
-  return JSONConversion::convertDSblocktoJson(Latest);
+  return GetDsBlockJson(Latest);
 }
 
 Json::Value LookupServer::GetLatestTxBlock() {
@@ -676,7 +939,7 @@ Json::Value LookupServer::GetLatestTxBlock() {
             "BlockNum " << Latest.GetHeader().GetBlockNum()
                         << "  Timestamp:        " << Latest.GetTimestamp());
 
-  return JSONConversion::convertTxBlocktoJson(Latest);
+  return GetTxBlockJson(Latest);
 }
 
 Json::Value LookupServer::GetBalance(const string& address) {
@@ -697,7 +960,8 @@ Json::Value LookupServer::GetBalance(const string& address) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
     }
     Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
 
     Json::Value ret;
     if (account != nullptr) {
@@ -721,6 +985,61 @@ Json::Value LookupServer::GetBalance(const string& address) {
   }
 }
 
+Json::Value LookupServer::GetAccountProof(const string& address) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  try {
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+    Address addr(tmpaddr);
+
+    // prove against the committed snapshot so the walk needs no trie lock
+    // and the returned root matches a finalized state root
+    const auto snapshot = AccountStore::GetInstance().GetCommittedSnapshot();
+    if (snapshot == nullptr) {
+      throw JsonRpcException(RPC_MISC_ERROR, "No committed state yet");
+    }
+
+    std::vector<bytes> proof;
+    bytes accountRaw;
+    if (!AccountStore::GetInstance().GetAccountProof(snapshot->m_root, addr,
+                                                     proof, accountRaw)) {
+      throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+    }
+
+    Json::Value ret;
+    ret["stateRoot"] = snapshot->m_root.hex();
+    ret["accountProof"] = Json::arrayValue;
+    for (const auto& node : proof) {
+      string nodeStr;
+      DataConversion::Uint8VecToHexStr(node, nodeStr);
+      ret["accountProof"].append(nodeStr);
+    }
+    // empty when the address is absent: the proof then shows non-inclusion
+    string accountStr;
+    DataConversion::Uint8VecToHexStr(accountRaw, accountStr);
+    ret["serializedAccount"] = accountStr;
+
+    return ret;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
 Json::Value LookupServer::GetSmartContractState(const string& address,
                                                 const string& vname,
                                                 const Json::Value& indices) {
@@ -742,7 +1061,8 @@ Json::Value LookupServer::GetSmartContractState(const string& address,
     }
 
     Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
 
     if (account == nullptr) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
@@ -769,6 +1089,139 @@ Json::Value LookupServer::GetSmartContractState(const string& address,
   }
 }
 
+Json::Value LookupServer::GetSmartContractSubStateBatch(
+    const string& address, const Json::Value& queries) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  try {
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+    if (!queries.isArray() || queries.empty()) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Queries must be a non-empty array");
+    }
+    if (queries.size() > STATE_BATCH_MAX_QUERIES) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Too many queries in one batch");
+    }
+
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+
+    Address addr(tmpaddr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
+
+    if (account == nullptr) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address does not exist");
+    }
+
+    if (!account->isContract()) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address not contract address");
+    }
+
+    // resolve all the paths within one handler invocation, so the caller
+    // pays one round trip instead of one per field and every field is read
+    // from the same state between block commits
+    Json::Value ret = Json::arrayValue;
+    for (const auto& query : queries) {
+      if (!query.isObject() || !query["vname"].isString()) {
+        throw JsonRpcException(RPC_INVALID_PARAMETER,
+                               "Each query needs a string vname");
+      }
+      const auto indices_vector = JSONConversion::convertJsonArrayToVector(
+          query.isMember("indices") ? query["indices"] : Json::arrayValue);
+
+      Json::Value root;
+      if (account->FetchStateJson(root, query["vname"].asString(),
+                                  indices_vector)) {
+        ret.append(root);
+      } else {
+        // a missing field must not fail the fields that do exist
+        ret.append(Json::nullValue);
+      }
+    }
+    return ret;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
+Json::Value LookupServer::GetSmartContractStatePage(const string& address,
+                                                    const string& cursor,
+                                                    unsigned int pageSize) {
+  LOG_MARKER();
+
+  if (!LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
+  }
+
+  try {
+    if (address.size() != ACC_ADDR_SIZE * 2) {
+      throw JsonRpcException(RPC_INVALID_PARAMETER,
+                             "Address size not appropriate");
+    }
+    bytes tmpaddr;
+    if (!DataConversion::HexStrToUint8Vec(address, tmpaddr)) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
+    }
+
+    Address addr(tmpaddr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
+
+    if (account == nullptr) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address does not exist");
+    }
+
+    if (!account->isContract()) {
+      throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
+                             "Address not contract address");
+    }
+
+    if (pageSize == 0) {
+      pageSize = STATE_PAGE_DEFAULT_SIZE;
+    }
+    pageSize = min(pageSize, STATE_PAGE_MAX_SIZE);
+
+    Json::Value state;
+    string nextCursor;
+    if (!Contract::ContractStorage2::GetContractStorage()
+             .FetchStateJsonForContractPaged(state, addr, cursor, pageSize,
+                                             nextCursor)) {
+      throw JsonRpcException(RPC_INTERNAL_ERROR,
+                             "FetchStateJsonForContractPaged failed");
+    }
+
+    Json::Value ret;
+    if (cursor.empty()) {
+      state["_balance"] = account->GetBalance().convert_to<string>();
+    }
+    ret["state"] = state;
+    ret["nextCursor"] = nextCursor;
+    return ret;
+  } catch (const JsonRpcException& je) {
+    throw je;
+  } catch (exception& e) {
+    LOG_GENERAL(INFO, "[Error]" << e.what() << " Input: " << address);
+    throw JsonRpcException(RPC_MISC_ERROR, "Unable To Process");
+  }
+}
+
 Json::Value LookupServer::GetSmartContractInit(const string& address) {
   LOG_MARKER();
 
@@ -788,7 +1241,8 @@ Json::Value LookupServer::GetSmartContractInit(const string& address) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
     }
     Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
 
     if (account == nullptr) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
@@ -832,7 +1286,8 @@ Json::Value LookupServer::GetSmartContractCode(const string& address) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY, "invalid address");
     }
     Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
 
     if (account == nullptr) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
@@ -874,7 +1329,8 @@ Json::Value LookupServer::GetSmartContracts(const string& address) {
     }
 
     Address addr(tmpaddr);
-    const Account* account = AccountStore::GetInstance().GetAccount(addr);
+    const shared_ptr<const Account> account =
+        AccountStore::GetInstance().GetAccountCached(addr);
 
     if (account == nullptr) {
       throw JsonRpcException(RPC_INVALID_ADDRESS_OR_KEY,
@@ -890,8 +1346,8 @@ Json::Value LookupServer::GetSmartContracts(const string& address) {
 
     for (uint64_t i = 0; i < nonce; i++) {
       Address contractAddr = Account::GetAddressForContract(addr, i);
-      const Account* contractAccount =
-          AccountStore::GetInstance().GetAccount(contractAddr);
+      const shared_ptr<const Account> contractAccount =
+          AccountStore::GetInstance().GetAccountCached(contractAddr);
 
       if (contractAccount == nullptr || !contractAccount->isContract()) {
         continue;
@@ -994,7 +1450,7 @@ string LookupServer::GetNumTransactions() {
   if (m_BlockTxPair.first < currBlock) {
     for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
       m_BlockTxPair.second +=
-          m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+          m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
     }
   }
   m_BlockTxPair.first = currBlock;
@@ -1021,7 +1477,7 @@ size_t LookupServer::GetNumTransactions(uint64_t blockNum) {
   size_t i, res = 0;
 
   for (i = blockNum + 1; i <= currBlockNum; i++) {
-    res += m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+    res += m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
   }
 
   return res;
@@ -1163,7 +1619,8 @@ double LookupServer::GetTxBlockRate() {
 string LookupServer::GetTotalCoinSupply() {
   auto totalSupply = TOTAL_COINBASE_REWARD + TOTAL_GENESIS_TOKEN;
   boost::multiprecision::cpp_dec_float_50 ans(totalSupply.str());
-  const Account* account = AccountStore::GetInstance().GetAccount(NullAddress);
+  const shared_ptr<const Account> account =
+      AccountStore::GetInstance().GetAccountCached(NullAddress);
   boost::multiprecision::cpp_dec_float_50 rewards(account->GetBalance().str());
   ans -= rewards;
   ans /= 1000000000000;  // Convert to ZIL
@@ -1295,7 +1752,7 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
   if (m_TxBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlock(0).GetHeader();
+      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlockHeader(0);
       SHA2<HashType::HASH_VARIANT_256> sha2;
       bytes vec;
       txhead.Serialize(vec, 0);
@@ -1315,15 +1772,13 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
 
   if (currBlockNum > m_TxBlockCache.first) {
     for (uint64_t i = m_TxBlockCache.first + 1; i < currBlockNum; i++) {
-      m_TxBlockCache.second.insert_new(m_TxBlockCache.second.size(),
-                                       m_mediator.m_txBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+      m_TxBlockCache.second.insert_new(
+          m_TxBlockCache.second.size(),
+          m_mediator.m_txBlockChain.GetBlockHeader(i + 1).GetPrevHash().hex());
     }
     // for the latest block
     TxBlockHeader txhead =
-        m_mediator.m_txBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_txBlockChain.GetBlockHeader(currBlockNum);
     SHA2<HashType::HASH_VARIANT_256> sha2;
     bytes vec;
     txhead.Serialize(vec, 0);
@@ -1359,10 +1814,10 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
     for (uint64_t i = offset; i < PAGE_SIZE + offset && i <= currBlockNum;
          i++) {
       tmpJson.clear();
-      tmpJson["Hash"] = m_mediator.m_txBlockChain.GetBlock(currBlockNum - i + 1)
-                            .GetHeader()
-                            .GetPrevHash()
-                            .hex();
+      tmpJson["Hash"] =
+          m_mediator.m_txBlockChain.GetBlockHeader(currBlockNum - i + 1)
+              .GetPrevHash()
+              .hex();
       tmpJson["BlockNum"] = uint(currBlockNum - i);
       _json["data"].append(tmpJson);
     }
@@ -1473,12 +1928,11 @@ string LookupServer::GetNumTxnsDSEpoch() {
 
     if (latestTxBlockNum > m_TxBlockCountSumPair.first) {
       // Case where the DS Epoch is same
-      if (m_mediator.m_txBlockChain.GetBlock(m_TxBlockCountSumPair.first)
-              .GetHeader()
+      if (m_mediator.m_txBlockChain.GetBlockHeader(m_TxBlockCountSumPair.first)
               .GetDSBlockNum() == latestDSBlockNum) {
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
         }
       }
       // Case if DS Epoch Changed
@@ -1486,13 +1940,12 @@ string LookupServer::GetNumTxnsDSEpoch() {
         m_TxBlockCountSumPair.second = 0;
 
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          if (m_mediator.m_txBlockChain.GetBlock(i)
-                  .GetHeader()
-                  .GetDSBlockNum() < latestDSBlockNum) {
+          if (m_mediator.m_txBlockChain.GetBlockHeader(i).GetDSBlockNum() <
+              latestDSBlockNum) {
             break;
           }
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockHeader(i).GetNumTxs();
         }
       }
 
@@ -1522,10 +1975,34 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const string& txBlockNum) {
     throw JsonRpcException(RPC_INVALID_PARAMETER, e.what());
   }
 
+  {
+    lock_guard<mutex> g(m_txnHashesJsonCacheMutex);
+    auto found = m_txnHashesJsonCache.find(txNum);
+    if (found != m_txnHashesJsonCache.end()) {
+      m_txnHashesJsonCacheOrder.splice(m_txnHashesJsonCacheOrder.begin(),
+                                       m_txnHashesJsonCacheOrder,
+                                       found->second.second);
+      return found->second.first;
+    }
+  }
+
   auto const& txBlock = m_mediator.m_txBlockChain.GetBlock(txNum);
 
-  return GetTransactionsForTxBlock(txBlock,
-                                   m_mediator.m_lookup->m_historicalDB);
+  Json::Value json =
+      GetTransactionsForTxBlock(txBlock, m_mediator.m_lookup->m_historicalDB);
+
+  // Only successful responses reach here; failures throw and stay uncached
+  lock_guard<mutex> g(m_txnHashesJsonCacheMutex);
+  if (m_txnHashesJsonCache.find(txNum) == m_txnHashesJsonCache.end()) {
+    m_txnHashesJsonCacheOrder.emplace_front(txNum);
+    m_txnHashesJsonCache.emplace(
+        txNum, make_pair(json, m_txnHashesJsonCacheOrder.begin()));
+    if (m_txnHashesJsonCache.size() > BLOCK_JSON_CACHE_MAX_ENTRIES) {
+      m_txnHashesJsonCache.erase(m_txnHashesJsonCacheOrder.back());
+      m_txnHashesJsonCacheOrder.pop_back();
+    }
+  }
+  return json;
 }
 
 Json::Value LookupServer::GetTxnBodiesForTxBlock(const string& txBlockNum) {
@@ -1588,22 +2065,45 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const TxBlock& txBlock,
   Json::Value _json = Json::arrayValue;
   bool hasTransactions = false;
 
-  for (auto const& mbInfo : microBlockInfos) {
-    MicroBlockSharedPtr mbptr;
+  // Fetch the microblocks on a worker pool so the storage reads overlap;
+  // each one lands in its own slot, keeping the response in shard order
+  vector<MicroBlockSharedPtr> microBlocks(microBlockInfos.size());
+  if (!microBlockInfos.empty()) {
+    const unsigned int NUMTHREADS = min<unsigned int>(
+        microBlockInfos.size(), max(1u, thread::hardware_concurrency()));
+    ThreadPool fetchPool(NUMTHREADS, "MBTxnHashesPool");
+
+    for (unsigned int i = 0; i < microBlockInfos.size(); i++) {
+      fetchPool.AddJob([&microBlockInfos, &microBlocks, historicalDB, i]() {
+        const auto& mbInfo = microBlockInfos.at(i);
+        if (mbInfo.m_txnRootHash == TxnHash()) {
+          return;
+        }
+        if (!BlockStorage::GetBlockStorage().GetMicroBlock(
+                mbInfo.m_microBlockHash, microBlocks.at(i)) &&
+            historicalDB) {
+          BlockStorage::GetBlockStorage().GetHistoricalMicroBlock(
+              mbInfo.m_microBlockHash, microBlocks.at(i));
+        }
+      });
+    }
+
+    while (fetchPool.GetJobsLeft() > 0) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+
+  for (unsigned int i = 0; i < microBlockInfos.size(); i++) {
+    const auto& mbInfo = microBlockInfos.at(i);
     _json[mbInfo.m_shardId] = Json::arrayValue;
 
     if (mbInfo.m_txnRootHash == TxnHash()) {
       continue;
     }
 
-    if (!BlockStorage::GetBlockStorage().GetMicroBlock(mbInfo.m_microBlockHash,
-                                                       mbptr)) {
-      if (!historicalDB) {
-        throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to get Microblock");
-      } else if (!BlockStorage::GetBlockStorage().GetHistoricalMicroBlock(
-                     mbInfo.m_microBlockHash, mbptr)) {
-        throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to get Microblock");
-      }
+    const MicroBlockSharedPtr& mbptr = microBlocks.at(i);
+    if (mbptr == nullptr) {
+      throw JsonRpcException(RPC_DATABASE_ERROR, "Failed to get Microblock");
     }
 
     const std::vector<TxnHash>& tranHashes = mbptr->GetTranHashes();
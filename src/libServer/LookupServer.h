@@ -18,7 +18,13 @@
 #ifndef ZILLIQA_SRC_LIBSERVER_LOOKUPSERVER_H_
 #define ZILLIQA_SRC_LIBSERVER_LOOKUPSERVER_H_
 
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "APIThrottle.h"
 #include "Server.h"
+#include "libUtils/AllocTracker.h"
 
 class Mediator;
 
@@ -41,6 +47,46 @@ class LookupServer : public Server,
   static std::mutex m_mutexRecentTxns;
   std::mt19937 m_eng;
 
+  // Converted block JSON caches: a block is immutable once created, while
+  // dashboards poll the same (usually latest) blocks thousands of times a
+  // minute; bounded by LRU eviction
+  static const unsigned int BLOCK_JSON_CACHE_MAX_ENTRIES = 64;
+  std::mutex m_dsBlockJsonCacheMutex;
+  std::list<uint64_t> m_dsBlockJsonCacheOrder;
+  std::unordered_map<uint64_t,
+                     std::pair<Json::Value, std::list<uint64_t>::iterator>>
+      m_dsBlockJsonCache;
+  std::mutex m_txBlockJsonCacheMutex;
+  std::list<uint64_t> m_txBlockJsonCacheOrder;
+  std::unordered_map<uint64_t,
+                     std::pair<Json::Value, std::list<uint64_t>::iterator>>
+      m_txBlockJsonCache;
+
+  /// Serves the converted block JSON from cache, converting on first use
+  Json::Value GetDsBlockJson(const DSBlock& block);
+  Json::Value GetTxBlockJson(const TxBlock& block);
+
+  // Per-block GetTransactionsForTxBlock responses: the microblock contents
+  // are immutable once the block is final, while explorers request every new
+  // block; bounded by LRU eviction
+  std::mutex m_txnHashesJsonCacheMutex;
+  std::list<uint64_t> m_txnHashesJsonCacheOrder;
+  std::unordered_map<uint64_t,
+                     std::pair<Json::Value, std::list<uint64_t>::iterator>>
+      m_txnHashesJsonCache;
+
+  // Hashes of recently admitted txns: replayed submissions are rejected
+  // here before paying signature verification again; bounded FIFO
+  static const unsigned int TXN_DEDUP_CACHE_MAX_ENTRIES = 16384;
+  std::mutex m_txnDedupMutex;
+  std::list<TxnHash> m_txnDedupOrder;
+  std::unordered_set<TxnHash> m_txnDedupCache;
+
+  /// Whether the txn hash is still in the dedup cache
+  bool IsRecentlyAdmittedTxn(const TxnHash& txhash);
+  /// Records an admitted txn hash, evicting the oldest entry when full
+  void RecordAdmittedTxn(const TxnHash& txhash);
+
   CreateTransactionTargetFunc m_createTransactionTarget =
       [this](const Transaction& tx, uint32_t shardId) -> bool {
     return m_mediator.m_lookup->AddToTxnShardMap(tx, shardId);
@@ -52,6 +98,20 @@ class LookupServer : public Server,
   LookupServer(Mediator& mediator, jsonrpc::AbstractServerConnector& server);
   ~LookupServer() = default;
 
+  /// Admission-controlled dispatch: the method runs under the bounded pool
+  /// matching its cost class
+  virtual void HandleMethodCall(jsonrpc::Procedure& proc,
+                                const Json::Value& input,
+                                Json::Value& output) {
+#ifdef ENABLE_ALLOC_TRACKING
+    // attribute everything the handler allocates to this RPC method
+    AllocTracker::ScopeTag allocTag(proc.GetProcedureName());
+#endif
+    APIThrottle::Guard guard(proc.GetProcedureName());
+    jsonrpc::AbstractServer<LookupServer>::HandleMethodCall(proc, input,
+                                                            output);
+  }
+
   inline virtual void GetNetworkIdI(const Json::Value& request,
                                     Json::Value& response) {
     (void)request;
@@ -59,15 +119,30 @@ class LookupServer : public Server,
   }
   inline virtual void CreateTransactionI(const Json::Value& request,
                                          Json::Value& response) {
-    response = CreateTransaction(
-        request[0u], m_mediator.m_lookup->GetShardPeers().size(),
-        m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetGasPrice(),
-        m_createTransactionTarget);
+    const auto epochContext = m_mediator.GetEpochContext();
+    response = CreateTransaction(request[0u], epochContext->numShards,
+                                 epochContext->gasPrice,
+                                 m_createTransactionTarget);
   }
   inline virtual void GetTransactionI(const Json::Value& request,
                                       Json::Value& response) {
     response = this->GetTransaction(request[0u].asString());
   }
+  inline virtual void GetTransactionsBatchI(const Json::Value& request,
+                                            Json::Value& response) {
+    response = this->GetTransactionsBatch(request[0u]);
+  }
+  inline virtual void GetEventLogsI(const Json::Value& request,
+                                    Json::Value& response) {
+    response = this->GetEventLogs(request[0u].asString(),
+                                  request[1u].asString(),
+                                  request[2u].asString());
+  }
+  inline virtual void GetTransactionsForAddressI(const Json::Value& request,
+                                                 Json::Value& response) {
+    response = this->GetTransactionsForAddress(request[0u].asString(),
+                                               request[1u].asUInt());
+  }
   inline virtual void GetDsBlockI(const Json::Value& request,
                                   Json::Value& response) {
     response = this->GetDsBlock(request[0u].asString());
@@ -90,6 +165,10 @@ class LookupServer : public Server,
                                   Json::Value& response) {
     response = this->GetBalance(request[0u].asString());
   }
+  inline virtual void GetAccountProofI(const Json::Value& request,
+                                       Json::Value& response) {
+    response = this->GetAccountProof(request[0u].asString());
+  }
   inline virtual void GetMinimumGasPriceI(const Json::Value& request,
                                           Json::Value& response) {
     (void)request;
@@ -179,10 +258,20 @@ class LookupServer : public Server,
     response = this->GetSmartContractState(request[0u].asString(),
                                            request[1u].asString(), request[2u]);
   }
+  inline virtual void GetSmartContractSubStateBatchI(const Json::Value& request,
+                                                     Json::Value& response) {
+    response = this->GetSmartContractSubStateBatch(request[0u].asString(),
+                                                   request[1u]);
+  }
   inline virtual void GetSmartContractStateI(const Json::Value& request,
                                              Json::Value& response) {
     response = this->GetSmartContractState(request[0u].asString());
   }
+  inline virtual void GetSmartContractStatePageI(const Json::Value& request,
+                                                 Json::Value& response) {
+    response = this->GetSmartContractStatePage(
+        request[0u].asString(), request[1u].asString(), request[2u].asUInt());
+  }
   inline virtual void GetSmartContractCodeI(const Json::Value& request,
                                             Json::Value& response) {
     response = this->GetSmartContractCode(request[0u].asString());
@@ -227,11 +316,18 @@ class LookupServer : public Server,
       const Json::Value& _json, const unsigned int num_shards,
       const uint128_t& gasPrice, const CreateTransactionTargetFunc& targetFunc);
   Json::Value GetTransaction(const std::string& transactionHash);
+  Json::Value GetTransactionsBatch(const Json::Value& transactionHashes);
+  Json::Value GetEventLogs(const std::string& address,
+                           const std::string& fromBlock,
+                           const std::string& toBlock);
+  Json::Value GetTransactionsForAddress(const std::string& address,
+                                        unsigned int page);
   Json::Value GetDsBlock(const std::string& blockNum);
   Json::Value GetTxBlock(const std::string& blockNum);
   Json::Value GetLatestDsBlock();
   Json::Value GetLatestTxBlock();
   Json::Value GetBalance(const std::string& address);
+  Json::Value GetAccountProof(const std::string& address);
   std::string GetMinimumGasPrice();
   Json::Value GetSmartContracts(const std::string& address);
   std::string GetContractAddressFromTransactionID(const std::string& tranID);
@@ -265,6 +361,11 @@ class LookupServer : public Server,
   Json::Value GetSmartContractState(
       const std::string& address, const std::string& vname = "",
       const Json::Value& indices = Json::arrayValue);
+  Json::Value GetSmartContractSubStateBatch(const std::string& address,
+                                            const Json::Value& queries);
+  Json::Value GetSmartContractStatePage(const std::string& address,
+                                        const std::string& cursor,
+                                        unsigned int pageSize);
   Json::Value GetSmartContractInit(const std::string& address);
   Json::Value GetSmartContractCode(const std::string& address);
 
@@ -19,6 +19,7 @@
 
 #include "libPersistence/ContractStorage2.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/ScillaProfiler.h"
 
 #include "ScillaIPCServer.h"
 
@@ -32,17 +33,28 @@ ScillaIPCServer::ScillaIPCServer(AbstractServerConnector &conn)
   bindAndAddMethod(Procedure("fetchStateValue", PARAMS_BY_NAME, JSON_OBJECT,
                              "query", JSON_STRING, NULL),
                    &ScillaIPCServer::fetchStateValueI);
+  bindAndAddMethod(Procedure("fetchStateValues", PARAMS_BY_NAME, JSON_OBJECT,
+                             "queries", JSON_ARRAY, NULL),
+                   &ScillaIPCServer::fetchStateValuesI);
   bindAndAddMethod(Procedure("updateStateValue", PARAMS_BY_NAME, JSON_STRING,
                              "query", JSON_STRING, "value", JSON_STRING, NULL),
                    &ScillaIPCServer::updateStateValueI);
 }
 
 void ScillaIPCServer::setContractAddress(const Address &address) {
+  lock_guard<mutex> g(m_contrAddrMutex);
   m_contrAddr = address;
 }
 
+Address ScillaIPCServer::getContractAddress() const {
+  lock_guard<mutex> g(m_contrAddrMutex);
+  return m_contrAddr;
+}
+
 void ScillaIPCServer::fetchStateValueI(const Json::Value &request,
                                        Json::Value &response) {
+  ScillaProfiler::GetInstance().OnStateFetch();
+
   std::string value;
   bool found;
   if (!fetchStateValue(request["query"].asString(), value, found)) {
@@ -55,8 +67,34 @@ void ScillaIPCServer::fetchStateValueI(const Json::Value &request,
   response.append(Json::Value(value));
 }
 
+void ScillaIPCServer::fetchStateValuesI(const Json::Value &request,
+                                        Json::Value &response) {
+  // Batched variant of fetchStateValue: an interpreter that knows up front
+  // which fields it will access can prefetch them all in a single round
+  // trip instead of one RPC per map key.
+  ScillaProfiler::GetInstance().OnStateFetch();
+
+  response.clear();
+  response.resize(0);
+
+  for (const auto &query : request["queries"]) {
+    std::string value;
+    bool found;
+    if (!fetchStateValue(query.asString(), value, found)) {
+      throw JsonRpcException("Fetching state value failed");
+    }
+
+    Json::Value result;
+    result.append(Json::Value(found));
+    result.append(Json::Value(value));
+    response.append(result);
+  }
+}
+
 void ScillaIPCServer::updateStateValueI(const Json::Value &request,
                                         Json::Value &response) {
+  ScillaProfiler::GetInstance().OnStateUpdate();
+
   if (!updateStateValue(request["query"].asString(),
                         request["value"].asString())) {
     throw JsonRpcException("Updating state value failed");
@@ -71,8 +109,8 @@ bool ScillaIPCServer::fetchStateValue(const string &query, string &value,
   bytes destination;
 
   if (!ContractStorage2::GetContractStorage().FetchStateValue(
-          m_contrAddr, DataConversion::StringToCharArray(query), 0, destination,
-          0, found)) {
+          getContractAddress(), DataConversion::StringToCharArray(query), 0,
+          destination, 0, found)) {
     return false;
   }
 
@@ -84,6 +122,6 @@ bool ScillaIPCServer::fetchStateValue(const string &query, string &value,
 bool ScillaIPCServer::updateStateValue(const string &query,
                                        const string &value) {
   return ContractStorage2::GetContractStorage().UpdateStateValue(
-      m_contrAddr, DataConversion::StringToCharArray(query), 0,
+      getContractAddress(), DataConversion::StringToCharArray(query), 0,
       DataConversion::StringToCharArray(value), 0);
 }
@@ -17,6 +17,8 @@
 #ifndef ZILLIQA_SRC_LIBSERVER_SCILLAIPCSERVER_H_
 #define ZILLIQA_SRC_LIBSERVER_SCILLAIPCSERVER_H_
 
+#include <mutex>
+
 #include <jsonrpccpp/server.h>
 #include <jsonrpccpp/server/abstractserver.h>
 #include <jsonrpccpp/server/connectors/unixdomainsocketserver.h>
@@ -32,6 +34,8 @@ class ScillaIPCServer : public jsonrpc::AbstractServer<ScillaIPCServer> {
 
   inline virtual void fetchStateValueI(const Json::Value& request,
                                        Json::Value& response);
+  inline virtual void fetchStateValuesI(const Json::Value& request,
+                                        Json::Value& response);
   inline virtual void updateStateValueI(const Json::Value& request,
                                         Json::Value& response);
   virtual bool fetchStateValue(const std::string& query, std::string& value,
@@ -41,6 +45,13 @@ class ScillaIPCServer : public jsonrpc::AbstractServer<ScillaIPCServer> {
   void setContractAddress(const Address& address);
 
  private:
+  /// Snapshot of the current target contract, taken once per request
+  Address getContractAddress() const;
+
+  // The executor sets the target contract before invoking the interpreter;
+  // guarded so a handler serving one IPC session reads a consistent address
+  // while another execution is being set up
+  mutable std::mutex m_contrAddrMutex;
   Address m_contrAddr = Address();
 };
 
@@ -57,6 +57,7 @@ class ServerBase {
         -26,  //!< Transaction or block was rejected by network rules
     RPC_IN_WARMUP = -28,          //!< Client still warming up
     RPC_METHOD_DEPRECATED = -32,  //!< RPC method is deprecated
+    RPC_SERVER_BUSY = -36,  //!< Request rejected by admission control
   };
 };
 
@@ -18,6 +18,7 @@
 #ifndef ZILLIQA_SRC_LIBSERVER_STAKINGSERVER_H_
 #define ZILLIQA_SRC_LIBSERVER_STAKINGSERVER_H_
 
+#include "APIThrottle.h"
 #include "Server.h"
 
 class Mediator;
@@ -38,6 +39,16 @@ class StakingServer : public Server,
  public:
   StakingServer(Mediator& mediator, jsonrpc::AbstractServerConnector& server);
   ~StakingServer() = default;
+
+  /// Admission-controlled dispatch: the method runs under the bounded pool
+  /// matching its cost class
+  virtual void HandleMethodCall(jsonrpc::Procedure& proc,
+                                const Json::Value& input,
+                                Json::Value& output) {
+    APIThrottle::Guard guard(proc.GetProcedureName());
+    jsonrpc::AbstractServer<StakingServer>::HandleMethodCall(proc, input,
+                                                             output);
+  }
 };
 
 #endif  // ZILLIQA_SRC_LIBSERVER_STAKINGSERVER_H_
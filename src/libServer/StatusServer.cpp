@@ -18,6 +18,13 @@
 #include "StatusServer.h"
 #include "JSONConversion.h"
 #include "libNetwork/Blacklist.h"
+#include "libUtils/AllocTracker.h"
+#include "libUtils/DetachedFunction.h"
+#include "libUtils/EpochPhaseTracker.h"
+#include "libUtils/EpochWatchdog.h"
+#include "libUtils/LockProfiler.h"
+#include "libUtils/MemoryBudget.h"
+#include "libUtils/ScillaProfiler.h"
 
 using namespace jsonrpc;
 using namespace std;
@@ -65,6 +72,10 @@ StatusServer::StatusServer(Mediator& mediator,
       jsonrpc::Procedure("GetDSCommittee", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, NULL),
       &StatusServer::GetDSCommitteeI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetChainTip", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetChainTipI);
   this->bindAndAddMethod(jsonrpc::Procedure("GetLatestEpochStatesUpdated",
                                             jsonrpc::PARAMS_BY_POSITION,
                                             jsonrpc::JSON_STRING, NULL),
@@ -98,6 +109,51 @@ StatusServer::StatusServer(Mediator& mediator,
       jsonrpc::Procedure("ToggleDisableTxns", jsonrpc::PARAMS_BY_POSITION,
                          jsonrpc::JSON_OBJECT, NULL),
       &StatusServer::ToggleDisableTxnsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetTxBodyMissCacheStats", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetTxBodyMissCacheStatsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetAPILatencyHistograms", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetAPILatencyHistogramsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetDetachedFunctionStats",
+                         jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,
+                         NULL),
+      &StatusServer::GetDetachedFunctionStatsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetEpochPhaseSpans", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetEpochPhaseSpansI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetAllocationStats", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetAllocationStatsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetMemoryBudget", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetMemoryBudgetI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetScillaProfile", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetScillaProfileI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetLockContention", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetLockContentionI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("GetEpochBlameReports", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_OBJECT, NULL),
+      &StatusServer::GetEpochBlameReportsI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("ExportCheckpoint", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_BOOLEAN, NULL),
+      &StatusServer::ExportCheckpointI);
+  this->bindAndAddMethod(
+      jsonrpc::Procedure("PrepareHandoff", jsonrpc::PARAMS_BY_POSITION,
+                         jsonrpc::JSON_BOOLEAN, NULL),
+      &StatusServer::PrepareHandoffI);
 }
 
 string StatusServer::GetLatestEpochStatesUpdated() {
@@ -118,6 +174,27 @@ string StatusServer::GetEpochFin() {
   return to_string(epochNum);
 }
 
+Json::Value StatusServer::GetChainTip() {
+  Json::Value ret;
+
+  const TxBlock& txBlock = m_mediator.m_txBlockChain.GetLastBlock();
+  const DSBlock& dsBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+
+  ret["TxBlockNum"] = to_string(txBlock.GetHeader().GetBlockNum());
+  ret["TxBlockTimestamp"] = to_string(txBlock.GetTimestamp());
+  ret["DSBlockNum"] = to_string(dsBlock.GetHeader().GetBlockNum());
+
+  if (m_mediator.m_DSCommittee != NULL) {
+    lock_guard<mutex> g(m_mediator.m_mutexDSCommittee);
+    ret["DSCommitteeSize"] =
+        static_cast<Json::UInt64>(m_mediator.m_DSCommittee->size());
+  }
+
+  ret["HeadersOnly"] = SYNC_HEADERS_ONLY;
+
+  return ret;
+}
+
 Json::Value StatusServer::GetDSCommittee() {
   if (m_mediator.m_DSCommittee == NULL) {
     throw JsonRpcException(RPC_INTERNAL_ERROR, "DS Committee empty");
@@ -258,6 +335,230 @@ bool StatusServer::DisablePoW() {
   return true;
 }
 
+bool StatusServer::ExportCheckpoint() {
+  if (!BlockStorage::GetBlockStorage().ExportCheckpoint(
+          m_mediator.m_currentEpochNum, STORAGE_PATH + "/checkpoints")) {
+    throw JsonRpcException(RPC_INTERNAL_ERROR, "Checkpoint export failed");
+  }
+  return true;
+}
+
+bool StatusServer::PrepareHandoff() {
+  if (LOOKUP_NODE_MODE) {
+    throw JsonRpcException(RPC_INVALID_REQUEST, "Not to be queried on lookup");
+  }
+  if (!m_mediator.m_node->ExportMempoolForHandoff()) {
+    throw JsonRpcException(RPC_INTERNAL_ERROR, "Mempool export failed");
+  }
+  return true;
+}
+
+Json::Value StatusServer::GetAPILatencyHistograms() {
+  return APIThrottle::GetInstance().GetLatencyHistograms();
+}
+
+Json::Value StatusServer::GetDetachedFunctionStats() {
+  Json::Value _json;
+  _json["poolSize"] = DetachedFunction::PoolSize;
+  _json["pooledJobs"] = static_cast<Json::UInt64>(
+      DetachedFunction::GetPooledJobCount().load(std::memory_order_relaxed));
+  _json["overflowThreads"] = static_cast<Json::UInt64>(
+      DetachedFunction::GetOverflowThreadCount().load(
+          std::memory_order_relaxed));
+  return _json;
+}
+
+Json::Value StatusServer::GetEpochPhaseSpans() {
+  std::vector<EpochPhaseTracker::Span> spans;
+  EpochPhaseTracker::GetInstance().GetSpans(spans);
+
+  Json::Value _json;
+  Json::Value spansJson = Json::arrayValue;
+  for (const auto& span : spans) {
+    Json::Value entry;
+    entry["epoch"] = static_cast<Json::UInt64>(span.epoch);
+    entry["phase"] = span.phase;
+    entry["startTimestampMicros"] =
+        static_cast<Json::UInt64>(span.startTimestampMicros);
+    entry["durationMicros"] = static_cast<Json::UInt64>(span.durationMicros);
+    spansJson.append(entry);
+  }
+  _json["spans"] = spansJson;
+
+  return _json;
+}
+
+Json::Value StatusServer::GetAllocationStats() {
+  const size_t topN = 20;
+
+  Json::Value _json;
+  _json["enabled"] = AllocTracker::Enabled();
+
+  Json::Value tagsJson = Json::arrayValue;
+  if (AllocTracker::Enabled()) {
+    std::vector<AllocTracker::TagReport> reports;
+    AllocTracker::GetInstance().GetTopTags(reports, topN);
+    for (const auto& report : reports) {
+      Json::Value entry;
+      entry["tag"] = report.tag;
+      entry["liveBytes"] = static_cast<Json::UInt64>(report.liveBytes);
+      entry["liveAllocs"] = static_cast<Json::UInt64>(report.liveAllocs);
+      entry["totalBytes"] = static_cast<Json::UInt64>(report.totalBytes);
+      entry["totalAllocs"] = static_cast<Json::UInt64>(report.totalAllocs);
+      tagsJson.append(entry);
+    }
+  }
+  _json["tags"] = tagsJson;
+
+  return _json;
+}
+
+Json::Value StatusServer::GetMemoryBudget() {
+  Json::Value _json;
+  _json["budgetMB"] = CACHE_MEMORY_BUDGET_MB;
+
+  std::vector<MemoryBudget::CacheReport> reports;
+  uint64_t totalBytes = 0;
+  MemoryBudget::GetInstance().GetReports(reports, totalBytes);
+
+  Json::Value cachesJson = Json::arrayValue;
+  for (const auto& report : reports) {
+    Json::Value entry;
+    entry["name"] = report.name;
+    entry["tier"] = MemoryBudget::TierToString(report.tier);
+    entry["usageBytes"] = static_cast<Json::UInt64>(report.usageBytes);
+    cachesJson.append(entry);
+  }
+  _json["caches"] = cachesJson;
+  _json["totalBytes"] = static_cast<Json::UInt64>(totalBytes);
+  _json["totalBytesShed"] =
+      static_cast<Json::UInt64>(MemoryBudget::GetInstance().GetTotalBytesShed());
+
+  return _json;
+}
+
+Json::Value StatusServer::GetScillaProfile() {
+  const size_t topN = 20;
+
+  Json::Value _json;
+  _json["enabled"] = ENABLE_SCILLA_PROFILE;
+
+  Json::Value contractsJson = Json::arrayValue;
+  if (ENABLE_SCILLA_PROFILE) {
+    std::vector<ScillaProfiler::ContractReport> reports;
+    ScillaProfiler::GetInstance().GetTopContracts(reports, topN);
+    for (const auto& report : reports) {
+      Json::Value entry;
+      entry["address"] = report.address;
+      entry["invocations"] = static_cast<Json::UInt64>(report.invocations);
+      entry["failures"] = static_cast<Json::UInt64>(report.failures);
+      entry["wallMicros"] = static_cast<Json::UInt64>(report.wallMicros);
+      entry["maxWallMicros"] = static_cast<Json::UInt64>(report.maxWallMicros);
+      entry["ipcFetches"] = static_cast<Json::UInt64>(report.ipcFetches);
+      entry["ipcUpdates"] = static_cast<Json::UInt64>(report.ipcUpdates);
+      entry["outputBytes"] = static_cast<Json::UInt64>(report.outputBytes);
+      entry["gasUsed"] = static_cast<Json::UInt64>(report.gasUsed);
+      contractsJson.append(entry);
+    }
+  }
+  _json["contracts"] = contractsJson;
+
+  return _json;
+}
+
+Json::Value StatusServer::GetLockContention() {
+  Json::Value _json;
+
+  Json::Value bounds = Json::arrayValue;
+  for (const uint64_t bound : LockProfiler::WaitBucketUpperBoundsMicros()) {
+    bounds.append(static_cast<Json::UInt64>(bound));
+  }
+  _json["bucketUpperBoundsMicros"] = bounds;
+
+  std::vector<LockProfiler::LockReport> reports;
+  LockProfiler::GetInstance().GetReports(reports);
+
+  Json::Value locksJson = Json::arrayValue;
+  for (const auto& report : reports) {
+    Json::Value entry;
+    entry["name"] = report.name;
+    entry["acquisitions"] = static_cast<Json::UInt64>(report.acquisitions);
+    entry["contended"] = static_cast<Json::UInt64>(report.contended);
+    entry["totalWaitMicros"] =
+        static_cast<Json::UInt64>(report.totalWaitMicros);
+    entry["maxWaitMicros"] = static_cast<Json::UInt64>(report.maxWaitMicros);
+    Json::Value counts = Json::arrayValue;
+    for (const uint64_t count : report.waitBuckets) {
+      counts.append(static_cast<Json::UInt64>(count));
+    }
+    entry["waitHistogram"] = counts;
+    locksJson.append(entry);
+  }
+  _json["locks"] = locksJson;
+
+  return _json;
+}
+
+Json::Value StatusServer::GetEpochBlameReports() {
+  std::vector<EpochWatchdog::Report> reports;
+  EpochWatchdog::GetInstance().GetReports(reports);
+
+  Json::Value _json;
+  _json["sloMs"] = EPOCH_TIME_SLO_MS;
+
+  Json::Value reportsJson = Json::arrayValue;
+  for (const auto& report : reports) {
+    Json::Value entry;
+    entry["epoch"] = static_cast<Json::UInt64>(report.epoch);
+    entry["timestampMicros"] =
+        static_cast<Json::UInt64>(report.timestampMicros);
+    entry["epochTimeMicros"] =
+        static_cast<Json::UInt64>(report.epochTimeMicros);
+    entry["sloMicros"] = static_cast<Json::UInt64>(report.sloMicros);
+    entry["worstPhase"] = report.worstPhase;
+
+    Json::Value phasesJson = Json::arrayValue;
+    for (const auto& phase : report.phases) {
+      Json::Value phaseJson;
+      phaseJson["phase"] = phase.phase;
+      phaseJson["durationMicros"] =
+          static_cast<Json::UInt64>(phase.durationMicros);
+      phaseJson["baselineMicros"] =
+          static_cast<Json::UInt64>(phase.baselineMicros);
+      phasesJson.append(phaseJson);
+    }
+    entry["phases"] = phasesJson;
+
+    Json::Value gaugesJson(Json::objectValue);
+    for (const auto& gauge : report.gauges) {
+      gaugesJson[gauge.name] = static_cast<Json::UInt64>(gauge.value);
+    }
+    entry["gauges"] = gaugesJson;
+
+    Json::Value detailsJson(Json::objectValue);
+    for (const auto& detail : report.details) {
+      detailsJson[detail.first] = detail.second;
+    }
+    entry["details"] = detailsJson;
+
+    reportsJson.append(entry);
+  }
+  _json["reports"] = reportsJson;
+
+  return _json;
+}
+
+Json::Value StatusServer::GetTxBodyMissCacheStats() {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  BlockStorage::GetBlockStorage().GetTxBodyMissCacheStats(hits, misses);
+
+  Json::Value _json;
+  _json["hits"] = static_cast<Json::UInt64>(hits);
+  _json["misses"] = static_cast<Json::UInt64>(misses);
+  return _json;
+}
+
 bool StatusServer::ToggleDisableTxns() {
   if (!LOOKUP_NODE_MODE) {
     throw JsonRpcException(RPC_INVALID_REQUEST,
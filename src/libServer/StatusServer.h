@@ -18,12 +18,24 @@
 #ifndef ZILLIQA_SRC_LIBSERVER_STATUSSERVER_H_
 #define ZILLIQA_SRC_LIBSERVER_STATUSSERVER_H_
 
+#include "APIThrottle.h"
 #include "Server.h"
 
 class StatusServer : public Server,
                      public jsonrpc::AbstractServer<StatusServer> {
  public:
   StatusServer(Mediator& mediator, jsonrpc::AbstractServerConnector& server);
+
+  /// Admission-controlled dispatch: the method runs under the bounded pool
+  /// matching its cost class
+  virtual void HandleMethodCall(jsonrpc::Procedure& proc,
+                                const Json::Value& input,
+                                Json::Value& output) {
+    APIThrottle::Guard guard(proc.GetProcedureName());
+    jsonrpc::AbstractServer<StatusServer>::HandleMethodCall(proc, input,
+                                                            output);
+  }
+
   inline virtual void GetNodeStateI(const Json::Value& request,
                                     Json::Value& response) {
     (void)request;
@@ -57,6 +69,11 @@ class StatusServer : public Server,
     (void)request;
     response = this->GetDSCommittee();
   }
+  inline virtual void GetChainTipI(const Json::Value& request,
+                                   Json::Value& response) {
+    (void)request;
+    response = this->GetChainTip();
+  }
   inline virtual void ToggleSendSCCallsToDSI(const Json::Value& request,
                                              Json::Value& response) {
     (void)request;
@@ -77,6 +94,61 @@ class StatusServer : public Server,
     (void)request;
     response = this->ToggleDisableTxns();
   }
+  inline virtual void GetTxBodyMissCacheStatsI(const Json::Value& request,
+                                               Json::Value& response) {
+    (void)request;
+    response = this->GetTxBodyMissCacheStats();
+  }
+  inline virtual void GetAPILatencyHistogramsI(const Json::Value& request,
+                                               Json::Value& response) {
+    (void)request;
+    response = this->GetAPILatencyHistograms();
+  }
+  inline virtual void GetDetachedFunctionStatsI(const Json::Value& request,
+                                                Json::Value& response) {
+    (void)request;
+    response = this->GetDetachedFunctionStats();
+  }
+  inline virtual void GetEpochPhaseSpansI(const Json::Value& request,
+                                          Json::Value& response) {
+    (void)request;
+    response = this->GetEpochPhaseSpans();
+  }
+  inline virtual void GetAllocationStatsI(const Json::Value& request,
+                                          Json::Value& response) {
+    (void)request;
+    response = this->GetAllocationStats();
+  }
+  inline virtual void GetMemoryBudgetI(const Json::Value& request,
+                                       Json::Value& response) {
+    (void)request;
+    response = this->GetMemoryBudget();
+  }
+  inline virtual void GetScillaProfileI(const Json::Value& request,
+                                        Json::Value& response) {
+    (void)request;
+    response = this->GetScillaProfile();
+  }
+  inline virtual void GetLockContentionI(const Json::Value& request,
+                                         Json::Value& response) {
+    (void)request;
+    response = this->GetLockContention();
+  }
+  inline virtual void GetEpochBlameReportsI(const Json::Value& request,
+                                            Json::Value& response) {
+    (void)request;
+    response = this->GetEpochBlameReports();
+  }
+  inline virtual void ExportCheckpointI(const Json::Value& request,
+                                        Json::Value& response) {
+    (void)request;
+    response = this->ExportCheckpoint();
+  }
+  inline virtual void PrepareHandoffI(const Json::Value& request,
+                                      Json::Value& response) {
+    (void)request;
+    response = this->PrepareHandoff();
+  }
 
   Json::Value IsTxnInMemPool(const std::string& tranID);
   bool AddToBlacklistExclusion(const std::string& ipAddr);
@@ -85,10 +157,31 @@ class StatusServer : public Server,
   std::string GetLatestEpochStatesUpdated();
   std::string GetEpochFin();
   Json::Value GetDSCommittee();
+
+  /// Latest tx and DS block info plus committee size; cheap enough for
+  /// header-only monitoring followers to poll
+  Json::Value GetChainTip();
   bool ToggleSendSCCallsToDS();
   bool GetSendSCCallsToDS();
   bool DisablePoW();
   bool ToggleDisableTxns();
+  Json::Value GetTxBodyMissCacheStats();
+  Json::Value GetAPILatencyHistograms();
+  Json::Value GetDetachedFunctionStats();
+  Json::Value GetEpochPhaseSpans();
+  Json::Value GetAllocationStats();
+
+  /// Per-cache usage breakdown from the MemoryBudget registry, plus the
+  /// configured budget and the bytes shed so far
+  Json::Value GetMemoryBudget();
+  Json::Value GetScillaProfile();
+  Json::Value GetLockContention();
+  Json::Value GetEpochBlameReports();
+  bool ExportCheckpoint();
+
+  /// Persists the pending mempool so the restarted process resumes with it;
+  /// called by the upgrade tooling right before the daemon restarts the node
+  bool PrepareHandoff();
 };
 
 #endif  // ZILLIQA_SRC_LIBSERVER_STATUSSERVER_H_
@@ -15,6 +15,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+
 #include "WebsocketServer.h"
 #include "LookupServer.h"
 
@@ -25,15 +29,22 @@
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/BlockData/BlockHeader/BlockHashSet.h"
+#include "libPersistence/BlockStorage.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/JsonUtils.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
 using websocketpp::connection_hdl;
 
 using namespace std;
 using namespace dev;
 
+/// Cap on bytes queued on one connection's outgoing buffer; a consumer that
+/// cannot drain its socket this far behind is dropped instead of holding
+/// frame memory for every subsequent block
+const size_t WEBSOCKET_MAX_OUT_BUFFERED_BYTES = 1024 * 1024;
+
 websocketserver WebsocketServer::m_server;
 
 std::mutex WebsocketServer::m_mutexSubscriptions;
@@ -44,6 +55,10 @@ std::map<websocketpp::connection_hdl, Subscription,
 std::mutex WebsocketServer::m_mutexEventLogAddrHdlTracker;
 EventLogAddrHdlTracker WebsocketServer::m_eventLogAddrHdlTracker;
 
+std::map<websocketpp::connection_hdl, std::set<uint32_t>,
+         std::owner_less<connection_hdl>>
+    WebsocketServer::m_eventLogNameFilters;
+
 std::mutex WebsocketServer::m_mutexEventLogDataBuffer;
 std::map<websocketpp::connection_hdl, std::unordered_map<Address, Json::Value>,
          std::owner_less<connection_hdl>>
@@ -58,6 +73,18 @@ std::map<websocketpp::connection_hdl, std::unordered_map<Address, Json::Value>,
 EventLogAddrHdlTracker WebsocketServer::m_txnLogAddrHdlTracker;
 std::mutex WebsocketServer::m_mutexTxnLogAddrHdlTracker;
 
+std::mutex WebsocketServer::m_mutexEventLogIndex;
+std::map<Address, std::vector<IndexedEventLog>> WebsocketServer::m_eventLogIndex;
+
+uint32_t WebsocketServer::InternEventName(const string& eventName) {
+  static mutex internMutex;
+  static unordered_map<string, uint32_t> ids;
+
+  lock_guard<mutex> g(internMutex);
+  return ids.emplace(eventName, static_cast<uint32_t>(ids.size()))
+      .first->second;
+}
+
 bool WebsocketServer::start() {
   LOG_MARKER();
   clean();
@@ -146,6 +173,7 @@ void WebsocketServer::clean() {
   {
     lock_guard<mutex> g(m_mutexEventLogAddrHdlTracker);
     m_eventLogAddrHdlTracker.clear();
+    m_eventLogNameFilters.clear();
   }
   {
     lock_guard<mutex> g(m_mutexEventLogDataBuffer);
@@ -163,12 +191,32 @@ void WebsocketServer::clean() {
     lock_guard<mutex> g(m_mutexTxnLogAddrHdlTracker);
     m_txnLogAddrHdlTracker.clear();
   }
+  {
+    lock_guard<mutex> g(m_mutexEventLogIndex);
+    m_eventLogIndex.clear();
+  }
 }
 
 bool WebsocketServer::sendData(const connection_hdl& hdl, const string& data) {
   LOG_MARKER();
   websocketpp::lib::error_code ec;
-  m_server.send(hdl, data, websocketpp::frame::opcode::text, ec);
+  websocketserver::connection_ptr con = m_server.get_con_from_hdl(hdl, ec);
+  if (ec) {
+    LOG_GENERAL(WARNING,
+                "websocket get_con_from_hdl failed, error: " << ec.message());
+    return false;
+  }
+
+  // websocketpp sends are asynchronous: frames queue on the connection until
+  // the socket drains. Refuse to queue more onto a connection that is already
+  // too far behind, so the slow consumer gets closed instead of buffering
+  // unboundedly
+  if (con->get_buffered_amount() > WEBSOCKET_MAX_OUT_BUFFERED_BYTES) {
+    LOG_GENERAL(WARNING, "websocket send buffer full for slow consumer");
+    return false;
+  }
+
+  ec = con->send(data, websocketpp::frame::opcode::text);
   if (ec) {
     LOG_GENERAL(WARNING, "websocket send failed, error: " << ec.message());
     return false;
@@ -261,13 +309,39 @@ void WebsocketServer::on_message(const connection_hdl& hdl,
           if (el_addresses.empty()) {
             response = "no contract found in list";
           } else {
-            {
-              lock_guard<mutex> g(m_mutexSubscriptions);
-              m_subscriptions[hdl].subscribe(EVENTLOG);
+            // compile the optional event-name filter to interned ids up
+            // front, so per-block matching never touches the strings
+            set<uint32_t> nameIds;
+            bool valid_names = true;
+            if (j_query.isMember("eventnames")) {
+              if (j_query["eventnames"].isArray()) {
+                for (const auto& name : j_query["eventnames"]) {
+                  if (!name.isString()) {
+                    valid_names = false;
+                    break;
+                  }
+                  nameIds.emplace(InternEventName(name.asString()));
+                }
+              } else {
+                valid_names = false;
+              }
             }
-            {
-              lock_guard<mutex> g(m_mutexEventLogAddrHdlTracker);
-              m_eventLogAddrHdlTracker.update(hdl, el_addresses);
+            if (!valid_names) {
+              response = "invalid eventnames field";
+            } else {
+              {
+                lock_guard<mutex> g(m_mutexSubscriptions);
+                m_subscriptions[hdl].subscribe(EVENTLOG);
+              }
+              {
+                lock_guard<mutex> g(m_mutexEventLogAddrHdlTracker);
+                m_eventLogAddrHdlTracker.update(hdl, el_addresses);
+                if (nameIds.empty()) {
+                  m_eventLogNameFilters.erase(hdl);
+                } else {
+                  m_eventLogNameFilters[hdl] = std::move(nameIds);
+                }
+              }
             }
           }
         } else {
@@ -437,22 +511,69 @@ void WebsocketServer::ParseTxnEventLog(const TransactionWithReceipt& twr) {
 
     try {
       Address addr(log["address"].asString());
-      lock_guard<mutex> g(m_mutexEventLogAddrHdlTracker);
-      auto find = m_eventLogAddrHdlTracker.m_addr_hdl_map.find(addr);
+      IndexedEventLog entry;
+      entry.nameId = InternEventName(log["_eventname"].asString());
+      entry.json["_eventname"] = log["_eventname"];
+      entry.json["params"] = log["params"];
+      // every event is indexed regardless of subscriptions; matching against
+      // subscribers happens once per block in FinalizeEventLogIndex
+      lock_guard<mutex> g(m_mutexEventLogIndex);
+      m_eventLogIndex[addr].emplace_back(std::move(entry));
+    } catch (...) {
+      continue;
+    }
+  }
+}
+
+void WebsocketServer::FinalizeEventLogIndex(uint64_t epochNum) {
+  LOG_MARKER();
+
+  std::map<Address, std::vector<IndexedEventLog>> index;
+  {
+    lock_guard<mutex> g(m_mutexEventLogIndex);
+    index.swap(m_eventLogIndex);
+  }
+
+  if (index.empty()) {
+    return;
+  }
+
+  // one tracker lookup per distinct emitting address, instead of one per
+  // event at receipt parse time; name filters compare interned ids only
+  {
+    lock(m_mutexEventLogAddrHdlTracker, m_mutexEventLogDataBuffer);
+    lock_guard<mutex> g(m_mutexEventLogAddrHdlTracker, adopt_lock);
+    lock_guard<mutex> h(m_mutexEventLogDataBuffer, adopt_lock);
+    for (const auto& entry : index) {
+      auto find = m_eventLogAddrHdlTracker.m_addr_hdl_map.find(entry.first);
       if (find == m_eventLogAddrHdlTracker.m_addr_hdl_map.end()) {
         continue;
       }
-      Json::Value j_eventlog;
-      j_eventlog["_eventname"] = log["_eventname"];
-      j_eventlog["params"] = log["params"];
       for (const connection_hdl& hdl : find->second) {
-        lock_guard<mutex> g(m_mutexEventLogDataBuffer);
-        m_eventLogDataBuffer[hdl][addr].append(j_eventlog);
+        const auto nameFilter = m_eventLogNameFilters.find(hdl);
+        for (const auto& event : entry.second) {
+          if (nameFilter != m_eventLogNameFilters.end() &&
+              nameFilter->second.count(event.nameId) == 0) {
+            continue;
+          }
+          m_eventLogDataBuffer[hdl][entry.first].append(event.json);
+        }
       }
-    } catch (...) {
-      continue;
     }
   }
+
+  std::map<std::string, Json::Value> addrToLogs;
+  for (auto& entry : index) {
+    Json::Value logs;
+    for (auto& event : entry.second) {
+      logs.append(std::move(event.json));
+    }
+    addrToLogs.emplace(entry.first.hex(), std::move(logs));
+  }
+  if (!BlockStorage::GetBlockStorage().PutEventLogIndex(epochNum,
+                                                        addrToLogs)) {
+    LOG_GENERAL(WARNING, "BlockStorage::PutEventLogIndex failed");
+  }
 }
 
 void WebsocketServer::closeSocket(
@@ -473,6 +594,7 @@ void WebsocketServer::closeSocket(
     if (find->second.subscribed(EVENTLOG)) {
       lock_guard<mutex> g3(m_mutexEventLogDataBuffer);
       m_eventLogAddrHdlTracker.remove(hdl);
+      m_eventLogNameFilters.erase(hdl);
     }
     m_subscriptions.erase(find);
   }
@@ -483,6 +605,14 @@ void WebsocketServer::SendOutMessages() {
 
   vector<std::pair<connection_hdl, string>> hdlToRemove;
 
+  // Subscribers to NewBlock only all receive byte-identical frames; their
+  // notification is serialized once and shared. Subscribers with
+  // per-connection payloads (event logs, txn logs, unsubscriptions) get
+  // their notification built here and serialized off the locks below
+  vector<connection_hdl> sharedFrameHdls;
+  Json::Value sharedNotification;
+  vector<std::pair<connection_hdl, Json::Value>> perClientNotifications;
+
   {
     lock_guard<mutex> g1(m_mutexSubscriptions);
 
@@ -506,78 +636,92 @@ void WebsocketServer::SendOutMessages() {
     for (auto it = m_subscriptions.begin(); it != m_subscriptions.end();) {
       if (it->second.queries.empty()) {
         hdlToRemove.push_back({it->first, "no subscription"});
-      } else {
-        Json::Value notification;
-        notification["type"] = "Notification";
+        ++it;
+        continue;
+      }
 
-        // SUBSCRIBE
-        for (const auto& query : it->second.queries) {
+      if (it->second.queries.size() == 1 &&
+          it->second.subscribed(NEWBLOCK) &&
+          it->second.unsubscribings.empty()) {
+        if (sharedNotification.empty()) {
+          sharedNotification["type"] = "Notification";
           Json::Value value;
-          value["query"] = GetQueryString(query);
-          bool valid_query = true;
-          switch (query) {
-            case NEWBLOCK: {
-              value["value"] = m_jsonTxnBlockNTxnHashes;
-              break;
-            }
-            case EVENTLOG: {
-              Json::Value j_eventlogs;
-              auto buffer = m_eventLogDataBuffer.find(it->first);
-              if (buffer != m_eventLogDataBuffer.end()) {
-                for (const auto& entry : buffer->second) {
-                  Json::Value j_contract;
-                  j_contract["address"] = entry.first.hex();
-                  j_contract["event_logs"] = entry.second;
-                  j_eventlogs.append(j_contract);
-                }
-                value["value"] = std::move(j_eventlogs);
+          value["query"] = GetQueryString(NEWBLOCK);
+          value["value"] = m_jsonTxnBlockNTxnHashes;
+          sharedNotification["values"].append(value);
+        }
+        sharedFrameHdls.push_back(it->first);
+        ++it;
+        continue;
+      }
+
+      Json::Value notification;
+      notification["type"] = "Notification";
+
+      // SUBSCRIBE
+      for (const auto& query : it->second.queries) {
+        Json::Value value;
+        value["query"] = GetQueryString(query);
+        bool valid_query = true;
+        switch (query) {
+          case NEWBLOCK: {
+            value["value"] = m_jsonTxnBlockNTxnHashes;
+            break;
+          }
+          case EVENTLOG: {
+            Json::Value j_eventlogs;
+            auto buffer = m_eventLogDataBuffer.find(it->first);
+            if (buffer != m_eventLogDataBuffer.end()) {
+              for (const auto& entry : buffer->second) {
+                Json::Value j_contract;
+                j_contract["address"] = entry.first.hex();
+                j_contract["event_logs"] = entry.second;
+                j_eventlogs.append(j_contract);
               }
-              break;
+              value["value"] = std::move(j_eventlogs);
             }
-            case TXNLOG: {
-              Json::Value j_txnlogs;
-              auto buffer = m_txnLogDataBuffer.find(it->first);
-              if (buffer != m_txnLogDataBuffer.end()) {
-                for (const auto& entry : buffer->second) {
-                  Json::Value _json;
-                  _json["address"] = entry.first.hex();
-                  _json["log"] = entry.second;
-                  j_txnlogs.append(_json);
-                }
-                value["value"] = move(j_txnlogs);
+            break;
+          }
+          case TXNLOG: {
+            Json::Value j_txnlogs;
+            auto buffer = m_txnLogDataBuffer.find(it->first);
+            if (buffer != m_txnLogDataBuffer.end()) {
+              for (const auto& entry : buffer->second) {
+                Json::Value _json;
+                _json["address"] = entry.first.hex();
+                _json["log"] = entry.second;
+                j_txnlogs.append(_json);
               }
-              break;
+              value["value"] = move(j_txnlogs);
             }
-            default:
-              valid_query = false;
-              break;
+            break;
           }
-          if (!valid_query) {
-            continue;
-          }
-          notification["values"].append(value);
+          default:
+            valid_query = false;
+            break;
         }
-
-        // UNSUBSCRIBE
-        if (!it->second.unsubscribings.empty()) {
-          Json::Value value;
-          value["query"] = GetQueryString(UNSUBSCRIBE);
-          Json::Value j_unsubscripings;
-          for (const auto& unsubscriping : it->second.unsubscribings) {
-            j_unsubscripings.append(GetQueryString(unsubscriping));
-          }
-          value["value"] = std::move(j_unsubscripings);
-          notification["values"].append(value);
-
-          it->second.unsubscribe_finish();
+        if (!valid_query) {
+          continue;
         }
+        notification["values"].append(value);
+      }
 
-        if (!sendData(it->first, JSONUtils::GetInstance().convertJsontoStr(
-                                     notification))) {
-          hdlToRemove.push_back({it->first, "unable to send data"});
+      // UNSUBSCRIBE
+      if (!it->second.unsubscribings.empty()) {
+        Json::Value value;
+        value["query"] = GetQueryString(UNSUBSCRIBE);
+        Json::Value j_unsubscripings;
+        for (const auto& unsubscriping : it->second.unsubscribings) {
+          j_unsubscripings.append(GetQueryString(unsubscriping));
         }
+        value["value"] = std::move(j_unsubscripings);
+        notification["values"].append(value);
+
+        it->second.unsubscribe_finish();
       }
 
+      perClientNotifications.push_back({it->first, std::move(notification)});
+
       ++it;
     }
 
@@ -585,6 +729,50 @@ void WebsocketServer::SendOutMessages() {
     m_txnLogDataBuffer.clear();
   }
 
+  // Serialize and send outside the subscription locks, sharded across
+  // workers, so neither JSON conversion cost nor one slow consumer can stall
+  // receipt parsing for the next block. websocketpp sends only queue the
+  // frame; the io thread drains the sockets
+  const size_t numClients =
+      sharedFrameHdls.size() + perClientNotifications.size();
+  if (numClients > 0) {
+    const string sharedFrame =
+        sharedFrameHdls.empty()
+            ? ""
+            : JSONUtils::GetInstance().convertJsontoStr(sharedNotification);
+
+    mutex removeMutex;
+    const unsigned int NUMTHREADS = min<unsigned int>(
+        numClients, max(1u, thread::hardware_concurrency()));
+    ThreadPool sendPool(NUMTHREADS, "WsSendPool");
+
+    for (unsigned int shard = 0; shard < NUMTHREADS; shard++) {
+      sendPool.AddJob([this, shard, NUMTHREADS, &sharedFrameHdls, &sharedFrame,
+                       &perClientNotifications, &removeMutex, &hdlToRemove]() {
+        for (size_t i = shard; i < sharedFrameHdls.size(); i += NUMTHREADS) {
+          if (!sendData(sharedFrameHdls[i], sharedFrame)) {
+            lock_guard<mutex> g(removeMutex);
+            hdlToRemove.push_back({sharedFrameHdls[i], "unable to send data"});
+          }
+        }
+        for (size_t i = shard; i < perClientNotifications.size();
+             i += NUMTHREADS) {
+          if (!sendData(perClientNotifications[i].first,
+                        JSONUtils::GetInstance().convertJsontoStr(
+                            perClientNotifications[i].second))) {
+            lock_guard<mutex> g(removeMutex);
+            hdlToRemove.push_back(
+                {perClientNotifications[i].first, "unable to send data"});
+          }
+        }
+      });
+    }
+
+    while (sendPool.GetJobsLeft() > 0) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+
   for (const auto& pair : hdlToRemove) {
     closeSocket(pair.first, pair.second, websocketpp::close::status::normal);
   }
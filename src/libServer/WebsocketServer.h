@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <vector>
 
 #include "websocketpp/config/asio_no_tls.hpp"
 #include "websocketpp/server.hpp"
@@ -101,6 +102,14 @@ struct EventLogAddrHdlTracker {
   }
 };
 
+/// One entry of the per-block event log index: the event JSON plus the
+/// interned id of its "_eventname", so subscriber name filters match on
+/// integers instead of strings
+struct IndexedEventLog {
+  uint32_t nameId{};
+  Json::Value json;
+};
+
 class WebsocketServer : public Singleton<WebsocketServer> {
   /// websocketpp server instance
   static websocketserver m_server;
@@ -115,6 +124,13 @@ class WebsocketServer : public Singleton<WebsocketServer> {
   static std::mutex m_mutexEventLogAddrHdlTracker;
   static EventLogAddrHdlTracker m_eventLogAddrHdlTracker;
 
+  /// optional per-subscriber event-name filters, compiled to interned ids at
+  /// subscribe time (no entry = all events); guarded by
+  /// m_mutexEventLogAddrHdlTracker together with the address tracker
+  static std::map<websocketpp::connection_hdl, std::set<uint32_t>,
+                  std::owner_less<websocketpp::connection_hdl>>
+      m_eventLogNameFilters;
+
   static std::mutex m_mutexTxnLogAddrHdlTracker;
   static EventLogAddrHdlTracker m_txnLogAddrHdlTracker;
 
@@ -132,6 +148,14 @@ class WebsocketServer : public Singleton<WebsocketServer> {
                   std::owner_less<websocketpp::connection_hdl>>
       m_txnLogDataBuffer;
 
+  /// inverted event log index for the block being committed (contract
+  /// address -> event entries), built once per block by ParseTxnEventLog
+  static std::mutex m_mutexEventLogIndex;
+  static std::map<Address, std::vector<IndexedEventLog>> m_eventLogIndex;
+
+  /// returns a stable id for 'eventName', assigning one on first sight
+  static uint32_t InternEventName(const std::string& eventName);
+
   /// make run() detached in a new thread to avoid blocking
   websocketpp::lib::shared_ptr<websocketpp::lib::thread> m_thread;
 
@@ -157,6 +181,11 @@ class WebsocketServer : public Singleton<WebsocketServer> {
 
   void ParseTxnLog(const TransactionWithReceipt& twr);
 
+  /// Distribute the block's event log index to subscriber buffers (one
+  /// index lookup per distinct address) and persist it for historical
+  /// queries; to be called once per final block before SendOutMessages
+  void FinalizeEventLogIndex(uint64_t epochNum);
+
   // /// Public interface to send all digested contract events to subscriber
   void SendOutMessages();
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "AllocTracker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+thread_local AllocTracker::TagStats* AllocTracker::t_currentTag = nullptr;
+thread_local bool AllocTracker::t_bypass = false;
+std::atomic<int> AllocTracker::s_state{0};
+
+AllocTracker::AllocTracker() {
+  m_untagged = Intern("UNTAGGED");
+  s_state.store(1, memory_order_release);
+}
+
+AllocTracker::~AllocTracker() { s_state.store(2, memory_order_release); }
+
+bool AllocTracker::Enabled() {
+#ifdef ENABLE_ALLOC_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+AllocTracker::TagStats* AllocTracker::Intern(const string& tag) {
+  lock_guard<mutex> g(m_tagsMutex);
+  return &m_tags[tag];
+}
+
+AllocTracker::Shard& AllocTracker::ShardFor(const void* p) {
+  // low bits carry no entropy under typical allocator alignment
+  return m_shards[(reinterpret_cast<uintptr_t>(p) >> 4) % NUM_SHARDS];
+}
+
+void AllocTracker::OnAlloc(void* p, const size_t size) {
+  TagStats* stats = (t_currentTag != nullptr) ? t_currentTag : m_untagged;
+  stats->liveBytes.fetch_add(size, memory_order_relaxed);
+  stats->liveAllocs.fetch_add(1, memory_order_relaxed);
+  stats->totalBytes.fetch_add(size, memory_order_relaxed);
+  stats->totalAllocs.fetch_add(1, memory_order_relaxed);
+
+  Shard& shard = ShardFor(p);
+  lock_guard<mutex> g(shard.mutex);
+  shard.entries[p] = {size, stats};
+}
+
+void AllocTracker::OnFree(void* p) {
+  Entry entry;
+  {
+    Shard& shard = ShardFor(p);
+    lock_guard<mutex> g(shard.mutex);
+    auto it = shard.entries.find(p);
+    if (it == shard.entries.end()) {
+      // allocated while bypassed or before the tracker came up
+      return;
+    }
+    entry = it->second;
+    shard.entries.erase(it);
+  }
+
+  entry.stats->liveBytes.fetch_sub(entry.size, memory_order_relaxed);
+  entry.stats->liveAllocs.fetch_sub(1, memory_order_relaxed);
+}
+
+void AllocTracker::TrackAlloc(void* p, const size_t size) {
+  if (t_bypass || s_state.load(memory_order_acquire) == 2) {
+    return;
+  }
+  t_bypass = true;
+  GetInstance().OnAlloc(p, size);
+  t_bypass = false;
+}
+
+void AllocTracker::TrackFree(void* p) {
+  if (t_bypass || s_state.load(memory_order_acquire) != 1) {
+    return;
+  }
+  t_bypass = true;
+  GetInstance().OnFree(p);
+  t_bypass = false;
+}
+
+#ifdef ENABLE_ALLOC_TRACKING
+
+AllocTracker::ScopeTag::ScopeTag(const string& tag) {
+  m_previous = t_currentTag;
+  t_bypass = true;
+  t_currentTag = GetInstance().Intern(tag);
+  t_bypass = false;
+}
+
+AllocTracker::ScopeTag::~ScopeTag() { t_currentTag = m_previous; }
+
+#else
+
+AllocTracker::ScopeTag::ScopeTag([[gnu::unused]] const string& tag) {}
+
+AllocTracker::ScopeTag::~ScopeTag() {}
+
+#endif  // ENABLE_ALLOC_TRACKING
+
+void AllocTracker::GetTopTags(vector<TagReport>& reports, const size_t topN) {
+  reports.clear();
+
+  {
+    lock_guard<mutex> g(m_tagsMutex);
+    reports.reserve(m_tags.size());
+    for (const auto& tag : m_tags) {
+      TagReport report;
+      report.tag = tag.first;
+      report.liveBytes = tag.second.liveBytes.load(memory_order_relaxed);
+      report.liveAllocs = tag.second.liveAllocs.load(memory_order_relaxed);
+      report.totalBytes = tag.second.totalBytes.load(memory_order_relaxed);
+      report.totalAllocs = tag.second.totalAllocs.load(memory_order_relaxed);
+      reports.push_back(move(report));
+    }
+  }
+
+  sort(reports.begin(), reports.end(),
+       [](const TagReport& a, const TagReport& b) {
+         return a.liveBytes > b.liveBytes;
+       });
+  if (reports.size() > topN) {
+    reports.resize(topN);
+  }
+}
+
+#ifdef ENABLE_ALLOC_TRACKING
+
+// Replaced global allocation functions. The nothrow and aligned variants of
+// the default library implementation route through these two, so replacing
+// the plain forms is sufficient.
+
+void* operator new(size_t size) {
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw bad_alloc();
+  }
+  AllocTracker::TrackAlloc(p, size);
+  return p;
+}
+
+void* operator new[](size_t size) { return ::operator new(size); }
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr) {
+    return;
+  }
+  AllocTracker::TrackFree(p);
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept { ::operator delete(p); }
+
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+
+void operator delete[](void* p, size_t) noexcept { ::operator delete(p); }
+
+#endif  // ENABLE_ALLOC_TRACKING
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_ALLOCTRACKER_H_
+#define ZILLIQA_SRC_LIBUTILS_ALLOCTRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// Opt-in allocation tracker for attributing heap growth to a subsystem.
+/// When built with cmake -DALLOC_TRACKING=ON, global operator new/delete are
+/// replaced and every live allocation is tagged with the subsystem the
+/// current thread is working for: message dispatch tags by message name,
+/// the RPC servers tag by procedure name, anything else is UNTAGGED.
+/// StatusServer exports the per-tag live-bytes totals, so a slow leak shows
+/// up as one tag's live bytes climbing instead of a multi-day hunt.
+/// In a normal build the operators are untouched and ScopeTag is a no-op.
+class AllocTracker : public Singleton<AllocTracker> {
+  friend class Singleton<AllocTracker>;
+
+  // Per-tag counters; lives as long as the process so allocation entries
+  // can point at it without refcounting
+  struct TagStats {
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> liveAllocs{0};
+    std::atomic<uint64_t> totalBytes{0};
+    std::atomic<uint64_t> totalAllocs{0};
+  };
+
+ public:
+  struct TagReport {
+    std::string tag;
+    uint64_t liveBytes = 0;
+    uint64_t liveAllocs = 0;
+    uint64_t totalBytes = 0;
+    uint64_t totalAllocs = 0;
+  };
+
+  /// RAII subsystem tag for the current thread; nests, restoring the
+  /// enclosing tag on destruction
+  class ScopeTag {
+   public:
+    explicit ScopeTag(const std::string& tag);
+    ~ScopeTag();
+
+   private:
+    TagStats* m_previous = nullptr;
+  };
+
+  /// Whether this binary was built with allocation tracking
+  static bool Enabled();
+
+  /// Fills reports with the top tags by live bytes, descending
+  void GetTopTags(std::vector<TagReport>& reports, const size_t topN);
+
+  /// Entry points for the replaced global operator new/delete; reentrancy
+  /// from the tracker's own bookkeeping allocations is filtered out
+  static void TrackAlloc(void* p, const size_t size);
+  static void TrackFree(void* p);
+
+ private:
+  AllocTracker();
+  ~AllocTracker();
+
+  static const unsigned int NUM_SHARDS = 64;
+
+  struct Entry {
+    size_t size = 0;
+    TagStats* stats = nullptr;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<void*, Entry> entries;
+  };
+
+  TagStats* Intern(const std::string& tag);
+  Shard& ShardFor(const void* p);
+  void OnAlloc(void* p, const size_t size);
+  void OnFree(void* p);
+
+  std::array<Shard, NUM_SHARDS> m_shards;
+
+  // node-based map keeps TagStats addresses stable across inserts
+  std::mutex m_tagsMutex;
+  std::map<std::string, TagStats> m_tags;
+  TagStats* m_untagged = nullptr;
+
+  static thread_local TagStats* t_currentTag;
+  static thread_local bool t_bypass;
+
+  // 0 = not yet constructed, 1 = alive, 2 = destroyed (static teardown)
+  static std::atomic<int> s_state;
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_ALLOCTRACKER_H_
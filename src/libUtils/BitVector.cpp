@@ -17,8 +17,33 @@
 
 #include "BitVector.h"
 
+#include <algorithm>
+
 using namespace std;
 
+// Expands the packed bytes at data into result (pre-sized and zeroed),
+// one whole byte per iteration instead of one bounds-checked bit
+static void UnpackBits(const uint8_t* data, unsigned int length_in_bits,
+                       unsigned int length_in_bytes,
+                       std::vector<bool>& result) {
+  for (unsigned int byteIndex = 0; byteIndex < length_in_bytes; byteIndex++) {
+    const uint8_t byte = data[byteIndex];
+
+    if (byte == 0) {
+      continue;
+    }
+
+    const unsigned int base = byteIndex << 3;
+    const unsigned int limit = std::min(8u, length_in_bits - base);
+
+    for (unsigned int bit = 0; bit < limit; bit++) {
+      if (byte & (1 << (7 - bit))) {
+        result[base + bit] = true;
+      }
+    }
+  }
+}
+
 unsigned int BitVector::GetBitVectorLengthInBytes(unsigned int length_in_bits) {
   return (((length_in_bits & 0x07) > 0) ? (length_in_bits >> 3) + 1
                                         : length_in_bits >> 3);
@@ -42,11 +67,9 @@ std::vector<bool> BitVector::GetBitVector(const bytes& src, unsigned int offset,
 
   if ((actual_length_bytes == expected_length) &&
       ((src.size() - offset - 2) >= actual_length_bytes)) {
-    result.reserve(actual_length);
-    for (unsigned int index = 0; index < actual_length; index++) {
-      result.push_back(src.at(offset + 2 + (index >> 3)) &
-                       (1 << (7 - (index & 0x07))));
-    }
+    result.resize(actual_length);
+    UnpackBits(src.data() + offset + 2, actual_length, actual_length_bytes,
+               result);
   }
 
   return result;
@@ -64,11 +87,9 @@ std::vector<bool> BitVector::GetBitVector(const bytes& src,
   }
 
   if ((src.size() - offset - 2) >= actual_length_bytes) {
-    result.reserve(actual_length);
-    for (unsigned int index = 0; index < actual_length; index++) {
-      result.push_back(src.at(offset + 2 + (index >> 3)) &
-                       (1 << (7 - (index & 0x07))));
-    }
+    result.resize(actual_length);
+    UnpackBits(src.data() + offset + 2, actual_length, actual_length_bytes,
+               result);
   }
 
   return result;
@@ -81,18 +102,33 @@ unsigned int BitVector::SetBitVector(bytes& dst, unsigned int offset,
   if ((offset + length_needed) > dst.size()) {
     dst.resize(offset + length_needed);
   }
-  fill(dst.begin() + offset, dst.begin() + offset + length_needed, 0x00);
 
-  dst.at(offset) = value.size() >> 8;
-  dst.at(offset + 1) = value.size();
+  dst[offset] = value.size() >> 8;
+  dst[offset + 1] = value.size();
 
+  // accumulate whole bytes instead of read-modify-writing per bit; every
+  // payload byte is written, so no upfront fill is needed
+  uint8_t* data = dst.data() + offset + 2;
   unsigned int index = 0;
+  uint8_t acc = 0;
+
   for (bool b : value) {
-    if (b) {
-      dst.at(offset + 2 + (index >> 3)) |= (1 << (7 - (index & 0x07)));
+    acc |= static_cast<uint8_t>(b) << (7 - (index & 0x07));
+
+    if ((index & 0x07) == 0x07) {
+      data[index >> 3] = acc;
+      acc = 0;
     }
     index++;
   }
 
+  if (index & 0x07) {
+    data[index >> 3] = acc;
+  }
+
   return length_needed;
 }
+
+unsigned int BitVector::CountSetBits(const std::vector<bool>& value) {
+  return std::count(value.begin(), value.end(), true);
+}
@@ -29,6 +29,10 @@ class BitVector {
   static std::vector<bool> GetBitVector(const bytes& src, unsigned int offset);
   static unsigned int SetBitVector(bytes& dst, unsigned int offset,
                                    const std::vector<bool>& value);
+
+  /// Counts the set bits; std::count over the bit-packed vector<bool>
+  /// representation compiles down to word-at-a-time popcount
+  static unsigned int CountSetBits(const std::vector<bool>& value);
 };
 
 #endif  // ZILLIQA_SRC_LIBUTILS_BITVECTOR_H_
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DataCompression.h"
+
+#include <snappy.h>
+
+#include "libUtils/Logger.h"
+
+bool DataCompression::Compress(const bytes& src, bytes& dst) {
+  std::string compressed;
+  snappy::Compress(reinterpret_cast<const char*>(src.data()), src.size(),
+                   &compressed);
+  dst.assign(compressed.begin(), compressed.end());
+  return true;
+}
+
+bool DataCompression::Decompress(const bytes& src, unsigned int offset,
+                                 bytes& dst) {
+  if (offset >= src.size()) {
+    LOG_GENERAL(WARNING, "Invalid data and offset, data size "
+                             << src.size() << ", offset " << offset);
+    return false;
+  }
+
+  const char* data = reinterpret_cast<const char*>(src.data()) + offset;
+  const size_t size = src.size() - offset;
+
+  if (!snappy::IsValidCompressedBuffer(data, size)) {
+    return false;
+  }
+
+  std::string uncompressed;
+  if (!snappy::Uncompress(data, size, &uncompressed)) {
+    return false;
+  }
+
+  dst.assign(uncompressed.begin(), uncompressed.end());
+  return true;
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_DATACOMPRESSION_H_
+#define ZILLIQA_SRC_LIBUTILS_DATACOMPRESSION_H_
+
+#include "common/Serializable.h"
+
+/// Utility class wrapping snappy for compressing serialized payloads.
+class DataCompression {
+ public:
+  /// Compresses src into dst. Returns false on failure.
+  static bool Compress(const bytes& src, bytes& dst);
+
+  /// Decompresses src (from offset to the end) into dst. Returns false if
+  /// the input is not a valid compressed buffer, leaving dst untouched.
+  static bool Decompress(const bytes& src, unsigned int offset, bytes& dst);
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_DATACOMPRESSION_H_
@@ -33,14 +33,28 @@ bool DataConversion::HexStringToUint64(const std::string& s, uint64_t* res) {
 }
 
 bool DataConversion::HexStrToUint8Vec(const string& hex_input, bytes& out) {
-  try {
-    out.clear();
-    boost::algorithm::unhex(hex_input.begin(), hex_input.end(),
-                            back_inserter(out));
-  } catch (exception& e) {
+  return HexStrToUint8Vec(hex_input.data(),
+                          hex_input.data() + hex_input.size(), out);
+}
+
+bool DataConversion::HexStrToUint8Vec(const char* first, const char* last,
+                                      bytes& out) {
+  if ((last - first) % 2 != 0) {
     LOG_GENERAL(WARNING, "Failed HexStrToUint8Vec conversion");
     return false;
   }
+
+  out.clear();
+  out.reserve((last - first) / 2);
+  for (const char* p = first; p != last; p += 2) {
+    const int hi = HexCharValue(p[0]);
+    const int lo = HexCharValue(p[1]);
+    if (hi < 0 || lo < 0) {
+      LOG_GENERAL(WARNING, "Failed HexStrToUint8Vec conversion");
+      return false;
+    }
+    out.push_back(static_cast<uint8_t>((hi << 4) | lo));
+  }
   return true;
 }
 
@@ -69,26 +83,17 @@ bool DataConversion::HexStrToStdArray64(const string& hex_input,
 }
 
 bool DataConversion::Uint8VecToHexStr(const bytes& hex_vec, string& str) {
-  try {
-    str = "";
-    boost::algorithm::hex(hex_vec.begin(), hex_vec.end(), back_inserter(str));
-  } catch (exception& e) {
-    LOG_GENERAL(WARNING, "Failed Uint8VecToHexStr conversion");
-    return false;
-  }
+  HexEncode(hex_vec.data(), hex_vec.size(), str);
   return true;
 }
 
 bool DataConversion::Uint8VecToHexStr(const bytes& hex_vec, unsigned int offset,
                                       unsigned int len, string& str) {
-  try {
-    str = "";
-    boost::algorithm::hex(hex_vec.begin() + offset,
-                          hex_vec.begin() + offset + len, back_inserter(str));
-  } catch (exception& e) {
+  if (offset + len > hex_vec.size()) {
     LOG_GENERAL(WARNING, "Failed Uint8VecToHexStr conversion");
     return false;
   }
+  HexEncode(hex_vec.data() + offset, len, str);
   return true;
 }
 
@@ -96,13 +101,7 @@ bool DataConversion::SerializableToHexStr(const Serializable& input,
                                           string& str) {
   bytes tmp;
   input.Serialize(tmp, 0);
-  try {
-    str = "";
-    boost::algorithm::hex(tmp.begin(), tmp.end(), back_inserter(str));
-  } catch (exception& e) {
-    LOG_GENERAL(WARNING, "Failed SerializableToHexStr conversion");
-    return false;
-  }
+  HexEncode(tmp.data(), tmp.size(), str);
   return true;
 }
 
@@ -110,13 +109,7 @@ bool DataConversion::SerializableToHexStr(const SerializableCrypto& input,
                                           string& str) {
   bytes tmp;
   input.Serialize(tmp, 0);
-  try {
-    str = "";
-    boost::algorithm::hex(tmp.begin(), tmp.end(), back_inserter(str));
-  } catch (exception& e) {
-    LOG_GENERAL(WARNING, "Failed SerializableToHexStr conversion");
-    return false;
-  }
+  HexEncode(tmp.data(), tmp.size(), str);
   return true;
 }
 
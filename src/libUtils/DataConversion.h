@@ -39,6 +39,10 @@ class DataConversion {
   /// Converts alphanumeric hex string to byte vector.
   static bool HexStrToUint8Vec(const std::string& hex_input, bytes& out);
 
+  /// Converts the hex characters in [first, last) to a byte vector without
+  /// copying the input into a temporary string.
+  static bool HexStrToUint8Vec(const char* first, const char* last, bytes& out);
+
   /// Converts alphanumeric hex string to 32-byte array.
   static bool HexStrToStdArray(const std::string& hex_input,
                                std::array<uint8_t, 32>& d);
@@ -47,6 +51,34 @@ class DataConversion {
   static bool HexStrToStdArray64(const std::string& hex_input,
                                  std::array<uint8_t, 64>& d);
 
+  /// Hex-encodes a raw buffer into str with a single preallocation, avoiding
+  /// the per-character back_inserter growth of the boost algorithms; used by
+  /// all the hex string converters below.
+  static inline void HexEncode(const uint8_t* input, size_t len,
+                               std::string& str) {
+    static const char hexDigits[] = "0123456789ABCDEF";
+    str.clear();
+    str.reserve(len * 2);
+    for (size_t i = 0; i < len; i++) {
+      str += hexDigits[input[i] >> 4];
+      str += hexDigits[input[i] & 0x0F];
+    }
+  }
+
+  /// Returns the value of a hex digit, or -1 if the character is not one.
+  static inline int HexCharValue(const char c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    }
+    return -1;
+  }
+
   /// Converts byte vector to alphanumeric hex string.
   static bool Uint8VecToHexStr(const bytes& hex_vec, std::string& str);
 
@@ -58,14 +90,7 @@ class DataConversion {
   template <size_t SIZE>
   static bool charArrToHexStr(const std::array<uint8_t, SIZE>& hex_arr,
                               std::string& str) {
-    try {
-      str = "";
-      boost::algorithm::hex(hex_arr.begin(), hex_arr.end(),
-                            std::back_inserter(str));
-    } catch (std::exception& e) {
-      LOG_GENERAL(WARNING, "Failed charArrToHexStr conversion");
-      return false;
-    }
+    HexEncode(hex_arr.data(), SIZE, str);
     return true;
   }
 
@@ -18,17 +18,26 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_DETACHEDFUNCTION_H_
 #define ZILLIQA_SRC_LIBUTILS_DETACHEDFUNCTION_H_
 
+#include <atomic>
 #include <functional>
 #include <thread>
 #include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
 
-/// Utility class for executing a function in one or more separate detached
-/// threads.
+/// Utility class for executing a fire-and-forget function. Invocations are
+/// served by a shared pool of resident worker threads instead of paying
+/// thread creation and teardown every time; if every pool worker is occupied
+/// (some callers park inside their task for a whole epoch), the task falls
+/// back to a freshly spawned detached thread so it never waits behind a
+/// long-running one.
 class DetachedFunction {
  public:
   /// Retry limit for launching the detached threads.
   const static int MaxAttempt = 3;
 
+  /// Number of resident workers in the shared pool.
+  const static unsigned int PoolSize = 16;
+
   /// Template constructor.
   template <class callable, class... arguments>
   DetachedFunction(int num_threads, callable&& f, arguments&&... args) {
@@ -38,6 +47,13 @@ class DetachedFunction {
     bool attempt_flag = false;
 
     for (int i = 0; i < num_threads; i++) {
+      if (GetPool().TryAddJob([task]() { task(); })) {
+        GetPooledJobCount().fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      GetOverflowThreadCount().fetch_add(1, std::memory_order_relaxed);
+
       for (int j = 0; j < MaxAttempt; j++) {
         try {
           if (!attempt_flag) {
@@ -54,6 +70,27 @@ class DetachedFunction {
       attempt_flag = false;
     }
   }
+
+  /// Running count of invocations served by the shared pool.
+  static std::atomic<uint64_t>& GetPooledJobCount() {
+    static std::atomic<uint64_t> count(0);
+    return count;
+  }
+
+  /// Running count of invocations that fell back to a new detached thread.
+  static std::atomic<uint64_t>& GetOverflowThreadCount() {
+    static std::atomic<uint64_t> count(0);
+    return count;
+  }
+
+ private:
+  /// The pool is deliberately leaked: joining its workers at exit could block
+  /// on tasks that run for a whole epoch, whereas detached threads never held
+  /// up process shutdown.
+  static ThreadPool& GetPool() {
+    static ThreadPool* pool = new ThreadPool(PoolSize, "Detached");
+    return *pool;
+  }
 };
 
 #endif  // ZILLIQA_SRC_LIBUTILS_DETACHEDFUNCTION_H_
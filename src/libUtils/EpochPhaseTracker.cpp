@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "EpochPhaseTracker.h"
+
+#include <algorithm>
+
+using namespace std;
+
+uint64_t EpochPhaseTracker::NowMicros() {
+  return chrono::duration_cast<chrono::microseconds>(
+             chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void EpochPhaseTracker::RecordSpan(const char* phase, const uint64_t epoch,
+                                   const uint64_t startTimestampMicros,
+                                   const uint64_t durationMicros) {
+  const uint64_t index = m_nextIndex.fetch_add(1, memory_order_relaxed);
+  Slot& slot = m_slots[index % SPAN_BUFFER_CAPACITY];
+
+  // Mark the slot in progress (odd), fill it, then publish the generation
+  // (even). A reader that sees either store in between discards the slot.
+  slot.seq.store(index * 2 + 1, memory_order_release);
+  slot.span.epoch = epoch;
+  slot.span.phase = phase;
+  slot.span.startTimestampMicros = startTimestampMicros;
+  slot.span.durationMicros = durationMicros;
+  slot.seq.store(index * 2 + 2, memory_order_release);
+}
+
+void EpochPhaseTracker::GetSpans(vector<Span>& spans) const {
+  spans.clear();
+
+  const uint64_t next = m_nextIndex.load(memory_order_acquire);
+  const uint64_t valid = min<uint64_t>(next, SPAN_BUFFER_CAPACITY);
+  spans.reserve(valid);
+
+  for (uint64_t index = next - valid; index < next; index++) {
+    const Slot& slot = m_slots[index % SPAN_BUFFER_CAPACITY];
+
+    if (slot.seq.load(memory_order_acquire) != index * 2 + 2) {
+      // overwritten by a newer span or still being written
+      continue;
+    }
+
+    Span copy = slot.span;
+
+    if (slot.seq.load(memory_order_acquire) != index * 2 + 2) {
+      continue;
+    }
+
+    spans.push_back(copy);
+  }
+}
+
+EpochPhaseTracker::Scope::Scope(const char* phase, const uint64_t epoch)
+    : m_phase(phase),
+      m_epoch(epoch),
+      m_start(chrono::steady_clock::now()),
+      m_startTimestampMicros(NowMicros()) {}
+
+EpochPhaseTracker::Scope::~Scope() {
+  const uint64_t durationMicros = chrono::duration_cast<chrono::microseconds>(
+                                      chrono::steady_clock::now() - m_start)
+                                      .count();
+  EpochPhaseTracker::GetInstance().RecordSpan(m_phase, m_epoch,
+                                              m_startTimestampMicros,
+                                              durationMicros);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_EPOCHPHASETRACKER_H_
+#define ZILLIQA_SRC_LIBUTILS_EPOCHPHASETRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// Records timed spans of the per-epoch pipeline (txn packet processing,
+/// consensus states, final block processing, persistence commits) into a
+/// fixed-size ring buffer, so epoch-time regressions can be attributed to a
+/// subsystem instead of inferred from scattered LOG_STATE timestamps.
+/// Writers never block: each slot carries its own sequence counter, and a
+/// reader that catches a slot mid-write simply skips it.
+class EpochPhaseTracker : public Singleton<EpochPhaseTracker> {
+  friend class Singleton<EpochPhaseTracker>;
+
+ public:
+  struct Span {
+    uint64_t epoch = 0;
+    const char* phase = "";  // must point to a string literal
+    uint64_t startTimestampMicros = 0;
+    uint64_t durationMicros = 0;
+  };
+
+  /// RAII span covering the enclosing scope as one phase of the given epoch
+  class Scope {
+   public:
+    Scope(const char* phase, const uint64_t epoch);
+    ~Scope();
+
+   private:
+    const char* m_phase;
+    uint64_t m_epoch;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_startTimestampMicros;
+  };
+
+  /// Records an already-measured span; phase must be a string literal
+  void RecordSpan(const char* phase, const uint64_t epoch,
+                  const uint64_t startTimestampMicros,
+                  const uint64_t durationMicros);
+
+  /// Copies the buffered spans, oldest first; spans being overwritten while
+  /// reading are skipped
+  void GetSpans(std::vector<Span>& spans) const;
+
+  /// Returns the current wall clock in microseconds since the Unix epoch
+  static uint64_t NowMicros();
+
+ private:
+  EpochPhaseTracker() = default;
+  ~EpochPhaseTracker() = default;
+
+  static const unsigned int SPAN_BUFFER_CAPACITY = 8192;
+
+  // The slot's sequence is odd while the span is being written and encodes
+  // the writer's generation when stable, so readers detect torn or
+  // overwritten slots without any lock
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    Span span;
+  };
+
+  std::array<Slot, SPAN_BUFFER_CAPACITY> m_slots;
+  std::atomic<uint64_t> m_nextIndex{0};
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_EPOCHPHASETRACKER_H_
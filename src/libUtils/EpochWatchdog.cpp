@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "EpochWatchdog.h"
+
+#include <algorithm>
+
+#include "common/Constants.h"
+#include "libUtils/EpochPhaseTracker.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+void EpochWatchdog::RegisterGauge(const string& name,
+                                  function<uint64_t()> fn) {
+  lock_guard<mutex> g(m_mutex);
+  m_gauges.emplace_back(name, move(fn));
+}
+
+void EpochWatchdog::RegisterDetail(const string& name,
+                                   function<string()> fn) {
+  lock_guard<mutex> g(m_mutex);
+  m_details.emplace_back(name, move(fn));
+}
+
+void EpochWatchdog::EpochCompleted(uint64_t epoch) {
+  if (EPOCH_TIME_SLO_MS == 0) {
+    return;
+  }
+
+  const uint64_t sloMicros = uint64_t(EPOCH_TIME_SLO_MS) * 1000;
+  const uint64_t nowMicros = EpochPhaseTracker::NowMicros();
+
+  // total up this epoch's spans per phase
+  vector<EpochPhaseTracker::Span> spans;
+  EpochPhaseTracker::GetInstance().GetSpans(spans);
+  map<string, uint64_t> phaseMicros;
+  for (const auto& span : spans) {
+    if (span.epoch == epoch) {
+      phaseMicros[span.phase] += span.durationMicros;
+    }
+  }
+
+  uint64_t epochTimeMicros = 0;
+  bool breached = false;
+  vector<pair<string, function<uint64_t()>>> gauges;
+  vector<pair<string, function<string()>>> details;
+  Report report;
+
+  {
+    lock_guard<mutex> g(m_mutex);
+
+    if (m_lastEpochEndMicros != 0 && nowMicros > m_lastEpochEndMicros) {
+      epochTimeMicros = nowMicros - m_lastEpochEndMicros;
+    }
+    m_lastEpochEndMicros = nowMicros;
+
+    breached = epochTimeMicros > sloMicros;
+
+    if (breached) {
+      report.epoch = epoch;
+      report.timestampMicros = nowMicros;
+      report.epochTimeMicros = epochTimeMicros;
+      report.sloMicros = sloMicros;
+
+      // blame the phase that grew the most over its baseline
+      int64_t worstRegression = -1;
+      for (const auto& entry : phaseMicros) {
+        PhaseBlame blame;
+        blame.phase = entry.first;
+        blame.durationMicros = entry.second;
+        const auto baseline = m_phaseBaselineMicros.find(entry.first);
+        blame.baselineMicros =
+            baseline != m_phaseBaselineMicros.end() ? baseline->second : 0;
+        const int64_t regression =
+            int64_t(blame.durationMicros) - int64_t(blame.baselineMicros);
+        if (regression > worstRegression) {
+          worstRegression = regression;
+          report.worstPhase = blame.phase;
+        }
+        report.phases.emplace_back(move(blame));
+      }
+
+      gauges = m_gauges;
+      details = m_details;
+    } else {
+      // only healthy epochs advance the baselines, so a sustained
+      // regression keeps being compared against good history
+      for (const auto& entry : phaseMicros) {
+        auto result = m_phaseBaselineMicros.emplace(entry.first, entry.second);
+        if (!result.second) {
+          uint64_t& baseline = result.first->second;
+          baseline += (int64_t(entry.second) - int64_t(baseline)) >>
+                      BASELINE_EWMA_SHIFT;
+        }
+      }
+    }
+  }
+
+  if (!breached) {
+    return;
+  }
+
+  // sample the gauges and details outside the lock; they call into other
+  // subsystems (message queues, LevelDB)
+  for (const auto& gauge : gauges) {
+    report.gauges.push_back({gauge.first, gauge.second()});
+  }
+  for (const auto& detail : details) {
+    report.details.emplace_back(detail.first, detail.second());
+  }
+
+  LOG_GENERAL(WARNING, "Epoch " << epoch << " took "
+                                << epochTimeMicros / 1000 << " ms against an "
+                                << EPOCH_TIME_SLO_MS
+                                << " ms SLO; worst regressed phase: "
+                                << (report.worstPhase.empty()
+                                        ? "<no spans recorded>"
+                                        : report.worstPhase));
+
+  lock_guard<mutex> g(m_mutex);
+  m_reports.emplace_front(move(report));
+  if (m_reports.size() > MAX_REPORTS) {
+    m_reports.pop_back();
+  }
+}
+
+void EpochWatchdog::GetReports(vector<Report>& reports) const {
+  lock_guard<mutex> g(m_mutex);
+  reports.assign(m_reports.begin(), m_reports.end());
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_EPOCHWATCHDOG_H_
+#define ZILLIQA_SRC_LIBUTILS_EPOCHWATCHDOG_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// SLO watchdog built on EpochPhaseTracker: every completed epoch it folds
+/// the phase durations into a rolling per-phase baseline, and when the
+/// wall time between consecutive final blocks exceeds EPOCH_TIME_SLO_MS it
+/// captures a structured blame report — each phase against its baseline,
+/// the registered runtime gauges (message queue depths) and detail texts
+/// (LevelDB engine stats) — retained for StatusServer so an incident ships
+/// with its own diagnosis instead of a cross-node log dig. Baselines are
+/// only advanced by epochs inside the SLO, so a sustained regression keeps
+/// being measured against healthy history. Disabled when the SLO is 0.
+class EpochWatchdog : public Singleton<EpochWatchdog> {
+  friend class Singleton<EpochWatchdog>;
+
+ public:
+  struct PhaseBlame {
+    std::string phase;
+    uint64_t durationMicros = 0;
+    uint64_t baselineMicros = 0;
+  };
+
+  struct GaugeSample {
+    std::string name;
+    uint64_t value = 0;
+  };
+
+  struct Report {
+    uint64_t epoch = 0;
+    uint64_t timestampMicros = 0;
+    uint64_t epochTimeMicros = 0;
+    uint64_t sloMicros = 0;
+    std::string worstPhase;
+    std::vector<PhaseBlame> phases;
+    std::vector<GaugeSample> gauges;
+    std::vector<std::pair<std::string, std::string>> details;
+  };
+
+  /// Registers a numeric gauge sampled into every report (e.g. a message
+  /// queue depth); call once at node startup
+  void RegisterGauge(const std::string& name, std::function<uint64_t()> fn);
+
+  /// Registers a free-form text detail sampled into every report (e.g.
+  /// LevelDB engine stats with the stall counters)
+  void RegisterDetail(const std::string& name, std::function<std::string()> fn);
+
+  /// Called once per epoch after the final block has been processed
+  void EpochCompleted(uint64_t epoch);
+
+  /// Copies the retained reports, newest first
+  void GetReports(std::vector<Report>& reports) const;
+
+ private:
+  EpochWatchdog() = default;
+  ~EpochWatchdog() = default;
+
+  static const unsigned int MAX_REPORTS = 8;
+  // EWMA weight: baseline moves by 1/8 of the deviation per healthy epoch
+  static const unsigned int BASELINE_EWMA_SHIFT = 3;
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, uint64_t> m_phaseBaselineMicros;
+  std::vector<std::pair<std::string, std::function<uint64_t()>>> m_gauges;
+  std::vector<std::pair<std::string, std::function<std::string()>>> m_details;
+  std::deque<Report> m_reports;
+  uint64_t m_lastEpochEndMicros = 0;
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_EPOCHWATCHDOG_H_
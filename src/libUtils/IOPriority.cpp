@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "IOPriority.h"
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace {
+
+// from linux/ioprio.h, which is not exported to userspace headers
+const int IOPRIO_CLASS_BE = 2;
+const int IOPRIO_BE_LOWEST = 7;
+const int IOPRIO_CLASS_SHIFT = 13;
+const int IOPRIO_WHO_PROCESS = 1;
+
+}  // namespace
+#endif
+
+void IOPriority::LowerCurrentThread([[gnu::unused]] const char* threadName) {
+  if (!BACKGROUND_COMMIT_IO_LOW_PRIO) {
+    return;
+  }
+
+#ifdef __linux__
+  // who = 0 addresses the calling thread
+  if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+              (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | IOPRIO_BE_LOWEST) !=
+      0) {
+    LOG_GENERAL(WARNING,
+                "Failed to lower I/O priority for " << threadName << ", errno "
+                                                    << errno);
+  }
+#endif
+}
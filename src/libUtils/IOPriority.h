@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_IOPRIORITY_H_
+#define ZILLIQA_SRC_LIBUTILS_IOPRIORITY_H_
+
+/// Demotes the background state-commit threads below the API read path in
+/// the kernel I/O scheduler, so the epoch-boundary write burst
+/// (MoveUpdatesToDisk, CommitStateDB, block metadata) queues behind
+/// GetTxBody-style reads instead of in front of them. Linux-only and
+/// best-effort: it takes effect under the BFQ/CFQ schedulers and is a
+/// silent no-op elsewhere.
+class IOPriority {
+ public:
+  /// Drops the calling thread to the lowest best-effort I/O priority.
+  /// Meant for threads created per commit, so nothing needs restoring.
+  /// Disabled (no-op) when BACKGROUND_COMMIT_IO_LOW_PRIO is off.
+  static void LowerCurrentThread(const char* threadName);
+
+  IOPriority() = delete;
+  ~IOPriority() = delete;
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_IOPRIORITY_H_
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LockProfiler.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+const array<uint64_t, LockProfiler::NUM_WAIT_BUCKETS - 1>
+    WAIT_BUCKET_UPPER_BOUNDS_MICROS = {10,     100,     1000,    10000,
+                                       100000, 1000000, 10000000};
+
+}  // namespace
+
+void LockProfiler::Stats::RecordWait(uint64_t waitMicros) {
+  acquisitions.fetch_add(1, memory_order_relaxed);
+  contended.fetch_add(1, memory_order_relaxed);
+  totalWaitMicros.fetch_add(waitMicros, memory_order_relaxed);
+
+  uint64_t prevMax = maxWaitMicros.load(memory_order_relaxed);
+  while (prevMax < waitMicros &&
+         !maxWaitMicros.compare_exchange_weak(prevMax, waitMicros,
+                                              memory_order_relaxed)) {
+  }
+
+  unsigned int bucket = 0;
+  while (bucket < NUM_WAIT_BUCKETS - 1 &&
+         waitMicros > WAIT_BUCKET_UPPER_BOUNDS_MICROS[bucket]) {
+    bucket++;
+  }
+  waitBuckets[bucket].fetch_add(1, memory_order_relaxed);
+}
+
+LockProfiler::Stats& LockProfiler::Register(const string& name) {
+  lock_guard<mutex> g(m_mutex);
+  return m_locks[name];
+}
+
+void LockProfiler::GetReports(vector<LockReport>& reports) const {
+  reports.clear();
+
+  {
+    lock_guard<mutex> g(m_mutex);
+    reports.reserve(m_locks.size());
+    for (const auto& entry : m_locks) {
+      LockReport report;
+      report.name = entry.first;
+      report.acquisitions = entry.second.acquisitions.load();
+      report.contended = entry.second.contended.load();
+      report.totalWaitMicros = entry.second.totalWaitMicros.load();
+      report.maxWaitMicros = entry.second.maxWaitMicros.load();
+      for (unsigned int i = 0; i < NUM_WAIT_BUCKETS; i++) {
+        report.waitBuckets[i] = entry.second.waitBuckets[i].load();
+      }
+      reports.emplace_back(move(report));
+    }
+  }
+
+  sort(reports.begin(), reports.end(),
+       [](const LockReport& a, const LockReport& b) {
+         return a.totalWaitMicros > b.totalWaitMicros;
+       });
+}
+
+const array<uint64_t, LockProfiler::NUM_WAIT_BUCKETS - 1>&
+LockProfiler::WaitBucketUpperBoundsMicros() {
+  return WAIT_BUCKET_UPPER_BOUNDS_MICROS;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_LOCKPROFILER_H_
+#define ZILLIQA_SRC_LIBUTILS_LOCKPROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// Registry of wait-time statistics for the named mutexes wrapped in
+/// ProfiledMutex/ProfiledSharedTimedMutex below. Contention on the hot
+/// locks is invisible until it causes timeouts; the wrapped locks try the
+/// uncontended fast path first (one relaxed counter increment) and only
+/// read the clock when they actually have to block, recording the wait
+/// into a per-lock log-scale histogram. Mutexes registered under the same
+/// name (e.g. the account cache shards) share one entry.
+class LockProfiler : public Singleton<LockProfiler> {
+  friend class Singleton<LockProfiler>;
+
+ public:
+  static const unsigned int NUM_WAIT_BUCKETS = 8;
+
+  /// Per-lock counters; updated lock-free by the wrappers
+  struct Stats {
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> totalWaitMicros{0};
+    std::atomic<uint64_t> maxWaitMicros{0};
+    std::array<std::atomic<uint64_t>, NUM_WAIT_BUCKETS> waitBuckets{};
+
+    void RecordUncontended() {
+      acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordWait(uint64_t waitMicros);
+  };
+
+  struct LockReport {
+    std::string name;
+    uint64_t acquisitions = 0;
+    uint64_t contended = 0;
+    uint64_t totalWaitMicros = 0;
+    uint64_t maxWaitMicros = 0;
+    std::array<uint64_t, NUM_WAIT_BUCKETS> waitBuckets{};
+  };
+
+  /// Returns the stats entry for a lock name, creating it on first use;
+  /// the reference stays valid for the process lifetime
+  Stats& Register(const std::string& name);
+
+  /// Copies the per-lock statistics, largest total wait first
+  void GetReports(std::vector<LockReport>& reports) const;
+
+  /// Upper bounds of the wait histogram buckets in microseconds; the last
+  /// bucket is unbounded
+  static const std::array<uint64_t, NUM_WAIT_BUCKETS - 1>&
+  WaitBucketUpperBoundsMicros();
+
+ private:
+  LockProfiler() = default;
+  ~LockProfiler() = default;
+
+  // std::map keeps the Stats addresses stable as locks register
+  mutable std::mutex m_mutex;
+  std::map<std::string, Stats> m_locks;
+};
+
+/// Drop-in replacement for std::mutex (and std::shared_timed_mutex via
+/// ProfiledSharedTimedMutex) that reports wait times under a fixed name.
+/// Satisfies Lockable, so std::lock_guard, std::unique_lock and std::lock
+/// work unchanged; locks paired with a std::condition_variable cannot be
+/// wrapped since the wait requires a plain std::mutex.
+template <class MutexT>
+class ProfiledMutexBase {
+ public:
+  explicit ProfiledMutexBase(const char* name)
+      : m_stats(LockProfiler::GetInstance().Register(name)) {}
+
+  ProfiledMutexBase(ProfiledMutexBase const&) = delete;
+  void operator=(ProfiledMutexBase const&) = delete;
+
+  void lock() {
+    if (m_mutex.try_lock()) {
+      m_stats.RecordUncontended();
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    m_mutex.lock();
+    m_stats.RecordWait(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
+  }
+
+  bool try_lock() {
+    if (m_mutex.try_lock()) {
+      m_stats.RecordUncontended();
+      return true;
+    }
+    return false;
+  }
+
+  void unlock() { m_mutex.unlock(); }
+
+ protected:
+  MutexT m_mutex;
+  LockProfiler::Stats& m_stats;
+};
+
+using ProfiledMutex = ProfiledMutexBase<std::mutex>;
+
+/// Shared (reader/writer) variant; shared waits land in the same histogram
+/// as exclusive waits since either kind stalls the caller
+class ProfiledSharedTimedMutex
+    : public ProfiledMutexBase<std::shared_timed_mutex> {
+ public:
+  using ProfiledMutexBase<std::shared_timed_mutex>::ProfiledMutexBase;
+
+  void lock_shared() {
+    if (m_mutex.try_lock_shared()) {
+      m_stats.RecordUncontended();
+      return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    m_mutex.lock_shared();
+    m_stats.RecordWait(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
+  }
+
+  bool try_lock_shared() {
+    if (m_mutex.try_lock_shared()) {
+      m_stats.RecordUncontended();
+      return true;
+    }
+    return false;
+  }
+
+  void unlock_shared() { m_mutex.unlock_shared(); }
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_LOCKPROFILER_H_
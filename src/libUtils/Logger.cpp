@@ -20,6 +20,7 @@
 #include <pthread.h>
 #include <sys/syscall.h>
 #include <unistd.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <cstring>
 #include <iostream>
@@ -49,6 +50,14 @@ inline pid_t getCurrentPid() {
 const streampos Logger::MAX_FILE_SIZE =
     1024 * 1024 * 100;  // 100MB per log file
 
+// Bound on the number of captured-but-unformatted log calls; beyond this the
+// callers drop the message instead of blocking behind a slow disk
+const size_t LOG_QUEUE_MAX_ENTRIES = 32768;
+
+// Everything at DEBUG and above is displayed by default;
+// Mediator::SetupLogLevel raises this according to DEBUG_LEVEL
+std::atomic<int> Logger::s_minLevelValue{DEBUG.value};
+
 Logger::Logger(const char* prefix, bool log_to_file, const char* logpath,
                streampos max_file_size) {
   this->m_logToFile = log_to_file;
@@ -80,9 +89,23 @@ Logger::Logger(const char* prefix, bool log_to_file, const char* logpath,
     m_seqNum = 0;
     newLog();
   }
+
+  m_sinkThread = std::thread(&Logger::SinkLoop, this);
 }
 
-Logger::~Logger() { m_logFile.close(); }
+Logger::~Logger() {
+  {
+    lock_guard<mutex> guard(m);
+    m_stopSink = true;
+  }
+  m_sinkCond.notify_one();
+
+  if (m_sinkThread.joinable()) {
+    m_sinkThread.join();
+  }
+
+  m_logFile.close();
+}
 
 void Logger::checkLog() {
   std::ifstream in(m_fileName.c_str(),
@@ -118,6 +141,80 @@ void Logger::newLog() {
   }
 }
 
+void Logger::EnqueueEntry(LogEntry&& entry) {
+  {
+    lock_guard<mutex> guard(m);
+
+    if (m_sinkQueue.size() >= LOG_QUEUE_MAX_ENTRIES) {
+      m_droppedEntries++;
+      return;
+    }
+
+    m_sinkQueue.emplace_back(move(entry));
+  }
+  m_sinkCond.notify_one();
+}
+
+void Logger::SinkLoop() {
+  unique_lock<mutex> guard(m);
+
+  while (true) {
+    m_sinkCond.wait(guard,
+                    [this] { return m_stopSink || !m_sinkQueue.empty(); });
+
+    if (m_sinkQueue.empty() && m_stopSink) {
+      break;
+    }
+
+    deque<LogEntry> batch;
+    batch.swap(m_sinkQueue);
+    const uint64_t dropped = m_droppedEntries;
+    m_droppedEntries = 0;
+    guard.unlock();
+
+    for (const auto& entry : batch) {
+      if (m_logToFile) {
+        checkLog();
+        WriteEntry(entry, m_logFile);
+      } else {
+        WriteEntry(entry, cout);
+      }
+    }
+
+    if (dropped > 0) {
+      ostream& os = m_logToFile ? static_cast<ostream&>(m_logFile) : cout;
+      os << "[Logger] Queue overflowed, dropped " << dropped << " messages"
+         << endl
+         << flush;
+    }
+
+    guard.lock();
+  }
+}
+
+void Logger::WriteEntry(const LogEntry& entry, ostream& os) {
+  auto cur_time_t = chrono::system_clock::to_time_t(entry.when);
+  auto file_and_line =
+      std::string(entry.filename + ":" + std::to_string(entry.linenum));
+  os << "[" << PAD(entry.tid, TID_LEN, ' ') << "]["
+     << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
+     << PAD(get_ms(entry.when), 3, '0') << "]["
+     << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
+     << LIMIT(entry.function, MAX_FUNCNAME_LEN) << "] " << entry.msg;
+
+  if (entry.hasPayload) {
+    std::unique_ptr<char[]> payload_string;
+    GetPayloadS(entry.payload, entry.maxBytesToDisplay, payload_string);
+    os << " (Len=" << entry.payloadSize << "): " << payload_string.get();
+
+    if (entry.payloadSize > entry.maxBytesToDisplay) {
+      os << "...";
+    }
+  }
+
+  os << endl << flush;
+}
+
 Logger& Logger::GetLogger(const char* fname_prefix, bool log_to_file,
                           const char* logpath, streampos max_file_size) {
   static Logger logger(fname_prefix, log_to_file, logpath, max_file_size);
@@ -151,6 +248,10 @@ void Logger::LogState(const char* msg) {
 void Logger::LogGeneral(const LEVELS& level, const char* msg,
                         const unsigned int linenum, const char* filename,
                         const char* function) {
+  if (!IsLevelEnabled(level)) {
+    return;
+  }
+
   if (IsG3Log()) {
     auto cur = chrono::system_clock::now();
     auto cur_time_t = chrono::system_clock::to_time_t(cur);
@@ -164,166 +265,77 @@ void Logger::LogGeneral(const LEVELS& level, const char* msg,
     return;
   }
 
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl
-         << flush;
-  }
+  LogEntry entry;
+  entry.when = chrono::system_clock::now();
+  entry.tid = GetPid();
+  entry.linenum = linenum;
+  entry.filename = filename;
+  entry.function = function;
+  entry.msg = msg;
+  EnqueueEntry(move(entry));
 }
 
-void Logger::LogEpoch([[gnu::unused]] const LEVELS& level, const char* msg,
-                      const char* epoch, const unsigned int linenum,
-                      const char* filename, const char* function) {
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch
-              << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch << "] "
-         << msg << endl
-         << flush;
+void Logger::LogEpoch(const LEVELS& level, const char* msg, const char* epoch,
+                      const unsigned int linenum, const char* filename,
+                      const char* function) {
+  if (!IsLevelEnabled(level)) {
+    return;
   }
+
+  LogEntry entry;
+  entry.when = chrono::system_clock::now();
+  entry.tid = GetPid();
+  entry.linenum = linenum;
+  entry.filename = filename;
+  entry.function = function;
+  entry.msg = string("[Epoch ") + epoch + "] " + msg;
+  EnqueueEntry(move(entry));
 }
 
-void Logger::LogPayload([[gnu::unused]] const LEVELS& level, const char* msg,
+void Logger::LogPayload(const LEVELS& level, const char* msg,
                         const bytes& payload, size_t max_bytes_to_display,
                         const unsigned int linenum, const char* filename,
                         const char* function) {
-  std::unique_ptr<char[]> payload_string;
-  GetPayloadS(payload, max_bytes_to_display, payload_string);
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-
-    if (payload.size() > max_bytes_to_display) {
-      m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-                << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-                << PAD(get_ms(cur), 3, '0') << "]["
-                << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-                << " (Len=" << payload.size() << "): " << payload_string.get()
-                << "..." << endl
-                << flush;
-    } else {
-      m_logFile << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-                << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-                << PAD(get_ms(cur), 3, '0') << "]["
-                << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-                << " (Len=" << payload.size() << "): " << payload_string.get()
-                << endl
-                << flush;
-    }
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-
-    if (payload.size() > max_bytes_to_display) {
-      cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-           << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-           << PAD(get_ms(cur), 3, '0') << "]["
-           << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-           << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-           << " (Len=" << payload.size() << "): " << payload_string.get()
-           << "..." << endl
-           << flush;
-    } else {
-      cout << "[" << PAD(GetPid(), TID_LEN, ' ') << "]["
-           << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-           << PAD(get_ms(cur), 3, '0') << "]["
-           << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-           << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg
-           << " (Len=" << payload.size() << "): " << payload_string.get()
-           << endl
-           << flush;
-    }
+  if (!IsLevelEnabled(level)) {
+    return;
   }
+
+  LogEntry entry;
+  entry.when = chrono::system_clock::now();
+  entry.tid = GetPid();
+  entry.linenum = linenum;
+  entry.filename = filename;
+  entry.function = function;
+  entry.msg = msg;
+  // only the displayed portion is copied; hex conversion happens on the sink
+  // thread
+  entry.payload.assign(
+      payload.begin(),
+      payload.begin() + min(payload.size(), max_bytes_to_display));
+  entry.payloadSize = payload.size();
+  entry.maxBytesToDisplay = max_bytes_to_display;
+  entry.hasPayload = true;
+  EnqueueEntry(move(entry));
 }
 
 void Logger::LogEpochInfo(const char* msg, const unsigned int linenum,
                           const char* filename, const char* function,
                           const char* epoch) {
-  pid_t tid = getCurrentPid();
-  lock_guard<mutex> guard(m);
-
-  if (m_logToFile) {
-    checkLog();
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    m_logFile << "[" << PAD(tid, TID_LEN, ' ') << "]["
-              << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-              << PAD(get_ms(cur), 3, '0') << "]["
-              << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-              << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch
-              << "] " << msg << endl
-              << flush;
-  } else {
-    auto cur = chrono::system_clock::now();
-    auto cur_time_t = chrono::system_clock::to_time_t(cur);
-    auto file_and_line =
-        std::string(std::string(filename) + ":" + std::to_string(linenum));
-    cout << "[" << PAD(tid, TID_LEN, ' ') << "]["
-         << put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")
-         << PAD(get_ms(cur), 3, '0') << "]["
-         << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) << "]["
-         << LIMIT(function, MAX_FUNCNAME_LEN) << "] [Epoch " << epoch << "] "
-         << msg << endl
-         << flush;
-  }
+  LogEntry entry;
+  entry.when = chrono::system_clock::now();
+  entry.tid = getCurrentPid();
+  entry.linenum = linenum;
+  entry.filename = filename;
+  entry.function = function;
+  entry.msg = string("[Epoch ") + epoch + "] " + msg;
+  EnqueueEntry(move(entry));
 }
 
 void Logger::DisplayLevelAbove(const LEVELS& level) {
-  if (level != INFO && level != WARNING && level != FATAL) return;
+  if (level != DEBUG && level != INFO && level != WARNING && level != FATAL)
+    return;
 
+  s_minLevelValue.store(level.value, std::memory_order_relaxed);
   g3::log_levels::setHighest(level);
 }
 
@@ -18,13 +18,17 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_LOGGER_H_
 #define ZILLIQA_SRC_LIBUTILS_LOGGER_H_
 
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include "common/BaseType.h"
 #include "g3log/g3log.hpp"
@@ -45,6 +49,21 @@
 /// Utility logging class for outputting messages to stdout or file.
 class Logger {
  private:
+  /// A log call captured on the hot path; formatting happens on the sink
+  /// thread.
+  struct LogEntry {
+    std::chrono::system_clock::time_point when;
+    pid_t tid{};
+    unsigned int linenum{};
+    std::string filename;
+    std::string function;
+    std::string msg;
+    bytes payload;
+    size_t payloadSize{};
+    size_t maxBytesToDisplay{};
+    bool hasPayload{};
+  };
+
   std::mutex m;
   bool m_logToFile;
   std::streampos m_maxFileSize;
@@ -57,6 +76,10 @@ class Logger {
   void checkLog();
   void newLog();
 
+  void EnqueueEntry(LogEntry&& entry);
+  void SinkLoop();
+  void WriteEntry(const LogEntry& entry, std::ostream& os);
+
   std::string m_fileNamePrefix;
   std::string m_fileName;
   std::ofstream m_logFile;
@@ -64,6 +87,14 @@ class Logger {
   bool m_bRefactor{};
   std::string m_logPath;
 
+  std::thread m_sinkThread;
+  std::condition_variable m_sinkCond;
+  std::deque<LogEntry> m_sinkQueue;  // guarded by m
+  uint64_t m_droppedEntries{};       // guarded by m
+  bool m_stopSink{};                 // guarded by m
+
+  static std::atomic<int> s_minLevelValue;
+
  public:
   /// Limits the number of bytes of a payload to display.
   static const size_t MAX_BYTES_TO_DISPLAY = 30;
@@ -129,11 +160,19 @@ class Logger {
                   const char* filename, const char* function);
 
   /// Setup the display debug level
-  ///     INFO: display all message
+  ///     DEBUG: display all message
+  ///     INFO: display info, warning and fatal message
   ///     WARNING: display warning and fatal message
   ///     FATAL: display fatal message only
   void DisplayLevelAbove(const LEVELS& level = INFO);
 
+  /// Returns true if messages at the specified level are currently displayed.
+  /// Cheap enough to guard hot call sites: one relaxed atomic load and a
+  /// compare, so filtered-out messages skip all formatting work.
+  static bool IsLevelEnabled(const LEVELS& level) {
+    return level.value >= s_minLevelValue.load(std::memory_order_relaxed);
+  }
+
   /// Enable the log level
   void EnableLevel(const LEVELS& level);
 
@@ -187,93 +226,107 @@ class ScopeMarker {
                            boost::filesystem::absolute("./").string().c_str()) \
         .LogState(oss.str().c_str());                                          \
   }
-#define LOG_GENERAL(level, msg)                                                \
-  {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ') << "][" \
-                 << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")         \
-                 << PAD(get_ms(cur), 3, '0') << "]["                           \
-                 << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)    \
-                 << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)      \
-                 << "] " << msg;                                               \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogGeneral(level, oss.str().c_str(), __LINE__, __FILE__,            \
-                      __FUNCTION__);                                           \
-    }                                                                          \
+#define LOG_GENERAL(level, msg)                                               \
+  {                                                                           \
+    if (Logger::IsLevelEnabled(level)) {                                      \
+      if (Logger::GetLogger(NULL, true,                                       \
+                            boost::filesystem::absolute("./").string()        \
+                                .c_str())                                     \
+              .IsG3Log()) {                                                   \
+        auto cur = std::chrono::system_clock::now();                          \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);          \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +        \
+                                         std::to_string(__LINE__));           \
+        LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')      \
+                   << "]["                                                    \
+                   << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")      \
+                   << PAD(get_ms(cur), 3, '0') << "]["                        \
+                   << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) \
+                   << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)   \
+                   << "] " << msg;                                            \
+      } else {                                                                \
+        std::ostringstream oss;                                               \
+        oss << msg;                                                           \
+        Logger::GetLogger(NULL, true,                                         \
+                          boost::filesystem::absolute("./").string().c_str()) \
+            .LogGeneral(level, oss.str().c_str(), __LINE__, __FILE__,         \
+                        __FUNCTION__);                                        \
+      }                                                                       \
+    }                                                                         \
   }
-#define LOG_EPOCH(level, epoch, msg)                                           \
-  {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ') << "][" \
-                 << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")         \
-                 << PAD(get_ms(cur), 3, '0') << "]["                           \
-                 << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)    \
-                 << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)      \
-                 << "] [Epoch " << std::to_string(epoch).c_str() << "] "       \
-                 << msg;                                                       \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogEpoch(level, std::to_string(epoch).c_str(), oss.str().c_str(),   \
-                    __LINE__, __FILE__, __FUNCTION__);                         \
-    }                                                                          \
+#define LOG_EPOCH(level, epoch, msg)                                          \
+  {                                                                           \
+    if (Logger::IsLevelEnabled(level)) {                                      \
+      if (Logger::GetLogger(NULL, true,                                       \
+                            boost::filesystem::absolute("./").string()        \
+                                .c_str())                                     \
+              .IsG3Log()) {                                                   \
+        auto cur = std::chrono::system_clock::now();                          \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);          \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +        \
+                                         std::to_string(__LINE__));           \
+        LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')      \
+                   << "]["                                                    \
+                   << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")      \
+                   << PAD(get_ms(cur), 3, '0') << "]["                        \
+                   << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN) \
+                   << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)   \
+                   << "] [Epoch " << std::to_string(epoch).c_str() << "] "    \
+                   << msg;                                                    \
+      } else {                                                                \
+        std::ostringstream oss;                                               \
+        oss << msg;                                                           \
+        Logger::GetLogger(NULL, true,                                         \
+                          boost::filesystem::absolute("./").string().c_str()) \
+            .LogEpoch(level, std::to_string(epoch).c_str(), oss.str().c_str(), \
+                      __LINE__, __FILE__, __FUNCTION__);                      \
+      }                                                                       \
+    }                                                                         \
   }
-#define LOG_PAYLOAD(level, msg, payload, max_bytes_to_display)                 \
-  {                                                                            \
-    if (Logger::GetLogger(NULL, true,                                          \
-                          boost::filesystem::absolute("./").string().c_str())  \
-            .IsG3Log()) {                                                      \
-      std::unique_ptr<char[]> payload_string;                                  \
-      Logger::GetPayloadS(payload, max_bytes_to_display, payload_string);      \
-      auto cur = std::chrono::system_clock::now();                             \
-      auto cur_time_t = std::chrono::system_clock::to_time_t(cur);             \
-      auto file_and_line =                                                     \
-          std::string(std::string(__FILE__) + ":" + std::to_string(__LINE__)); \
-      if ((payload).size() > max_bytes_to_display) {                           \
-        LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')       \
-                   << "]["                                                     \
-                   << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")       \
-                   << PAD(get_ms(cur), 3, '0') << "]["                         \
-                   << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)  \
-                   << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)    \
-                   << "] " << msg << " (Len=" << (payload).size()              \
-                   << "): " << payload_string.get() << "...";                  \
-      } else {                                                                 \
-        LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')       \
-                   << "]["                                                     \
-                   << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")       \
-                   << PAD(get_ms(cur), 3, '0') << "]["                         \
-                   << LIMIT_RIGHT(file_and_line, Logger::MAX_FILEANDLINE_LEN)  \
-                   << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN)    \
-                   << "] " << msg << " (Len=" << (payload).size()              \
-                   << "): " << payload_string.get();                           \
-      }                                                                        \
-    } else {                                                                   \
-      std::ostringstream oss;                                                  \
-      oss << msg;                                                              \
-      Logger::GetLogger(NULL, true,                                            \
-                        boost::filesystem::absolute("./").string().c_str())    \
-          .LogPayload(level, oss.str().c_str(), payload, max_bytes_to_display, \
-                      __LINE__, __FILE__, __FUNCTION__);                       \
-    }                                                                          \
+#define LOG_PAYLOAD(level, msg, payload, max_bytes_to_display)                \
+  {                                                                           \
+    if (Logger::IsLevelEnabled(level)) {                                      \
+      if (Logger::GetLogger(NULL, true,                                       \
+                            boost::filesystem::absolute("./").string()        \
+                                .c_str())                                     \
+              .IsG3Log()) {                                                   \
+        std::unique_ptr<char[]> payload_string;                               \
+        Logger::GetPayloadS(payload, max_bytes_to_display, payload_string);   \
+        auto cur = std::chrono::system_clock::now();                          \
+        auto cur_time_t = std::chrono::system_clock::to_time_t(cur);          \
+        auto file_and_line = std::string(std::string(__FILE__) + ":" +        \
+                                         std::to_string(__LINE__));           \
+        if ((payload).size() > max_bytes_to_display) {                        \
+          LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')    \
+                     << "]["                                                  \
+                     << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")    \
+                     << PAD(get_ms(cur), 3, '0') << "]["                      \
+                     << LIMIT_RIGHT(file_and_line,                            \
+                                    Logger::MAX_FILEANDLINE_LEN)              \
+                     << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN) \
+                     << "] " << msg << " (Len=" << (payload).size()           \
+                     << "): " << payload_string.get() << "...";               \
+        } else {                                                              \
+          LOG(level) << "[" << PAD(Logger::GetPid(), Logger::TID_LEN, ' ')    \
+                     << "]["                                                  \
+                     << std::put_time(gmtime(&cur_time_t), "%y-%m-%dT%T.")    \
+                     << PAD(get_ms(cur), 3, '0') << "]["                      \
+                     << LIMIT_RIGHT(file_and_line,                            \
+                                    Logger::MAX_FILEANDLINE_LEN)              \
+                     << "][" << LIMIT(__FUNCTION__, Logger::MAX_FUNCNAME_LEN) \
+                     << "] " << msg << " (Len=" << (payload).size()           \
+                     << "): " << payload_string.get();                        \
+        }                                                                     \
+      } else {                                                                \
+        std::ostringstream oss;                                               \
+        oss << msg;                                                           \
+        Logger::GetLogger(NULL, true,                                         \
+                          boost::filesystem::absolute("./").string().c_str()) \
+            .LogPayload(level, oss.str().c_str(), payload,                    \
+                        max_bytes_to_display, __LINE__, __FILE__,             \
+                        __FUNCTION__);                                        \
+      }                                                                       \
+    }                                                                         \
   }
 #define LOG_DISPLAY_LEVEL_ABOVE(level)                                    \
   {                                                                       \
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryBudget.h"
+
+#include <algorithm>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+void MemoryBudget::RegisterCache(const string& name, Tier tier,
+                                 function<uint64_t()> usageFn,
+                                 function<void(uint64_t)> shrinkFn) {
+  lock_guard<mutex> g(m_mutex);
+  m_caches.emplace_back(Entry{name, tier, move(usageFn), move(shrinkFn)});
+}
+
+void MemoryBudget::Enforce() {
+  if (CACHE_MEMORY_BUDGET_MB == 0) {
+    return;
+  }
+
+  // Copy the registry so the callbacks run without m_mutex held; a shrink
+  // that indirectly registers or reports would otherwise deadlock
+  vector<Entry> caches;
+  {
+    lock_guard<mutex> g(m_mutex);
+    caches = m_caches;
+  }
+
+  vector<pair<uint64_t, const Entry*>> usages;
+  usages.reserve(caches.size());
+  uint64_t total = 0;
+  for (const auto& entry : caches) {
+    const uint64_t usage = entry.usageFn();
+    usages.emplace_back(usage, &entry);
+    total += usage;
+  }
+
+  const uint64_t budget = uint64_t(CACHE_MEMORY_BUDGET_MB) * 1024 * 1024;
+  if (total <= budget) {
+    return;
+  }
+
+  uint64_t overshoot = total - budget;
+  LOG_GENERAL(INFO, "Cache usage " << total << " bytes exceeds budget of "
+                                   << budget << ", shedding " << overshoot);
+
+  // Lowest tier first; within a tier the largest cache gives first so one
+  // oversized cache cannot force every small one to empty
+  sort(usages.begin(), usages.end(),
+       [](const pair<uint64_t, const Entry*>& a,
+          const pair<uint64_t, const Entry*>& b) {
+         if (a.second->tier != b.second->tier) {
+           return a.second->tier < b.second->tier;
+         }
+         return a.first > b.first;
+       });
+
+  uint64_t totalShed = 0;
+  for (const auto& usage : usages) {
+    if (overshoot == 0) {
+      break;
+    }
+    const uint64_t before = usage.first;
+    if (before == 0) {
+      continue;
+    }
+    usage.second->shrinkFn(before > overshoot ? before - overshoot : 0);
+    const uint64_t after = usage.second->usageFn();
+    const uint64_t shed = before > after ? before - after : 0;
+    overshoot -= min(overshoot, shed);
+    totalShed += shed;
+  }
+
+  {
+    lock_guard<mutex> g(m_mutex);
+    m_totalBytesShed += totalShed;
+  }
+
+  if (overshoot > 0) {
+    LOG_GENERAL(WARNING, "Still " << overshoot
+                                  << " bytes over the cache budget after "
+                                     "shrinking every registered cache");
+  }
+}
+
+void MemoryBudget::GetReports(vector<CacheReport>& reports,
+                              uint64_t& totalBytes) const {
+  vector<Entry> caches;
+  {
+    lock_guard<mutex> g(m_mutex);
+    caches = m_caches;
+  }
+
+  reports.clear();
+  totalBytes = 0;
+  for (const auto& entry : caches) {
+    CacheReport report;
+    report.name = entry.name;
+    report.tier = entry.tier;
+    report.usageBytes = entry.usageFn();
+    totalBytes += report.usageBytes;
+    reports.emplace_back(move(report));
+  }
+
+  sort(reports.begin(), reports.end(),
+       [](const CacheReport& a, const CacheReport& b) {
+         return a.usageBytes > b.usageBytes;
+       });
+}
+
+uint64_t MemoryBudget::GetTotalBytesShed() const {
+  lock_guard<mutex> g(m_mutex);
+  return m_totalBytesShed;
+}
+
+const char* MemoryBudget::TierToString(Tier tier) {
+  switch (tier) {
+    case Tier::OPPORTUNISTIC:
+      return "OPPORTUNISTIC";
+    case Tier::PERFORMANCE:
+      return "PERFORMANCE";
+    case Tier::ESSENTIAL:
+      return "ESSENTIAL";
+  }
+  return "UNKNOWN";
+}
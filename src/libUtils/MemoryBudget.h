@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_MEMORYBUDGET_H_
+#define ZILLIQA_SRC_LIBUTILS_MEMORYBUDGET_H_
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// Global accounting for the node's in-process caches. Each cache grew its
+/// own bound independently, so their worst cases stack up and the sum is
+/// invisible until the box swaps; registrants report their footprint through
+/// a usage callback and accept a shrink callback, and Enforce() keeps the
+/// summed usage under CACHE_MEMORY_BUDGET_MB by shedding the lowest tier
+/// first. A budget of 0 disables enforcement but keeps the per-cache
+/// breakdown available for monitoring.
+class MemoryBudget : public Singleton<MemoryBudget> {
+  friend class Singleton<MemoryBudget>;
+
+ public:
+  /// Shrink order under pressure. OPPORTUNISTIC caches only save repeat
+  /// work on negative results and empty first; PERFORMANCE caches are
+  /// rebuilt on demand and shrink next; ESSENTIAL caches stall the node
+  /// noticeably when cold and are shed only as a last resort.
+  enum class Tier : unsigned char { OPPORTUNISTIC = 0, PERFORMANCE, ESSENTIAL };
+
+  struct CacheReport {
+    std::string name;
+    Tier tier;
+    uint64_t usageBytes = 0;
+  };
+
+  /// Registers a cache for the process lifetime. usageFn returns the
+  /// current footprint estimate in bytes; shrinkFn is asked to reduce the
+  /// cache to at most targetBytes and must tolerate the cache being used
+  /// concurrently. Both callbacks run without the registry lock held.
+  void RegisterCache(const std::string& name, Tier tier,
+                     std::function<uint64_t()> usageFn,
+                     std::function<void(uint64_t)> shrinkFn);
+
+  /// One enforcement pass: if the summed usage exceeds the budget, asks
+  /// caches to shrink - lowest tier first, largest cache first within a
+  /// tier - until the total fits. No-op when CACHE_MEMORY_BUDGET_MB is 0.
+  void Enforce();
+
+  /// Current per-cache usage (largest first) and the summed total
+  void GetReports(std::vector<CacheReport>& reports,
+                  uint64_t& totalBytes) const;
+
+  /// Total bytes shed by shrink callbacks since startup
+  uint64_t GetTotalBytesShed() const;
+
+  static const char* TierToString(Tier tier);
+
+ private:
+  MemoryBudget() = default;
+  ~MemoryBudget() = default;
+
+  struct Entry {
+    std::string name;
+    Tier tier;
+    std::function<uint64_t()> usageFn;
+    std::function<void(uint64_t)> shrinkFn;
+  };
+
+  mutable std::mutex m_mutex;
+  std::vector<Entry> m_caches;
+  uint64_t m_totalBytesShed = 0;
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_MEMORYBUDGET_H_
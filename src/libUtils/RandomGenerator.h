@@ -20,16 +20,18 @@
 
 #include <iostream>
 #include <random>
+#include <vector>
 
 /// Utility function to get random number from range
 
 namespace RandomGenerator {
 
-static auto rng = [] {
-  std::mt19937 rng;
-  rng.seed(std::random_device()());
+// One engine per thread, seeded once on first use, so callers neither
+// synchronize nor re-seed
+inline std::mt19937& GetEngine() {
+  thread_local std::mt19937 rng(std::random_device{}());
   return rng;
-}();
+}
 
 template <typename T,
           template <typename>
@@ -37,11 +39,11 @@ template <typename T,
           typename... Args>
 T GetRandom(Args&&... args) {
   Distribution<T> dist(std::forward<Args>(args)...);
-  return dist(rng);
+  return dist(GetEngine());
 }
 
 // Get random integer from 0 to size - 1
-int GetRandomInt(const int& size) {
+inline int GetRandomInt(const int& size) {
   if (size > 0) {
     return GetRandom<int>(0, size - 1);
   } else {
@@ -49,6 +51,25 @@ int GetRandomInt(const int& size) {
   }
 }
 
+// Fill result with count integers from 0 to size - 1, sharing one
+// distribution and engine lookup across the whole batch
+inline void GetRandomInts(std::vector<int>& result, const size_t count,
+                          const int& size) {
+  result.clear();
+
+  if (size <= 0) {
+    return;
+  }
+
+  result.reserve(count);
+  std::uniform_int_distribution<int> dist(0, size - 1);
+  auto& engine = GetEngine();
+
+  for (size_t i = 0; i < count; i++) {
+    result.push_back(dist(engine));
+  }
+}
+
 }  // namespace RandomGenerator
 
 #endif  // ZILLIQA_SRC_LIBUTILS_RANDOMGENERATOR_H_
\ No newline at end of file
@@ -45,7 +45,7 @@ template <typename... Container>
 TxnHash ConcatTranAndHash(const Container&... conts) {
   LOG_MARKER();
 
-  SHA2<HashType::HASH_VARIANT_256> sha2;
+  auto& sha2 = SHA2<HashType::HASH_VARIANT_256>::GetReusableInstance();
   bool hasValue = false;
 
   (void)std::initializer_list<int>{(
@@ -56,7 +56,10 @@ TxnHash ConcatTranAndHash(const Container&... conts) {
         hasValue = true;
 
         for (auto& item : list) {
-          sha2.Update(GetHash(item).asBytes());
+          // hash the fixed-size digest in place; asBytes() would allocate a
+          // temporary vector per transaction
+          const auto& hash = GetHash(item);
+          sha2.Update(hash.data(), hash.size);
         }
       }(conts, sha2, hasValue),
       0)...};
@@ -25,6 +25,8 @@ class SafeMath {
   static bool sub(const T& a, const T& b, T& result);
   static bool mul(const T& a, const T& b, T& result);
   static bool div(const T& a, const T& b, T& result);
+  static bool div_with_remainder(const T& a, const T& b, T& quotient,
+                                 T& remainder);
   static bool power_core(const T& base, const T& exponent, T& result);
   static T power(const T& base, const T& exponent, bool isCritical = false);
 
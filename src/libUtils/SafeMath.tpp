@@ -88,6 +88,20 @@ bool SafeMath<T>::div(const T& a, const T& b, T& result) {
   return false;
 }
 
+// Splits a into b equal shares plus the undistributed remainder with a
+// single checked division, so batch distributions need only one overflow
+// check instead of one per recipient.
+template <class T>
+bool SafeMath<T>::div_with_remainder(const T& a, const T& b, T& quotient,
+                                     T& remainder) {
+  if (!div(a, b, quotient)) {
+    return false;
+  }
+
+  remainder = a - quotient * b;
+  return true;
+}
+
 template <class T>
 bool SafeMath<T>::power_core(const T& base, const T& exponent, T& result) {
   if (exponent == 0) {
@@ -48,9 +48,16 @@ void Scheduler::ServiceQueue() {
         continue;
       }
 
-      std::function<void(void)> f = taskQueue.begin()->second;
+      std::function<void(void)> f = taskQueue.begin()->second.first;
+      CancelToken token = taskQueue.begin()->second.second;
       taskQueue.erase(taskQueue.begin());
 
+      // cancellation may have lost the race with dispatch; skip the task
+      // without running it
+      if (token->load()) {
+        continue;
+      }
+
       {
         ReverseLock<unique_lock<mutex>> rlock(lock);
         f();
@@ -62,31 +69,74 @@ void Scheduler::ServiceQueue() {
   newTaskScheduled.notify_one();
 }
 
-void Scheduler::ScheduleAt(std::function<void(void)> f,
-                           chrono::time_point<chrono::system_clock> t) {
+void Scheduler::ScheduleAtInternal(
+    std::function<void(void)> f,
+    const chrono::time_point<chrono::system_clock>& t,
+    const CancelToken& token) {
   {
     lock_guard<mutex> lock(newTaskMutex);
-    taskQueue.emplace(t, f);
+    taskQueue.emplace(t, make_pair(move(f), token));
   }
   newTaskScheduled.notify_one();
 }
 
-void Scheduler::ScheduleAfter(std::function<void(void)> f,
-                              int64_t deltaMilliSeconds) {
-  ScheduleAt(move(f), chrono::system_clock::now() +
-                          chrono::milliseconds(deltaMilliSeconds));
+Scheduler::CancelToken Scheduler::ScheduleAt(
+    std::function<void(void)> f, chrono::time_point<chrono::system_clock> t) {
+  CancelToken token = make_shared<atomic<bool>>(false);
+  ScheduleAtInternal(move(f), t, token);
+  return token;
+}
+
+Scheduler::CancelToken Scheduler::ScheduleAfter(std::function<void(void)> f,
+                                                int64_t deltaMilliSeconds) {
+  return ScheduleAt(move(f), chrono::system_clock::now() +
+                                 chrono::milliseconds(deltaMilliSeconds));
 }
 
-static void SchedulePeriodicallyHelper(Scheduler* s,
-                                       std::function<void(void)> f,
-                                       int64_t deltaMilliSeconds) {
+void Scheduler::SchedulePeriodicallyInternal(const std::function<void(void)>& f,
+                                             int64_t deltaMilliSeconds,
+                                             const CancelToken& token) {
   f();
-  s->ScheduleAfter(bind(&SchedulePeriodicallyHelper, s, f, deltaMilliSeconds),
-                   deltaMilliSeconds);
+
+  if (token->load()) {
+    return;
+  }
+
+  ScheduleAtInternal(
+      bind(&Scheduler::SchedulePeriodicallyInternal, this, f,
+           deltaMilliSeconds, token),
+      chrono::system_clock::now() + chrono::milliseconds(deltaMilliSeconds),
+      token);
+}
+
+Scheduler::CancelToken Scheduler::SchedulePeriodically(
+    std::function<void(void)> f, int64_t deltaMilliSeconds) {
+  CancelToken token = make_shared<atomic<bool>>(false);
+  ScheduleAtInternal(
+      bind(&Scheduler::SchedulePeriodicallyInternal, this, move(f),
+           deltaMilliSeconds, token),
+      chrono::system_clock::now() + chrono::milliseconds(deltaMilliSeconds),
+      token);
+  return token;
 }
 
-void Scheduler::SchedulePeriodically(std::function<void(void)> f,
-                                     int64_t deltaMilliSeconds) {
-  ScheduleAfter(bind(&SchedulePeriodicallyHelper, this, f, deltaMilliSeconds),
-                deltaMilliSeconds);
+void Scheduler::Cancel(const CancelToken& token) {
+  if (token == nullptr) {
+    return;
+  }
+
+  token->store(true);
+
+  {
+    lock_guard<mutex> lock(newTaskMutex);
+
+    for (auto it = taskQueue.begin(); it != taskQueue.end();) {
+      if (it->second.second == token) {
+        it = taskQueue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  newTaskScheduled.notify_one();
 }
@@ -18,12 +18,15 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_SCHEDULER_H_
 #define ZILLIQA_SRC_LIBUTILS_SCHEDULER_H_
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
 
 // should be initialized this way
 // CScheduler::Function serviceLoop = boost::bind(&CScheduler::serviceQueue,
@@ -34,23 +37,44 @@
 /// [TODO] Currently unused
 class Scheduler {
  public:
+  /// Handle for cancelling a scheduled task before it runs; shared with the
+  /// service thread so a cancellation that loses the race with dispatch
+  /// still stops the task (and any periodic rescheduling).
+  using CancelToken = std::shared_ptr<std::atomic<bool>>;
+
   Scheduler();
   ~Scheduler();
 
-  void ScheduleAt(std::function<void(void)> f,
-                  std::chrono::time_point<std::chrono::system_clock> t =
-                      std::chrono::system_clock::now());
-
-  void ScheduleAfter(std::function<void(void)> f, int64_t deltaMilliSeconds);
+  CancelToken ScheduleAt(std::function<void(void)> f,
+                         std::chrono::time_point<std::chrono::system_clock> t =
+                             std::chrono::system_clock::now());
 
-  void SchedulePeriodically(std::function<void(void)> f,
+  CancelToken ScheduleAfter(std::function<void(void)> f,
                             int64_t deltaMilliSeconds);
 
+  CancelToken SchedulePeriodically(std::function<void(void)> f,
+                                   int64_t deltaMilliSeconds);
+
+  /// Cancels a scheduled task. The queued entry is removed right away, so an
+  /// abandoned timer neither wakes the service thread at its deadline nor
+  /// lingers in the queue; a periodic task additionally stops rescheduling
+  /// itself after any run already in flight.
+  void Cancel(const CancelToken& token);
+
   void ServiceQueue();
 
  private:
+  void ScheduleAtInternal(
+      std::function<void(void)> f,
+      const std::chrono::time_point<std::chrono::system_clock>& t,
+      const CancelToken& token);
+
+  void SchedulePeriodicallyInternal(const std::function<void(void)>& f,
+                                    int64_t deltaMilliSeconds,
+                                    const CancelToken& token);
+
   std::multimap<std::chrono::time_point<std::chrono::system_clock>,
-                std::function<void(void)>>
+                std::pair<std::function<void(void)>, CancelToken>>
       taskQueue;
   std::condition_variable newTaskScheduled;
   mutable std::mutex newTaskMutex;
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScillaProfiler.h"
+
+#include <algorithm>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+#include "libUtils/TimeUtils.h"
+
+using namespace std;
+
+void ScillaProfiler::StartInvocation(const string& addressHex) {
+  if (!ENABLE_SCILLA_PROFILE) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  m_curAddress = addressHex;
+  m_curStartMicros = get_time_as_int();
+  m_curIpcFetches = 0;
+  m_curIpcUpdates = 0;
+}
+
+void ScillaProfiler::EndInvocation(bool success, uint64_t outputBytes) {
+  if (!ENABLE_SCILLA_PROFILE) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  if (m_curAddress.empty()) {
+    return;
+  }
+
+  const uint64_t nowMicros = get_time_as_int();
+  const uint64_t wallMicros =
+      nowMicros >= m_curStartMicros ? nowMicros - m_curStartMicros : 0;
+
+  Totals& totals = m_contracts[m_curAddress];
+  totals.invocations++;
+  if (!success) {
+    totals.failures++;
+  }
+  totals.wallMicros += wallMicros;
+  totals.maxWallMicros = max(totals.maxWallMicros, wallMicros);
+  totals.ipcFetches += m_curIpcFetches;
+  totals.ipcUpdates += m_curIpcUpdates;
+  totals.outputBytes += outputBytes;
+
+  if (SCILLA_PROFILE_SLOW_THRESHOLD_MICROS > 0 &&
+      wallMicros >= SCILLA_PROFILE_SLOW_THRESHOLD_MICROS) {
+    LOG_GENERAL(WARNING, "Slow contract "
+                             << m_curAddress << ": " << wallMicros
+                             << " microseconds, " << m_curIpcFetches
+                             << " fetches, " << m_curIpcUpdates << " updates, "
+                             << outputBytes << " output bytes"
+                             << (success ? "" : " (failed)"));
+  }
+
+  m_curAddress.clear();
+}
+
+void ScillaProfiler::AddGas(const string& addressHex, uint64_t gasUsed) {
+  if (!ENABLE_SCILLA_PROFILE) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  m_contracts[addressHex].gasUsed += gasUsed;
+}
+
+void ScillaProfiler::OnStateFetch() {
+  if (!ENABLE_SCILLA_PROFILE) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  if (!m_curAddress.empty()) {
+    m_curIpcFetches++;
+  }
+}
+
+void ScillaProfiler::OnStateUpdate() {
+  if (!ENABLE_SCILLA_PROFILE) {
+    return;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+  if (!m_curAddress.empty()) {
+    m_curIpcUpdates++;
+  }
+}
+
+void ScillaProfiler::GetTopContracts(vector<ContractReport>& reports,
+                                     size_t topN) const {
+  reports.clear();
+
+  {
+    lock_guard<mutex> g(m_mutex);
+    reports.reserve(m_contracts.size());
+    for (const auto& entry : m_contracts) {
+      ContractReport report;
+      report.address = entry.first;
+      report.invocations = entry.second.invocations;
+      report.failures = entry.second.failures;
+      report.wallMicros = entry.second.wallMicros;
+      report.maxWallMicros = entry.second.maxWallMicros;
+      report.ipcFetches = entry.second.ipcFetches;
+      report.ipcUpdates = entry.second.ipcUpdates;
+      report.outputBytes = entry.second.outputBytes;
+      report.gasUsed = entry.second.gasUsed;
+      reports.emplace_back(move(report));
+    }
+  }
+
+  sort(reports.begin(), reports.end(),
+       [](const ContractReport& a, const ContractReport& b) {
+         return a.wallMicros > b.wallMicros;
+       });
+  if (reports.size() > topN) {
+    reports.resize(topN);
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBUTILS_SCILLAPROFILER_H_
+#define ZILLIQA_SRC_LIBUTILS_SCILLAPROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/Singleton.h"
+
+/// Accumulates per-contract accounting of scilla-runner invocations: wall
+/// time, state IPC round trips, output size and gas consumed, keyed by the
+/// contract address. UpdateAccounts executes at most one runner at a time
+/// (chained calls run after the parent runner has exited), so the "current
+/// invocation" is a single slot: AccountStoreSC brackets each runner with
+/// StartInvocation/EndInvocation, ScillaIPCServer bumps the IPC counters
+/// from the socket-server thread in between, and the gas a transition
+/// consumed is attributed once the runner output has been parsed. No-op
+/// unless ENABLE_SCILLA_PROFILE is set in constants.xml.
+class ScillaProfiler : public Singleton<ScillaProfiler> {
+  friend class Singleton<ScillaProfiler>;
+
+ public:
+  struct ContractReport {
+    std::string address;
+    uint64_t invocations = 0;
+    uint64_t failures = 0;
+    uint64_t wallMicros = 0;
+    uint64_t maxWallMicros = 0;
+    uint64_t ipcFetches = 0;
+    uint64_t ipcUpdates = 0;
+    uint64_t outputBytes = 0;
+    uint64_t gasUsed = 0;
+  };
+
+  /// Opens the current-invocation slot for one runner execution of the
+  /// given contract
+  void StartInvocation(const std::string& addressHex);
+
+  /// Closes the current invocation, folds it into the per-contract totals
+  /// and warns if it exceeded SCILLA_PROFILE_SLOW_THRESHOLD_MICROS
+  void EndInvocation(bool success, uint64_t outputBytes);
+
+  /// Attributes gas consumed to a contract; called separately from
+  /// EndInvocation because gas is only known after the output is parsed
+  void AddGas(const std::string& addressHex, uint64_t gasUsed);
+
+  /// One fetchStateValue(s) round trip on behalf of the current invocation
+  void OnStateFetch();
+
+  /// One updateStateValue round trip on behalf of the current invocation
+  void OnStateUpdate();
+
+  /// Copies the per-contract totals, heaviest wall time first
+  void GetTopContracts(std::vector<ContractReport>& reports,
+                       size_t topN) const;
+
+ private:
+  ScillaProfiler() = default;
+  ~ScillaProfiler() = default;
+
+  struct Totals {
+    uint64_t invocations = 0;
+    uint64_t failures = 0;
+    uint64_t wallMicros = 0;
+    uint64_t maxWallMicros = 0;
+    uint64_t ipcFetches = 0;
+    uint64_t ipcUpdates = 0;
+    uint64_t outputBytes = 0;
+    uint64_t gasUsed = 0;
+  };
+
+  // Guards both the current-invocation slot (written by the UpdateAccounts
+  // thread, bumped by the IPC server thread) and the totals map
+  mutable std::mutex m_mutex;
+  std::map<std::string, Totals> m_contracts;
+
+  std::string m_curAddress;
+  uint64_t m_curStartMicros = 0;
+  uint64_t m_curIpcFetches = 0;
+  uint64_t m_curIpcUpdates = 0;
+};
+
+#endif  // ZILLIQA_SRC_LIBUTILS_SCILLAPROFILER_H_
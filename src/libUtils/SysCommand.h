@@ -31,6 +31,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <utility>
+#include <vector>
 
 #include "Logger.h"
 
@@ -42,6 +43,13 @@ static int pid_place_holder;
 
 class SysCommand {
  public:
+  // true if the command is a plain program invocation with whitespace
+  // separated arguments and no shell syntax, so it can be exec'ed directly
+  static bool IsPlainCommand(const std::string& command) {
+    return command.find_first_of(";|&<>*?$`'\"(){}[]~#\\") ==
+           std::string::npos;
+  }
+
   static FILE* popen_with_pid(const std::string& command,
                               const std::string& type, int& pid,
                               const std::string& cwd = "") {
@@ -62,6 +70,8 @@ class SysCommand {
         close(fd[READ]);  // Close the READ end of the pipe since the child's fd
                           // is write-only
         dup2(fd[WRITE], 1);  // Redirect stdout to pipe
+        dup2(fd[WRITE], 2);  // Redirect stderr to pipe too (replaces the
+                             // "2>&1" the shell used to apply)
       } else {
         close(fd[WRITE]);   // Close the WRITE end of the pipe since the child's
                             // fd is read-only
@@ -77,6 +87,26 @@ class SysCommand {
           exit(1);
         }
       }
+      if (IsPlainCommand(command)) {
+        // Exec the program directly: the scilla checker/runner invocations
+        // are plain argv strings, and skipping /bin/sh halves the processes
+        // spawned per contract call and makes the returned pid the
+        // interpreter itself, so a timeout kill reaches it
+        std::vector<std::string> args;
+        boost::split(args, command, boost::is_any_of(" \t"),
+                     boost::token_compress_on);
+        std::vector<char*> argv;
+        for (auto& arg : args) {
+          if (!arg.empty()) {
+            argv.push_back(&arg[0]);
+          }
+        }
+        if (!argv.empty()) {
+          argv.push_back(NULL);
+          execvp(argv[0], argv.data());
+          // fall through to the shell if the direct exec failed
+        }
+      }
       execl("/bin/sh", "/bin/sh", "-c", command.c_str(), NULL);
       exit(0);
     } else {
@@ -155,8 +185,7 @@ class SysCommand {
 
     signal(SIGCHLD, SIG_IGN);
 
-    // Log the stderr into stdout as well
-    cmd += " 2>&1 ";
+    // stderr is merged into the output pipe by popen_with_pid itself
     std::unique_ptr<FILE, std::function<void(FILE*)>> proc(
         popen_with_pid(cmd.c_str(), "r", pid, cwd),
         [pid](FILE* ptr) { popen_with_pid(ptr, pid); });
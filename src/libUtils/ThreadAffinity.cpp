@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadAffinity.h"
+
+#include <pthread.h>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include "Logger.h"
+
+using namespace std;
+
+namespace {
+
+struct PlacementInfo {
+  string cpuList;
+  int sampledCpu{};
+  unsigned int threadCount{};
+};
+
+// Function-local statics: threads are pinned from pool constructors that run
+// during static initialization of singletons
+mutex& GetPlacementMutex() {
+  static mutex placementMutex;
+  return placementMutex;
+}
+
+map<string, PlacementInfo>& GetPlacementMap() {
+  static map<string, PlacementInfo> placementMap;
+  return placementMap;
+}
+
+}  // namespace
+
+bool ThreadAffinity::ParseCpuList(const string& cpuList, cpu_set_t& cpuSet) {
+  CPU_ZERO(&cpuSet);
+
+  stringstream ss(cpuList);
+  string token;
+  while (getline(ss, token, ',')) {
+    if (token.empty()) {
+      continue;
+    }
+    try {
+      const size_t dash = token.find('-');
+      if (dash == string::npos) {
+        const unsigned long cpu = stoul(token);
+        if (cpu >= CPU_SETSIZE) {
+          return false;
+        }
+        CPU_SET(cpu, &cpuSet);
+      } else {
+        const unsigned long lo = stoul(token.substr(0, dash));
+        const unsigned long hi = stoul(token.substr(dash + 1));
+        if ((lo > hi) || (hi >= CPU_SETSIZE)) {
+          return false;
+        }
+        for (unsigned long cpu = lo; cpu <= hi; ++cpu) {
+          CPU_SET(cpu, &cpuSet);
+        }
+      }
+    } catch (const exception&) {
+      return false;
+    }
+  }
+
+  return CPU_COUNT(&cpuSet) > 0;
+}
+
+void ThreadAffinity::PinCurrentThread(const string& cpuList,
+                                      const string& threadName) {
+  if (cpuList.empty()) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  if (!ParseCpuList(cpuList, cpuSet)) {
+    LOG_GENERAL(WARNING, "Invalid CPU list '" << cpuList << "' for thread "
+                                              << threadName);
+    return;
+  }
+
+  const int ret =
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+  if (ret != 0) {
+    LOG_GENERAL(WARNING, "pthread_setaffinity_np failed for thread "
+                             << threadName << " (error " << ret << ")");
+    return;
+  }
+
+  const int currentCpu = sched_getcpu();
+  {
+    lock_guard<mutex> guard(GetPlacementMutex());
+    PlacementInfo& info = GetPlacementMap()[threadName];
+    info.cpuList = cpuList;
+    info.sampledCpu = currentCpu;
+    info.threadCount++;
+  }
+
+  LOG_GENERAL(INFO, "Pinned thread " << threadName << " to CPUs [" << cpuList
+                                     << "], now on CPU " << currentCpu);
+}
+
+string ThreadAffinity::GetPlacementReport() {
+  lock_guard<mutex> guard(GetPlacementMutex());
+
+  ostringstream oss;
+  for (const auto& entry : GetPlacementMap()) {
+    oss << entry.first << ": " << entry.second.threadCount << " thread(s) on ["
+        << entry.second.cpuList << "], sampled CPU " << entry.second.sampledCpu
+        << "; ";
+  }
+  return oss.str();
+}
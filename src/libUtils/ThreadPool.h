@@ -18,11 +18,18 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 #define ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <mutex>
+#include <sstream>
 #include <thread>
 
+#include "ThreadAffinity.h"
+
 /**
  *  Set to 1 to use vector instead of queue for jobs container to improve
  *  memory locality however changes job order from FIFO to LIFO.
@@ -38,19 +45,27 @@
  * Simple thread pool that creates `threadCount` threads upon its creation, and
  * pulls from a queue to get new jobs. This class requires a number of C++11
  * features be present in your compiler.
+ *
+ * Jobs may carry a tag, and every pool keeps per-tag job counts, the queue
+ * depth high-water mark and a histogram of how long jobs waited in the queue.
+ * All live pools are tracked in a registry so GetAllPoolsReport can snapshot
+ * them in one call (fed to EpochWatchdog as a report detail).
  */
 class ThreadPool {
  public:
   typedef std::function<void()> Job;
 
-  /// Constructor.
+  /// Constructor. A non-empty 'cpuList' pins every worker thread to those
+  /// CPUs (see ThreadAffinity), keeping the pool on one NUMA domain.
 #if CONTIGUOUS_JOBS_MEMORY
   explicit ThreadPool(const unsigned int threadCount,
                       const std::string& poolName,
+                      const std::string& cpuList = "",
                       const unsigned int jobsReserveCount = 0)
 #else
   explicit ThreadPool(const unsigned int threadCount,
-                      const std::string& poolName)
+                      const std::string& poolName,
+                      const std::string& cpuList = "")
 #endif
       : _jobsLeft(0),
         _bailout(false),
@@ -60,7 +75,10 @@ class ThreadPool {
         _queueMutex() {
     _threads.reserve(threadCount);
     for (unsigned int index = 0; index < threadCount; ++index) {
-      _threads.push_back(std::thread([this] { this->Task(); }));
+      _threads.push_back(std::thread([this, cpuList] {
+        ThreadAffinity::PinCurrentThread(cpuList, _poolName);
+        this->Task();
+      }));
     }
 
 #if CONTIGUOUS_JOBS_MEMORY
@@ -68,24 +86,37 @@ class ThreadPool {
       _queue.reserve(jobsReserveCount);
     }
 #endif
+
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry().push_back(this);
   }
 
   /// Destructor (JoinAll on deconstruction).
-  ~ThreadPool() { JoinAll(); }
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(RegistryMutex());
+      auto& registry = Registry();
+      registry.erase(std::remove(registry.begin(), registry.end(), this),
+                     registry.end());
+    }
+    JoinAll();
+  }
 
   /// Adds a new job to the pool. If there are no jobs in the queue, a thread is
   /// woken up to take the job. If all threads are busy, the job is added to the
-  /// end of the queue.
-  void AddJob(const Job& job) {
+  /// end of the queue. The optional tag groups the job under that name in the
+  /// pool's stats.
+  void AddJob(const Job& job, const std::string& tag = "") {
     std::lock(_queueMutex, _jobsLeftMutex);
     std::lock_guard<std::mutex> lg1(_queueMutex, std::adopt_lock);
     std::lock_guard<std::mutex> lg2(_jobsLeftMutex, std::adopt_lock);
 
 #if CONTIGUOUS_JOBS_MEMORY
-    _queue.push_back(job);
+    _queue.push_back({job, tag, std::chrono::steady_clock::now()});
 #else
-    _queue.push(job);
+    _queue.push({job, tag, std::chrono::steady_clock::now()});
 #endif
+    RecordEnqueue(tag);
     ++_jobsLeft;
     _jobAvailableVar.notify_one();
 
@@ -94,6 +125,31 @@ class ThreadPool {
     }
   }
 
+  /// Adds a new job only if an idle thread is guaranteed to pick it up right
+  /// away, i.e. the job can never sit in the queue behind long-running jobs.
+  /// Returns false (and does not queue the job) if every thread is occupied.
+  bool TryAddJob(const Job& job, const std::string& tag = "") {
+    std::lock(_queueMutex, _jobsLeftMutex);
+    std::lock_guard<std::mutex> lg1(_queueMutex, std::adopt_lock);
+    std::lock_guard<std::mutex> lg2(_jobsLeftMutex, std::adopt_lock);
+
+    // _jobsLeft counts queued plus currently executing jobs, so staying below
+    // the thread count guarantees a free thread
+    if (_jobsLeft >= static_cast<int>(_threads.size())) {
+      return false;
+    }
+
+#if CONTIGUOUS_JOBS_MEMORY
+    _queue.push_back({job, tag, std::chrono::steady_clock::now()});
+#else
+    _queue.push({job, tag, std::chrono::steady_clock::now()});
+#endif
+    RecordEnqueue(tag);
+    ++_jobsLeft;
+    _jobAvailableVar.notify_one();
+    return true;
+  }
+
   /// Joins with all threads. Blocks until all threads have completed. The queue
   /// may be filled after this call, but the threads will be done. After
   /// invoking JoinAll, the pool can no longer be used.
@@ -134,6 +190,51 @@ class ThreadPool {
     return _jobsLeft;
   }
 
+  /// One line with this pool's depth high-water mark, queue-wait histogram
+  /// and per-tag job counts
+  std::string GetStatsReport() {
+    std::ostringstream oss;
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    oss << _poolName << ": threads=" << _threads.size()
+        << " depth=" << _queue.size() << " maxDepth=" << _maxDepth
+        << " done=" << _jobsDone << " wait_ms[";
+    for (unsigned int i = 0; i <= NUM_WAIT_BUCKETS; i++) {
+      if (i > 0) {
+        oss << ' ';
+      }
+      if (i < NUM_WAIT_BUCKETS) {
+        oss << "<=" << WaitBucketBoundsMs()[i];
+      } else {
+        oss << '>' << WaitBucketBoundsMs()[NUM_WAIT_BUCKETS - 1];
+      }
+      oss << ':' << _waitBuckets[i];
+    }
+    oss << ']';
+    if (!_tagCounts.empty()) {
+      oss << " tags[";
+      bool first = true;
+      for (const auto& tagCount : _tagCounts) {
+        if (!first) {
+          oss << ' ';
+        }
+        first = false;
+        oss << tagCount.first << ':' << tagCount.second;
+      }
+      oss << ']';
+    }
+    return oss.str();
+  }
+
+  /// One line per live pool, for attaching to a watchdog report
+  static std::string GetAllPoolsReport() {
+    std::ostringstream oss;
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    for (ThreadPool* pool : Registry()) {
+      oss << pool->GetStatsReport() << '\n';
+    }
+    return oss.str();
+  }
+
  private:
   /**
    *  Take the next job in the queue and run it.
@@ -161,12 +262,14 @@ class ThreadPool {
 
         // Get job from the queue
 #if CONTIGUOUS_JOBS_MEMORY
-        job = _queue.back();
+        JobEntry entry = _queue.back();
         _queue.pop_back();
 #else
-        job = _queue.front();
+        JobEntry entry = _queue.front();
         _queue.pop();
 #endif
+        RecordDequeue(entry);
+        job = std::move(entry.job);
       }
 
       job();
@@ -179,11 +282,61 @@ class ThreadPool {
     }
   }
 
+  /// A queued job with its tag and the time it entered the queue
+  struct JobEntry {
+    Job job;
+    std::string tag;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  static const unsigned int NUM_WAIT_BUCKETS = 5;
+
+  /// Queue-wait histogram bucket upper bounds; behind a function so the
+  /// header needs no out-of-line definition
+  static const uint64_t (&WaitBucketBoundsMs())[NUM_WAIT_BUCKETS] {
+    static const uint64_t bounds[NUM_WAIT_BUCKETS] = {1, 10, 100, 1000, 10000};
+    return bounds;
+  }
+
+  /// Caller must hold _queueMutex
+  void RecordEnqueue(const std::string& tag) {
+    _maxDepth = std::max(_maxDepth, _queue.size());
+    if (!tag.empty()) {
+      ++_tagCounts[tag];
+    }
+  }
+
+  /// Caller must hold _queueMutex
+  void RecordDequeue(const JobEntry& entry) {
+    ++_jobsDone;
+    const uint64_t waitMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - entry.enqueued)
+            .count();
+    unsigned int bucket = 0;
+    while (bucket < NUM_WAIT_BUCKETS && waitMs > WaitBucketBoundsMs()[bucket]) {
+      ++bucket;
+    }
+    ++_waitBuckets[bucket];
+  }
+
+  /// Registry of every live pool, so all of them can be reported in one
+  /// snapshot; function-local statics keep this header-only
+  static std::mutex& RegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::vector<ThreadPool*>& Registry() {
+    static std::vector<ThreadPool*> registry;
+    return registry;
+  }
+
   std::vector<std::thread> _threads;
 #if CONTIGUOUS_JOBS_MEMORY
-  std::vector<Job> _queue;
+  std::vector<JobEntry> _queue;
 #else
-  std::queue<Job> _queue;
+  std::queue<JobEntry> _queue;
 #endif
 
   int _jobsLeft;
@@ -192,6 +345,12 @@ class ThreadPool {
   std::condition_variable _jobAvailableVar;
   std::mutex _jobsLeftMutex;
   std::mutex _queueMutex;
+
+  // stats, all guarded by _queueMutex
+  size_t _maxDepth = 0;
+  uint64_t _jobsDone = 0;
+  uint64_t _waitBuckets[NUM_WAIT_BUCKETS + 1] = {};
+  std::map<std::string, uint64_t> _tagCounts;
 };
 
 #undef CONTIGUOUS_JOBS_MEMORY
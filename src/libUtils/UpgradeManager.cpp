@@ -49,9 +49,9 @@ struct PTree {
 };
 
 const vector<string> ReadDSCommFromFile() {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   std::vector<std::string> result;
-  for (auto& pubk : pt.get_child("dsnodes")) {
+  for (const auto& pubk : pt.get_child("dsnodes")) {
     if (pubk.first == dsNodePubProp) {
       result.emplace_back(pubk.second.data());
     }
@@ -60,7 +60,7 @@ const vector<string> ReadDSCommFromFile() {
 }
 
 const string ReadDSCommFile(const string& propName) {
-  auto pt = PTree::GetInstance();
+  const auto& pt = PTree::GetInstance();
   return pt.get<string>(propName);
 }
 }  // namespace
@@ -223,7 +223,6 @@ bool UpgradeManager::LoadInitialDS(vector<PubKey>& initialDSCommittee) {
       boost::filesystem::copy_file(
           dsnodeFile, dsNodeFile,
           boost::filesystem::copy_option::overwrite_if_exists);
-      auto pt = PTree::GetInstance();
 
       vector<std::string> tempDsComm_string{ReadDSCommFromFile()};
       initialDSCommittee.clear();
@@ -15,13 +15,20 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "Validator.h"
+#include "libCrypto/Sha2.h"
 #include "libData/AccountData/Account.h"
 #include "libMediator/Mediator.h"
 #include "libMessage/Messenger.h"
 #include "libUtils/BitVector.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -32,11 +39,61 @@ Validator::Validator(Mediator& mediator) : m_mediator(mediator) {}
 
 Validator::~Validator() {}
 
+namespace {
+
+// Cache of (core fields, signature, pubkey) tuples that already passed
+// Schnorr::Verify, keyed by their digest. The same txn is verified again
+// every time a lookup re-forwards it in a packet until it is mined, and
+// each EC verification costs two scalar multiplications; a digest lookup
+// is orders of magnitude cheaper. Keying on the full tuple (not just the
+// TranID) means a re-sent txn with a tampered signature can never hit.
+const unsigned int VERIFIED_TXN_CACHE_MAX_ENTRIES = 65536;
+mutex g_mutexVerifiedTxnCache;
+unordered_set<dev::h256> g_verifiedTxnCache;
+deque<dev::h256> g_verifiedTxnOrder;
+
+dev::h256 ComputeVerifiedTxnDigest(const bytes& txnData,
+                                   const Transaction& tran) {
+  SHA2<HashType::HASH_VARIANT_256> sha2;
+  sha2.Update(txnData);
+  bytes buf;
+  tran.GetSignature().Serialize(buf, 0);
+  tran.GetSenderPubKey().Serialize(buf, buf.size());
+  sha2.Update(buf);
+  return dev::h256(sha2.Finalize());
+}
+
+}  // namespace
+
 bool Validator::VerifyTransaction(const Transaction& tran) {
   bytes txnData;
   tran.SerializeCoreFields(txnData, 0);
 
-  return Schnorr::Verify(txnData, tran.GetSignature(), tran.GetSenderPubKey());
+  const dev::h256 digest = ComputeVerifiedTxnDigest(txnData, tran);
+
+  {
+    lock_guard<mutex> g(g_mutexVerifiedTxnCache);
+    if (g_verifiedTxnCache.find(digest) != g_verifiedTxnCache.end()) {
+      return true;
+    }
+  }
+
+  if (!Schnorr::Verify(txnData, tran.GetSignature(), tran.GetSenderPubKey())) {
+    return false;
+  }
+
+  {
+    lock_guard<mutex> g(g_mutexVerifiedTxnCache);
+    if (g_verifiedTxnCache.emplace(digest).second) {
+      g_verifiedTxnOrder.emplace_back(digest);
+      while (g_verifiedTxnOrder.size() > VERIFIED_TXN_CACHE_MAX_ENTRIES) {
+        g_verifiedTxnCache.erase(g_verifiedTxnOrder.front());
+        g_verifiedTxnOrder.pop_front();
+      }
+    }
+  }
+
+  return true;
 }
 
 bool Validator::CheckCreatedTransaction(const Transaction& tx,
@@ -213,15 +270,11 @@ bool Validator::CheckCreatedTransactionFromLookup(const Transaction& tx) {
   return true;
 }
 
-template <class Container, class DirectoryBlock>
-bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
-                                      const Container& commKeys) {
-  LOG_MARKER();
-
-  unsigned int index = 0;
-  unsigned int count = 0;
-
-  const vector<bool>& B2 = block.GetB2();
+// Extracts the pubkeys of the cosigners marked in bitmap B2
+template <class Container>
+static bool ExtractCosignerKeys(const vector<bool>& B2,
+                                const Container& commKeys,
+                                vector<PubKey>& keys) {
   if (commKeys.size() != B2.size()) {
     LOG_GENERAL(WARNING, "Mismatch: committee size = "
                              << commKeys.size()
@@ -229,36 +282,93 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
     return false;
   }
 
-  // Generate the aggregated key
-  vector<PubKey> keys;
+  // popcount the bitmap before touching any keys, so an invalid cosig is
+  // rejected without extracting hundreds of pubkeys
+  const unsigned int count = BitVector::CountSetBits(B2);
+
+  if (count != ConsensusCommon::NumForConsensus(B2.size())) {
+    LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
+    return false;
+  }
+
+  keys.reserve(keys.size() + count);
+
+  unsigned int index = 0;
   for (auto const& kv : commKeys) {
-    if (B2.at(index)) {
+    if (B2[index]) {
       keys.emplace_back(get<PubKey>(kv));
-      count++;
     }
     index++;
   }
 
-  if (count != ConsensusCommon::NumForConsensus(B2.size())) {
-    LOG_GENERAL(WARNING, "Cosig was not generated by enough nodes");
-    return false;
+  return true;
+}
+
+// Memoize the aggregation: during catch-up, consecutive blocks are
+// typically cosigned by the same committee with the same bitmap (guard
+// nodes sign every block), and re-adding hundreds of pubkeys costs more
+// than the signature check itself. Since `keys` is already filtered by
+// the bitmap, key-list equality alone decides whether the cached
+// aggregate applies.
+static shared_ptr<PubKey> AggregateCosignerKeys(const vector<PubKey>& keys) {
+  static std::mutex aggregateCacheMutex;
+  static vector<PubKey> aggregateCacheKeys;
+  static shared_ptr<PubKey> aggregateCacheResult;
+
+  {
+    lock_guard<mutex> g(aggregateCacheMutex);
+    if (aggregateCacheResult != nullptr && aggregateCacheKeys == keys) {
+      return aggregateCacheResult;
+    }
   }
 
   shared_ptr<PubKey> aggregatedKey = MultiSig::AggregatePubKeys(keys);
   if (aggregatedKey == nullptr) {
     LOG_GENERAL(WARNING, "Aggregated key generation failed");
-    return false;
+    return nullptr;
   }
 
-  // Verify the collective signature
+  lock_guard<mutex> g(aggregateCacheMutex);
+  aggregateCacheKeys = keys;
+  aggregateCacheResult = aggregatedKey;
+  return aggregatedKey;
+}
+
+template <class DirectoryBlock>
+static bool VerifyCosignature(const DirectoryBlock& block,
+                              const PubKey& aggregatedKey) {
   bytes serializedHeader;
   block.GetHeader().Serialize(serializedHeader, 0);
   block.GetCS1().Serialize(serializedHeader, serializedHeader.size());
   BitVector::SetBitVector(serializedHeader, serializedHeader.size(),
                           block.GetB1());
   if (!MultiSig::MultiSigVerify(serializedHeader, 0, serializedHeader.size(),
-                                block.GetCS2(), *aggregatedKey)) {
+                                block.GetCS2(), aggregatedKey)) {
     LOG_GENERAL(WARNING, "Cosig verification failed");
+    return false;
+  }
+
+  return true;
+}
+
+template <class Container, class DirectoryBlock>
+bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
+                                      const Container& commKeys) {
+  LOG_MARKER();
+
+  // Generate the aggregated key
+  vector<PubKey> keys;
+  if (!ExtractCosignerKeys(block.GetB2(), commKeys, keys)) {
+    return false;
+  }
+
+  shared_ptr<PubKey> aggregatedKey = AggregateCosignerKeys(keys);
+  if (aggregatedKey == nullptr) {
+    return false;
+  }
+
+  // Verify the collective signature
+  if (!VerifyCosignature(block, *aggregatedKey)) {
     for (auto& kv : keys) {
       LOG_GENERAL(WARNING, kv);
     }
@@ -268,6 +378,68 @@ bool Validator::CheckBlockCosignature(const DirectoryBlock& block,
   return true;
 }
 
+template <class Container, class DirectoryBlock>
+bool Validator::CheckBlockCosignatures(const vector<DirectoryBlock>& blocks,
+                                       unsigned int startIndex,
+                                       const Container& commKeys) {
+  LOG_MARKER();
+
+  if (startIndex >= blocks.size()) {
+    return true;
+  }
+
+  if (startIndex == blocks.size() - 1) {
+    return CheckBlockCosignature(blocks.back(), commKeys);
+  }
+
+  // The Schnorr challenge binds each collective signature to its own
+  // message, so N cosignatures cannot be folded into a single multi-scalar
+  // multiplication. The batch win comes instead from aggregating the
+  // cosigner key once per distinct bitmap and running the independent
+  // verifies in parallel.
+  vector<shared_ptr<PubKey>> aggregatedKeys;
+  aggregatedKeys.reserve(blocks.size() - startIndex);
+  for (unsigned int i = startIndex; i < blocks.size(); i++) {
+    vector<PubKey> keys;
+    if (!ExtractCosignerKeys(blocks.at(i).GetB2(), commKeys, keys)) {
+      return false;
+    }
+    shared_ptr<PubKey> aggregatedKey = AggregateCosignerKeys(keys);
+    if (aggregatedKey == nullptr) {
+      return false;
+    }
+    aggregatedKeys.emplace_back(move(aggregatedKey));
+  }
+
+  auto result = make_shared<atomic<bool>>(true);
+
+  const unsigned int NUMTHREADS =
+      min<unsigned int>(blocks.size() - startIndex,
+                        max(1u, thread::hardware_concurrency()));
+  ThreadPool verifyPool(NUMTHREADS, "CosigVerifyPool");
+
+  for (unsigned int i = startIndex; i < blocks.size(); i++) {
+    verifyPool.AddJob([&blocks, &aggregatedKeys, i, startIndex, result]() {
+      if (!*result) {
+        return;
+      }
+      if (!VerifyCosignature(blocks.at(i),
+                             *aggregatedKeys.at(i - startIndex))) {
+        LOG_GENERAL(WARNING,
+                    "Cosig verification failed for block "
+                        << blocks.at(i).GetHeader().GetBlockNum());
+        *result = false;
+      }
+    });
+  }
+
+  while (verifyPool.GetJobsLeft() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+
+  return *result;
+}
+
 bool Validator::CheckDirBlocks(
     const vector<boost::variant<DSBlock, VCBlock,
                                 FallbackBlockWShardingStructure>>& dirBlocks,
@@ -285,7 +457,38 @@ bool Validator::CheckDirBlocks(
   BlockHash prevHash = get<BlockLinkIndex::BLOCKHASH>(
       m_mediator.m_blocklinkchain.GetLatestBlockLink());
 
+  // Verified-checkpoint store: a blocklink whose cosignature was already
+  // verified (e.g. before a crash) has its post-link committee hash on disk,
+  // so the expensive cosignature check can be skipped on replay. The
+  // committee evolution is still applied and its hash compared against the
+  // stored value, which catches any divergence in the skipped prefix.
+  auto commitCheckpoint = [&mutable_ds_comm](const uint64_t& index,
+                                             const bool preVerified,
+                                             const CommitteeHash& stored) {
+    CommitteeHash current;
+    if (!Messenger::GetDSCommitteeHash(mutable_ds_comm, current)) {
+      LOG_GENERAL(WARNING, "GetDSCommitteeHash failed");
+      return false;
+    }
+    if (preVerified) {
+      if (current != stored) {
+        LOG_GENERAL(WARNING, "Committee hash at checkpointed blocklink "
+                                 << index
+                                 << " does not match the stored value");
+        return false;
+      }
+      return true;
+    }
+    return BlockStorage::GetBlockStorage().PutDirBlockCheckpoint(index,
+                                                                 current);
+  };
+
   for (const auto& dirBlock : dirBlocks) {
+    CommitteeHash checkpointHash;
+    const bool preVerified = BlockStorage::GetBlockStorage()
+                                 .GetDirBlockCheckpoint(totalIndex,
+                                                        checkpointHash);
+
     if (typeid(DSBlock) == dirBlock.type()) {
       const auto& dsblock = get<DSBlock>(dirBlock);
       if (dsblock.GetHeader().GetBlockNum() != prevdsblocknum + 1) {
@@ -304,7 +507,7 @@ bool Validator::CheckDirBlocks(
         break;
       }
 
-      if (!CheckBlockCosignature(dsblock, mutable_ds_comm)) {
+      if (!preVerified && !CheckBlockCosignature(dsblock, mutable_ds_comm)) {
         LOG_GENERAL(WARNING, "Co-sig verification of ds block "
                                  << prevdsblocknum + 1 << " failed");
         ret = false;
@@ -332,6 +535,10 @@ bool Validator::CheckDirBlocks(
         return false;
       }
       m_mediator.m_node->UpdateDSCommitteeComposition(mutable_ds_comm, dsblock);
+      if (!commitCheckpoint(totalIndex, preVerified, checkpointHash)) {
+        ret = false;
+        break;
+      }
       totalIndex++;
       if (!BlockStorage::GetBlockStorage().ResetDB(BlockStorage::STATE_DELTA)) {
         LOG_GENERAL(WARNING, "BlockStorage::ResetDB failed");
@@ -357,7 +564,7 @@ bool Validator::CheckDirBlocks(
         ret = false;
         break;
       }
-      if (!CheckBlockCosignature(vcblock, mutable_ds_comm)) {
+      if (!preVerified && !CheckBlockCosignature(vcblock, mutable_ds_comm)) {
         LOG_GENERAL(WARNING, "Co-sig verification of vc block in "
                                  << prevdsblocknum << " failed"
                                  << totalIndex + 1);
@@ -387,6 +594,10 @@ bool Validator::CheckDirBlocks(
         return false;
       }
       prevHash = vcblock.GetBlockHash();
+      if (!commitCheckpoint(totalIndex, preVerified, checkpointHash)) {
+        ret = false;
+        break;
+      }
       totalIndex++;
     } else if (typeid(FallbackBlockWShardingStructure) == dirBlock.type()) {
       const auto& fallbackwshardingstructure =
@@ -442,7 +653,8 @@ bool Validator::CheckDirBlocks(
 
       uint32_t shard_id = fallbackblock.GetHeader().GetShardId();
 
-      if (!CheckBlockCosignature(fallbackblock, shards.at(shard_id))) {
+      if (!preVerified &&
+          !CheckBlockCosignature(fallbackblock, shards.at(shard_id))) {
         LOG_GENERAL(WARNING, "Co-sig verification of fallbackblock in "
                                  << prevdsblocknum << " failed"
                                  << totalIndex + 1);
@@ -466,6 +678,10 @@ bool Validator::CheckDirBlocks(
         return false;
       }
       prevHash = fallbackblock.GetBlockHash();
+      if (!commitCheckpoint(totalIndex, preVerified, checkpointHash)) {
+        ret = false;
+        break;
+      }
       totalIndex++;
     } else {
       LOG_GENERAL(WARNING, "dirBlock type unexpected ");
@@ -508,7 +724,18 @@ Validator::TxBlockValidationMsg Validator::CheckTxBlocks(
     return TxBlockValidationMsg::STALEDSINFO;
   }
 
-  if (!CheckBlockCosignature(latestTxBlock, dsComm)) {
+  // Every fetched block minted in the DS epoch of the latest Tx block
+  // carries a cosignature from dsComm, so those can be verified in one
+  // batch. Blocks from earlier DS epochs cannot be checked against dsComm
+  // and stay covered by the prev-hash chain walk below.
+  unsigned int firstInEpoch = txBlocks.size() - 1;
+  while (firstInEpoch > 0 && txBlocks.at(firstInEpoch - 1)
+                                     .GetHeader()
+                                     .GetDSBlockNum() == latestDSIndex) {
+    firstInEpoch--;
+  }
+
+  if (!CheckBlockCosignatures(txBlocks, firstInEpoch, dsComm)) {
     return TxBlockValidationMsg::INVALID;
   }
 
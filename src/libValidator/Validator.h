@@ -47,6 +47,13 @@ class Validator {
   bool CheckBlockCosignature(const DirectoryBlock& block,
                              const Container& commKeys);
 
+  // Verifies the cosignatures of blocks[startIndex..end] in one batch. All
+  // the blocks in the range must have been cosigned by commKeys.
+  template <class Container, class DirectoryBlock>
+  bool CheckBlockCosignatures(const std::vector<DirectoryBlock>& blocks,
+                              unsigned int startIndex,
+                              const Container& commKeys);
+
   bool CheckDirBlocks(
       const std::vector<boost::variant<
           DSBlock, VCBlock, FallbackBlockWShardingStructure>>& dirBlocks,
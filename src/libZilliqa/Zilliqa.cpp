@@ -21,6 +21,7 @@
 #include "Zilliqa.h"
 #include "common/Constants.h"
 #include "common/MessageNames.h"
+#include "common/Messages.h"
 #include "common/Serializable.h"
 #include "depends/safeserver/safehttpserver.h"
 #include "jsonrpccpp/server/connectors/tcpsocketserver.h"
@@ -29,9 +30,15 @@
 #include "libNetwork/Guard.h"
 #include "libServer/GetWorkServer.h"
 #include "libServer/WebsocketServer.h"
+#include "libUtils/AllocTracker.h"
 #include "libUtils/DataConversion.h"
+#include "libPersistence/BlockStorage.h"
+#include "libPersistence/ContractStorage2.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EpochWatchdog.h"
 #include "libUtils/Logger.h"
+#include "libUtils/MemoryBudget.h"
+#include "libUtils/ThreadAffinity.h"
 #include "libUtils/UpgradeManager.h"
 
 using namespace std;
@@ -79,8 +86,9 @@ void Zilliqa::LogSelfNodeInfo(const PairOfKey& key, const Peer& peer) {
 }
 
 void Zilliqa::ProcessMessage(pair<bytes, Peer>* message) {
-  if (message->first.size() >= MessageOffset::BODY) {
-    const unsigned char msg_type = message->first.at(MessageOffset::TYPE);
+  MessageEnvelope envelope;
+  if (MessageEnvelope::Parse(message->first, envelope)) {
+    const unsigned char msg_type = envelope.m_type;
 
     // To-do: Remove consensus user and peer manager placeholders
     Executable* msg_handlers[] = {NULL, &m_ds, &m_n, NULL, &m_lookup};
@@ -95,11 +103,16 @@ void Zilliqa::ProcessMessage(pair<bytes, Peer>* message) {
         return;
       }
 
+#ifdef ENABLE_ALLOC_TRACKING
+      // attribute everything the handler allocates to this message type
+      AllocTracker::ScopeTag allocTag(
+          FormatMessageName(msg_type, envelope.m_instruction));
+#endif
+
       std::chrono::time_point<std::chrono::high_resolution_clock> tpStart;
       std::string msgName;
       if (ENABLE_CHECK_PERFORMANCE_LOG) {
-        const auto ins_byte = message->first.at(MessageOffset::INST);
-        msgName = FormatMessageName(msg_type, ins_byte);
+        msgName = FormatMessageName(msg_type, envelope.m_instruction);
         LOG_GENERAL(INFO, MessageSizeKeyword << msgName << " "
                                              << message->first.size());
 
@@ -136,7 +149,8 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
       m_ds(m_mediator),
       m_lookup(m_mediator, syncType),
       m_n(m_mediator, syncType, toRetrieveHistory),
-      m_msgQueue(MSGQUEUE_SIZE)
+      m_msgQueue(MSGQUEUE_SIZE),
+      m_msgQueuePriority(MSGQUEUE_PRIORITY_SIZE)
 
 {
   LOG_MARKER();
@@ -147,9 +161,12 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
 
   // Launch the thread that reads messages from the queue
   auto funcCheckMsgQueue = [this]() mutable -> void {
+    ThreadAffinity::PinCurrentThread(NUMA_MESSAGE_THREADS_CPUS,
+                                     "MsgQueueDrain");
     pair<bytes, Peer>* message = NULL;
     while (true) {
       while (m_msgQueue.pop(message)) {
+        m_msgQueueDepth--;
         // For now, we use a thread pool to handle this message
         // Eventually processing will be single-threaded
         m_queuePool.AddJob(
@@ -160,6 +177,73 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
   };
   DetachedFunction(1, funcCheckMsgQueue);
 
+  // Consensus-critical messages are drained by their own thread and handled
+  // by a dedicated pool, so a burst of bulk txn bodies occupying QueuePool
+  // cannot delay them into a view change.
+  auto funcCheckPriorityMsgQueue = [this]() mutable -> void {
+    ThreadAffinity::PinCurrentThread(NUMA_MESSAGE_THREADS_CPUS,
+                                     "PrioMsgQueueDrain");
+    pair<bytes, Peer>* message = NULL;
+    while (true) {
+      while (m_msgQueuePriority.pop(message)) {
+        m_msgQueuePriorityDepth--;
+        m_queuePoolPriority.AddJob(
+            [this, message]() mutable -> void { ProcessMessage(message); });
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(1));
+    }
+  };
+  DetachedFunction(1, funcCheckPriorityMsgQueue);
+
+  // context the epoch watchdog attaches to an SLO-breach report
+  EpochWatchdog::GetInstance().RegisterGauge(
+      "msgQueueDepth", [this]() -> uint64_t { return m_msgQueueDepth; });
+  EpochWatchdog::GetInstance().RegisterGauge(
+      "msgQueuePriorityDepth",
+      [this]() -> uint64_t { return m_msgQueuePriorityDepth; });
+  EpochWatchdog::GetInstance().RegisterDetail(
+      "threadPlacement", []() { return ThreadAffinity::GetPlacementReport(); });
+  EpochWatchdog::GetInstance().RegisterDetail(
+      "threadPools", []() { return ThreadPool::GetAllPoolsReport(); });
+  EpochWatchdog::GetInstance().RegisterDetail("leveldb_stateDelta", []() {
+    const auto stats =
+        BlockStorage::GetBlockStorage().GetDBStats(BlockStorage::STATE_DELTA);
+    return stats.empty() ? string() : stats.front();
+  });
+  EpochWatchdog::GetInstance().RegisterDetail("leveldb_txBlocks", []() {
+    const auto stats =
+        BlockStorage::GetBlockStorage().GetDBStats(BlockStorage::TX_BLOCK);
+    return stats.empty() ? string() : stats.front();
+  });
+  EpochWatchdog::GetInstance().RegisterDetail("leveldb_txBodies", []() {
+    const auto stats =
+        BlockStorage::GetBlockStorage().GetDBStats(BlockStorage::TX_BODY);
+    return stats.empty() ? string() : stats.front();
+  });
+
+  // The cache budget coordinator only acts when polled, so a slow
+  // dedicated loop keeps the summed cache usage bounded even while the
+  // consensus threads are busy (e.g. during sync)
+  if (CACHE_MEMORY_BUDGET_MB > 0) {
+    auto funcEnforceCacheBudget = []() -> void {
+      while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(10));
+        MemoryBudget::GetInstance().Enforce();
+      }
+    };
+    DetachedFunction(1, funcEnforceCacheBudget);
+  }
+
+  // Re-encode any contract state still left in the legacy storage layout,
+  // off the critical path; per-contract markers make reruns cheap
+  if (ENABLE_SC) {
+    auto funcMigrateLegacyState = []() -> void {
+      Contract::ContractStorage2::GetContractStorage()
+          .MigrateAllLegacyContractStates();
+    };
+    DetachedFunction(1, funcMigrateLegacyState);
+  }
+
   m_validator = make_shared<Validator>(m_mediator);
 
   m_mediator.RegisterColleagues(&m_ds, &m_n, &m_lookup, m_validator.get());
@@ -370,6 +454,7 @@ Zilliqa::Zilliqa(const PairOfKey& key, const Peer& peer, SyncType syncType,
     } else {
       LOG_GENERAL(INFO, "I am a lookup node.");
       m_lookup.SetServerTrue();
+      m_lookup.ReplayTxnPoolJournal();
     }
 
     if (LOOKUP_NODE_MODE) {
@@ -448,13 +533,58 @@ Zilliqa::~Zilliqa() {
   while (m_msgQueue.pop(message)) {
     delete message;
   }
+  while (m_msgQueuePriority.pop(message)) {
+    delete message;
+  }
+}
+
+bool Zilliqa::IsPriorityMessage(const bytes& message) {
+  MessageEnvelope envelope;
+  if (!MessageEnvelope::Parse(message, envelope)) {
+    return false;
+  }
+
+  const unsigned char msgType = envelope.m_type;
+  const unsigned char instruction = envelope.m_instruction;
+
+  switch (msgType) {
+    case MessageType::DIRECTORY:
+      // Everything the DS committee exchanges is consensus-critical
+      return true;
+    case MessageType::NODE:
+      switch (instruction) {
+        case NodeInstructionType::DSBLOCK:
+        case NodeInstructionType::MICROBLOCKCONSENSUS:
+        case NodeInstructionType::FINALBLOCK:
+        case NodeInstructionType::VCBLOCK:
+        case NodeInstructionType::FALLBACKCONSENSUS:
+        case NodeInstructionType::FALLBACKBLOCK:
+          return true;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
 }
 
 void Zilliqa::Dispatch(pair<bytes, Peer>* message) {
   // LOG_MARKER();
 
+  if (IsPriorityMessage(message->first)) {
+    m_msgQueuePriorityDepth++;
+    if (!m_msgQueuePriority.bounded_push(message)) {
+      m_msgQueuePriorityDepth--;
+      LOG_GENERAL(WARNING, "Priority MsgQueue is full");
+      delete message;
+    }
+    return;
+  }
+
   // Queue message
+  m_msgQueueDepth++;
   if (!m_msgQueue.bounded_push(message)) {
+    m_msgQueueDepth--;
     LOG_GENERAL(WARNING, "Input MsgQueue is full");
     delete message;
   }
@@ -18,6 +18,7 @@
 #ifndef ZILLIQA_SRC_LIBZILLIQA_ZILLIQA_H_
 #define ZILLIQA_SRC_LIBZILLIQA_ZILLIQA_H_
 
+#include <atomic>
 #include <vector>
 
 #include "libDirectoryService/DirectoryService.h"
@@ -39,7 +40,16 @@ class Zilliqa {
   Node m_n;
   // ConsensusUser m_cu; // Note: This is just a test class to demo Consensus
   // usage
+  // Two-level dispatch: consensus-critical messages (DS instructions, block
+  // consensus / block delivery) go through their own queue and pool so they
+  // never sit behind bulk transaction bodies draining the normal queue.
   boost::lockfree::queue<std::pair<bytes, Peer>*> m_msgQueue;
+  boost::lockfree::queue<std::pair<bytes, Peer>*> m_msgQueuePriority;
+
+  // approximate depths of the two queues (lockfree::queue has no size());
+  // sampled by the epoch watchdog when an SLO breach report is captured
+  std::atomic<uint32_t> m_msgQueueDepth{0};
+  std::atomic<uint32_t> m_msgQueuePriorityDepth{0};
 
   std::shared_ptr<LookupServer> m_lookupServer;
   std::shared_ptr<StakingServer> m_stakingServer;
@@ -48,11 +58,19 @@ class Zilliqa {
   std::unique_ptr<jsonrpc::AbstractServerConnector> m_stakingServerConnector;
   std::unique_ptr<jsonrpc::AbstractServerConnector> m_statusServerConnector;
 
-  ThreadPool m_queuePool{MAXRECVMESSAGE, "QueuePool"};
+  ThreadPool m_queuePool{MAXRECVMESSAGE, "QueuePool",
+                         NUMA_MESSAGE_THREADS_CPUS};
+  ThreadPool m_queuePoolPriority{MAXRECVMESSAGE_PRIORITY, "QueuePoolPrio",
+                                 NUMA_MESSAGE_THREADS_CPUS};
 
   void ProcessMessage(std::pair<bytes, Peer>* message);
 
  public:
+  /// Returns true for message classes that must not queue behind bulk
+  /// traffic (consensus announcements, DS/final/VC blocks). Also registered
+  /// with P2PComm so the same classes get the outbound priority lane.
+  static bool IsPriorityMessage(const bytes& message);
+
   /// Constructor.
   Zilliqa(const PairOfKey& key, const Peer& peer,
           SyncType syncType = SyncType::NO_SYNC,
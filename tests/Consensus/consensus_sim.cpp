@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// In-process consensus simulator: drives one ConsensusLeader and N-1
+// ConsensusBackup instances over an in-memory message fabric with an
+// injectable latency distribution, and reports round latency percentiles.
+// Lets consensus parameters (committee size, subset counts, timeouts) be
+// evaluated without a testnet deployment.
+//
+// usage: consensus_sim [committeeSize] [rounds] [latencyMeanMs]
+//                      [latencyStddevMs]
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "common/Messages.h"
+#include "libConsensus/ConsensusBackup.h"
+#include "libConsensus/ConsensusLeader.h"
+#include "libData/BlockData/Block/MicroBlock.h"
+#include "libMessage/Messenger.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+#include "libUtils/RandomGenerator.h"
+
+using namespace std;
+
+const unsigned int DEFAULT_COMMITTEE_SIZE = 10;
+const unsigned int DEFAULT_ROUNDS = 5;
+const double DEFAULT_LATENCY_MEAN_MS = 5.0;
+const double DEFAULT_LATENCY_STDDEV_MS = 2.0;
+
+/// number of threads delivering fabric messages concurrently
+const unsigned int FABRIC_WORKERS = 4;
+
+/// give up on a round after this long (covers ERROR states that never
+/// reach DONE)
+const unsigned int ROUND_TIMEOUT_SECONDS = 120;
+
+const unsigned char SIM_CLASS_BYTE = 0x01;
+const unsigned char SIM_INS_BYTE = 0x01;
+
+/// Queues messages between in-process consensus instances and delivers each
+/// one after a latency sampled from a normal distribution (clamped at zero)
+class InMemoryFabric {
+ public:
+  using Handler = function<void(const bytes& message, const Peer& from)>;
+
+  InMemoryFabric(double latencyMeanMs, double latencyStddevMs)
+      : m_latencyMeanMs(latencyMeanMs), m_latencyStddevMs(latencyStddevMs) {
+    for (unsigned int i = 0; i < FABRIC_WORKERS; i++) {
+      m_workers.emplace_back([this]() { WorkerLoop(); });
+    }
+  }
+
+  ~InMemoryFabric() {
+    {
+      lock_guard<mutex> g(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  void RegisterNode(const Peer& peer, const Handler& handler) {
+    lock_guard<mutex> g(m_mutex);
+    m_handlers[peer.m_ipAddress] = handler;
+  }
+
+  void Send(const Peer& from, const Peer& to, const bytes& message) {
+    if (to.m_ipAddress == from.m_ipAddress) {
+      // production delivery drops self-addressed consensus messages too
+      return;
+    }
+
+    double latencyMs = 0;
+    if (m_latencyStddevMs > 0) {
+      latencyMs = max(0.0, RandomGenerator::GetRandom<double, normal_distribution>(
+                               m_latencyMeanMs, m_latencyStddevMs));
+    } else {
+      latencyMs = max(0.0, m_latencyMeanMs);
+    }
+
+    Delivery delivery;
+    delivery.due = chrono::steady_clock::now() +
+                   chrono::microseconds(static_cast<int64_t>(latencyMs * 1000));
+    delivery.toIp = to.m_ipAddress;
+    delivery.from = from;
+    delivery.message = message;
+
+    {
+      lock_guard<mutex> g(m_mutex);
+      delivery.seq = m_nextSeq++;
+      m_queue.push(move(delivery));
+    }
+    m_cond.notify_one();
+  }
+
+ private:
+  struct Delivery {
+    chrono::steady_clock::time_point due;
+    uint64_t seq = 0;
+    uint128_t toIp = 0;
+    Peer from;
+    bytes message;
+
+    bool operator>(const Delivery& other) const {
+      return tie(due, seq) > tie(other.due, other.seq);
+    }
+  };
+
+  void WorkerLoop() {
+    unique_lock<mutex> lk(m_mutex);
+    while (true) {
+      if (m_stop) {
+        return;
+      }
+
+      if (m_queue.empty()) {
+        m_cond.wait(lk);
+        continue;
+      }
+
+      const auto due = m_queue.top().due;
+      if (due > chrono::steady_clock::now()) {
+        m_cond.wait_until(lk, due);
+        continue;
+      }
+
+      Delivery delivery = m_queue.top();
+      m_queue.pop();
+
+      auto it = m_handlers.find(delivery.toIp);
+      if (it == m_handlers.end()) {
+        continue;
+      }
+      // copy the handler so the shared_ptrs it captures outlive any
+      // re-registration while we deliver off-lock
+      Handler handler = it->second;
+
+      lk.unlock();
+      handler(delivery.message, delivery.from);
+      lk.lock();
+    }
+  }
+
+  const double m_latencyMeanMs;
+  const double m_latencyStddevMs;
+
+  mutex m_mutex;
+  condition_variable m_cond;
+  priority_queue<Delivery, vector<Delivery>, greater<Delivery>> m_queue;
+  map<uint128_t, Handler> m_handlers;
+  uint64_t m_nextSeq = 0;
+  bool m_stop = false;
+  vector<thread> m_workers;
+};
+
+namespace {
+
+bool AnnouncementGenerator(bytes& dst, unsigned int offset,
+                           const uint32_t consensusID,
+                           const uint64_t blockNumber, const bytes& blockHash,
+                           const uint16_t leaderID, const PairOfKey& leaderKey,
+                           bytes& messageToCosign) {
+  // a minimal but well-formed microblock announcement
+  const MicroBlockHeader header(0, 0, 0, 0, blockNumber, MicroBlockHashSet(),
+                                0, leaderKey.second, blockNumber);
+  const MicroBlock microBlock(header, {}, CoSignatures());
+  return Messenger::SetNodeMicroBlockAnnouncement(
+      dst, offset, consensusID, blockNumber, blockHash, leaderID, leaderKey,
+      microBlock, messageToCosign);
+}
+
+bool AnnouncementValidator(const bytes& input, unsigned int offset,
+                           [[gnu::unused]] bytes& errorMsg,
+                           const uint32_t consensusID,
+                           const uint64_t blockNumber, const bytes& blockHash,
+                           const uint16_t leaderID, const PubKey& leaderKey,
+                           bytes& messageToCosign) {
+  MicroBlock microBlock;
+  return Messenger::GetNodeMicroBlockAnnouncement(
+      input, offset, consensusID, blockNumber, blockHash, leaderID, leaderKey,
+      microBlock, messageToCosign);
+}
+
+// Runs one consensus round and returns the leader's start-to-DONE latency in
+// milliseconds, or a negative value if the round failed or timed out
+double RunRound(InMemoryFabric& fabric, const vector<PairOfKey>& keys,
+                const DequeOfNode& committee, const uint32_t consensusID,
+                const uint64_t blockNumber) {
+  const bytes blockHash = TestUtils::GenerateRandomCharVector(32);
+
+  auto leader = make_shared<ConsensusLeader>(
+      consensusID, blockNumber, blockHash, 0, keys[0].first, committee,
+      SIM_CLASS_BYTE, SIM_INS_BYTE,
+      []([[gnu::unused]] const bytes& errorMsg,
+         [[gnu::unused]] const Peer& from) { return true; },
+      []([[gnu::unused]] map<unsigned int, bytes> failureMap) {
+        return true;
+      });
+
+  vector<shared_ptr<ConsensusBackup>> backups;
+  for (unsigned int i = 1; i < committee.size(); i++) {
+    backups.emplace_back(make_shared<ConsensusBackup>(
+        consensusID, blockNumber, blockHash, i, 0, keys[i].first, committee,
+        SIM_CLASS_BYTE, SIM_INS_BYTE, AnnouncementValidator));
+  }
+
+  // route every instance's outbound traffic through the fabric
+  for (unsigned int i = 0; i < committee.size(); i++) {
+    shared_ptr<ConsensusCommon> node =
+        (i == 0) ? shared_ptr<ConsensusCommon>(leader)
+                 : shared_ptr<ConsensusCommon>(backups[i - 1]);
+    const Peer self = committee.at(i).second;
+
+    node->SetTransport(
+        [&fabric, self](const Peer& to, const bytes& message) {
+          fabric.Send(self, to, message);
+        },
+        [&fabric, self](const deque<Peer>& peers, const bytes& message) {
+          for (const auto& to : peers) {
+            fabric.Send(self, to, message);
+          }
+        });
+
+    fabric.RegisterNode(
+        self, [node](const bytes& message, const Peer& from) {
+          node->ProcessMessage(message, MessageOffset::BODY, from);
+        });
+  }
+
+  const auto start = chrono::steady_clock::now();
+  if (!leader->StartConsensus(AnnouncementGenerator, false)) {
+    cerr << "StartConsensus failed" << endl;
+    return -1;
+  }
+
+  const auto deadline = start + chrono::seconds(ROUND_TIMEOUT_SECONDS);
+  while (leader->GetState() != ConsensusCommon::DONE) {
+    if (leader->GetState() == ConsensusCommon::ERROR ||
+        chrono::steady_clock::now() > deadline) {
+      cerr << "Round failed in state " << leader->GetStateString() << endl;
+      return -1;
+    }
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+      .count();
+}
+
+double Percentile(const vector<double>& sorted, double q) {
+  const size_t index = min(
+      sorted.size() - 1,
+      static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5));
+  return sorted[index];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const unsigned int committeeSize =
+      (argc > 1) ? atoi(argv[1]) : DEFAULT_COMMITTEE_SIZE;
+  const unsigned int rounds = (argc > 2) ? atoi(argv[2]) : DEFAULT_ROUNDS;
+  const double latencyMeanMs =
+      (argc > 3) ? atof(argv[3]) : DEFAULT_LATENCY_MEAN_MS;
+  const double latencyStddevMs =
+      (argc > 4) ? atof(argv[4]) : DEFAULT_LATENCY_STDDEV_MS;
+
+  if (committeeSize < 3 || rounds == 0) {
+    cerr << "usage: " << argv[0]
+         << " [committeeSize>=3] [rounds] [latencyMeanMs] [latencyStddevMs]"
+         << endl;
+    return 1;
+  }
+
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+
+  cout << "committeeSize=" << committeeSize << " rounds=" << rounds
+       << " latencyMeanMs=" << latencyMeanMs
+       << " latencyStddevMs=" << latencyStddevMs << endl;
+
+  vector<PairOfKey> keys;
+  DequeOfNode committee;
+  for (unsigned int i = 0; i < committeeSize; i++) {
+    keys.emplace_back(TestUtils::GenerateRandomKeyPair());
+    committee.emplace_back(keys.back().second, Peer(i + 1, 30303));
+  }
+
+  InMemoryFabric fabric(latencyMeanMs, latencyStddevMs);
+
+  vector<double> latenciesMs;
+  for (unsigned int round = 0; round < rounds; round++) {
+    const double roundMs =
+        RunRound(fabric, keys, committee, round + 1, round + 1);
+    if (roundMs < 0) {
+      cout << "round " << round << ": FAILED" << endl;
+      continue;
+    }
+    cout << "round " << round << ": " << roundMs << " ms" << endl;
+    latenciesMs.push_back(roundMs);
+  }
+
+  if (latenciesMs.empty()) {
+    cerr << "all rounds failed" << endl;
+    return 1;
+  }
+
+  sort(latenciesMs.begin(), latenciesMs.end());
+  cout << "successful rounds: " << latenciesMs.size() << "/" << rounds << endl;
+  cout << "round latency ms: p50=" << Percentile(latenciesMs, 0.5)
+       << " p90=" << Percentile(latenciesMs, 0.9)
+       << " p99=" << Percentile(latenciesMs, 0.99)
+       << " max=" << latenciesMs.back() << endl;
+
+  return 0;
+}
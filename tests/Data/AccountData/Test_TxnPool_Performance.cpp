@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// TxnPool benchmarks: same-sender nonce floods (the adversarial
+// findSameNonceButHigherGas path), random-sender inserts, and a concurrent
+// insert/snapshot-drain mix shaped like ProcessTransactionWhenShardLeader.
+// Reports throughput plus p50/p99/max per-insert latency, to size
+// pool bounds from data.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libData/AccountData/TxnPool.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE txnpoolperformance
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+// Scaled for CI; raise for local profiling runs. Mainnet shard pools see
+// tens of thousands of pending txns
+const unsigned int NUM_FLOOD_TXNS = 20000;
+const unsigned int NUM_FLOOD_NONCES = 100;
+const unsigned int NUM_RANDOM_TXNS = 20000;
+const unsigned int NUM_RANDOM_SENDERS = 1000;
+const unsigned int NUM_PRODUCER_THREADS = 4;
+const unsigned int TXNS_PER_PRODUCER = 5000;
+const unsigned int DRAIN_SNAPSHOT_SIZE = 500;
+
+namespace {
+
+Transaction MakeTransaction(const PubKey& senderPubKey, const uint64_t nonce,
+                            const uint128_t& gasPrice) {
+  return Transaction(TxnHash::random(), TestUtils::DistUint32(), nonce,
+                     Address().random(), senderPubKey, TestUtils::DistUint128(),
+                     gasPrice, TestUtils::DistUint64(), {}, {},
+                     TestUtils::GenerateRandomSignature());
+}
+
+struct LatencyReport {
+  double throughputPerSec = 0;
+  double p50Micros = 0;
+  double p99Micros = 0;
+  double maxMicros = 0;
+};
+
+// Runs insertFunc over txns one at a time, timing each call
+template <class F>
+LatencyReport TimedInserts(const vector<Transaction>& txns, const F& insertFunc,
+                           vector<double>& latenciesMicros) {
+  latenciesMicros.clear();
+  latenciesMicros.reserve(txns.size());
+
+  const auto runStart = chrono::steady_clock::now();
+  for (const auto& t : txns) {
+    const auto start = chrono::steady_clock::now();
+    insertFunc(t);
+    latenciesMicros.push_back(
+        chrono::duration<double, micro>(chrono::steady_clock::now() - start)
+            .count());
+  }
+  const double totalSec =
+      chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+
+  sort(latenciesMicros.begin(), latenciesMicros.end());
+  LatencyReport report;
+  report.throughputPerSec = txns.size() / totalSec;
+  report.p50Micros = latenciesMicros[latenciesMicros.size() / 2];
+  report.p99Micros = latenciesMicros[(latenciesMicros.size() * 99) / 100];
+  report.maxMicros = latenciesMicros.back();
+  return report;
+}
+
+void LogReport(const char* name, const size_t count,
+               const LatencyReport& report) {
+  LOG_GENERAL(INFO, name << ": inserts=" << count << " throughput/s="
+                         << report.throughputPerSec
+                         << " p50us=" << report.p50Micros
+                         << " p99us=" << report.p99Micros
+                         << " maxUs=" << report.maxMicros);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(txnpool_performance_test)
+
+BOOST_AUTO_TEST_CASE(init) {
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+}
+
+// One sender floods a small nonce range with ever-higher gas prices, so
+// nearly every insert is a replacement through the nonce index
+BOOST_AUTO_TEST_CASE(bench_SameSenderNonceFlood) {
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+
+  vector<Transaction> txns;
+  txns.reserve(NUM_FLOOD_TXNS);
+  for (unsigned int i = 0; i < NUM_FLOOD_TXNS; i++) {
+    // rising gas price forces the eviction path on every revisit of a nonce
+    txns.emplace_back(
+        MakeTransaction(sender, 1 + (i % NUM_FLOOD_NONCES), 1 + i));
+  }
+
+  TxnPool pool;
+  vector<double> latencies;
+  const LatencyReport report = TimedInserts(
+      txns, [&pool](const Transaction& t) { pool.insert(t); }, latencies);
+  LogReport("SameSenderNonceFlood insert", txns.size(), report);
+  BOOST_CHECK(pool.size() == NUM_FLOOD_NONCES);
+
+  // every lookup hits a pooled txn with higher gas and evicts it
+  const auto start = chrono::steady_clock::now();
+  unsigned int swapped = 0;
+  for (unsigned int nonce = 1; nonce <= NUM_FLOOD_NONCES; nonce++) {
+    Transaction t = MakeTransaction(sender, nonce, 0);
+    const TxnHash incomingID = t.GetTranID();
+    pool.findSameNonceButHigherGas(t);
+    if (t.GetTranID() != incomingID) {
+      swapped++;
+    }
+  }
+  const double elapsedMs =
+      chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+          .count();
+  LOG_GENERAL(INFO, "findSameNonceButHigherGas: lookups="
+                        << NUM_FLOOD_NONCES << " swapped=" << swapped
+                        << " totalMs=" << elapsedMs);
+  BOOST_CHECK(swapped == NUM_FLOOD_NONCES);
+  BOOST_CHECK(pool.size() == 0);
+}
+
+// Many senders, unique nonces: the pool grows monotonically, exercising
+// steady-state insert cost at increasing index sizes
+BOOST_AUTO_TEST_CASE(bench_RandomSenderInserts) {
+  vector<PubKey> senders;
+  senders.reserve(NUM_RANDOM_SENDERS);
+  for (unsigned int i = 0; i < NUM_RANDOM_SENDERS; i++) {
+    senders.emplace_back(TestUtils::GenerateRandomPubKey());
+  }
+
+  vector<Transaction> txns;
+  txns.reserve(NUM_RANDOM_TXNS);
+  for (unsigned int i = 0; i < NUM_RANDOM_TXNS; i++) {
+    txns.emplace_back(MakeTransaction(senders[i % NUM_RANDOM_SENDERS],
+                                      1 + i / NUM_RANDOM_SENDERS,
+                                      TestUtils::DistUint32()));
+  }
+
+  TxnPool pool;
+  vector<double> latencies;
+  const LatencyReport report = TimedInserts(
+      txns, [&pool](const Transaction& t) { pool.insert(t); }, latencies);
+  LogReport("RandomSenderInserts", txns.size(), report);
+  BOOST_CHECK(pool.size() == NUM_RANDOM_TXNS);
+}
+
+// Producers insert under the pool mutex while a drainer periodically
+// snapshots and empties the pool off-lock, the way the shard leader copies
+// m_createdTxns and drains the copy while packing a microblock
+BOOST_AUTO_TEST_CASE(bench_ConcurrentInsertDrain) {
+  vector<vector<Transaction>> perProducerTxns(NUM_PRODUCER_THREADS);
+  for (unsigned int p = 0; p < NUM_PRODUCER_THREADS; p++) {
+    const PubKey sender = TestUtils::GenerateRandomPubKey();
+    perProducerTxns[p].reserve(TXNS_PER_PRODUCER);
+    for (unsigned int i = 0; i < TXNS_PER_PRODUCER; i++) {
+      perProducerTxns[p].emplace_back(
+          MakeTransaction(sender, 1 + i, TestUtils::DistUint32()));
+    }
+  }
+
+  TxnPool pool;
+  mutex poolMutex;
+  atomic<bool> producersDone{false};
+  atomic<uint64_t> drained{0};
+  vector<vector<double>> perProducerLatencies(NUM_PRODUCER_THREADS);
+
+  const auto runStart = chrono::steady_clock::now();
+
+  vector<thread> producers;
+  for (unsigned int p = 0; p < NUM_PRODUCER_THREADS; p++) {
+    producers.emplace_back([&, p]() {
+      auto& latencies = perProducerLatencies[p];
+      latencies.reserve(TXNS_PER_PRODUCER);
+      for (const auto& t : perProducerTxns[p]) {
+        const auto start = chrono::steady_clock::now();
+        {
+          lock_guard<mutex> g(poolMutex);
+          pool.insert(t);
+        }
+        latencies.push_back(chrono::duration<double, micro>(
+                                chrono::steady_clock::now() - start)
+                                .count());
+      }
+    });
+  }
+
+  thread drainer([&]() {
+    while (true) {
+      TxnPool snapshot;
+      {
+        // snapshot-and-clear under the lock, drain off-lock
+        lock_guard<mutex> g(poolMutex);
+        if (pool.size() >= DRAIN_SNAPSHOT_SIZE ||
+            (producersDone.load() && pool.size() > 0)) {
+          snapshot = move(pool);
+          pool = TxnPool();
+        } else if (producersDone.load()) {
+          return;
+        }
+      }
+
+      Transaction t;
+      while (snapshot.findOne(t)) {
+        drained++;
+      }
+      this_thread::yield();
+    }
+  });
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  producersDone = true;
+  drainer.join();
+
+  const double totalSec =
+      chrono::duration<double>(chrono::steady_clock::now() - runStart).count();
+
+  vector<double> allLatencies;
+  for (const auto& latencies : perProducerLatencies) {
+    allLatencies.insert(allLatencies.end(), latencies.begin(),
+                        latencies.end());
+  }
+  sort(allLatencies.begin(), allLatencies.end());
+
+  const uint64_t inserted = NUM_PRODUCER_THREADS * TXNS_PER_PRODUCER;
+  LOG_GENERAL(
+      INFO, "ConcurrentInsertDrain: inserts="
+                << inserted << " drained=" << drained.load() << " throughput/s="
+                << inserted / totalSec
+                << " p50us=" << allLatencies[allLatencies.size() / 2]
+                << " p99us=" << allLatencies[(allLatencies.size() * 99) / 100]
+                << " maxUs=" << allLatencies.back());
+  BOOST_CHECK(drained.load() == inserted);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
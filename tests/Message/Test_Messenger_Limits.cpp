@@ -224,8 +224,10 @@ BOOST_AUTO_TEST_CASE(test_GetLookupSetStateFromSeed) {
       dst, offset, lookupKey, AccountStore::GetInstance()));
   PubKey lookupPubKeyDeserialized;
   bytes dummyAccountStoreBytes;  // unchecked
+  bytes dummyNextCursor;         // unchecked
   BOOST_CHECK(Messenger::GetLookupSetStateFromSeed(
-      dst, offset, lookupPubKeyDeserialized, dummyAccountStoreBytes));
+      dst, offset, lookupPubKeyDeserialized, dummyAccountStoreBytes,
+      dummyNextCursor));
   BOOST_CHECK(lookupKey.second == lookupPubKeyDeserialized);
 
   // Test for above the limit. Let's add a few just to be sure.
@@ -239,7 +241,8 @@ BOOST_AUTO_TEST_CASE(test_GetLookupSetStateFromSeed) {
       dst, offset, lookupKey, AccountStore::GetInstance()));
   PubKey lookupPubKeyDeserialized2;
   BOOST_CHECK(!Messenger::GetLookupSetStateFromSeed(
-      dst, offset, lookupPubKeyDeserialized2, dummyAccountStoreBytes));
+      dst, offset, lookupPubKeyDeserialized2, dummyAccountStoreBytes,
+      dummyNextCursor));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "libData/AccountData/AccountStore.h"
+#include "libMessage/Messenger.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE messengerperformance
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+// Scaled-down defaults so the suite stays inside CI time budgets; raise
+// these for local profiling runs (production-like would be ~100 microblock
+// infos per final block and hundreds of thousands of delta accounts)
+const unsigned int FINALBLOCK_ITERATIONS = 20;
+const unsigned int NUM_MICROBLOCK_INFOS = 100;
+const unsigned int STATE_DELTA_BYTES = 1 << 20;
+const unsigned int DELTA_ITERATIONS = 5;
+const unsigned int NUM_DELTA_ACCOUNTS = 10000;
+
+// Allocation counters: every operator new in this binary is counted, so the
+// per-iteration deltas below include what Messenger and protobuf allocate
+static atomic<uint64_t> g_allocCount{0};
+static atomic<uint64_t> g_allocBytes{0};
+
+void* operator new(size_t size) {
+  g_allocCount.fetch_add(1, memory_order_relaxed);
+  g_allocBytes.fetch_add(size, memory_order_relaxed);
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void* operator new[](size_t size) {
+  g_allocCount.fetch_add(1, memory_order_relaxed);
+  g_allocBytes.fetch_add(size, memory_order_relaxed);
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+// Runs f iterations times and reports wall time and allocations per run
+template <class F>
+void Bench(const char* name, const unsigned int iterations, const F& f) {
+  double totalMs = 0;
+  double minMs = -1;
+  const uint64_t allocCountBefore = g_allocCount.load(memory_order_relaxed);
+  const uint64_t allocBytesBefore = g_allocBytes.load(memory_order_relaxed);
+
+  for (unsigned int i = 0; i < iterations; i++) {
+    const auto start = chrono::steady_clock::now();
+    f();
+    const double elapsedMs =
+        chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+            .count();
+    totalMs += elapsedMs;
+    if (minMs < 0 || elapsedMs < minMs) {
+      minMs = elapsedMs;
+    }
+  }
+
+  const uint64_t allocsPerIter =
+      (g_allocCount.load(memory_order_relaxed) - allocCountBefore) /
+      iterations;
+  const uint64_t allocBytesPerIter =
+      (g_allocBytes.load(memory_order_relaxed) - allocBytesBefore) /
+      iterations;
+
+  LOG_GENERAL(INFO, name << ": iterations=" << iterations
+                         << " avgMs=" << totalMs / iterations
+                         << " minMs=" << minMs << " allocs/iter="
+                         << allocsPerIter << " allocBytes/iter="
+                         << allocBytesPerIter);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(messenger_performance_test)
+
+BOOST_AUTO_TEST_CASE(init) {
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+}
+
+BOOST_AUTO_TEST_CASE(bench_NodeFinalBlockRoundTrip) {
+  vector<MicroBlockInfo> mbInfos;
+  mbInfos.reserve(NUM_MICROBLOCK_INFOS);
+  for (unsigned int i = 0; i < NUM_MICROBLOCK_INFOS; i++) {
+    mbInfos.emplace_back(MicroBlockInfo{BlockHash(), TxnHash(), i});
+  }
+
+  const TxBlock txBlock(TestUtils::GenerateRandomTxBlockHeader(), mbInfos,
+                        TestUtils::GenerateRandomCoSignatures());
+  const bytes stateDelta = TestUtils::GenerateRandomCharVector(
+      STATE_DELTA_BYTES);
+  const uint64_t dsBlockNumber = TestUtils::DistUint64();
+  const uint32_t consensusID = TestUtils::DistUint32();
+
+  // Verify the round trip once before timing it
+  bytes dst;
+  BOOST_CHECK(Messenger::SetNodeFinalBlock(dst, 0, dsBlockNumber, consensusID,
+                                           txBlock, stateDelta));
+  {
+    uint64_t dsBlockNumberOut = 0;
+    uint32_t consensusIDOut = 0;
+    TxBlock txBlockOut;
+    bytes stateDeltaOut;
+    BOOST_CHECK(Messenger::GetNodeFinalBlock(
+        dst, 0, dsBlockNumberOut, consensusIDOut, txBlockOut, stateDeltaOut));
+    BOOST_CHECK(dsBlockNumberOut == dsBlockNumber);
+    BOOST_CHECK(consensusIDOut == consensusID);
+    BOOST_CHECK(txBlockOut.GetMicroBlockInfos() ==
+                txBlock.GetMicroBlockInfos());
+    BOOST_CHECK(stateDeltaOut == stateDelta);
+  }
+
+  Bench("SetNodeFinalBlock", FINALBLOCK_ITERATIONS, [&]() {
+    bytes serialized;
+    BOOST_CHECK(Messenger::SetNodeFinalBlock(
+        serialized, 0, dsBlockNumber, consensusID, txBlock, stateDelta));
+  });
+
+  Bench("GetNodeFinalBlock", FINALBLOCK_ITERATIONS, [&]() {
+    uint64_t dsBlockNumberOut = 0;
+    uint32_t consensusIDOut = 0;
+    TxBlock txBlockOut;
+    bytes stateDeltaOut;
+    BOOST_CHECK(Messenger::GetNodeFinalBlock(
+        dst, 0, dsBlockNumberOut, consensusIDOut, txBlockOut, stateDeltaOut));
+  });
+}
+
+BOOST_AUTO_TEST_CASE(bench_AccountStoreDeltaRoundTrip) {
+  AccountStore::GetInstance().Init();
+
+  AccountStoreTemp accountStoreTemp(AccountStore::GetInstance());
+  for (unsigned int i = 0; i < NUM_DELTA_ACCOUNTS; i++) {
+    accountStoreTemp.AddAccount(Address(i + 1),
+                                Account(TestUtils::DistUint64(), 1));
+  }
+
+  // Verify the round trip once before timing it
+  bytes dst;
+  BOOST_CHECK(Messenger::SetAccountStoreDelta(dst, 0, accountStoreTemp,
+                                              AccountStore::GetInstance()));
+  {
+    AccountStoreTemp deserialized(AccountStore::GetInstance());
+    BOOST_CHECK(Messenger::GetAccountStoreDelta(dst, 0, deserialized, true));
+    BOOST_CHECK(deserialized.GetAccount(Address(1)) != nullptr);
+  }
+
+  Bench("SetAccountStoreDelta", DELTA_ITERATIONS, [&]() {
+    bytes serialized;
+    BOOST_CHECK(Messenger::SetAccountStoreDelta(serialized, 0,
+                                                accountStoreTemp,
+                                                AccountStore::GetInstance()));
+  });
+
+  Bench("GetAccountStoreDelta", DELTA_ITERATIONS, [&]() {
+    AccountStoreTemp deserialized(AccountStore::GetInstance());
+    BOOST_CHECK(Messenger::GetAccountStoreDelta(dst, 0, deserialized, true));
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Soak benchmark for the BlockStorage write paths. Drives
+// PutTxBlock/PutMicroBlock/PutTxBodies/PutStateDelta with synthetic
+// mainnet-shaped epochs and tracks, per database:
+//  - logical bytes handed to BlockStorage vs bytes on disk
+//    (space amplification)
+//  - put latency (avg/max) and stall counts (puts over a threshold,
+//    i.e. writes blocked behind compaction)
+//  - the engine's own level/compaction statistics, whose per-level
+//    write volumes give the true write amplification
+//
+// Payloads are random (incompressible), so on-disk figures are an upper
+// bound relative to real protobuf-encoded bodies.
+//
+// usage: BenchBlockStorage [epochs] [shards] [txnsPerShard]
+//                          [reportEveryEpochs]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "libPersistence/BlockStorage.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+const unsigned int DEFAULT_EPOCHS = 1000;
+const unsigned int DEFAULT_SHARDS = 4;
+const unsigned int DEFAULT_TXNS_PER_SHARD = 100;
+const unsigned int DEFAULT_REPORT_EVERY_EPOCHS = 200;
+
+// Rough mainnet shapes: a Tx block carries one MicroBlockInfo per shard
+// (plus the DS microblock), a microblock carries one hash per txn
+const unsigned int TXBLOCK_BASE_BYTES = 1024;
+const unsigned int MBINFO_BYTES = 68;
+const unsigned int MICROBLOCK_BASE_BYTES = 1024;
+const unsigned int TXHASH_BYTES = 32;
+const unsigned int TXBODY_BYTES = 300;
+const unsigned int STATE_DELTA_BYTES = 64 * 1024;
+
+/// a put slower than this is counted as a (compaction) stall
+const double STALL_THRESHOLD_MS = 100.0;
+
+namespace {
+
+struct PutStats {
+  uint64_t puts = 0;
+  uint64_t logicalBytes = 0;
+  double totalMs = 0;
+  double maxMs = 0;
+  uint64_t stalls = 0;
+
+  void Record(const uint64_t bytes, const double elapsedMs) {
+    puts++;
+    logicalBytes += bytes;
+    totalMs += elapsedMs;
+    maxMs = max(maxMs, elapsedMs);
+    if (elapsedMs > STALL_THRESHOLD_MS) {
+      stalls++;
+    }
+  }
+};
+
+// Times one put and folds it into the per-DB stats
+template <class F>
+bool TimedPut(PutStats& stats, const uint64_t bytes, const F& f) {
+  const auto start = chrono::steady_clock::now();
+  const bool ok = f();
+  stats.Record(
+      bytes,
+      chrono::duration<double, milli>(chrono::steady_clock::now() - start)
+          .count());
+  return ok;
+}
+
+uintmax_t DirSizeBytes(const string& path) {
+  boost::system::error_code ec;
+  if (!boost::filesystem::exists(path, ec)) {
+    return 0;
+  }
+
+  uintmax_t total = 0;
+  for (boost::filesystem::recursive_directory_iterator it(path, ec), end;
+       it != end && !ec; it.increment(ec)) {
+    if (boost::filesystem::is_regular_file(it->path(), ec)) {
+      total += boost::filesystem::file_size(it->path(), ec);
+    }
+  }
+  return total;
+}
+
+struct TrackedDB {
+  const char* label;
+  BlockStorage::DBTYPE type;
+  PutStats stats;
+};
+
+void Report(const uint64_t epoch, vector<TrackedDB>& dbs,
+            const bool withEngineStats) {
+  cout << "=== epoch " << epoch << " ===" << endl;
+  for (auto& db : dbs) {
+    uintmax_t diskBytes = 0;
+    for (const auto& name :
+         BlockStorage::GetBlockStorage().GetDBName(db.type)) {
+      diskBytes += DirSizeBytes(STORAGE_PATH + PERSISTENCE_PATH + "/" + name);
+    }
+
+    const double spaceAmp =
+        (db.stats.logicalBytes > 0)
+            ? static_cast<double>(diskBytes) /
+                  static_cast<double>(db.stats.logicalBytes)
+            : 0;
+    cout << db.label << ": puts=" << db.stats.puts
+         << " logicalMB=" << db.stats.logicalBytes / (1024.0 * 1024.0)
+         << " diskMB=" << diskBytes / (1024.0 * 1024.0)
+         << " spaceAmp=" << spaceAmp << " avgPutMs="
+         << (db.stats.puts > 0 ? db.stats.totalMs / db.stats.puts : 0)
+         << " maxPutMs=" << db.stats.maxMs << " stalls>"
+         << STALL_THRESHOLD_MS << "ms=" << db.stats.stalls << endl;
+
+    if (withEngineStats) {
+      for (const auto& engineStats :
+           BlockStorage::GetBlockStorage().GetDBStats(db.type)) {
+        if (!engineStats.empty()) {
+          cout << engineStats << endl;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const unsigned int epochs = (argc > 1) ? atoi(argv[1]) : DEFAULT_EPOCHS;
+  const unsigned int shards = (argc > 2) ? atoi(argv[2]) : DEFAULT_SHARDS;
+  const unsigned int txnsPerShard =
+      (argc > 3) ? atoi(argv[3]) : DEFAULT_TXNS_PER_SHARD;
+  const unsigned int reportEvery =
+      (argc > 4) ? atoi(argv[4]) : DEFAULT_REPORT_EVERY_EPOCHS;
+
+  if (epochs == 0 || shards == 0 || reportEvery == 0) {
+    cerr << "usage: " << argv[0]
+         << " [epochs] [shards] [txnsPerShard] [reportEveryEpochs]" << endl;
+    return 1;
+  }
+
+  INIT_STDOUT_LOGGER();
+  TestUtils::Initialize();
+
+  cout << "epochs=" << epochs << " shards=" << shards
+       << " txnsPerShard=" << txnsPerShard << " reportEvery=" << reportEvery
+       << endl;
+  if (!LOOKUP_NODE_MODE) {
+    cout << "LOOKUP_NODE_MODE is false: tx bodies are skipped (PutTxBodies "
+            "is lookup-only)"
+         << endl;
+  }
+
+  BlockStorage& storage = BlockStorage::GetBlockStorage();
+
+  enum { TXBLOCK = 0, MICROBLOCK, TXBODY, STATEDELTA };
+  vector<TrackedDB> dbs = {
+      {"txBlocks", BlockStorage::TX_BLOCK, {}},
+      {"microBlocks", BlockStorage::MICROBLOCK, {}},
+      {"txBodies", BlockStorage::TX_BODY, {}},
+      {"stateDelta", BlockStorage::STATE_DELTA, {}},
+  };
+
+  // one DS microblock in addition to the shard microblocks
+  const unsigned int microBlocksPerEpoch = shards + 1;
+  const unsigned int txBlockBytes =
+      TXBLOCK_BASE_BYTES + microBlocksPerEpoch * MBINFO_BYTES;
+  const unsigned int microBlockBytes =
+      MICROBLOCK_BASE_BYTES + txnsPerShard * TXHASH_BYTES;
+
+  for (uint64_t epoch = 1; epoch <= epochs; epoch++) {
+    for (unsigned int shard = 0; shard < microBlocksPerEpoch; shard++) {
+      const bytes mbBody = TestUtils::GenerateRandomCharVector(
+          microBlockBytes);
+      if (!TimedPut(dbs[MICROBLOCK].stats, mbBody.size(), [&]() {
+            return storage.PutMicroBlock(dev::h256::random(), mbBody);
+          })) {
+        cerr << "PutMicroBlock failed at epoch " << epoch << endl;
+        return 1;
+      }
+    }
+
+    if (LOOKUP_NODE_MODE) {
+      unordered_map<dev::h256, bytes> bodies;
+      bodies.reserve(shards * txnsPerShard);
+      uint64_t bodyBytes = 0;
+      for (unsigned int i = 0; i < shards * txnsPerShard; i++) {
+        bytes body =
+            TestUtils::GenerateRandomCharVector(TXBODY_BYTES);
+        bodyBytes += body.size();
+        bodies.emplace(dev::h256::random(), move(body));
+      }
+      if (!TimedPut(dbs[TXBODY].stats, bodyBytes,
+                    [&]() { return storage.PutTxBodies(bodies); })) {
+        cerr << "PutTxBodies failed at epoch " << epoch << endl;
+        return 1;
+      }
+    }
+
+    const bytes txBlockBody =
+        TestUtils::GenerateRandomCharVector(txBlockBytes);
+    if (!TimedPut(dbs[TXBLOCK].stats, txBlockBody.size(), [&]() {
+          return storage.PutTxBlock(epoch, txBlockBody);
+        })) {
+      cerr << "PutTxBlock failed at epoch " << epoch << endl;
+      return 1;
+    }
+
+    const bytes stateDelta = TestUtils::GenerateRandomCharVector(
+        STATE_DELTA_BYTES);
+    if (!TimedPut(dbs[STATEDELTA].stats, stateDelta.size(), [&]() {
+          return storage.PutStateDelta(epoch, stateDelta);
+        })) {
+      cerr << "PutStateDelta failed at epoch " << epoch << endl;
+      return 1;
+    }
+
+    if (epoch % reportEvery == 0) {
+      Report(epoch, dbs, false);
+    }
+  }
+
+  // final report including the engine's per-level compaction figures: sum
+  // of per-level Write(MB) over logicalMB is the write amplification
+  Report(epochs, dbs, true);
+
+  return 0;
+}
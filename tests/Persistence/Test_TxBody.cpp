@@ -17,6 +17,7 @@
 
 #include <Schnorr.h>
 #include <array>
+#include <map>
 #include <string>
 #include <vector>
 #include "common/Constants.h"
@@ -241,4 +242,34 @@ BOOST_AUTO_TEST_CASE(testRandomBlockAccesses) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(testTxnAddressIndexEpochParse) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+  if (LOOKUP_NODE_MODE) {
+    // The index key concatenates the epoch digits and the txn hash with no
+    // separator; a hash starting with decimal digits must not leak into the
+    // parsed blockNum
+    const string address = "00112233445566778899aabbccddeeff00112233";
+    const string txnHash =
+        "1234567890abcdef1234567890abcdef1234567890abcdef1234567890abcdef";
+    const uint64_t epochNum = 42;
+
+    map<string, vector<string>> addrToTxnHashes;
+    addrToTxnHashes[address].push_back(txnHash);
+    BOOST_CHECK(BlockStorage::GetBlockStorage().PutTxnAddressIndex(
+        epochNum, addrToTxnHashes));
+
+    Json::Value txns;
+    bool hasMore = true;
+    BOOST_CHECK(BlockStorage::GetBlockStorage().GetTxnHashesForAddress(
+        address, 1, 10, txns, hasMore));
+
+    BOOST_CHECK_EQUAL(txns.size(), 1u);
+    BOOST_CHECK_EQUAL(txns[0u]["blockNum"].asString(), "42");
+    BOOST_CHECK_EQUAL(txns[0u]["TxnHash"].asString(), txnHash);
+    BOOST_CHECK(!hasMore);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,6 +16,7 @@
  */
 
 #include <array>
+#include <map>
 #include <string>
 #include <thread>
 #include <vector>
@@ -183,6 +184,44 @@ BOOST_AUTO_TEST_CASE(testCachedAndEvictedBlocks) {
       "block number shouldn't change after writing to/ reading from disk");
 }
 
+BOOST_AUTO_TEST_CASE(testTxBlockHeaderColumn) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  map<int, TxBlockHeader> storedHeaders;
+
+  for (int i = 30; i < 60; i++) {
+    TxBlock block = constructDummyTxBlock(i);
+    storedHeaders[i] = block.GetHeader();
+
+    bytes serializedTxBlock;
+    block.Serialize(serializedTxBlock, 0);
+    BlockStorage::GetBlockStorage().PutTxBlock(i, serializedTxBlock);
+  }
+
+  // block 30 has been evicted from the recent-blocks tier by now, so this
+  // read is served from the header column
+  TxBlockHeader header;
+  BOOST_CHECK_MESSAGE(
+      BlockStorage::GetBlockStorage().GetTxBlockHeader(30, header),
+      "header of an evicted block should be retrievable");
+
+  BOOST_CHECK_MESSAGE(
+      storedHeaders[30] == header,
+      "header shouldn't change after writing to/ reading from disk");
+
+  // block 59 is still in the recent-blocks tier
+  TxBlockHeader recentHeader;
+  BOOST_CHECK_MESSAGE(
+      BlockStorage::GetBlockStorage().GetTxBlockHeader(59, recentHeader),
+      "header of a recent block should be retrievable");
+
+  BOOST_CHECK_MESSAGE(
+      storedHeaders[59] == recentHeader,
+      "header shouldn't change after writing to/ reading from disk");
+}
+
 void writeBlock(int id) {
   TxBlock block = constructDummyTxBlock(id);
 
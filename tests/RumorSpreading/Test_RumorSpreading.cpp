@@ -67,4 +67,35 @@ BOOST_AUTO_TEST_CASE(RRS_Initialization) {
   BOOST_CHECK(dummy_message_push == dummy_message_push);
   BOOST_TEST_MESSAGE("RRS Message undefined: " << dummy_message_undefined);
 }
+
+/**
+ * \brief Convergence statistics for retired rumors
+ *
+ * \details Drives a rumor through its round limit and checks that the holder
+ * records how many rumors reached quiescence and in how many rounds
+ */
+BOOST_AUTO_TEST_CASE(RRS_ConvergenceStatistics) {
+  std::unordered_set<int> dummy_peerIdSet;
+  for (int i = 0; i < 16; i++) {
+    dummy_peerIdSet.insert(i);
+  }
+
+  RRS::RumorHolder holder(dummy_peerIdSet, 1, 1, 2, 1, 0);
+  BOOST_CHECK(holder.addRumor(1));
+
+  // Tick past the total round limit so the rumor state machine retires
+  for (int round = 0; round < 4; round++) {
+    holder.advanceRound();
+  }
+  BOOST_CHECK(holder.isOld(1));
+
+  const auto& stats = holder.statistics();
+  auto converged =
+      stats.find(RRS::RumorHolder::StatisticKey::NumConvergedRumors);
+  BOOST_CHECK(converged != stats.end());
+  BOOST_CHECK_EQUAL(converged->second, 1);
+  auto rounds = stats.find(RRS::RumorHolder::StatisticKey::RoundsToQuiescence);
+  BOOST_CHECK(rounds != stats.end());
+  BOOST_CHECK(rounds->second >= 1);
+}
 BOOST_AUTO_TEST_SUITE_END()